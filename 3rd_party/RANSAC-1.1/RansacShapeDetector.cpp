@@ -460,8 +460,9 @@ RansacShapeDetector::Detect(PointCloud &pc, size_t beginIdx, size_t endIdx,
 	/*
 	 * Initialization part
 	 */
-	srand((unsigned int)time(NULL));
-	rn_setseed((size_t)time(NULL));
+	unsigned int seed = m_options.m_seed ? m_options.m_seed : (unsigned int)time(NULL);
+	srand(seed);
+	rn_setseed((size_t)seed);
 
 	CandidatesType candidates;
 
@@ -27,6 +27,7 @@ class DLL_LINKAGE RansacShapeDetector
 			, m_bitmapEpsilon(0.01f)
 			, m_fitting(LS_FITTING)
 			, m_probability(0.001f)
+			, m_seed(0)
 			{}
 			float m_epsilon;
 			float m_normalThresh;
@@ -34,6 +35,7 @@ class DLL_LINKAGE RansacShapeDetector
 			float m_bitmapEpsilon;
 			enum { NO_FITTING, LS_FITTING } m_fitting;
 			float m_probability;
+			unsigned int m_seed; // seed for the random number generators (0 = seed from the current time)
 		};
 		RansacShapeDetector();
 		RansacShapeDetector(const Options &options);
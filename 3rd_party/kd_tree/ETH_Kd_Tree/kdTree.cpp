@@ -30,6 +30,10 @@
 #include <float.h>
 #include <stdlib.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 namespace kdtree  {
 
@@ -69,6 +73,9 @@ namespace kdtree  {
 	float g_queryMaxCosAngle, g_queryMaxTanAngle, g_queryMinSqrRange;
 	//=====================================================
 
+	// subtrees with more points than this threshold are built as separate tasks
+	static const int PARALLEL_BUILD_THRESHOLD = 32768;
+
 	KdTree::KdTree(const Vector3D *positions, unsigned int nOfPositions, unsigned int maxBucketSize) {
 		m_bucketSize			= maxBucketSize;
 		m_nOfPositions			= nOfPositions;
@@ -76,25 +83,151 @@ namespace kdtree  {
 		m_nOfFoundNeighbours	= 0;
 		m_nOfNeighbours			= 0;
 		m_queryPriorityQueue	= new PQueue();
-		for (unsigned int i=0; i<nOfPositions; i++) {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+		for (int i=0; i<(int)nOfPositions; i++) {
 			m_points[i].pos = positions[i];
 			m_points[i].index = i;
 		}
 		m_root = new KdNode();
 		Vector3D maximum, minimum;
 		getSpread(m_points, nOfPositions, maximum, minimum);
+		// the recursive build spawns a task per subtree (see createTree); the tasks are
+		// distributed over the team by the OpenMP runtime (work stealing). The implicit
+		// barrier at the end of the parallel region waits for all of them.
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
 		createTree(*m_root, 0, nOfPositions, maximum, minimum);
 		m_root->createBoundingBox(m_boundingBoxLowCorner, m_boundingBoxHighCorner);
 		setNOfNeighbours(1);
 	}
 
 
+	KdTree::KdTree() {
+		m_points				= NULL;
+		m_bucketSize			= 0;
+		m_root					= NULL;
+		m_nOfFoundNeighbours	= 0;
+		m_nOfNeighbours			= 0;
+		m_nOfPositions			= 0;
+		m_queryPriorityQueue	= NULL;
+	}
+
+
 	KdTree::~KdTree() {
 		delete m_root;
 		delete[] m_points;
 		delete m_queryPriorityQueue;
 	}
 
+
+	void KdTree::saveNode(const BaseKdNode *node, const KdTreePoint *base, FILE *file) {
+		const KdNode *inner = dynamic_cast<const KdNode*>(node);
+		unsigned char tag = inner ? 0 : 1;
+		fwrite(&tag, sizeof(tag), 1, file);
+		fwrite(&node->m_boundingBoxLowCorner, sizeof(Vector3D), 1, file);
+		fwrite(&node->m_boundingBoxHighCorner, sizeof(Vector3D), 1, file);
+		if (inner) {
+			fwrite(&inner->m_cutVal, sizeof(float), 1, file);
+			fwrite(&inner->m_dim, sizeof(unsigned char), 1, file);
+			saveNode(inner->m_children[0], base, file);
+			saveNode(inner->m_children[1], base, file);
+		}
+		else {
+			const KdLeaf *leaf = static_cast<const KdLeaf*>(node);
+			// leaves point into the permuted point array; store the offset
+			unsigned int offset = (unsigned int)(leaf->m_points - base);
+			fwrite(&offset, sizeof(offset), 1, file);
+			fwrite(&leaf->m_nOfElements, sizeof(leaf->m_nOfElements), 1, file);
+		}
+	}
+
+
+	void KdTree::save(FILE *file) const {
+		unsigned int bucketSize = (unsigned int)m_bucketSize;
+		fwrite(&m_nOfPositions, sizeof(m_nOfPositions), 1, file);
+		fwrite(&bucketSize, sizeof(bucketSize), 1, file);
+		fwrite(m_points, sizeof(KdTreePoint), m_nOfPositions, file);
+		saveNode(m_root, m_points, file);
+	}
+
+
+	BaseKdNode* KdTree::loadNode(FILE *file) {
+		unsigned char tag;
+		Vector3D low, high;
+		if (fread(&tag, sizeof(tag), 1, file) != 1 ||
+			fread(&low, sizeof(Vector3D), 1, file) != 1 ||
+			fread(&high, sizeof(Vector3D), 1, file) != 1) {
+			return NULL;
+		}
+		if (tag == 0) {
+			KdNode *node = new KdNode();
+			node->m_boundingBoxLowCorner = low;
+			node->m_boundingBoxHighCorner = high;
+			node->m_children = new BaseKdNode*[2];
+			node->m_children[0] = NULL;
+			node->m_children[1] = NULL;
+			if (fread(&node->m_cutVal, sizeof(float), 1, file) != 1 ||
+				fread(&node->m_dim, sizeof(unsigned char), 1, file) != 1) {
+				delete node;
+				return NULL;
+			}
+			node->m_children[0] = loadNode(file);
+			node->m_children[1] = loadNode(file);
+			if (!node->m_children[0] || !node->m_children[1]) {
+				delete node;
+				return NULL;
+			}
+			return node;
+		}
+		else {
+			KdLeaf *leaf = new KdLeaf();
+			leaf->m_boundingBoxLowCorner = low;
+			leaf->m_boundingBoxHighCorner = high;
+			unsigned int offset, nOfElements;
+			if (fread(&offset, sizeof(offset), 1, file) != 1 ||
+				fread(&nOfElements, sizeof(nOfElements), 1, file) != 1 ||
+				offset > m_nOfPositions || nOfElements > m_nOfPositions - offset) {
+				delete leaf;
+				return NULL;
+			}
+			leaf->m_points = m_points + offset;
+			leaf->m_nOfElements = nOfElements;
+			return leaf;
+		}
+	}
+
+
+	KdTree* KdTree::load(FILE *file) {
+		KdTree *tree = new KdTree();
+		unsigned int bucketSize = 0;
+		if (fread(&tree->m_nOfPositions, sizeof(tree->m_nOfPositions), 1, file) != 1 ||
+			fread(&bucketSize, sizeof(bucketSize), 1, file) != 1 ||
+			tree->m_nOfPositions == 0) {
+			delete tree;
+			return NULL;
+		}
+		tree->m_bucketSize = bucketSize;
+		tree->m_points = new KdTreePoint[tree->m_nOfPositions];
+		if (fread(tree->m_points, sizeof(KdTreePoint), tree->m_nOfPositions, file) != tree->m_nOfPositions) {
+			delete tree;
+			return NULL;
+		}
+		tree->m_root = dynamic_cast<KdNode*>(tree->loadNode(file));
+		if (!tree->m_root) {
+			delete tree;
+			return NULL;
+		}
+		tree->m_boundingBoxLowCorner = tree->m_root->m_boundingBoxLowCorner;
+		tree->m_boundingBoxHighCorner = tree->m_root->m_boundingBoxHighCorner;
+		tree->m_queryPriorityQueue = new PQueue();
+		tree->setNOfNeighbours(1);
+		return tree;
+	}
+
 	void KdTree::queryPosition(const Vector3D &position) {
 		if (m_neighbours.size() == 0) {
 			return;
@@ -313,6 +446,12 @@ namespace kdtree  {
 			node.m_children[0] = childNode;
 			float oldMax = maximum[dim];
 			maximum[dim] = node.m_cutVal;
+			// the two children work on disjoint ranges of m_points, so they can be
+			// built concurrently. The left child becomes a task (its arguments are
+			// copied at task creation), the right child is built by this thread.
+#ifdef _OPENMP
+#pragma omp task firstprivate(childNode, start, mid, maximum, minimum) if (mid-start > PARALLEL_BUILD_THRESHOLD)
+#endif
 			createTree(*childNode, start, mid, maximum, minimum);
 			maximum[dim] = oldMax;
 		}
@@ -32,6 +32,7 @@
 #include "vector2D.h"
 #include "vector3D.h"
 #include "PriorityQueue.h"
+#include <stdio.h>
 #include <vector>
 
 
@@ -271,6 +272,23 @@ namespace kdtree  {
 		*/
 		virtual ~KdTree();
 
+		/**
+		* writes the tree (including the permuted point array) to a binary stream
+		*
+		* @param file
+		*			the stream to write to (opened in binary mode)
+		*/
+		void save(FILE *file) const;
+
+		/**
+		* restores a tree previously written by save()
+		*
+		* @param file
+		*			the stream to read from (opened in binary mode)
+		* @return the restored tree, or NULL if the stream does not contain a valid tree
+		*/
+		static KdTree* load(FILE *file);
+
 		/**
 		* look for the nearest neighbours at <code>position</code>
 		*
@@ -406,6 +424,13 @@ namespace kdtree  {
 
 	private:
 
+		// for load() only: creates an empty tree to be filled from a stream
+		KdTree();
+
+		// recursive parts of save() and load()
+		static void saveNode(const BaseKdNode *node, const KdTreePoint *base, FILE *file);
+		BaseKdNode* loadNode(FILE *file);
+
 		KdTreePoint*				m_points;
 		//const Vector3D*				m_positions;
 		std::vector<Neighbour>  	m_neighbours;
@@ -11135,7 +11135,10 @@ void tetgenmesh::randomsample(point searchpt,triface *searchtet)
     }
   } else {
     // The mesh is non-convex. Do not use 'recenttet'.
-    searchdist = longest;
+    // Note: the sample distances below are squared, so the initial bound must
+    //   be squared as well, otherwise no sample may be accepted and 'searchtet'
+    //   can be left uninitialized (a null tet crashes scout_point()).
+    searchdist = longest * longest;
   }
 
   // Select "good" candidate using k random samples, taking the closest one.
@@ -590,6 +590,12 @@ public:
       }
       delete [] vcelllist;
     }
+
+    // Reset all pointers and counters, so that calling clean_memory() twice
+    //   (e.g., once explicitly and once from the destructor) cannot free the
+    //   same array twice. Lists that a subsequent run does not re-populate
+    //   would otherwise be left dangling.
+    initialize();
   }
 
   // Constructor & destructor.
@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <easy3d/fileio/batch_convert.h>
+#include <easy3d/util/logging.h>
+
+
+using namespace easy3d;
+
+// Batch conversion of model files, e.g., thousands of LAS tiles to bin, or OBJ meshes to
+// binary PLY. The files are converted in parallel (one model per worker in memory at any
+// time) and a manifest recording the outcome of every file is written next to the outputs.
+
+static void usage(const char* name) {
+    std::cerr << "Usage: " << name << " <cloud|mesh|graph|polymesh> <target_extension> <target_directory> <file>...\n"
+              << "    target_extension:  the output format, e.g., bin, ply, obj (without the dot)\n"
+              << "    target_directory:  where the output files go ('-' places each output next to its input)\n"
+              << "Example: " << name << " cloud bin - tiles/*.las" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    logging::initialize();
+
+    if (argc < 4) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string type_name(argv[1]);
+    io::BatchConverter::Type type;
+    if (type_name == "cloud")
+        type = io::BatchConverter::POINT_CLOUD;
+    else if (type_name == "mesh")
+        type = io::BatchConverter::SURFACE_MESH;
+    else if (type_name == "graph")
+        type = io::BatchConverter::GRAPH;
+    else if (type_name == "polymesh")
+        type = io::BatchConverter::POLY_MESH;
+    else {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string target_extension(argv[2]);
+    std::string target_directory(argv[3]);
+    if (target_directory == "-")
+        target_directory.clear();
+
+    std::vector<std::string> file_names;
+    for (int i = 4; i < argc; ++i)
+        file_names.push_back(argv[i]);
+    if (file_names.empty()) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    io::BatchConverter converter(type);
+    const std::size_t num_converted = converter.run(file_names, target_extension, target_directory);
+
+    const std::string manifest = (target_directory.empty() ? std::string(".") : target_directory)
+            + "/conversion_manifest.txt";
+    converter.save_manifest(manifest);
+
+    std::cout << num_converted << " of " << file_names.size() << " files converted"
+              << " (manifest: " << manifest << ")" << std::endl;
+    return num_converted == file_names.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
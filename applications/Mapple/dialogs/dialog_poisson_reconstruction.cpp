@@ -83,21 +83,40 @@ void DialogPoissonReconstruction::showHint(bool b) {
 void DialogPoissonReconstruction::reconstruct() {
     PointCloud *cloud = dynamic_cast<PointCloud *>(viewer_->currentModel());
     if (cloud) {
+        if (window_->executor()->is_busy(cloud)) {
+            LOG(WARNING) << "an operation is already running on this model";
+            return;
+        }
+
         int octree_depth = spinBoxOctreeDepth->value();
         float sampers_per_node = spinBoxSamplesPerNode->value();
-
-        PoissonReconstruction recon;
-        recon.set_depth(octree_depth);
-        recon.set_sampers_per_node(sampers_per_node);
-
-        SurfaceMesh *mesh = recon.apply(cloud, density_attr_name_);
-        if (mesh) {
-            const std::string &name = file_system::name_less_extension(cloud->name()) + "_poisson_reconstruction.ply";
-            mesh->set_name(name);
-            viewer_->addModel(mesh);
-            window_->updateUi();
-            viewer_->update();
-        }
+        const std::string attr_name = density_attr_name_;
+
+        // the reconstruction runs on a worker so the window stays responsive (a deep octree can
+        // take minutes); the result is added to the viewer in the completion callback, which the
+        // main window runs on the UI thread
+        auto viewer = viewer_;
+        auto window = window_;
+        auto result = std::make_shared<SurfaceMesh *>(nullptr);
+        window_->executor()->submit(
+                cloud, "Poisson reconstruction",
+                [=]() {
+                    PoissonReconstruction recon;
+                    recon.set_depth(octree_depth);
+                    recon.set_sampers_per_node(sampers_per_node);
+                    *result = recon.apply(cloud, attr_name);
+                },
+                [=]() {
+                    SurfaceMesh *mesh = *result;
+                    if (mesh) {
+                        const std::string &name =
+                                file_system::name_less_extension(cloud->name()) + "_poisson_reconstruction.ply";
+                        mesh->set_name(name);
+                        viewer->addModel(mesh);
+                        window->updateUi();
+                        viewer->update();
+                    }
+                });
     }
 }
 
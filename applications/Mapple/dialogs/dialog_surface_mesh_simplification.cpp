@@ -25,6 +25,8 @@
 
 #include "dialog_surface_mesh_simplification.h"
 
+#include <algorithm>
+
 #include <QIntValidator>
 
 #include <easy3d/core/surface_mesh.h>
@@ -52,14 +54,22 @@ DialogSurfaceMeshSimplification::DialogSurfaceMeshSimplification(MainWindow *win
 
     layout()->setSizeConstraint(QLayout::SetFixedSize);
     connect(okButton, SIGNAL(clicked()), this, SLOT(apply()));
+
+    mesh_ = nullptr;
+    simplifier_ = nullptr;
+    timer_.setInterval(0);  // fire whenever the event loop is idle
+    connect(&timer_, SIGNAL(timeout()), this, SLOT(step()));
 }
 
 
 DialogSurfaceMeshSimplification::~DialogSurfaceMeshSimplification() {
+    stopStepping();
 }
 
 
 void DialogSurfaceMeshSimplification::apply() {
+    stopStepping();     // a previous run may still be in progress
+
     SurfaceMesh *mesh = dynamic_cast<SurfaceMesh *>(viewer_->currentModel());
     if (!mesh)
         return;
@@ -68,12 +78,50 @@ void DialogSurfaceMeshSimplification::apply() {
     const int aspect_ratio = 10;
 
     const int expected_vertex_number = lineEditVertexNumber->text().toInt();
-    SurfaceMeshSimplification ss(mesh);
-    ss.initialize(aspect_ratio, 0.0, 0.0, normal_deviation, 0.0);
-    ss.simplify(expected_vertex_number);
 
-    mesh->renderer()->update();
+    // the simplification is stepped in small time slices interleaved with rendering, so the
+    // user watches the model converge instead of a frozen screen
+    mesh_ = mesh;
+    simplifier_ = new SurfaceMeshSimplification(mesh);
+    simplifier_->initialize(aspect_ratio, 0.0, 0.0, normal_deviation, 0.0);
+    if (simplifier_->simplify_start(expected_vertex_number))
+        timer_.start();
+    else
+        stopStepping();
+}
+
+
+void DialogSurfaceMeshSimplification::step() {
+    // the model may have been deleted while the simplification was in progress
+    const auto &models = viewer_->models();
+    if (std::find(models.begin(), models.end(), mesh_) == models.end()) {
+        timer_.stop();
+        // the mesh is gone and the simplifier's cleanup would touch it; abandoning the
+        // small wrapper object is the only safe option
+        simplifier_ = nullptr;
+        mesh_ = nullptr;
+        return;
+    }
+
+    const bool more = simplifier_->step(30.0);  // ms per slice; keeps the UI responsive
+
+    mesh_->renderer()->update();
     viewer_->update();
-    window_->updateUi();
+
+    if (!more) {
+        stopStepping();
+        window_->updateUi();
+    }
+}
+
+
+void DialogSurfaceMeshSimplification::stopStepping() {
+    timer_.stop();
+    if (simplifier_) {
+        simplifier_->simplify_finish(); // keep the partially simplified mesh
+        delete simplifier_;
+        simplifier_ = nullptr;
+    }
+    mesh_ = nullptr;
 }
 
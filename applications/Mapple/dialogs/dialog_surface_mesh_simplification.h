@@ -26,9 +26,15 @@
 #ifndef DIALOG_SURFACE_SIMPLIFICATION_H
 #define DIALOG_SURFACE_SIMPLIFICATION_H
 
+#include <QTimer>
+
 #include "dialog.h"
 #include "ui_dialog_surface_mesh_simplification.h"
 
+namespace easy3d {
+    class SurfaceMesh;
+    class SurfaceMeshSimplification;
+}
 
 class DialogSurfaceMeshSimplification : public Dialog, public Ui::DialogSurfaceMeshSimplification {
 Q_OBJECT
@@ -40,6 +46,18 @@ public:
 private Q_SLOTS:
 
     void apply();
+
+    // one time slice of the stepped simplification (see apply()); renders the intermediate
+    // mesh so the user watches the model converge instead of a frozen screen
+    void step();
+
+private:
+    void stopStepping();
+
+private:
+    QTimer timer_;
+    easy3d::SurfaceMesh *mesh_;
+    easy3d::SurfaceMeshSimplification *simplifier_;
 };
 
 #endif // DIALOG_SURFACE_SIMPLIFICATION_H
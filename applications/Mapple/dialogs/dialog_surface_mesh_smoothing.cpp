@@ -96,7 +96,8 @@ void DialogSurfaceMeshSmoothing::apply() {
         smoother.implicit_smoothing(dt, uniform_laplace, rescale);
     }
 
-    mesh->renderer()->update();
+    // smoothing moves vertices but never changes the connectivity
+    mesh->renderer()->update_geometry();
     viewer_->update();
 }
 
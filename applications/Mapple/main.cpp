@@ -25,9 +25,11 @@
 
 #include "main_window.h"
 
+#include <cstdlib>
 #include <string>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 #include <QDir>
 #include <QTime>
@@ -39,6 +41,7 @@
 #include <QSurfaceFormat>
 #include <QElapsedTimer>
 
+#include <easy3d/fileio/batch_convert.h>
 #include <easy3d/fileio/resources.h>
 #include <easy3d/util/logging.h>
 
@@ -79,6 +82,40 @@ int main(int argc, char *argv[])
 #endif
     }
 
+    // Batch conversion mode: converts the given files in parallel and exits, without
+    // starting the GUI. Usage:
+    //      Mapple --convert <cloud|mesh|graph|polymesh> <target_extension> <file>...
+    // The outputs (and the manifest recording the outcome of every file) are placed next
+    // to the input files.
+    if (argc >= 4 && std::string(argv[1]) == "--convert") {
+        logging::initialize(true, "", google::GLOG_INFO);
+
+        const std::string type_name(argv[2]);
+        io::BatchConverter::Type type;
+        if (type_name == "cloud")
+            type = io::BatchConverter::POINT_CLOUD;
+        else if (type_name == "mesh")
+            type = io::BatchConverter::SURFACE_MESH;
+        else if (type_name == "graph")
+            type = io::BatchConverter::GRAPH;
+        else if (type_name == "polymesh")
+            type = io::BatchConverter::POLY_MESH;
+        else {
+            std::cerr << "unknown model type: " << type_name
+                      << " (expected cloud, mesh, graph, or polymesh)" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::vector<std::string> file_names;
+        for (int i = 4; i < argc; ++i)
+            file_names.push_back(argv[i]);
+
+        io::BatchConverter converter(type);
+        const std::size_t num_converted = converter.run(file_names, argv[3]);
+        converter.save_manifest("conversion_manifest.txt");
+        return num_converted == file_names.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     // Note: Calling QSurfaceFormat::setDefaultFormat() before constructing the
     //       QApplication instance is mandatory on some platforms(for example, macOS)
     //       when an OpenGL core profile context is requested. This is to ensure
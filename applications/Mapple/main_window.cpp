@@ -36,6 +36,8 @@
 #include <QColorDialog>
 #include <QCoreApplication>
 #include <QPushButton>
+#include <QThread>
+#include <QTimer>
 
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/graph.h>
@@ -70,9 +72,12 @@
 #include <easy3d/algo/delaunay_3d.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/file_system.h>
+#include <easy3d/util/operation_executor.h>
 #include <easy3d/util/stop_watch.h>
 
+#include "model_statistics.h"
 #include "paint_canvas.h"
+#include "session.h"
 
 #include "dialogs/dialog_snapshot.h"
 #include "dialogs/dialog_properties.h"
@@ -111,6 +116,16 @@ MainWindow::MainWindow(QWidget *parent)
     viewer_ = new PaintCanvas(this);
     setCentralWidget(viewer_);
 
+    // long-running algorithms run on background workers; their completion callbacks are polled
+    // here so results are handed over on the UI thread
+    executor_ = new OperationExecutor;
+    auto poll_timer = new QTimer(this);
+    connect(poll_timer, SIGNAL(timeout()), this, SLOT(pollOperations()));
+    poll_timer->start(50);
+
+    // model statistics compute lazily on the executor and are cached
+    statistics_ = new ModelStatistics(executor_);
+
     // ----- the width of the rendering panel ------
     // sizeHint() doesn't suggest a good value
     // const QSize& size = ui->dockWidgetRendering->sizeHint();
@@ -192,11 +207,32 @@ MainWindow::MainWindow(QWidget *parent)
 
 
 MainWindow::~MainWindow() {
+    executor_->wait_all();  // deliver the results of operations still running
+    delete statistics_;
+    delete executor_;
     LOG(INFO) << "Mapple terminated. Bye!";
 }
 
 
 void MainWindow::notify(std::size_t value, bool show_text, bool update_viewer) {
+    if (QThread::currentThread() != thread()) {
+        // progress now also arrives from executor workers; the widgets may only be touched on
+        // the UI thread, so the update is marshaled there through the queued slot invocation
+        QMetaObject::invokeMethod(this, "updateProgress", Qt::QueuedConnection,
+                                  Q_ARG(int, int(value)), Q_ARG(bool, show_text), Q_ARG(bool, update_viewer));
+        return;
+    }
+    updateProgress(int(value), show_text, update_viewer);
+}
+
+
+void MainWindow::pollOperations() {
+    if (executor_->poll_finished() > 0)
+        viewer_->update();
+}
+
+
+void MainWindow::updateProgress(int value, bool show_text, bool update_viewer) {
     progress_bar_->setValue(int(value));
     progress_bar_->setTextVisible(show_text);
     progress_bar_->setVisible(value > 0 && value < 100);
@@ -436,6 +472,54 @@ bool MainWindow::onSave() {
 }
 
 
+bool MainWindow::onOpenProject() {
+    const QString& fileName = QFileDialog::getOpenFileName(
+                this,
+                "Open project",
+                curDataDirectory_,
+                "Mapple project (*.mproj)"
+    );
+
+    // Hide closed dialog
+    QApplication::processEvents();
+
+    if (fileName.isEmpty())
+        return false;
+
+    if (!Session::load(fileName.toStdString(), viewer_))
+        return false;
+
+    curDataDirectory_ = fileName.left(fileName.lastIndexOf("/"));
+    updateUi();
+    viewer_->update();
+    return true;
+}
+
+
+bool MainWindow::onSaveProject() {
+    if (viewer_->models().empty()) {
+        std::cerr << "no model exists" << std::endl;
+        return false;
+    }
+
+    const QString& fileName = QFileDialog::getSaveFileName(
+                this,
+                "Save project",
+                curDataDirectory_,
+                "Mapple project (*.mproj)"
+    );
+
+    if (fileName.isEmpty())
+        return false;
+
+    if (!Session::save(fileName.toStdString(), viewer_))
+        return false;
+
+    curDataDirectory_ = fileName.left(fileName.lastIndexOf("/"));
+    return true;
+}
+
+
 Model* MainWindow::open(const std::string& file_name) {
     auto models = viewer_->models();
     for (auto m : models) {
@@ -517,6 +601,7 @@ void MainWindow::setCurrentFile(const QString &fileName)
         recentFiles_.removeAll(fileName);
         recentFiles_.prepend(fileName);
         updateRecentFileActions();
+        refreshRecentFileInfo();
     }
 
     updateWindowTitle();
@@ -736,7 +821,11 @@ void MainWindow::readSettings()
 {
     QSettings settings("liangliang.nan@gmail.com", "Mapple");
     recentFiles_ = settings.value("recentFiles").toStringList();
+    recentFileInfo_ = settings.value("recentFileInfo").toMap();
+    // the menu is built from the cached metadata only; the files themselves are stat'ed in the
+    // background (they may live on a slow network drive, which must not delay the first paint)
     updateRecentFileActions();
+    refreshRecentFileInfo();
     curDataDirectory_ = settings.value("currentDirectory").toString();
 }
 
@@ -745,6 +834,7 @@ void MainWindow::writeSettings()
 {
     QSettings settings("liangliang.nan@gmail.com", "Mapple");
     settings.setValue("recentFiles", recentFiles_);
+    settings.setValue("recentFileInfo", recentFileInfo_);
     if (!curDataDirectory_.isEmpty() && file_system::is_directory(curDataDirectory_.toStdString()))
         settings.setValue("currentDirectory", curDataDirectory_);
 }
@@ -781,17 +871,23 @@ void MainWindow::closeEvent(QCloseEvent *event)
 
 void MainWindow::updateRecentFileActions()
 {
-    QMutableStringListIterator i(recentFiles_);
-    while (i.hasNext()) {
-        if (!QFile::exists(i.next()))
-            i.remove();
-    }
-
+    // no filesystem access here (that is what refreshRecentFileInfo() is for): stat'ing files
+    // on a slow network drive from this function used to delay the first paint by seconds.
     for (int j = 0; j < MaxRecentFiles; ++j) {
         if (j < recentFiles_.count()) {
             QString text = tr("&%1 %2").arg(j + 1).arg(strippedName(recentFiles_[j]));
             actionsRecentFile[j]->setText(text);
             actionsRecentFile[j]->setData(recentFiles_[j]);
+            const auto pos = recentFileInfo_.find(recentFiles_[j]);
+            if (pos != recentFileInfo_.end()) {
+                const QStringList info = pos.value().toString().split("|");
+                if (info.size() == 2) {
+                    actionsRecentFile[j]->setToolTip(
+                            tr("%1\n%2 bytes, modified %3").arg(recentFiles_[j]).arg(info[0]).arg(info[1]));
+                }
+            }
+            else
+                actionsRecentFile[j]->setToolTip(recentFiles_[j]);
             actionsRecentFile[j]->setVisible(true);
         } else {
             actionsRecentFile[j]->setVisible(false);
@@ -802,6 +898,50 @@ void MainWindow::updateRecentFileActions()
 }
 
 
+void MainWindow::refreshRecentFileInfo()
+{
+    std::vector<std::string> files;
+    for (int i = 0; i < recentFiles_.count(); ++i)
+        files.push_back(recentFiles_[i].toStdString());
+    if (files.empty())
+        return;
+
+    struct Info {
+        bool exists;
+        std::string size;
+        std::string time;
+    };
+    auto infos = std::make_shared<std::vector<Info> >(files.size());
+    executor_->submit(
+            &recentFiles_, "Refresh recent files",
+            [=]() {
+                for (std::size_t i = 0; i < files.size(); ++i) {
+                    Info& info = (*infos)[i];
+                    info.exists = file_system::is_file(files[i]);
+                    if (info.exists) {
+                        info.size = std::to_string(static_cast<long long>(file_system::file_size(files[i])));
+                        info.time = file_system::time_string(files[i]);
+                    }
+                }
+            },
+            [=]() {
+                // runs on the UI thread: files that have disappeared are dropped from the menu
+                // and the metadata cache is renewed for those that still exist
+                recentFileInfo_.clear();
+                for (std::size_t i = 0; i < files.size(); ++i) {
+                    const QString name = QString::fromStdString(files[i]);
+                    if (!(*infos)[i].exists)
+                        recentFiles_.removeAll(name);
+                    else {
+                        recentFileInfo_[name] = QString::fromStdString(
+                                (*infos)[i].size + "|" + (*infos)[i].time);
+                    }
+                }
+                updateRecentFileActions();
+            });
+}
+
+
 QString MainWindow::strippedName(const QString &fullFileName)
 {
     return QFileInfo(fullFileName).fileName();
@@ -812,6 +952,14 @@ void MainWindow::createActionsForFileMenu() {
     connect(ui->actionOpen, SIGNAL(triggered()), this, SLOT(onOpen()));
     connect(ui->actionSave, SIGNAL(triggered()), this, SLOT(onSave()));
 
+    QAction* actionOpenProject = new QAction("Open Project...", this);
+    connect(actionOpenProject, SIGNAL(triggered()), this, SLOT(onOpenProject()));
+    QAction* actionSaveProject = new QAction("Save Project...", this);
+    connect(actionSaveProject, SIGNAL(triggered()), this, SLOT(onSaveProject()));
+    ui->menuFile->addSeparator();
+    ui->menuFile->addAction(actionOpenProject);
+    ui->menuFile->addAction(actionSaveProject);
+
     actionSeparator = ui->menuFile->addSeparator();
 
     QList<QAction*> actions;
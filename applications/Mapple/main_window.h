@@ -32,6 +32,7 @@
 #include <QMainWindow>
 #include <QProgressBar>
 #include <QLabel>
+#include <QVariantMap>
 
 #include <easy3d/util/progress.h>
 #include <easy3d/core/types.h>
@@ -43,8 +44,10 @@ namespace Ui {
 
 namespace easy3d {
     class Model;
+    class OperationExecutor;
 }
 
+class ModelStatistics;
 class PaintCanvas;
 class WidgetPointsDrawable;
 class WidgetLinesDrawable;
@@ -60,6 +63,16 @@ public:
 
     PaintCanvas* viewer() { return viewer_; }
 
+    /// The background executor for long-running algorithms. Submit the heavy work together with
+    /// the model it operates on; deliver the result to the viewer in the completion callback
+    /// (which runs on the UI thread). \see OperationExecutor.
+    easy3d::OperationExecutor* executor() { return executor_; }
+
+    /// Lazily computed, cached model statistics (components, genus, area, volume, memory).
+    /// UI panels query it instead of calling into the algorithms directly, so selecting a
+    /// heavy model never stalls the UI. \see ModelStatistics.
+    ModelStatistics* statistics() { return statistics_; }
+
     void setCurrentFile(const QString &fileName);
 
     void updateUi(); // entire ui: window tile, rendering panel, model panel
@@ -77,6 +90,8 @@ private slots:
     // file
     bool onOpen();
     bool onSave();
+    bool onOpenProject();
+    bool onSaveProject();
     void onOpenRecentFile();
     void onClearRecentFiles();
 
@@ -149,6 +164,10 @@ private slots:
     void updateStatusBar();
     void cancelTask();
 
+    // background operations
+    void updateProgress(int value, bool show_text, bool update_viewer);
+    void pollOperations();
+
     // about
     void onAbout();
     void showManual();
@@ -180,14 +199,21 @@ private:
     void updateWindowTitle();
 
     void updateRecentFileActions();
+    // stats the recent files on a worker thread and updates the menu (and the cached metadata)
+    // when done. The menu itself is built from the cache only, so a slow (e.g., network) drive
+    // never delays startup or painting.
+    void refreshRecentFileInfo();
     QString strippedName(const QString &fullFileName);
 
     void notify(std::size_t value, bool show_text = true, bool update_viewer = true) override ;
 
 private:
     PaintCanvas*   viewer_;
+    easy3d::OperationExecutor* executor_;
+    ModelStatistics* statistics_;
 
     QStringList recentFiles_;
+    QVariantMap recentFileInfo_;    // path -> "size|mtime", persisted with the settings
     QString		curDataDirectory_;
 
     enum { MaxRecentFiles = 5 };
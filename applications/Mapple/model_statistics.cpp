@@ -0,0 +1,162 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "model_statistics.h"
+
+#include <memory>
+
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/algo/surface_mesh_components.h>
+#include <easy3d/algo/surface_mesh_topology.h>
+#include <easy3d/algo/surface_mesh_geometry.h>
+#include <easy3d/util/operation_executor.h>
+
+using namespace easy3d;
+
+
+namespace {
+    const char* name_of(ModelStatistics::Statistic stat) {
+        switch (stat) {
+            case ModelStatistics::NUM_COMPONENTS:   return "number of components";
+            case ModelStatistics::GENUS:            return "genus";
+            case ModelStatistics::AREA:             return "surface area";
+            case ModelStatistics::VOLUME:           return "volume";
+            case ModelStatistics::MEMORY:           return "memory usage";
+            default:                                return "unknown";
+        }
+    }
+}
+
+
+ModelStatistics::ModelStatistics(OperationExecutor* executor)
+    : executor_(executor)
+{
+}
+
+
+bool ModelStatistics::query(SurfaceMesh* mesh, Statistic stat, double& value, Callback on_ready) {
+    if (!mesh || stat < 0 || stat >= NUM_STATISTICS)
+        return false;
+
+    Entry& entry = cache_[mesh][stat];
+    if (entry.state == Entry::READY && entry.version == mesh->structural_version()) {
+        value = entry.value;
+        return true;
+    }
+
+    if (on_ready)
+        entry.waiting.push_back(on_ready);
+    if (entry.state == Entry::PENDING)  // already in flight; don't schedule it again
+        return false;
+    entry.state = Entry::PENDING;
+
+    // the version is recorded when the job actually runs: the executor serializes operations
+    // per model, so by then all previously submitted edits of this mesh have been applied and
+    // the version describes exactly the mesh the statistics were computed from
+    auto version = std::make_shared<std::size_t>(0);
+    auto results = std::make_shared< std::vector< std::pair<Statistic, double> > >();
+    executor_->submit(mesh, std::string("statistics: ") + name_of(stat),
+        [mesh, stat, version, results]() {      // on a worker
+            *version = mesh->structural_version();
+            compute(mesh, stat, *results);
+        },
+        [this, mesh, version, results]() {      // on the polling thread
+            auto pos = cache_.find(mesh);
+            if (pos == cache_.end())
+                return;     // the model was removed while the statistics were being computed
+            for (std::size_t i = 0; i < results->size(); ++i) {
+                Entry& e = pos->second[(*results)[i].first];
+                e.state = Entry::READY;
+                e.version = *version;
+                e.value = (*results)[i].second;
+                std::vector<Callback> waiting;
+                waiting.swap(e.waiting);
+                for (std::size_t j = 0; j < waiting.size(); ++j)
+                    waiting[j](mesh, (*results)[i].first, e.value);
+            }
+        }
+    );
+    return false;
+}
+
+
+void ModelStatistics::invalidate(const SurfaceMesh* mesh) {
+    auto pos = cache_.find(mesh);
+    if (pos != cache_.end()) {
+        for (std::size_t i = 0; i < NUM_STATISTICS; ++i) {
+            if (pos->second[i].state == Entry::READY)
+                pos->second[i].state = Entry::INVALID;
+        }
+    }
+}
+
+
+void ModelStatistics::invalidate(const SurfaceMesh* mesh, Statistic stat) {
+    auto pos = cache_.find(mesh);
+    if (pos != cache_.end() && pos->second[stat].state == Entry::READY)
+        pos->second[stat].state = Entry::INVALID;
+}
+
+
+void ModelStatistics::remove(const Model* model) {
+    cache_.erase(model);
+}
+
+
+void ModelStatistics::compute(SurfaceMesh* mesh, Statistic stat,
+                              std::vector< std::pair<Statistic, double> >& results)
+{
+    switch (stat) {
+        case NUM_COMPONENTS:
+        case GENUS: {
+            const auto& components = SurfaceMeshComponent::extract(mesh);
+            results.push_back(std::make_pair(NUM_COMPONENTS, double(components.size())));
+            long genus = 0;
+            for (std::size_t i = 0; i < components.size(); ++i) {
+                SurfaceMeshTopology topo(&components[i]);
+                // Euler-Poincare: chi = 2 - 2g - b, thus g = (2 - chi - b) / 2
+                const long g = (2 - topo.euler_poincare() - long(topo.number_of_borders())) / 2;
+                if (g > 0)  // guards against non-manifold components
+                    genus += g;
+            }
+            results.push_back(std::make_pair(GENUS, double(genus)));
+            break;
+        }
+
+        case AREA:
+        case VOLUME: {
+            const auto& m = geom::metrics(mesh);    // one sweep gives both
+            results.push_back(std::make_pair(AREA, double(m.area)));
+            results.push_back(std::make_pair(VOLUME, double(m.volume)));
+            break;
+        }
+
+        case MEMORY:
+            results.push_back(std::make_pair(MEMORY, double(mesh->memory_usage())));
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MODEL_STATISTICS_H
+#define MODEL_STATISTICS_H
+
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace easy3d {
+    class Model;
+    class SurfaceMesh;
+    class OperationExecutor;
+}
+
+/**
+ * \brief Lazily computed, cached statistics of the models in the viewer.
+ *
+ * \details The model info UI used to compute component counts, area, etc. eagerly whenever the
+ *      selection changed, which stalls the UI on big meshes. This service computes each statistic
+ *      on a worker (through the executor, so it never runs concurrently with an algorithm
+ *      mutating the same model) on first request only, and caches the result keyed to the mesh's
+ *      structural_version(): a statistic is recomputed only after the mesh actually changed.
+ *      Statistics that fall out of one sweep together (area and volume; components and genus)
+ *      are computed and cached together.
+ *
+ *      All methods must be called from the thread that polls the executor (the UI thread); the
+ *      cache is not locked.
+ */
+class ModelStatistics {
+public:
+    enum Statistic {
+        NUM_COMPONENTS = 0, ///< number of connected components
+        GENUS,              ///< total genus, summed over the components
+        AREA,               ///< surface area (assumes triangular faces)
+        VOLUME,             ///< enclosed volume (meaningful for closed meshes only)
+        MEMORY,             ///< memory occupied by the mesh, in bytes
+        NUM_STATISTICS
+    };
+
+    typedef std::function<void(easy3d::SurfaceMesh*, Statistic, double)> Callback;
+
+    explicit ModelStatistics(easy3d::OperationExecutor* executor);
+
+    /**
+     * \brief Requests a statistic of \p mesh.
+     * \details If the statistic is cached and the mesh has not been structurally modified since
+     *      it was computed, writes it to \p value and returns true. Otherwise returns false and
+     *      schedules the computation (unless one is already in flight); \p on_ready is then
+     *      called on the polling thread once the value is available. Repeated queries while a
+     *      computation is in flight do not schedule it again, so calling this from a paint/update
+     *      path is fine.
+     * \attention Do not delete \p mesh while the executor reports it busy.
+     */
+    bool query(easy3d::SurfaceMesh* mesh, Statistic stat, double& value,
+               Callback on_ready = Callback());
+
+    /// \brief Discards all cached statistics of \p mesh. Structural edits are detected
+    ///     automatically through structural_version(); call this after geometry-only edits
+    ///     (e.g., smoothing, noise), which change area and volume without bumping the version.
+    void invalidate(const easy3d::SurfaceMesh* mesh);
+
+    /// \brief Discards one cached statistic of \p mesh.
+    void invalidate(const easy3d::SurfaceMesh* mesh, Statistic stat);
+
+    /// \brief Forgets \p model entirely. Call this before a model is deleted.
+    void remove(const easy3d::Model* model);
+
+private:
+    // computes 'stat' (and the statistics that come for free with it) on the calling thread
+    static void compute(easy3d::SurfaceMesh* mesh, Statistic stat,
+                        std::vector< std::pair<Statistic, double> >& results);
+
+private:
+    struct Entry {
+        Entry() : state(INVALID), version(0), value(0.0) {}
+        enum State { INVALID, PENDING, READY } state;
+        std::size_t version;    // structural_version() of the mesh when the value was computed
+        double      value;
+        std::vector<Callback> waiting;  // callbacks of the queries made while PENDING
+    };
+
+    easy3d::OperationExecutor* executor_;
+    std::unordered_map<const easy3d::Model*, std::array<Entry, NUM_STATISTICS> > cache_;
+};
+
+
+#endif  // MODEL_STATISTICS_H
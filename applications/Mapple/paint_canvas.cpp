@@ -149,9 +149,8 @@ void PaintCanvas::initializeGL() {
     func_->initializeOpenGLFunctions();
 
     OpenglInfo::init();
-#ifndef NDEBUG
-    opengl::setup_gl_debug_callback();
-#endif
+    if (setting::gl_debug_output)
+        opengl::setup_gl_debug_callback();
 
     if (!func_->hasOpenGLFeature(QOpenGLFunctions::Multisample))
         throw std::runtime_error("Multisample not supported on this machine!!! ViewerQt may not run properly");
@@ -969,22 +968,21 @@ void PaintCanvas::drawCornerAxes() {
 
     const mat4 &proj = transform::ortho(-1, 1, -1, 1, -1, 1);
     const mat4 &view = camera_->orientation().inverse().matrix();
-    const mat4 &MVP = proj * view;
 
+    ShaderProgram::FrameBlock frame_block;
+    frame_block.MVP = proj * view;
     // camera position is defined in world coordinate system.
-    const vec3 &wCamPos = camera_->position();
+    frame_block.wCamPos = camera_->position();
     // it can also be computed as follows:
     //const vec3& wCamPos = invMV * vec4(0, 0, 0, 1);
     const mat4 &MV = camera_->modelViewMatrix();
-    const vec4 &wLightPos = inverse(MV) * setting::light_position;
+    frame_block.wLightPos = vec3(inverse(MV) * setting::light_position);
 
     program->bind();
-    program->set_uniform("MVP", MVP)
-            ->set_uniform("lighting", true)
+    ShaderProgram::upload_block("FrameBlock", &frame_block, sizeof(frame_block));
+    program->set_uniform("lighting", true)
             ->set_uniform("two_sides_lighting", false)
             ->set_uniform("smooth_shading", true)
-            ->set_uniform("wLightPos", wLightPos)
-            ->set_uniform("wCamPos", wCamPos)
             ->set_uniform("ssaoEnabled", false)
             ->set_uniform("per_vertex_color", true)
             ->set_uniform("distinct_back_color", false)
@@ -0,0 +1,486 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "session.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <easy3d/core/graph.h>
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/core/poly_mesh.h>
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/fileio/graph_io.h>
+#include <easy3d/fileio/point_cloud_io.h>
+#include <easy3d/fileio/poly_mesh_io.h>
+#include <easy3d/fileio/surface_mesh_io.h>
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/drawable_lines.h>
+#include <easy3d/renderer/drawable_points.h>
+#include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/manipulated_camera_frame.h>
+#include <easy3d/renderer/renderer.h>
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/logging.h>
+
+#include "paint_canvas.h"
+
+using namespace easy3d;
+
+
+namespace internal {
+
+    static const char MAGIC[4] = { 'M', 'P', 'R', 'J' };
+    static const std::uint32_t VERSION = 1;
+
+    // the kind of model a section stores
+    enum ModelKind : std::uint32_t {
+        KIND_POINT_CLOUD = 1,
+        KIND_SURFACE_MESH = 2,
+        KIND_GRAPH = 3,
+        KIND_POLY_MESH = 4
+    };
+
+    // ------------------------------------------------------------ scalar helpers
+
+    inline void write_uint32(std::ostream& output, std::uint32_t value) {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    inline std::uint32_t read_uint32(std::istream& input) {
+        std::uint32_t value = 0;
+        input.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+
+    inline void write_uint64(std::ostream& output, std::uint64_t value) {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    inline std::uint64_t read_uint64(std::istream& input) {
+        std::uint64_t value = 0;
+        input.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+
+    inline void write_float(std::ostream& output, float value) {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    inline float read_float(std::istream& input) {
+        float value = 0;
+        input.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+
+    inline void write_string(std::ostream& output, const std::string& str) {
+        write_uint32(output, static_cast<std::uint32_t>(str.size()));
+        output.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+
+    inline std::string read_string(std::istream& input) {
+        const std::uint32_t size = read_uint32(input);
+        std::string str(size, '\0');
+        input.read(&str[0], size);
+        return str;
+    }
+
+    inline void write_vec3(std::ostream& output, const vec3& v) {
+        output.write(reinterpret_cast<const char*>(&v), sizeof(vec3));
+    }
+
+    inline vec3 read_vec3(std::istream& input) {
+        vec3 v;
+        input.read(reinterpret_cast<char*>(&v), sizeof(vec3));
+        return v;
+    }
+
+    inline void write_vec4(std::ostream& output, const vec4& v) {
+        output.write(reinterpret_cast<const char*>(&v), sizeof(vec4));
+    }
+
+    inline vec4 read_vec4(std::istream& input) {
+        vec4 v;
+        input.read(reinterpret_cast<char*>(&v), sizeof(vec4));
+        return v;
+    }
+
+    // ------------------------------------------------------------ drawable state
+
+    // the persistent subset of easy3d::State. The texture pointer and the SSAO texture id
+    // are runtime handles and are not stored; textured drawables fall back to their
+    // property coloring until the texture is reassigned.
+    void write_state(std::ostream& output, const State* state) {
+        write_uint32(output, state->is_visible() ? 1 : 0);
+        write_uint32(output, static_cast<std::uint32_t>(state->coloring_method()));
+        write_uint32(output, static_cast<std::uint32_t>(state->property_location()));
+        write_string(output, state->property_name());
+        write_vec4(output, state->color());
+        write_uint32(output, state->lighting() ? 1 : 0);
+        write_uint32(output, state->lighting_two_sides() ? 1 : 0);
+        write_uint32(output, state->distinct_back_color() ? 1 : 0);
+        write_vec4(output, state->back_color());
+        write_uint32(output, state->clamp_range() ? 1 : 0);
+        write_float(output, state->clamp_lower());
+        write_float(output, state->clamp_upper());
+        write_vec3(output, state->material().ambient);
+        write_vec3(output, state->material().specular);
+        write_float(output, state->material().shininess);
+    }
+
+    void read_state(std::istream& input, State* state) {
+        const bool visible = read_uint32(input) != 0;
+        const auto method = static_cast<State::Method>(read_uint32(input));
+        const auto location = static_cast<State::PropertyLocation>(read_uint32(input));
+        const std::string property_name = read_string(input);
+        const vec4 color = read_vec4(input);
+
+        state->set_visible(visible);
+        state->set_coloring(method, location, property_name);
+        if (method == State::UNIFORM_COLOR)
+            state->set_uniform_coloring(color);
+        state->set_lighting(read_uint32(input) != 0);
+        state->set_lighting_two_sides(read_uint32(input) != 0);
+        state->set_distinct_back_color(read_uint32(input) != 0);
+        state->set_back_color(read_vec4(input));
+        state->set_clamp_range(read_uint32(input) != 0);
+        state->set_clamp_lower(read_float(input));
+        state->set_clamp_upper(read_float(input));
+        State::Material material;
+        material.ambient = read_vec3(input);
+        material.specular = read_vec3(input);
+        material.shininess = read_float(input);
+        state->set_material(material);
+    }
+
+    void write_drawables(std::ostream& output, const Renderer* renderer) {
+        write_uint32(output, static_cast<std::uint32_t>(renderer->points_drawables().size()));
+        for (auto d : renderer->points_drawables()) {
+            write_string(output, d->name());
+            write_state(output, d);
+            write_float(output, d->point_size());
+            write_uint32(output, static_cast<std::uint32_t>(d->impostor_type()));
+        }
+        write_uint32(output, static_cast<std::uint32_t>(renderer->lines_drawables().size()));
+        for (auto d : renderer->lines_drawables()) {
+            write_string(output, d->name());
+            write_state(output, d);
+            write_float(output, d->line_width());
+            write_uint32(output, static_cast<std::uint32_t>(d->impostor_type()));
+        }
+        write_uint32(output, static_cast<std::uint32_t>(renderer->triangles_drawables().size()));
+        for (auto d : renderer->triangles_drawables()) {
+            write_string(output, d->name());
+            write_state(output, d);
+            write_uint32(output, d->smooth_shading() ? 1 : 0);
+            write_float(output, d->opacity());
+        }
+    }
+
+    // drawables are matched by name: the renderer of the restored model creates the default
+    // set, and records for drawables that no longer exist are skipped gracefully
+    void read_drawables(std::istream& input, Renderer* renderer) {
+        const std::uint32_t num_points = read_uint32(input);
+        for (std::uint32_t i = 0; i < num_points; ++i) {
+            const std::string name = read_string(input);
+            State state;
+            read_state(input, &state);
+            const float point_size = read_float(input);
+            const auto impostor = static_cast<PointsDrawable::ImposterType>(read_uint32(input));
+            if (auto d = renderer ? renderer->get_points_drawable(name) : nullptr) {
+                static_cast<State&>(*d) = state;
+                d->set_point_size(point_size);
+                d->set_impostor_type(impostor);
+            }
+        }
+        const std::uint32_t num_lines = read_uint32(input);
+        for (std::uint32_t i = 0; i < num_lines; ++i) {
+            const std::string name = read_string(input);
+            State state;
+            read_state(input, &state);
+            const float line_width = read_float(input);
+            const auto impostor = static_cast<LinesDrawable::ImposterType>(read_uint32(input));
+            if (auto d = renderer ? renderer->get_lines_drawable(name) : nullptr) {
+                static_cast<State&>(*d) = state;
+                d->set_line_width(line_width);
+                d->set_impostor_type(impostor);
+            }
+        }
+        const std::uint32_t num_triangles = read_uint32(input);
+        for (std::uint32_t i = 0; i < num_triangles; ++i) {
+            const std::string name = read_string(input);
+            State state;
+            read_state(input, &state);
+            const bool smooth = read_uint32(input) != 0;
+            const float opacity = read_float(input);
+            if (auto d = renderer ? renderer->get_triangles_drawable(name) : nullptr) {
+                static_cast<State&>(*d) = state;
+                d->set_smooth_shading(smooth);
+                d->set_opacity(opacity);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------ model caches
+
+    inline std::string cache_directory(const std::string& project_file) {
+        return file_system::name_less_extension(project_file) + "_cache";
+    }
+
+    // writes the model's native binary cache; returns the cache file name ("" for model
+    // types without an e3d cache - those are reloaded from their source file)
+    std::string write_cache(const std::string& directory, std::size_t index, const Model* model) {
+        std::string cache;
+        if (dynamic_cast<const PointCloud*>(model) ||
+            dynamic_cast<const SurfaceMesh*>(model) ||
+            dynamic_cast<const PolyMesh*>(model)) {
+            char name[64];
+            std::snprintf(name, sizeof(name), "/model_%zu.e3d", index);
+            cache = directory + name;
+        }
+        else
+            return "";
+
+        bool saved = false;
+        if (auto cloud = dynamic_cast<const PointCloud*>(model))
+            saved = io::save_e3d(cache, cloud);
+        else if (auto mesh = dynamic_cast<const SurfaceMesh*>(model))
+            saved = io::save_e3d(cache, mesh);
+        else if (auto poly = dynamic_cast<const PolyMesh*>(model))
+            saved = io::save_e3d(cache, poly);
+        return saved ? cache : "";
+    }
+
+    // loads a model from its cache, falling back to the original source file
+    Model* load_model(std::uint32_t kind, const std::string& source, const std::string& cache) {
+        switch (kind) {
+            case KIND_POINT_CLOUD: {
+                if (!cache.empty()) {
+                    auto cloud = new PointCloud;
+                    if (io::load_e3d(cache, cloud))
+                        return cloud;
+                    delete cloud;
+                }
+                return PointCloudIO::load(source);
+            }
+            case KIND_SURFACE_MESH: {
+                if (!cache.empty()) {
+                    auto mesh = new SurfaceMesh;
+                    if (io::load_e3d(cache, mesh))
+                        return mesh;
+                    delete mesh;
+                }
+                return SurfaceMeshIO::load(source);
+            }
+            case KIND_GRAPH:
+                return GraphIO::load(source);
+            case KIND_POLY_MESH: {
+                if (!cache.empty()) {
+                    auto poly = new PolyMesh;
+                    if (io::load_e3d(cache, poly))
+                        return poly;
+                    delete poly;
+                }
+                return PolyMeshIO::load(source);
+            }
+            default:
+                LOG(ERROR) << "unknown model kind in project file: " << kind;
+                return nullptr;
+        }
+    }
+
+}
+
+
+bool Session::save(const std::string& file_name, const PaintCanvas* viewer) {
+    if (!viewer) {
+        LOG(ERROR) << "null viewer";
+        return false;
+    }
+
+    const std::string directory = internal::cache_directory(file_name);
+    if (!file_system::is_directory(directory) && !file_system::create_directory(directory)) {
+        LOG(ERROR) << "could not create the model cache directory: " << directory;
+        return false;
+    }
+
+    // sections are assembled in memory first, so the index (which needs the offsets) can be
+    // written in one pass before the blobs
+    std::vector< std::pair<std::string, std::string> > sections;
+
+    {   // camera
+        std::ostringstream camera(std::ios::binary);
+        const Camera* cam = viewer->camera();
+        internal::write_uint32(camera, static_cast<std::uint32_t>(cam->type()));
+        internal::write_float(camera, cam->zClippingCoefficient());
+        internal::write_float(camera, cam->zNearCoefficient());
+        internal::write_float(camera, cam->sceneRadius());
+        internal::write_float(camera, cam->fieldOfView());
+        internal::write_vec3(camera, cam->sceneCenter());
+        internal::write_vec3(camera, cam->frame()->position());
+        const quat& orientation = cam->frame()->orientation();
+        for (int i = 0; i < 4; ++i)
+            internal::write_float(camera, orientation[i]);
+        sections.emplace_back("camera", camera.str());
+    }
+
+    std::size_t index = 0;
+    for (auto model : viewer->models()) {
+        std::uint32_t kind = 0;
+        if (dynamic_cast<PointCloud*>(model))        kind = internal::KIND_POINT_CLOUD;
+        else if (dynamic_cast<SurfaceMesh*>(model))  kind = internal::KIND_SURFACE_MESH;
+        else if (dynamic_cast<Graph*>(model))        kind = internal::KIND_GRAPH;
+        else if (dynamic_cast<PolyMesh*>(model))     kind = internal::KIND_POLY_MESH;
+        else {
+            LOG(WARNING) << "model of unknown type not stored in the project: " << model->name();
+            continue;
+        }
+
+        std::ostringstream record(std::ios::binary);
+        internal::write_uint32(record, kind);
+        internal::write_string(record, model->name());
+        internal::write_string(record, internal::write_cache(directory, index, model));
+        internal::write_drawables(record, model->renderer());
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "model:%zu", index);
+        sections.emplace_back(name, record.str());
+        ++index;
+    }
+
+    std::ofstream output(file_name.c_str(), std::fstream::binary);
+    if (output.fail()) {
+        LOG(ERROR) << "could not open file: " << file_name;
+        return false;
+    }
+
+    // header + index + blobs. Offsets in the index are absolute, so a reader can map the
+    // file and jump straight to a section.
+    output.write(internal::MAGIC, 4);
+    internal::write_uint32(output, internal::VERSION);
+    internal::write_uint32(output, static_cast<std::uint32_t>(sections.size()));
+
+    std::uint64_t index_size = 0;
+    for (const auto& section : sections)
+        index_size += 4 + section.first.size() + 8 + 8;
+    std::uint64_t offset = 4 + 4 + 4 + index_size;
+    for (const auto& section : sections) {
+        internal::write_string(output, section.first);
+        internal::write_uint64(output, offset);
+        internal::write_uint64(output, section.second.size());
+        offset += section.second.size();
+    }
+    for (const auto& section : sections)
+        output.write(section.second.data(), static_cast<std::streamsize>(section.second.size()));
+
+    LOG(INFO) << "session saved to: " << file_name << " (" << index << " models)";
+    return output.good();
+}
+
+
+bool Session::load(const std::string& file_name, PaintCanvas* viewer) {
+    if (!viewer) {
+        LOG(ERROR) << "null viewer";
+        return false;
+    }
+
+    std::ifstream input(file_name.c_str(), std::fstream::binary);
+    if (input.fail()) {
+        LOG(ERROR) << "could not open file: " << file_name;
+        return false;
+    }
+
+    char magic[4];
+    input.read(magic, 4);
+    if (input.fail() || std::memcmp(magic, internal::MAGIC, 4) != 0) {
+        LOG(ERROR) << "not a Mapple project file: " << file_name;
+        return false;
+    }
+    const std::uint32_t version = internal::read_uint32(input);
+    if (version != internal::VERSION) {
+        LOG(ERROR) << "unsupported project file version: " << version;
+        return false;
+    }
+
+    const std::uint32_t num_sections = internal::read_uint32(input);
+    std::vector<std::string> names(num_sections);
+    std::map<std::string, std::pair<std::uint64_t, std::uint64_t> > sections;
+    for (std::uint32_t i = 0; i < num_sections; ++i) {
+        names[i] = internal::read_string(input);
+        const std::uint64_t offset = internal::read_uint64(input);
+        const std::uint64_t size = internal::read_uint64(input);
+        sections[names[i]] = std::make_pair(offset, size);
+    }
+    if (input.fail()) {
+        LOG(ERROR) << "corrupted project file: " << file_name;
+        return false;
+    }
+
+    // models first (in the order they were saved), so the restored camera is not disturbed
+    // by fit-to-screen logic triggered by model additions
+    for (const auto& name : names) {
+        if (name.compare(0, 6, "model:") != 0)
+            continue;
+        input.clear();
+        input.seekg(static_cast<std::streamoff>(sections[name].first));
+
+        const std::uint32_t kind = internal::read_uint32(input);
+        const std::string source = internal::read_string(input);
+        const std::string cache = internal::read_string(input);
+
+        Model* model = internal::load_model(kind, source, cache);
+        if (!model) {
+            LOG(WARNING) << "could not restore model: " << source;
+            continue;
+        }
+        model->set_name(source);
+        viewer->addModel(model);
+        internal::read_drawables(input, model->renderer());
+    }
+
+    const auto camera_section = sections.find("camera");
+    if (camera_section != sections.end()) {
+        input.clear();
+        input.seekg(static_cast<std::streamoff>(camera_section->second.first));
+        Camera* cam = viewer->camera();
+        cam->setType(static_cast<Camera::Type>(internal::read_uint32(input)));
+        cam->setZClippingCoefficient(internal::read_float(input));
+        cam->setZNearCoefficient(internal::read_float(input));
+        cam->setSceneRadius(internal::read_float(input));
+        cam->setFieldOfView(internal::read_float(input));
+        cam->setSceneCenter(internal::read_vec3(input));
+        const vec3 position = internal::read_vec3(input);
+        quat orientation;
+        for (int i = 0; i < 4; ++i)
+            orientation[i] = internal::read_float(input);
+        cam->frame()->setPositionAndOrientation(position, orientation);
+    }
+
+    viewer->update();
+    LOG(INFO) << "session restored from: " << file_name;
+    return true;
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPLE_SESSION_H
+#define MAPPLE_SESSION_H
+
+#include <string>
+
+class PaintCanvas;
+
+/**
+ * \brief Fast binary serialization of a Mapple session (a "project").
+ *
+ * \details A project file restores yesterday's session without reloading and re-processing
+ *      every source file: it stores the camera state, the rendering state of every drawable
+ *      of every model (see easy3d::State), and for each model a reference to a native binary
+ *      cache (the e3d flat property dump) written next to the project file. Loading a cached
+ *      model is a sequential read plus a pointer fixup - no parsing, no re-tessellation.
+ *
+ *      The file is a single indexed container: a small header, an index of named sections
+ *      (name, offset, size), then the section blobs. Sections are located through the index,
+ *      so a reader maps or seeks straight to what it needs. The model data itself stays in
+ *      the per-model cache files ("<project>_cache/model_<i>.e3d"); models whose type has no
+ *      e3d cache (graphs) are reloaded from their original source file.
+ */
+class Session {
+public:
+    /// \brief Saves the current session of \p viewer (models, drawable states, camera) to
+    ///     \p file_name, writing the model caches next to it. Returns true on success.
+    static bool save(const std::string& file_name, const PaintCanvas* viewer);
+
+    /// \brief Restores a session into \p viewer: models are added (loaded from their caches
+    ///     when possible, from the original files otherwise), drawable states are applied,
+    ///     and the camera is restored. Returns true if at least the index was readable.
+    static bool load(const std::string& file_name, PaintCanvas* viewer);
+};
+
+#endif  // MAPPLE_SESSION_H
@@ -189,19 +189,18 @@ void WidgetCheckerSphere::paintGL() {
     if (!program)
         return;
 
-    const mat4& MVP = camera_->modelViewProjectionMatrix();
+    ShaderProgram::FrameBlock frame_block;
+    frame_block.MVP = camera_->modelViewProjectionMatrix();
     // camera position is defined in world coordinate system.
-    const vec3& wCamPos = camera_->position();
+    frame_block.wCamPos = camera_->position();
     // it can also be computed as follows:
     //const vec3& wCamPos = invMV * vec4(0, 0, 0, 1);
     const mat4& MV = camera_->modelViewMatrix();
-    const vec4& wLightPos = inverse(MV) * setting::light_position;
+    frame_block.wLightPos = vec3(inverse(MV) * setting::light_position);
 
     program->bind();
-    program->set_uniform("MVP", MVP)
-            ->set_uniform("lighting", true)
-            ->set_uniform("wLightPos", wLightPos)
-            ->set_uniform("wCamPos", wCamPos)
+    ShaderProgram::upload_block("FrameBlock", &frame_block, sizeof(frame_block));
+    program->set_uniform("lighting", true)
             ->set_uniform("two_sides_lighting", false)
             ->set_uniform("distinct_back_color", false)
             ->set_uniform("smooth_shading", true)
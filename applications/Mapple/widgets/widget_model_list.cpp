@@ -1,5 +1,6 @@
 #include "widget_model_list.h"
 #include "main_window.h"
+#include "model_statistics.h"
 #include "paint_canvas.h"
 
 #include <easy3d/core/graph.h>
@@ -430,8 +431,10 @@ void WidgetModelList::deleteSelected() {
 	const QList<QTreeWidgetItem*>& items = selectedItems();
 	for (int i = 0; i < items.size(); ++i) {
 		ModelItem* item = dynamic_cast<ModelItem*>(items[i]);
-		if (item)
+		if (item) {
+            mainWindow_->statistics()->remove(item->model());
             viewer()->deleteModel(item->model());
+        }
 	}
 
 	Model* current_model = viewer()->currentModel();
@@ -602,6 +605,7 @@ void WidgetModelList::addModel(Model *model, bool make_current) {
 
 
 void WidgetModelList::deleteModel(Model *model, bool fit) {
+    mainWindow_->statistics()->remove(model);
     viewer()->deleteModel(model);
     Model *active_model = viewer()->currentModel();
     if (!active_model)  // no model exists
@@ -679,6 +683,7 @@ void WidgetModelList::mergeModels(const std::vector<Model *> &models) {
 
 	for (unsigned int i = 0; i < to_delete.size(); ++i) {
 		Model* model = to_delete[i];
+        mainWindow_->statistics()->remove(model);
 		viewer()->deleteModel(model);
 	}
 
@@ -714,6 +719,7 @@ void WidgetModelList::decomposeModel(Model *model) {
 	}
 
     // delete the original model
+    mainWindow_->statistics()->remove(mesh);
     viewer()->deleteModel(mesh);
     updateModelList();
     mainWindow_->updateUi();
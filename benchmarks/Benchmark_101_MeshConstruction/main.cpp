@@ -0,0 +1,90 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/manifold_builder.h>
+#include <easy3d/util/logging.h>
+
+#include <benchmarks/benchmark.h>
+
+
+using namespace easy3d;
+
+
+// This benchmark measures the construction of a surface mesh from raw vertices and connectivity:
+//      - directly through SurfaceMesh::add_vertex()/add_triangle() (manifold input only);
+//      - through ManifoldBuilder (the recommended way, resolves non-manifoldness).
+// The input is a procedurally generated n x n triangulated grid, so the runs are reproducible
+// and do not depend on resource files.
+
+
+int main(int argc, char** argv) {
+    // Initialize logging.
+    logging::initialize();
+
+    const int n = 512;  // the grid has n x n vertices and 2 * (n-1) * (n-1) triangles
+
+    std::vector<vec3> points;
+    points.reserve(n * n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j)
+            points.push_back(vec3(static_cast<float>(i), static_cast<float>(j), 0.0f));
+    }
+
+    std::vector<std::vector<int> > triangles;
+    triangles.reserve(2 * (n - 1) * (n - 1));
+    for (int i = 0; i < n - 1; ++i) {
+        for (int j = 0; j < n - 1; ++j) {
+            const int v00 = i * n + j, v01 = i * n + j + 1;
+            const int v10 = (i + 1) * n + j, v11 = (i + 1) * n + j + 1;
+            triangles.push_back({v00, v10, v11});
+            triangles.push_back({v00, v11, v01});
+        }
+    }
+
+    benchmark::Report report("mesh_construction");
+
+    report.run("SurfaceMesh::add_triangle", 5, [&]() {
+        SurfaceMesh mesh;
+        for (const auto& p : points)
+            mesh.add_vertex(p);
+        for (const auto& t : triangles)
+            mesh.add_triangle(SurfaceMesh::Vertex(t[0]), SurfaceMesh::Vertex(t[1]), SurfaceMesh::Vertex(t[2]));
+        CHECK_EQ(mesh.n_faces(), triangles.size());
+    });
+
+    report.run("ManifoldBuilder", 5, [&]() {
+        SurfaceMesh mesh;
+        ManifoldBuilder builder(&mesh);
+        builder.begin_surface();
+        for (const auto& p : points)
+            builder.add_vertex(p);
+        for (const auto& t : triangles)
+            builder.add_triangle(SurfaceMesh::Vertex(t[0]), SurfaceMesh::Vertex(t[1]), SurfaceMesh::Vertex(t[2]));
+        builder.end_surface(false);
+        CHECK_EQ(mesh.n_faces(), triangles.size());
+    });
+
+    return report.save(argc > 1 ? argv[1] : "mesh_construction.json") ? EXIT_SUCCESS : EXIT_FAILURE;
+}
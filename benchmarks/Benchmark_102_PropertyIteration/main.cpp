@@ -0,0 +1,105 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/manifold_builder.h>
+#include <easy3d/util/logging.h>
+
+#include <benchmarks/benchmark.h>
+
+
+using namespace easy3d;
+
+
+// This benchmark measures the traversal primitives of SurfaceMesh:
+//      - iterating a vertex property over all vertices;
+//      - the vertex-around-face circulator (per-face centroid);
+//      - the vertex-around-vertex circulator (per-vertex valence).
+// The input is a procedurally generated triangulated grid (see Benchmark_101_MeshConstruction).
+
+
+int main(int argc, char** argv) {
+    // Initialize logging.
+    logging::initialize();
+
+    const int n = 512;  // the grid has n x n vertices and 2 * (n-1) * (n-1) triangles
+
+    SurfaceMesh mesh;
+    ManifoldBuilder builder(&mesh);
+    builder.begin_surface();
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j)
+            builder.add_vertex(vec3(static_cast<float>(i), static_cast<float>(j), 0.0f));
+    }
+    for (int i = 0; i < n - 1; ++i) {
+        for (int j = 0; j < n - 1; ++j) {
+            const SurfaceMesh::Vertex v00(i * n + j), v01(i * n + j + 1);
+            const SurfaceMesh::Vertex v10((i + 1) * n + j), v11((i + 1) * n + j + 1);
+            builder.add_triangle(v00, v10, v11);
+            builder.add_triangle(v00, v11, v01);
+        }
+    }
+    builder.end_surface(false);
+
+    benchmark::Report report("property_iteration");
+
+    // prevents the compiler from optimizing the traversals away
+    volatile float guard = 0.0f;
+
+    auto points = mesh.get_vertex_property<vec3>("v:point");
+    report.run("vertex property sum", 20, [&]() {
+        vec3 sum(0, 0, 0);
+        for (auto v : mesh.vertices())
+            sum += points[v];
+        guard += sum.x;
+    });
+
+    report.run("face circulator (centroid)", 20, [&]() {
+        vec3 sum(0, 0, 0);
+        for (auto f : mesh.faces()) {
+            vec3 centroid(0, 0, 0);
+            float count = 0.0f;
+            for (auto v : mesh.vertices(f)) {
+                centroid += points[v];
+                count += 1.0f;
+            }
+            sum += centroid / count;
+        }
+        guard += sum.x;
+    });
+
+    report.run("vertex circulator (valence)", 20, [&]() {
+        std::size_t total = 0;
+        for (auto v : mesh.vertices()) {
+            for (auto vv : mesh.vertices(v)) {
+                (void) vv;
+                ++total;
+            }
+        }
+        guard += static_cast<float>(total);
+    });
+
+    (void) guard;
+    return report.save(argc > 1 ? argv[1] : "property_iteration.json") ? EXIT_SUCCESS : EXIT_FAILURE;
+}
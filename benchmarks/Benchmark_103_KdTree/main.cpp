@@ -0,0 +1,96 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/fileio/point_cloud_io.h>
+#include <easy3d/fileio/resources.h>
+#include <easy3d/kdtree/kdtree_search_ann.h>
+#include <easy3d/kdtree/kdtree_search_eth.h>
+#include <easy3d/kdtree/kdtree_search_flann.h>
+#include <easy3d/kdtree/kdtree_search_nanoflann.h>
+#include <easy3d/util/logging.h>
+
+#include <benchmarks/benchmark.h>
+
+
+using namespace easy3d;
+
+
+// This benchmark compares the four kd-tree backends (ANN, ETH, FLANN, NanoFLANN):
+//      - tree construction;
+//      - closest point query (for each point of the cloud);
+//      - K nearest neighbors query (K = 16, for each point of the cloud).
+// It reproduces the comparison documented in kdtree_search.h on the bunny point cloud.
+
+
+template <typename KdTree>
+static void benchmark_backend(benchmark::Report& report, const std::string& backend, PointCloud* cloud) {
+    KdTree tree;
+    report.run(backend + " build", 3, [&]() {
+        tree.begin();
+        tree.add_point_cloud(cloud);
+        tree.end();
+    });
+
+    const std::vector<vec3>& points = cloud->points();
+
+    volatile int guard = 0;
+    report.run(backend + " closest point", 3, [&]() {
+        int sum = 0;
+        for (const auto& p : points)
+            sum += tree.find_closest_point(p);
+        guard += sum;
+    });
+
+    report.run(backend + " knn (k=16)", 3, [&]() {
+        std::vector<int> neighbors;
+        for (const auto& p : points)
+            tree.find_closest_k_points(p, 16, neighbors);
+        guard += static_cast<int>(neighbors.size());
+    });
+    (void) guard;
+}
+
+
+int main(int argc, char** argv) {
+    // Initialize logging.
+    logging::initialize();
+
+    const std::string file_name = resource::directory() + "/data/bunny.bin";
+    PointCloud* cloud = PointCloudIO::load(file_name);
+    if (!cloud) {
+        LOG(ERROR) << "failed to load point cloud from file: " << file_name;
+        return EXIT_FAILURE;
+    }
+    LOG(INFO) << "point cloud has " << cloud->n_vertices() << " points";
+
+    benchmark::Report report("kdtree");
+    benchmark_backend<KdTreeSearch_ANN>(report, "ANN", cloud);
+    benchmark_backend<KdTreeSearch_ETH>(report, "ETH", cloud);
+    benchmark_backend<KdTreeSearch_FLANN>(report, "FLANN", cloud);
+    benchmark_backend<KdTreeSearch_NanoFLANN>(report, "NanoFLANN", cloud);
+
+    delete cloud;
+    return report.save(argc > 1 ? argv[1] : "kdtree.json") ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/graph.h>
+#include <easy3d/core/poly_mesh.h>
+#include <easy3d/fileio/point_cloud_io.h>
+#include <easy3d/fileio/surface_mesh_io.h>
+#include <easy3d/fileio/graph_io.h>
+#include <easy3d/fileio/poly_mesh_io.h>
+#include <easy3d/fileio/resources.h>
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/logging.h>
+
+#include <benchmarks/benchmark.h>
+
+
+using namespace easy3d;
+
+
+// This benchmark measures file loading for the fileio formats. To cover formats for which the
+// resource directory has no sample file, the benchmark first converts the resource models into
+// a scratch directory (one file per format) and then times the loads from there. The best of
+// several repetitions is recorded, so the numbers measure parsing with a warm file system cache.
+
+
+int main(int argc, char** argv) {
+    // Initialize logging.
+    logging::initialize();
+
+    const std::string dir = "benchmark_fileio_data";
+    if (!file_system::is_directory(dir))
+        file_system::create_directory(dir);
+
+    benchmark::Report report("fileio");
+
+    // point cloud formats
+    {
+        PointCloud* cloud = PointCloudIO::load(resource::directory() + "/data/bunny.bin");
+        if (!cloud) {
+            LOG(ERROR) << "failed to load the bunny point cloud";
+            return EXIT_FAILURE;
+        }
+        for (const std::string& ext : {"bin", "xyz", "bxyz", "ply"}) {
+            const std::string file_name = dir + "/cloud." + ext;
+            if (!PointCloudIO::save(file_name, cloud)) {
+                LOG(ERROR) << "failed to save point cloud to file: " << file_name;
+                continue;
+            }
+            report.run("PointCloud " + std::string(ext), 5, [&]() {
+                PointCloud* c = PointCloudIO::load(file_name);
+                CHECK_EQ(c->n_vertices(), cloud->n_vertices());
+                delete c;
+            });
+        }
+        delete cloud;
+    }
+
+    // surface mesh formats
+    {
+        SurfaceMesh* mesh = SurfaceMeshIO::load(resource::directory() + "/data/bunny.ply");
+        if (!mesh) {
+            LOG(ERROR) << "failed to load the bunny mesh";
+            return EXIT_FAILURE;
+        }
+        for (const std::string& ext : {"ply", "obj", "off", "stl"}) {
+            const std::string file_name = dir + "/mesh." + ext;
+            if (!SurfaceMeshIO::save(file_name, mesh)) {
+                LOG(ERROR) << "failed to save mesh to file: " << file_name;
+                continue;
+            }
+            report.run("SurfaceMesh " + std::string(ext), 5, [&]() {
+                SurfaceMesh* m = SurfaceMeshIO::load(file_name);
+                CHECK_EQ(m->n_faces(), mesh->n_faces());
+                delete m;
+            });
+        }
+        delete mesh;
+    }
+
+    // graph formats
+    {
+        const std::string file_name = resource::directory() + "/data/graph.ply";
+        report.run("Graph ply", 5, [&]() {
+            Graph* g = GraphIO::load(file_name);
+            CHECK_GT(g->n_edges(), 0);
+            delete g;
+        });
+    }
+
+    // polyhedral mesh formats
+    {
+        PolyMesh* mesh = PolyMeshIO::load(resource::directory() + "/data/sphere.plm");
+        if (!mesh) {
+            LOG(ERROR) << "failed to load the sphere polyhedral mesh";
+            return EXIT_FAILURE;
+        }
+        for (const std::string& ext : {"plm", "pmesh"}) {
+            const std::string file_name = dir + "/mesh." + ext;
+            if (!PolyMeshIO::save(file_name, mesh)) {
+                LOG(ERROR) << "failed to save polyhedral mesh to file: " << file_name;
+                continue;
+            }
+            report.run("PolyMesh " + std::string(ext), 5, [&]() {
+                PolyMesh* m = PolyMeshIO::load(file_name);
+                CHECK_EQ(m->n_cells(), mesh->n_cells());
+                delete m;
+            });
+        }
+        delete mesh;
+    }
+
+    return report.save(argc > 1 ? argv[1] : "fileio.json") ? EXIT_SUCCESS : EXIT_FAILURE;
+}
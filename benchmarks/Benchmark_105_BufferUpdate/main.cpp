@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/viewer/viewer.h>
+#include <easy3d/core/model.h>
+#include <easy3d/renderer/renderer.h>
+#include <easy3d/renderer/drawable_points.h>
+#include <easy3d/renderer/drawable_lines.h>
+#include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/buffers.h>
+#include <easy3d/fileio/resources.h>
+#include <easy3d/util/logging.h>
+
+#include <benchmarks/benchmark.h>
+
+
+using namespace easy3d;
+
+
+// This benchmark measures renderer::buffers::update() for every drawable of a model, i.e., the
+// cost of turning a model into GPU buffers (computing the render buffers from the geometry and
+// the active coloring scheme, and uploading them).
+//
+// Note: an OpenGL context is required, so the benchmark creates a viewer (the window shows up
+// briefly but the event loop is never entered).
+
+
+int main(int argc, char** argv) {
+    // Initialize logging.
+    logging::initialize();
+
+    // A viewer must be created first to have an OpenGL context (the event loop is never entered).
+    Viewer viewer("Benchmark_105_BufferUpdate");
+
+    const std::string file_name = resource::directory() + "/data/bunny.ply";
+    Model* model = viewer.add_model(file_name);
+    if (!model) {
+        LOG(ERROR) << "failed to load model from file: " << file_name;
+        return EXIT_FAILURE;
+    }
+
+    benchmark::Report report("buffer_update");
+
+    std::vector<Drawable*> drawables;
+    for (auto d : model->renderer()->points_drawables())    drawables.push_back(d);
+    for (auto d : model->renderer()->lines_drawables())     drawables.push_back(d);
+    for (auto d : model->renderer()->triangles_drawables()) drawables.push_back(d);
+
+    for (auto drawable : drawables) {
+        report.run("'" + drawable->name() + "'", 10, [&]() {
+            buffers::update(model, drawable);
+        });
+    }
+
+    return report.save(argc > 1 ? argv[1] : "buffer_update.json") ? EXIT_SUCCESS : EXIT_FAILURE;
+}
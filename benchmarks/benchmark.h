@@ -0,0 +1,119 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_BENCHMARK_BENCHMARK_H
+#define EASY3D_BENCHMARK_BENCHMARK_H
+
+#include <easy3d/util/stop_watch.h>
+#include <easy3d/util/logging.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace easy3d {
+
+    namespace benchmark {
+
+        /**
+         * \brief Collects the timed scenarios of a benchmark run and writes them to a JSON file
+         *      for regression tracking.
+         * \details Each benchmark executable creates one Report, runs its scenarios through run()
+         *      (which repeats the scenario and records the best time to reduce noise), and finally
+         *      calls save(). The JSON files of two runs can then be diffed or fed into a tracking
+         *      script to catch regressions.
+         */
+        class Report {
+        public:
+            explicit Report(const std::string& name) : name_(name) {}
+
+            /**
+             * \brief Times a scenario and records the result.
+             * \param scenario A short name identifying the scenario, e.g., "build" or "knn (k=16)".
+             * \param iterations How often the scenario is repeated. The best (smallest) time of all
+             *      repetitions is recorded, which is less noisy than the mean on a loaded machine.
+             * \param func The scenario. It must be repeatable, i.e., not destroy its input.
+             * \return The recorded time in seconds.
+             */
+            template <typename Func>
+            double run(const std::string& scenario, int iterations, Func func) {
+                double best = 0.0;
+                for (int i = 0; i < iterations; ++i) {
+                    StopWatch w;
+                    func();
+                    const double t = w.elapsed_seconds(6);
+                    if (i == 0 || t < best)
+                        best = t;
+                }
+                records_.push_back({scenario, best, iterations});
+                LOG(INFO) << name_ << " | " << scenario << ": " << best << " s (best of " << iterations << ")";
+                return best;
+            }
+
+            /// \brief Records an externally measured result (for scenarios that cannot be repeated).
+            void add(const std::string& scenario, double seconds) {
+                records_.push_back({scenario, seconds, 1});
+                LOG(INFO) << name_ << " | " << scenario << ": " << seconds << " s";
+            }
+
+            /// \brief Writes all recorded scenarios to a JSON file. Returns false on failure.
+            bool save(const std::string& file_name) const {
+                std::ofstream output(file_name.c_str());
+                if (output.fail()) {
+                    LOG(ERROR) << "could not open file: " << file_name;
+                    return false;
+                }
+                output << "{\n"
+                       << "    \"benchmark\": \"" << name_ << "\",\n"
+                       << "    \"scenarios\": [\n";
+                for (std::size_t i = 0; i < records_.size(); ++i) {
+                    const Record& r = records_[i];
+                    output << "        {\"name\": \"" << r.scenario << "\", "
+                           << "\"seconds\": " << r.seconds << ", "
+                           << "\"iterations\": " << r.iterations << "}"
+                           << (i + 1 < records_.size() ? ",\n" : "\n");
+                }
+                output << "    ]\n"
+                       << "}\n";
+                LOG(INFO) << "benchmark results saved to: " << file_name;
+                return true;
+            }
+
+        private:
+            struct Record {
+                std::string scenario;
+                double      seconds;
+                int         iterations;
+            };
+
+            std::string         name_;
+            std::vector<Record> records_;
+        };
+
+    }
+
+}
+
+#endif  // EASY3D_BENCHMARK_BENCHMARK_H
@@ -24,11 +24,27 @@
 
 #include <easy3d/algo/delaunay_2d.h>
 #include <easy3d/util/stop_watch.h>
+#include <easy3d/util/thread_pool.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
 
 extern "C" {
 #include <3rd_party/triangle/triangle.h>
 }
 
+// The robust geometric predicates from tetgen (3rd_party/tetgen/predicates.cxx), which the algo
+// library links anyway. orient2d() is positive if (a, b, c) occur in counterclockwise order;
+// incircle() is positive if d lies strictly inside the circle through the counterclockwise-ordered
+// a, b, c. exactinit() must be called with the coordinate range to set up the error filters.
+void exactinit(int verbose, int noexact, int nofilter, double maxx, double maxy, double maxz);
+double orient2d(double *pa, double *pb, double *pc);
+double incircle(double *pa, double *pb, double *pc, double *pd);
+
 
 namespace easy3d {
 
@@ -55,7 +71,522 @@ namespace easy3d {
         memset(tri, 0, sizeof(struct triangulateio));
     }
 
-    Delaunay2::Delaunay2() : Delaunay(2) {
+    // \cond
+    namespace details {
+
+        // interleaves the lower 32 bits of v with zeros
+        inline std::uint64_t expand_bits_2d(std::uint64_t v) {
+            v &= 0xffffffffull;
+            v = (v | (v << 16)) & 0x0000ffff0000ffffull;
+            v = (v | (v << 8)) & 0x00ff00ff00ff00ffull;
+            v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0full;
+            v = (v | (v << 2)) & 0x3333333333333333ull;
+            v = (v | (v << 1)) & 0x5555555555555555ull;
+            return v;
+        }
+
+        // the 64-bit Morton code of quantized 2D coordinates
+        inline std::uint64_t morton_code_2d(std::uint64_t x, std::uint64_t y) {
+            return expand_bits_2d(x) | (expand_bits_2d(y) << 1);
+        }
+
+
+        // An editable triangulation for Bowyer-Watson point insertion. Every convex hull edge
+        // carries a "ghost" triangle whose third corner is the symbolic infinite vertex (-1), so
+        // the insertion is uniform for points inside and outside the current hull: the
+        // "circumcircle" of a ghost is the open half plane beyond its hull edge.
+        class IncrementalDT {
+        public:
+            IncrementalDT(const std::vector<float> &pts) : pts_(pts), hint_(0), rand_(1) {}
+
+            // copies the arrays of an existing triangulation and creates the ghost triangles.
+            // Returns false if the boundary is not a set of closed loops (corrupted input).
+            bool init(unsigned int nb_cells, const int *cell_to_v, const int *cell_to_cell) {
+                tri_v_.assign(cell_to_v, cell_to_v + 3 * nb_cells);
+                tri_n_.assign(cell_to_cell, cell_to_cell + 3 * nb_cells);
+
+                // one ghost per hull edge (u, w), stored as (w, u, -1)
+                std::unordered_map<int, int> ghost_start, ghost_end; // hull edge start/end -> ghost
+                std::vector<int> hull_u, hull_w;
+                for (unsigned int t = 0; t < nb_cells; ++t) {
+                    for (int i = 0; i < 3; ++i) {
+                        if (tri_n_[3 * t + i] == -1) {
+                            const int u = tri_v_[3 * t + (i + 1) % 3];
+                            const int w = tri_v_[3 * t + (i + 2) % 3];
+                            const int g = static_cast<int>(tri_v_.size() / 3);
+                            tri_v_.push_back(w);
+                            tri_v_.push_back(u);
+                            tri_v_.push_back(-1);
+                            tri_n_.push_back(-1);
+                            tri_n_.push_back(-1);
+                            tri_n_.push_back(static_cast<int>(t));
+                            tri_n_[3 * t + i] = g;
+                            if (ghost_start.find(u) != ghost_start.end() ||
+                                ghost_end.find(w) != ghost_end.end())
+                                return false; // a hull vertex with more than one outgoing hull edge
+                            ghost_start[u] = g;
+                            ghost_end[w] = g;
+                            hull_u.push_back(u);
+                            hull_w.push_back(w);
+                        }
+                    }
+                }
+                // link the ghosts to each other around the hull
+                for (std::size_t i = 0; i < hull_u.size(); ++i) {
+                    const int u = hull_u[i], w = hull_w[i];
+                    const int g = ghost_start[u];
+                    if (ghost_start.find(w) == ghost_start.end() ||
+                        ghost_end.find(u) == ghost_end.end())
+                        return false; // open boundary loop
+                    tri_n_[3 * g + 1] = ghost_start[w]; // opposite u: the edge (w, -1)
+                    tri_n_[3 * g + 0] = ghost_end[u];   // opposite w: the edge (u, -1)
+                }
+
+                erased_.assign(tri_v_.size() / 3, 0);
+                in_cavity_.assign(tri_v_.size() / 3, 0);
+                return true;
+            }
+
+            // inserts vertex v (an index into the point array). Returns false if the vertex
+            // coincides with an existing one (it is kept, but remains unconnected).
+            bool insert(int v) {
+                double p[2] = {pts_[2 * v], pts_[2 * v + 1]};
+                const int t = locate(p);
+                if (t < 0) {
+                    LOG_FIRST_N(WARNING, 1) << "point location failed (degenerate input?); "
+                                            << "vertex " << v << " not inserted";
+                    return false;
+                }
+
+                // exact duplicate of a corner of the located triangle?
+                for (int i = 0; i < 3; ++i) {
+                    const int c = tri_v_[3 * t + i];
+                    if (c >= 0 && pts_[2 * c] == p[0] && pts_[2 * c + 1] == p[1])
+                        return false;
+                }
+
+                // grow the cavity: all triangles whose circumcircle contains p
+                cavity_.clear();
+                cavity_.push_back(t);
+                in_cavity_[t] = 1;
+                for (std::size_t k = 0; k < cavity_.size(); ++k) {
+                    const int tc = cavity_[k];
+                    for (int i = 0; i < 3; ++i) {
+                        const int nb = tri_n_[3 * tc + i];
+                        if (!in_cavity_[nb] && conflict(nb, p)) {
+                            in_cavity_[nb] = 1;
+                            cavity_.push_back(nb);
+                        }
+                    }
+                }
+                // enforce a star-shaped cavity: p must see every finite boundary edge from the
+                // inside, otherwise the fan below would create inverted or degenerate triangles
+                // (this matters when p lies exactly on an edge or a circumcircle)
+                bool grown = true;
+                while (grown) {
+                    grown = false;
+                    for (std::size_t k = 0; k < cavity_.size(); ++k) {
+                        const int tc = cavity_[k];
+                        for (int i = 0; i < 3; ++i) {
+                            const int nb = tri_n_[3 * tc + i];
+                            if (in_cavity_[nb])
+                                continue;
+                            const int u = tri_v_[3 * tc + (i + 1) % 3];
+                            const int w = tri_v_[3 * tc + (i + 2) % 3];
+                            if (u < 0 || w < 0)
+                                continue;
+                            double pu[2] = {pts_[2 * u], pts_[2 * u + 1]};
+                            double pw[2] = {pts_[2 * w], pts_[2 * w + 1]};
+                            if (orient2d(pu, pw, p) <= 0) {
+                                in_cavity_[nb] = 1;
+                                cavity_.push_back(nb);
+                                grown = true;
+                            }
+                        }
+                    }
+                }
+
+                // collect the boundary edges (directed with the cavity on the left)
+                struct BoundaryEdge {
+                    int u, w, out, out_c;
+                };
+                std::vector<BoundaryEdge> boundary;
+                for (std::size_t k = 0; k < cavity_.size(); ++k) {
+                    const int tc = cavity_[k];
+                    for (int i = 0; i < 3; ++i) {
+                        const int nb = tri_n_[3 * tc + i];
+                        if (in_cavity_[nb])
+                            continue;
+                        BoundaryEdge e;
+                        e.u = tri_v_[3 * tc + (i + 1) % 3];
+                        e.w = tri_v_[3 * tc + (i + 2) % 3];
+                        e.out = nb;
+                        e.out_c = 0;
+                        while (tri_n_[3 * nb + e.out_c] != tc)
+                            ++e.out_c;
+                        boundary.push_back(e);
+                    }
+                }
+
+                // retire the cavity triangles and re-triangulate the cavity as a fan around p
+                for (std::size_t k = 0; k < cavity_.size(); ++k) {
+                    erased_[cavity_[k]] = 1;
+                    free_.push_back(cavity_[k]);
+                }
+                std::unordered_map<int, int> start_of, end_of; // boundary vertex -> new triangle
+                std::vector<int> created(boundary.size());
+                for (std::size_t k = 0; k < boundary.size(); ++k) {
+                    const BoundaryEdge &e = boundary[k];
+                    const int nt = alloc();
+                    tri_v_[3 * nt] = e.u;
+                    tri_v_[3 * nt + 1] = e.w;
+                    tri_v_[3 * nt + 2] = v;
+                    tri_n_[3 * nt + 2] = e.out; // opposite v: the boundary edge itself
+                    tri_n_[3 * e.out + e.out_c] = nt;
+                    start_of[e.u] = nt;
+                    end_of[e.w] = nt;
+                    created[k] = nt;
+                }
+                for (std::size_t k = 0; k < boundary.size(); ++k) {
+                    const int nt = created[k];
+                    tri_n_[3 * nt] = start_of[boundary[k].w];   // opposite u: the edge (w, v)
+                    tri_n_[3 * nt + 1] = end_of[boundary[k].u]; // opposite w: the edge (v, u)
+                }
+                for (std::size_t k = 0; k < cavity_.size(); ++k)
+                    in_cavity_[cavity_[k]] = 0;
+
+                // prefer a finite triangle as the hint for the next location walk
+                hint_ = created[0];
+                for (std::size_t k = 0; k < created.size(); ++k) {
+                    if (tri_v_[3 * created[k]] >= 0 && tri_v_[3 * created[k] + 1] >= 0) {
+                        hint_ = created[k];
+                        break;
+                    }
+                }
+                return true;
+            }
+
+            // writes the finite triangles back into cell arrays (ghost neighbors become -1)
+            void collect(std::vector<int> &cell_to_v, std::vector<int> &cell_to_cell) const {
+                const std::size_t nt = tri_v_.size() / 3;
+                std::vector<int> id(nt, -1);
+                int nb = 0;
+                for (std::size_t t = 0; t < nt; ++t) {
+                    if (!erased_[t] && tri_v_[3 * t] >= 0 && tri_v_[3 * t + 1] >= 0 &&
+                        tri_v_[3 * t + 2] >= 0)
+                        id[t] = nb++;
+                }
+                cell_to_v.resize(nb * 3);
+                cell_to_cell.resize(nb * 3);
+                for (std::size_t t = 0; t < nt; ++t) {
+                    if (id[t] == -1)
+                        continue;
+                    for (int i = 0; i < 3; ++i) {
+                        cell_to_v[3 * id[t] + i] = tri_v_[3 * t + i];
+                        const int n = tri_n_[3 * t + i];
+                        cell_to_cell[3 * id[t] + i] = (n >= 0) ? id[n] : -1;
+                    }
+                }
+            }
+
+        private:
+            bool is_ghost(int t) const {
+                return tri_v_[3 * t] < 0 || tri_v_[3 * t + 1] < 0 || tri_v_[3 * t + 2] < 0;
+            }
+
+            // is p inside the circumcircle of t (for a ghost: strictly beyond its hull edge)?
+            bool conflict(int t, double *p) const {
+                const int a = tri_v_[3 * t], b = tri_v_[3 * t + 1], c = tri_v_[3 * t + 2];
+                if (a >= 0 && b >= 0 && c >= 0) {
+                    double pa[2] = {pts_[2 * a], pts_[2 * a + 1]};
+                    double pb[2] = {pts_[2 * b], pts_[2 * b + 1]};
+                    double pc[2] = {pts_[2 * c], pts_[2 * c + 1]};
+                    return incircle(pa, pb, pc, p) > 0;
+                }
+                const int i = (a < 0) ? 0 : ((b < 0) ? 1 : 2);
+                const int u = tri_v_[3 * t + (i + 1) % 3];
+                const int w = tri_v_[3 * t + (i + 2) % 3];
+                double pu[2] = {pts_[2 * u], pts_[2 * u + 1]};
+                double pw[2] = {pts_[2 * w], pts_[2 * w + 1]};
+                return orient2d(pu, pw, p) > 0;
+            }
+
+            // remembering stochastic walk from the last modified triangle. Returns the triangle
+            // containing p (a ghost if p is outside the hull), or -1 on failure.
+            int locate(double *p) {
+                int t = (hint_ >= 0 && hint_ < (int) erased_.size() && !erased_[hint_]) ? hint_ : -1;
+                if (t == -1) {
+                    for (std::size_t i = 0; i < erased_.size(); ++i) {
+                        if (!erased_[i] && !is_ghost(static_cast<int>(i))) {
+                            t = static_cast<int>(i);
+                            break;
+                        }
+                    }
+                    if (t == -1)
+                        return -1;
+                }
+                int prev = -1;
+                const std::size_t max_steps = 2 * erased_.size() + 16;
+                for (std::size_t step = 0; step < max_steps; ++step) {
+                    if (is_ghost(t))
+                        return t; // we crossed a hull edge, so p is outside the hull
+                    rand_ = rand_ * 1103515245u + 12345u; // randomize the edge order (no cycling)
+                    int next = -1;
+                    for (int k = 0; k < 3; ++k) {
+                        const int i = (k + static_cast<int>(rand_ >> 16)) % 3;
+                        if (tri_n_[3 * t + i] == prev)
+                            continue;
+                        const int u = tri_v_[3 * t + (i + 1) % 3];
+                        const int w = tri_v_[3 * t + (i + 2) % 3];
+                        double pu[2] = {pts_[2 * u], pts_[2 * u + 1]};
+                        double pw[2] = {pts_[2 * w], pts_[2 * w + 1]};
+                        if (orient2d(pu, pw, p) < 0) {
+                            next = tri_n_[3 * t + i];
+                            break;
+                        }
+                    }
+                    if (next == -1)
+                        return t;
+                    prev = t;
+                    t = next;
+                }
+                return -1;
+            }
+
+            int alloc() {
+                if (!free_.empty()) {
+                    const int t = free_.back();
+                    free_.pop_back();
+                    erased_[t] = 0;
+                    return t;
+                }
+                const int t = static_cast<int>(tri_v_.size() / 3);
+                tri_v_.resize(tri_v_.size() + 3);
+                tri_n_.resize(tri_n_.size() + 3);
+                erased_.push_back(0);
+                in_cavity_.push_back(0);
+                return t;
+            }
+
+        private:
+            const std::vector<float> &pts_;
+            std::vector<int> tri_v_;    // 3 corners per triangle (-1: the infinite vertex)
+            std::vector<int> tri_n_;    // the neighbor opposite each corner
+            std::vector<char> erased_;
+            std::vector<char> in_cavity_;
+            std::vector<int> free_;
+            std::vector<int> cavity_;
+            int hint_;
+            unsigned int rand_;
+        };
+
+
+        // ----- helpers for the parallel divide-and-conquer mode -----
+
+        // below this size the partitioning overhead is not worth it
+        const unsigned int min_parallel_sites = 8192;
+
+        // one group of sites (a vertical strip, or the repair set along the strip boundaries)
+        struct SiteGroup {
+            std::vector<int> sites;         // indices into the full site array
+            std::vector<int> triangles;     // the group's triangles, 3 global site indices each
+            std::vector<int> neighbors;     // the group-local neighbor opposite each corner
+            std::vector<int> accepted;      // the certified subset of the triangles
+        };
+
+        // triangulates the sites of the group with "triangle" and writes the triangle list with
+        // global site indices. "triangle" keeps a little global state (the predicate error
+        // bounds, which every call initializes to the same values, and the seed of the
+        // point-location randomization), so concurrent calls do not disturb each other.
+        void triangulate_group(const float *pts, SiteGroup &group) {
+            group.triangles.clear();
+            group.neighbors.clear();
+            if (group.sites.size() < 3)
+                return;
+
+            struct triangulateio in, out;
+            memset(&in, 0, sizeof(struct triangulateio));
+            memset(&out, 0, sizeof(struct triangulateio));
+            std::vector<double> coords(group.sites.size() * 2);
+            for (std::size_t i = 0; i < group.sites.size(); ++i) {
+                coords[2 * i] = pts[2 * group.sites[i]];
+                coords[2 * i + 1] = pts[2 * group.sites[i] + 1];
+            }
+            in.numberofpoints = static_cast<int>(group.sites.size());
+            in.pointlist = coords.data();
+            triangulate((char *) "Qzn", &in, &out, nullptr);
+
+            group.triangles.resize(out.numberoftriangles * 3);
+            for (int t = 0; t < out.numberoftriangles * 3; ++t)
+                group.triangles[t] = group.sites[out.trianglelist[t]];
+            group.neighbors.assign(out.neighborlist, out.neighborlist + out.numberoftriangles * 3);
+            free_triangulateio(&out);
+        }
+
+        // circumcenter and radius, computed relative to the first corner for accuracy.
+        // Returns false for (nearly) degenerate triangles.
+        inline bool circumcircle(const double *a, const double *b, const double *c,
+                                 double *center, double &radius) {
+            const double bx = b[0] - a[0], by = b[1] - a[1];
+            const double cx = c[0] - a[0], cy = c[1] - a[1];
+            const double d = 2.0 * (bx * cy - by * cx);
+            if (d == 0.0)
+                return false;
+            const double b2 = bx * bx + by * by;
+            const double c2 = cx * cx + cy * cy;
+            const double ux = (cy * b2 - by * c2) / d;
+            const double uy = (bx * c2 - cx * b2) / d;
+            center[0] = a[0] + ux;
+            center[1] = a[1] + uy;
+            radius = std::sqrt(ux * ux + uy * uy);
+            return true;
+        }
+
+        // conservative x-extent of the part of the circumdisk of (a, b, c) that can contain
+        // sites, i.e., the disk clipped against the y-range of the whole site set. The giant
+        // disks of the near-degenerate hull triangles lie mostly outside that slab, so the
+        // clipping keeps the stitching bands narrow. Returns false for degenerate triangles.
+        // A triangle is a triangle of the full Delaunay triangulation whenever its extent is
+        // covered by the x-interval of a group that contains all sites of that interval.
+        inline bool disk_extent(const double *a, const double *b, const double *c,
+                                double ymin, double ymax, double &lo, double &hi) {
+            double center[2], radius;
+            if (!circumcircle(a, b, c, center, radius))
+                return false;
+            double half = radius;
+            if (center[1] < ymin || center[1] > ymax) {
+                const double dy = (center[1] < ymin) ? ymin - center[1] : center[1] - ymax;
+                half = std::sqrt(std::max(0.0, radius * radius - dy * dy));
+            }
+            // a safety margin for the floating point circumcenter. All groups evaluate the
+            // same formula on the same coordinates, so the classification stays consistent.
+            const double margin = 1e-9 * (std::fabs(center[0]) + radius + 1.0);
+            lo = center[0] - half - margin;
+            hi = center[0] + half + margin;
+            return true;
+        }
+
+        // links the triangles into a neighbor array and verifies that they form one complete
+        // triangulation of the convex hull: all triangles are positively oriented, every
+        // directed edge occurs at most once, the unmatched edges form a single convex CCW
+        // boundary loop, the triangle count satisfies Euler's formula, and every site is used
+        // (or is an exact duplicate of a used one, which "triangle" also leaves unconnected).
+        bool validate_and_link(unsigned int nb_sites, const float *pts,
+                               const std::vector<int> &tri_v, std::vector<int> &tri_n) {
+            const std::size_t nt = tri_v.size() / 3;
+            if (nt == 0)
+                return false;
+
+            // directed edges, sorted by their packed key (a hash map is noticeably slower here)
+            std::vector<std::pair<std::uint64_t, int> > edges(nt * 3); // key -> 3 * t + corner
+            for (std::size_t t = 0; t < nt; ++t) {
+                double p[3][2];
+                for (int i = 0; i < 3; ++i) {
+                    const int v = tri_v[3 * t + i];
+                    p[i][0] = pts[2 * v];
+                    p[i][1] = pts[2 * v + 1];
+                }
+                if (orient2d(p[0], p[1], p[2]) <= 0)
+                    return false;
+                for (int i = 0; i < 3; ++i) {
+                    const int u = tri_v[3 * t + (i + 1) % 3];
+                    const int w = tri_v[3 * t + (i + 2) % 3];
+                    const std::uint64_t key =
+                            (static_cast<std::uint64_t>(u) << 32) | static_cast<std::uint32_t>(w);
+                    edges[3 * t + i] = std::make_pair(key, static_cast<int>(3 * t + i));
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+            for (std::size_t e = 1; e < edges.size(); ++e) {
+                if (edges[e].first == edges[e - 1].first)
+                    return false; // overlapping triangles
+            }
+            const auto find_edge = [&edges](int u, int w) -> int {
+                const std::uint64_t key =
+                        (static_cast<std::uint64_t>(u) << 32) | static_cast<std::uint32_t>(w);
+                auto it = std::lower_bound(edges.begin(), edges.end(),
+                                           std::make_pair(key, 0));
+                return (it != edges.end() && it->first == key) ? it->second : -1;
+            };
+
+            tri_n.assign(nt * 3, -1);
+            std::unordered_map<int, int> boundary_next; // boundary edge start -> end
+            for (std::size_t t = 0; t < nt; ++t) {
+                for (int i = 0; i < 3; ++i) {
+                    const int u = tri_v[3 * t + (i + 1) % 3];
+                    const int w = tri_v[3 * t + (i + 2) % 3];
+                    const int e = find_edge(w, u);
+                    if (e >= 0)
+                        tri_n[3 * t + i] = e / 3;
+                    else if (!boundary_next.insert(std::make_pair(u, w)).second)
+                        return false; // a boundary vertex with two outgoing boundary edges
+                }
+            }
+            if (boundary_next.empty())
+                return false;
+
+            // the boundary must be one closed loop...
+            std::vector<int> loop;
+            int v = boundary_next.begin()->first;
+            do {
+                loop.push_back(v);
+                auto it = boundary_next.find(v);
+                if (it == boundary_next.end() || loop.size() > boundary_next.size())
+                    return false;
+                v = it->second;
+            } while (v != loop[0]);
+            if (loop.size() != boundary_next.size())
+                return false; // more than one loop, i.e., holes between the groups
+
+            // ... and it must be convex (the directed boundary edges of CCW triangles run CCW
+            // around the hull, so all turns are left turns)
+            for (std::size_t i = 0; i < loop.size(); ++i) {
+                const int va = loop[i];
+                const int vb = loop[(i + 1) % loop.size()];
+                const int vc = loop[(i + 2) % loop.size()];
+                double pa[2] = {pts[2 * va], pts[2 * va + 1]};
+                double pb[2] = {pts[2 * vb], pts[2 * vb + 1]};
+                double pc[2] = {pts[2 * vc], pts[2 * vc + 1]};
+                if (orient2d(pa, pb, pc) < 0)
+                    return false;
+            }
+
+            // Euler's formula for a triangulated disk
+            std::vector<char> used(nb_sites, 0);
+            for (std::size_t i = 0; i < tri_v.size(); ++i)
+                used[tri_v[i]] = 1;
+            long nb_used = 0;
+            for (unsigned int i = 0; i < nb_sites; ++i)
+                nb_used += used[i];
+            if (static_cast<long>(nt) != 2 * nb_used - static_cast<long>(loop.size()) - 2)
+                return false;
+
+            // every unconnected site must coincide with a connected one
+            if (nb_used < static_cast<long>(nb_sites)) {
+                const auto coord_key = [pts](unsigned int i) -> std::uint64_t {
+                    std::uint32_t x, y;
+                    memcpy(&x, pts + 2 * i, sizeof(std::uint32_t));
+                    memcpy(&y, pts + 2 * i + 1, sizeof(std::uint32_t));
+                    return (static_cast<std::uint64_t>(x) << 32) | y;
+                };
+                std::unordered_map<std::uint64_t, char> seen;
+                seen.reserve(nb_used);
+                for (unsigned int i = 0; i < nb_sites; ++i) {
+                    if (used[i])
+                        seen[coord_key(i)] = 1;
+                }
+                for (unsigned int i = 0; i < nb_sites; ++i) {
+                    if (!used[i] && seen.find(coord_key(i)) == seen.end())
+                        return false;
+                }
+            }
+            return true;
+        }
+    }
+    // \endcond
+
+
+    Delaunay2::Delaunay2() : Delaunay(2), parallel_(false) {
         triangle_in_ = new struct triangulateio;
         triangle_out_ = new struct triangulateio;
 
@@ -74,6 +605,22 @@ namespace easy3d {
         LOG(INFO) << "Delaunay triangulation...";
         StopWatch t;
 
+        // a full re-triangulation from user data invalidates the incremental copies
+        if (!incr_vertices_.empty() && vertices != incr_vertices_.data()) {
+            incr_vertices_.clear();
+            incr_cell_to_v_.clear();
+            incr_cell_to_cell_.clear();
+        }
+
+        if (parallel_ && nb_vertices >= details::min_parallel_sites) {
+            if (triangulate_parallel(nb_vertices, vertices)) {
+                LOG(INFO) << "done (parallel). time: " << t.time_string();
+                return;
+            }
+            LOG_FIRST_N(WARNING, 1) << "parallel triangulation could not be verified; "
+                                    << "using the serial path";
+        }
+
         Delaunay::set_vertices(nb_vertices, vertices);
         //free_triangulateio(triangle_out_) ;
         triangle_in_->numberofpoints = nb_vertices;
@@ -101,4 +648,260 @@ namespace easy3d {
         LOG(INFO) << "done. time: " << t.time_string();
     }
 
+
+    bool Delaunay2::triangulate_parallel(unsigned int nb_vertices, const float *vertices) {
+        // one strip per thread, but keep the strips reasonably populated
+        int num_strips = ThreadPool::global().num_workers() + 1;
+        while (num_strips > 1 && nb_vertices / num_strips < details::min_parallel_sites / 4)
+            --num_strips;
+        if (num_strips < 2)
+            return false;
+
+        // the coordinate range (the robust predicates need it for their static error filters)
+        float cmin[2] = {FLT_MAX, FLT_MAX}, cmax[2] = {-FLT_MAX, -FLT_MAX};
+        for (unsigned int i = 0; i < nb_vertices; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                cmin[j] = std::min(cmin[j], vertices[2 * i + j]);
+                cmax[j] = std::max(cmax[j], vertices[2 * i + j]);
+            }
+        }
+        if (cmax[0] <= cmin[0])
+            return false; // all sites on one vertical line
+        exactinit(0, 0, 0, cmax[0] - cmin[0], cmax[1] - cmin[1], 0.0);
+        const double ymin = cmin[1], ymax = cmax[1];
+
+        // sort the sites by coordinates, and keep a single representative of each batch of
+        // exactly coinciding sites: the groups below could otherwise connect different
+        // representatives, which would not stitch. Like in the serial path, the dropped
+        // duplicates simply remain unconnected.
+        std::vector<int> order(nb_vertices);
+        for (unsigned int i = 0; i < nb_vertices; ++i)
+            order[i] = static_cast<int>(i);
+        std::sort(order.begin(), order.end(), [vertices](int a, int b) {
+            if (vertices[2 * a] != vertices[2 * b])
+                return vertices[2 * a] < vertices[2 * b];
+            return vertices[2 * a + 1] < vertices[2 * b + 1];
+        });
+        const auto unique_end = std::unique(order.begin(), order.end(), [vertices](int a, int b) {
+            return vertices[2 * a] == vertices[2 * b] && vertices[2 * a + 1] == vertices[2 * b + 1];
+        });
+        const auto nb_unique = static_cast<unsigned int>(unique_end - order.begin());
+        order.resize(nb_unique);
+        if (nb_unique < details::min_parallel_sites)
+            return false;
+
+        // choose the strip boundaries between distinct x coordinates
+        std::vector<unsigned int> split(1, 0);
+        for (int k = 1; k < num_strips; ++k) {
+            auto s = static_cast<unsigned int>(
+                    static_cast<std::uint64_t>(k) * nb_unique / num_strips);
+            while (s < nb_unique && vertices[2 * order[s]] == vertices[2 * order[s - 1]])
+                ++s; // never split between equal coordinates
+            if (s > split.back() && s < nb_unique)
+                split.push_back(s);
+        }
+        split.push_back(nb_unique);
+        const int nb_strips = static_cast<int>(split.size()) - 1;
+        if (nb_strips < 2)
+            return false;
+
+        // the cut between strips k and k+1 runs strictly between two site coordinates
+        std::vector<double> cuts(nb_strips - 1);
+        for (int k = 0; k + 1 < nb_strips; ++k) {
+            cuts[k] = 0.5 * (static_cast<double>(vertices[2 * order[split[k + 1] - 1]]) +
+                             static_cast<double>(vertices[2 * order[split[k + 1]]]));
+        }
+
+        // triangulate the strips concurrently and certify every triangle whose clipped
+        // circumdisk stays strictly between the cuts: the strips partition the sites by x, so
+        // such a disk cannot contain a site of any other strip and the triangle belongs to
+        // the full Delaunay triangulation. The vertices of the remaining triangles -- and of
+        // the triangles along the strip hulls, whose surroundings a strip cannot judge -- are
+        // handed to the repair stage.
+        std::vector<details::SiteGroup> strips(nb_strips);
+        for (int k = 0; k < nb_strips; ++k)
+            strips[k].sites.assign(order.begin() + split[k], order.begin() + split[k + 1]);
+        std::vector<char> in_repair(nb_vertices, 0);  // the strips write disjoint entries
+        std::vector<char> connected(nb_vertices, 0);  // of these two
+        ThreadPool::global().parallel_for(0, strips.size(), [&](std::size_t k) {
+            details::SiteGroup &strip = strips[k];
+            details::triangulate_group(vertices, strip);
+            const double lo_cut = (k == 0) ? -DBL_MAX : cuts[k - 1];
+            const double hi_cut = (k + 1 == strips.size()) ? DBL_MAX : cuts[k];
+            for (std::size_t t = 0; t < strip.triangles.size(); t += 3) {
+                double p[3][2];
+                for (int i = 0; i < 3; ++i) {
+                    const int v = strip.triangles[t + i];
+                    p[i][0] = vertices[2 * v];
+                    p[i][1] = vertices[2 * v + 1];
+                    connected[v] = 1;
+                }
+                double lo, hi;
+                const bool finite = details::disk_extent(p[0], p[1], p[2], ymin, ymax, lo, hi);
+                const bool on_hull = strip.neighbors[t] < 0 || strip.neighbors[t + 1] < 0 ||
+                                     strip.neighbors[t + 2] < 0;
+                if (finite && lo > lo_cut && hi < hi_cut) {
+                    strip.accepted.insert(strip.accepted.end(),
+                                          strip.triangles.begin() + t,
+                                          strip.triangles.begin() + t + 3);
+                    if (!on_hull)
+                        continue;
+                }
+                for (int i = 0; i < 3; ++i)
+                    in_repair[strip.triangles[t + i]] = 1;
+            }
+        });
+
+        // re-triangulate the repair sites together. Any triangle of the full Delaunay
+        // triangulation that is still missing has an empty circumdisk and all its vertices in
+        // the repair set, so it is also a triangle of the repair triangulation.
+        details::SiteGroup repair;
+        repair.sites.reserve(nb_unique / 4);
+        for (unsigned int i = 0; i < nb_unique; ++i) {
+            // representatives left unconnected by their strip (e.g., a degenerate strip
+            // that produced no triangles at all) need repairing as well
+            if (in_repair[order[i]] || !connected[order[i]])
+                repair.sites.push_back(order[i]);
+        }
+        details::triangulate_group(vertices, repair);
+
+        // collect the missing triangles by flooding the repair triangulation from the
+        // unmatched edges of the certified part, without ever crossing back into it
+        const auto edge_key = [](int u, int w) -> std::uint64_t {
+            return (static_cast<std::uint64_t>(u) << 32) | static_cast<std::uint32_t>(w);
+        };
+        incr_cell_to_v_.clear();
+        for (int k = 0; k < nb_strips; ++k) {
+            incr_cell_to_v_.insert(incr_cell_to_v_.end(),
+                                   strips[k].accepted.begin(), strips[k].accepted.end());
+        }
+        std::vector<std::uint64_t> accepted_edges(incr_cell_to_v_.size()); // sorted keys
+        for (std::size_t t = 0; t < incr_cell_to_v_.size(); t += 3) {
+            for (int i = 0; i < 3; ++i) {
+                accepted_edges[t + i] = edge_key(incr_cell_to_v_[t + (i + 1) % 3],
+                                                 incr_cell_to_v_[t + (i + 2) % 3]);
+            }
+        }
+        std::sort(accepted_edges.begin(), accepted_edges.end());
+        const auto in_accepted = [&accepted_edges](std::uint64_t key) {
+            return std::binary_search(accepted_edges.begin(), accepted_edges.end(), key);
+        };
+        std::vector<std::pair<std::uint64_t, int> > repair_edges(repair.triangles.size());
+        for (std::size_t t = 0; t < repair.triangles.size(); t += 3) {
+            for (int i = 0; i < 3; ++i) {
+                repair_edges[t + i] = std::make_pair(edge_key(repair.triangles[t + (i + 1) % 3],
+                                                             repair.triangles[t + (i + 2) % 3]),
+                                                     static_cast<int>(t / 3));
+            }
+        }
+        std::sort(repair_edges.begin(), repair_edges.end());
+        const auto in_repair_dt = [&repair_edges](std::uint64_t key) -> int {
+            auto it = std::lower_bound(repair_edges.begin(), repair_edges.end(),
+                                       std::make_pair(key, 0));
+            return (it != repair_edges.end() && it->first == key) ? it->second : -1;
+        };
+
+        std::vector<char> visited(repair.triangles.size() / 3, 0);
+        std::vector<int> stack;
+        for (const auto key : accepted_edges) {
+            const int u = static_cast<int>(key >> 32);
+            const int w = static_cast<int>(key & 0xffffffffu);
+            if (in_accepted(edge_key(w, u)))
+                continue; // matched inside the certified part
+            // the gap side of the edge; absent when the edge is on the convex hull
+            const int t = in_repair_dt(edge_key(w, u));
+            if (t >= 0)
+                stack.push_back(t);
+        }
+        while (!stack.empty()) {
+            const int t = stack.back();
+            stack.pop_back();
+            if (visited[t])
+                continue;
+            visited[t] = 1;
+            incr_cell_to_v_.insert(incr_cell_to_v_.end(),
+                                   repair.triangles.begin() + 3 * t,
+                                   repair.triangles.begin() + 3 * t + 3);
+            for (int i = 0; i < 3; ++i) {
+                const int u = repair.triangles[3 * t + (i + 1) % 3];
+                const int w = repair.triangles[3 * t + (i + 2) % 3];
+                if (in_accepted(edge_key(w, u)))
+                    continue; // the certified part lies on the other side
+                const int next = in_repair_dt(edge_key(w, u));
+                if (next >= 0 && !visited[next])
+                    stack.push_back(next);
+            }
+        }
+
+        // verify that nothing is missing, duplicated, or overlapping
+        if (!details::validate_and_link(nb_vertices, vertices, incr_cell_to_v_, incr_cell_to_cell_))
+            return false;
+
+        Delaunay::set_vertices(nb_vertices, vertices);
+        set_arrays(static_cast<unsigned int>(incr_cell_to_v_.size() / 3),
+                   incr_cell_to_v_.data(), incr_cell_to_cell_.data());
+        return true;
+    }
+
+
+    void Delaunay2::add_vertices(unsigned int nb_vertices, const float *vertices) {
+        if (nb_vertices == 0)
+            return;
+
+        // switch to owned storage, so the vertex array can grow
+        if (incr_vertices_.empty() && nb_vertices_ > 0)
+            incr_vertices_.assign(vertices_, vertices_ + nb_vertices_ * 2);
+        const unsigned int nb_old = nb_vertices_;
+        incr_vertices_.insert(incr_vertices_.end(), vertices, vertices + nb_vertices * 2);
+        const unsigned int nb_total = static_cast<unsigned int>(incr_vertices_.size() / 2);
+
+        if (nb_cells() == 0) { // nothing to insert into yet
+            set_vertices(nb_total, incr_vertices_.data());
+            return;
+        }
+
+        LOG(INFO) << "incremental Delaunay insertion...";
+        StopWatch t;
+
+        // the robust predicates need the coordinate range for their static error filters
+        float cmin[2] = {FLT_MAX, FLT_MAX}, cmax[2] = {-FLT_MAX, -FLT_MAX};
+        for (unsigned int i = 0; i < nb_total; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                cmin[j] = std::min(cmin[j], incr_vertices_[2 * i + j]);
+                cmax[j] = std::max(cmax[j], incr_vertices_[2 * i + j]);
+            }
+        }
+        exactinit(0, 0, 0, cmax[0] - cmin[0], cmax[1] - cmin[1], 0.0);
+
+        details::IncrementalDT dt(incr_vertices_);
+        if (!dt.init(nb_cells(), cell_to_v(), cell_to_cell())) {
+            LOG(WARNING) << "current triangulation is corrupted; re-triangulating from scratch";
+            set_vertices(nb_total, incr_vertices_.data());
+            return;
+        }
+
+        // BRIO-style spatial sort of the new points (Morton order), so that consecutive
+        // insertions stay close to each other and the location walks remain short
+        const double sx = (cmax[0] > cmin[0]) ? 2097151.0 / (cmax[0] - cmin[0]) : 0.0;
+        const double sy = (cmax[1] > cmin[1]) ? 2097151.0 / (cmax[1] - cmin[1]) : 0.0;
+        std::vector<std::pair<std::uint64_t, int> > order(nb_vertices);
+        for (unsigned int i = 0; i < nb_vertices; ++i) {
+            const int v = static_cast<int>(nb_old + i);
+            const std::uint64_t x = static_cast<std::uint64_t>((incr_vertices_[2 * v] - cmin[0]) * sx);
+            const std::uint64_t y = static_cast<std::uint64_t>((incr_vertices_[2 * v + 1] - cmin[1]) * sy);
+            order[i] = std::make_pair(details::morton_code_2d(x, y), v);
+        }
+        std::sort(order.begin(), order.end());
+
+        for (std::size_t i = 0; i < order.size(); ++i)
+            dt.insert(order[i].second);
+
+        dt.collect(incr_cell_to_v_, incr_cell_to_cell_);
+        Delaunay::set_vertices(nb_total, incr_vertices_.data());
+        set_arrays(static_cast<unsigned int>(incr_cell_to_v_.size() / 3),
+                   incr_cell_to_v_.data(), incr_cell_to_cell_.data());
+
+        LOG(INFO) << "done. inserted " << nb_vertices << " vertices. time: " << t.time_string();
+    }
+
 }
\ No newline at end of file
@@ -52,6 +52,33 @@ namespace easy3d {
             set_vertices((unsigned int) vertices.size(), &vertices[0].x);
         }
 
+        /// \brief Incrementally inserts additional vertices into the current triangulation.
+        /// \details The new points are spatially sorted (for locality) and inserted one by one with
+        /// the Bowyer-Watson algorithm, starting the point location walk from the previously
+        /// modified triangle. Appending a small batch to a large triangulation is therefore much
+        /// cheaper than re-triangulating everything with set_vertices(). The new vertices are
+        /// appended after the existing ones, so previously returned vertex indices remain valid.
+        void add_vertices(unsigned int nb_vertices, const float *vertices);
+
+        /// \brief Incrementally inserts additional vertices from an array of 2D points.
+        void add_vertices(const std::vector<vec2> &vertices) {
+            add_vertices((unsigned int) vertices.size(), &vertices[0].x);
+        }
+
+        /// \brief Enables the parallel divide-and-conquer mode of set_vertices(). Disabled by default.
+        /// \details In this mode, large inputs are partitioned into vertical strips that are
+        /// triangulated concurrently; the strips are then stitched by re-triangulating the
+        /// sites along the strip boundaries. Every produced triangle is certified to be a
+        /// triangle of the Delaunay triangulation of the full point set, and the assembled result
+        /// is verified to be a complete triangulation of the convex hull; whenever the
+        /// verification fails (e.g., for degenerate inputs), set_vertices() silently falls back
+        /// to the serial path. The triangle and neighbor *indices* may differ from those of the
+        /// serial path, but the triangulation itself carries the same guarantees.
+        void set_parallel(bool b) { parallel_ = b; }
+
+        /// \brief Returns whether the parallel divide-and-conquer mode is enabled.
+        bool is_parallel() const { return parallel_; }
+
         unsigned int nearest_vertex(const float *p) const {
             return Delaunay::nearest_vertex(p);
         }
@@ -82,9 +109,22 @@ namespace easy3d {
             return cell_adjacent(t, le);
         }
 
+    protected:
+        // the divide-and-conquer mode. Returns false if the result could not be verified, in
+        // which case the caller runs the serial path.
+        bool triangulate_parallel(unsigned int nb_vertices, const float *vertices);
+
     protected:
         struct triangulateio *triangle_out_;
         struct triangulateio *triangle_in_;
+
+        bool parallel_;
+
+        // owned storage for the incremental mode. The vertices and the arrays produced by
+        // "triangle" are copied here on the first call to add_vertices(), so they can grow.
+        std::vector<float> incr_vertices_;
+        std::vector<int> incr_cell_to_v_;
+        std::vector<int> incr_cell_to_cell_;
     };
 
 
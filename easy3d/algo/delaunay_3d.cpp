@@ -25,6 +25,9 @@
 #include <easy3d/algo/delaunay_3d.h>
 #include <easy3d/util/stop_watch.h>
 
+#include <algorithm>
+#include <float.h>
+
 #include <3rd_party/tetgen/tetgen.h>
 
 
@@ -46,6 +49,10 @@ namespace easy3d {
     }
 
     void Delaunay3::set_vertices(unsigned int nb_vertices, const float *vertices) {
+        // a full re-triangulation from user data invalidates the incremental copy
+        if (!incr_vertices_.empty() && vertices != incr_vertices_.data())
+            incr_vertices_.clear();
+
         Delaunay::set_vertices(nb_vertices, vertices);
         tetgen_out_->clean_memory();
         tetgen_in_->numberofpoints = nb_vertices;
@@ -79,6 +86,104 @@ namespace easy3d {
     }
 
 
+    void Delaunay3::add_vertices(unsigned int nb_vertices, const float *vertices) {
+        if (nb_vertices == 0)
+            return;
+
+        // switch to owned storage, so the vertex array can grow
+        if (incr_vertices_.empty() && nb_vertices_ > 0)
+            incr_vertices_.assign(vertices_, vertices_ + nb_vertices_ * 3);
+        const unsigned int nb_old = nb_vertices_;
+        incr_vertices_.insert(incr_vertices_.end(), vertices, vertices + nb_vertices * 3);
+
+        if (nb_cells() == 0) { // nothing to insert into yet
+            set_vertices(static_cast<unsigned int>(incr_vertices_.size() / 3), incr_vertices_.data());
+            return;
+        }
+
+        // tetgen's point insertion silently ignores points outside the bounding box of the
+        // existing mesh, so such batches have to take the full re-triangulation path
+        float cmin[3], cmax[3];
+        for (int j = 0; j < 3; ++j) {
+            cmin[j] = FLT_MAX;
+            cmax[j] = -FLT_MAX;
+        }
+        for (unsigned int i = 0; i < nb_old; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                cmin[j] = std::min(cmin[j], incr_vertices_[3 * i + j]);
+                cmax[j] = std::max(cmax[j], incr_vertices_[3 * i + j]);
+            }
+        }
+        for (unsigned int i = 0; i < nb_vertices; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                if (vertices[3 * i + j] < cmin[j] || vertices[3 * i + j] > cmax[j]) {
+                    LOG(INFO) << "new points extend beyond the bounding box of the current "
+                                 "triangulation; re-triangulating from scratch";
+                    set_vertices(static_cast<unsigned int>(incr_vertices_.size() / 3),
+                                 incr_vertices_.data());
+                    return;
+                }
+            }
+        }
+
+        LOG(INFO) << "incremental Delaunay insertion...";
+        StopWatch t;
+
+        // the current mesh goes back in as input (copy it before clearing the previous output)
+        tetgen_in_->clean_memory();
+        tetgen_in_->firstnumber = 0;
+        tetgen_in_->numberofpoints = nb_old;
+        tetgen_in_->pointlist = new double[nb_old * 3];
+        for (unsigned int i = 0; i < nb_old * 3; ++i)
+            tetgen_in_->pointlist[i] = incr_vertices_[i];
+        tetgen_in_->numberoftetrahedra = nb_cells();
+        tetgen_in_->numberofcorners = 4;
+        tetgen_in_->tetrahedronlist = new int[nb_cells() * 4];
+        for (unsigned int c = 0; c < nb_cells(); ++c) {
+            for (unsigned int lv = 0; lv < 4; ++lv)
+                tetgen_in_->tetrahedronlist[c * 4 + lv] = cell_vertex(c, lv);
+        }
+
+        // ...together with the points to insert
+        tetgenio addin;
+        addin.firstnumber = 0;
+        addin.numberofpoints = nb_vertices;
+        addin.pointlist = new double[nb_vertices * 3];
+        for (unsigned int i = 0; i < nb_vertices * 3; ++i)
+            addin.pointlist[i] = vertices[i];
+
+        tetgen_out_->clean_memory();
+        tetgen_out_->firstnumber = 0;
+
+        try {
+            tetgenbehavior tetgen_args_;
+            // Q: quiet
+            // r: reconstruct the given mesh (instead of triangulating from scratch)
+            // i: insert the additional points
+            // n: output tet neighbors
+            tetgen_args_.parse_commandline((char *) ("Qrin"));
+            ::tetrahedralize(&tetgen_args_, tetgen_in_, tetgen_out_, &addin);
+        } catch (const std::exception &e) {
+            LOG(ERROR) << "encountered a problem: " << e.what();
+        }
+
+        // tetgen may reject coinciding points, so take the final vertex set from the output
+        // (the surviving new vertices are appended after the existing ones)
+        const unsigned int nb_total = tetgen_out_->numberofpoints;
+        incr_vertices_.resize(nb_total * 3);
+        for (unsigned int i = 0; i < nb_total * 3; ++i)
+            incr_vertices_[i] = static_cast<float>(tetgen_out_->pointlist[i]);
+
+        Delaunay::set_vertices(nb_total, incr_vertices_.data());
+        set_arrays(
+                tetgen_out_->numberoftetrahedra,
+                tetgen_out_->tetrahedronlist, tetgen_out_->neighborlist
+        );
+
+        LOG(INFO) << "done. inserted " << nb_total - nb_old << " vertices. time: " << t.time_string();
+    }
+
+
 
 
 
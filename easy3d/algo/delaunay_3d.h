@@ -61,6 +61,21 @@ namespace easy3d {
             set_vertices((unsigned int) vertices.size(), &vertices[0].x);
         }
 
+        /// \brief Incrementally inserts additional vertices into the current triangulation.
+        /// \details The existing tetrahedral mesh is handed back to tetgen for reconstruction
+        /// (a near-linear pass) and the new points are then inserted incrementally (tetgen's
+        /// -r -i mode), which is much cheaper than re-triangulating everything with
+        /// set_vertices(). The new vertices are appended after the existing ones, so previously
+        /// returned vertex indices remain valid. Batches containing points beyond the bounding
+        /// box of the current triangulation fall back to a full re-triangulation (tetgen cannot
+        /// grow an existing mesh outwards).
+        void add_vertices(unsigned int nb_vertices, const float *vertices);
+
+        /// \brief Incrementally inserts additional vertices from an array of 3D points.
+        void add_vertices(const std::vector<vec3> &vertices) {
+            add_vertices((unsigned int) vertices.size(), &vertices[0].x);
+        }
+
         /// \brief Returns the number of tetrahedra.
         unsigned int nb_tets() const { return nb_cells(); }
 
@@ -165,6 +180,9 @@ namespace easy3d {
     protected:
         tetgenio *tetgen_out_;
         tetgenio *tetgen_in_;
+
+        // owned copy of the vertices for the incremental mode (it must be able to grow)
+        std::vector<float> incr_vertices_;
     };
 
     //________________________________________________________________________________
@@ -29,13 +29,64 @@
 #include <easy3d/core/manifold_builder.h>
 #include <easy3d/algo/tessellator.h>
 #include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
 
 
 namespace easy3d {
 
+    namespace details {
+
+        // \cond
+
+        // feed the bottom, top, and side faces of one prism into the tessellator
+        void tessellate_prism(Tessellator &tessellator, const std::vector<Polygon2> &contours, float height);
+
+        // \endcond
+
+    } // namespace details
+
+
     bool extrude(SurfaceMesh *mesh, const std::vector<Polygon2> &contours, float height) {
         Tessellator tessellator;
-        tessellator.set_winding_rule(Tessellator::WINDING_ODD);
+        details::tessellate_prism(tessellator, contours, height);
+
+        //-------------------------------------------------------------------------------------
+
+        // now we can collect the triangle faces
+        const auto &elements = tessellator.elements();
+        if (elements.empty()) {
+            LOG(WARNING) << "extrusion failed: no faces generated";
+            return false;
+        } else {
+            // the vertex index starts from 0 for each character.
+            const int offset = mesh->n_vertices();
+
+            // use ManifoldBuilder (ensuring the final model is manifold).
+            ManifoldBuilder builder(mesh);
+            builder.begin_surface();
+
+            const auto &final_vertices = tessellator.vertices();
+            for (const auto v : final_vertices)
+                builder.add_vertex(vec3(v->data()));
+
+            for (const auto &e : elements) {
+                builder.add_triangle(SurfaceMesh::Vertex(e[0] + offset),
+                                     SurfaceMesh::Vertex(e[1] + offset),
+                                     SurfaceMesh::Vertex(e[2] + offset));
+            }
+
+            builder.end_surface(false);
+            return true;
+        }
+    }
+
+
+    namespace details {
+
+        // \cond
+
+        void tessellate_prism(Tessellator &tessellator, const std::vector<Polygon2> &contours, float height) {
+            tessellator.set_winding_rule(Tessellator::WINDING_ODD);
 
 #if 1   // generate bottom faces
         tessellator.begin_polygon(vec3(0, 0, -1));
@@ -102,37 +153,11 @@ namespace easy3d {
             }
         }
 #endif
+        }
 
-        //-------------------------------------------------------------------------------------
-
-        // now we can collect the triangle faces
-
-        const auto &elements = tessellator.elements();
-        if (elements.empty()) {
-            LOG(WARNING) << "extrusion failed: no faces generated";
-            return false;
-        } else {
-            // the vertex index starts from 0 for each character.
-            const int offset = mesh->n_vertices();
-
-            // use ManifoldBuilder (ensuring the final model is manifold).
-            ManifoldBuilder builder(mesh);
-            builder.begin_surface();
-
-            const auto &final_vertices = tessellator.vertices();
-            for (const auto v : final_vertices)
-                builder.add_vertex(vec3(v->data()));
-
-            for (const auto &e : elements) {
-                builder.add_triangle(SurfaceMesh::Vertex(e[0] + offset),
-                                     SurfaceMesh::Vertex(e[1] + offset),
-                                     SurfaceMesh::Vertex(e[2] + offset));
-            }
+        // \endcond
 
-            builder.end_surface(false);
-            return true;
-        }
-    }
+    } // namespace details
 
 
     SurfaceMesh *extrude(const std::vector<Polygon2> &simple_contours, float height) {
@@ -149,4 +174,91 @@ namespace easy3d {
         }
     }
 
+
+    std::size_t extrude(SurfaceMesh *mesh, const std::vector<ExtrusionJob> &jobs) {
+        if (!mesh || jobs.empty())
+            return 0;
+
+        // each job's triangles, as a local vertex array plus an index triple array
+        struct JobResult {
+            std::vector<vec3> vertices;
+            std::vector<unsigned int> triangles;
+        };
+        std::vector<JobResult> results(jobs.size());
+
+        // tessellate the jobs over the thread pool. Each worker thread keeps one
+        // tessellator alive and resets it between jobs, so the internal pools are reused
+        // across the worker's whole share of the batch.
+        ThreadPool::global().parallel_for(0, jobs.size(), [&](std::size_t i) {
+            static thread_local Tessellator tessellator;
+            tessellator.reset();
+            if (jobs[i].contours.empty())
+                return;
+            details::tessellate_prism(tessellator, jobs[i].contours, jobs[i].height);
+
+            const auto &elements = tessellator.elements();
+            if (elements.empty())
+                return;
+            JobResult &result = results[i];
+            const auto &final_vertices = tessellator.vertices();
+            result.vertices.reserve(final_vertices.size());
+            for (const auto v : final_vertices)
+                result.vertices.push_back(vec3(v->data()));
+            result.triangles.reserve(elements.size() * 3);
+            for (const auto &e : elements) {
+                result.triangles.push_back(e[0]);
+                result.triangles.push_back(e[1]);
+                result.triangles.push_back(e[2]);
+            }
+        });
+
+        // assemble the combined mesh in one pass, with the storage sized up front
+        std::size_t num_vertices = 0, num_triangles = 0, num_done = 0;
+        for (const auto &result : results) {
+            num_vertices += result.vertices.size();
+            num_triangles += result.triangles.size() / 3;
+            if (!result.triangles.empty())
+                ++num_done;
+        }
+        if (num_done == 0) {
+            LOG(WARNING) << "extrusion failed: no faces generated";
+            return 0;
+        }
+        LOG_IF(WARNING, num_done < jobs.size())
+                << "extrusion failed for " << jobs.size() - num_done << " of the " << jobs.size() << " jobs";
+
+        mesh->reserve(static_cast<unsigned int>(mesh->n_vertices() + num_vertices),
+                      static_cast<unsigned int>(num_triangles * 3 / 2),
+                      static_cast<unsigned int>(mesh->n_faces() + num_triangles));
+
+        ManifoldBuilder builder(mesh);
+        builder.begin_surface();
+        unsigned int offset = mesh->n_vertices();
+        for (const auto &result : results) {
+            builder.add_vertices(result.vertices);
+            for (std::size_t t = 0; t < result.triangles.size(); t += 3) {
+                builder.add_triangle(SurfaceMesh::Vertex(static_cast<int>(result.triangles[t] + offset)),
+                                     SurfaceMesh::Vertex(static_cast<int>(result.triangles[t + 1] + offset)),
+                                     SurfaceMesh::Vertex(static_cast<int>(result.triangles[t + 2] + offset)));
+            }
+            offset += static_cast<unsigned int>(result.vertices.size());
+        }
+        builder.end_surface(false);
+
+        return num_done;
+    }
+
+
+    SurfaceMesh *extrude(const std::vector<ExtrusionJob> &jobs) {
+        if (jobs.empty())
+            return nullptr;
+
+        SurfaceMesh *mesh = new SurfaceMesh;
+        if (extrude(mesh, jobs) > 0)
+            return mesh;
+
+        delete mesh;
+        return nullptr;
+    }
+
 }
\ No newline at end of file
@@ -58,6 +58,38 @@ namespace easy3d {
      */
     bool extrude(SurfaceMesh *mesh, const std::vector<Polygon2> &contours, float height);
 
+    /**
+     * \brief One job of a batch extrusion: a set of simple contours and its extrusion height.
+     * \sa extrude(const std::vector<ExtrusionJob> &)
+     */
+    struct ExtrusionJob {
+        ExtrusionJob() : height(0.0f) {}
+        ExtrusionJob(const std::vector<Polygon2> &c, float h) : contours(c), height(h) {}
+        std::vector<Polygon2> contours;
+        float height;
+    };
+
+    /**
+     * \brief Extrudes many contour sets (e.g., building footprints) into one combined mesh.
+     * \details The jobs are tessellated and extruded over the library's thread pool; each
+     *      worker reuses one tessellator across its share of the jobs, and the combined mesh
+     *      is assembled from the per-job results in one pass with preallocated storage. The
+     *      contours of each job must satisfy the same requirements as for the per-call
+     *      extrude().
+     * \param mesh The output mesh model. Must be allocated before hand.
+     * @param jobs The extrusion jobs.
+     * @return The number of successfully extruded jobs.
+     */
+    std::size_t extrude(SurfaceMesh *mesh, const std::vector<ExtrusionJob> &jobs);
+
+    /**
+     * \brief Extrudes many contour sets (e.g., building footprints) into one combined mesh.
+     * \sa extrude(SurfaceMesh *, const std::vector<ExtrusionJob> &)
+     * @param jobs The extrusion jobs.
+     * @return The extruded surface mesh model. NULL if all jobs failed.
+     */
+    SurfaceMesh *extrude(const std::vector<ExtrusionJob> &jobs);
+
 }
 
 
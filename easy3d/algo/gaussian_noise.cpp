@@ -30,12 +30,35 @@
 #include <easy3d/util/logging.h>
 
 #include <chrono>
-#include <random>
+#include <cmath>
 
 
 namespace easy3d {
 
-    void GaussianNoise::apply(SurfaceMesh *mesh, float sigma) {
+    namespace details {
+
+        // a time-based seed when the user does not provide one (non-reproducible runs)
+        inline uint64_t noise_seed(unsigned int seed) {
+            if (seed != 0)
+                return seed;
+            return (uint64_t) std::chrono::system_clock::now().time_since_epoch().count();
+        }
+
+        // one noise displacement: a normally distributed offset (Box-Muller) along a random direction
+        inline vec3 noise_offset(RandomStream &rng, float sigma) {
+            const double u1 = 1.0 - rng.next_float();   // in (0, 1], so the log stays finite
+            const double u2 = rng.next_float();
+            const double offset = sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+            vec3 dir(rng.next_float() * 2.0f - 1.0f, rng.next_float() * 2.0f - 1.0f,
+                     rng.next_float() * 2.0f - 1.0f);
+            dir = normalize(dir);
+            return dir * float(offset);
+        }
+
+    }
+
+
+    void GaussianNoise::apply(SurfaceMesh *mesh, float sigma, unsigned int seed /* = 0 */) {
         if (!mesh) {
             LOG(WARNING) << "empty surface mesh";
             return;
@@ -46,20 +69,19 @@ namespace easy3d {
             return;
         }
 
-        // Define random generator with Gaussian distribution
-        const double mean = 0.0;
-        // construct a trivial random generator engine from a time-based seed:
-        unsigned int seed = (unsigned int) std::chrono::system_clock::now().time_since_epoch().count();
-        std::default_random_engine generator(seed);
-        std::normal_distribution<double> distribution(mean, sigma);
-
+        // every vertex derives its own random stream from the seed (counter-based), so the
+        // loop parallelizes without a shared generator and the noise does not depend on the
+        // number of threads
+        const uint64_t base_seed = details::noise_seed(seed);
         auto points = mesh->get_vertex_property<vec3>("v:point");
-        for (auto v : mesh->vertices()) {
-            double offset = distribution(generator);
-            vec3 dir(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f),
-                     random_float(-1.0f, 1.0f));
-            dir = normalize(dir);
-            points[v] = points[v] + dir * offset;
+        const int nv = static_cast<int>(mesh->vertices_size());
+#pragma omp parallel for
+        for (int i = 0; i < nv; ++i) {
+            SurfaceMesh::Vertex v(i);
+            if (mesh->is_deleted(v))
+                continue;
+            RandomStream rng(base_seed + static_cast<uint64_t>(i));
+            points[v] = points[v] + details::noise_offset(rng, sigma);
         }
 
         // update normals if exist
@@ -70,7 +92,7 @@ namespace easy3d {
     }
 
 
-    void GaussianNoise::apply(PointCloud *cloud, float sigma) {
+    void GaussianNoise::apply(PointCloud *cloud, float sigma, unsigned int seed /* = 0 */) {
         if (!cloud) {
             LOG(WARNING) << "empty point cloud";
             return;
@@ -81,20 +103,48 @@ namespace easy3d {
             return;
         }
 
-        // Define random generator with Gaussian distribution
-        const double mean = 0.0;
-        // construct a trivial random generator engine from a time-based seed:
-        unsigned int seed = (unsigned int) std::chrono::system_clock::now().time_since_epoch().count();
-        std::default_random_engine generator(seed);
-        std::normal_distribution<double> distribution(mean, sigma);
-
+        const uint64_t base_seed = details::noise_seed(seed);
         auto points = cloud->get_vertex_property<vec3>("v:point");
-        for (auto v : cloud->vertices()) {
-            double offset = distribution(generator);
-            vec3 dir(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f),
-                     random_float(-1.0f, 1.0f));
-            dir = normalize(dir);
-            points[v] = points[v] + dir * offset;
+        const int nv = static_cast<int>(cloud->vertices_size());
+#pragma omp parallel for
+        for (int i = 0; i < nv; ++i) {
+            PointCloud::Vertex v(i);
+            if (cloud->is_deleted(v))
+                continue;
+            RandomStream rng(base_seed + static_cast<uint64_t>(i));
+            points[v] = points[v] + details::noise_offset(rng, sigma);
+        }
+    }
+
+
+    void GaussianNoise::apply_batch(const SurfaceMesh *mesh, float sigma, unsigned int num,
+                                    std::vector< std::vector<vec3> > &variants, unsigned int seed /* = 0 */) {
+        variants.clear();
+        if (!mesh) {
+            LOG(WARNING) << "empty surface mesh";
+            return;
+        }
+
+        if (sigma <= 0) {
+            LOG(WARNING) << "sigma must be positive";
+            return;
+        }
+
+        const std::vector<vec3> &base = mesh->points();
+        const uint64_t base_seed = details::noise_seed(seed);
+        variants.resize(num);
+
+        // the variants are independent, so they are generated in parallel. The stream of a
+        // displacement is derived from the seed, the variant, and the vertex, so variant 0
+        // is exactly what apply() with the same seed produces.
+#pragma omp parallel for
+        for (int k = 0; k < static_cast<int>(num); ++k) {
+            std::vector<vec3> &variant = variants[k];
+            variant = base;
+            for (std::size_t i = 0; i < variant.size(); ++i) {
+                RandomStream rng(base_seed + static_cast<uint64_t>(k) * variant.size() + i);
+                variant[i] = variant[i] + details::noise_offset(rng, sigma);
+            }
         }
     }
 
@@ -25,6 +25,10 @@
 #ifndef EASY3D_ALGO_GAUSSIAN_NOISE_H
 #define EASY3D_ALGO_GAUSSIAN_NOISE_H
 
+#include <vector>
+
+#include <easy3d/core/types.h>
+
 
 namespace easy3d {
 
@@ -42,8 +46,11 @@ namespace easy3d {
          * @param sigma The standard deviation of the noise distribution. So about 68 percent of the noise values are
          *              within one standard deviation of the mean (mathematically, μ ± σ, where μ is the arithmetic
          *              mean), about 95 percent are within two standard deviations (μ ± 2σ).
+         * @param seed Seed of the noise. A non-zero seed makes the noise reproducible (each vertex derives its
+         *             own random stream from the seed, so the result is also independent of the number of
+         *             threads). With the default seed 0, every run produces different noise.
          */
-        static void apply(SurfaceMesh *mesh, float sigma);
+        static void apply(SurfaceMesh *mesh, float sigma, unsigned int seed = 0);
 
         /**
          * \brief Add Gaussian noise (that has a normal distribution) to a point cloud.
@@ -51,8 +58,26 @@ namespace easy3d {
          * @param sigma The standard deviation of the noise distribution. So about 68 percent of the noise values are
          *              within one standard deviation of the mean (mathematically, μ ± σ, where μ is the arithmetic
          *              mean), about 95 percent are within two standard deviations (μ ± 2σ).
+         * @param seed Seed of the noise, with the same semantics as in apply(SurfaceMesh*, float, unsigned int).
+         */
+        static void apply(PointCloud *cloud, float sigma, unsigned int seed = 0);
+
+        /**
+         * \brief Generates \p num noisy variants of the vertex positions of a mesh (e.g., for Monte-Carlo
+         *      robustness studies).
+         * \details All variants share the topology of \p mesh: only the position arrays are produced, one per
+         *      variant, instead of deep-copying the whole mesh \p num times. To evaluate variant \c k, swap its
+         *      array into the mesh (\c std::swap(mesh->points(), \c variants[k]) ) and swap it back afterwards;
+         *      this costs nothing but two pointer exchanges. With a non-zero \p seed, variant 0 is identical to
+         *      what apply(mesh, sigma, seed) would produce, and every variant is reproducible.
+         * @param mesh The surface mesh providing the base positions (not modified).
+         * @param sigma The standard deviation of the noise distribution.
+         * @param num The number of variants to generate.
+         * @param variants The resulting position arrays, one per variant (input content is discarded).
+         * @param seed Seed of the noise, with the same semantics as in apply().
          */
-        static void apply(PointCloud *cloud, float sigma);
+        static void apply_batch(const SurfaceMesh *mesh, float sigma, unsigned int num,
+                                std::vector< std::vector<vec3> > &variants, unsigned int seed = 0);
     };
 
 }
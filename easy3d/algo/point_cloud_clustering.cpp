@@ -0,0 +1,168 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/algo/point_cloud_clustering.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include <easy3d/kdtree/kdtree_search_nanoflann.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    // \cond
+    namespace details {
+
+        // A union-find over point indices whose unions are lock-free (compare-and-swap), so the
+        // neighbor links of different points can be merged concurrently. The root of a set is
+        // always its smallest member.
+        class UnionFind {
+        public:
+            UnionFind(int n) : parent_(new std::atomic<int>[n]) {
+                for (int i = 0; i < n; ++i)
+                    parent_[i].store(i, std::memory_order_relaxed);
+            }
+
+            int find(int i) {
+                while (true) {
+                    int p = parent_[i].load(std::memory_order_relaxed);
+                    if (p == i)
+                        return i;
+                    // path halving (losing the update race only costs a later retraversal)
+                    const int gp = parent_[p].load(std::memory_order_relaxed);
+                    parent_[i].compare_exchange_weak(p, gp);
+                    i = gp;
+                }
+            }
+
+            void unite(int a, int b) {
+                while (true) {
+                    a = find(a);
+                    b = find(b);
+                    if (a == b)
+                        return;
+                    if (a > b)
+                        std::swap(a, b);    // the smaller root wins
+                    int expected = b;
+                    if (parent_[b].compare_exchange_strong(expected, a))
+                        return;
+                    // b was re-parented by another thread; retry from the new roots
+                }
+            }
+
+        private:
+            std::unique_ptr<std::atomic<int>[]> parent_;
+        };
+    }
+    // \endcond
+
+
+    int PointCloudClustering::extract(PointCloud *cloud, float radius, KdTreeSearch *kdtree) {
+        if (radius <= 0.0f) {
+            LOG(ERROR) << "radius must be positive (got " << radius << ")";
+            return 0;
+        }
+        if (cloud->has_garbage())
+            cloud->collect_garbage();   // so point indices and kd-tree indices agree
+
+        const int num = static_cast<int>(cloud->n_vertices());
+        if (num == 0)
+            return 0;
+
+        KdTreeSearch_NanoFLANN own_kdtree;  // its batch queries run in parallel
+        if (!kdtree) {
+            own_kdtree.begin();
+            own_kdtree.add_point_cloud(cloud);
+            own_kdtree.end();
+            kdtree = &own_kdtree;
+        }
+
+        const std::vector<vec3> &points = cloud->points();
+        details::UnionFind uf(num);
+
+        // the radius queries are issued in chunks: the CSR neighbor lists of all points at once
+        // would not fit in memory for the very large clouds this is meant for
+        const std::size_t chunk_size = 4 * 1024 * 1024;
+        std::vector<std::size_t> offsets;
+        std::vector<int> neighbors;
+        for (std::size_t begin = 0; begin < static_cast<std::size_t>(num); begin += chunk_size) {
+            const std::size_t n = std::min(chunk_size, static_cast<std::size_t>(num) - begin);
+            kdtree->find_points_in_range(points.data() + begin, n, radius * radius, offsets, neighbors);
+
+            // merge the neighbor links of this chunk
+            const int nn = static_cast<int>(n);
+#pragma omp parallel for schedule(dynamic, 4096)
+            for (int i = 0; i < nn; ++i) {
+                const int self = static_cast<int>(begin) + i;
+                for (std::size_t t = offsets[i]; t < offsets[i + 1]; ++t) {
+                    if (neighbors[t] != self)
+                        uf.unite(self, neighbors[t]);
+                }
+            }
+        }
+
+        // compact the cluster ids in order of first occurrence
+        auto cluster = cloud->vertex_property<int>("v:cluster");
+        std::vector<int> root_id(num, -1);
+        int nb_clusters = 0;
+        for (int i = 0; i < num; ++i) {
+            const int root = uf.find(i);
+            if (root_id[root] == -1)
+                root_id[root] = nb_clusters++;
+            cluster[PointCloud::Vertex(i)] = root_id[root];
+        }
+
+        return nb_clusters;
+    }
+
+
+    std::vector<PointCloud::Vertex> PointCloudClustering::small_clusters(PointCloud *cloud,
+                                                                         unsigned int min_points) {
+        std::vector<PointCloud::Vertex> result;
+
+        auto cluster = cloud->get_vertex_property<int>("v:cluster");
+        if (!cluster) {
+            LOG(ERROR) << "point cloud has no \"v:cluster\" property (call extract() first)";
+            return result;
+        }
+
+        int nb_clusters = 0;
+        for (auto v : cloud->vertices())
+            nb_clusters = std::max(nb_clusters, cluster[v] + 1);
+
+        std::vector<unsigned int> sizes(nb_clusters, 0);
+        for (auto v : cloud->vertices())
+            ++sizes[cluster[v]];
+
+        for (auto v : cloud->vertices()) {
+            if (sizes[cluster[v]] < min_points)
+                result.push_back(v);
+        }
+        return result;
+    }
+
+} // namespace easy3d
@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_ALGO_POINT_CLOUD_CLUSTERING_H
+#define EASY3D_ALGO_POINT_CLOUD_CLUSTERING_H
+
+#include <vector>
+
+#include <easy3d/core/point_cloud.h>
+
+namespace easy3d {
+
+    class KdTreeSearch;
+
+    /// \brief Euclidean clustering of point clouds, i.e., segmentation by spatial proximity.
+    /// \class PointCloudClustering easy3d/algo/point_cloud_clustering.h
+    /// \details Two points closer than a given radius belong to the same cluster (and so does,
+    /// transitively, everything connected through such links). Typical use is dropping small
+    /// floating noise blobs from scans:
+    /// \code
+    /// PointCloudClustering::extract(cloud, radius);
+    /// for (auto v : PointCloudClustering::small_clusters(cloud, 100))
+    ///     cloud->delete_vertex(v);
+    /// cloud->collect_garbage();
+    /// \endcode
+    class PointCloudClustering {
+    public:
+        /**
+         * \brief Cluster the points of a point cloud by spatial proximity.
+         * \details The neighbor links are computed with batched kd-tree radius queries (issued
+         * in memory-bounded chunks, processed in parallel by the kd-tree backend) and merged
+         * with a lock-free union-find, so the clustering scales to clouds with hundreds of
+         * millions of points. The result is written into a vertex property "v:cluster" (int);
+         * the cluster ids are contiguous, starting at 0, in order of first occurrence (i.e.,
+         * the cluster of the first point gets id 0), which makes the labeling deterministic.
+         * \param cloud The point cloud.
+         * \param radius Points within this distance are linked into the same cluster.
+         * \param kdtree A kd-tree defined on this point cloud. If null, a kd-tree will be built
+         *        and used internally.
+         * \return The number of clusters.
+         */
+        static int extract(PointCloud *cloud, float radius, KdTreeSearch *kdtree = nullptr);
+
+        /**
+         * \brief Query the points belonging to small clusters (e.g., floating noise blobs).
+         * \details Expects the "v:cluster" property written by extract(). Following the
+         * convention of PointCloudSimplification, the points are returned instead of deleted,
+         * so the caller decides (see the class documentation for the deletion idiom).
+         * \param cloud The point cloud.
+         * \param min_points Clusters with fewer points than this are reported.
+         * \return The points of all clusters smaller than \p min_points.
+         */
+        static std::vector<PointCloud::Vertex> small_clusters(PointCloud *cloud, unsigned int min_points);
+    };
+
+} // namespace easy3d
+
+#endif  // EASY3D_ALGO_POINT_CLOUD_CLUSTERING_H
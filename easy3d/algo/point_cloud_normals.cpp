@@ -26,6 +26,9 @@
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/core/principal_axes.h>
 #include <easy3d/kdtree/kdtree_search_nanoflann.h>
+#include <easy3d/kdtree/point_cloud_neighborhood.h>
+
+#include <algorithm>
 
 #include <easy3d/util/stop_watch.h>
 
@@ -48,23 +51,30 @@
 namespace easy3d {
 
     bool PointCloudNormals::estimate(PointCloud *cloud, unsigned int k /* = 16 */,
-                                     bool compute_curvature /* = false */) const {
+                                     bool compute_curvature /* = false */,
+                                     const PointCloudNeighborhood *neighborhood /* = nullptr */) const {
         if (!cloud) {
             LOG(ERROR) << "empty input point cloud";
             return false;
         }
 
+        int num = cloud->n_vertices();
+
+        const bool use_cache = neighborhood && neighborhood->num_points() == static_cast<std::size_t>(num);
+        LOG_IF(WARNING, neighborhood && !use_cache)
+                        << "the neighborhood cache does not match the point cloud and is thus ignored";
+
         StopWatch w;
         w.start();
 
-        LOG(INFO) << "building kd_tree...";
         KdTreeSearch_NanoFLANN kdtree;
-        kdtree.begin();
-        kdtree.add_point_cloud(cloud);
-        kdtree.end();
-        LOG(INFO) << "done. " << w.time_string();
-
-        int num = cloud->n_vertices();
+        if (!use_cache) {
+            LOG(INFO) << "building kd_tree...";
+            kdtree.begin();
+            kdtree.add_point_cloud(cloud);
+            kdtree.end();
+            LOG(INFO) << "done. " << w.time_string();
+        }
         const std::vector<vec3> &points = cloud->points();
         std::vector<vec3> &normals = cloud->vertex_property<vec3>("v:normal").vector();
 
@@ -75,28 +85,47 @@ namespace easy3d {
         w.restart();
         LOG(INFO) << "estimating normals...";
 
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
-            const vec3 &p = points[i];
+#pragma omp parallel
+        {
+            // per-thread buffers, reused for all the points a thread processes
             std::vector<int> neighbors;
-            kdtree.find_closest_k_points(p, k, neighbors);
-
+            std::vector<vec3> neighbor_points;
             PrincipalAxes<3, float> pca;
-            pca.begin();
-            for (unsigned int j = 0; j < neighbors.size(); ++j) {
-                int idx = neighbors[j];
-                pca.add_point(points[idx]);
-            }
-            pca.end();
 
-            // the eigen vector corresponding to the smallest eigen value
-            normals[i] = pca.axis(2);
-            if (normals[i].z < 0) // almost have positive Z
-                normals[i] = -normals[i];
+            // dynamic chunks keep the cores busy: the query cost varies with the local
+            // point density, so equal-size static partitions finish at different times
+#pragma omp for schedule(dynamic, 4096)
+            for (int i = 0; i < num; ++i) {
+                // gather the neighborhood into a flat array, so the covariance
+                // accumulation in add_points() vectorizes
+                if (use_cache) {
+                    const int *ids = neighborhood->neighbors(i);
+                    const std::size_t found = neighborhood->size(i);
+                    neighbor_points.resize(found);
+                    for (std::size_t j = 0; j < found; ++j)
+                        neighbor_points[j] = points[ids[j]];
+                }
+                else {
+                    neighbors.clear();
+                    kdtree.find_closest_k_points(points[i], k, neighbors);
+                    neighbor_points.resize(neighbors.size());
+                    for (std::size_t j = 0; j < neighbors.size(); ++j)
+                        neighbor_points[j] = points[neighbors[j]];
+                }
+
+                pca.begin();
+                pca.add_points(neighbor_points.data(), static_cast<int>(neighbor_points.size()));
+                pca.end();
+
+                // the eigen vector corresponding to the smallest eigen value
+                normals[i] = pca.axis(2);
+                if (normals[i].z < 0) // almost have positive Z
+                    normals[i] = -normals[i];
 
-            if (compute_curvature)
-                (*curvatures)[i] = float(
-                        pca.eigen_value(2) / (pca.eigen_value(0) + pca.eigen_value(1) + pca.eigen_value(2)));
+                if (compute_curvature)
+                    (*curvatures)[i] = float(
+                            pca.eigen_value(2) / (pca.eigen_value(0) + pca.eigen_value(1) + pca.eigen_value(2)));
+            }
         }
 
         LOG(INFO) << "done. " << w.time_string();
@@ -146,41 +175,50 @@ namespace easy3d {
 
             // Step 2: create the edges connecting neighboring points.
 
-            auto points = cloud->get_vertex_property<easy3d::vec3>("v:point");
-            auto normals = cloud->get_vertex_property<easy3d::vec3>("v:normal");
-            for (auto v : cloud->vertices()) {
-                const easy3d::vec3 &p = points[v];
-
-                // The indices of the neighbors of v (NOTE: the result include v itself).
-                std::vector<int> neighbor_indices;
-                tree->find_closest_k_points(p, k, neighbor_indices);
-                if (neighbor_indices.size() < k)
-                    continue; // in extreme cases, a point cloud can have less than K points
-
-                // now let's create the edges
-                for (std::size_t i = 0; i < neighbor_indices.size(); ++i) {
-                    int index = neighbor_indices[i];
-                    if (index == v.idx())
-                        continue; // this is actually the current vertex
+            // The neighborhoods of all the points are queried in one parallel batch. The
+            // edges are then deduplicated by normalizing each pair to (smaller, greater)
+            // and sorting, which avoids the per-candidate adjacency scan of boost::edge().
+            const std::size_t num = cloud->n_vertices();
+            const std::vector<easy3d::vec3> &points = cloud->points();
+            std::vector<int> neighbor_indices(num * k);
+            tree->find_closest_k_points(points.data(), num, static_cast<int>(k), neighbor_indices.data());
 
-                    easy3d::PointCloud::Vertex v2(index);
-                    RiemannianGraph::Vertex vd1 = vertex_descriptors[v];
-                    RiemannianGraph::Vertex vd2 = vertex_descriptors[v2];
-                    std::pair<RiemannianGraph::Edge, bool> ed = boost::edge(vd1, vd2, graph);
-                    if (ed.second)
-                        continue; // the edge already exists.
-
-                    const easy3d::vec3 &n1 = normals[v];
-                    const easy3d::vec3 &n2 = normals[v2];
-                    float weight = 1.0f - std::abs(dot(n1, n2));
-                    if (weight < 0)
-                        weight = 0; // safety check
-
-                    // add an edge to the graph: add_edge()
-                    boost::add_edge(vd1, vd2, EdgeProperty(weight), graph);
+            std::vector< std::pair<int, int> > candidate_edges(num * k, std::make_pair(-1, -1));
+#pragma omp parallel for
+            for (long long i = 0; i < static_cast<long long>(num); ++i) {
+                // in extreme cases, a point cloud can have less than K points (then the
+                // trailing slots are -1)
+                if (neighbor_indices[i * k + k - 1] < 0)
+                    continue;
+                for (unsigned int j = 0; j < k; ++j) {
+                    const int index = neighbor_indices[i * k + j];
+                    if (index == static_cast<int>(i))
+                        continue; // this is actually the current vertex
+                    candidate_edges[i * k + j] = std::make_pair(
+                            std::min(static_cast<int>(i), index),
+                            std::max(static_cast<int>(i), index));
                 }
             }
 
+            std::sort(candidate_edges.begin(), candidate_edges.end());
+            candidate_edges.erase(std::unique(candidate_edges.begin(), candidate_edges.end()),
+                                  candidate_edges.end());
+
+            auto normals = cloud->get_vertex_property<easy3d::vec3>("v:normal");
+            for (const auto &e : candidate_edges) {
+                if (e.first < 0)
+                    continue; // the (-1, -1) entries of skipped candidates
+                easy3d::PointCloud::Vertex v1(e.first), v2(e.second);
+                const easy3d::vec3 &n1 = normals[v1];
+                const easy3d::vec3 &n2 = normals[v2];
+                float weight = 1.0f - std::abs(dot(n1, n2));
+                if (weight < 0)
+                    weight = 0; // safety check
+
+                // add an edge to the graph: add_edge()
+                boost::add_edge(vertex_descriptors[v1], vertex_descriptors[v2], EdgeProperty(weight), graph);
+            }
+
             cloud->remove_vertex_property(vertex_descriptors);
         }
 
@@ -406,22 +444,26 @@ namespace easy3d {
                   << ", #components: " << components.size()
                   << ". " << w.time_string();
 
+        // The components are disjoint (each spanning tree only touches the normals of its own
+        // component), so the spanning trees can be extracted and traversed in parallel. Within a
+        // component the MST and the propagation along it remain sequential.
         w.restart();
         LOG(INFO) << "extract minimum spanning tree...";
         std::vector<details::MST_Graph> ms_trees;
-        for (const auto &graph : components) {
+        for (std::size_t i = 0; i < components.size(); ++i)
             ms_trees.emplace_back(cloud->get_vertex_property<vec3>("v:normal"));
-            details::MST_Graph &mst = ms_trees.back();
-            details::extract_minimum_spanning_tree(graph, mst);
-        }
+#pragma omp parallel for schedule(dynamic)
+        for (long long i = 0; i < static_cast<long long>(components.size()); ++i)
+            details::extract_minimum_spanning_tree(components[i], ms_trees[i]);
         LOG(INFO) << "done. " << w.time_string();
 
         w.restart();
         LOG(INFO) << "propagate...";
-        for (const auto &mst : ms_trees) {
+#pragma omp parallel for schedule(dynamic)
+        for (long long i = 0; i < static_cast<long long>(ms_trees.size()); ++i) {
             // Traverse the point set along the MST to propagate source_point's orientation
             details::BfsVisitor<details::MST_Graph> bfsVisitor(details::propagate_normal);
-            boost::breadth_first_search(mst, mst.root, boost::visitor(bfsVisitor));
+            boost::breadth_first_search(ms_trees[i], ms_trees[i].root, boost::visitor(bfsVisitor));
         }
         LOG(INFO) << "done. " << w.time_string();
 
@@ -31,6 +31,7 @@
 namespace easy3d {
 
     class PointCloud;
+    class PointCloudNeighborhood;
 
     /// \brief Estimate point cloud normals. It also allows to reorients the point cloud normals based on a minimum
     /// spanning tree algorithm.
@@ -40,7 +41,13 @@ namespace easy3d {
         /// \brief Estimates the point cloud normals using PCA.
         /// @param k: the number of neighboring points to construct the covariance matrix.
         /// @param compute_curvature: also computes the curvature?
-        bool estimate(PointCloud *cloud, unsigned int k = 16, bool compute_curvature = false) const;
+        /// @param neighborhood: precomputed neighborhoods of the points (see PointCloudNeighborhood),
+        ///        so the kd-tree construction and queries are skipped. If null (the default), the
+        ///        neighborhoods are queried from a kd-tree built internally. Useful when several
+        ///        neighborhood-based stages run on the same cloud. \note The cache is expected to
+        ///        be built with build_knn() and the same \p k.
+        bool estimate(PointCloud *cloud, unsigned int k = 16, bool compute_curvature = false,
+                      const PointCloudNeighborhood *neighborhood = nullptr) const;
 
         /// \brief Reorients the point cloud normals.
         /// This method implements the normal reorientation method described in
@@ -110,12 +110,18 @@ namespace easy3d {
         confidence_ = false;
         normalWeight_ = false;
         verbose_ = false;
+        lowMemory_ = false;
     }
 
     PoissonReconstruction::~PoissonReconstruction(void) {
     }
 
 
+    void PoissonReconstruction::set_num_threads(int n) {
+        threads_ = (n > 0) ? n : omp_get_num_procs();
+    }
+
+
     // \cond
     namespace details {
 
@@ -217,7 +223,9 @@ namespace easy3d {
         REAL isoValue = 0;
 
         //if (OctNode< TreeNodeData >::NodeAllocator.blockSize != MEMORY_ALLOCATOR_BLOCK_SIZE)
-        OctNode<TreeNodeData>::SetAllocator(MEMORY_ALLOCATOR_BLOCK_SIZE);
+        // in low-memory mode the nodes are allocated individually (block size 0), so the memory of
+        // discarded nodes goes back to the heap immediately instead of staying in the pools
+        OctNode<TreeNodeData>::SetAllocator(lowMemory_ ? 0 : MEMORY_ALLOCATOR_BLOCK_SIZE);
 
         Reset<REAL>();
         Octree<REAL> tree;
@@ -447,6 +455,7 @@ namespace easy3d {
                 *colorData = tree.template setDataField<DATA_DEGREE, false>(*samples, *sampleData,
                                                                             (DensityEstimator *) nullptr);
                 delete sampleData, sampleData = nullptr;
+                delete samples, samples = nullptr; // the samples are not needed beyond this point either
                 for (const OctNode<TreeNodeData> *n = tree.tree().nextNode(); n; n = tree.tree().nextNode(n)) {
                     ProjectiveData<Point3D<REAL>, REAL> *clr = (*colorData)(n);
                     if (clr)
@@ -82,6 +82,24 @@ namespace easy3d {
         void set_normal_weight(bool v) { normalWeight_ = v; }
         void set_verbose(bool v) { verbose_ = v; }
 
+        /**
+         * \brief Set the number of threads used for the reconstruction.
+         * The reconstructor is parallelized with OpenMP and by default uses all available cores.
+         * Passing a value <= 0 restores this default. This is only effective if OpenMP was
+         * enabled when Easy3D was built.
+         */
+        void set_num_threads(int n);
+
+        /**
+         * \brief Trade reconstruction speed for a smaller memory footprint.
+         * In low-memory mode the octree nodes are allocated individually instead of from pooled
+         * memory blocks (the pools are only returned to the system when the reconstruction
+         * finishes), which noticeably reduces the peak memory usage of deep (e.g., depth >= 12)
+         * reconstructions at the cost of a slower octree construction. The extracted surface is
+         * always streamed to a temporary file, so it does not add to the peak. Disabled by default.
+         */
+        void set_low_memory_mode(bool v) { lowMemory_ = v; }
+
     private:
         /*
         This integer is the maximum depth of the tree that will be used for surface
@@ -129,6 +147,7 @@ namespace easy3d {
         bool confidence_;
         bool normalWeight_;
         bool verbose_;
+        bool lowMemory_;
     };
 
 } // namespace easy3d
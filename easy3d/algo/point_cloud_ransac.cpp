@@ -26,6 +26,10 @@
 
 #include <set>
 #include <list>
+#include <map>
+#include <stack>
+#include <cmath>
+#include <functional>
 
 #include <easy3d/core/point_cloud.h>
 
@@ -49,6 +53,32 @@ namespace easy3d {
     // \cond
     namespace details {
 
+        // set which primitives are to be detected by adding the respective constructors
+        void setup_detector(RansacShapeDetector &detector, const std::set<PrimitivesRansac::PrimType> &types) {
+            std::set<PrimitivesRansac::PrimType>::const_iterator it = types.begin();
+            for (; it != types.end(); ++it) {
+                switch (*it) {
+                    case PrimitivesRansac::PLANE:
+                        detector.Add(new PlanePrimitiveShapeConstructor());
+                        break;
+                    case PrimitivesRansac::CYLINDER:
+                        detector.Add(new CylinderPrimitiveShapeConstructor());
+                        break;
+                    case PrimitivesRansac::SPHERE:
+                        detector.Add(new SpherePrimitiveShapeConstructor());
+                        break;
+                    case PrimitivesRansac::CONE:
+                        detector.Add(new ConePrimitiveShapeConstructor());
+                        break;
+                    case PrimitivesRansac::TORUS:
+                        detector.Add(new TorusPrimitiveShapeConstructor());
+                        break;
+                    case PrimitivesRansac::UNKNOWN:
+                        break;
+                }
+            }
+        }
+
         // returns the number of detected primitives
         int do_detect(
                 PointCloud *cloud,
@@ -80,30 +110,7 @@ namespace easy3d {
             ransacOptions.m_probability = overlook_prob;
 
             RansacShapeDetector detector(ransacOptions); // the detector object
-
-            // set which primitives are to be detected by adding the respective constructors
-            std::set<PrimitivesRansac::PrimType>::const_iterator it = types.begin();
-            for (; it != types.end(); ++it) {
-                switch (*it) {
-                    case PrimitivesRansac::PLANE:
-                        detector.Add(new PlanePrimitiveShapeConstructor());
-                        break;
-                    case PrimitivesRansac::CYLINDER:
-                        detector.Add(new CylinderPrimitiveShapeConstructor());
-                        break;
-                    case PrimitivesRansac::SPHERE:
-                        detector.Add(new SpherePrimitiveShapeConstructor());
-                        break;
-                    case PrimitivesRansac::CONE:
-                        detector.Add(new ConePrimitiveShapeConstructor());
-                        break;
-                    case PrimitivesRansac::TORUS:
-                        detector.Add(new TorusPrimitiveShapeConstructor());
-                        break;
-                    case PrimitivesRansac::UNKNOWN:
-                        break;
-                }
-            }
+            setup_detector(detector, types);
 
             MiscLib::Vector<std::pair<MiscLib::RefCountPtr<PrimitiveShape>, size_t> > shapes; // stores the detected shapes
             // returns number of unassigned points
@@ -220,6 +227,169 @@ namespace easy3d {
             LOG(INFO) << index << " primitives extracted. " << remaining << " points remained";
             return index;
         }
+
+
+        // a primitive detected in a single octree cell, with the parameters needed for
+        // merging compatible primitives across cell boundaries
+        struct DetectedPrimitive {
+            int type;
+            Vec3f pos;  // plane: position; sphere/torus: center; cylinder: axis position; cone: apex
+            Vec3f dir;  // plane: normal; cylinder/cone/torus: axis direction
+            float r1;   // sphere/cylinder: radius; cone: opening angle (radians); torus: minor radius
+            float r2;   // torus: major radius
+            std::vector<int> vts;   // the supporting vertices (indices into the easy3d point cloud)
+        };
+
+
+        // runs the detector on the points of a single cell and appends the detected primitives
+        // (with their supporting vertices and parameters) to \p primitives
+        void detect_in_cell(
+                const std::vector<vec3> &pts,
+                const std::vector<vec3> &nms,
+                const std::vector<int> &indices,
+                const Box3 &cell_box,
+                const std::set<PrimitivesRansac::PrimType> &types,
+                const RansacShapeDetector::Options &ransacOptions,
+                std::vector<DetectedPrimitive> &primitives
+        ) {
+            PointCloud_Ransac pc;
+            pc.resize(indices.size());
+
+#pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(indices.size()); ++i) {
+                const vec3 &p = pts[indices[i]];
+                const vec3 &n = nms[indices[i]];
+                pc[i] = Point(
+                        Vec3f(p.x, p.y, p.z),
+                        Vec3f(n.x, n.y, n.z)
+                );
+                pc[i].index = indices[i];
+            }
+
+            pc.setBBox(
+                    Vec3f(static_cast<float>(cell_box.min(0)), static_cast<float>(cell_box.min(1)),
+                          static_cast<float>(cell_box.min(2))),
+                    Vec3f(static_cast<float>(cell_box.max(0)), static_cast<float>(cell_box.max(1)),
+                          static_cast<float>(cell_box.max(2)))
+            );
+
+            RansacShapeDetector detector(ransacOptions);
+            setup_detector(detector, types);
+
+            MiscLib::Vector<std::pair<MiscLib::RefCountPtr<PrimitiveShape>, size_t> > shapes;
+            detector.Detect(pc, 0, pc.size(), &shapes);
+
+            PointCloud_Ransac::reverse_iterator start = pc.rbegin();
+            MiscLib::Vector<std::pair<MiscLib::RefCountPtr<PrimitiveShape>, std::size_t> >::const_iterator shape_itr = shapes.begin();
+            for (; shape_itr != shapes.end(); ++shape_itr) {
+                const PrimitiveShape *primitive = shape_itr->first;
+                std::size_t num = shape_itr->second;
+
+                DetectedPrimitive s;
+                s.type = primitive->Identifier();
+                s.r1 = s.r2 = 0.0f;
+                s.vts.reserve(num);
+                PointCloud_Ransac::reverse_iterator point_itr = start;
+                for (std::size_t count = 0; count < num; ++count) {
+                    s.vts.push_back(int(point_itr->index));
+                    ++point_itr;
+                }
+                start = point_itr;
+
+                if (num < ransacOptions.m_minSupport)
+                    continue;
+
+                switch (s.type) {
+                    case PrimitivesRansac::PLANE: {
+                        const Plane &pl = dynamic_cast<const PlanePrimitiveShape *>(primitive)->Internal();
+                        s.pos = pl.getPosition();
+                        s.dir = pl.getNormal();
+                        s.r1 = pl.SignedDistToOrigin();
+                        break;
+                    }
+                    case PrimitivesRansac::SPHERE: {
+                        const Sphere &sphere = dynamic_cast<const SpherePrimitiveShape *>(primitive)->Internal();
+                        s.pos = sphere.Center();
+                        s.r1 = sphere.Radius();
+                        break;
+                    }
+                    case PrimitivesRansac::CYLINDER: {
+                        const Cylinder &cylinder = dynamic_cast<const CylinderPrimitiveShape *>(primitive)->Internal();
+                        s.pos = cylinder.AxisPosition();
+                        s.dir = cylinder.AxisDirection();
+                        s.r1 = cylinder.Radius();
+                        break;
+                    }
+                    case PrimitivesRansac::CONE: {
+                        const Cone &cone = dynamic_cast<const ConePrimitiveShape *>(primitive)->Internal();
+                        s.pos = cone.Center();  // the apex of the cone
+                        s.dir = cone.AxisDirection();
+                        s.r1 = cone.Angle();
+                        break;
+                    }
+                    case PrimitivesRansac::TORUS: {
+                        const Torus &torus = dynamic_cast<const TorusPrimitiveShape *>(primitive)->Internal();
+                        s.pos = torus.Center();
+                        s.dir = torus.AxisDirection();
+                        s.r1 = torus.MinorRadius();
+                        s.r2 = torus.MajorRadius();
+                        break;
+                    }
+                    default:
+                        continue;
+                }
+                primitives.push_back(s);
+            }
+        }
+
+
+        // do the two primitives (detected in different cells) describe the same surface?
+        bool compatible(const DetectedPrimitive &a, const DetectedPrimitive &b,
+                        float dist_tolerance, float normal_thresh) {
+            if (a.type != b.type)
+                return false;
+
+            const float angle_tolerance = std::acos(std::min(normal_thresh, 1.0f));
+            switch (a.type) {
+                case PrimitivesRansac::PLANE: {
+                    const float d = a.dir.dot(b.dir);
+                    if (std::fabs(d) < normal_thresh)
+                        return false;
+                    // compare the signed distances to the origin (the normals may be oppositely oriented)
+                    const float dist_b = (d >= 0.0f) ? b.r1 : -b.r1;
+                    return std::fabs(a.r1 - dist_b) <= dist_tolerance;
+                }
+                case PrimitivesRansac::SPHERE:
+                    return (a.pos - b.pos).length() <= dist_tolerance &&
+                           std::fabs(a.r1 - b.r1) <= dist_tolerance;
+                case PrimitivesRansac::CYLINDER: {
+                    if (std::fabs(a.dir.dot(b.dir)) < normal_thresh)
+                        return false;
+                    if (std::fabs(a.r1 - b.r1) > dist_tolerance)
+                        return false;
+                    // distance of b's axis position to a's axis
+                    const Vec3f d = b.pos - a.pos;
+                    const Vec3f perp = d - a.dir * d.dot(a.dir);
+                    return perp.length() <= dist_tolerance;
+                }
+                case PrimitivesRansac::CONE: {
+                    if (a.dir.dot(b.dir) < normal_thresh)    // cones are oriented
+                        return false;
+                    if ((a.pos - b.pos).length() > dist_tolerance)   // the apexes
+                        return false;
+                    return std::fabs(a.r1 - b.r1) <= angle_tolerance;   // the opening angles
+                }
+                case PrimitivesRansac::TORUS: {
+                    if (std::fabs(a.dir.dot(b.dir)) < normal_thresh)
+                        return false;
+                    if ((a.pos - b.pos).length() > dist_tolerance)
+                        return false;
+                    return std::fabs(a.r1 - b.r1) <= dist_tolerance &&
+                           std::fabs(a.r2 - b.r2) <= dist_tolerance;
+                }
+            }
+            return false;
+        }
     }
     // \endcond
 
@@ -328,4 +498,167 @@ namespace easy3d {
         return details::do_detect(cloud, pc, types_, min_support, dist_thresh, bitmap_reso, normal_thresh, overlook_prob);
     }
 
+
+    int PrimitivesRansac::detect_parallel(
+            PointCloud *cloud,
+            unsigned int min_support /* = 1000 */,
+            float dist_thresh /* = 0.005 */,
+            float bitmap_reso /* = 0.02 */,
+            float normal_thresh /* = 0.8 */,
+            float overlook_prob /* = 0.001 */,
+            unsigned int max_points_per_cell /* = 10000000 */,
+            unsigned int seed /* = 1 */ ) {
+        if (!cloud) {
+            LOG(ERROR) << "no data exists";
+            return 0;
+        }
+
+        if (cloud->n_vertices() < 3) {
+            LOG(ERROR) << "point set has less than 3 points";
+            return 0;
+        }
+
+        if (types_.empty()) {
+            LOG(ERROR) << "no primitive types specified";
+            return 0;
+        }
+
+        PointCloud::VertexProperty<vec3> normals = cloud->get_vertex_property<vec3>("v:normal");
+        if (!normals) {
+            LOG(ERROR) << "RANSAC Detector requires point cloud normals";
+            return 0;
+        }
+
+        const std::vector<vec3> &nms = normals.vector();
+        const std::vector<vec3> &pts = cloud->points();
+
+        // the thresholds are relative to the bounding box of the entire cloud, so that all cells
+        // are detected with exactly the same tolerances as in detect()
+        const Box3 &box = cloud->bounding_box();
+        const float scale = std::max(box.range(0), std::max(box.range(1), box.range(2)));
+        RansacShapeDetector::Options ransacOptions;
+        ransacOptions.m_minSupport = min_support;
+        ransacOptions.m_epsilon = dist_thresh * scale;
+        ransacOptions.m_bitmapEpsilon = bitmap_reso * scale;
+        ransacOptions.m_normalThresh = normal_thresh;
+        ransacOptions.m_probability = overlook_prob;
+
+        // subdivide the bounding box octree-style until no cell holds more than max_points_per_cell points
+        struct Cell {
+            Box3 box;
+            std::vector<int> indices;
+            int depth;
+        };
+        std::vector<Cell> leaves;
+        {
+            std::stack<Cell> stack;
+            Cell root;
+            root.box = box;
+            root.depth = 0;
+            root.indices.resize(pts.size());
+            for (int i = 0; i < static_cast<int>(pts.size()); ++i)
+                root.indices[i] = i;
+            stack.push(root);
+
+            while (!stack.empty()) {
+                Cell cell = stack.top();
+                stack.pop();
+                // the depth guard protects against degenerate inputs (e.g., many duplicate points)
+                if (cell.indices.size() <= max_points_per_cell || cell.depth >= 16) {
+                    leaves.push_back(cell);
+                    continue;
+                }
+                const vec3 center = cell.box.center();
+                Cell children[8];
+                for (int c = 0; c < 8; ++c) {
+                    // the child box spans [min, center] or [center, max] per axis
+                    vec3 bmin = cell.box.min(), bmax = center;
+                    for (int d = 0; d < 3; ++d) {
+                        if (c & (1 << d)) {
+                            bmin[d] = center[d];
+                            bmax[d] = cell.box.max(d);
+                        }
+                    }
+                    children[c].box = Box3(bmin, bmax);
+                    children[c].depth = cell.depth + 1;
+                }
+                for (auto id : cell.indices) {
+                    const vec3 &p = pts[id];
+                    const int c = (p.x >= center.x ? 1 : 0) | (p.y >= center.y ? 2 : 0) | (p.z >= center.z ? 4 : 0);
+                    children[c].indices.push_back(id);
+                }
+                for (int c = 0; c < 8; ++c) {
+                    if (!children[c].indices.empty())
+                        stack.push(children[c]);
+                }
+            }
+        }
+        LOG(INFO) << "detecting primitives in " << leaves.size() << " octree cells...";
+
+        // detect the primitives cell by cell. The cells are processed in deterministic order, each
+        // with its own seed; within a cell the detector itself generates and evaluates the candidates
+        // in parallel on all cores. Running several detector instances concurrently is not an option:
+        // the detector keeps its random number state in globals (and is parallel internally already).
+        std::vector<details::DetectedPrimitive> primitives;
+        for (std::size_t c = 0; c < leaves.size(); ++c) {
+            if (leaves[c].indices.size() < min_support)
+                continue;   // this cell cannot support a primitive; its points remain unassigned
+            RansacShapeDetector::Options cellOptions = ransacOptions;
+            cellOptions.m_seed = seed + static_cast<unsigned int>(c);
+            details::detect_in_cell(pts, nms, leaves[c].indices, leaves[c].box, types_, cellOptions, primitives);
+        }
+
+        // merge primitives of the same type with compatible parameters across cell boundaries
+        // (union-find; the number of primitives is small, so the quadratic pass is negligible)
+        std::vector<int> parent(primitives.size());
+        for (std::size_t i = 0; i < parent.size(); ++i)
+            parent[i] = static_cast<int>(i);
+        std::function<int(int)> find = [&](int i) -> int {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        };
+        // consistent with the detector, which internally takes 3 * epsilon as the distance threshold
+        const float dist_tolerance = 3.0f * ransacOptions.m_epsilon;
+        for (std::size_t i = 0; i < primitives.size(); ++i) {
+            for (std::size_t j = i + 1; j < primitives.size(); ++j) {
+                if (details::compatible(primitives[i], primitives[j], dist_tolerance, normal_thresh)) {
+                    const int ri = find(static_cast<int>(i)), rj = find(static_cast<int>(j));
+                    if (ri != rj)
+                        parent[rj] = ri;
+                }
+            }
+        }
+
+        // assign a compact index per merged group and write the result into the vertex properties
+        auto primitive_types = cloud->vertex_property<int>("v:primitive_type", UNKNOWN);
+        auto primitive_indices = cloud->vertex_property<int>("v:primitive_index", -1);
+        primitive_types.vector().assign(cloud->n_vertices(), UNKNOWN);
+        primitive_indices.vector().assign(cloud->n_vertices(), -1);
+
+        std::map<int, int> root_to_index;
+        for (std::size_t i = 0; i < primitives.size(); ++i) {
+            const int root = find(static_cast<int>(i));
+            int index;
+            auto pos = root_to_index.find(root);
+            if (pos == root_to_index.end()) {
+                index = static_cast<int>(root_to_index.size());
+                root_to_index[root] = index;
+            } else
+                index = pos->second;
+
+            for (auto id : primitives[i].vts) {
+                const PointCloud::Vertex v(id);
+                primitive_types[v] = primitives[i].type;
+                primitive_indices[v] = index;
+            }
+        }
+
+        const int num = static_cast<int>(root_to_index.size());
+        LOG(INFO) << num << " primitives extracted (" << primitives.size() << " before merging across cells)";
+        return num;
+    }
+
 }
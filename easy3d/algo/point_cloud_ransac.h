@@ -89,6 +89,29 @@ namespace easy3d {
                 float overlook_prob = 0.001f    // the probability with which a primitive is overlooked
         );
 
+        /// \brief Extract primitives from a (large) point cloud by processing it in octree cells.
+        /// Returns the number of extracted primitives (after merging).
+        /// The bounding box of the cloud is subdivided octree-style until no cell holds more than
+        /// \p max_points_per_cell points. The detector is then run per cell (candidate generation within a
+        /// cell uses all cores) and primitives of the same type with compatible parameters are merged
+        /// across cell boundaries afterwards. This keeps the working set of the detector small, so the cost
+        /// grows linearly with the input size, making it the method of choice for huge scans. The result
+        /// may differ from detect(): a primitive must gather at least \p min_support points within a single
+        /// cell to be found at all. Each cell is seeded deterministically from \p seed, so runs with the
+        /// same input, parameters, and seed are reproducible.
+        /// The extracted primitives are stored in the same "v:primitive_type" and "v:primitive_index"
+        /// vertex properties as for detect().
+        int detect_parallel(
+                PointCloud *cloud,
+                unsigned int min_support = 1000,    // the minimal number of points required for a primitive
+                float dist_thresh = 0.005f,    // relative to the bounding box width. NOTE: Internally the distance threshold is taken as 3 * distance_threshold!!!
+                float bitmap_reso = 0.02f,    // relative to the bounding box width. NOTE: This threshold is NOT multiplied internally!
+                float normal_thresh = 0.8f,    // the cos of the maximal normal deviation
+                float overlook_prob = 0.001f,    // the probability with which a primitive is overlooked
+                unsigned int max_points_per_cell = 10000000,    // cells are subdivided until below this size
+                unsigned int seed = 1    // seed for the random number generators (each cell derives its own seed from it)
+        );
+
     private:
         std::set<PrimType> types_;
     };
@@ -0,0 +1,219 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/algo/point_cloud_registration.h>
+
+#include <cmath>
+
+#include <easy3d/algo/point_cloud_normals.h>
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/kdtree/kdtree_search_nanoflann.h>
+#include <easy3d/util/logging.h>
+
+#include <Eigen/Dense>
+
+
+namespace easy3d {
+
+    PointCloudRegistration::PointCloudRegistration(PointCloud *source, PointCloud *target)
+            : source_(source), target_(target), kdtree_(nullptr),
+              max_iterations_(50), convergence_delta_(1e-4f), max_distance_(0.0f),
+              num_levels_(3), coarse_sample_size_(50000),
+              transformation_(mat4::identity()), rmse_(0.0f), iterations_(0) {
+        // the planes of the point-to-plane error are defined by the target normals
+        if (!target_->get_vertex_property<vec3>("v:normal"))
+            PointCloudNormals().estimate(target_);
+
+        kdtree_ = new KdTreeSearch_NanoFLANN;   // its batch queries run in parallel
+        kdtree_->begin();
+        kdtree_->add_point_cloud(target_);
+        kdtree_->end();
+    }
+
+
+    PointCloudRegistration::~PointCloudRegistration() {
+        delete kdtree_;
+    }
+
+
+    bool PointCloudRegistration::align(const mat4 &initial) {
+        transformation_ = initial;
+        rmse_ = 0.0f;
+        iterations_ = 0;
+
+        const std::vector<vec3> &src_points = source_->points();
+        const int total = static_cast<int>(src_points.size());
+        if (total == 0 || target_->n_vertices() == 0) {
+            LOG(WARNING) << "empty point cloud, nothing to align";
+            return false;
+        }
+
+        // const access only: the iterations read the clouds concurrently, and a non-const
+        // property access would detach their copy-on-write storage
+        const PointCloud::VertexProperty<vec3> normal_prop = target_->get_vertex_property<vec3>("v:normal");
+        const std::vector<vec3> &tgt_normals = normal_prop.vector();
+        const std::vector<vec3> &tgt_points = target_->points();
+
+        const float base_distance = max_distance_ > 0.0f
+                                    ? max_distance_
+                                    : target_->bounding_box().diagonal() * 0.05f;
+
+        bool converged = false;
+
+        // coarse to fine: each finer level samples 4x more points, gets half the iteration
+        // budget, and accepts correspondences within half the distance
+        for (int level = num_levels_ - 1; level >= 0; --level) {
+            const long long wanted = static_cast<long long>(coarse_sample_size_)
+                                     << (2 * (num_levels_ - 1 - level));
+            const int stride = static_cast<int>(std::max(1LL, total / std::max(1LL, wanted)));
+            const float max_dist = base_distance / static_cast<float>(1 << (num_levels_ - 1 - level));
+            const float max_dist2 = max_dist * max_dist;
+
+            std::vector<int> sample;
+            sample.reserve(total / stride + 1);
+            for (int i = 0; i < total; i += stride)
+                sample.push_back(i);
+            const int n = static_cast<int>(sample.size());
+
+            std::vector<vec3> transformed(n);
+            std::vector<int> closest(n);
+
+            const int iters = std::max(5, max_iterations_ >> (num_levels_ - 1 - level));
+            float prev_rmse = -1.0f;
+
+            for (int it = 0; it < iters; ++it, ++iterations_) {
+                // move the sampled source points by the current estimate
+#pragma omp parallel for
+                for (int i = 0; i < n; ++i)
+                    transformed[i] = transformation_ * src_points[sample[i]];
+
+                // correspondences: one parallel batch query against the target
+                kdtree_->find_closest_k_points(transformed.data(), n, 1, closest.data());
+
+                // accumulate the normal equations J^T J x = J^T r of the linearized
+                // point-to-plane error, with x = (omega, t) the rotation/translation update
+                double AtA[21] = {0};   // upper triangle of the symmetric 6x6 matrix
+                double Atb[6] = {0};
+                double error = 0;
+                long long count = 0;
+#pragma omp parallel
+                {
+                    double AtA_l[21] = {0}, Atb_l[6] = {0}, error_l = 0;
+                    long long count_l = 0;
+#pragma omp for nowait
+                    for (int i = 0; i < n; ++i) {
+                        const int j = closest[i];
+                        if (j < 0)
+                            continue;
+                        const vec3 &p = transformed[i];
+                        const vec3 d = p - tgt_points[j];
+                        if (length2(d) > max_dist2)
+                            continue;   // outlier / non-overlapping region
+
+                        const vec3 &nrm = tgt_normals[j];
+                        const double r = dot(nrm, d);
+                        const vec3 c = cross(p, nrm);
+                        const double a[6] = {c.x, c.y, c.z, nrm.x, nrm.y, nrm.z};
+                        int idx = 0;
+                        for (int u = 0; u < 6; ++u) {
+                            for (int v = u; v < 6; ++v)
+                                AtA_l[idx++] += a[u] * a[v];
+                            Atb_l[u] -= r * a[u];
+                        }
+                        error_l += r * r;
+                        ++count_l;
+                    }
+#pragma omp critical
+                    {
+                        for (int u = 0; u < 21; ++u) AtA[u] += AtA_l[u];
+                        for (int u = 0; u < 6; ++u) Atb[u] += Atb_l[u];
+                        error += error_l;
+                        count += count_l;
+                    }
+                }
+
+                if (count < 6) {
+                    LOG(WARNING) << "too few correspondences (" << count
+                                 << "); is the initial transformation a rough pre-alignment?";
+                    return false;
+                }
+                rmse_ = static_cast<float>(std::sqrt(error / static_cast<double>(count)));
+
+                Eigen::Matrix<double, 6, 6> A;
+                Eigen::Matrix<double, 6, 1> b;
+                int idx = 0;
+                for (int u = 0; u < 6; ++u) {
+                    for (int v = u; v < 6; ++v) {
+                        A(u, v) = AtA[idx];
+                        A(v, u) = AtA[idx];
+                        ++idx;
+                    }
+                    b(u) = Atb[u];
+                }
+                const Eigen::Matrix<double, 6, 1> x = A.ldlt().solve(b);
+
+                // apply the update: a small rotation (axis-angle omega) followed by a translation
+                const vec3 omega(static_cast<float>(x(0)), static_cast<float>(x(1)), static_cast<float>(x(2)));
+                const vec3 t(static_cast<float>(x(3)), static_cast<float>(x(4)), static_cast<float>(x(5)));
+                mat4 update = mat4::translation(t);
+                if (length2(omega) > 0)
+                    update = update * mat4::rotation(omega);
+                transformation_ = update * transformation_;
+
+                // converged at this level?
+                if (prev_rmse >= 0.0f &&
+                    std::abs(prev_rmse - rmse_) <= convergence_delta_ * std::max(prev_rmse, 1e-12f)) {
+                    converged = (level == 0);
+                    break;
+                }
+                prev_rmse = rmse_;
+            }
+        }
+
+        LOG(INFO) << "registration done: rmse = " << rmse_ << " (" << iterations_ << " iterations)";
+        return converged;
+    }
+
+
+    void PointCloudRegistration::apply() const {
+        auto points = source_->get_vertex_property<vec3>("v:point");
+        std::vector<vec3> &pts = points.vector();   // detach once, before the parallel writes
+        const int num = static_cast<int>(pts.size());
+#pragma omp parallel for
+        for (int i = 0; i < num; ++i)
+            pts[i] = transformation_ * pts[i];
+
+        auto normals = source_->get_vertex_property<vec3>("v:normal");
+        if (normals) {
+            const mat3 rotation(transformation_);   // rigid: the upper-left 3x3 is the rotation
+            std::vector<vec3> &nrms = normals.vector();
+#pragma omp parallel for
+            for (int i = 0; i < num; ++i)
+                nrms[i] = normalize(rotation * nrms[i]);
+        }
+
+        source_->invalidate_bounding_box();
+    }
+
+} // namespace easy3d
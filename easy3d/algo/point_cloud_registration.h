@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_ALGO_POINT_CLOUD_REGISTRATION_H
+#define EASY3D_ALGO_POINT_CLOUD_REGISTRATION_H
+
+#include <easy3d/core/types.h>
+
+namespace easy3d {
+
+    class PointCloud;
+    class KdTreeSearch;
+
+    /// \brief Rigid registration of two point clouds using the point-to-plane ICP algorithm.
+    /// \class PointCloudRegistration easy3d/algo/point_cloud_registration.h
+    /// \details The source cloud is aligned to the (fixed) target cloud. The registration runs
+    /// in a multi-resolution fashion: the first iterations work on a coarse subsampling of the
+    /// source (where each iteration is cheap and the basin of convergence is large), and later
+    /// levels refine the alignment on progressively denser subsamplings. Per iteration, the
+    /// correspondences are queried from a kd-tree of the target in one parallel batch, and the
+    /// normal equations of the point-to-plane error are accumulated on all cores, so even scans
+    /// with tens of millions of points align in seconds. The kd-tree and the normals of the
+    /// target are built once (in the constructor) and reused, both across the iterations and
+    /// across repeated align() calls, e.g., when several scans are registered to the same
+    /// reference, or when re-running from a better initial guess (warm start).
+    /// \attention ICP converges to the nearest local minimum, so the initial transformation
+    /// must roughly pre-align the scans (for repeat scans of the same scene, the identity is
+    /// usually sufficient).
+    class PointCloudRegistration {
+    public:
+        /// \brief Construct with the source cloud (the one to be moved) and the target cloud
+        /// (the fixed reference). If the target has no "v:normal" property, the normals are
+        /// estimated (they define the planes of the point-to-plane error).
+        PointCloudRegistration(PointCloud *source, PointCloud *target);
+
+        ~PointCloudRegistration();
+
+        /// \brief Replace the source cloud, keeping the target and its kd-tree/normals. Useful
+        /// when a sequence of scans is registered to the same reference.
+        void set_source(PointCloud *source) { source_ = source; }
+
+        /// \name Parameters (to be set before align())
+        /// @{
+        /// \brief The total iteration budget. The coarsest level may use all of it; each finer
+        ///        level gets half the budget of the previous one. Default: 50.
+        void set_max_iterations(int n) { max_iterations_ = n; }
+        /// \brief Stop iterating at a level when the relative change of the RMSE drops below
+        ///        this threshold. Default: 1e-4.
+        void set_convergence_delta(float d) { convergence_delta_ = d; }
+        /// \brief Reject correspondences farther apart than this distance. A value <= 0 (the
+        ///        default) derives the threshold from the bounding box of the target (5% of its
+        ///        diagonal); the threshold is halved on each finer level.
+        void set_max_distance(float d) { max_distance_ = d; }
+        /// \brief The number of resolution levels. Default: 3.
+        void set_num_levels(int n) { num_levels_ = n; }
+        /// \brief The number of source points sampled at the coarsest level; each finer level
+        ///        uses 4 times more (capped by the size of the cloud). Default: 50000.
+        void set_coarse_sample_size(int n) { coarse_sample_size_ = n; }
+        /// @}
+
+        /// \brief Run the registration.
+        /// \param initial The initial guess for the transformation of the source, e.g., the
+        ///        result of a previous registration of a similar scan (warm start).
+        /// \return true if the finest level converged (the RMSE stopped improving within the
+        ///        iteration budget). The computed transformation is available either way.
+        bool align(const mat4 &initial = mat4::identity());
+
+        /// \brief The resulting transformation that aligns the source to the target. Only valid
+        ///        after align(). The source cloud itself is not modified; call apply() to bake
+        ///        the transformation into its points.
+        const mat4 &transformation() const { return transformation_; }
+
+        /// \brief The root mean squared point-to-plane error of the last iteration.
+        float rmse() const { return rmse_; }
+
+        /// \brief The total number of iterations performed (summed over all levels).
+        int iterations() const { return iterations_; }
+
+        /// \brief Transform the points (and, if present, the normals) of the source cloud by
+        ///        transformation().
+        void apply() const;
+
+    private:
+        PointCloud *source_;
+        PointCloud *target_;
+        KdTreeSearch *kdtree_;      // built on the target, shared by all align() calls
+
+        // parameters
+        int max_iterations_;
+        float convergence_delta_;
+        float max_distance_;
+        int num_levels_;
+        int coarse_sample_size_;
+
+        // results
+        mat4 transformation_;
+        float rmse_;
+        int iterations_;
+    };
+
+} // namespace easy3d
+
+#endif  // EASY3D_ALGO_POINT_CLOUD_REGISTRATION_H
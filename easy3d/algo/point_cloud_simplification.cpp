@@ -25,10 +25,14 @@
 #include <easy3d/algo/point_cloud_simplification.h>
 
 #include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
 
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/kdtree/kdtree_search_eth.h>
+#include <easy3d/kdtree/point_cloud_neighborhood.h>
 
 
 namespace easy3d {
@@ -81,75 +85,104 @@ namespace easy3d {
     //  \cond
     namespace details {
 
-        /// Utility class for grid simplification of point set.
-        /// LessEpsilonPoints defines a 3D points order: two points are equal
-        /// iff they belong to the same cell of a grid of cell size = epsilon.
-        template<class Point>
-        class LessEpsilonPoints {
-        public:
-            LessEpsilonPoints(float epsilon) : m_epsilon(epsilon) {
-                assert(epsilon > 0);
-            }
-
-            // Round points to multiples of m_epsilon, then compare.
-            bool operator()(const Point &a, const Point &b) const {
-                const vec3 *a_n = (a.pos);
-                const vec3 *b_n = (b.pos);
-
-                vec3 rounded_a(round_epsilon(a_n->x, m_epsilon), round_epsilon(a_n->y, m_epsilon),
-                               round_epsilon(a_n->z, m_epsilon));
-                vec3 rounded_b(round_epsilon(b_n->x, m_epsilon), round_epsilon(b_n->y, m_epsilon),
-                               round_epsilon(b_n->z, m_epsilon));
-
-                //return (rounded_a < rounded_b);
-                if (rounded_a.x < rounded_b.x)
-                    return true;
-                else if (rounded_a.x == rounded_b.x) {
-                    if (rounded_a.y < rounded_b.y)
-                        return true;
-                    else if (rounded_a.y == rounded_b.y) {
-                        if (rounded_a.z < rounded_b.z)
-                            return true;
-                    }
-                }
-
-                return false;
-            }
-
-        private:
-            // Round number to multiples of epsilon
-            static inline float round_epsilon(float value, float epsilon) {
-                return std::floor(value / epsilon) * epsilon;
-            }
+        // spreads the lower 21 bits of v so that they occupy every third bit
+        inline std::uint64_t expand_bits(std::uint64_t v) {
+            v &= 0x1fffff;
+            v = (v | v << 32) & 0x1f00000000ffffULL;
+            v = (v | v << 16) & 0x1f0000ff0000ffULL;
+            v = (v | v << 8) & 0x100f00f00f00f00fULL;
+            v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+            v = (v | v << 2) & 0x1249249249249249ULL;
+            return v;
+        }
 
-        private:
-            float m_epsilon;
-        };
+        // the Morton code of a grid cell (21 bits per axis)
+        inline std::uint64_t morton_code(std::uint64_t x, std::uint64_t y, std::uint64_t z) {
+            return expand_bits(x) | (expand_bits(y) << 1) | (expand_bits(z) << 2);
+        }
     }
     //  \endcond
 
 
-    std::vector<PointCloud::Vertex> PointCloudSimplification::grid_simplification(PointCloud *cloud, float epsilon) {
+    std::vector<PointCloud::Vertex> PointCloudSimplification::grid_simplification(PointCloud *cloud, float epsilon,
+                                                                                  CellRepresentative representative) {
         assert(epsilon > 0);
 
-        struct Point {
-            const vec3 *pos;
-            PointCloud::Vertex vertex;
+        std::vector<PointCloud::Vertex> points_to_remove;
+        const auto &points = cloud->points();
+        const int num = static_cast<int>(points.size());
+        if (num == 0)
+            return points_to_remove;
+
+        const vec3 origin = cloud->bounding_box().min();
+
+        // bin the points: the Morton code of the cell holding each point, paired with the point index.
+        // After sorting, the points of a cell form a contiguous run (ordered by index within the cell),
+        // and consecutive runs belong to spatially nearby cells, so the selection pass is cache-friendly.
+        auto cell_coord = [epsilon](float value, float base) -> std::uint64_t {
+            const double c = std::floor(double(value - base) / epsilon);
+            return static_cast<std::uint64_t>(std::min(std::max(c, 0.0), 2097151.0));   // 21 bits per axis
         };
+        std::vector<std::pair<std::uint64_t, int> > bins(num);
+#pragma omp parallel for
+        for (int i = 0; i < num; ++i) {
+            const vec3 &p = points[i];
+            bins[i] = std::make_pair(
+                    details::morton_code(cell_coord(p.x, origin.x), cell_coord(p.y, origin.y),
+                                         cell_coord(p.z, origin.z)),
+                    i);
+        }
+        std::sort(bins.begin(), bins.end());
 
-        // Merges points which belong to the same cell of a grid of cell size = epsilon.
-        // points_to_keep will contain 1 point per cell; the others will be in points_to_remove.
-        std::set<Point, details::LessEpsilonPoints<Point> > points_to_keep(epsilon);
-        std::vector<PointCloud::Vertex> points_to_remove;
+        // the start of each run of equal cell codes
+        std::vector<int> starts;
+        for (int i = 0; i < num; ++i) {
+            if (i == 0 || bins[i].first != bins[i - 1].first)
+                starts.push_back(i);
+        }
+        starts.push_back(num);
+
+        // select the representative of each cell; the cells are independent
+        auto vpoints = cloud->vertex_property<vec3>("v:point");
+        std::vector<char> remove(num, 0);
+        const int num_cells = static_cast<int>(starts.size()) - 1;
+#pragma omp parallel for
+        for (int c = 0; c < num_cells; ++c) {
+            const int begin = starts[c], end = starts[c + 1];
+            if (end - begin == 1)
+                continue;   // a single point is always its own representative
+
+            int keep = bins[begin].second;  // the smallest index in the cell
+            if (representative != FIRST_POINT) {
+                dvec3 sum(0, 0, 0);
+                for (int j = begin; j < end; ++j)
+                    sum += static_cast<dvec3>(points[bins[j].second]);
+                const vec3 centroid(sum / double(end - begin));
+
+                if (representative == CENTROID)
+                    vpoints[PointCloud::Vertex(keep)] = centroid;
+                else {  // CLOSEST_TO_CENTROID
+                    float min_sqr_dist = std::numeric_limits<float>::max();
+                    for (int j = begin; j < end; ++j) {
+                        const float sqr_dist = distance2(points[bins[j].second], centroid);
+                        if (sqr_dist < min_sqr_dist) {
+                            min_sqr_dist = sqr_dist;
+                            keep = bins[j].second;
+                        }
+                    }
+                }
+            }
 
-        const auto &points = cloud->points();
-        for (auto v : cloud->vertices()) {
-            Point p;
-            p.pos = &(points[v.idx()]);
-            p.vertex = v;
-            const auto &result = points_to_keep.insert(p);
-            if (!result.second) // if not inserted
-                points_to_remove.push_back(v);
+            for (int j = begin; j < end; ++j) {
+                if (bins[j].second != keep)
+                    remove[bins[j].second] = 1;
+            }
+        }
+
+        points_to_remove.reserve(num - num_cells);
+        for (int i = 0; i < num; ++i) {
+            if (remove[i])
+                points_to_remove.push_back(PointCloud::Vertex(i));
         }
 
         return points_to_remove;
@@ -157,10 +190,15 @@ namespace easy3d {
 
 
     std::vector<PointCloud::Vertex>
-    PointCloudSimplification::uniform_simplification(PointCloud *cloud, float epsilon, KdTreeSearch *tree) {
+    PointCloudSimplification::uniform_simplification(PointCloud *cloud, float epsilon, KdTreeSearch *tree,
+                                                     const PointCloudNeighborhood *neighborhood) {
+        const bool use_cache = neighborhood && neighborhood->num_points() == cloud->n_vertices();
+        LOG_IF(WARNING, neighborhood && !use_cache)
+                        << "the neighborhood cache does not match the point cloud and is thus ignored";
+
         KdTreeSearch *kdtree = tree;
         bool need_delete(false);
-        if (!kdtree) {
+        if (!kdtree && !use_cache) {
             kdtree = new KdTreeSearch_ETH;
             kdtree->begin();
             kdtree->add_point_cloud(cloud);
@@ -174,13 +212,25 @@ namespace easy3d {
         double sqr_dist = epsilon * epsilon;
         for (std::size_t i = 0; i < points.size(); ++i) {
             if (keep[i]) {
-                const vec3 &p = points[i];
-                std::vector<int> neighbors;
-                kdtree->find_points_in_range(p, sqr_dist, neighbors);
-                if (neighbors.size() > 1) {
-                    for (std::size_t j = 1; j < neighbors.size(); ++j) {
-                        int idx = neighbors[j];
-                        keep[idx] = 0;
+                if (use_cache) {
+                    // the point itself is part of its cached neighborhood, but not necessarily
+                    // the first entry, so it is skipped by index
+                    const int *ids = neighborhood->neighbors(i);
+                    const std::size_t found = neighborhood->size(i);
+                    for (std::size_t j = 0; j < found; ++j) {
+                        if (ids[j] != static_cast<int>(i))
+                            keep[ids[j]] = 0;
+                    }
+                }
+                else {
+                    const vec3 &p = points[i];
+                    std::vector<int> neighbors;
+                    kdtree->find_points_in_range(p, sqr_dist, neighbors);
+                    if (neighbors.size() > 1) {
+                        for (std::size_t j = 1; j < neighbors.size(); ++j) {
+                            int idx = neighbors[j];
+                            keep[idx] = 0;
+                        }
                     }
                 }
             }
@@ -34,6 +34,7 @@
 namespace easy3d {
 
     class KdTreeSearch;
+    class PointCloudNeighborhood;
 
     /// \brief PointCloudSimplification provides various point cloud simplification algorithms.
     /// \class PointCloudSimplification easy3d/algo/point_cloud_simplification.h
@@ -57,15 +58,26 @@ namespace easy3d {
 
         //----- simplification using a grid (non-uniform) ------------------------------------------------
 
+        /// \brief How the representative point of a grid cell is chosen in grid_simplification().
+        enum CellRepresentative {
+            FIRST_POINT,            ///< the point with the smallest index in the cell (fastest)
+            CENTROID,               ///< like FIRST_POINT, but the kept point is moved to the centroid of the cell
+            CLOSEST_TO_CENTROID     ///< the existing point closest to the centroid (positions are not modified)
+        };
+
         /**
-         * \brief Simplification of a point cloud using a regular grid covering the bounding box of the points. Simplification
-         * is done by keeping a representative point (chosen arbitrarily) for each cell of the grid. This is non-uniform
-         * simplification since the representative point is chosen arbitrarily.
+         * \brief Simplification of a point cloud using a regular grid covering the bounding box of the points.
+         * Simplification is done by keeping a representative point for each cell of the grid. The points are binned
+         * into the cells by sorting the Morton codes of their cell coordinates (binning and the per-cell selection
+         * run in parallel on all cores), so the cost is a single sort regardless of the cell size.
          * @param cloud The point cloud.
          * @param cell_size The size of the cells of the grid.
+         * @param representative How the representative point of a cell is chosen. \note With CENTROID, the
+         *        coordinates of the kept points are modified.
          * @return The indices of points to be deleted.
          */
-        static std::vector<PointCloud::Vertex> grid_simplification(PointCloud *cloud, float cell_size);
+        static std::vector<PointCloud::Vertex> grid_simplification(PointCloud *cloud, float cell_size,
+                                                                   CellRepresentative representative = FIRST_POINT);
 
         //----- uniform simplification (specifying distance threshold) ------------------------------------
 
@@ -77,10 +89,15 @@ namespace easy3d {
          *                 value are considered identical. After simplification, the distance of any point pair is
          *                 larger than this value.
          * @param kdtree   A kdtree defined on this point cloud. If null, a new kdtree will be built and used.
+         * @param neighborhood Precomputed neighborhoods of the points (see PointCloudNeighborhood), so the
+         *                 kd-tree construction and queries are skipped (the \p kdtree argument is then unused).
+         *                 Useful when several neighborhood-based stages run on the same cloud. \note The cache
+         *                 is expected to be built with build_radius() and the same \p epsilon.
          * @return The indices of points to be deleted.
          */
         static std::vector<PointCloud::Vertex>
-        uniform_simplification(PointCloud *cloud, float epsilon, KdTreeSearch *kdtree = nullptr);
+        uniform_simplification(PointCloud *cloud, float epsilon, KdTreeSearch *kdtree = nullptr,
+                               const PointCloudNeighborhood *neighborhood = nullptr);
 
         //----- uniform simplification (specifying expected point number) ---------------------------------
 
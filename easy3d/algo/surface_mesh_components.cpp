@@ -27,9 +27,58 @@
 #include <easy3d/algo/surface_mesh_enumerator.h>
 #include <easy3d/algo/tessellator.h>
 
+#include <atomic>
+#include <memory>
+
 
 namespace easy3d {
 
+    // \cond
+    namespace details {
+
+        // A lock-free union-find over element indices. The unions are applied with compare-and-swap,
+        // so the edges (or faces) can be processed concurrently; the root of a set is always its
+        // smallest index, which makes the final labeling deterministic.
+        class UnionFind {
+        public:
+            UnionFind(int n) : parent_(new std::atomic<int>[n]) {
+                for (int i = 0; i < n; ++i)
+                    parent_[i].store(i, std::memory_order_relaxed);
+            }
+
+            int find(int i) {
+                while (true) {
+                    int p = parent_[i].load(std::memory_order_relaxed);
+                    if (p == i)
+                        return i;
+                    // path halving: point i to its grandparent (best effort; a lost race is harmless)
+                    const int gp = parent_[p].load(std::memory_order_relaxed);
+                    parent_[i].compare_exchange_weak(p, gp);
+                    i = gp;
+                }
+            }
+
+            void unite(int a, int b) {
+                while (true) {
+                    a = find(a);
+                    b = find(b);
+                    if (a == b)
+                        return;
+                    if (a > b)
+                        std::swap(a, b);    // hang the larger root under the smaller one
+                    int expected = b;
+                    if (parent_[b].compare_exchange_strong(expected, a))
+                        return;
+                    // another thread re-parented b in the meantime; retry from the new roots
+                }
+            }
+
+        private:
+            std::unique_ptr<std::atomic<int>[]> parent_;
+        };
+    }
+    // \endcond
+
     SurfaceMesh *SurfaceMeshComponent::to_mesh() const {
         const SurfaceMeshComponent *comp = this;
         SurfaceMesh *mesh = comp->mesh();
@@ -129,42 +178,97 @@ namespace easy3d {
 
 
     std::vector<SurfaceMeshComponent> SurfaceMeshComponent::extract(SurfaceMesh *mesh) {
-        auto component_id = mesh->add_vertex_property<int>("SurfaceMeshComponentExtractor::extract::component_id");
-        int nb_components = SurfaceMeshEnumerator::enumerate_connected_components(mesh, component_id);
-        std::vector<SurfaceMeshComponent> result;
-        for (int i = 0; i < nb_components; i++) {
-            result.emplace_back(SurfaceMeshComponent(mesh));
+        // label the vertices with a parallel union-find over the edges. This is equivalent to the
+        // serial flood fill, but the edges can be processed concurrently.
+        details::UnionFind uf(static_cast<int>(mesh->vertices_size()));
+        const int num_edges = static_cast<int>(mesh->edges_size());
+#pragma omp parallel for
+        for (int i = 0; i < num_edges; ++i) {
+            const SurfaceMesh::Edge e(i);
+            if (!mesh->is_deleted(e))
+                uf.unite(mesh->vertex(e, 0).idx(), mesh->vertex(e, 1).idx());
         }
 
+        // compact the labels in order of first occurrence, which is the order the serial flood
+        // fill assigns them
+        std::vector<int> component_id(mesh->vertices_size(), -1);
+        std::vector<int> root_id(mesh->vertices_size(), -1);
+        int nb_components = 0;
         for (auto v : mesh->vertices()) {
-            int idx = component_id[v];
-            result[idx].vertices_.push_back(v);
+            const int root = uf.find(v.idx());
+            if (root_id[root] == -1)
+                root_id[root] = nb_components++;
+            component_id[v.idx()] = root_id[root];
         }
 
-        for (auto f : mesh->faces()) {
-            auto v = mesh->vertices(f).begin();
-            int idx = component_id[*v];
-            result[idx].faces_.push_back(f);
+        std::vector<SurfaceMeshComponent> result(nb_components, SurfaceMeshComponent(mesh));
+
+        // one counting pass per element type, so each per-component list is allocated exactly once
+        // (with 100k+ components the repeated push_back reallocations used to dominate)
+        std::vector<std::size_t> nv(nb_components, 0), nf(nb_components, 0),
+                ne(nb_components, 0), nh(nb_components, 0);
+        for (auto v : mesh->vertices())
+            ++nv[component_id[v.idx()]];
+        for (auto f : mesh->faces())
+            ++nf[component_id[(*mesh->vertices(f).begin()).idx()]];
+        for (auto e : mesh->edges())
+            ++ne[component_id[mesh->vertex(e, 0).idx()]];
+        for (auto h : mesh->halfedges())
+            ++nh[component_id[mesh->target(h).idx()]];
+        for (int i = 0; i < nb_components; ++i) {
+            result[i].vertices_.reserve(nv[i]);
+            result[i].faces_.reserve(nf[i]);
+            result[i].edges_.reserve(ne[i]);
+            result[i].halfedges_.reserve(nh[i]);
         }
 
-        for (auto e : mesh->edges()) {
-            auto v = mesh->vertex(e, 0);
-            int idx = component_id[v];
-            result[idx].edges_.push_back(e);
-        }
+        for (auto v : mesh->vertices())
+            result[component_id[v.idx()]].vertices_.push_back(v);
 
-        for (auto h : mesh->halfedges()) {
-            auto v = mesh->target(h);
-            int idx = component_id[v];
-            result[idx].halfedges_.push_back(h);
-        }
+        for (auto f : mesh->faces())
+            result[component_id[(*mesh->vertices(f).begin()).idx()]].faces_.push_back(f);
 
-        mesh->remove_vertex_property(component_id);
+        for (auto e : mesh->edges())
+            result[component_id[mesh->vertex(e, 0).idx()]].edges_.push_back(e);
+
+        for (auto h : mesh->halfedges())
+            result[component_id[mesh->target(h).idx()]].halfedges_.push_back(h);
 
         return result;
     }
 
 
+    int SurfaceMeshComponent::label(SurfaceMesh *mesh) {
+        auto component = mesh->face_property<int>("f:component", -1);
+
+        // a parallel union-find over the edges: each interior edge connects the two faces incident to it
+        details::UnionFind uf(static_cast<int>(mesh->faces_size()));
+        const int num_edges = static_cast<int>(mesh->edges_size());
+#pragma omp parallel for
+        for (int i = 0; i < num_edges; ++i) {
+            const SurfaceMesh::Edge e(i);
+            if (mesh->is_deleted(e))
+                continue;
+            const auto h0 = mesh->halfedge(e, 0);
+            const auto h1 = mesh->halfedge(e, 1);
+            if (!mesh->is_border(h0) && !mesh->is_border(h1))
+                uf.unite(mesh->face(h0).idx(), mesh->face(h1).idx());
+        }
+
+        // compact the labels in order of first occurrence
+        std::vector<int> root_id(mesh->faces_size(), -1);
+        int nb_components = 0;
+        for (auto f : mesh->faces()) {
+            const int root = uf.find(f.idx());
+            if (root_id[root] == -1)
+                root_id[root] = nb_components++;
+            component[f] = root_id[root];
+        }
+
+        return nb_components;
+    }
+
+
     SurfaceMeshComponent SurfaceMeshComponent::extract(SurfaceMesh *mesh, SurfaceMesh::Face face) {
         auto component_id = mesh->add_vertex_property<int>("SurfaceMeshComponentExtractor::extract::component_id");
         SurfaceMeshEnumerator::enumerate_connected_components(mesh, component_id);
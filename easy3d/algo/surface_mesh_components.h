@@ -51,6 +51,16 @@ namespace easy3d {
         /** Extracts connected components */
         static std::vector<SurfaceMeshComponent> extract(SurfaceMesh *mesh);
 
+        /**
+         * Labels the connected components of the mesh without materializing the components.
+         * Each face is assigned the index (0, 1, 2...) of the component it belongs to, stored in the face
+         * property "f:component". Two faces belong to the same component if they are connected through a
+         * sequence of shared edges. The labeling runs as a parallel union-find pass over the edges, and it
+         * is much cheaper than extract() when only the labels are needed (no per-component element lists
+         * are built). Returns the number of components.
+         */
+        static int label(SurfaceMesh *mesh);
+
         /** Extracts a single connected component from the seed face */
         static SurfaceMeshComponent extract(SurfaceMesh *mesh, SurfaceMesh::Face seed);
 
@@ -52,6 +52,13 @@ namespace easy3d {
         for (auto e : mesh_->edges())
             cotan[e] = geom::cotan_weight(mesh_, e);
 
+        // raw base pointers for the traversal below; no elements or properties are
+        // added/removed until the clean-up, so the pointers stay valid (see Property::data())
+        const vec3* points = mesh_->get_vertex_property<vec3>("v:point").data();
+        const double* cotan_data = cotan.data();
+        float* kmin_data = min_curvature_.data();
+        float* kmax_data = max_curvature_.data();
+
         // Voronoi area per vertex
         // Laplace per vertex
         // angle sum per vertex
@@ -63,18 +70,17 @@ namespace easy3d {
                 laplace = vec3(0.0);
                 sum_weights = 0.0;
                 sum_angles = 0.0;
-                p0 = mesh_->position(v);
+                p0 = points[v.idx()];
 
                 // Voronoi area
                 area = geom::voronoi_area(mesh_, v);
 
                 // Laplace & angle sum
                 for (auto vh : mesh_->halfedges(v)) {
-                    p1 = mesh_->position(mesh_->target(vh));
-                    p2 = mesh_->position(
-                            mesh_->target(mesh_->prev_around_source(vh)));
+                    p1 = points[mesh_->target(vh).idx()];
+                    p2 = points[mesh_->target(mesh_->prev_around_source(vh)).idx()];
 
-                    weight = cotan[mesh_->edge(vh)];
+                    weight = cotan_data[mesh_->edge(vh).idx()];
                     sum_weights += weight;
                     laplace += weight * p1;
 
@@ -84,7 +90,7 @@ namespace easy3d {
                     p2.normalize();
                     sum_angles += acos(geom::clamp_cos(dot(p1, p2)));
                 }
-                laplace -= sum_weights * mesh_->position(v);
+                laplace -= sum_weights * points[v.idx()];
                 laplace /= float(2.0) * area;
 
                 mean = float(0.5) * norm(laplace);
@@ -95,8 +101,8 @@ namespace easy3d {
                 kmax = mean + s;
             }
 
-            min_curvature_[v] = kmin;
-            max_curvature_[v] = kmax;
+            kmin_data[v.idx()] = kmin;
+            kmax_data[v.idx()] = kmax;
         }
 
         // boundary vertices: interpolate from interior neighbors
@@ -105,12 +111,14 @@ namespace easy3d {
                 kmin = kmax = sum_weights = 0.0;
 
                 for (auto vh : mesh_->halfedges(v)) {
-                    v = mesh_->target(vh);
-                    if (!mesh_->is_border(v)) {
-                        weight = cotan[mesh_->edge(vh)];
+                    // note: do not reuse v as the loop variable here - the interpolated
+                    // values below must be written to the border vertex itself
+                    auto vv = mesh_->target(vh);
+                    if (!mesh_->is_border(vv)) {
+                        weight = cotan_data[mesh_->edge(vh).idx()];
                         sum_weights += weight;
-                        kmin += weight * min_curvature_[v];
-                        kmax += weight * max_curvature_[v];
+                        kmin += weight * kmin_data[vv.idx()];
+                        kmax += weight * kmax_data[vv.idx()];
                     }
                 }
 
@@ -133,6 +141,131 @@ namespace easy3d {
 
     //-----------------------------------------------------------------------------
 
+    void SurfaceMeshCurvature::analyze(const std::vector<SurfaceMesh::Vertex> &dirty_vertices) {
+        float kmin, kmax, mean, gauss;
+        float area, sum_angles;
+        float weight, sum_weights;
+        vec3 p0, p1, p2, laplace;
+
+        // the affected region: the dirty vertices and their one-ring neighbors (the
+        // curvature of a vertex only depends on its one-ring)
+        std::vector<SurfaceMesh::Vertex> region;
+        region.reserve(dirty_vertices.size() * 7);
+        std::vector<bool> in_region(mesh_->n_vertices(), false);
+        for (auto v : dirty_vertices) {
+            if (!in_region[v.idx()]) {
+                in_region[v.idx()] = true;
+                region.push_back(v);
+            }
+            for (auto vv : mesh_->vertices(v)) {
+                if (!in_region[vv.idx()]) {
+                    in_region[vv.idx()] = true;
+                    region.push_back(vv);
+                }
+            }
+        }
+
+        auto points = mesh_->get_vertex_property<vec3>("v:point");
+
+        // interior vertices of the region. The cotan weights are evaluated on the fly:
+        // the region is small, so precomputing them per edge (as analyze() does) would
+        // cost more than it saves.
+        for (auto v : region) {
+            kmin = kmax = 0.0;
+
+            if (!mesh_->is_isolated(v) && !mesh_->is_border(v)) {
+                laplace = vec3(0.0);
+                sum_weights = 0.0;
+                sum_angles = 0.0;
+                p0 = points[v];
+
+                // Voronoi area
+                area = geom::voronoi_area(mesh_, v);
+
+                // Laplace & angle sum
+                for (auto vh : mesh_->halfedges(v)) {
+                    p1 = points[mesh_->target(vh)];
+                    p2 = points[mesh_->target(mesh_->prev_around_source(vh))];
+
+                    weight = geom::cotan_weight(mesh_, mesh_->edge(vh));
+                    sum_weights += weight;
+                    laplace += weight * p1;
+
+                    p1 -= p0;
+                    p1.normalize();
+                    p2 -= p0;
+                    p2.normalize();
+                    sum_angles += acos(geom::clamp_cos(dot(p1, p2)));
+                }
+                laplace -= sum_weights * points[v];
+                laplace /= float(2.0) * area;
+
+                mean = float(0.5) * norm(laplace);
+                gauss = (2.0 * M_PI - sum_angles) / area;
+
+                const float s = sqrt(std::max(float(0.0), mean * mean - gauss));
+                kmin = mean - s;
+                kmax = mean + s;
+            }
+
+            min_curvature_[v] = kmin;
+            max_curvature_[v] = kmax;
+        }
+
+        // boundary vertices of the region, and those right next to it (their values are
+        // interpolated from interior neighbors, whose curvatures may just have changed):
+        // interpolate from interior neighbors
+        std::vector<SurfaceMesh::Vertex> border_region;
+        for (auto v : region) {
+            if (mesh_->is_border(v))
+                border_region.push_back(v);
+            for (auto vv : mesh_->vertices(v)) {
+                if (mesh_->is_border(vv) && !in_region[vv.idx()]) {
+                    in_region[vv.idx()] = true;
+                    border_region.push_back(vv);
+                }
+            }
+        }
+        for (auto v : border_region) {
+            kmin = kmax = sum_weights = 0.0;
+
+            for (auto vh : mesh_->halfedges(v)) {
+                auto vv = mesh_->target(vh);
+                if (!mesh_->is_border(vv)) {
+                    weight = geom::cotan_weight(mesh_, mesh_->edge(vh));
+                    sum_weights += weight;
+                    kmin += weight * min_curvature_[vv];
+                    kmax += weight * max_curvature_[vv];
+                }
+            }
+
+            if (sum_weights) {
+                kmin /= sum_weights;
+                kmax /= sum_weights;
+            }
+
+            min_curvature_[v] = kmin;
+            max_curvature_[v] = kmax;
+        }
+
+        // update the derived curvature properties in place (only if they exist, i.e.,
+        // the corresponding compute_xxx_curvature() function has been called before)
+        auto mean_curv = mesh_->get_vertex_property<float>("v:curv-mean");
+        auto gauss_curv = mesh_->get_vertex_property<float>("v:curv-gauss");
+        auto max_abs_curv = mesh_->get_vertex_property<float>("v:curv-max_abs");
+        region.insert(region.end(), border_region.begin(), border_region.end());
+        for (auto v : region) {
+            if (mean_curv)
+                mean_curv[v] = mean_curvature(v);
+            if (gauss_curv)
+                gauss_curv[v] = gauss_curvature(v);
+            if (max_abs_curv)
+                max_abs_curv[v] = max_abs_curvature(v);
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+
     void SurfaceMeshCurvature::analyze_tensor(unsigned int post_smoothing_steps,
                                               bool two_ring_neighborhood) {
         auto area = mesh_->add_vertex_property<double>("curv:area", 0.0);
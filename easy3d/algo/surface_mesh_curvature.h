@@ -59,6 +59,17 @@ namespace easy3d {
          */
         void analyze_tensor(unsigned int post_smoothing_steps = 0, bool two_ring_neighborhood = false);
 
+        /**
+         * Recomputes the curvatures for the given \p dirty_vertices only (e.g., the vertices modified by an editing
+         * operation). The curvature of a vertex depends on its one-ring, so moving a vertex also invalidates the
+         * curvatures of its neighbors; the affected region (the dirty vertices and their one-ring neighborhoods) is
+         * collected internally. The "v:curv-min" and "v:curv-max" properties are updated in place, and so are the
+         * derived "v:curv-mean", "v:curv-gauss", and "v:curv-max_abs" properties if they exist.
+         * @attention No smoothing is performed (it would bleed outside the affected region). A full analyze() must
+         *      have been called once before.
+         */
+        void analyze(const std::vector<SurfaceMesh::Vertex> &dirty_vertices);
+
         /**
          * Computes the mean curvature.
          * @attention This function must be called after calling to the "analyze" function.
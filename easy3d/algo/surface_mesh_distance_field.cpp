@@ -0,0 +1,223 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <easy3d/algo/surface_mesh_distance_field.h>
+#include <easy3d/algo/triangle_mesh_kdtree.h>
+#include <easy3d/util/logging.h>
+
+#include <cfloat>
+
+
+namespace easy3d {
+
+    namespace details {
+
+        // the smallest distance between the axis-aligned box [bc - bh, bc + bh] and the
+        // bounding box of a triangle
+        inline float dist_box_triangle(const vec3 &bc, float bh,
+                                       const vec3 &x0, const vec3 &x1, const vec3 &x2) {
+            float d2 = 0.0f;
+            for (int i = 0; i < 3; ++i) {
+                const float lo = std::min(x0[i], std::min(x1[i], x2[i]));
+                const float hi = std::max(x0[i], std::max(x1[i], x2[i]));
+                float d = 0.0f;
+                if (lo > bc[i] + bh)
+                    d = lo - (bc[i] + bh);
+                else if (hi < bc[i] - bh)
+                    d = (bc[i] - bh) - hi;
+                d2 += d * d;
+            }
+            return std::sqrt(d2);
+        }
+
+    }
+
+
+    SurfaceMeshDistanceField::SurfaceMeshDistanceField(const SurfaceMesh *mesh,
+                                                       unsigned int max_faces_per_cell,
+                                                       unsigned int max_depth)
+            : mesh_(mesh), root_(nullptr), kdtree_(nullptr), max_faces_per_cell_(max_faces_per_cell),
+              max_depth_(max_depth) {
+        if (!mesh->is_triangle_mesh()) {
+            LOG(ERROR) << "only triangle meshes can be converted to a distance field";
+            return;
+        }
+
+        // collect the triangles and the face normals (the normals give the distance its sign)
+        SurfaceMesh::VertexProperty<vec3> points = mesh->get_vertex_property<vec3>("v:point");
+        triangles_.reserve(mesh->n_faces());
+        face_normals_.resize(mesh->faces_size());
+        for (auto f : mesh->faces()) {
+            SurfaceMesh::VertexAroundFaceCirculator vfit = mesh->vertices(f);
+            const vec3 &x0 = points[*vfit];
+            ++vfit;
+            const vec3 &x1 = points[*vfit];
+            ++vfit;
+            const vec3 &x2 = points[*vfit];
+            triangles_.push_back(Triangle(x0, x1, x2, f));
+            face_normals_[f.idx()] = mesh->compute_face_normal(f);
+        }
+
+        // the root cell: a cube enclosing the mesh, with a small margin
+        const Box3 &box = mesh->bounding_box();
+        const float range = std::max(box.range(0), std::max(box.range(1), box.range(2)));
+        const float half = range * 0.5f * 1.01f;
+        root_ = new Node(box.center(), half);
+
+        std::vector<unsigned int> all(triangles_.size());
+        for (std::size_t i = 0; i < all.size(); ++i)
+            all[i] = static_cast<unsigned int>(i);
+
+        // Split the top two levels serially (two linear binning passes), which yields up to
+        // 64 independent subtrees; those are then built in parallel.
+        std::vector<Node *> subtrees;
+        std::vector< std::vector<unsigned int> > candidates;
+        unsigned int subtree_depth = 0;
+        subtrees.push_back(root_);
+        candidates.push_back(all);
+        for (int level = 0; level < 2 && subtree_depth < max_depth_; ++level) {
+            std::vector<Node *> next_subtrees;
+            std::vector< std::vector<unsigned int> > next_candidates;
+            for (std::size_t i = 0; i < subtrees.size(); ++i) {
+                if (candidates[i].size() <= max_faces_per_cell_) {  // already a leaf
+                    subtrees[i]->faces.swap(candidates[i]);
+                    continue;
+                }
+                std::vector<unsigned int> child_candidates[8];
+                split(subtrees[i], candidates[i], child_candidates);
+                for (int c = 0; c < 8; ++c) {
+                    next_subtrees.push_back(subtrees[i]->children[c]);
+                    next_candidates.push_back(std::vector<unsigned int>());
+                    next_candidates.back().swap(child_candidates[c]);
+                }
+            }
+            subtrees.swap(next_subtrees);
+            candidates.swap(next_candidates);
+            ++subtree_depth;
+        }
+
+        const int num = static_cast<int>(subtrees.size());
+#pragma omp parallel for
+        for (int i = 0; i < num; ++i)
+            build_recurse(subtrees[i], candidates[i], subtree_depth);
+
+        kdtree_ = new TriangleMeshKdTree(mesh);
+    }
+
+
+    SurfaceMeshDistanceField::~SurfaceMeshDistanceField() {
+        delete root_;
+        delete kdtree_;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void SurfaceMeshDistanceField::split(Node *node, const std::vector<unsigned int> &candidates,
+                                         std::vector<unsigned int> (&child_candidates)[8]) const {
+        const float h = node->half_size * 0.5f;
+        for (int c = 0; c < 8; ++c) {
+            const vec3 center(node->center.x + ((c & 1) ? h : -h),
+                              node->center.y + ((c & 2) ? h : -h),
+                              node->center.z + ((c & 4) ? h : -h));
+            node->children[c] = new Node(center, h);
+        }
+
+        // A child receives every candidate within one cell size of it. This guard band is what
+        // makes leaf distances exact: if the distance to the nearest binned triangle does not
+        // exceed the cell size, no unbinned triangle can be closer.
+        const float delta = 2.0f * h;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            const Triangle &t = triangles_[candidates[i]];
+            for (int c = 0; c < 8; ++c) {
+                if (details::dist_box_triangle(node->children[c]->center, h,
+                                               t.x[0], t.x[1], t.x[2]) <= delta)
+                    child_candidates[c].push_back(candidates[i]);
+            }
+        }
+    }
+
+
+    void SurfaceMeshDistanceField::build_recurse(Node *node, std::vector<unsigned int> &candidates,
+                                                 unsigned int depth) {
+        if (candidates.size() <= max_faces_per_cell_ || depth >= max_depth_) {
+            node->faces.swap(candidates);
+            return;
+        }
+
+        std::vector<unsigned int> child_candidates[8];
+        split(node, candidates, child_candidates);
+        candidates.clear();
+        for (int c = 0; c < 8; ++c)
+            build_recurse(node->children[c], child_candidates[c], depth + 1);
+    }
+
+    //-----------------------------------------------------------------------------
+
+    float SurfaceMeshDistanceField::evaluate(const vec3 &p) const {
+        const Node *node = root_;
+        while (node && !node->is_leaf()) {
+            int c = 0;
+            if (p.x > node->center.x) c |= 1;
+            if (p.y > node->center.y) c |= 2;
+            if (p.z > node->center.z) c |= 4;
+            node = node->children[c];
+        }
+
+        if (node && !node->faces.empty()) {
+            float best = FLT_MAX;
+            vec3 best_nearest;
+            int best_face = -1;
+            for (std::size_t i = 0; i < node->faces.size(); ++i) {
+                const Triangle &t = triangles_[node->faces[i]];
+                vec3 nearest;
+                const float d = geom::dist_point_triangle(p, t.x[0], t.x[1], t.x[2], nearest);
+                if (d < best) {
+                    best = d;
+                    best_nearest = nearest;
+                    best_face = t.f.idx();
+                }
+            }
+            // within the guard band of the leaf the nearest binned triangle is the nearest
+            // triangle of the whole mesh
+            if (best <= 2.0f * node->half_size)
+                return dot(p - best_nearest, face_normals_[best_face]) >= 0.0f ? best : -best;
+        }
+
+        // far from the surface (or in an empty region of the octree): exact fallback
+        const TriangleMeshKdTree::NearestNeighbor nn = kdtree_->nearest(p);
+        return dot(p - nn.nearest, face_normals_[nn.face.idx()]) >= 0.0f ? nn.dist : -nn.dist;
+    }
+
+
+    void SurfaceMeshDistanceField::evaluate(const std::vector<vec3> &points,
+                                            std::vector<float> &distances) const {
+        distances.resize(points.size());
+        const int num = static_cast<int>(points.size());
+#pragma omp parallel for
+        for (int i = 0; i < num; ++i)
+            distances[i] = evaluate(points[i]);
+    }
+
+} // namespace easy3d
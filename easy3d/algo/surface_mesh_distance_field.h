@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_ALGO_SURFACE_MESH_DISTANCE_FIELD_H
+#define EASY3D_ALGO_SURFACE_MESH_DISTANCE_FIELD_H
+
+#include <vector>
+
+#include <easy3d/core/surface_mesh.h>
+
+
+namespace easy3d {
+
+    class TriangleMeshKdTree;
+
+    /**
+     * \brief A signed distance field of a triangle mesh, for evaluating many query points fast.
+     * \class SurfaceMeshDistanceField easy3d/algo/surface_mesh_distance_field.h
+     * \details The construction bins the triangles of the mesh into a sparse octree: cells are
+     *      subdivided near the surface and a leaf stores every triangle within one cell size of
+     *      it. A query then descends to the leaf containing the point and computes the exact
+     *      distance to the handful of binned triangles, so near-surface queries (the common case
+     *      in mesh-to-point-cloud deviation measurement) never touch a global search structure.
+     *      Queries that are farther from the surface than the guard band of their leaf fall back
+     *      to TriangleMeshKdTree. The distance is negative behind the nearest triangle (with
+     *      respect to its face normal). The batch evaluate() processes the query points in
+     *      parallel, which is how large comparisons should call it.
+     */
+    class SurfaceMeshDistanceField {
+    public:
+        /**
+         * \brief Constructs the distance field of \p mesh (which must be a triangle mesh).
+         * @param max_faces_per_cell Octree cells holding more candidate triangles are subdivided.
+         * @param max_depth The maximum subdivision depth of the octree.
+         */
+        SurfaceMeshDistanceField(const SurfaceMesh *mesh, unsigned int max_faces_per_cell = 32,
+                                 unsigned int max_depth = 10);
+
+        ~SurfaceMeshDistanceField();
+
+        /// \brief Evaluates the signed distance of a single query point \p p.
+        float evaluate(const vec3 &p) const;
+
+        /// \brief Evaluates the signed distances of a batch of query points, in parallel.
+        /// @param points The query points.
+        /// @param distances The resulting signed distances, one per query point.
+        void evaluate(const std::vector<vec3> &points, std::vector<float> &distances) const;
+
+    private:
+        // a triangle with its corners flattened out of the mesh, as in TriangleMeshKdTree
+        struct Triangle {
+            Triangle() {}
+            Triangle(const vec3 &x0, const vec3 &x1, const vec3 &x2, SurfaceMesh::Face ff) {
+                x[0] = x0;
+                x[1] = x1;
+                x[2] = x2;
+                f = ff;
+            }
+            vec3 x[3];
+            SurfaceMesh::Face f;
+        };
+
+        // an octree cell; a leaf (no children) stores the indices of its binned triangles
+        struct Node {
+            Node(const vec3 &c, float h) : center(c), half_size(h) {
+                for (int i = 0; i < 8; ++i)
+                    children[i] = nullptr;
+            }
+            ~Node() {
+                for (int i = 0; i < 8; ++i)
+                    delete children[i];
+            }
+            bool is_leaf() const { return children[0] == nullptr; }
+
+            vec3 center;
+            float half_size;
+            std::vector<unsigned int> faces;
+            Node *children[8];
+        };
+
+        // creates the children of 'node' and bins the candidate triangles to them
+        void split(Node *node, const std::vector<unsigned int> &candidates,
+                   std::vector<unsigned int> (&child_candidates)[8]) const;
+
+        // recursive part of the construction
+        void build_recurse(Node *node, std::vector<unsigned int> &candidates, unsigned int depth);
+
+    private:
+        const SurfaceMesh *mesh_;
+        std::vector<Triangle> triangles_;
+        std::vector<vec3> face_normals_;    // indexed by face index, for the distance sign
+        Node *root_;
+        TriangleMeshKdTree *kdtree_;        // fallback for queries far from the surface
+        unsigned int max_faces_per_cell_;
+        unsigned int max_depth_;
+    };
+
+} // namespace easy3d
+
+
+#endif  // EASY3D_ALGO_SURFACE_MESH_DISTANCE_FIELD_H
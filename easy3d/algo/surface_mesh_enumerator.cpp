@@ -25,11 +25,56 @@
 
 #include <easy3d/algo/surface_mesh_enumerator.h>
 
+#include <atomic>
 #include <stack>
+#include <vector>
 
 
 namespace easy3d {
 
+    namespace details {
+
+        // \cond
+
+        // A lock-free union-find over the element indices. The enumeration problems below are
+        // connected components of an adjacency relation that is symmetric (two vertices share
+        // an edge; two faces share an edge and - for the planar case - have compatible
+        // normals), so the regions can be built by uniting the two sides of every mesh edge in
+        // parallel instead of growing one region at a time from seeds. unite() always directs
+        // the larger root to the smaller one, so the representative of every region is its
+        // smallest element index - the deterministic tie-break that makes the final labeling
+        // identical to the serial region growing (which starts a new region at the smallest
+        // unvisited element).
+
+        inline int find_root(std::vector< std::atomic<int> >& parent, int x) {
+            int p = parent[x].load(std::memory_order_relaxed);
+            while (p != x) {
+                const int gp = parent[p].load(std::memory_order_relaxed);
+                parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);   // path halving
+                x = parent[x].load(std::memory_order_relaxed);
+                p = parent[x].load(std::memory_order_relaxed);
+            }
+            return x;
+        }
+
+        inline void unite(std::vector< std::atomic<int> >& parent, int a, int b) {
+            for (;;) {
+                a = find_root(parent, a);
+                b = find_root(parent, b);
+                if (a == b)
+                    return;
+                if (a > b)
+                    std::swap(a, b);
+                int expected = b;   // the larger root becomes a child of the smaller one
+                if (parent[b].compare_exchange_strong(expected, a, std::memory_order_relaxed))
+                    return;
+            }
+        }
+
+        // \endcond
+
+    } // namespace details
+
     void SurfaceMeshEnumerator::propagate_connected_component(SurfaceMesh *mesh, SurfaceMesh::VertexProperty<int> id,
                                                               SurfaceMesh::Vertex seed, int cur_id) {
         std::stack<SurfaceMesh::Vertex> stack;
@@ -51,14 +96,33 @@ namespace easy3d {
 
 
     int SurfaceMeshEnumerator::enumerate_connected_components(SurfaceMesh *mesh, SurfaceMesh::VertexProperty<int> id) {
-        id.vector().assign(mesh->n_vertices(), -1);
+        id.vector().assign(id.vector().size(), -1);
+
+        const int num = static_cast<int>(mesh->vertices_size());
+        std::vector< std::atomic<int> > parent(num);
+#pragma omp parallel for
+        for (int i = 0; i < num; ++i)
+            parent[i].store(i, std::memory_order_relaxed);
 
+        // unite the two endpoints of every edge
+        const int num_edges = static_cast<int>(mesh->edges_size());
+#pragma omp parallel for schedule(dynamic, 4096)
+        for (int i = 0; i < num_edges; ++i) {
+            const SurfaceMesh::Edge e(i);
+            if (mesh->has_garbage() && mesh->is_deleted(e))
+                continue;
+            details::unite(parent, mesh->vertex(e, 0).idx(), mesh->vertex(e, 1).idx());
+        }
+
+        // assign the ids in the order the serial enumeration would discover the components:
+        // a vertex that is its own root starts the next component
         int cur_id = 0;
         for (auto v : mesh->vertices()) {
-            if (id[v] == -1) {
-                propagate_connected_component(mesh, id, v, cur_id);
-                ++cur_id;
-            }
+            const int root = details::find_root(parent, v.idx());
+            if (root == v.idx())
+                id[v] = cur_id++;
+            else    // the root has a smaller index, so it has been labeled already
+                id[v] = id[SurfaceMesh::Vertex(root)];
         }
         return cur_id;
     }
@@ -90,14 +154,34 @@ namespace easy3d {
 
 
     int SurfaceMeshEnumerator::enumerate_connected_components(SurfaceMesh *mesh, SurfaceMesh::FaceProperty<int> id) {
-        id.vector().assign(mesh->n_faces(), -1);
+        id.vector().assign(id.vector().size(), -1);
+
+        const int num = static_cast<int>(mesh->faces_size());
+        std::vector< std::atomic<int> > parent(num);
+#pragma omp parallel for
+        for (int i = 0; i < num; ++i)
+            parent[i].store(i, std::memory_order_relaxed);
+
+        // unite the two faces incident to every edge
+        const int num_edges = static_cast<int>(mesh->edges_size());
+#pragma omp parallel for schedule(dynamic, 4096)
+        for (int i = 0; i < num_edges; ++i) {
+            const SurfaceMesh::Edge e(i);
+            if (mesh->has_garbage() && mesh->is_deleted(e))
+                continue;
+            const auto f0 = mesh->face(mesh->halfedge(e, 0));
+            const auto f1 = mesh->face(mesh->halfedge(e, 1));
+            if (f0.is_valid() && f1.is_valid())
+                details::unite(parent, f0.idx(), f1.idx());
+        }
 
         int cur_id = 0;
         for (auto f : mesh->faces()) {
-            if (id[f] == -1) {
-                propagate_connected_component(mesh, id, f, cur_id);
-                ++cur_id;
-            }
+            const int root = details::find_root(parent, f.idx());
+            if (root == f.idx())
+                id[f] = cur_id++;
+            else    // the root has a smaller index, so it has been labeled already
+                id[f] = id[SurfaceMesh::Face(root)];
         }
 
         return cur_id;
@@ -152,12 +236,42 @@ namespace easy3d {
             }
         }
 
+        auto fnormals = mesh->get_face_property<vec3>("f:normal");
+
+        const int num = static_cast<int>(mesh->faces_size());
+        std::vector< std::atomic<int> > parent(num);
+#pragma omp parallel for
+        for (int i = 0; i < num; ++i)
+            parent[i].store(i, std::memory_order_relaxed);
+
+        // unite the two faces incident to an edge when their normals are compatible. The
+        // angle test - by far the expensive part of the enumeration - runs once per edge,
+        // on all cores.
+        const int num_edges = static_cast<int>(mesh->edges_size());
+#pragma omp parallel for schedule(dynamic, 4096)
+        for (int i = 0; i < num_edges; ++i) {
+            const SurfaceMesh::Edge e(i);
+            if (mesh->has_garbage() && mesh->is_deleted(e))
+                continue;
+            const auto f0 = mesh->face(mesh->halfedge(e, 0));
+            const auto f1 = mesh->face(mesh->halfedge(e, 1));
+            if (!f0.is_valid() || !f1.is_valid() || is_degenerate[f0] || is_degenerate[f1])
+                continue;
+            auto angle = geom::angle(fnormals[f0], fnormals[f1]); // in [-pi, pi]
+            angle = rad2deg(std::abs(angle));
+            if (std::abs(angle) < angle_threshold)
+                details::unite(parent, f0.idx(), f1.idx());
+        }
+
         int cur_id = 0;
         for (auto f : mesh->faces()) {
-            if (!is_degenerate[f] && id[f] == -1) {
-                propagate_planar_component(mesh, id, f, cur_id, angle_threshold);
-                cur_id++;
-            }
+            if (is_degenerate[f])
+                continue;
+            const int root = details::find_root(parent, f.idx());
+            if (root == f.idx())
+                id[f] = cur_id++;
+            else    // the root has a smaller index, so it has been labeled already
+                id[f] = id[SurfaceMesh::Face(root)];
         }
 
         if (num_degenerate > 0) { // propagate the planar partition to degenerate faces
@@ -40,7 +40,24 @@ namespace easy3d {
 
     //=============================================================================
 
-    SurfaceMeshFairing::SurfaceMeshFairing(SurfaceMesh *mesh) : mesh_(mesh) {
+    // the factorized system, kept around for repeated solves. the right-hand side is not
+    // stored as values but as references to the locked vertices (and their weights), so
+    // resolve() can rebuild it from the constraint positions current at that time.
+    struct SurfaceMeshFairing::SolverCache {
+        unsigned int degree;
+        // fingerprint of the mesh connectivity the factorization was computed for
+        unsigned int n_vertices;
+        unsigned int n_edges;
+        unsigned int n_faces;
+        std::vector<SurfaceMesh::Vertex> free_vertices;
+        // per free vertex: the locked vertices entering its right-hand side, with weights
+        std::vector<std::vector<std::pair<SurfaceMesh::Vertex, double> > > rhs_terms;
+        Eigen::SimplicialLDLT<SparseMatrix> solver;
+    };
+
+    //-----------------------------------------------------------------------------
+
+    SurfaceMeshFairing::SurfaceMeshFairing(SurfaceMesh *mesh) : mesh_(mesh), cache_(nullptr) {
         // get & add properties
         points_ = mesh_->get_vertex_property<vec3>("v:point");
         vselected_ = mesh_->get_vertex_property<bool>("v:selected");
@@ -58,11 +75,27 @@ namespace easy3d {
         mesh_->remove_vertex_property(vweight_);
         mesh_->remove_edge_property(eweight_);
         mesh_->remove_vertex_property(idx_);
+
+        delete cache_;
     }
 
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshFairing::fair(unsigned int k) {
+        // a single-shot solve: set up and factorize for the current constraints, then solve
+        if (prefactorize(k))
+            resolve();
+    }
+
+    //-----------------------------------------------------------------------------
+
+    bool SurfaceMeshFairing::setup_system(unsigned int k, std::vector<SurfaceMesh::Vertex> &vertices) {
+        // reset the state of a previous setup (the constraint set may have changed)
+        for (auto v : mesh_->vertices()) {
+            vlocked_[v] = false;
+            idx_[v] = -1;
+        }
+
         // compute cotan weights
         for (auto v : mesh_->vertices()) {
             vweight_[v] = 0.5 / geom::voronoi_area(mesh_, v);
@@ -116,7 +149,7 @@ namespace easy3d {
         }
 
         // collect free vertices
-        std::vector<SurfaceMesh::Vertex> vertices;
+        vertices.clear();
         vertices.reserve(mesh_->n_vertices());
         for (auto v : mesh_->vertices()) {
             if (!vlocked_[v]) {
@@ -128,21 +161,40 @@ namespace easy3d {
         // we need locked vertices as boundary constraints
         if (vertices.size() == mesh_->n_vertices()) {
             LOG(WARNING) << "SurfaceMeshFairing requires locked vertices as boundary constraints.";
-            return;
+            return false;
         }
 
-        // construct matrix & rhs
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    bool SurfaceMeshFairing::prefactorize(unsigned int k) {
+        // an earlier factorization (possibly for another degree) is no longer of use
+        delete cache_;
+        cache_ = nullptr;
+
+        std::vector<SurfaceMesh::Vertex> vertices;
+        if (!setup_system(k, vertices))
+            return false;
+
+        SolverCache *cache = new SolverCache;
+        cache->degree = k;
+        cache->n_vertices = mesh_->n_vertices();
+        cache->n_edges = mesh_->n_edges();
+        cache->n_faces = mesh_->n_faces();
+        cache->free_vertices = vertices;
+
+        // construct the matrix; the locked vertices entering each row are recorded so the
+        // right-hand side can be rebuilt from their positions at solve time
         const unsigned int n = vertices.size();
         SparseMatrix A(n, n);
-        Eigen::MatrixXd B(n, 3);
-        dvec3 b;
 
         std::map<SurfaceMesh::Vertex, double> row;
         std::vector<Triplet> triplets;
+        cache->rhs_terms.resize(n);
 
         for (unsigned int i = 0; i < n; ++i) {
-            b = dvec3(0.0);
-
             setup_matrix_row(vertices[i], vweight_, eweight_, k, row);
 
             for (auto r : row) {
@@ -152,27 +204,64 @@ namespace easy3d {
                 if (idx_[v] != -1) {
                     triplets.emplace_back(i, idx_[v], w);
                 } else {
-                    b -= w * static_cast<dvec3>(points_[v]);
+                    cache->rhs_terms[i].emplace_back(v, w);
                 }
             }
-
-            B.row(i) = (Eigen::Vector3d) b;
         }
 
         A.setFromTriplets(triplets.begin(), triplets.end());
 
-        // solve A*X = B
-        Eigen::SimplicialLDLT<SparseMatrix> solver(A);
-        Eigen::MatrixXd X = solver.solve(B);
+        // factorize (symbolic + numeric)
+        cache->solver.compute(A);
+        if (cache->solver.info() != Eigen::Success) {
+            std::cerr << "SurfaceMeshFairing: Could not factorize linear system\n";
+            delete cache;
+            return false;
+        }
+
+        cache_ = cache;
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    bool SurfaceMeshFairing::resolve() {
+        if (!cache_) {
+            LOG(WARNING) << "no factorization available. prefactorize() must be called first";
+            return false;
+        }
+
+        // the factorization is only valid for the connectivity it was computed for
+        if (cache_->n_vertices != mesh_->n_vertices() ||
+            cache_->n_edges != mesh_->n_edges() ||
+            cache_->n_faces != mesh_->n_faces()) {
+            LOG(WARNING) << "mesh has changed since prefactorize(). the cached factorization is invalid";
+            return false;
+        }
 
-        if (solver.info() != Eigen::Success) {
+        // rebuild the right-hand side from the current constraint positions
+        const unsigned int n = cache_->free_vertices.size();
+        Eigen::MatrixXd B(n, 3);
+        for (unsigned int i = 0; i < n; ++i) {
+            dvec3 b(0.0);
+            for (const auto &term : cache_->rhs_terms[i])
+                b -= term.second * static_cast<dvec3>(points_[term.first]);
+            B.row(i) = (Eigen::Vector3d) b;
+        }
+
+        // solve A*X = B reusing the factorization
+        Eigen::MatrixXd X = cache_->solver.solve(B);
+
+        if (cache_->solver.info() != Eigen::Success) {
             std::cerr << "SurfaceMeshFairing: Could not solve linear system\n";
-        } else {
-            for (unsigned int i = 0; i < n; ++i) {
-                const auto &tmp = X.row(i);
-                points_[vertices[i]] = vec3(tmp(0), tmp(1), tmp(2));
-            }
+            return false;
+        }
+
+        for (unsigned int i = 0; i < n; ++i) {
+            const auto &tmp = X.row(i);
+            points_[cache_->free_vertices[i]] = vec3(tmp(0), tmp(1), tmp(2));
         }
+        return true;
     }
 
     //-----------------------------------------------------------------------------
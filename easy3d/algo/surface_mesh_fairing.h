@@ -35,6 +35,12 @@ namespace easy3d {
      * \class SurfaceMeshFairing easy3d/algo/surface_mesh_fairing.h
      * See the following paper for more details:
      *  - Mathieu Desbrun et al. Implicit fairing of irregular meshes using diffusion and curvature flow. SIGGRAPH, 1999.
+     *
+     * For a single fairing operation simply call fair(). Workflows that fair the same mesh
+     * repeatedly (e.g., hole filling with moving boundary constraints) can factorize the
+     * system once with prefactorize() and then call resolve() for each new set of
+     * constraint positions, which reduces the cost per solve to a pair of triangular
+     * back-substitutions.
      */
     class SurfaceMeshFairing {
     public:
@@ -53,7 +59,33 @@ namespace easy3d {
         //! compute surface by solving k-harmonic equation
         void fair(unsigned int k = 2);
 
+        /**
+         * \brief Build and factorize the k-harmonic system for the current constraint set.
+         * \details The Laplacian weights, the locked vertices, and the symbolic + numeric
+         * factorization are computed from the current state of the mesh and cached. The
+         * cache stays valid as long as the mesh connectivity is not modified; changing
+         * vertex positions (in particular those of the locked vertices) does not
+         * invalidate it, since the weights are kept frozen at prefactorize() time.
+         * \return \c true on success; \c false if the mesh has no locked vertices to serve
+         * as boundary constraints or if the factorization fails.
+         */
+        bool prefactorize(unsigned int k = 2);
+
+        /**
+         * \brief Re-solve the prefactorized system.
+         * \details Uses the current positions of the locked vertices as the right-hand
+         * side and overwrites the positions of the free vertices with the solution.
+         * Requires a successful prior call to prefactorize(); if the mesh connectivity
+         * has changed since then, the cached factorization is rejected.
+         * \return \c true on success.
+         */
+        bool resolve();
+
     private:
+        // computes the weights and the locked-vertex pattern, and collects the free vertices.
+        // returns false if no vertex is locked (i.e., there are no boundary constraints).
+        bool setup_system(unsigned int k, std::vector<SurfaceMesh::Vertex> &vertices);
+
         void setup_matrix_row(const SurfaceMesh::Vertex v, SurfaceMesh::VertexProperty<double> vweight,
                               SurfaceMesh::EdgeProperty<double> eweight,
                               unsigned int laplace_degree,
@@ -69,6 +101,11 @@ namespace easy3d {
         SurfaceMesh::VertexProperty<double> vweight_;
         SurfaceMesh::EdgeProperty<double> eweight_;
         SurfaceMesh::VertexProperty<int> idx_;
+
+        // cached factorization for repeated solves (defined in the .cpp to keep Eigen
+        // out of this header)
+        struct SolverCache;
+        SolverCache *cache_;
     };
 
 
@@ -60,21 +60,106 @@ namespace easy3d {
     void SurfaceMeshFeatures::detect_angle(float angle) {
         const float feature_cosine = cos(angle / 180.0 * M_PI);
 
-        for (auto e : mesh_->edges()) {
+        // batch the face normals once (the per-edge version recomputes each face normal for
+        // every one of its edges)
+        const int num_faces = static_cast<int>(mesh_->faces_size());
+        std::vector<vec3> normals(num_faces, vec3(0, 0, 0));
+#pragma omp parallel for schedule(dynamic, 4096)
+        for (int i = 0; i < num_faces; ++i) {
+            const SurfaceMesh::Face f(i);
+            if (mesh_->has_garbage() && mesh_->is_deleted(f))
+                continue;
+            normals[i] = mesh_->compute_face_normal(f);
+        }
+
+        // the dihedral test: one flat pass of dot products over the edge array
+        const int num_edges = static_cast<int>(mesh_->edges_size());
+        std::vector<char> is_feature(num_edges, 0);
+#pragma omp parallel for
+        for (int i = 0; i < num_edges; ++i) {
+            const SurfaceMesh::Edge e(i);
+            if (mesh_->has_garbage() && mesh_->is_deleted(e))
+                continue;
             if (!mesh_->is_border(e)) {
                 const auto f0 = mesh_->face(mesh_->halfedge(e, 0));
                 const auto f1 = mesh_->face(mesh_->halfedge(e, 1));
+                if (dot(normals[f0.idx()], normals[f1.idx()]) < feature_cosine)
+                    is_feature[i] = 1;
+            }
+        }
+
+        // the marking pass. The flags are packed bits (std::vector<bool>), so they must not
+        // be written concurrently; setting them from the precomputed byte array is a trivial
+        // sweep anyway.
+        for (int i = 0; i < num_edges; ++i) {
+            if (is_feature[i]) {
+                const SurfaceMesh::Edge e(i);
+                efeature_[e] = true;
+                vfeature_[mesh_->vertex(e, 0)] = true;
+                vfeature_[mesh_->vertex(e, 1)] = true;
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
 
-                const vec3 n0 = mesh_->compute_face_normal(f0);
-                const vec3 n1 = mesh_->compute_face_normal(f1);
+    void SurfaceMeshFeatures::detect_angle(float angle, const std::vector<SurfaceMesh::Face> &changed_faces) {
+        const float feature_cosine = cos(angle / 180.0 * M_PI);
 
-                if (dot(n0, n1) < feature_cosine) {
-                    efeature_[e] = true;
-                    vfeature_[mesh_->vertex(e, 0)] = true;
-                    vfeature_[mesh_->vertex(e, 1)] = true;
+        // the edges incident to the changed faces, deduplicated
+        std::vector<SurfaceMesh::Edge> edges;
+        edges.reserve(changed_faces.size() * 3);
+        std::vector<char> seen(mesh_->edges_size(), 0);
+        for (auto f : changed_faces) {
+            if (!f.is_valid() || mesh_->is_deleted(f))
+                continue;
+            for (auto h : mesh_->halfedges(f)) {
+                const auto e = mesh_->edge(h);
+                if (!seen[e.idx()]) {
+                    seen[e.idx()] = 1;
+                    edges.push_back(e);
                 }
             }
         }
+
+        // re-evaluate those edges in parallel (each face normal is shared by only a handful
+        // of the collected edges, so they are recomputed on the fly)
+        const int num = static_cast<int>(edges.size());
+        std::vector<char> is_feature(num, 0);
+#pragma omp parallel for schedule(dynamic, 1024)
+        for (int i = 0; i < num; ++i) {
+            const auto e = edges[i];
+            if (mesh_->is_border(e))
+                continue;
+            const auto f0 = mesh_->face(mesh_->halfedge(e, 0));
+            const auto f1 = mesh_->face(mesh_->halfedge(e, 1));
+            const vec3 n0 = mesh_->compute_face_normal(f0);
+            const vec3 n1 = mesh_->compute_face_normal(f1);
+            if (dot(n0, n1) < feature_cosine)
+                is_feature[i] = 1;
+        }
+
+        // apply: unlike the full pass, the incremental pass may also clear the flag of an
+        // edge that is no longer sharp
+        for (int i = 0; i < num; ++i) {
+            if (!mesh_->is_border(edges[i]))    // border edge flags belong to detect_boundary()
+                efeature_[edges[i]] = (is_feature[i] != 0);
+        }
+
+        // refresh the end vertices of the re-evaluated edges from their incident edges
+        std::vector<char> seen_vertex(mesh_->vertices_size(), 0);
+        for (int i = 0; i < num; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                const auto v = mesh_->vertex(edges[i], j);
+                if (seen_vertex[v.idx()])
+                    continue;
+                seen_vertex[v.idx()] = 1;
+                bool feature = mesh_->is_border(v);
+                for (auto h : mesh_->halfedges(v))
+                    feature = feature || efeature_[mesh_->edge(h)];
+                vfeature_[v] = feature;
+            }
+        }
     }
 
 } // namespace easy3d
\ No newline at end of file
@@ -46,6 +46,14 @@ namespace easy3d {
         //! \brief Mark edges with dihedral angle larger than \p angle as feature.
         void detect_angle(float angle);
 
+        //! \brief Incremental variant of detect_angle(): re-evaluates only the edges incident
+        //! to \p changed_faces (e.g., the faces touched by a remeshing pass) instead of the
+        //! whole mesh. The feature flags of those edges are both set and cleared according to
+        //! the current dihedral angles, and the flags of their end vertices are refreshed from
+        //! the incident edges (keeping boundary vertices marked). Border edge flags are left
+        //! to detect_boundary().
+        void detect_angle(float angle, const std::vector<SurfaceMesh::Face> &changed_faces);
+
     private:
         SurfaceMesh *mesh_;
 
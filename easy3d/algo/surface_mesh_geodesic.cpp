@@ -25,14 +25,97 @@
 
 #include <easy3d/algo/surface_mesh_geodesic.h>
 
+#include <queue>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 namespace easy3d {
 
-    SurfaceMeshGeodesic::SurfaceMeshGeodesic(SurfaceMesh *mesh, bool use_virtual_edges)
-            : mesh_(mesh), use_virtual_edges_(use_virtual_edges) {
+    // \cond
+    namespace details {
+
+        // a queue entry: the distance a vertex was pushed with, and the vertex index. Entries are
+        // never removed on update; a popped entry whose distance no longer matches the current
+        // distance of the vertex is stale and skipped (lazy deletion).
+        typedef std::pair<float, int> QueueEntry;
+
+        // exact ordering by a binary heap
+        class HeapQueue {
+        public:
+            bool empty() const { return queue_.empty(); }
+
+            void push(float dist, int v) { queue_.push(QueueEntry(dist, v)); }
+
+            QueueEntry pop() {
+                const QueueEntry top = queue_.top();
+                queue_.pop();
+                return top;
+            }
+
+        private:
+            std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue_;
+        };
+
+        // a bucketed (Dial-style) queue: the entries are binned by distance and the buckets are
+        // consumed in order. Within a bucket the order is arbitrary, so the processing is only
+        // near-sorted (off by at most the bucket width), but every operation is O(1).
+        class BucketQueue {
+        public:
+            BucketQueue(float width) : width_(width), current_(0), size_(0) {}
+
+            bool empty() const { return size_ == 0; }
+
+            void push(float dist, int v) {
+                std::size_t b = static_cast<std::size_t>(dist / width_);
+                if (b < current_)
+                    b = current_;   // guards against rounding right below the current bucket
+                if (b >= buckets_.size())
+                    buckets_.resize(b + 1);
+                buckets_[b].push_back(QueueEntry(dist, v));
+                ++size_;
+            }
+
+            QueueEntry pop() {
+                while (buckets_[current_].empty())
+                    ++current_;
+                const QueueEntry top = buckets_[current_].back();
+                buckets_[current_].pop_back();
+                --size_;
+                return top;
+            }
+
+        private:
+            float width_;
+            std::size_t current_;
+            std::size_t size_;
+            std::vector<std::vector<QueueEntry> > buckets_;
+        };
+    }
+    // \endcond
+
+
+    SurfaceMeshGeodesic::SurfaceMeshGeodesic(SurfaceMesh *mesh, bool use_virtual_edges, QueueType queue_type)
+            : mesh_(mesh), use_virtual_edges_(use_virtual_edges), queue_type_(queue_type), bucket_width_(0.0f) {
         distance_ = mesh_->vertex_property<float>("v:geodesic:distance");
         processed_ = mesh_->add_vertex_property<bool>("v:geodesic:processed");
 
+        if (queue_type_ == BUCKET) {
+            // half the average edge length keeps the out-of-order error well below the
+            // discretization error of the propagation
+            double total(0.0);
+            for (auto e : mesh_->edges())
+                total += mesh_->edge_length(e);
+            if (mesh_->n_edges() > 0)
+                bucket_width_ = static_cast<float>(0.5 * total / mesh_->n_edges());
+            if (bucket_width_ <= 0.0f) {
+                LOG(WARNING) << "degenerate edge lengths; falling back to the heap-based queue";
+                queue_type_ = HEAP;
+            }
+        }
+
         if (use_virtual_edges_)
             find_virtual_edges();
     }
@@ -151,6 +234,32 @@ namespace easy3d {
                                               std::vector<SurfaceMesh::Vertex> *neighbors) {
         unsigned int num(0);
 
+        if (queue_type_ == BUCKET) {
+            // the bucket-queue path runs on the generic propagation with lazy deletion
+            std::vector<float> &dist = distance_.vector();
+            std::vector<bool> processed(mesh_->vertices_size(), false);
+            std::vector<SurfaceMesh::Vertex> front_init;
+            num = init_seeds(seed, dist, processed, front_init, neighbors);
+
+            if (neighbors)
+                std::sort(neighbors->begin(), neighbors->end(), VertexCmp(distance_));
+            if (num > maxnum) {
+                num = maxnum;
+                if (neighbors)
+                    neighbors->resize(maxnum);
+            }
+
+            if (num < maxnum) {
+                details::BucketQueue front(bucket_width_);
+                for (auto v : front_init)
+                    front.push(dist[v.idx()], v.idx());
+                num += propagate(front, dist, processed, maxdist, maxnum - num, neighbors);
+            }
+
+            mesh_->remove_vertex_property(processed_);
+            return num;
+        }
+
         // generate front
         front_ = new PriorityQueue(VertexCmp(distance_));
 
@@ -273,6 +382,232 @@ namespace easy3d {
 
     //-----------------------------------------------------------------------------
 
+    unsigned int SurfaceMeshGeodesic::init_seeds(const std::vector<SurfaceMesh::Vertex> &seed,
+                                                 std::vector<float> &dist,
+                                                 std::vector<bool> &processed,
+                                                 std::vector<SurfaceMesh::Vertex> &front_init,
+                                                 std::vector<SurfaceMesh::Vertex> *neighbors) const {
+        unsigned int num(0);
+
+        if (seed.empty())
+            return num;
+
+        dist.assign(dist.size(), FLT_MAX);
+        processed.assign(processed.size(), false);
+
+        if (neighbors)
+            neighbors->clear();
+
+        // initialize seed vertices
+        for (auto v : seed) {
+            processed[v.idx()] = true;
+            dist[v.idx()] = 0.0;
+        }
+
+        // initialize seed's one-ring
+        for (auto v : seed) {
+            for (auto vv : mesh_->vertices(v)) {
+                const float d = easy3d::distance(mesh_->position(v), mesh_->position(vv));
+                if (d < dist[vv.idx()]) {
+                    dist[vv.idx()] = d;
+                    processed[vv.idx()] = true;
+                    ++num;
+                    if (neighbors)
+                        neighbors->push_back(vv);
+                }
+            }
+        }
+
+        // initialize the front: the unprocessed neighbors of the one-ring
+        for (auto v : seed) {
+            for (auto vv : mesh_->vertices(v)) {
+                for (auto vvv : mesh_->vertices(vv)) {
+                    if (!processed[vvv.idx()]) {
+                        const float d = update_distance(vvv, dist, processed);
+                        if (d < dist[vvv.idx()]) {
+                            dist[vvv.idx()] = d;
+                            front_init.push_back(vvv);
+                        }
+                    }
+                }
+            }
+        }
+
+        return num;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    template<typename Queue>
+    unsigned int SurfaceMeshGeodesic::propagate(Queue &front, std::vector<float> &dist,
+                                                std::vector<bool> &processed,
+                                                float maxdist, unsigned int maxnum,
+                                                std::vector<SurfaceMesh::Vertex> *neighbors) const {
+        unsigned int num(0);
+
+        while (!front.empty()) {
+            const details::QueueEntry top = front.pop();
+            const SurfaceMesh::Vertex v(top.second);
+
+            // stale entry: the vertex was settled or updated after this entry was pushed
+            if (processed[v.idx()] || top.first != dist[v.idx()])
+                continue;
+
+            processed[v.idx()] = true;
+            ++num;
+            if (neighbors)
+                neighbors->push_back(v);
+
+            // did we reach maximum distance?
+            if (dist[v.idx()] > maxdist)
+                break;
+
+            // did we reach maximum number of neighbors
+            if (num >= maxnum)
+                break;
+
+            // update front
+            for (auto vv : mesh_->vertices(v)) {
+                if (!processed[vv.idx()]) {
+                    const float d = update_distance(vv, dist, processed);
+                    if (d < dist[vv.idx()]) {
+                        dist[vv.idx()] = d;
+                        front.push(d, vv.idx());
+                    }
+                }
+            }
+        }
+
+        return num;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    float SurfaceMeshGeodesic::update_distance(SurfaceMesh::Vertex v, const std::vector<float> &dist,
+                                               const std::vector<bool> &processed) const {
+        SurfaceMesh::Vertex v0, v1, vv;
+        float d, d_min(FLT_MAX), l;
+        typename VirtualEdges::const_iterator ve_it, ve_end(virtual_edges_.end());
+
+        for (auto h : mesh_->halfedges(v)) {
+            if (!mesh_->is_border(h)) {
+                ve_it = virtual_edges_.find(h);
+
+                // no virtual edge
+                if (ve_it == ve_end) {
+                    v0 = mesh_->target(h);
+                    v1 = mesh_->target(mesh_->next(h));
+
+                    if (processed[v0.idx()] && processed[v1.idx()]) {
+                        d = distance(v0, v1, v, dist, FLT_MAX, FLT_MAX);
+                        if (d < d_min)
+                            d_min = d;
+                    }
+                }
+
+                    // virtual edge
+                else {
+                    v0 = mesh_->target(h);
+                    v1 = mesh_->target(mesh_->next(h));
+                    vv = ve_it->second.vertex;
+                    l = ve_it->second.length;
+
+                    if (processed[v0.idx()] && processed[vv.idx()]) {
+                        d = distance(v0, vv, v, dist, FLT_MAX, l);
+                        if (d < d_min)
+                            d_min = d;
+                    }
+
+                    if (processed[v1.idx()] && processed[vv.idx()]) {
+                        d = distance(vv, v1, v, dist, l, FLT_MAX);
+                        if (d < d_min)
+                            d_min = d;
+                    }
+                }
+            }
+        }
+
+        return d_min;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    unsigned int SurfaceMeshGeodesic::compute_parallel(const std::vector<SurfaceMesh::Vertex> &seed,
+                                                       float maxdist) {
+        std::vector<float> &global_dist = distance_.vector();
+        global_dist.assign(mesh_->vertices_size(), FLT_MAX);
+
+        if (seed.empty())
+            return 0;
+
+#ifdef _OPENMP
+        const int num_threads = omp_get_max_threads();
+#else
+        const int num_threads = 1;
+#endif
+        const int num_groups = std::min(static_cast<int>(seed.size()), num_threads);
+
+        // sort the seeds along the longest bounding-box axis and split them into contiguous groups,
+        // so that each group's wavefront stays spatially compact and the groups overlap little
+        std::vector<SurfaceMesh::Vertex> sorted_seeds = seed;
+        const Box3 &box = mesh_->bounding_box();
+        int axis = 0;
+        if (box.range(1) > box.range(axis)) axis = 1;
+        if (box.range(2) > box.range(axis)) axis = 2;
+        auto points = mesh_->get_vertex_property<vec3>("v:point");
+        std::sort(sorted_seeds.begin(), sorted_seeds.end(),
+                  [&points, axis](SurfaceMesh::Vertex a, SurfaceMesh::Vertex b) -> bool {
+                      return points[a][axis] < points[b][axis];
+                  });
+
+        // each group propagates its front into thread-private arrays...
+        std::vector<std::vector<float> > group_dist(num_groups);
+#pragma omp parallel for schedule(dynamic)
+        for (int g = 0; g < num_groups; ++g) {
+            const std::size_t begin = seed.size() * g / num_groups;
+            const std::size_t end = seed.size() * (g + 1) / num_groups;
+            const std::vector<SurfaceMesh::Vertex> group_seeds(sorted_seeds.begin() + begin,
+                                                               sorted_seeds.begin() + end);
+
+            std::vector<float> &dist = group_dist[g];
+            dist.resize(mesh_->vertices_size());
+            std::vector<bool> processed(mesh_->vertices_size());
+            std::vector<SurfaceMesh::Vertex> front_init;
+            init_seeds(group_seeds, dist, processed, front_init, nullptr);
+
+            if (queue_type_ == BUCKET) {
+                details::BucketQueue front(bucket_width_);
+                for (auto v : front_init)
+                    front.push(dist[v.idx()], v.idx());
+                propagate(front, dist, processed, maxdist, UINT_MAX, nullptr);
+            } else {
+                details::HeapQueue front;
+                for (auto v : front_init)
+                    front.push(dist[v.idx()], v.idx());
+                propagate(front, dist, processed, maxdist, UINT_MAX, nullptr);
+            }
+        }
+
+        // ... and the fields are merged by taking the minimum distance per vertex
+        const int num = static_cast<int>(mesh_->vertices_size());
+        unsigned int reached = 0;
+#pragma omp parallel for reduction(+:reached)
+        for (int i = 0; i < num; ++i) {
+            float d = global_dist[i];
+            for (int g = 0; g < num_groups; ++g)
+                d = std::min(d, group_dist[g][i]);
+            global_dist[i] = d;
+            if (d < maxdist && d != FLT_MAX)
+                ++reached;
+        }
+
+        mesh_->remove_vertex_property(processed_);
+
+        return reached;
+    }
+
+    //-----------------------------------------------------------------------------
+
     void SurfaceMeshGeodesic::heap_vertex(SurfaceMesh::Vertex v) {
         assert(!processed_[v]);
 
@@ -401,6 +736,62 @@ namespace easy3d {
 
     //-----------------------------------------------------------------------------
 
+    float
+    SurfaceMeshGeodesic::distance(SurfaceMesh::Vertex v0, SurfaceMesh::Vertex v1, SurfaceMesh::Vertex v2,
+                                  const std::vector<float> &dist, float r0, float r1) const {
+        vec3 A, B, C;
+        double TA, TB;
+        double a, b;
+
+        // choose points such that TB>TA and hence u>0
+        if (dist[v0.idx()] < dist[v1.idx()]) {
+            A = mesh_->position(v0);
+            B = mesh_->position(v1);
+            C = mesh_->position(v2);
+            TA = dist[v0.idx()];
+            TB = dist[v1.idx()];
+            a = r1 == FLT_MAX ? easy3d::distance(B, C) : r1;
+            b = r0 == FLT_MAX ? easy3d::distance(A, C) : r0;
+        } else {
+            A = mesh_->position(v1);
+            B = mesh_->position(v0);
+            C = mesh_->position(v2);
+            TA = dist[v1.idx()];
+            TB = dist[v0.idx()];
+            a = r0 == FLT_MAX ? easy3d::distance(B, C) : r0;
+            b = r1 == FLT_MAX ? easy3d::distance(A, C) : r1;
+        }
+
+        // Dykstra: propagate along edges
+        const double dykstra = std::min(TA + b, TB + a);
+
+        // obtuse angle -> fall back to Dykstra
+        const double c = dot(normalize(A - C), normalize(B - C)); // cosine
+        if (c < 0.0)
+            return dykstra;
+
+        // Kimmel: solve quadratic equation
+        const double u = TB - TA;
+        const double aa = a * a + b * b - 2.0 * a * b * c;
+        const double bb = 2.0 * b * u * (a * c - b);
+        const double cc = b * b * (u * u - a * a * (1.0 - c * c));
+        const double dd = bb * bb - 4.0 * aa * cc;
+        if (dd > 0.0) {
+            const double t1 = (-bb + sqrt(dd)) / (2.0 * aa);
+            const double t2 = (-bb - sqrt(dd)) / (2.0 * aa);
+            const double t = std::max(t1, t2);
+            const double q = b * (t - u) / t;
+            if ((u < t) && (a * c < q) && (q < a / c)) {
+                return TA + t;
+            }
+        }
+
+        // use Dykstra as fall-back
+        return dykstra;
+    }
+
+    //-----------------------------------------------------------------------------
+
     void SurfaceMeshGeodesic::distance_to_texture_coordinates() {
         // find maximum distance
         float maxdist(0);
@@ -43,12 +43,22 @@ namespace easy3d {
      */
     class SurfaceMeshGeodesic {
     public:
+        //! \brief The type of priority queue used for the front propagation.
+        enum QueueType {
+            HEAP,   //!< exact ordering of the front (the default)
+            BUCKET  //!< a bucketed (Dial-style) queue: O(1) queue operations at the cost of only
+                    //!< near-sorted processing. The computed distances may deviate from the HEAP
+                    //!< result by up to the bucket width (half the average edge length), which is
+                    //!< well below the discretization error of the method itself.
+        };
+
         //! \brief Construct from mesh.
         //! \param mesh The mesh on which to compute the geodesic distances.
         //! \param use_virtual_edges A flag to control the use of virtual edges.
         //! Default: true.
+        //! \param queue_type The type of priority queue driving the propagation.
         //! \sa compute() to actually compute the geodesic distances.
-        SurfaceMeshGeodesic(SurfaceMesh *mesh, bool use_virtual_edges = true);
+        SurfaceMeshGeodesic(SurfaceMesh *mesh, bool use_virtual_edges = true, QueueType queue_type = HEAP);
 
         // destructor
         ~SurfaceMeshGeodesic();
@@ -66,6 +76,20 @@ namespace easy3d {
                              unsigned int maxnum = INT_MAX,
                              std::vector<SurfaceMesh::Vertex> *neighbors = nullptr);
 
+        //! \brief Compute the geodesic distances to the closest of the given seed vertices, with the
+        //! per-seed wavefronts propagating concurrently.
+        //! \details The seeds are sorted spatially and split into contiguous groups; each group
+        //! propagates its own front into thread-private arrays, and the fields are merged by taking
+        //! the minimum distance per vertex. This computes the same distance field as compute() with
+        //! the same seeds. It pays off when the propagation is bounded (a finite \p maxdist, as when
+        //! computing local geodesic balls around thousands of sample points) or when the seeds cover
+        //! the mesh densely; with a single far-away seed there is nothing to parallelize.
+        //! \param[in] seed The vector of seed vertices.
+        //! \param[in] maxdist The maximum distance up to which to compute the geodesic distances.
+        //! \return The number of vertices reached (i.e., with a finite distance).
+        unsigned int compute_parallel(const std::vector<SurfaceMesh::Vertex> &seed,
+                                      float maxdist = FLT_MAX);
+
         //! \brief Access the computed geodesic distance.
         //! \param[in] v The vertex for which to return the geodesic distance.
         //! \return The geodesic distance of vertex \p v.
@@ -123,12 +147,37 @@ namespace easy3d {
         float distance(SurfaceMesh::Vertex v0, SurfaceMesh::Vertex v1, SurfaceMesh::Vertex v2, float r0 = FLT_MAX,
                        float r1 = FLT_MAX);
 
+        // The same propagation as heap_vertex()/propagate_front(), but operating on explicit
+        // distance/processed arrays and a queue with lazy deletion, so several fronts can run
+        // concurrently on thread-private arrays. Used by the BUCKET mode and compute_parallel().
+        float distance(SurfaceMesh::Vertex v0, SurfaceMesh::Vertex v1, SurfaceMesh::Vertex v2,
+                       const std::vector<float> &dist, float r0, float r1) const;
+
+        // the best distance of v computed from its already processed neighbors (FLT_MAX if none)
+        float update_distance(SurfaceMesh::Vertex v, const std::vector<float> &dist,
+                              const std::vector<bool> &processed) const;
+
+        // seeds the front: seed vertices and their one-rings; returns the number of one-ring
+        // neighbors initialized, and collects them in front_init
+        unsigned int init_seeds(const std::vector<SurfaceMesh::Vertex> &seed, std::vector<float> &dist,
+                                std::vector<bool> &processed,
+                                std::vector<SurfaceMesh::Vertex> &front_init,
+                                std::vector<SurfaceMesh::Vertex> *neighbors) const;
+
+        template<typename Queue>
+        unsigned int propagate(Queue &front, std::vector<float> &dist, std::vector<bool> &processed,
+                               float maxdist, unsigned int maxnum,
+                               std::vector<SurfaceMesh::Vertex> *neighbors) const;
+
     private: // private data
         SurfaceMesh *mesh_;
 
         bool use_virtual_edges_;
         VirtualEdges virtual_edges_;
 
+        QueueType queue_type_;
+        float bucket_width_;
+
         PriorityQueue *front_;
 
         SurfaceMesh::VertexProperty<float> distance_;
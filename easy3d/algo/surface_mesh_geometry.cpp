@@ -24,6 +24,8 @@
 
 #include <easy3d/algo/surface_mesh_geometry.h>
 
+#include <easy3d/util/thread_pool.h>
+
 #include <limits>
 #include <cmath>
 #include <cfloat>
@@ -31,6 +33,41 @@
 
 namespace easy3d {
 
+    // \cond
+    namespace details {
+
+        // the faces are reduced per fixed-size block; the blocks are distributed over the
+        // threads but each block is summed sequentially in double precision, and the block
+        // partials are then combined pairwise in index order. The result is therefore
+        // independent of the number of threads.
+        static const std::size_t reduction_block_size = 4096;
+
+        struct FacePartial {
+            FacePartial() : area(0.0), volume(0.0), moment(0.0, 0.0, 0.0) {}
+
+            double area;
+            double volume;
+            dvec3 moment;   // area-weighted sum of the face centroids
+        };
+
+        // combines the partials pairwise (recursive halving) in index order
+        static FacePartial combine_pairwise(std::vector<FacePartial> &partials,
+                                            std::size_t begin, std::size_t end) {
+            if (end - begin == 1)
+                return partials[begin];
+            const std::size_t mid = begin + (end - begin) / 2;
+            const FacePartial lo = combine_pairwise(partials, begin, mid);
+            const FacePartial hi = combine_pairwise(partials, mid, end);
+            FacePartial result;
+            result.area = lo.area + hi.area;
+            result.volume = lo.volume + hi.volume;
+            result.moment = lo.moment + hi.moment;
+            return result;
+        }
+
+    }
+    // \endcond
+
     namespace geom {
 
         float triangle_area(const SurfaceMesh *mesh, SurfaceMesh::Face f) {
@@ -47,11 +84,7 @@ namespace easy3d {
         //-----------------------------------------------------------------------------
 
         float surface_area(const SurfaceMesh *mesh) {
-            float area(0);
-            for (auto f : mesh->faces()) {
-                area += triangle_area(mesh, f);
-            }
-            return area;
+            return metrics(mesh).area;
         }
 
         //-----------------------------------------------------------------------------
@@ -70,16 +103,50 @@ namespace easy3d {
         //-----------------------------------------------------------------------------
 
         vec3 centroid(const SurfaceMesh *mesh) {
-            vec3 center(0, 0, 0), c;
-            float area(0), a;
-            for (auto f : mesh->faces()) {
-                a = triangle_area(mesh, f);
-                c = centroid(mesh, f);
-                area += a;
-                center += a * c;
-            }
-            center /= area;
-            return center;
+            return metrics(mesh).centroid;
+        }
+
+        //-----------------------------------------------------------------------------
+
+        SurfaceMeshMetrics metrics(const SurfaceMesh *mesh) {
+            const std::size_t nb_faces = mesh->faces_size(); // the raw range (may contain deleted faces)
+            const std::size_t nb_blocks =
+                    std::max(std::size_t(1), (nb_faces + details::reduction_block_size - 1) /
+                                             details::reduction_block_size);
+
+            std::vector<details::FacePartial> partials(nb_blocks);
+            ThreadPool::global().parallel_for(0, nb_blocks, [mesh, nb_faces, &partials](std::size_t b) {
+                details::FacePartial &partial = partials[b];
+                const std::size_t begin = b * details::reduction_block_size;
+                const std::size_t end = std::min(nb_faces, begin + details::reduction_block_size);
+                for (std::size_t i = begin; i < end; ++i) {
+                    const SurfaceMesh::Face f((int) i);
+                    if (mesh->is_deleted(f))
+                        continue;
+                    auto fv = mesh->vertices(f);
+                    const dvec3 p0 = (dvec3) mesh->position(*fv);
+                    const dvec3 p1 = (dvec3) mesh->position(*(++fv));
+                    const dvec3 p2 = (dvec3) mesh->position(*(++fv));
+                    const double a = 0.5 * norm(cross(p1 - p0, p2 - p0));
+                    partial.area += a;
+                    partial.volume += dot(p0, cross(p1, p2)) / 6.0;
+                    partial.moment += a * (p0 + p1 + p2) / 3.0;
+                }
+            }, 1);
+
+            const details::FacePartial total = details::combine_pairwise(partials, 0, nb_blocks);
+            SurfaceMeshMetrics result;
+            result.area = (float) total.area;
+            result.volume = (float) std::abs(total.volume);
+            if (total.area > std::numeric_limits<double>::min())
+                result.centroid = vec3(total.moment / total.area);
+            return result;
+        }
+
+        //-----------------------------------------------------------------------------
+
+        float volume(const SurfaceMesh *mesh) {
+            return metrics(mesh).volume;
         }
 
         //-----------------------------------------------------------------------------
@@ -125,6 +192,18 @@ namespace easy3d {
 
         //-----------------------------------------------------------------------------
 
+        std::vector<double> cotan_weights(const SurfaceMesh *mesh) {
+            std::vector<double> weights(mesh->edges_size(), 0.0);
+            ThreadPool::global().parallel_for(0, weights.size(), [mesh, &weights](std::size_t i) {
+                const SurfaceMesh::Edge e((int) i);
+                if (!mesh->is_deleted(e))
+                    weights[i] = cotan_weight(mesh, e);
+            });
+            return weights;
+        }
+
+        //-----------------------------------------------------------------------------
+
         double voronoi_area(const SurfaceMesh *mesh, SurfaceMesh::Vertex v) {
             double area(0.0);
 
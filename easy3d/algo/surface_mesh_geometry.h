@@ -38,18 +38,49 @@ namespace easy3d {
         float triangle_area(const SurfaceMesh *mesh, SurfaceMesh::Face f);
 
         /** \brief surface area of the mesh (assumes triangular faces)    */
+        /** \note the faces are summed in parallel with a deterministic reduction, so the
+         *      result does not depend on the number of threads.    */
         float surface_area(const SurfaceMesh *mesh);
 
         /** \brief barycenter/centroid of a face    */
         vec3 centroid(const SurfaceMesh *mesh, SurfaceMesh::Face f);
 
         /** \brief barycenter/centroid of mesh, computed as area-weighted mean of vertices.    */
-        /** \note assumes triangular faces.    */
+        /** \note assumes triangular faces. Computed with the same deterministic parallel
+         *      reduction as surface_area().    */
         vec3 centroid(const SurfaceMesh *mesh);
 
+        /** \brief area, volume, and centroid of a mesh, from a single sweep over the faces. */
+        struct SurfaceMeshMetrics {
+            SurfaceMeshMetrics() : area(0.0f), volume(0.0f), centroid(0, 0, 0) {}
+
+            float area;     ///< surface area (assumes triangular faces)
+            float volume;   ///< enclosed volume; only meaningful for closed meshes
+            vec3 centroid;  ///< area-weighted centroid
+        };
+
+        /**
+         * \brief Computes the area, the volume, and the centroid of \p mesh in one pass.
+         * \details The three quantities are accumulated from a single parallel sweep over the
+         *      face list, which is considerably cheaper than calling surface_area(), volume(),
+         *      and centroid() separately on large meshes. The faces are summed per fixed-size
+         *      block in double precision and the block partials are combined pairwise in index
+         *      order, so the result is deterministic regardless of the number of threads.
+         * \note Assumes triangular faces. The volume is computed with the divergence theorem
+         *      and is only meaningful for closed meshes.
+         */
+        SurfaceMeshMetrics metrics(const SurfaceMesh *mesh);
+
+        /** \brief enclosed volume of the mesh (assumes a closed triangle mesh)    */
+        float volume(const SurfaceMesh *mesh);
+
         /** \brief compute the cotangent weight for edge e    */
         double cotan_weight(const SurfaceMesh *mesh, SurfaceMesh::Edge e);
 
+        /** \brief compute the cotangent weights of all edges in parallel    */
+        /** \note the weight of edge \c e is stored at index \c e.idx(); deleted edges get 0.    */
+        std::vector<double> cotan_weights(const SurfaceMesh *mesh);
+
         /** \brief compute (mixed) Voronoi area of vertex v    */
         double voronoi_area(const SurfaceMesh *mesh, SurfaceMesh::Vertex v);
 
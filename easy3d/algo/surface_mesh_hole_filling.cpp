@@ -85,34 +85,147 @@ namespace easy3d {
 
     //-----------------------------------------------------------------------------
 
-    bool SurfaceMeshHoleFilling::triangulate_hole(SurfaceMesh::Halfedge _h) {
-        // trace hole
-        hole_.clear();
-        SurfaceMesh::Halfedge h = _h;
-        do {
-            // check for manifoldness
-            if (!mesh_->is_manifold(mesh_->target(h))) {
+    std::vector<SurfaceMesh::Halfedge> SurfaceMeshHoleFilling::holes() const {
+        std::vector<SurfaceMesh::Halfedge> result;
+        std::vector<bool> visited(mesh_->halfedges_size(), false);
+        for (auto h : mesh_->halfedges()) {
+            if (mesh_->is_border(h) && !visited[h.idx()]) {
+                result.push_back(h);
+                SurfaceMesh::Halfedge hh = h;
+                do {
+                    visited[hh.idx()] = true;
+                } while ((hh = mesh_->next(hh)) != h);
+            }
+        }
+        return result;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    unsigned int SurfaceMeshHoleFilling::fill_holes(unsigned int small_hole_size) {
+        unsigned int count = 0;
+
+        // enumerate the holes and route them by size
+        std::vector<std::vector<SurfaceMesh::Halfedge>> small_holes;
+        bool has_large_holes = false;
+        for (auto h : holes()) {
+            std::vector<SurfaceMesh::Halfedge> hole;
+            if (!trace_hole(h, hole)) {
                 std::cerr << "[SurfaceMeshHoleFilling] Non-manifold hole\n";
-                return false;
+                continue;
             }
+            if (hole.size() <= small_hole_size)
+                small_holes.push_back(hole);
+            else
+                has_large_holes = true;
+        }
+
+        // small holes: the triangulations only read the mesh, so they are computed
+        // concurrently (note that the const points_/mesh_ accesses never modify shared
+        // state); the triangles of all holes are then added in one serial batch
+        const int num = static_cast<int>(small_holes.size());
+        std::vector<std::vector<SurfaceMesh::Vertex>> triangles(num);
+        const SurfaceMeshHoleFilling *self = this;
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < num; ++i)
+            self->triangulate_hole(small_holes[i], triangles[i]);
+
+        for (int i = 0; i < num; ++i) {
+            for (std::size_t t = 0; t < triangles[i].size(); t += 3)
+                mesh_->add_triangle(triangles[i][t], triangles[i][t + 1], triangles[i][t + 2]);
+            if (!triangles[i].empty())
+                ++count;
+        }
+
+        // large holes: the full pipeline (remeshing and fairing) one at a time. Filling a
+        // hole collects garbage, which invalidates the handles of the remaining holes, so
+        // the next hole is re-found after every fill; failed holes are marked through a
+        // halfedge property, which survives the garbage collection.
+        if (has_large_holes) {
+            auto failed = mesh_->add_halfedge_property<bool>("SurfaceMeshHoleFilling:failed", false);
+            bool again = true;
+            while (again) {
+                again = false;
+                for (auto h : mesh_->halfedges()) {
+                    if (!mesh_->is_border(h) || failed[h])
+                        continue;
+
+                    std::vector<SurfaceMesh::Halfedge> hole;
+                    if (!trace_hole(h, hole) || hole.size() <= small_hole_size) {
+                        // non-manifold, or a small hole whose triangulation failed: leave it
+                        for (auto hh : hole)
+                            failed[hh] = true;
+                        continue;
+                    }
+
+                    if (fill_hole(h)) {
+                        ++count;
+                        again = true;
+                        break;  // handles may have been invalidated; rescan
+                    } else {
+                        for (auto hh : hole)
+                            failed[hh] = true;
+                    }
+                }
+            }
+            mesh_->remove_halfedge_property(failed);
+        }
+
+        return count;
+    }
+
+    //-----------------------------------------------------------------------------
 
-            hole_.push_back(h);
+    bool SurfaceMeshHoleFilling::trace_hole(SurfaceMesh::Halfedge _h,
+                                            std::vector<SurfaceMesh::Halfedge> &hole) const {
+        bool manifold = true;
+        SurfaceMesh::Halfedge h = _h;
+        do {
+            // check for manifoldness
+            if (!mesh_->is_manifold(mesh_->target(h)))
+                manifold = false;
+            hole.push_back(h);
         } while ((h = mesh_->next(h)) != _h);
-        const int n = hole_.size();
+        return manifold;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    bool SurfaceMeshHoleFilling::triangulate_hole(SurfaceMesh::Halfedge _h) {
+        // trace hole
+        hole_.clear();
+        if (!trace_hole(_h, hole_)) {
+            std::cerr << "[SurfaceMeshHoleFilling] Non-manifold hole\n";
+            return false;
+        }
+
+        // compute the minimal triangulation and add its triangles to the mesh
+        std::vector<SurfaceMesh::Vertex> triangles;
+        if (!triangulate_hole(hole_, triangles))
+            return false;
+        for (std::size_t i = 0; i < triangles.size(); i += 3)
+            mesh_->add_triangle(triangles[i], triangles[i + 1], triangles[i + 2]);
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    bool SurfaceMeshHoleFilling::triangulate_hole(const std::vector<SurfaceMesh::Halfedge> &hole,
+                                                  std::vector<SurfaceMesh::Vertex> &triangles) const {
+        const int n = hole.size();
 
         // compute minimal triangulation by dynamic programming
-        weight_.clear();
-        weight_.resize(n, std::vector<Weight>(n, Weight()));
-        index_.clear();
-        index_.resize(n, std::vector<int>(n, 0));
+        std::vector<std::vector<Weight>> weight(n, std::vector<Weight>(n, Weight()));
+        std::vector<std::vector<int>> index(n, std::vector<int>(n, 0));
 
         int i, j, m, k, imin;
         Weight w, wmin;
 
         // initialize 2-gons
         for (i = 0; i < n - 1; ++i) {
-            weight_[i][i + 1] = Weight(0, 0);
-            index_[i][i + 1] = -1;
+            weight[i][i + 1] = Weight(0, 0);
+            index[i][i + 1] = -1;
         }
 
         // n-gons with n>2
@@ -125,19 +238,20 @@ namespace easy3d {
 
                 // find best split i < m < i+j
                 for (m = i + 1; m < k; ++m) {
-                    w = weight_[i][m] + compute_weight(i, m, k) + weight_[m][k];
+                    w = weight[i][m] + compute_weight(hole, index, i, m, k) + weight[m][k];
                     if (w < wmin) {
                         wmin = w;
                         imin = m;
                     }
                 }
 
-                weight_[i][k] = wmin;
-                index_[i][k] = imin;
+                weight[i][k] = wmin;
+                index[i][k] = imin;
             }
         }
 
-        // now add triangles to mesh
+        // now collect the triangles
+        triangles.reserve(3 * (n - 2));
         std::vector<ivec2> todo;
         todo.reserve(n);
         todo.push_back(ivec2(0, n - 1));
@@ -148,29 +262,28 @@ namespace easy3d {
             int end = tri[1];
             if (end - start < 2)
                 continue;
-            int split = index_[start][end];
+            int split = index[start][end];
 
-            mesh_->add_triangle(hole_vertex(start), hole_vertex(split),
-                                hole_vertex(end));
+            triangles.push_back(hole_vertex(hole, start));
+            triangles.push_back(hole_vertex(hole, split));
+            triangles.push_back(hole_vertex(hole, end));
 
             todo.push_back(ivec2(start, split));
             todo.push_back(ivec2(split, end));
         }
 
-        // clean up
-        weight_.clear();
-        index_.clear();
-
         return true;
     }
 
     //-----------------------------------------------------------------------------
 
-    SurfaceMeshHoleFilling::Weight SurfaceMeshHoleFilling::compute_weight(int _i, int _j,
-                                                                          int _k) const {
-        const SurfaceMesh::Vertex a = hole_vertex(_i);
-        const SurfaceMesh::Vertex b = hole_vertex(_j);
-        const SurfaceMesh::Vertex c = hole_vertex(_k);
+    SurfaceMeshHoleFilling::Weight SurfaceMeshHoleFilling::compute_weight(
+            const std::vector<SurfaceMesh::Halfedge> &hole,
+            const std::vector<std::vector<int>> &index,
+            int _i, int _j, int _k) const {
+        const SurfaceMesh::Vertex a = hole_vertex(hole, _i);
+        const SurfaceMesh::Vertex b = hole_vertex(hole, _j);
+        const SurfaceMesh::Vertex c = hole_vertex(hole, _k);
         SurfaceMesh::Vertex d;
 
         // if one of the potential edges already exists, this would result
@@ -188,16 +301,16 @@ namespace easy3d {
         const vec3 n = compute_normal(a, b, c);
 
         // ...neighbor to (i,j)
-        d = (_i + 1 == _j) ? opposite_vertex(_j) : hole_vertex(index_[_i][_j]);
+        d = (_i + 1 == _j) ? opposite_vertex(hole, _j) : hole_vertex(hole, index[_i][_j]);
         angle = std::max(angle, compute_angle(n, compute_normal(a, d, b)));
 
         // ...neighbor to (j,k)
-        d = (_j + 1 == _k) ? opposite_vertex(_k) : hole_vertex(index_[_j][_k]);
+        d = (_j + 1 == _k) ? opposite_vertex(hole, _k) : hole_vertex(hole, index[_j][_k]);
         angle = std::max(angle, compute_angle(n, compute_normal(b, d, c)));
 
         // ...neighbor to (k,i) if (k,i)==(n-1, 0)
-        if (_i == 0 && _k + 1 == (int) hole_.size()) {
-            d = opposite_vertex(0);
+        if (_i == 0 && _k + 1 == (int) hole.size()) {
+            d = opposite_vertex(hole, 0);
             angle = std::max(angle, compute_angle(n, compute_normal(c, d, a)));
         }
 
@@ -213,8 +326,8 @@ namespace easy3d {
         // compute target edge length
         l = 0.0;
         for (int i = 0; i < n; ++i) {
-            l += distance(points_[hole_vertex(i)],
-                          points_[hole_vertex((i + 1) % n)]);
+            l += distance(points_[hole_vertex(hole_, i)],
+                          points_[hole_vertex(hole_, (i + 1) % n)]);
         }
         l /= (float) n;
         lmin = 0.7 * l;
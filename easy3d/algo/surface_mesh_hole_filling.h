@@ -47,6 +47,23 @@ namespace easy3d {
         /// \brief fill the hole specified by halfedge h
         bool fill_hole(SurfaceMesh::Halfedge h);
 
+        /// \brief enumerate the holes of the mesh
+        /// \return one border halfedge per boundary loop.
+        std::vector<SurfaceMesh::Halfedge> holes() const;
+
+        /// \brief fill all holes of the mesh
+        /// \details Holes touch disjoint topology, so the expensive part of the work is done
+        /// concurrently: the minimal triangulations of all small holes (boundary loops with no
+        /// more than \p small_hole_size edges) are computed in parallel (the computation only
+        /// reads the mesh), and the resulting triangles are added to the mesh in one batched
+        /// serial pass. Larger holes go through the full pipeline of fill_hole() (triangulation,
+        /// isotropic remeshing, and fairing), one at a time. Holes that cannot be filled (e.g.,
+        /// non-manifold ones) are skipped.
+        /// \param small_hole_size the maximum number of boundary edges of a hole to be closed
+        /// with the minimal triangulation only (without remeshing and fairing).
+        /// \return the number of holes filled.
+        unsigned int fill_holes(unsigned int small_hole_size = 32);
+
     private:
         struct Weight {
             Weight(float _angle = FLT_MAX, float _area = FLT_MAX)
@@ -67,11 +84,22 @@ namespace easy3d {
         };
 
     private:
-        // compute optimal triangulation of hole
+        // trace the boundary loop through h. Returns false if the hole is non-manifold.
+        bool trace_hole(SurfaceMesh::Halfedge h, std::vector<SurfaceMesh::Halfedge> &hole) const;
+
+        // compute optimal triangulation of hole and add the triangles to the mesh
         bool triangulate_hole(SurfaceMesh::Halfedge h);
 
+        // compute the optimal (angle/area-minimizing) triangulation of a hole by dynamic
+        // programming. Only reads the mesh, so holes can be triangulated concurrently; the
+        // resulting triangles (consecutive vertex triples) are added to the mesh by the caller.
+        bool triangulate_hole(const std::vector<SurfaceMesh::Halfedge> &hole,
+                              std::vector<SurfaceMesh::Vertex> &triangles) const;
+
         // compute the weight of the triangle (i,j,k).
-        Weight compute_weight(int i, int j, int k) const;
+        Weight compute_weight(const std::vector<SurfaceMesh::Halfedge> &hole,
+                              const std::vector<std::vector<int>> &index,
+                              int i, int j, int k) const;
 
         // refine triangulation (isotropic remeshing)
         void refine();
@@ -88,16 +116,16 @@ namespace easy3d {
 
     private:
         // return i'th vertex of hole
-        SurfaceMesh::Vertex hole_vertex(unsigned int i) const {
-            assert(i < hole_.size());
-            return mesh_->target(hole_[i]);
+        SurfaceMesh::Vertex hole_vertex(const std::vector<SurfaceMesh::Halfedge> &hole, unsigned int i) const {
+            assert(i < hole.size());
+            return mesh_->target(hole[i]);
         }
 
         // return vertex opposite edge (i-1,i)
-        SurfaceMesh::Vertex opposite_vertex(unsigned int i) const {
-            assert(i < hole_.size());
+        SurfaceMesh::Vertex opposite_vertex(const std::vector<SurfaceMesh::Halfedge> &hole, unsigned int i) const {
+            assert(i < hole.size());
             return mesh_->target(
-                    mesh_->next(mesh_->opposite(hole_[i])));
+                    mesh_->next(mesh_->opposite(hole[i])));
         }
 
         // does interior edge (_a,_b) exist already?
@@ -120,10 +148,6 @@ namespace easy3d {
         SurfaceMesh::EdgeProperty<bool> elocked_;
 
         std::vector<SurfaceMesh::Halfedge> hole_;
-
-        // data for computing optimal triangulation
-        std::vector<std::vector<Weight>> weight_;
-        std::vector<std::vector<int>> index_;
     };
 
 }
@@ -24,16 +24,64 @@
 
 
 #include <easy3d/algo/surface_mesh_parameterization.h>
+#include <easy3d/algo/surface_mesh_components.h>
 #include <easy3d/algo/surface_mesh_geometry.h>
 #include <easy3d/util/logging.h>
+#include <easy3d/util/progress.h>
 
 #include <cmath>
+#include <functional>
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
 
 namespace easy3d {
 
+    // \cond
+    // the iterative solvers below multi-thread their sparse matrix-vector products
+    // (with OpenMP) only when the matrix is stored row-major
+    using SparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+    using Triplet = Eigen::Triplet<double>;
+
+    namespace details {
+
+        // Parameterizes every connected component of the mesh on a mesh of its own and copies
+        // the texture coordinates back. The charts are completely independent systems, so they
+        // are assembled and solved concurrently. Returns false when the mesh is a single chart
+        // (or empty), in which case the caller falls through to the direct path.
+        bool parameterize_per_component(SurfaceMesh *mesh,
+                                        const std::function<void(SurfaceMesh *)> &parameterize_chart) {
+            const std::vector<SurfaceMeshComponent> components = SurfaceMeshComponent::extract(mesh);
+            if (components.size() <= 1)
+                return false;
+
+            // copy each component into its own mesh. This stays serial: to_mesh() temporarily
+            // tags the shared source mesh with a vertex property.
+            std::vector<SurfaceMesh *> charts(components.size());
+            for (std::size_t i = 0; i < components.size(); ++i)
+                charts[i] = components[i].to_mesh();
+
+#pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < static_cast<int>(charts.size()); ++i)
+                parameterize_chart(charts[i]);
+
+            // copy the texture coordinates back: to_mesh() numbers the chart vertices in the
+            // order the component lists them
+            auto tex = mesh->vertex_property<vec2>("v:texcoord");
+            for (std::size_t i = 0; i < components.size(); ++i) {
+                auto chart_tex = charts[i]->get_vertex_property<vec2>("v:texcoord");
+                const auto &vertices = components[i].vertices();
+                for (std::size_t j = 0; j < vertices.size(); ++j)
+                    tex[vertices[j]] = chart_tex[SurfaceMesh::Vertex(static_cast<int>(j))];
+                delete charts[i];
+            }
+
+            return true;
+        }
+
+    }
+    // \endcond
+
     SurfaceMeshParameterization::SurfaceMeshParameterization(SurfaceMesh *mesh)
             : mesh_(mesh) {
     }
@@ -104,6 +152,19 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshParameterization::harmonic(bool use_uniform_weights) {
+        // a mesh that decomposes into several charts is parameterized chart by chart,
+        // with the charts running concurrently
+        if (details::parameterize_per_component(mesh_, [use_uniform_weights](SurfaceMesh *chart) {
+                SurfaceMeshParameterization(chart).harmonic_chart(use_uniform_weights);
+            }))
+            return;
+
+        harmonic_chart(use_uniform_weights);
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void SurfaceMeshParameterization::harmonic_chart(bool use_uniform_weights) {
         // map boundary to circle
         if (!setup_boundary_constraints()) {
             LOG(ERROR) << "failed setup boundary constraints.";
@@ -115,9 +176,14 @@ namespace easy3d {
         auto eweight = mesh_->add_edge_property<float>("e:param:SurfaceMeshParameterization");
         auto idx = mesh_->add_vertex_property<int>("v:idx:SurfaceMeshParameterization", -1);
 
-        // compute Laplace weight per edge: cotan or uniform
-        for (auto e : mesh_->edges()) {
-            eweight[e] = use_uniform_weights ? 1.0 : std::max(0.0, geom::cotan_weight(mesh_, e));
+        // compute Laplace weight per edge: cotan or uniform. The weights are independent
+        // of each other, and the cotan evaluation dominates this loop.
+        const int num_edges = static_cast<int>(mesh_->edges_size());
+#pragma omp parallel for
+        for (int ei = 0; ei < num_edges; ++ei) {
+            const SurfaceMesh::Edge e(ei);
+            if (!mesh_->is_deleted(e))
+                eweight[e] = use_uniform_weights ? 1.0 : std::max(0.0, geom::cotan_weight(mesh_, e));
         }
 
         // collect free (non-boundary) vertices in array free_vertices[]
@@ -134,51 +200,91 @@ namespace easy3d {
 
         // setup matrix A and rhs B
         const unsigned int n = free_vertices.size();
-        Eigen::SparseMatrix<double> A(n, n);
+        SparseMatrix A(n, n);
         Eigen::MatrixXd B(n, 2);
-        std::vector<Eigen::Triplet<double>>
-                triplets;
-        dvec2 b;
-        double w, ww;
-        SurfaceMesh::Vertex v, vv;
-        SurfaceMesh::Edge e;
-        for (i = 0; i < n; ++i) {
-            v = free_vertices[i];
+
+        // cancellation is checked at chunk boundaries of the assembly loop and before the
+        // solve; a canceled run leaves the texture coordinates untouched (except for the
+        // boundary, which has already been mapped)
+        ProgressLogger progress(n, "Harmonic parameterization");
+        bool canceled = false;
+
+        // every row of the system depends only on the 1-ring of its vertex, so the rows are
+        // assembled concurrently: a counting pass sizes the triplet array, then each row
+        // writes its own range
+        std::vector<std::size_t> row_start(n + 1, 0);
+#pragma omp parallel for
+        for (int r = 0; r < static_cast<int>(n); ++r) {
+            std::size_t nnz = 1;    // the diagonal
+            for (auto h : mesh_->halfedges(free_vertices[r])) {
+                if (!mesh_->is_border(mesh_->target(h)))
+                    ++nnz;
+            }
+            row_start[r + 1] = nnz;
+        }
+        for (i = 0; i < n; ++i)
+            row_start[i + 1] += row_start[i];
+        std::vector<Triplet> triplets(row_start[n]);
+
+#pragma omp parallel for schedule(dynamic, 4096)
+        for (int r = 0; r < static_cast<int>(n); ++r) {
+            if ((r & 0xfff) == 0 && progress.is_canceled())
+                canceled = true;    // every writer stores true, so the race is benign
+            if (canceled)
+                continue;
+            const SurfaceMesh::Vertex v = free_vertices[r];
+            std::size_t t = row_start[r];
 
             // rhs row
-            b = dvec2(0.0);
+            dvec2 b(0.0, 0.0);
 
             // lhs row
-            ww = 0.0;
+            double ww = 0.0;
             for (auto h : mesh_->halfedges(v)) {
-                vv = mesh_->target(h);
-                e = mesh_->edge(h);
-                w = eweight[e];
+                const SurfaceMesh::Vertex vv = mesh_->target(h);
+                const double w = eweight[mesh_->edge(h)];
                 ww += w;
 
                 if (mesh_->is_border(vv)) {
                     b -= -w * static_cast<dvec2>(tex[vv]);
                 } else {
-                    triplets.emplace_back(i, idx[vv], -w);
+                    triplets[t++] = Triplet(r, idx[vv], -w);
                 }
             }
-            triplets.emplace_back(i, i, ww);
-            B.row(i) = (Eigen::Vector2d) b;
+            triplets[t] = Triplet(r, r, ww);
+            B.row(r) = (Eigen::Vector2d) b;
         }
 
-        // build sparse matrix from triplets
-        A.setFromTriplets(triplets.begin(), triplets.end());
-
-        // solve A*X = B
-        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(A);
-        Eigen::MatrixXd X = solver.solve(B);
-        if (solver.info() != Eigen::Success) {
-            LOG(ERROR) << "failed solving the linear system.";
+        if (canceled || progress.is_canceled()) {
+            LOG(WARNING) << "harmonic parameterization canceled";
         } else {
-            // copy solution
-            for (i = 0; i < n; ++i) {
-                const auto &tmp = X.row(i);
-                tex[free_vertices[i]] = vec2(tmp(0), tmp(1));
+            // build sparse matrix from triplets
+            A.setFromTriplets(triplets.begin(), triplets.end());
+
+            // solve A*X = B. With the negative cotan weights clamped to zero the system is
+            // symmetric positive definite, so a conjugate gradient with an incomplete
+            // Cholesky preconditioner applies; its matrix-vector products run multi-threaded.
+            // Fall back to the direct solver in the (unexpected) case the iteration fails.
+            Eigen::ConjugateGradient<SparseMatrix, Eigen::Lower | Eigen::Upper,
+                    Eigen::IncompleteCholesky<double>> solver;
+            solver.setTolerance(1e-10);
+            solver.compute(A);
+            Eigen::MatrixXd X = solver.solve(B);
+            bool solved = (solver.info() == Eigen::Success);
+            if (!solved) {
+                const Eigen::SparseMatrix<double> A_col_major(A);
+                Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> direct_solver(A_col_major);
+                X = direct_solver.solve(B);
+                solved = (direct_solver.info() == Eigen::Success);
+            }
+            if (!solved) {
+                LOG(ERROR) << "failed solving the linear system.";
+            } else {
+                // copy solution
+                for (i = 0; i < n; ++i) {
+                    const auto &tmp = X.row(i);
+                    tex[free_vertices[i]] = vec2(tmp(0), tmp(1));
+                }
             }
         }
 
@@ -239,6 +345,19 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshParameterization::lscm() {
+        // a mesh that decomposes into several charts is parameterized chart by chart,
+        // with the charts running concurrently
+        if (details::parameterize_per_component(mesh_, [](SurfaceMesh *chart) {
+                SurfaceMeshParameterization(chart).lscm_chart();
+            }))
+            return;
+
+        lscm_chart();
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void SurfaceMeshParameterization::lscm_chart() {
         // boundary constraints
         if (!setup_lscm_boundary())
             return;
@@ -251,8 +370,15 @@ namespace easy3d {
         auto locked = mesh_->get_vertex_property<bool>("v:locked:SurfaceMeshParameterization");
         assert(locked);
 
-        // compute weights/gradients per face/halfedge
-        for (auto f : mesh_->faces()) {
+        // compute weights/gradients per face/halfedge. Each face writes only the weights of
+        // its own three halfedges, so the faces can be processed concurrently.
+        const int num_faces = static_cast<int>(mesh_->faces_size());
+#pragma omp parallel for
+        for (int fi = 0; fi < num_faces; ++fi) {
+            const SurfaceMesh::Face f(fi);
+            if (mesh_->is_deleted(f))
+                continue;
+
             // collect face halfedge
             auto fh_it = mesh_->halfedges(f);
             auto ha = *fh_it;
@@ -315,20 +441,51 @@ namespace easy3d {
         const unsigned int nv2 = 2 * mesh_->n_vertices();
         const unsigned int nv = mesh_->n_vertices();
         const unsigned int n = free_vertices.size();
-        SurfaceMesh::Vertex vi, vj;
-        SurfaceMesh::Halfedge hh;
-        double si, sj0, sj1, sign;
-        int row(0), c0, c1;
 
-        Eigen::SparseMatrix<double> A(2 * n, 2 * n);
+        SparseMatrix A(2 * n, 2 * n);
         Eigen::VectorXd b = Eigen::VectorXd::Zero(2 * n);
-        std::vector<Eigen::Triplet<double>>
-                triplets;
 
-        for (unsigned int i = 0; i < nv2; ++i) {
-            vi = SurfaceMesh::Vertex(i % nv);
-
-            if (i < nv) {
+        // as in harmonic_chart(): cancellation is checked at chunk boundaries of the assembly
+        // loop and before the solve; a canceled run leaves the texture coordinates untouched
+        ProgressLogger progress(nv2, "LSCM parameterization");
+        bool canceled = false;
+
+        // one row per free vertex and texture coordinate. The rows only read the face
+        // gradients of the 1-ring, so — as in harmonic_chart() — a counting pass sizes the
+        // triplet array and the rows are then assembled concurrently into disjoint ranges.
+        // Since idx[] follows the vertex order, row i < nv maps to idx[vi] and row i >= nv
+        // to idx[vi] + n, which makes the row index independent of the loop order.
+        std::vector<std::size_t> row_start(2 * n + 1, 0);
+#pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(nv2); ++i) {
+            const SurfaceMesh::Vertex vi(i % static_cast<int>(nv));
+            if (locked[vi])
+                continue;
+            std::size_t nnz = 1;    // the diagonal
+            for (auto h : mesh_->halfedges(vi)) {
+                if (!locked[mesh_->target(h)])
+                    nnz += 2;
+            }
+            const int row = idx[vi] + (i < static_cast<int>(nv) ? 0 : n);
+            row_start[row + 1] = nnz;
+        }
+        for (unsigned int r = 0; r < 2 * n; ++r)
+            row_start[r + 1] += row_start[r];
+        std::vector<Triplet> triplets(row_start[2 * n]);
+
+#pragma omp parallel for schedule(dynamic, 4096)
+        for (int i = 0; i < static_cast<int>(nv2); ++i) {
+            if ((i & 0xfff) == 0 && progress.is_canceled())
+                canceled = true;    // every writer stores true, so the race is benign
+            if (canceled)
+                continue;
+            const SurfaceMesh::Vertex vi(i % static_cast<int>(nv));
+            if (locked[vi])
+                continue;
+
+            double sign;
+            int c0, c1;
+            if (i < static_cast<int>(nv)) {
                 sign = 1.0;
                 c0 = 0;
                 c1 = 1;
@@ -338,73 +495,87 @@ namespace easy3d {
                 c1 = 0;
             }
 
-            if (!locked[vi]) {
-                si = 0;
-
-                for (auto h : mesh_->halfedges(vi)) {
-                    vj = mesh_->target(h);
-                    sj0 = sj1 = 0;
-
-                    if (!mesh_->is_border(h)) {
-                        const dvec2 &wj = weight[h];
-                        const dvec2 &wi = weight[mesh_->prev(h)];
-
-                        sj0 += sign * wi[c0] * wj[0] + wi[c1] * wj[1];
-                        sj1 += -sign * wi[c0] * wj[1] + wi[c1] * wj[0];
-                        si += wi[0] * wi[0] + wi[1] * wi[1];
-                    }
-
-                    h = mesh_->opposite(h);
-                    if (!mesh_->is_border(h)) {
-                        const dvec2 &wi = weight[h];
-                        const dvec2 &wj = weight[mesh_->prev(h)];
-
-                        sj0 += sign * wi[c0] * wj[0] + wi[c1] * wj[1];
-                        sj1 += -sign * wi[c0] * wj[1] + wi[c1] * wj[0];
-                        si += wi[0] * wi[0] + wi[1] * wi[1];
-                    }
-
-                    if (!locked[vj]) {
-                        triplets.emplace_back(row, idx[vj], sj0);
-                        triplets.emplace_back(row, idx[vj] + n, sj1);
-                    } else {
-                        b[row] -= sj0 * tex[vj][0];
-                        b[row] -= sj1 * tex[vj][1];
-                    }
+            const int row = idx[vi] + (i < static_cast<int>(nv) ? 0 : n);
+            std::size_t t = row_start[row];
+            double si = 0;
+
+            for (auto h : mesh_->halfedges(vi)) {
+                const SurfaceMesh::Vertex vj = mesh_->target(h);
+                double sj0 = 0, sj1 = 0;
+
+                if (!mesh_->is_border(h)) {
+                    const dvec2 &wj = weight[h];
+                    const dvec2 &wi = weight[mesh_->prev(h)];
+
+                    sj0 += sign * wi[c0] * wj[0] + wi[c1] * wj[1];
+                    sj1 += -sign * wi[c0] * wj[1] + wi[c1] * wj[0];
+                    si += wi[0] * wi[0] + wi[1] * wi[1];
                 }
 
-                triplets.emplace_back(row, idx[vi] + (i < nv ? 0 : n), 0.5 * si);
+                h = mesh_->opposite(h);
+                if (!mesh_->is_border(h)) {
+                    const dvec2 &wi = weight[h];
+                    const dvec2 &wj = weight[mesh_->prev(h)];
 
-                ++row;
+                    sj0 += sign * wi[c0] * wj[0] + wi[c1] * wj[1];
+                    sj1 += -sign * wi[c0] * wj[1] + wi[c1] * wj[0];
+                    si += wi[0] * wi[0] + wi[1] * wi[1];
+                }
+
+                if (!locked[vj]) {
+                    triplets[t++] = Triplet(row, idx[vj], sj0);
+                    triplets[t++] = Triplet(row, idx[vj] + n, sj1);
+                } else {
+                    b[row] -= sj0 * tex[vj][0];
+                    b[row] -= sj1 * tex[vj][1];
+                }
             }
-        }
 
-        // build sparse matrix from triplets
-        A.setFromTriplets(triplets.begin(), triplets.end());
+            triplets[t] = Triplet(row, idx[vi] + (i < static_cast<int>(nv) ? 0 : n), 0.5 * si);
+        }
 
-        // solve A*X = B
-        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(A);
-        Eigen::VectorXd x = solver.solve(b);
-        if (solver.info() != Eigen::Success) {
-            LOG(ERROR) << "failed solving the linear system";
+        if (canceled || progress.is_canceled()) {
+            LOG(WARNING) << "LSCM parameterization canceled";
         } else {
-            // copy solution
-            for (i = 0; i < n; ++i) {
-                tex[free_vertices[i]] = vec2(x[i], x[i + n]);
+            // build sparse matrix from triplets
+            A.setFromTriplets(triplets.begin(), triplets.end());
+
+            // solve A*X = B. The LSCM energy is quadratic and, with the two pinned vertices,
+            // positive definite, so the same preconditioned conjugate gradient as in
+            // harmonic_chart() applies, with the same direct-solver fallback.
+            Eigen::ConjugateGradient<SparseMatrix, Eigen::Lower | Eigen::Upper,
+                    Eigen::IncompleteCholesky<double>> solver;
+            solver.setTolerance(1e-10);
+            solver.compute(A);
+            Eigen::VectorXd x = solver.solve(b);
+            bool solved = (solver.info() == Eigen::Success);
+            if (!solved) {
+                const Eigen::SparseMatrix<double> A_col_major(A);
+                Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> direct_solver(A_col_major);
+                x = direct_solver.solve(b);
+                solved = (direct_solver.info() == Eigen::Success);
+            }
+            if (!solved) {
+                LOG(ERROR) << "failed solving the linear system";
+            } else {
+                // copy solution
+                for (i = 0; i < n; ++i) {
+                    tex[free_vertices[i]] = vec2(x[i], x[i + n]);
+                }
             }
-        }
 
-        // scale tex coordiantes to unit square
-        vec2 bbmin(1, 1), bbmax(0, 0);
-        for (auto v : mesh_->vertices()) {
-            bbmin = comp_min(bbmin, tex[v]);
-            bbmax = comp_max(bbmax, tex[v]);
-        }
-        bbmax -= bbmin;
-        float s = std::max(bbmax[0], bbmax[1]);
-        for (auto v : mesh_->vertices()) {
-            tex[v] -= bbmin;
-            tex[v] /= s;
+            // scale tex coordiantes to unit square
+            vec2 bbmin(1, 1), bbmax(0, 0);
+            for (auto v : mesh_->vertices()) {
+                bbmin = comp_min(bbmin, tex[v]);
+                bbmax = comp_max(bbmax, tex[v]);
+            }
+            bbmax -= bbmin;
+            float s = std::max(bbmax[0], bbmax[1]);
+            for (auto v : mesh_->vertices()) {
+                tex[v] -= bbmin;
+                tex[v] /= s;
+            }
         }
 
         // clean-up
@@ -44,12 +44,19 @@ namespace easy3d {
         SurfaceMeshParameterization(SurfaceMesh *mesh);
 
         //! \brief Compute discrete harmonic parameterization.
+        //! \details If the mesh decomposes into several connected components, each chart is
+        //! parameterized independently of the others (and the charts run concurrently).
         void harmonic(bool use_uniform_weights = false);
 
         //! \brief Compute parameterization based on least squares conformal mapping.
+        //! \details If the mesh decomposes into several connected components, each chart is
+        //! parameterized independently of the others (and the charts run concurrently).
         void lscm();
 
     private:
+        //! single-chart implementations (the public methods dispatch per connected component)
+        void harmonic_chart(bool use_uniform_weights);
+        void lscm_chart();
         //! setup boundary constraints: map surface boundary to unit circle
         bool setup_boundary_constraints();
 
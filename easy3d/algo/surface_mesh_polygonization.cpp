@@ -92,6 +92,21 @@ namespace easy3d {
             }
         }
 
+        // The regions are independent and tracing a boundary loop only reads the mesh, so
+        // the loops of all regions are extracted in parallel. Only the final rebuild - the
+        // builder mutates the mesh - stays serial, and it merely replays the precomputed
+        // vertex lists.
+        std::vector< std::vector<SurfaceMesh::Vertex> > region_vts(starters.size());
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < static_cast<int>(starters.size()); ++i) {
+            if (starters[i] == SurfaceMesh::Halfedge())     // a region without boundary cannot be a polygon
+                continue;
+            const std::vector<SurfaceMesh::Halfedge> &loop = extract_boundary_loop(&model, i, starters[i]);
+            region_vts[i].reserve(loop.size());
+            for (std::size_t j = 0; j < loop.size(); ++j)
+                region_vts[i].push_back(model.target(loop[j]));
+        }
+
         mesh->clear();
         ManifoldBuilder builder(mesh);
         builder.begin_surface();
@@ -99,15 +114,10 @@ namespace easy3d {
         for (auto v : model.vertices())
             builder.add_vertex(model.position(v));
 
-        for (std::size_t i = 0; i < starters.size(); ++i) {
-            const std::vector<SurfaceMesh::Halfedge> &loop = extract_boundary_loop(&model, i, starters[i]);
-
-            std::vector<SurfaceMesh::Vertex> vts;
-            for (std::size_t j = 0; j < loop.size(); ++j) {
-                SurfaceMesh::Vertex v = model.target(loop[j]);
-                vts.push_back(v);
-            }
-            auto f = builder.add_face(vts);
+        for (std::size_t i = 0; i < region_vts.size(); ++i) {
+            if (region_vts[i].empty())
+                continue;
+            auto f = builder.add_face(region_vts[i]);
             if (!f.is_valid()) {
                 LOG_FIRST_N(WARNING, 1) << "failed to add a face to the surface mesh";
                 break;
@@ -27,15 +27,22 @@
 #include <easy3d/algo/surface_mesh_geometry.h>
 #include <easy3d/algo/triangle_mesh_kdtree.h>
 #include <easy3d/util/progress.h>
+#include <easy3d/util/stop_watch.h>
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 namespace easy3d {
 
     SurfaceMeshRemeshing::SurfaceMeshRemeshing(SurfaceMesh *mesh)
-            : mesh_(mesh), refmesh_(nullptr), kd_tree_(nullptr) {
+            : mesh_(mesh), refmesh_(nullptr), kd_tree_(nullptr),
+              stepping_(false), iterations_total_(0), iterations_done_(0) {
         points_ = mesh_->get_vertex_property<vec3>("v:point");
 
         mesh_->update_vertex_normals();
@@ -44,7 +51,9 @@ namespace easy3d {
 
     //-----------------------------------------------------------------------------
 
-    SurfaceMeshRemeshing::~SurfaceMeshRemeshing() = default;
+    SurfaceMeshRemeshing::~SurfaceMeshRemeshing() {
+        remeshing_finish();     // a stepped session may still be open
+    }
 
     //-----------------------------------------------------------------------------
 
@@ -64,15 +73,12 @@ namespace easy3d {
 
         ProgressLogger progress(iterations);
         for (unsigned int i = 0; i < iterations; ++i) {
-            split_long_edges();
-
-            mesh_->update_vertex_normals();
-
-            collapse_short_edges();
-
-            flip_edges();
+            // every finished iteration leaves a valid mesh, so cancellation (or an
+            // exhausted time budget) is honored at iteration boundaries
+            if (progress.is_canceled())
+                break;
 
-            tangential_smoothing(5);
+            remeshing_iteration();
             progress.next();
         }
 
@@ -103,21 +109,114 @@ namespace easy3d {
 
         ProgressLogger progress(iterations);
         for (unsigned int i = 0; i < iterations; ++i) {
-            split_long_edges();
+            // every finished iteration leaves a valid mesh, so cancellation (or an
+            // exhausted time budget) is honored at iteration boundaries
+            if (progress.is_canceled())
+                break;
 
-            mesh_->update_vertex_normals();
+            remeshing_iteration();
+            progress.next();
+        }
+
+        remove_caps();
+
+        postprocessing();
+    }
+
+    //-----------------------------------------------------------------------------
 
-            collapse_short_edges();
+    void SurfaceMeshRemeshing::remeshing_iteration() {
+        split_long_edges();
 
-            flip_edges();
+        mesh_->update_vertex_normals();
 
-            tangential_smoothing(5);
-            progress.next();
+        collapse_short_edges();
+
+        flip_edges();
+
+        tangential_smoothing(5);
+    }
+
+    //-----------------------------------------------------------------------------
+
+    bool SurfaceMeshRemeshing::uniform_remeshing_start(float edge_length,
+                                                       unsigned int iterations,
+                                                       bool use_projection) {
+        if (!mesh_->is_triangle_mesh()) {
+            std::cerr << "Not a triangle mesh!" << std::endl;
+            return false;
         }
 
-        remove_caps();
+        if (stepping_)  // a previous session is still open
+            remeshing_finish();
+
+        uniform_ = true;
+        use_projection_ = use_projection;
+        target_edge_length_ = edge_length;
+
+        preprocessing();
+
+        iterations_total_ = iterations;
+        iterations_done_ = 0;
+        stepping_ = true;
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    bool SurfaceMeshRemeshing::adaptive_remeshing_start(float min_edge_length,
+                                                        float max_edge_length,
+                                                        float approx_error,
+                                                        unsigned int iterations,
+                                                        bool use_projection) {
+        if (!mesh_->is_triangle_mesh()) {
+            std::cerr << "Not a triangle mesh!" << std::endl;
+            return false;
+        }
+
+        if (stepping_)  // a previous session is still open
+            remeshing_finish();
+
+        uniform_ = false;
+        min_edge_length_ = min_edge_length;
+        max_edge_length_ = max_edge_length;
+        approx_error_ = approx_error;
+        use_projection_ = use_projection;
 
+        preprocessing();
+
+        iterations_total_ = iterations;
+        iterations_done_ = 0;
+        stepping_ = true;
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    bool SurfaceMeshRemeshing::step(double budget_ms) {
+        if (!stepping_)
+            return false;
+
+        StopWatch w;
+        while (iterations_done_ < iterations_total_) {
+            remeshing_iteration();
+            ++iterations_done_;
+            if (w.elapsed_seconds() * 1000.0 >= budget_ms && iterations_done_ < iterations_total_)
+                return true;    // out of budget; resume with the next step()
+        }
+
+        remeshing_finish();
+        return false;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void SurfaceMeshRemeshing::remeshing_finish() {
+        if (!stepping_)
+            return;
+        remove_caps();
         postprocessing();
+        stepping_ = false;
     }
 
     //-----------------------------------------------------------------------------
@@ -486,6 +585,13 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshRemeshing::flip_edges() {
+#ifdef _OPENMP
+        if (omp_get_max_threads() > 1) {
+            flip_edges_parallel();
+            return;
+        }
+#endif
+
         SurfaceMesh::Vertex v0, v1, v2, v3;
         SurfaceMesh::Halfedge h;
         int val0, val1, val2, val3;
@@ -571,44 +677,163 @@ namespace easy3d {
 
     //-----------------------------------------------------------------------------
 
-    void SurfaceMeshRemeshing::tangential_smoothing(unsigned int iterations) {
-        SurfaceMesh::Vertex v1, v2, v3, vv;
-        SurfaceMesh::Edge e;
-        float w, ww, area;
-        vec3 u, n, t, b;
+    void SurfaceMeshRemeshing::flip_edges_parallel() {
+        // Flipping an edge only modifies the connectivity of its two incident triangles and the
+        // out-going halfedges of their four vertices. Two candidate flips can therefore be applied
+        // concurrently whenever these vertex quads are disjoint. Each sweep evaluates all edges in
+        // parallel (read-only), greedily extracts an independent set of improving flips (one color
+        // class of the conflict graph), and applies it in parallel.
 
+        // precompute valences
+        SurfaceMesh::VertexProperty<int> valence = mesh_->add_vertex_property<int>("valence");
+        for (auto v : mesh_->vertices()) {
+            valence[v] = mesh_->valence(v);
+        }
+
+        struct Flip {
+            int edge;
+            int v[4]; // the two edge vertices, then the two opposite vertices
+        };
+
+        const int num_edges = static_cast<int>(mesh_->edges_size());
+        std::vector<unsigned char> improves(num_edges, 0);
+        std::vector<unsigned char> vertex_taken(mesh_->vertices_size(), 0);
+        std::vector<Flip> selected;
+
+        for (int sweep = 0; sweep < 100; ++sweep) {
+            // find the edges whose flip would reduce the valence energy
+#pragma omp parallel for
+            for (int idx = 0; idx < num_edges; ++idx) {
+                improves[idx] = 0;
+
+                const SurfaceMesh::Edge e(idx);
+                if (mesh_->is_deleted(e) || elocked_[e] || efeature_[e])
+                    continue;
+
+                SurfaceMesh::Halfedge h = mesh_->halfedge(e, 0);
+                const SurfaceMesh::Vertex v0 = mesh_->target(h);
+                const SurfaceMesh::Vertex v2 = mesh_->target(mesh_->next(h));
+                h = mesh_->halfedge(e, 1);
+                const SurfaceMesh::Vertex v1 = mesh_->target(h);
+                const SurfaceMesh::Vertex v3 = mesh_->target(mesh_->next(h));
+
+                if (vlocked_[v0] || vlocked_[v1] || vlocked_[v2] || vlocked_[v3])
+                    continue;
+
+                const int val_opt0 = (mesh_->is_border(v0) ? 4 : 6);
+                const int val_opt1 = (mesh_->is_border(v1) ? 4 : 6);
+                const int val_opt2 = (mesh_->is_border(v2) ? 4 : 6);
+                const int val_opt3 = (mesh_->is_border(v3) ? 4 : 6);
+
+                int ve0 = (valence[v0] - val_opt0);
+                int ve1 = (valence[v1] - val_opt1);
+                int ve2 = (valence[v2] - val_opt2);
+                int ve3 = (valence[v3] - val_opt3);
+                const int ve_before = ve0 * ve0 + ve1 * ve1 + ve2 * ve2 + ve3 * ve3;
+
+                ve0 = (valence[v0] - 1 - val_opt0);
+                ve1 = (valence[v1] - 1 - val_opt1);
+                ve2 = (valence[v2] + 1 - val_opt2);
+                ve3 = (valence[v3] + 1 - val_opt3);
+                const int ve_after = ve0 * ve0 + ve1 * ve1 + ve2 * ve2 + ve3 * ve3;
+
+                if (ve_before > ve_after && mesh_->is_flip_ok(e))
+                    improves[idx] = 1;
+            }
+
+            // greedily select an independent set: no two flips may share a quad vertex
+            selected.clear();
+            for (int idx = 0; idx < num_edges; ++idx) {
+                if (!improves[idx])
+                    continue;
+
+                const SurfaceMesh::Edge e(idx);
+                Flip flip;
+                flip.edge = idx;
+                SurfaceMesh::Halfedge h = mesh_->halfedge(e, 0);
+                flip.v[0] = mesh_->target(h).idx();
+                flip.v[2] = mesh_->target(mesh_->next(h)).idx();
+                h = mesh_->halfedge(e, 1);
+                flip.v[1] = mesh_->target(h).idx();
+                flip.v[3] = mesh_->target(mesh_->next(h)).idx();
+
+                if (vertex_taken[flip.v[0]] || vertex_taken[flip.v[1]] ||
+                    vertex_taken[flip.v[2]] || vertex_taken[flip.v[3]])
+                    continue;
+
+                vertex_taken[flip.v[0]] = 1;
+                vertex_taken[flip.v[1]] = 1;
+                vertex_taken[flip.v[2]] = 1;
+                vertex_taken[flip.v[3]] = 1;
+                selected.push_back(flip);
+            }
+
+            if (selected.empty())
+                break;
+
+            // the selected flips are pairwise independent: apply them concurrently
+#pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(selected.size()); ++i) {
+                const Flip &flip = selected[i];
+                mesh_->flip(SurfaceMesh::Edge(flip.edge));
+                --valence[SurfaceMesh::Vertex(flip.v[0])];
+                --valence[SurfaceMesh::Vertex(flip.v[1])];
+                ++valence[SurfaceMesh::Vertex(flip.v[2])];
+                ++valence[SurfaceMesh::Vertex(flip.v[3])];
+            }
+
+            for (std::size_t i = 0; i < selected.size(); ++i) {
+                for (int j = 0; j < 4; ++j)
+                    vertex_taken[selected[i].v[j]] = 0;
+            }
+        }
+
+        mesh_->remove_vertex_property(valence);
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void SurfaceMeshRemeshing::tangential_smoothing(unsigned int iterations) {
         // add property
         SurfaceMesh::VertexProperty<vec3> update = mesh_->add_vertex_property<vec3>("v:update", vec3(0, 0, 0));
 
+        const int num_vertices = static_cast<int>(mesh_->vertices_size());
+
         // project at the beginning to get valid sizing values and normal vectors
-        // for vertices introduced by splitting
+        // for vertices introduced by splitting.
+        // each vertex is projected independently (the kd-tree is read-only)
         if (use_projection_) {
-            for (auto v : mesh_->vertices()) {
-                if (!mesh_->is_border(v) && !vlocked_[v]) {
+#pragma omp parallel for
+            for (int idx = 0; idx < num_vertices; ++idx) {
+                const SurfaceMesh::Vertex v(idx);
+                if (!mesh_->is_deleted(v) && !mesh_->is_border(v) && !vlocked_[v]) {
                     project_to_reference(v);
                 }
             }
         }
 
         for (unsigned int iters = 0; iters < iterations; ++iters) {
-            for (auto v : mesh_->vertices()) {
-                if (!mesh_->is_border(v) && !vlocked_[v]) {
+            // the relaxation only reads the current positions and writes per-vertex updates
+#pragma omp parallel for
+            for (int idx = 0; idx < num_vertices; ++idx) {
+                const SurfaceMesh::Vertex v(idx);
+                if (!mesh_->is_deleted(v) && !mesh_->is_border(v) && !vlocked_[v]) {
                     if (vfeature_[v]) {
-                        u = vec3(0.0);
-                        t = vec3(0.0);
-                        ww = 0;
+                        vec3 u(0.0);
+                        vec3 t(0.0);
+                        float ww = 0;
                         int c = 0;
 
                         for (auto h : mesh_->halfedges(v)) {
                             if (efeature_[mesh_->edge(h)]) {
-                                vv = mesh_->target(h);
+                                const SurfaceMesh::Vertex vv = mesh_->target(h);
 
-                                b = points_[v];
+                                vec3 b = points_[v];
                                 b += points_[vv];
                                 b *= 0.5;
 
-                                w = distance(points_[v], points_[vv]) /
-                                    (0.5 * (vsizing_[v] + vsizing_[vv]));
+                                const float w = distance(points_[v], points_[vv]) /
+                                                (0.5 * (vsizing_[v] + vsizing_[vv]));
                                 ww += w;
                                 u += w * b;
 
@@ -632,26 +857,25 @@ namespace easy3d {
                             update[v] = u;
                         }
                     } else {
-                        u = vec3(0.0);
-                        t = vec3(0.0);
-                        ww = 0;
+                        vec3 u(0.0);
+                        float ww = 0;
 
                         for (auto h : mesh_->halfedges(v)) {
-                            v1 = v;
-                            v2 = mesh_->target(h);
-                            v3 = mesh_->target(mesh_->next(h));
+                            const SurfaceMesh::Vertex v1 = v;
+                            const SurfaceMesh::Vertex v2 = mesh_->target(h);
+                            const SurfaceMesh::Vertex v3 = mesh_->target(mesh_->next(h));
 
-                            b = points_[v1];
+                            vec3 b = points_[v1];
                             b += points_[v2];
                             b += points_[v3];
                             b *= (1.0 / 3.0);
 
-                            area = norm(cross(points_[v2] - points_[v1],
-                                              points_[v3] - points_[v1]));
-                            w = area /
-                                pow((vsizing_[v1] + vsizing_[v2] + vsizing_[v3]) /
-                                    3.0,
-                                    2.0);
+                            const float area = norm(cross(points_[v2] - points_[v1],
+                                                          points_[v3] - points_[v1]));
+                            const float w = area /
+                                            pow((vsizing_[v1] + vsizing_[v2] + vsizing_[v3]) /
+                                                3.0,
+                                                2.0);
 
                             u += w * b;
                             ww += w;
@@ -660,7 +884,7 @@ namespace easy3d {
                         if (ww > 0) { // to avoid overflow (i.e., ww == 0)
                             u /= ww;
                             u -= points_[v];
-                            n = vnormal_[v];
+                            const vec3 n = vnormal_[v];
                             u -= n * dot(u, n);
                             update[v] = u;
                         }
@@ -669,8 +893,10 @@ namespace easy3d {
             }
 
             // update vertex positions
-            for (auto v : mesh_->vertices()) {
-                if (!mesh_->is_border(v) && !vlocked_[v]) {
+#pragma omp parallel for
+            for (int idx = 0; idx < num_vertices; ++idx) {
+                const SurfaceMesh::Vertex v(idx);
+                if (!mesh_->is_deleted(v) && !mesh_->is_border(v) && !vlocked_[v]) {
                     points_[v] += update[v];
                 }
             }
@@ -681,8 +907,10 @@ namespace easy3d {
 
         // project at the end
         if (use_projection_) {
-            for (auto v : mesh_->vertices()) {
-                if (!mesh_->is_border(v) && !vlocked_[v]) {
+#pragma omp parallel for
+            for (int idx = 0; idx < num_vertices; ++idx) {
+                const SurfaceMesh::Vertex v(idx);
+                if (!mesh_->is_deleted(v) && !mesh_->is_border(v) && !vlocked_[v]) {
                     project_to_reference(v);
                 }
             }
@@ -40,6 +40,10 @@ namespace easy3d {
      * and tangential relaxation. See the following papers for more details:
      *  - Mario Botsch and Leif Kobbelt. A remeshing approach to multiresolution modeling. SGP, 2004.
      *  - Marion Dunyach et al. Adaptive remeshing for real-time mesh deformation. EG (Short Papers) 2013.
+     *
+     * When built with OpenMP, the tangential relaxation and projection passes run in parallel over the
+     * vertices, and edge flipping is parallelized by repeatedly flipping independent sets of candidate
+     * edges (no two edges of a set share a vertex of their two incident triangles).
      */
     class SurfaceMeshRemeshing {
     public:
@@ -56,13 +60,48 @@ namespace easy3d {
                                 float approx_error, unsigned int iterations = 10,
                                 bool use_projection = true);
 
+        //! \name Resumable execution
+        //! \details For interactive previews, the remeshing can be driven in time slices that are
+        //! interleaved with rendering instead of running to completion: after one of the _start()
+        //! functions, each step() runs whole remeshing iterations until roughly the given budget
+        //! is spent and then yields, leaving the mesh in a valid (renderable) state. All state
+        //! lives in this object, so no threads share mutable mesh data.
+        //@{
+        //! \brief Prepares a resumable uniform remeshing (same parameters as uniform_remeshing()).
+        //!     A session still in progress is finished first.
+        //! \return \c false if the mesh is not a triangle mesh.
+        bool uniform_remeshing_start(float edge_length, unsigned int iterations = 10,
+                                     bool use_projection = true);
+
+        //! \brief Prepares a resumable adaptive remeshing (same parameters as adaptive_remeshing()).
+        //!     A session still in progress is finished first.
+        //! \return \c false if the mesh is not a triangle mesh.
+        bool adaptive_remeshing_start(float min_edge_length, float max_edge_length,
+                                      float approx_error, unsigned int iterations = 10,
+                                      bool use_projection = true);
+
+        //! \brief Runs remeshing iterations (at least one) until roughly \p budget_ms milliseconds
+        //!     are spent, then yields.
+        //! \return \c true while more iterations remain. After the last one the session cleans up
+        //!     automatically and \c false is returned.
+        bool step(double budget_ms);
+
+        //! \brief Finishes a stepped session early, keeping the iterations done so far. Called
+        //!     automatically when step() completes or the object is destructed.
+        void remeshing_finish();
+        //@}
+
     private:
         void preprocessing();
         void postprocessing();
 
+        // one split/collapse/flip/smooth round (the body of the remeshing loop)
+        void remeshing_iteration();
+
         void split_long_edges();
         void collapse_short_edges();
         void flip_edges();
+        void flip_edges_parallel();
         void tangential_smoothing(unsigned int iterations);
 
         void remove_caps();
@@ -86,6 +125,11 @@ namespace easy3d {
         bool use_projection_;
         TriangleMeshKdTree *kd_tree_;
 
+        // the resumable-execution session (see the _start() functions and step())
+        bool stepping_;
+        unsigned int iterations_total_;
+        unsigned int iterations_done_;
+
         bool uniform_;
         float target_edge_length_;
         float min_edge_length_;
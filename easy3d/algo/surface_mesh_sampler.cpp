@@ -23,16 +23,102 @@
  */
 
 #include <easy3d/algo/surface_mesh_sampler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/core/random.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/progress.h>
 
 
 namespace easy3d {
 
+    namespace details {
+
+        // a triangle of the (fan-triangulated) mesh, flattened for sampling
+        struct SampleTriangle {
+            vec3 a, b, c;
+            vec3 normal;
+            float area;
+        };
+
+        // fan-triangulates the faces of the mesh; returns the total surface area
+        float collect_triangles(const SurfaceMesh *mesh, std::vector<SampleTriangle> &triangles) {
+            auto mesh_points = mesh->get_vertex_property<vec3>("v:point");
+            auto mesh_face_normals = mesh->get_face_property<vec3>("f:normal");
+
+            float surface_area = 0.0f;
+            for (auto f : mesh->faces()) {
+                const vec3 &n = mesh_face_normals ? mesh_face_normals[f] : mesh->compute_face_normal(f);
+
+                SurfaceMesh::Halfedge start = mesh->halfedge(f);
+                SurfaceMesh::Halfedge cur = mesh->next(mesh->next(start));
+                SurfaceMesh::Vertex va = mesh->target(start);
+                while (cur != start) {
+                    SampleTriangle tri;
+                    tri.a = mesh_points[va];
+                    tri.b = mesh_points[mesh->source(cur)];
+                    tri.c = mesh_points[mesh->target(cur)];
+                    tri.normal = n;
+                    tri.area = geom::triangle_area(tri.a, tri.b, tri.c);
+                    triangles.push_back(tri);
+                    surface_area += tri.area;
+
+                    cur = mesh->next(cur);
+                }
+            }
+            return surface_area;
+        }
+
+        // generates 'num' area-weighted random samples on the triangles (in parallel, one
+        // random stream per triangle - the result only depends on the seed)
+        void generate_candidates(const std::vector<SampleTriangle> &triangles, float surface_area,
+                                 std::size_t num, uint64_t base_seed,
+                                 std::vector<vec3> &points, std::vector<vec3> &normals) {
+            const std::size_t triangle_num = triangles.size();
+            const float density = num / surface_area;
+
+            // each triangle gets its own slot range (area-proportional, error diffused)
+            std::vector<std::size_t> offsets(triangle_num + 1, 0);
+            float samples_error = 0.0f;
+            for (std::size_t idx = 0; idx < triangle_num; ++idx) {
+                float samples_num = triangles[idx].area * density;
+                std::size_t quant_samples_num = (std::size_t) samples_num;
+                samples_error += samples_num - quant_samples_num;
+                if (samples_error > 1.0) {
+                    samples_error -= 1.0;
+                    quant_samples_num++;
+                }
+                if (idx == triangle_num - 1)
+                    quant_samples_num = (offsets[idx] < num) ? num - offsets[idx] : 0;
+                offsets[idx + 1] = offsets[idx] + quant_samples_num;
+            }
+
+            points.resize(offsets[triangle_num]);
+            normals.resize(offsets[triangle_num]);
 
-    PointCloud *SurfaceMeshSampler::apply(const SurfaceMesh *mesh, int num /* = 1000000 */) {
+#pragma omp parallel for
+            for (int idx = 0; idx < static_cast<int>(triangle_num); ++idx) {
+                const SampleTriangle &tri = triangles[idx];
+                RandomStream rng(base_seed + static_cast<uint64_t>(idx));
+                for (std::size_t j = offsets[idx]; j < offsets[idx + 1]; ++j) {
+                    const float s = std::sqrt(rng.next_float());
+                    const float t = rng.next_float();
+                    points[j] = (1.0f - s) * tri.a + s * (1.0f - t) * tri.b + s * t * tri.c;
+                    normals[j] = tri.normal;
+                }
+            }
+        }
+
+    }
+
+
+    PointCloud *SurfaceMeshSampler::apply(const SurfaceMesh *mesh, int num /* = 1000000 */,
+                                          unsigned int seed /* = 0 */) {
         PointCloud *cloud = new PointCloud;
         const std::string &name = file_system::name_less_extension(mesh->name()) + "_sampled.ply";
         cloud->set_name(name);
@@ -96,14 +182,13 @@ namespace easy3d {
         float density = num_needed / surface_area;
         float samples_error = 0.0;
         std::size_t triangle_num = triangles.size();
-        std::size_t num_generated = 0;
-        std::size_t triangles_done = 0;
-        ProgressLogger progress(triangle_num, "Sampling mesh");
-        for (std::size_t idx = 0; idx < triangle_num; ++idx) {
-            const Triangle &tri = triangles[idx];
-            const vec3 &n = triangle_normals[idx];
 
-            // samples number considering the facet size (i.e., area)
+        // first pass: samples number per triangle considering the facet size (i.e., area),
+        // with the quantization error diffused over the triangles. The resulting exclusive
+        // prefix sum assigns each triangle its own slot range in the output cloud, so the
+        // generation itself can run in parallel.
+        std::vector<std::size_t> offsets(triangle_num + 1, 0);
+        for (std::size_t idx = 0; idx < triangle_num; ++idx) {
             float samples_num = triangle_areas[idx] * density;
             std::size_t quant_samples_num = (std::size_t) samples_num;
 
@@ -114,32 +199,158 @@ namespace easy3d {
                 quant_samples_num++;
             }
 
-            if (triangles_done ==
-                triangle_num - 1)        // override number to gather all remaining points if last facet
-                quant_samples_num = num_needed - num_generated;
+            if (idx == triangle_num - 1)   // override number to gather all remaining points if last facet
+                quant_samples_num = (offsets[idx] < std::size_t(num_needed)) ? num_needed - offsets[idx] : 0;
+
+            offsets[idx + 1] = offsets[idx] + quant_samples_num;
+        }
+
+        // every sample gets its slot, so the cloud is allocated in one go
+        const std::size_t base = cloud->n_vertices();
+        cloud->resize(static_cast<unsigned int>(base + offsets[triangle_num]));
+        auto cloud_points = cloud->get_vertex_property<vec3>("v:point");
+
+        // a non-zero seed makes the sampling reproducible; each triangle derives its own
+        // random stream from the seed, so the result is independent of the thread count
+        const uint64_t base_seed = (seed != 0) ? seed : std::random_device()();
+
+        // second pass: generate the samples, one block of triangles at a time. The blocks
+        // keep the sampling anytime-capable: when canceled, the cloud is truncated to the
+        // completed blocks and the points generated so far form a valid (sparser) sample.
+        const std::size_t block_size = std::max<std::size_t>(4096, triangle_num / 100);
+        std::size_t triangles_done = 0;
+        ProgressLogger progress(triangle_num, "Sampling mesh");
+        while (triangles_done < triangle_num) {
+            if (progress.is_canceled()) {
+                cloud->resize(static_cast<unsigned int>(base + offsets[triangles_done]));
+                break;
+            }
+            const std::size_t block_end = std::min(triangles_done + block_size, triangle_num);
+
+#pragma omp parallel for
+            for (int idx = static_cast<int>(triangles_done); idx < static_cast<int>(block_end); ++idx) {
+                const Triangle &tri = triangles[idx];
+                const vec3 &n = triangle_normals[idx];
+                const vec3 &pa = mesh_points[tri[0]];
+                const vec3 &pb = mesh_points[tri[1]];
+                const vec3 &pc = mesh_points[tri[2]];
+
+                RandomStream rng(base_seed + static_cast<uint64_t>(idx));
+                for (std::size_t j = offsets[idx]; j < offsets[idx + 1]; ++j) {
+                    // compute barycentric coords
+                    const float s = std::sqrt(rng.next_float());
+                    const float t = rng.next_float();
+                    const PointCloud::Vertex v(static_cast<int>(base + j));
+                    cloud_points[v] = (1.0f - s) * pa + s * (1.0f - t) * pb + s * t * pc;
+                    normals[v] = n;
+                }
+            }
+
+            progress.notify(block_end, true, false);
+            triangles_done = block_end;
+        }
+
+        LOG(INFO) << "done. resulted point cloud has " << cloud->n_vertices() << " points";
+        return cloud;
+    }
+
 
-            // generate points
-            for (unsigned int j = 0; j < quant_samples_num; j++) {
-                // compute barycentric coords
-                double s = sqrt((double) rand() / (double) RAND_MAX);
-                double t = (double) rand() / (double) RAND_MAX;
-                double c[3];
+    PointCloud *SurfaceMeshSampler::apply_poisson_disk(const SurfaceMesh *mesh, float min_distance,
+                                                       unsigned int seed /* = 0 */) {
+        if (min_distance <= 0.0f) {
+            LOG(ERROR) << "minimum distance must be positive (provided value: " << min_distance << ")";
+            return nullptr;
+        }
+
+        std::vector<details::SampleTriangle> triangles;
+        const float surface_area = details::collect_triangles(mesh, triangles);
+        if (triangles.empty() || surface_area <= 0.0f) {
+            LOG(WARNING) << "mesh has no valid surface to sample";
+            return nullptr;
+        }
+
+        LOG(INFO) << "Poisson-disk sampling surface...";
+
+        // a hexagonal packing with spacing r holds 2A / (sqrt(3) r^2) points; dart throwing
+        // reaches a good fraction of that, and ~4 candidates per potential sample saturate it
+        const double r2 = double(min_distance) * double(min_distance);
+        const std::size_t max_samples = static_cast<std::size_t>(2.0 * surface_area / (std::sqrt(3.0) * r2)) + 1;
+        const std::size_t candidate_num = std::max<std::size_t>(1024, max_samples * 4);
+
+        const uint64_t base_seed = (seed != 0) ? seed : std::random_device()();
+        std::vector<vec3> candidates, candidate_normals;
+        details::generate_candidates(triangles, surface_area, candidate_num, base_seed,
+                                     candidates, candidate_normals);
+
+        // uniform grid over the accepted samples: a conflict check visits only the 27 cells
+        // around a candidate. Cells are hashed, so the grid needs no bounding volume.
+        const float cell_size = min_distance;
+        std::unordered_map<uint64_t, std::vector<unsigned int> > grid;
+        std::vector<vec3> accepted, accepted_normals;
+        accepted.reserve(max_samples);
+        accepted_normals.reserve(max_samples);
 
-                c[0] = 1.0 - s;
-                c[1] = s * (1.0 - t);
-                c[2] = s * t;
+        auto cell_key = [cell_size](const vec3 &p, int dx, int dy, int dz) -> uint64_t {
+            const int64_t x = static_cast<int64_t>(std::floor(p.x / cell_size)) + dx;
+            const int64_t y = static_cast<int64_t>(std::floor(p.y / cell_size)) + dy;
+            const int64_t z = static_cast<int64_t>(std::floor(p.z / cell_size)) + dz;
+            // hash collisions only add far-away samples to a bucket; the distance test rejects them
+            return static_cast<uint64_t>(x * 73856093) ^ static_cast<uint64_t>(y * 19349669) ^
+                   static_cast<uint64_t>(z * 83492791);
+        };
+        auto has_conflict = [&](const vec3 &p) -> bool {
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dz = -1; dz <= 1; ++dz) {
+                        auto pos = grid.find(cell_key(p, dx, dy, dz));
+                        if (pos == grid.end())
+                            continue;
+                        for (auto idx : pos->second) {
+                            if (distance2(p, accepted[idx]) < r2)
+                                return true;
+                        }
+                    }
+                }
+            }
+            return false;
+        };
+
+        // dart throwing, batch by batch: the conflict checks of a batch run in parallel against
+        // the samples accepted so far; the few surviving candidates are then accepted serially
+        // (re-checked, as they may conflict with an earlier survivor of the same batch). The
+        // accepted set only depends on the candidate order, so the result is independent of the
+        // thread count.
+        const std::size_t batch_size = 4096;
+        std::vector<char> conflicts(batch_size);
+        ProgressLogger progress(candidates.size(), "Poisson-disk sampling");
+        for (std::size_t batch_start = 0; batch_start < candidates.size(); batch_start += batch_size) {
+            // anytime-capable: the samples accepted so far form a valid Poisson-disk set
+            if (progress.is_canceled())
+                break;
+            const std::size_t batch_end = std::min(batch_start + batch_size, candidates.size());
 
-                vec3 p;
-                for (std::size_t i = 0; i < 3; i++)
-                    p = p + c[i] * mesh_points[tri[i]];
+#pragma omp parallel for
+            for (int k = static_cast<int>(batch_start); k < static_cast<int>(batch_end); ++k)
+                conflicts[k - batch_start] = has_conflict(candidates[k]) ? 1 : 0;
 
-                PointCloud::Vertex v = cloud->add_vertex(p);
-                normals[v] = n;
+            for (std::size_t k = batch_start; k < batch_end; ++k) {
+                if (conflicts[k - batch_start] || has_conflict(candidates[k]))
+                    continue;
+                const unsigned int idx = static_cast<unsigned int>(accepted.size());
+                accepted.push_back(candidates[k]);
+                accepted_normals.push_back(candidate_normals[k]);
+                grid[cell_key(candidates[k], 0, 0, 0)].push_back(idx);
             }
 
-            num_generated += quant_samples_num;
-            triangles_done++;
-            progress.next();
+            progress.notify(batch_end, true, false);
+        }
+
+        PointCloud *cloud = new PointCloud;
+        cloud->set_name(file_system::name_less_extension(mesh->name()) + "_poisson.ply");
+        auto normals = cloud->add_vertex_property<vec3>("v:normal");
+        for (std::size_t i = 0; i < accepted.size(); ++i) {
+            PointCloud::Vertex v = cloud->add_vertex(accepted[i]);
+            normals[v] = accepted_normals[i];
         }
 
         LOG(INFO) << "done. resulted point cloud has " << cloud->n_vertices() << " points";
@@ -36,7 +36,25 @@ namespace easy3d {
     class SurfaceMeshSampler {
     public:
         /// @param num The expected point number, much be greater than the number of vertices of the surface mesh.
-        PointCloud *apply(const SurfaceMesh *mesh, int num = 1000000);
+        /// @param seed Seed of the random sampling. A non-zero seed makes the sampling deterministic: the same
+        ///     mesh, \p num, and seed always produce the same point cloud, independent of the number of threads.
+        ///     With the default seed 0, every run produces a different sampling.
+        PointCloud *apply(const SurfaceMesh *mesh, int num = 1000000, unsigned int seed = 0);
+
+        /**
+         * \brief Poisson-disk (blue noise) sampling of the surface.
+         * \details No two samples are closer than \p min_distance, which gives the well-distributed
+         *      point sets needed for point-based rendering proxies. The sampling throws darts from a
+         *      dense area-weighted candidate set and rejects candidates that conflict with an already
+         *      accepted sample; a uniform grid over the accepted samples makes each conflict check a
+         *      constant-size neighborhood query, and the checks of a batch of candidates run in
+         *      parallel. This replaces the much more expensive route of post-filtering a dense
+         *      uniform sampling with point cloud simplification.
+         * @param min_distance The minimum distance between any two samples. Determines the number of
+         *      generated samples (the denser packing the smaller the distance).
+         * @param seed Seed of the random sampling, with the same semantics as in apply().
+         */
+        PointCloud *apply_poisson_disk(const SurfaceMesh *mesh, float min_distance, unsigned int seed = 0);
     };
 
 } // namespace easy3d
@@ -0,0 +1,456 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/algo/surface_mesh_section.h>
+#include <easy3d/algo/tessellator.h>
+#include <easy3d/util/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+
+namespace easy3d {
+
+    // \cond
+    namespace details {
+
+        // a node of the interval tree over the face spans: the faces whose span contains the
+        // node's center, sorted by both span ends for one-sided reporting
+        struct SectionTreeNode {
+            SectionTreeNode() : center(0.0f), left(-1), right(-1) {}
+            float center;
+            int left, right;                // children indices, -1 if none
+            std::vector<int> by_lo;         // faces sorted by ascending span minimum
+            std::vector<int> by_hi;         // the same faces sorted by descending span maximum
+        };
+
+        // everything the section computation keeps between frames, cached on the mesh and valid
+        // as long as the mesh's structural version has not changed
+        struct SectionCache {
+            SectionCache()
+                    : mesh_version(0), direction_valid(false), root(-1), lo_pos(0), hi_pos(0),
+                      num_inactive(0), has_offset(false), offset(0.0f), has_result(false),
+                      result_version(0) {}
+
+            std::size_t mesh_version;       // SurfaceMesh::structural_version() of the spans
+
+            // ---- per sweep-direction structures (rebuilt when the plane rotates) ----
+            bool direction_valid;
+            vec3 normal;                    // the unit sweep direction the spans refer to
+            std::vector<float> lo, hi;      // span of each face along the normal (indexed by face)
+            std::vector<details::SectionTreeNode> nodes;    // the interval tree
+            int root;
+            std::vector<int> faces_by_lo;   // faces sorted by span minimum
+            std::vector<int> faces_by_hi;   // faces sorted by span maximum
+
+            // ---- the set of faces crossing the plane, maintained across frames ----
+            std::size_t lo_pos;             // number of faces with span minimum <= offset
+            std::size_t hi_pos;             // number of faces with span maximum < offset
+            std::vector<char> active;       // whether a face is in the crossing set
+            std::vector<char> in_list;      // whether a face has an entry in 'crossing'
+            std::vector<int> crossing;      // the crossing faces (with lazily deleted entries)
+            std::size_t num_inactive;       // lazily deleted entries in 'crossing'
+            bool has_offset;
+            float offset;
+
+            // ---- the results for the current plane ----
+            bool has_result;
+            vec4 result_plane;              // the (normalized) plane the results belong to
+            std::vector< std::vector<vec3> > contours;
+            std::vector<char> closed;       // whether each contour is a closed loop
+            std::vector<vec3> cap;
+            std::size_t result_version;
+        };
+
+
+        // recursively builds the interval tree over the given faces (indices into lo/hi)
+        static int build_section_tree(SectionCache &cache, std::vector<int> &faces) {
+            if (faces.empty())
+                return -1;
+
+            // center the node at the median of the span midpoints, so the tree stays balanced
+            std::vector<float> mids(faces.size());
+            for (std::size_t i = 0; i < faces.size(); ++i)
+                mids[i] = (cache.lo[faces[i]] + cache.hi[faces[i]]) * 0.5f;
+            std::nth_element(mids.begin(), mids.begin() + mids.size() / 2, mids.end());
+            const float center = mids[mids.size() / 2];
+
+            const int index = static_cast<int>(cache.nodes.size());
+            cache.nodes.push_back(SectionTreeNode());
+            cache.nodes[index].center = center;
+
+            std::vector<int> left_faces, right_faces, mid_faces;
+            for (auto f : faces) {
+                if (cache.hi[f] < center)
+                    left_faces.push_back(f);
+                else if (cache.lo[f] > center)
+                    right_faces.push_back(f);
+                else
+                    mid_faces.push_back(f);
+            }
+            faces.clear();  // release the memory before recursing
+
+            std::vector<int> &by_lo = cache.nodes[index].by_lo;
+            std::vector<int> &by_hi = cache.nodes[index].by_hi;
+            by_lo = mid_faces;
+            std::sort(by_lo.begin(), by_lo.end(),
+                      [&cache](int a, int b) { return cache.lo[a] < cache.lo[b]; });
+            by_hi.swap(mid_faces);
+            std::sort(by_hi.begin(), by_hi.end(),
+                      [&cache](int a, int b) { return cache.hi[a] > cache.hi[b]; });
+
+            const int left = build_section_tree(cache, left_faces);
+            const int right = build_section_tree(cache, right_faces);
+            cache.nodes[index].left = left;
+            cache.nodes[index].right = right;
+            return index;
+        }
+
+
+        // reports all faces whose span contains the offset (the classic stabbing query)
+        static void stab_section_tree(const SectionCache &cache, int node, float offset,
+                                      std::vector<int> &result) {
+            if (node < 0)
+                return;
+            const SectionTreeNode &n = cache.nodes[node];
+            if (offset < n.center) {
+                for (auto f : n.by_lo) {
+                    if (cache.lo[f] > offset)
+                        break;
+                    result.push_back(f);
+                }
+                stab_section_tree(cache, n.left, offset, result);
+            } else {
+                for (auto f : n.by_hi) {
+                    if (cache.hi[f] < offset)
+                        break;
+                    result.push_back(f);
+                }
+                if (offset > n.center)
+                    stab_section_tree(cache, n.right, offset, result);
+            }
+        }
+
+    }
+    // \endcond
+
+
+    SurfaceMeshSection::SurfaceMeshSection(SurfaceMesh *mesh) : mesh_(mesh) {
+    }
+
+
+    void SurfaceMeshSection::update(const Plane3 &plane) {
+        auto prop = mesh_->model_property<details::SectionCache>("SurfaceMeshSection:cache");
+        details::SectionCache &cache = prop[0];
+
+        const float length = norm(plane.normal());
+        if (length < std::numeric_limits<float>::min()) {
+            LOG_FIRST_N(ERROR, 1) << "degenerate section plane (zero normal)";
+            return;
+        }
+        const vec3 n = plane.normal() / length;
+        const float offset = -plane.d() / length;   // the plane position along its unit normal
+        const vec4 plane_key(n, -offset);
+        if (cache.has_result && cache.result_plane == plane_key &&
+            cache.mesh_version == mesh_->structural_version())
+            return;
+
+        // ---- rebuild the per-direction structures if the mesh or the sweep direction changed ----
+        if (cache.mesh_version != mesh_->structural_version() || !cache.direction_valid ||
+            dot(cache.normal, n) < 1.0f - 1e-6f)
+        {
+            cache.mesh_version = mesh_->structural_version();
+            cache.normal = n;
+
+            const std::size_t num = mesh_->faces_size();
+            cache.lo.assign(num, 1.0f);
+            cache.hi.assign(num, -1.0f);    // deleted faces keep an empty span (lo > hi)
+            std::vector<int> faces;
+            faces.reserve(mesh_->n_faces());
+            for (auto f : mesh_->faces()) {
+                float lo = std::numeric_limits<float>::max();
+                float hi = -std::numeric_limits<float>::max();
+                for (auto v : mesh_->vertices(f)) {
+                    const float s = dot(n, mesh_->position(v));
+                    lo = std::min(lo, s);
+                    hi = std::max(hi, s);
+                }
+                cache.lo[f.idx()] = lo;
+                cache.hi[f.idx()] = hi;
+                faces.push_back(f.idx());
+            }
+
+            cache.faces_by_lo = faces;
+            std::sort(cache.faces_by_lo.begin(), cache.faces_by_lo.end(),
+                      [&cache](int a, int b) { return cache.lo[a] < cache.lo[b]; });
+            cache.faces_by_hi = faces;
+            std::sort(cache.faces_by_hi.begin(), cache.faces_by_hi.end(),
+                      [&cache](int a, int b) { return cache.hi[a] < cache.hi[b]; });
+
+            cache.nodes.clear();
+            cache.root = details::build_section_tree(cache, faces);
+
+            cache.active.assign(num, 0);
+            cache.in_list.assign(num, 0);
+            cache.crossing.clear();
+            cache.num_inactive = 0;
+            cache.has_offset = false;
+            cache.direction_valid = true;
+        }
+
+        // ---- bring the crossing set to the new offset ----
+        const std::vector<int> &by_lo = cache.faces_by_lo;
+        const std::vector<int> &by_hi = cache.faces_by_hi;
+        const std::size_t new_lo_pos = std::upper_bound(by_lo.begin(), by_lo.end(), offset,
+                [&cache](float q, int f) { return q < cache.lo[f]; }) - by_lo.begin();
+        const std::size_t new_hi_pos = std::lower_bound(by_hi.begin(), by_hi.end(), offset,
+                [&cache](int f, float q) { return cache.hi[f] < q; }) - by_hi.begin();
+
+        const std::size_t walk_cost =
+                (new_lo_pos > cache.lo_pos ? new_lo_pos - cache.lo_pos : cache.lo_pos - new_lo_pos) +
+                (new_hi_pos > cache.hi_pos ? new_hi_pos - cache.hi_pos : cache.hi_pos - new_hi_pos);
+
+        if (!cache.has_offset || walk_cost > cache.crossing.size() + 1024) {
+            // first query, or the plane jumped: a fresh stabbing query beats walking the endpoints
+            for (auto f : cache.crossing) {
+                cache.active[f] = 0;
+                cache.in_list[f] = 0;
+            }
+            cache.crossing.clear();
+            cache.num_inactive = 0;
+            details::stab_section_tree(cache, cache.root, offset, cache.crossing);
+            for (auto f : cache.crossing) {
+                cache.active[f] = 1;
+                cache.in_list[f] = 1;
+            }
+        }
+        else if (offset >= cache.offset) {
+            // sweeping forward: faces whose span begins before the new offset enter the set,
+            // faces whose span ends before it leave it
+            for (std::size_t i = cache.lo_pos; i < new_lo_pos; ++i) {
+                const int f = by_lo[i];
+                if (cache.hi[f] >= offset && !cache.active[f]) {
+                    cache.active[f] = 1;
+                    if (!cache.in_list[f]) {    // a stale, lazily deleted entry may still exist
+                        cache.in_list[f] = 1;
+                        cache.crossing.push_back(f);
+                    } else
+                        --cache.num_inactive;
+                }
+            }
+            for (std::size_t i = cache.hi_pos; i < new_hi_pos; ++i) {
+                const int f = by_hi[i];
+                if (cache.active[f]) {
+                    cache.active[f] = 0;
+                    ++cache.num_inactive;
+                }
+            }
+        }
+        else {
+            // sweeping backward: the mirrored update
+            for (std::size_t i = cache.hi_pos; i > new_hi_pos; --i) {
+                const int f = by_hi[i - 1];
+                if (cache.lo[f] <= offset && !cache.active[f]) {
+                    cache.active[f] = 1;
+                    if (!cache.in_list[f]) {    // a stale, lazily deleted entry may still exist
+                        cache.in_list[f] = 1;
+                        cache.crossing.push_back(f);
+                    } else
+                        --cache.num_inactive;
+                }
+            }
+            for (std::size_t i = cache.lo_pos; i > new_lo_pos; --i) {
+                const int f = by_lo[i - 1];
+                if (cache.active[f]) {
+                    cache.active[f] = 0;
+                    ++cache.num_inactive;
+                }
+            }
+        }
+        cache.lo_pos = new_lo_pos;
+        cache.hi_pos = new_hi_pos;
+        cache.has_offset = true;
+        cache.offset = offset;
+
+        // compact the lazily deleted entries once they dominate
+        if (cache.num_inactive > cache.crossing.size() / 2) {
+            std::vector<int> alive;
+            alive.reserve(cache.crossing.size() - cache.num_inactive);
+            for (auto f : cache.crossing) {
+                if (cache.active[f])
+                    alive.push_back(f);
+                else
+                    cache.in_list[f] = 0;
+            }
+            cache.crossing.swap(alive);
+            cache.num_inactive = 0;
+        }
+
+        // ---- intersect the crossing faces with the plane and chain the contours ----
+
+        // a face contributes segments between its edges that cross the plane; keying the segment
+        // ends by the mesh edge makes chaining across neighboring faces exact (no point welding)
+        struct Segment {
+            int e0, e1;
+            vec3 p0, p1;
+            bool used;
+        };
+        std::vector<Segment> segments;
+        segments.reserve(cache.crossing.size() - cache.num_inactive);
+        std::unordered_map<int, std::vector<int> > edge_segments;   // edge -> incident segments
+
+        std::vector<std::pair<int, vec3> > points;  // the crossing points of one face, in order
+        for (auto fidx : cache.crossing) {
+            if (!cache.active[fidx])
+                continue;
+            points.clear();
+            for (auto h : mesh_->halfedges(SurfaceMesh::Face(fidx))) {
+                const vec3 &pa = mesh_->position(mesh_->source(h));
+                const vec3 &pb = mesh_->position(mesh_->target(h));
+                const float sa = dot(n, pa) - offset;
+                const float sb = dot(n, pb) - offset;
+                if ((sa < 0.0f) == (sb < 0.0f))
+                    continue;
+                const float t = sa / (sa - sb);
+                points.push_back(std::make_pair(mesh_->edge(h).idx(), pa + t * (pb - pa)));
+            }
+            // pairs of consecutive crossing points bound the inside of the face (a triangle has
+            // exactly one pair; larger faces may contribute several)
+            for (std::size_t i = 0; i + 1 < points.size(); i += 2) {
+                const Segment s = {points[i].first, points[i + 1].first,
+                                   points[i].second, points[i + 1].second, false};
+                if (s.e0 == s.e1)
+                    continue;   // the plane grazed a vertex
+                const int index = static_cast<int>(segments.size());
+                segments.push_back(s);
+                edge_segments[s.e0].push_back(index);
+                edge_segments[s.e1].push_back(index);
+            }
+        }
+
+        cache.contours.clear();
+        cache.closed.clear();
+        for (std::size_t i = 0; i < segments.size(); ++i) {
+            if (segments[i].used)
+                continue;
+            segments[i].used = true;
+
+            std::vector<vec3> contour;
+            contour.push_back(segments[i].p0);
+            contour.push_back(segments[i].p1);
+            const int first_edge = segments[i].e0;
+            bool is_closed = false;
+
+            // grow the chain forward; if it ends on a border, grow it backward, too
+            for (int direction = 0; direction < 2; ++direction) {
+                int edge = (direction == 0) ? segments[i].e1 : first_edge;
+                for (;;) {
+                    const auto pos = edge_segments.find(edge);
+                    int next = -1;
+                    if (pos != edge_segments.end()) {
+                        for (auto si : pos->second) {
+                            if (!segments[si].used) {
+                                next = si;
+                                break;
+                            }
+                        }
+                    }
+                    if (next < 0)
+                        break;
+                    segments[next].used = true;
+                    edge = (segments[next].e0 == edge) ? segments[next].e1 : segments[next].e0;
+                    const vec3 &p = (edge == segments[next].e0) ? segments[next].p0 : segments[next].p1;
+                    if (direction == 0)
+                        contour.push_back(p);
+                    else
+                        contour.insert(contour.begin(), p);
+                    if (direction == 0 && edge == first_edge) {
+                        is_closed = true;
+                        contour.pop_back();     // the closing point duplicates the first one
+                        break;
+                    }
+                }
+                if (is_closed)
+                    break;
+            }
+
+            cache.contours.push_back(contour);
+            cache.closed.push_back(is_closed ? 1 : 0);
+        }
+
+        // ---- triangulate the closed contours into the cap ----
+        cache.cap.clear();
+        bool has_closed = false;
+        for (auto c : cache.closed)
+            has_closed |= (c != 0);
+        if (has_closed) {
+            // the odd winding rule caps nested contours correctly (holes stay open)
+            Tessellator tess;
+            tess.set_winding_rule(Tessellator::WINDING_ODD);
+            tess.begin_polygon(n);
+            for (std::size_t i = 0; i < cache.contours.size(); ++i) {
+                if (!cache.closed[i])
+                    continue;
+                tess.begin_contour();
+                for (const auto &p : cache.contours[i])
+                    tess.add_vertex(p);
+                tess.end_contour();
+            }
+            tess.end_polygon();
+
+            const auto &vertices = tess.vertices();
+            for (const auto &triangle : tess.elements()) {
+                for (auto id : triangle) {
+                    const Tessellator::Vertex *v = vertices[id];
+                    cache.cap.push_back(vec3(static_cast<float>((*v)[0]),
+                                             static_cast<float>((*v)[1]),
+                                             static_cast<float>((*v)[2])));
+                }
+            }
+        }
+
+        cache.has_result = true;
+        cache.result_plane = plane_key;
+        ++cache.result_version;
+    }
+
+
+    const std::vector< std::vector<vec3> > &SurfaceMeshSection::contours(const Plane3 &plane) {
+        update(plane);
+        return mesh_->model_property<details::SectionCache>("SurfaceMeshSection:cache")[0].contours;
+    }
+
+
+    const std::vector<vec3> &SurfaceMeshSection::cap_triangles(const Plane3 &plane) {
+        update(plane);
+        return mesh_->model_property<details::SectionCache>("SurfaceMeshSection:cache")[0].cap;
+    }
+
+
+    std::size_t SurfaceMeshSection::version() const {
+        return mesh_->model_property<details::SectionCache>("SurfaceMeshSection:cache")[0].result_version;
+    }
+
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_ALGO_SURFACE_MESH_SECTION_H
+#define EASY3D_ALGO_SURFACE_MESH_SECTION_H
+
+#include <easy3d/core/surface_mesh.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Plane-mesh intersection, producing the contours and the cap polygons of a cross
+     *      section.
+     * \class SurfaceMeshSection easy3d/algo/surface_mesh_section.h
+     *
+     * \details Clipping a solid part with a plane leaves a hollow shell; the cap polygons close
+     *      the section, so the part looks solid again. Since a section plane is typically dragged
+     *      interactively, the computation is organized around two caches that live on the mesh
+     *      (in a model property, like the one of SurfaceMeshTopology):
+     *        - For the current sweep direction, the span of every face along the plane normal is
+     *          precomputed and organized in an interval tree, so the faces crossing the plane at
+     *          any offset are found in O(log n + k) instead of scanning all faces.
+     *        - While the plane sweeps along its normal (the common drag), the set of crossing
+     *          faces is updated incrementally from the previous frame through the sorted span
+     *          endpoints, so the per-frame cost is proportional to the motion, not to the mesh.
+     *      Only rotating the plane (or structurally editing the mesh) rebuilds the tree.
+     *
+     *      The contours are chained from the face-plane intersection segments; closed contours
+     *      are triangulated into the cap with the odd winding rule, so nested contours (holes)
+     *      are handled. The class itself is cheap to construct: all state is in the cache.
+     */
+    class SurfaceMeshSection {
+    public:
+        explicit SurfaceMeshSection(SurfaceMesh *mesh);
+
+        /**
+         * \brief The intersection contours of the plane with the mesh.
+         * \details Each contour is a sequence of points on the plane; contours of closed surface
+         *      regions are closed (last point connects to the first), contours ending on mesh
+         *      borders are open polylines. The result is cached and only recomputed when the
+         *      plane or the mesh changed.
+         */
+        const std::vector< std::vector<vec3> > &contours(const Plane3 &plane);
+
+        /**
+         * \brief The cap of the cross section: the closed contours triangulated into a flat
+         *      polygon on the plane.
+         * \return The triangles as a flat list of points (three consecutive points per triangle).
+         */
+        const std::vector<vec3> &cap_triangles(const Plane3 &plane);
+
+        /// A counter that increases whenever the cached section changes, so a renderer can skip
+        /// re-uploading buffers while the plane stands still.
+        std::size_t version() const;
+
+    private:
+        // brings the cached section up to date with the plane
+        void update(const Plane3 &plane);
+
+        SurfaceMesh *mesh_;
+    };
+
+}
+
+#endif  // EASY3D_ALGO_SURFACE_MESH_SECTION_H
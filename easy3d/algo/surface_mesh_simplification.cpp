@@ -24,14 +24,19 @@
 
 #include <easy3d/algo/surface_mesh_simplification.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <iterator> // for back_inserter on Windows
 
+#include <easy3d/util/progress.h>
+#include <easy3d/util/stop_watch.h>
+
 
 namespace easy3d {
 
     SurfaceMeshSimplification::SurfaceMeshSimplification(SurfaceMesh *mesh)
-            : mesh_(mesh), initialized_(false), queue_(nullptr) {
+            : mesh_(mesh), initialized_(false), queue_(nullptr),
+              stepping_(false), nv_(0), target_nv_(0) {
         aspect_ratio_ = 0;
         edge_length_ = 0;
         max_valence_ = 0;
@@ -52,6 +57,8 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
     SurfaceMeshSimplification::~SurfaceMeshSimplification() {
+        simplify_finish();  // a stepped session may still be open
+
         // remove added properties
         mesh_->remove_vertex_property(vquadric_);
         mesh_->remove_face_property(normal_cone_);
@@ -152,10 +159,28 @@ namespace easy3d {
         unsigned int nv(mesh_->n_vertices());
 
         std::vector<SurfaceMesh::Vertex> one_ring;
-        std::vector<SurfaceMesh::Vertex>::iterator or_it, or_end;
-        SurfaceMesh::Halfedge h;
-        SurfaceMesh::Vertex v;
 
+        setup_queue();
+
+        // simplification is anytime-capable: when canceled (or out of time budget), stop
+        // collapsing and keep the partially simplified mesh
+        ProgressLogger progress(nv > n_vertices ? nv - n_vertices : 0, "Simplifying mesh");
+
+        while (nv > n_vertices && !queue_->empty()) {
+            if (progress.is_canceled())
+                break;
+            progress.next(false);
+
+            if (collapse_one(one_ring))
+                --nv;
+            //if (nv % 1000 == 0) std::cerr << nv << "\r";
+        }
+
+        teardown_queue();
+    }
+
+
+    void SurfaceMeshSimplification::setup_queue() {
         // add properties for priority queue
         vpriority_ = mesh_->add_vertex_property<float>("v:prio");
         heap_pos_ = mesh_->add_vertex_property<int>("v:heap");
@@ -165,53 +190,273 @@ namespace easy3d {
         HeapInterface hi(vpriority_, heap_pos_);
         queue_ = new PriorityQueue(hi);
         queue_->reserve(mesh_->n_vertices());
+        // defer the sifting during the initial build: the queue is then built in a
+        // single linear-time pass instead of one sift per vertex
+        queue_->set_deferred_updates(true);
         for (auto v : mesh_->vertices()) {
             queue_->reset_heap_position(v);
             enqueue_vertex(v);
         }
+        queue_->set_deferred_updates(false);
+    }
 
-        while (nv > n_vertices && !queue_->empty()) {
-            // get 1st element
-            v = queue_->front();
-            queue_->pop_front();
-            h = vtarget_[v];
-            CollapseData cd(mesh_, h);
 
-            // check this (again)
-            if (!mesh_->is_collapse_ok(h))
-                continue;
+    void SurfaceMeshSimplification::teardown_queue() {
+        delete queue_;
+        queue_ = nullptr;
+        mesh_->collect_garbage();
+        mesh_->remove_vertex_property(vpriority_);
+        mesh_->remove_vertex_property(heap_pos_);
+        mesh_->remove_vertex_property(vtarget_);
+    }
+
+
+    bool SurfaceMeshSimplification::collapse_one(std::vector<SurfaceMesh::Vertex> &one_ring) {
+        // get 1st element
+        auto v = queue_->front();
+        queue_->pop_front();
+        auto h = vtarget_[v];
+        CollapseData cd(mesh_, h);
+
+        // check this (again)
+        if (!mesh_->is_collapse_ok(h))
+            return false;
+
+        // store one-ring
+        one_ring.clear();
+        for (auto vv : mesh_->vertices(cd.v0)) {
+            one_ring.push_back(vv);
+        }
+
+        // perform collapse
+        mesh_->collapse(h);
+
+        // postprocessing, e.g., update quadrics
+        postprocess_collapse(cd);
+
+        // update queue
+        for (auto vv : one_ring)
+            enqueue_vertex(vv);
+
+        return true;
+    }
+
+
+    bool SurfaceMeshSimplification::simplify_start(unsigned int n_vertices) {
+        if (!mesh_->is_triangle_mesh()) {
+            std::cerr << "Not a triangle mesh!" << std::endl;
+            return false;
+        }
+
+        if (stepping_)  // a previous session is still open
+            simplify_finish();
+
+        // make sure the decimater is initialized
+        if (!initialized_)
+            initialize();
+
+        nv_ = mesh_->n_vertices();
+        target_nv_ = n_vertices;
+        setup_queue();
+        stepping_ = true;
+        return true;
+    }
+
+
+    bool SurfaceMeshSimplification::step(double budget_ms) {
+        if (!stepping_)
+            return false;
+
+        StopWatch w;
+        std::vector<SurfaceMesh::Vertex> one_ring;
+        while (nv_ > target_nv_ && !queue_->empty()) {
+            if (collapse_one(one_ring))
+                --nv_;
+            if (w.elapsed_seconds() * 1000.0 >= budget_ms && nv_ > target_nv_ && !queue_->empty())
+                return true;    // out of budget; resume with the next step()
+        }
+
+        simplify_finish();
+        return false;
+    }
+
+
+    void SurfaceMeshSimplification::simplify_finish() {
+        if (!stepping_)
+            return;
+        teardown_queue();
+        stepping_ = false;
+    }
+
+    //-----------------------------------------------------------------------------
+
+    void SurfaceMeshSimplification::simplify_parallel(unsigned int n_vertices) {
+        if (!mesh_->is_triangle_mesh()) {
+            std::cerr << "Not a triangle mesh!" << std::endl;
+            return;
+        }
+
+        // make sure the decimater is initialized
+        if (!initialized_)
+            initialize();
+
+        unsigned int nv(mesh_->n_vertices());
+
+        // properties for the candidate collapses (no heap positions: there is no heap)
+        vpriority_ = mesh_->add_vertex_property<float>("v:prio");
+        vtarget_ = mesh_->add_vertex_property<SurfaceMesh::Halfedge>("v:target");
+
+        const int num = static_cast<int>(mesh_->vertices_size());
+
+        // the vertices whose candidate collapse must be (re)evaluated; initially all
+        std::vector<int> dirty_list;
+        std::vector<char> is_dirty(num, 0);
+        dirty_list.reserve(num);
+        for (auto v : mesh_->vertices()) {
+            dirty_list.push_back(v.idx());
+            is_dirty[v.idx()] = 1;
+        }
+
+        // candidate collapses carried across the rounds as (priority, vertex index);
+        // stale entries (deleted vertices, superseded priorities) are filtered lazily
+        std::vector< std::pair<float, int> > candidates, survivors;
+        candidates.reserve(mesh_->n_vertices());
+
+        std::vector<int> vcolor(num, -1);
+        std::vector<char> locked(num, 0);
+        std::vector<SurfaceMesh::Vertex> one_ring;
 
-            // store one-ring
-            one_ring.clear();
-            for (auto vv : mesh_->vertices(cd.v0)) {
-                one_ring.push_back(vv);
+        // cancellation (or an exhausted time budget) is honored at round boundaries, keeping
+        // the partially simplified mesh
+        const unsigned int nv_start = nv;
+        ProgressLogger progress(nv > n_vertices ? nv - n_vertices : 0, "Simplifying mesh");
+
+        while (nv > n_vertices) {
+            if (progress.is_canceled())
+                break;
+            progress.notify(nv_start - nv, false);
+
+            // step 1: greedily color the dirty vertices so that no two adjacent ones share a
+            // color. Evaluating two adjacent candidates concurrently is unsafe: the checks in
+            // is_collapse_legal() temporarily move the candidate vertex, which the evaluation
+            // of a neighbor would observe.
+            int num_colors = 1;
+            for (auto idx : dirty_list)
+                vcolor[idx] = -1;
+            for (auto idx : dirty_list) {
+                SurfaceMesh::Vertex v(idx);
+                if (mesh_->is_deleted(v))
+                    continue;
+                int c = 0;
+                bool again = true;
+                while (again) {
+                    again = false;
+                    for (auto vv : mesh_->vertices(v)) {
+                        if (vcolor[vv.idx()] == c) {
+                            ++c;
+                            again = true;
+                            break;
+                        }
+                    }
+                }
+                vcolor[idx] = c;
+                num_colors = std::max(num_colors, c + 1);
             }
 
-            // perform collapse
-            mesh_->collapse(h);
-            --nv;
-            //if (nv % 1000 == 0) std::cerr << nv << "\r";
+            // step 2: (re)evaluate the dirty vertices of each color class in parallel
+            for (int c = 0; c < num_colors; ++c) {
+#pragma omp parallel for schedule(dynamic, 1024)
+                for (long long i = 0; i < static_cast<long long>(dirty_list.size()); ++i) {
+                    const int idx = dirty_list[i];
+                    if (vcolor[idx] != c)
+                        continue;
+                    SurfaceMesh::Vertex v(idx);
+                    if (!mesh_->is_deleted(v))
+                        compute_target(v);
+                }
+            }
+            for (auto idx : dirty_list) {
+                is_dirty[idx] = 0;
+                SurfaceMesh::Vertex v(idx);
+                if (!mesh_->is_deleted(v) && vpriority_[v] >= 0.0f)
+                    candidates.push_back(std::make_pair(vpriority_[v], idx));
+            }
+            dirty_list.clear();
+
+            // step 3: apply the candidates best-first. A collapse whose neighborhood was
+            // already modified in this round has a stale priority and is postponed: the
+            // modified region is locked and its vertices are re-evaluated in the next round.
+            std::sort(candidates.begin(), candidates.end());
+            std::fill(locked.begin(), locked.end(), 0);
+            survivors.clear();
+            unsigned int collapsed = 0;
+
+            for (const auto &c : candidates) {
+                SurfaceMesh::Vertex v(c.second);
+                if (mesh_->is_deleted(v) || vpriority_[v] != c.first)
+                    continue; // stale entry
+                if (nv - collapsed <= n_vertices || locked[v.idx()]) {
+                    if (locked[v.idx()] && !is_dirty[v.idx()]) {
+                        is_dirty[v.idx()] = 1;
+                        dirty_list.push_back(v.idx());
+                    } else if (!locked[v.idx()])
+                        survivors.push_back(c);
+                    continue;
+                }
 
-            // postprocessing, e.g., update quadrics
-            postprocess_collapse(cd);
+                SurfaceMesh::Halfedge h = vtarget_[v];
+                CollapseData cd(mesh_, h);
 
-            // update queue
-            for (or_it = one_ring.begin(), or_end = one_ring.end(); or_it != or_end;
-                 ++or_it)
-                enqueue_vertex(*or_it);
+                // check this (again)
+                if (!mesh_->is_collapse_ok(h)) {
+                    if (!is_dirty[v.idx()]) {
+                        is_dirty[v.idx()] = 1;
+                        dirty_list.push_back(v.idx());
+                    }
+                    continue;
+                }
+
+                // store the region the collapse modifies: the one-rings of both endpoints
+                one_ring.clear();
+                for (auto vv : mesh_->vertices(cd.v0))
+                    one_ring.push_back(vv);
+                for (auto vv : mesh_->vertices(cd.v1))
+                    one_ring.push_back(vv);
+                one_ring.push_back(cd.v1);
+
+                // perform collapse
+                mesh_->collapse(h);
+                ++collapsed;
+
+                // postprocessing, e.g., update quadrics
+                postprocess_collapse(cd);
+
+                // lock the modified region for the rest of this round and schedule it
+                // for re-evaluation
+                for (auto vv : one_ring) {
+                    locked[vv.idx()] = 1;
+                    if (!is_dirty[vv.idx()]) {
+                        is_dirty[vv.idx()] = 1;
+                        dirty_list.push_back(vv.idx());
+                    }
+                }
+            }
+
+            candidates.swap(survivors);
+            nv -= collapsed;
+            if (collapsed == 0)
+                break; // no legal collapse left
         }
 
         // clean up
-        delete queue_;
         mesh_->collect_garbage();
         mesh_->remove_vertex_property(vpriority_);
-        mesh_->remove_vertex_property(heap_pos_);
         mesh_->remove_vertex_property(vtarget_);
     }
 
     //-----------------------------------------------------------------------------
 
-    void SurfaceMeshSimplification::enqueue_vertex(SurfaceMesh::Vertex v) {
+    bool SurfaceMeshSimplification::compute_target(SurfaceMesh::Vertex v) {
         float prio, min_prio(FLT_MAX);
         SurfaceMesh::Halfedge min_h;
 
@@ -227,11 +472,16 @@ namespace easy3d {
             }
         }
 
-        // target found -> put vertex on heap
-        if (min_h.is_valid()) {
-            vpriority_[v] = min_prio;
-            vtarget_[v] = min_h;
+        vtarget_[v] = min_h;
+        vpriority_[v] = min_h.is_valid() ? min_prio : -1.0f;
+        return min_h.is_valid();
+    }
+
+    //-----------------------------------------------------------------------------
 
+    void SurfaceMeshSimplification::enqueue_vertex(SurfaceMesh::Vertex v) {
+        // target found -> put vertex on heap
+        if (compute_target(v)) {
             if (queue_->is_stored(v))
                 queue_->update(v);
             else
@@ -242,9 +492,6 @@ namespace easy3d {
         else {
             if (queue_->is_stored(v))
                 queue_->remove(v);
-
-            vpriority_[v] = -1;
-            vtarget_[v] = min_h;
         }
     }
 
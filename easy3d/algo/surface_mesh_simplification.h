@@ -192,6 +192,44 @@ namespace easy3d {
         //! Simplify mesh to \p n vertices.
         void simplify(unsigned int n_vertices);
 
+        //! Simplify mesh to \p n vertices using all cores.
+        //! \details Instead of collapsing edges one by one from a single global heap, the candidate
+        //! collapses are (re)evaluated in parallel rounds (vertices are greedily colored so that no two
+        //! adjacent vertices are evaluated concurrently), then applied best-first; a collapse whose
+        //! neighborhood was already modified in the current round is postponed to the next one. The
+        //! result reaches the same target complexity as simplify() with near-identical quality, but the
+        //! exact collapse order - and thus the exact output - may differ.
+        void simplify_parallel(unsigned int n_vertices);
+
+        //! \name Resumable execution
+        //! \details For interactive previews, the simplification can be driven in time slices that
+        //! are interleaved with rendering instead of running to completion: after simplify_start(),
+        //! each step() collapses edges for roughly the given budget and then yields, leaving the
+        //! mesh in a valid (renderable) state. All state lives in this object, so no threads share
+        //! mutable mesh data. Typical use in a UI event loop:
+        //!     \code
+        //!     if (ss.simplify_start(n))
+        //!         while (ss.step(30.0)) {  // 30 ms per slice
+        //!             mesh->renderer()->update();
+        //!             // ... process events, redraw ...
+        //!         }
+        //!     \endcode
+        //@{
+        //! \brief Prepares a resumable simplification to \p n_vertices (building the priority
+        //!     queue). A session still in progress is finished first.
+        //! \return \c false if the mesh is not a triangle mesh.
+        bool simplify_start(unsigned int n_vertices);
+
+        //! \brief Collapses edges for roughly \p budget_ms milliseconds, then yields.
+        //! \return \c true while more work remains. When the target is reached the session cleans
+        //!     up automatically (garbage collection included) and \c false is returned.
+        bool step(double budget_ms);
+
+        //! \brief Finishes a stepped session early, keeping the partially simplified mesh.
+        //!     Called automatically when step() completes or the object is destructed.
+        void simplify_finish();
+        //@}
+
     private:
         //! Store data for an halfedge collapse
         /*
@@ -243,11 +281,17 @@ namespace easy3d {
             SurfaceMesh::VertexProperty<int> pos_;
         };
 
-        typedef Heap<SurfaceMesh::Vertex, HeapInterface> PriorityQueue;
+        // the 4-ary heap variant: shallower sifts and contiguous children improve the cache
+        // behavior of the millions of heap operations in a full decimation
+        typedef Heap4<SurfaceMesh::Vertex, HeapInterface> PriorityQueue;
 
         typedef std::vector<vec3> Points;
 
     private:
+        // find the best collapse target of vertex v; stores it in vtarget_/vpriority_
+        // (vpriority_ is -1 if no legal collapse exists). Returns whether one was found.
+        bool compute_target(SurfaceMesh::Vertex v);
+
         // put the vertex v in the priority queue
         void enqueue_vertex(SurfaceMesh::Vertex v);
 
@@ -266,6 +310,16 @@ namespace easy3d {
         // compute distance from p to triagle f
         float distance(SurfaceMesh::Face f, const vec3 &p) const;
 
+        // add the queue properties and build the priority queue
+        void setup_queue();
+
+        // destroy the queue, collect garbage, and remove the queue properties
+        void teardown_queue();
+
+        // pop the best vertex and collapse it (re-enqueueing its one-ring); returns whether a
+        // collapse was performed ('one_ring' is scratch storage owned by the caller)
+        bool collapse_one(std::vector<SurfaceMesh::Vertex> &one_ring);
+
     private:
         SurfaceMesh *mesh_;
 
@@ -286,6 +340,11 @@ namespace easy3d {
 
         PriorityQueue *queue_;
 
+        // the resumable-execution session (see simplify_start()/step())
+        bool stepping_;
+        unsigned int nv_;
+        unsigned int target_nv_;
+
         bool has_selection_;
         bool has_features_;
         float normal_deviation_;
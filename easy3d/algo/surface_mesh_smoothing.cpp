@@ -29,11 +29,15 @@
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
+#include <easy3d/util/progress.h>
+
 
 namespace easy3d {
 
     // \cond
-    using SparseMatrix = Eigen::SparseMatrix<double>;
+    // row-major storage: Eigen parallelizes the sparse matrix-vector products of its
+    // iterative solvers (with OpenMP) only for row-major matrices
+    using SparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
     using Triplet = Eigen::Triplet<double>;
     // \endcond
 
@@ -101,37 +105,59 @@ namespace easy3d {
             compute_edge_weights(use_uniform_laplace);
         eweight = mesh_->get_edge_property<float>("e:cotan");
 
-        auto points = mesh_->get_vertex_property<vec3>("v:point");
         auto laplace = mesh_->add_vertex_property<vec3>("v:laplace");
 
-        // smoothing iterations
-        SurfaceMesh::Vertex vv;
-        SurfaceMesh::Edge e;
-        for (unsigned int i = 0; i < iters; ++i) {
+        // raw base pointers; nothing is added/removed during the iterations, so the
+        // pointers stay valid and the compiler can keep them in registers (Property::data())
+        vec3* points = mesh_->get_vertex_property<vec3>("v:point").data();
+        vec3* laplace_data = laplace.data();
+        const float* eweight_data = eweight.data();
+
+        // smoothing iterations. The two steps are Jacobi-style double-buffered (the
+        // Laplacians are computed from the old positions before any vertex moves), so
+        // each step parallelizes over the vertices without synchronization.
+        // smoothing is anytime-capable: every finished iteration is a valid (just less
+        // smoothed) result, so cancellation and time budgets are honored per iteration
+        ProgressLogger progress(iters, "Smoothing mesh");
+
+        const int num = static_cast<int>(mesh_->vertices_size());
+        for (unsigned int iter = 0; iter < iters; ++iter) {
+            if (progress.is_canceled())
+                break;
+
             // step 1: compute Laplace for each vertex
-            for (auto v : mesh_->vertices()) {
+#pragma omp parallel for
+            for (int i = 0; i < num; ++i) {
+                SurfaceMesh::Vertex v(i);
+                if (mesh_->is_deleted(v))
+                    continue;
+
                 vec3 l(0, 0, 0);
 
                 if (!mesh_->is_border(v)) {
                     float w(0);
 
                     for (auto h : mesh_->halfedges(v)) {
-                        vv = mesh_->target(h);
-                        e = mesh_->edge(h);
-                        l += eweight[e] * (points[vv] - points[v]);
-                        w += eweight[e];
+                        SurfaceMesh::Vertex vv = mesh_->target(h);
+                        SurfaceMesh::Edge e = mesh_->edge(h);
+                        l += eweight_data[e.idx()] * (points[vv.idx()] - points[v.idx()]);
+                        w += eweight_data[e.idx()];
                     }
 
                     l /= w;
                 }
 
-                laplace[v] = l;
+                laplace_data[i] = l;
             }
 
             // step 2: move each vertex by its (damped) Laplacian
-            for (auto v : mesh_->vertices()) {
-                points[v] += 0.5f * laplace[v];
+#pragma omp parallel for
+            for (int i = 0; i < num; ++i) {
+                if (!mesh_->is_deleted(SurfaceMesh::Vertex(i)))
+                    points[i] += 0.5f * laplace_data[i];
             }
+
+            progress.next(false);
         }
 
         // clean-up custom properties
@@ -210,9 +236,8 @@ namespace easy3d {
                 else {
                     triplets.emplace_back(i, idx[vv], -timestep * eweight[e]);
                 }
-
-                B.row(i) = (Eigen::Vector3d) b;
             }
+            B.row(i) = (Eigen::Vector3d) b;
 
             // center vertex -> matrix
             triplets.emplace_back(i, i, 1.0 / vweight[v] + timestep * ww);
@@ -221,10 +246,23 @@ namespace easy3d {
         // build sparse matrix from triplets
         A.setFromTriplets(triplets.begin(), triplets.end());
 
-        // solve A*X = B
-        Eigen::SimplicialLDLT<SparseMatrix> solver(A);
+        // solve A*X = B. The system is symmetric positive definite (the Laplacian is
+        // symmetric and the mass term makes it diagonally dominant), so a conjugate
+        // gradient applies; its matrix-vector products run multi-threaded, and for
+        // smoothing a modest tolerance is plenty. Fall back to the direct solver in
+        // the (unexpected) case the iteration does not converge.
+        Eigen::ConjugateGradient<SparseMatrix, Eigen::Lower | Eigen::Upper> solver;
+        solver.setTolerance(1e-8);
+        solver.compute(A);
         Eigen::MatrixXd X = solver.solve(B);
-        if (solver.info() != Eigen::Success) {
+        bool solved = (solver.info() == Eigen::Success);
+        if (!solved) {
+            const Eigen::SparseMatrix<double> A_col_major(A);
+            Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > direct_solver(A_col_major);
+            X = direct_solver.solve(B);
+            solved = (direct_solver.info() == Eigen::Success);
+        }
+        if (!solved) {
             std::cerr << "SurfaceMeshSmoothing: Could not solve linear system\n";
         } else {
             // copy solution
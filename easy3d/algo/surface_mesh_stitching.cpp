@@ -24,44 +24,24 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include <easy3d/algo/surface_mesh_stitching.h>
 #include <easy3d/core/surface_mesh.h>
 
-#include <3rd_party/kd_tree/ANN/ANN.h>
-
-
-using namespace ANN;
-
-#define get_tree(x) (reinterpret_cast<ANNkd_tree*>(x))
-
 
 namespace easy3d {
 
     SurfaceMeshStitching::SurfaceMeshStitching(SurfaceMesh *mesh)
-            : mesh_(mesh), coordinates_(nullptr), tree_(nullptr), k_for_radius_search_(4) {
+            : mesh_(mesh), cell_size_(0.0f) {
         for (auto h : mesh_->halfedges()) {
             if (mesh_->is_border(h))
                 border_edges_.push_back(h);
         }
-
-        if (border_edges_.empty())
-            return;
-
-        coordinates_ = annAllocPts(border_edges_.size(), 6);
-        for (std::size_t i = 0; i < border_edges_.size(); ++i)
-            assign_edge_coordinate(coordinates_[i], border_edges_[i]);
-
-        tree_ = new ANNkd_tree(coordinates_, border_edges_.size(), 6);
     }
 
 
     SurfaceMeshStitching::~SurfaceMeshStitching() {
-        if (coordinates_)
-            annDeallocPts(coordinates_);
-
-        delete get_tree(tree_);
-        annClose();
     }
 
 
@@ -89,21 +69,30 @@ namespace easy3d {
     };
 
 
-    void SurfaceMeshStitching::assign_edge_coordinate(float *coords, SurfaceMesh::Halfedge h) const {
-        const auto vs = mesh_->source(h);
-        const auto vt = mesh_->target(h);
-        const vec3 &s = mesh_->position(vs);
-        const vec3 &t = mesh_->position(vt);
-        if (lexicographically_smaller(s, t)) {
-            for (std::size_t j = 0; j < 3; ++j) {
-                coords[j] = s[j];
-                coords[j + 3] = t[j];
-            }
-        } else {
-            for (std::size_t j = 0; j < 3; ++j) {
-                coords[j] = t[j];
-                coords[j + 3] = s[j];
-            }
+    const vec3 &SurfaceMeshStitching::smaller_endpoint(SurfaceMesh::Halfedge h) const {
+        const vec3 &s = mesh_->position(mesh_->source(h));
+        const vec3 &t = mesh_->position(mesh_->target(h));
+        return lexicographically_smaller(s, t) ? s : t;
+    }
+
+
+    uint64_t SurfaceMeshStitching::cell_key(int ix, int iy, int iz) const {
+        return (uint64_t(uint32_t(ix)) * 73856093u) ^
+               (uint64_t(uint32_t(iy)) * 19349663u) ^
+               (uint64_t(uint32_t(iz)) * 83492791u);
+    }
+
+
+    void SurfaceMeshStitching::build_grid(float cell_size) {
+        cell_size_ = cell_size;
+        grid_.clear();
+        grid_.reserve(border_edges_.size());
+        for (std::size_t i = 0; i < border_edges_.size(); ++i) {
+            const vec3 &p = smaller_endpoint(border_edges_[i]);
+            const int ix = static_cast<int>(std::floor(p.x / cell_size_));
+            const int iy = static_cast<int>(std::floor(p.y / cell_size_));
+            const int iz = static_cast<int>(std::floor(p.z / cell_size_));
+            grid_[cell_key(ix, iy, iz)].push_back(static_cast<int>(i));
         }
     }
 
@@ -112,20 +101,29 @@ namespace easy3d {
             SurfaceMesh::Halfedge h, float squared_dist_threshold,
             std::vector<SurfaceMesh::Halfedge> &neighbors
     ) const {
-        ANNcoord ann_p[6];
-        assign_edge_coordinate(ann_p, h);
-
-        std::vector<int> pts_indices(k_for_radius_search_);               // neighbor indices
-        std::vector<float> pts_squared_distances(k_for_radius_search_);     // neighbor (squared) distances
-        const int n = get_tree(tree_)->annkFRSearch(ann_p, squared_dist_threshold, k_for_radius_search_,
-                                                    pts_indices.data(), pts_squared_distances.data());
-
-        const int num = std::min(n, k_for_radius_search_);
-        neighbors.reserve(num);
-        for (int i = 0; i < num; ++i) {
-            auto idx = pts_indices[i];
-            if (border_edges_[idx] != h) {  // exclude it self
-                neighbors.push_back(border_edges_[idx]);
+        // candidates are the edges whose smaller endpoint falls in the 27 cells around
+        // that of h (the cell size is >= the distance threshold, so matching edges
+        // cannot be further away). This is a superset of the true matches; the exact
+        // edge-to-edge distance is checked by the caller.
+        const vec3 &p = smaller_endpoint(h);
+        const int ix = static_cast<int>(std::floor(p.x / cell_size_));
+        const int iy = static_cast<int>(std::floor(p.y / cell_size_));
+        const int iz = static_cast<int>(std::floor(p.z / cell_size_));
+
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    auto pos = grid_.find(cell_key(ix + dx, iy + dy, iz + dz));
+                    if (pos == grid_.end())
+                        continue;
+                    for (auto idx : pos->second) {
+                        auto h2 = border_edges_[idx];
+                        if (h2 == h)    // exclude it self
+                            continue;
+                        if (distance2(p, smaller_endpoint(h2)) <= squared_dist_threshold)
+                            neighbors.push_back(h2);
+                    }
+                }
             }
         }
     }
@@ -168,9 +166,19 @@ namespace easy3d {
         std::vector<std::pair<SurfaceMesh::Halfedge, SurfaceMesh::Halfedge> > to_stitch;
 
         const float squared_dist_threshold = dist_threshold * dist_threshold;
-        for (auto h : border_edges_) {
+        build_grid(std::max(dist_threshold, 1e-6f));
+
+        // find the best match of every border edge in parallel (the searches only read
+        // the mesh and the grid), then pair the edges up in a serial greedy pass
+        std::vector<SurfaceMesh::Halfedge> best_match(border_edges_.size());
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(border_edges_.size()); ++i)
+            best_match[i] = matched_border(border_edges_[i], squared_dist_threshold);
+
+        for (std::size_t i = 0; i < border_edges_.size(); ++i) {
+            auto h = border_edges_[i];
             if (!scheduled[h]) {
-                auto h2 = matched_border(h, squared_dist_threshold);
+                auto h2 = best_match[i];
                 if (h2.is_valid() && !scheduled[h2]) {
                     to_stitch.emplace_back(std::make_pair(h, h2));
                     scheduled[h] = true;
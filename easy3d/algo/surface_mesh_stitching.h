@@ -26,7 +26,10 @@
 #define EASY3D_ALGO_SURFACE_MESH_STITCHING_H
 
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
+
 #include <easy3d/core/surface_mesh.h>
 
 namespace easy3d {
@@ -52,6 +55,17 @@ namespace easy3d {
 
     private:
 
+        // build the spatial hash over the border edges: each edge is indexed by the grid cell of its
+        // lexicographically smaller endpoint, quantized by the cell size.
+        void build_grid(float cell_size);
+
+        // the hash key of the grid cell (ix, iy, iz). Collisions between distant cells are harmless:
+        // every candidate is verified against the true distance threshold.
+        uint64_t cell_key(int ix, int iy, int iz) const;
+
+        // the xyz-lexicographically smaller endpoint of h (edges are matched regardless of direction).
+        const vec3 &smaller_endpoint(SurfaceMesh::Halfedge h) const;
+
         // given a border halfedge h (its face is nullptr), return the matched border halfedge.
         //  - if multiple edges match, return the closest one;
         //  - if could not found, return an invalid halfedge.
@@ -63,10 +77,6 @@ namespace easy3d {
                 std::vector<SurfaceMesh::Halfedge> &neighbors
         ) const;
 
-        // the coordinates of an halfedge: represented by its two end points going from the xyz-lexicographically
-        // smaller endpoint toward the xyz-lexicographically larger end point.
-        void assign_edge_coordinate(float* coords, SurfaceMesh::Halfedge) const;
-
         bool lexicographically_smaller(const vec3 &p0, const vec3 &p1) const;
 
         float squared_distance(SurfaceMesh::Halfedge h1, SurfaceMesh::Halfedge h2) const;
@@ -76,12 +86,10 @@ namespace easy3d {
 
         std::vector<SurfaceMesh::Halfedge> border_edges_;
 
-        // the coordinates of all the border edges. Each halfedge is represented by its two end points going from the
-        // xyz-lexicographically smaller endpoint toward the xyz-lexicographically larger end point.
-        float **coordinates_;
-
-        void *tree_;
-        int k_for_radius_search_;
+        // spatial hash over the border edges, built by apply() once the distance threshold
+        // (and thus the cell size) is known: cell key -> indices into border_edges_.
+        std::unordered_map< uint64_t, std::vector<int> > grid_;
+        float cell_size_;
     };
 
 } // namespace easy3d
@@ -413,4 +413,290 @@ namespace easy3d {
         return true;
     }
 
+
+    //-----------------------------------------------------------------------------
+
+
+    SurfaceMeshSubdivider::SurfaceMeshSubdivider(const SurfaceMesh *control, Scheme scheme)
+            : scheme_(scheme), valid_(false), nv_(0), ne_(0), nf_(0),
+              face_arity_(scheme == LOOP ? 3 : 4) {
+        if (!control) {
+            LOG(ERROR) << "empty control mesh";
+            return;
+        }
+        if (control->has_garbage()) {
+            LOG(ERROR) << "the control mesh must be garbage-collected before building the stencil tables";
+            return;
+        }
+        if (scheme == LOOP && !control->is_triangle_mesh()) {
+            LOG(WARNING) << "the Loop subdivision method works only for triangle meshes";
+            return;
+        }
+
+        nv_ = control->n_vertices();
+        ne_ = control->n_edges();
+        nf_ = control->n_faces();
+
+        if (scheme == CATMULL_CLARK)
+            build_catmull_clark(control);
+        else
+            build_loop(control);
+
+        valid_ = true;
+    }
+
+
+    void SurfaceMeshSubdivider::build_catmull_clark(const SurfaceMesh *mesh) {
+        auto vfeature = mesh->get_vertex_property<bool>("v:feature");
+        auto efeature = mesh->get_edge_property<bool>("e:feature");
+
+        // the control face -> vertex table, which evaluates the face points
+        fv_offsets_.reserve(nf_ + 1);
+        fv_offsets_.push_back(0);
+        for (auto f : mesh->faces()) {
+            for (auto v : mesh->vertices(f))
+                fv_indices_.push_back(v.idx());
+            fv_offsets_.push_back(fv_indices_.size());
+        }
+
+        const int base_edge = static_cast<int>(nv_);        // refined index of the first edge point
+        const int base_face = static_cast<int>(nv_ + ne_);  // refined index of the first face point
+
+        row_offsets_.reserve(nv_ + ne_ + nf_ + 1);
+        row_offsets_.push_back(0);
+
+        // stencils of the repositioned control vertices (the rules mirror catmull_clark())
+        for (auto v : mesh->vertices()) {
+            // isolated vertex?
+            if (mesh->is_isolated(v)) {
+                terms_.push_back(Term{v.idx(), 1.0f});
+            }
+
+                // boundary vertex?
+            else if (mesh->is_border(v)) {
+                auto h1 = mesh->out_halfedge(v);
+                auto h0 = mesh->prev(h1);
+                terms_.push_back(Term{v.idx(), 0.75f});
+                terms_.push_back(Term{mesh->target(h1).idx(), 0.125f});
+                terms_.push_back(Term{mesh->source(h0).idx(), 0.125f});
+            }
+
+                // interior feature vertex?
+            else if (vfeature && vfeature[v]) {
+                std::vector<int> feature_nbrs;
+                for (auto h : mesh->halfedges(v)) {
+                    if (efeature[mesh->edge(h)])
+                        feature_nbrs.push_back(mesh->target(h).idx());
+                }
+                if (feature_nbrs.size() == 2) { // vertex is on feature edge
+                    terms_.push_back(Term{v.idx(), 0.75f});
+                    terms_.push_back(Term{feature_nbrs[0], 0.125f});
+                    terms_.push_back(Term{feature_nbrs[1], 0.125f});
+                } else {                        // keep fixed
+                    terms_.push_back(Term{v.idx(), 1.0f});
+                }
+            }
+
+                // interior vertex
+            else {
+                // weights from SIGGRAPH paper "Subdivision Surfaces in Character Animation"
+                const float k = mesh->valence(v);
+                const float w = 1.0f / (k * k);
+                terms_.push_back(Term{v.idx(), (k - 2.0f) / k});
+                for (auto vv : mesh->vertices(v))
+                    terms_.push_back(Term{vv.idx(), w});
+                for (auto f : mesh->faces(v))
+                    terms_.push_back(Term{base_face + f.idx(), w});
+            }
+            row_offsets_.push_back(terms_.size());
+        }
+
+        // stencils of the edge points
+        for (auto e : mesh->edges()) {
+            const int v0 = mesh->vertex(e, 0).idx();
+            const int v1 = mesh->vertex(e, 1).idx();
+            // boundary or feature edge?
+            if (mesh->is_border(e) || (efeature && efeature[e])) {
+                terms_.push_back(Term{v0, 0.5f});
+                terms_.push_back(Term{v1, 0.5f});
+            }
+                // interior edge
+            else {
+                terms_.push_back(Term{v0, 0.25f});
+                terms_.push_back(Term{v1, 0.25f});
+                terms_.push_back(Term{base_face + mesh->face(e, 0).idx(), 0.25f});
+                terms_.push_back(Term{base_face + mesh->face(e, 1).idx(), 0.25f});
+            }
+            row_offsets_.push_back(terms_.size());
+        }
+
+        // the rows of the face points just pick up the already evaluated face points
+        for (auto f : mesh->faces()) {
+            terms_.push_back(Term{base_face + f.idx(), 1.0f});
+            row_offsets_.push_back(terms_.size());
+        }
+
+        // one refined quad per face corner: the corner vertex, the two adjacent edge
+        // points, and the face point
+        faces_.reserve(fv_indices_.size() * 4);
+        for (auto f : mesh->faces()) {
+            for (auto h : mesh->halfedges(f)) {
+                faces_.push_back(mesh->target(h).idx());
+                faces_.push_back(base_edge + mesh->edge(mesh->next(h)).idx());
+                faces_.push_back(base_face + f.idx());
+                faces_.push_back(base_edge + mesh->edge(h).idx());
+            }
+        }
+    }
+
+
+    void SurfaceMeshSubdivider::build_loop(const SurfaceMesh *mesh) {
+        auto vfeature = mesh->get_vertex_property<bool>("v:feature");
+        auto efeature = mesh->get_edge_property<bool>("e:feature");
+
+        const int base_edge = static_cast<int>(nv_);    // refined index of the first edge point
+
+        row_offsets_.reserve(nv_ + ne_ + 1);
+        row_offsets_.push_back(0);
+
+        // stencils of the repositioned control vertices (the rules mirror loop())
+        for (auto v : mesh->vertices()) {
+            // isolated vertex?
+            if (mesh->is_isolated(v)) {
+                terms_.push_back(Term{v.idx(), 1.0f});
+            }
+
+                // boundary vertex?
+            else if (mesh->is_border(v)) {
+                auto h1 = mesh->out_halfedge(v);
+                auto h0 = mesh->prev(h1);
+                terms_.push_back(Term{v.idx(), 0.75f});
+                terms_.push_back(Term{mesh->target(h1).idx(), 0.125f});
+                terms_.push_back(Term{mesh->source(h0).idx(), 0.125f});
+            }
+
+                // interior feature vertex?
+            else if (vfeature && vfeature[v]) {
+                std::vector<int> feature_nbrs;
+                for (auto h : mesh->halfedges(v)) {
+                    if (efeature[mesh->edge(h)])
+                        feature_nbrs.push_back(mesh->target(h).idx());
+                }
+                if (feature_nbrs.size() == 2) { // vertex is on feature edge
+                    terms_.push_back(Term{v.idx(), 0.75f});
+                    terms_.push_back(Term{feature_nbrs[0], 0.125f});
+                    terms_.push_back(Term{feature_nbrs[1], 0.125f});
+                } else {                        // keep fixed
+                    terms_.push_back(Term{v.idx(), 1.0f});
+                }
+            }
+
+                // interior vertex
+            else {
+                const float k = mesh->valence(v);
+                const float beta = (0.625 - pow(0.375 + 0.25 * cos(2.0 * M_PI / k), 2.0));
+                terms_.push_back(Term{v.idx(), 1.0f - beta});
+                for (auto vv : mesh->vertices(v))
+                    terms_.push_back(Term{vv.idx(), beta / k});
+            }
+            row_offsets_.push_back(terms_.size());
+        }
+
+        // stencils of the edge points
+        for (auto e : mesh->edges()) {
+            const int v0 = mesh->vertex(e, 0).idx();
+            const int v1 = mesh->vertex(e, 1).idx();
+            // boundary or feature edge?
+            if (mesh->is_border(e) || (efeature && efeature[e])) {
+                terms_.push_back(Term{v0, 0.5f});
+                terms_.push_back(Term{v1, 0.5f});
+            }
+                // interior edge
+            else {
+                auto h0 = mesh->halfedge(e, 0);
+                auto h1 = mesh->halfedge(e, 1);
+                terms_.push_back(Term{v0, 0.375f});
+                terms_.push_back(Term{v1, 0.375f});
+                terms_.push_back(Term{mesh->target(mesh->next(h0)).idx(), 0.125f});
+                terms_.push_back(Term{mesh->target(mesh->next(h1)).idx(), 0.125f});
+            }
+            row_offsets_.push_back(terms_.size());
+        }
+
+        // 1-to-4 split: one corner triangle per face corner, plus the center triangle
+        // of the three edge points
+        faces_.reserve(nf_ * 4 * 3);
+        for (auto f : mesh->faces()) {
+            for (auto h : mesh->halfedges(f)) {
+                faces_.push_back(mesh->target(h).idx());
+                faces_.push_back(base_edge + mesh->edge(mesh->next(h)).idx());
+                faces_.push_back(base_edge + mesh->edge(h).idx());
+            }
+            auto h0 = mesh->halfedge(f);
+            faces_.push_back(base_edge + mesh->edge(h0).idx());
+            faces_.push_back(base_edge + mesh->edge(mesh->next(h0)).idx());
+            faces_.push_back(base_edge + mesh->edge(mesh->prev(h0)).idx());
+        }
+    }
+
+
+    bool SurfaceMeshSubdivider::subdivide(const SurfaceMesh *control, SurfaceMesh *refined) const {
+        if (!valid_ || !control || !refined)
+            return false;
+        if (control->n_vertices() != nv_ || control->n_edges() != ne_ || control->n_faces() != nf_) {
+            LOG(ERROR) << "the control mesh does not match the topology the stencil tables were built from";
+            return false;
+        }
+
+        const std::vector<vec3> &points = control->points();
+
+        // evaluate the face points first (Catmull-Clark only): the stencil rows refer to them
+        std::vector<vec3> fpoints;
+        if (scheme_ == CATMULL_CLARK) {
+            fpoints.resize(nf_);
+#pragma omp parallel for
+            for (long long i = 0; i < static_cast<long long>(nf_); ++i) {
+                vec3 p(0, 0, 0);
+                for (std::size_t j = fv_offsets_[i]; j < fv_offsets_[i + 1]; ++j)
+                    p += points[fv_indices_[j]];
+                fpoints[i] = p / static_cast<float>(fv_offsets_[i + 1] - fv_offsets_[i]);
+            }
+        }
+
+        // evaluate all stencil rows: a term refers to a control point or to a face point
+        const std::size_t num = n_refined_vertices();
+        const int nv = static_cast<int>(nv_);
+        const std::size_t fp_base = nv_ + ne_;
+        std::vector<vec3> new_points(num);
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(num); ++i) {
+            vec3 p(0, 0, 0);
+            for (std::size_t j = row_offsets_[i]; j < row_offsets_[i + 1]; ++j) {
+                const Term &t = terms_[j];
+                p += t.weight * (t.index < nv ? points[t.index] : fpoints[t.index - fp_base]);
+            }
+            new_points[i] = p;
+        }
+
+        const std::size_t num_faces = n_refined_faces();
+        if (refined->n_vertices() == num && refined->n_faces() == num_faces && !refined->has_garbage()) {
+            // the refined topology is already in place: update the positions only
+            std::vector<vec3> &pts = refined->points();   // detaches copy-on-write storage once
+#pragma omp parallel for
+            for (long long i = 0; i < static_cast<long long>(num); ++i)
+                pts[i] = new_points[i];
+        } else {
+            refined->clear();
+            for (std::size_t i = 0; i < num; ++i)
+                refined->add_vertex(new_points[i]);
+            std::vector<SurfaceMesh::Vertex> corners(face_arity_);
+            for (std::size_t i = 0; i < num_faces; ++i) {
+                for (int j = 0; j < face_arity_; ++j)
+                    corners[j] = SurfaceMesh::Vertex(faces_[i * face_arity_ + j]);
+                refined->add_face(corners);
+            }
+        }
+        return true;
+    }
+
 } // namespace easy3d
\ No newline at end of file
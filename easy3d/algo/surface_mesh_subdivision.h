@@ -26,6 +26,10 @@
 #define EASY3D_ALGO_MESH_SUBDIVISION_H
 
 
+#include <cstddef>
+#include <vector>
+
+
 namespace easy3d {
 
     class SurfaceMesh;
@@ -44,6 +48,101 @@ namespace easy3d {
         static bool sqrt3(SurfaceMesh *mesh);
     };
 
+
+    /**
+     * \brief Table-driven subdivision of a control mesh with a fixed topology.
+     * \class SurfaceMeshSubdivider easy3d/algo/surface_mesh_subdivision.h
+     *
+     * \details SurfaceMeshSubdivision::catmull_clark() and loop() subdivide in place and rebuild
+     * the topology element by element, which is convenient for a one-off refinement but wasteful
+     * when the same control mesh is subdivided over and over (e.g., an animation preview that
+     * subdivides the deformed control cage every frame). This class separates the two costs:
+     * the constructor analyzes the control topology once and bakes the subdivision rules into
+     * stencil tables (per refined vertex, the control vertices/face points it depends on and
+     * their weights, in a compressed layout); subdivide() then merely evaluates the tables,
+     * in parallel on all cores. When the output mesh already carries the refined topology from a
+     * previous call, only the vertex positions are updated and no topology is touched at all.
+     *
+     * The subdivision rules match the in-place implementations: borders and feature edges/vertices
+     * (the \c e:feature and \c v:feature properties of the control mesh at construction time) use
+     * the crease rules. Feature tags are not propagated to the refined mesh.
+     *
+     * Example usage (subdividing a deforming control mesh every frame):
+     * \code
+     *      SurfaceMeshSubdivider subdivider(control, SurfaceMeshSubdivider::CATMULL_CLARK);
+     *      SurfaceMesh refined;
+     *      while (animating) {
+     *          deform(control);                        // positions change, topology does not
+     *          subdivider.subdivide(control, &refined);   // parallel position evaluation only
+     *      }
+     * \endcode
+     */
+    class SurfaceMeshSubdivider {
+    public:
+        /// The supported subdivision schemes.
+        enum Scheme {
+            CATMULL_CLARK,  ///< Catmull-Clark subdivision (general polygonal meshes).
+            LOOP            ///< Loop subdivision (triangle meshes only).
+        };
+
+        /**
+         * \brief Builds the stencil tables for one subdivision level of the topology of \p control.
+         * \param control The control mesh. It must be garbage-collected; for LOOP it must be a
+         *      triangle mesh. Only its topology (and its feature tags, if any) is baked into the
+         *      tables; the positions are read on every subdivide() call.
+         * \param scheme The subdivision scheme.
+         */
+        SurfaceMeshSubdivider(const SurfaceMesh *control, Scheme scheme);
+
+        /// \brief Returns whether the stencil tables have been built successfully.
+        bool is_valid() const { return valid_; }
+
+        /// \brief The number of vertices of the refined mesh.
+        std::size_t n_refined_vertices() const { return row_offsets_.empty() ? 0 : row_offsets_.size() - 1; }
+        /// \brief The number of faces of the refined mesh.
+        std::size_t n_refined_faces() const { return faces_.size() / face_arity_; }
+
+        /**
+         * \brief Subdivides \p control into \p refined.
+         * \details The new vertex positions are evaluated from the stencil tables in parallel.
+         *      If \p refined already holds the refined topology (i.e., it was filled by a
+         *      previous call with this subdivider), only its vertex positions are updated;
+         *      otherwise it is cleared and the refined topology is built.
+         * \param control A mesh with the same topology as the one the subdivider was built
+         *      from (the vertex positions may differ, e.g., a deformed copy).
+         * \param refined The output mesh.
+         * \return true on success.
+         */
+        bool subdivide(const SurfaceMesh *control, SurfaceMesh *refined) const;
+
+    private:
+        // a weighted reference to a control vertex (index < nv_) or, for Catmull-Clark,
+        // to a face point (index - nv_)
+        struct Term {
+            int index;
+            float weight;
+        };
+
+        void build_catmull_clark(const SurfaceMesh *mesh);
+        void build_loop(const SurfaceMesh *mesh);
+
+        Scheme scheme_;
+        bool valid_;
+        std::size_t nv_, ne_, nf_;  // element counts of the control mesh
+        int face_arity_;            // vertices per refined face: 4 (Catmull-Clark) or 3 (Loop)
+
+        // control face -> its vertices (compressed); also evaluates the face points
+        std::vector<std::size_t> fv_offsets_;
+        std::vector<int> fv_indices_;
+
+        // one stencil row per refined vertex (old vertices, then edge points, then face points)
+        std::vector<std::size_t> row_offsets_;
+        std::vector<Term> terms_;
+
+        // the refined faces, face_arity_ refined vertex indices each
+        std::vector<int> faces_;
+    };
+
 } // namespace easy3d
 
 #endif  // EASY3D_ALGO_MESH_SUBDIVISION_H
\ No newline at end of file
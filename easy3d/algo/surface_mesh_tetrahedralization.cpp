@@ -31,13 +31,21 @@
 
 #include <3rd_party/tetgen/tetgen.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 
 namespace easy3d {
 
 
-    SurfaceMeshTetrehedralization::SurfaceMeshTetrehedralization()
-            : allow_steiner_points_on_boundary_(true), tag_regions_(false), max_tet_shape_(2.0),
-              min_dihedral_angle_(0.0), max_tet_volume_(-1.0), command_line_("") {
+    SurfaceMeshTetrehedralization::SurfaceMeshTetrehedralization() {
+    }
+
+
+    SurfaceMeshTetrehedralization::SurfaceMeshTetrehedralization(const Options& options)
+            : options_(options) {
     }
 
 
@@ -63,36 +71,37 @@ namespace easy3d {
 
         tetgenbehavior *tetgen_args = new tetgenbehavior;
         // Create tetgen argument string from options.
-        if (command_line_.empty()) {
+        if (options_.command_line.empty()) {
             std::ostringstream s;
             // Q: quiet
             // p: input data is surface
-            // n: output tet neighbors
             // q: desired quality
             // V: verbose
-            s << "Qpnq" << max_tet_shape_;
-            LOG(INFO) << "maximum allowed radius-edge ratio: " << max_tet_shape_;
-
-            if (min_dihedral_angle_ > 0) {
-                s << "/" << min_dihedral_angle_;
-                LOG(INFO) << "minimum allowed dihedral angle: " << min_dihedral_angle_;
+            // (the former 'n' switch - output tet neighbors - was dropped: the neighbor
+            // array was never consumed and costs four ints per tetrahedron)
+            s << "Qpq" << options_.max_tet_shape;
+            LOG(INFO) << "maximum allowed radius-edge ratio: " << options_.max_tet_shape;
+
+            if (options_.min_dihedral_angle > 0) {
+                s << "/" << options_.min_dihedral_angle;
+                LOG(INFO) << "minimum allowed dihedral angle: " << options_.min_dihedral_angle;
             }
 
-            if (max_tet_volume_ > 0.0) {
-                s << "a" << max_tet_volume_;
-                LOG(INFO) << "max allowed tetrahedron volume: " << max_tet_volume_;
+            if (options_.max_tet_volume > 0.0) {
+                s << "a" << options_.max_tet_volume;
+                LOG(INFO) << "max allowed tetrahedron volume: " << options_.max_tet_volume;
             }
 
             // A: generate region tags for each shell.
-            if (tag_regions_) {
+            if (options_.tag_regions) {
                 s << "A";
                 LOG(INFO) << "adding a cell property \"c:region\" to indicate different bounded regions";
             }
 
             // Y: prohibit steiner points on boundaries
-            if (allow_steiner_points_on_boundary_)
+            if (options_.allow_steiner_points_on_boundary)
                 LOG(INFO) << "allowing Steiner points on the boundary edges and faces";
-            if (!allow_steiner_points_on_boundary_) {
+            if (!options_.allow_steiner_points_on_boundary) {
                 s << "Y";
                 LOG(INFO) << "preserving boundary edges and faces";
             }
@@ -101,8 +110,8 @@ namespace easy3d {
             LOG(INFO) << "using command line: " << arg_str;
             tetgen_args->parse_commandline(const_cast<char *>(arg_str.c_str()));
         } else {
-            LOG(INFO) << "using user-specified command line: " << command_line_;
-            tetgen_args->parse_commandline(const_cast<char *>(command_line_.c_str()));
+            LOG(INFO) << "using user-specified command line: " << options_.command_line;
+            tetgen_args->parse_commandline(const_cast<char *>(options_.command_line.c_str()));
         }
 
         tetgenio *tetgen_surface = to_tetgen_surface(mesh);
@@ -120,6 +129,13 @@ namespace easy3d {
             }
         }
 
+        // the copy of the input is no longer needed - release it before the output
+        // mesh is allocated
+        delete tetgen_surface;
+        tetgen_surface = nullptr;
+        delete tetgen_args;
+        tetgen_args = nullptr;
+
         PolyMesh *result = to_easy3d_poly_mesh(tetgen_volume);
 
         if (result) {
@@ -132,8 +148,6 @@ namespace easy3d {
         } else
             LOG(WARNING) << "tetrehedralization failed. " << w.time_string();
 
-        delete tetgen_args;
-        delete tetgen_surface;
         delete tetgen_volume;
 
         return result;
@@ -178,36 +192,307 @@ namespace easy3d {
     }
 
 
+    namespace details {
+
+        // \cond
+
+        // a triangle keyed by its sorted vertex triple
+        struct Triple {
+            Triple(int x, int y, int z) : a(x), b(y), c(z) {
+                if (a > b) std::swap(a, b);
+                if (b > c) std::swap(b, c);
+                if (a > b) std::swap(a, b);
+            }
+            bool operator==(const Triple& t) const { return a == t.a && b == t.b && c == t.c; }
+            int a, b, c;
+        };
+
+        struct TripleHash {
+            std::size_t operator()(const Triple& t) const {
+                std::uint64_t h = 14695981039346656037ull;
+                h = (h ^ static_cast<std::uint64_t>(t.a)) * 1099511628211ull;
+                h = (h ^ static_cast<std::uint64_t>(t.b)) * 1099511628211ull;
+                h = (h ^ static_cast<std::uint64_t>(t.c)) * 1099511628211ull;
+                return static_cast<std::size_t>(h);
+            }
+        };
+
+        // Build the PolyMesh of a tetrahedron soup in bulk, the same way the binary PLM
+        // loader does: one hash pass identifies the unique faces and edges (replacing the
+        // linear find_half_face()/find_edge() scans that add_tetra() performs per cell),
+        // then the connectivity arrays are filled in parallel passes.
+        bool build_from_tets(PolyMesh* mesh, std::vector<vec3>& points, const int* tets, int num_cells) {
+            const int num_vertices = static_cast<int>(points.size());
+
+            // Pass 1 (sequential): unique faces and edges. The face key is the sorted vertex
+            // triple; the vertex following the smallest one in the stored rotation decides
+            // which of the two halffaces an occurrence refers to.
+            std::unordered_map<Triple, int, TripleHash> face_indices;
+            face_indices.reserve(num_cells * 2);
+            std::unordered_map<std::uint64_t, int> edge_indices;
+            edge_indices.reserve(num_cells * 2);
+
+            std::vector<int> face_vts;          // 3 per face, smallest vertex first
+            std::vector<int> face_edges;        // 3 per face
+            std::vector<int> edge_vts;          // 2 per edge
+            std::vector<int> halfface_cells;    // 2 per face (-1 = boundary)
+            std::vector<int> cell_halffaces(static_cast<std::size_t>(num_cells) * 4);
+            face_vts.reserve(num_cells * 6);
+            face_edges.reserve(num_cells * 6);
+
+            // for each face of a tet (v0,v1,v2,v3), its normal points inside the cell -
+            // the same convention as PolyMesh::add_tetra()
+            static const int corners[4][3] = { {1, 2, 3}, {0, 3, 2}, {3, 0, 1}, {2, 1, 0} };
+
+            for (int c = 0; c < num_cells; ++c) {
+                const int* t = tets + static_cast<std::size_t>(c) * 4;
+                if (t[0] == t[1] || t[0] == t[2] || t[0] == t[3] ||
+                    t[1] == t[2] || t[1] == t[3] || t[2] == t[3])
+                    return false;
+                for (int k = 0; k < 4; ++k) {
+                    int vts[3] = { t[corners[k][0]], t[corners[k][1]], t[corners[k][2]] };
+                    if (vts[0] < 0 || vts[0] >= num_vertices ||
+                        vts[1] < 0 || vts[1] >= num_vertices ||
+                        vts[2] < 0 || vts[2] >= num_vertices)
+                        return false;
+                    // rotate so the smallest vertex comes first
+                    while (vts[0] > vts[1] || vts[0] > vts[2]) {
+                        const int first = vts[0];
+                        vts[0] = vts[1];
+                        vts[1] = vts[2];
+                        vts[2] = first;
+                    }
+
+                    int halfface = -1;
+                    const Triple key(vts[0], vts[1], vts[2]);
+                    auto pos = face_indices.find(key);
+                    if (pos == face_indices.end()) {
+                        const int face = static_cast<int>(face_vts.size()) / 3;
+                        face_indices[key] = face;
+                        for (int i = 0; i < 3; ++i) {
+                            const int s = vts[i];
+                            const int e = vts[(i + 1) % 3];
+                            face_vts.push_back(s);
+                            const std::uint64_t ekey =
+                                    (static_cast<std::uint64_t>(std::min(s, e)) << 32) |
+                                     static_cast<std::uint64_t>(std::max(s, e));
+                            auto epos = edge_indices.find(ekey);
+                            int edge;
+                            if (epos == edge_indices.end()) {
+                                edge = static_cast<int>(edge_vts.size()) / 2;
+                                edge_indices[ekey] = edge;
+                                edge_vts.push_back(s);
+                                edge_vts.push_back(e);
+                            }
+                            else
+                                edge = epos->second;
+                            face_edges.push_back(edge);
+                        }
+                        halfface_cells.push_back(-1);
+                        halfface_cells.push_back(-1);
+                        halfface = 2 * face;
+                    }
+                    else {
+                        // same orientation iff the same vertex follows the smallest one
+                        const bool same = (face_vts[pos->second * 3 + 1] == vts[1]);
+                        halfface = 2 * pos->second + (same ? 0 : 1);
+                    }
+                    cell_halffaces[static_cast<std::size_t>(c) * 4 + k] = halfface;
+                    halfface_cells[halfface] = c;
+                }
+            }
+
+            const int num_faces = static_cast<int>(face_vts.size()) / 3;
+            const int num_edges = static_cast<int>(edge_vts.size()) / 2;
+
+            // size all property arrays once and adopt the coordinates
+            mesh->resize(num_vertices, num_edges, num_faces, num_cells);
+            mesh->vertex_property<vec3>("v:point").vector().swap(points);
+
+            auto vconn = mesh->vertex_property<PolyMesh::VertexConnectivity>("v:connectivity");
+            auto econn = mesh->edge_property<PolyMesh::EdgeConnectivity>("e:connectivity");
+            auto hconn = mesh->halfface_property<PolyMesh::HalfFaceConnectivity>("h:connectivity");
+            auto cconn = mesh->cell_property<PolyMesh::CellConnectivity>("c:connectivity");
+
+            // Pass 2 (parallel): the halfface and edge topology
+#pragma omp parallel for schedule(dynamic, 4096)
+            for (int f = 0; f < num_faces; ++f) {
+                auto& hc = hconn[PolyMesh::HalfFace(2 * f)];
+                auto& oc = hconn[PolyMesh::HalfFace(2 * f + 1)];
+                hc.vertices_.reserve(3);
+                for (int k = 0; k < 3; ++k) {
+                    hc.vertices_.push_back(PolyMesh::Vertex(face_vts[f * 3 + k]));
+                    hc.edges_.insert(PolyMesh::Edge(face_edges[f * 3 + k]));
+                }
+                oc.vertices_.assign(hc.vertices_.rbegin(), hc.vertices_.rend());
+                oc.edges_ = hc.edges_;
+                hc.opposite_ = PolyMesh::HalfFace(2 * f + 1);
+                oc.opposite_ = PolyMesh::HalfFace(2 * f);
+                hc.cell_ = PolyMesh::Cell(halfface_cells[2 * f]);
+                oc.cell_ = PolyMesh::Cell(halfface_cells[2 * f + 1]);
+            }
+
+#pragma omp parallel for
+            for (int e = 0; e < num_edges; ++e)
+                econn[PolyMesh::Edge(e)].vertices_ = { PolyMesh::Vertex(edge_vts[2 * e]),
+                                                       PolyMesh::Vertex(edge_vts[2 * e + 1]) };
+
+            // Pass 3 (parallel): the per-cell incidences
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (int c = 0; c < num_cells; ++c) {
+                auto& cc = cconn[PolyMesh::Cell(c)];
+                cc.halffaces_.reserve(4);
+                for (int k = 0; k < 4; ++k) {
+                    const int h = cell_halffaces[static_cast<std::size_t>(c) * 4 + k];
+                    cc.halffaces_.push_back(PolyMesh::HalfFace(h));
+                    const int f = h / 2;
+                    for (int i = 0; i < 3; ++i) {
+                        cc.vertices_.insert(PolyMesh::Vertex(face_vts[f * 3 + i]));
+                        cc.edges_.insert(PolyMesh::Edge(face_edges[f * 3 + i]));
+                    }
+                }
+            }
+
+            // Pass 4 (parallel): the per-vertex and per-edge incidences, bucketed into CSR
+            // ranges first so each element's sets are filled by exactly one thread
+            {
+                std::vector<int> edge_begin(num_vertices + 1, 0);
+                for (int v : edge_vts)
+                    ++edge_begin[v + 1];
+                for (int v = 0; v < num_vertices; ++v)
+                    edge_begin[v + 1] += edge_begin[v];
+                std::vector<int> vertex_edges(edge_begin[num_vertices]);
+                std::vector<int> where(edge_begin.begin(), edge_begin.end() - 1);
+                for (int e = 0; e < num_edges; ++e) {
+                    vertex_edges[where[edge_vts[2 * e]]++] = e;
+                    vertex_edges[where[edge_vts[2 * e + 1]]++] = e;
+                }
+
+                std::vector<int> face_begin(num_vertices + 1, 0);
+                for (int v : face_vts)
+                    ++face_begin[v + 1];
+                for (int v = 0; v < num_vertices; ++v)
+                    face_begin[v + 1] += face_begin[v];
+                std::vector<int> vertex_faces(face_begin[num_vertices]);
+                where.assign(face_begin.begin(), face_begin.end() - 1);
+                for (int f = 0; f < num_faces; ++f) {
+                    for (int k = 0; k < 3; ++k)
+                        vertex_faces[where[face_vts[f * 3 + k]]++] = f;
+                }
+
+                std::vector<int> cell_begin(num_vertices + 1, 0);
+                for (std::size_t k = 0; k < static_cast<std::size_t>(num_cells) * 4; ++k)
+                    ++cell_begin[tets[k] + 1];
+                for (int v = 0; v < num_vertices; ++v)
+                    cell_begin[v + 1] += cell_begin[v];
+                std::vector<int> vertex_cells(cell_begin[num_vertices]);
+                where.assign(cell_begin.begin(), cell_begin.end() - 1);
+                for (int c = 0; c < num_cells; ++c) {
+                    for (int k = 0; k < 4; ++k)
+                        vertex_cells[where[tets[static_cast<std::size_t>(c) * 4 + k]]++] = c;
+                }
+
+#pragma omp parallel for schedule(dynamic, 4096)
+                for (int v = 0; v < num_vertices; ++v) {
+                    auto& vc = vconn[PolyMesh::Vertex(v)];
+                    for (int k = edge_begin[v]; k < edge_begin[v + 1]; ++k) {
+                        const int e = vertex_edges[k];
+                        vc.edges_.insert(PolyMesh::Edge(e));
+                        vc.vertices_.insert(PolyMesh::Vertex(edge_vts[2 * e] + edge_vts[2 * e + 1] - v));
+                    }
+                    for (int k = face_begin[v]; k < face_begin[v + 1]; ++k) {
+                        vc.halffaces_.insert(PolyMesh::HalfFace(2 * vertex_faces[k]));
+                        vc.halffaces_.insert(PolyMesh::HalfFace(2 * vertex_faces[k] + 1));
+                    }
+                    for (int k = cell_begin[v]; k < cell_begin[v + 1]; ++k)
+                        vc.cells_.insert(PolyMesh::Cell(vertex_cells[k]));
+                }
+            }
+
+            {
+                std::vector<int> face_begin(num_edges + 1, 0);
+                for (int e : face_edges)
+                    ++face_begin[e + 1];
+                for (int e = 0; e < num_edges; ++e)
+                    face_begin[e + 1] += face_begin[e];
+                std::vector<int> incident_faces(face_begin[num_edges]);
+                std::vector<int> where(face_begin.begin(), face_begin.end() - 1);
+                for (int f = 0; f < num_faces; ++f) {
+                    for (int k = 0; k < 3; ++k)
+                        incident_faces[where[face_edges[f * 3 + k]]++] = f;
+                }
+
+                std::vector<int> cell_begin(num_edges + 1, 0);
+                for (int c = 0; c < num_cells; ++c) {
+                    for (auto e : cconn[PolyMesh::Cell(c)].edges_)
+                        ++cell_begin[e.idx() + 1];
+                }
+                for (int e = 0; e < num_edges; ++e)
+                    cell_begin[e + 1] += cell_begin[e];
+                std::vector<int> incident_cells(cell_begin[num_edges]);
+                where.assign(cell_begin.begin(), cell_begin.end() - 1);
+                for (int c = 0; c < num_cells; ++c) {
+                    for (auto e : cconn[PolyMesh::Cell(c)].edges_)
+                        incident_cells[where[e.idx()]++] = c;
+                }
+
+#pragma omp parallel for schedule(dynamic, 4096)
+                for (int e = 0; e < num_edges; ++e) {
+                    auto& ec = econn[PolyMesh::Edge(e)];
+                    for (int k = face_begin[e]; k < face_begin[e + 1]; ++k) {
+                        ec.halffaces_.insert(PolyMesh::HalfFace(2 * incident_faces[k]));
+                        ec.halffaces_.insert(PolyMesh::HalfFace(2 * incident_faces[k] + 1));
+                    }
+                    for (int k = cell_begin[e]; k < cell_begin[e + 1]; ++k)
+                        ec.cells_.insert(PolyMesh::Cell(incident_cells[k]));
+                }
+            }
+
+            return true;
+        }
+
+        // \endcond
+
+    } // namespace details
+
+
     PolyMesh *SurfaceMeshTetrehedralization::to_easy3d_poly_mesh(tetgenio *volume) {
         if (volume->numberofpoints <= 0 || volume->numberoftetrahedra <= 0)
             return nullptr;
 
-        PolyMesh *mesh = new PolyMesh;
-
-        PolyMesh::CellProperty<double> region;
-        if (tag_regions_)
-            region = mesh-> add_cell_property<double>("c:region");
-
-        double *p = volume->pointlist;
+        // adopt the coordinates, then release tetgen's copy right away
+        std::vector<vec3> points(volume->numberofpoints);
+        const double *p = volume->pointlist;
         for (int i = 0; i < volume->numberofpoints; i++) {
-            mesh->add_vertex(vec3(p[0], p[1], p[2]));
+            points[i] = vec3(p[0], p[1], p[2]);
             p += 3;
         }
+        delete[] volume->pointlist;
+        volume->pointlist = nullptr;
 
-        int *t = volume->tetrahedronlist;
-        for (int i = 0; i < volume->numberoftetrahedra; i++) {
-            PolyMesh::Cell c = mesh->add_tetra(
-                    PolyMesh::Vertex(t[0] - volume->firstnumber),
-                    PolyMesh::Vertex(t[1] - volume->firstnumber),
-                    PolyMesh::Vertex(t[2] - volume->firstnumber),
-                    PolyMesh::Vertex(t[3] - volume->firstnumber)
-                    );
-
-            if (tag_regions_)
-                region[c] = volume->tetrahedronattributelist[i];
+        if (volume->firstnumber != 0) {
+            for (int i = 0; i < volume->numberoftetrahedra * 4; ++i)
+                volume->tetrahedronlist[i] -= volume->firstnumber;
+        }
 
-            t += 4;
+        PolyMesh *mesh = new PolyMesh;
+        if (!details::build_from_tets(mesh, points, volume->tetrahedronlist, volume->numberoftetrahedra)) {
+            LOG(ERROR) << "tetgen produced an invalid tetrahedron list";
+            delete mesh;
+            return nullptr;
+        }
+        delete[] volume->tetrahedronlist;
+        volume->tetrahedronlist = nullptr;
+
+        if (options_.tag_regions && volume->tetrahedronattributelist) {
+            auto region = mesh->add_cell_property<double>("c:region");
+            for (int i = 0; i < volume->numberoftetrahedra; i++)
+                region[PolyMesh::Cell(i)] = volume->tetrahedronattributelist[i];
+            delete[] volume->tetrahedronattributelist;
+            volume->tetrahedronattributelist = nullptr;
         }
+        volume->numberofpoints = 0;
+        volume->numberoftetrahedra = 0;
 
         return mesh;
     }
@@ -39,7 +39,27 @@ namespace easy3d {
     /// \class SurfaceMeshTetrehedralization easy3d/algo/surface_mesh_tetrahedralization.h
     class SurfaceMeshTetrehedralization {
     public:
+        /**
+         * \brief The tetgen quality/size options, collected in one place.
+         * \details Equivalent to calling the individual setters; handy when the options come
+         *      from a configuration or need to be passed around. See the setters for the
+         *      meaning and the tetgen manual references.
+         */
+        struct Options {
+            Options()
+                    : allow_steiner_points_on_boundary(true), tag_regions(false), max_tet_shape(2.0),
+                      min_dihedral_angle(0.0), max_tet_volume(-1.0), command_line("") {
+            }
+            bool        allow_steiner_points_on_boundary;
+            bool        tag_regions;
+            double      max_tet_shape;
+            double      min_dihedral_angle;
+            double      max_tet_volume;
+            std::string command_line;   ///< if non-empty, overrides all other options
+        };
+
         SurfaceMeshTetrehedralization();
+        explicit SurfaceMeshTetrehedralization(const Options& options);
         ~SurfaceMeshTetrehedralization();
 
         /**
@@ -48,7 +68,7 @@ namespace easy3d {
          *      there exists any) will appear only in the interior space of the input surface.
          */
         void set_allow_steiner_points_on_boundary(bool x) {
-            allow_steiner_points_on_boundary_ = x;
+            options_.allow_steiner_points_on_boundary = x;
         }
 
         /**
@@ -58,7 +78,7 @@ namespace easy3d {
          * http://wias-berlin.de/software/tetgen/1.5/doc/manual/manual005.html#cmd-q
          * \sa set_max_dihedral_angle()
          */
-        void set_max_tet_shape(double x) { max_tet_shape_ = x; }
+        void set_max_tet_shape(double x) { options_.max_tet_shape = x; }
 
         /**
          * Sets the minimum allowable dihedral angle. Default value is 0.
@@ -67,7 +87,7 @@ namespace easy3d {
          * http://wias-berlin.de/software/tetgen/1.5/doc/manual/manual005.html#cmd-q
          * \sa set_max_tet_shape()
          */
-        void set_min_dihedral_angle(double x) { min_dihedral_angle_ = x; }
+        void set_min_dihedral_angle(double x) { options_.min_dihedral_angle = x; }
 
         /**
          * Sets the maximum volume constraint on all tetrahedra. Default value is -1 (no max volume constraint).
@@ -76,19 +96,28 @@ namespace easy3d {
          * More complicated constraints can be set by using set_command_line(). See the "-a" switch in tetgen manual.
          * http://wias-berlin.de/software/tetgen/1.5/doc/manual/manual005.html#cmd-a
          */
-        void set_max_tet_volume(double x) { max_tet_volume_ = x; }
+        void set_max_tet_volume(double x) { options_.max_tet_volume = x; }
 
         /**
          * If enabled, assigns an additional attribute (an integer number) to each tetrahedron that identifies to what
          * facet-bounded region it belongs. In the output mesh, all tetrahedra in the same region will get a
          * corresponding non-zero attribute.
          */
-        void set_tag_regions(bool x) { tag_regions_ = x; }
+        void set_tag_regions(bool x) { options_.tag_regions = x; }
 
         /** If specified, overrides all other options. */
-        void set_command_line(const std::string &x) { command_line_ = x; }
+        void set_command_line(const std::string &x) { options_.command_line = x; }
 
-        /** Performs tetrahedralization on the input mesh. */
+        /** Sets all options at once. \sa Options */
+        void set_options(const Options& options) { options_ = options; }
+
+        /**
+         * Performs tetrahedralization on the input mesh.
+         * \details The intermediate tetgen structures are released as the output mesh is
+         *      built (the input copy right after tetrahedralization, each output array as
+         *      soon as it has been consumed), so the peak memory is close to the larger of
+         *      the tetgen run and the final mesh instead of their sum.
+         */
         PolyMesh* apply(SurfaceMesh *mesh);
 
     protected:
@@ -96,12 +125,7 @@ namespace easy3d {
         PolyMesh* to_easy3d_poly_mesh(tetgenio* volume);
 
     private:
-        bool allow_steiner_points_on_boundary_;
-        bool tag_regions_;
-        double max_tet_shape_;
-        double min_dihedral_angle_;
-        double max_tet_volume_;
-        std::string command_line_;
+        Options options_;
     };
 
 }
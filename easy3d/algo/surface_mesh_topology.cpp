@@ -28,6 +28,26 @@
 
 namespace easy3d {
 
+    // \cond
+    namespace details {
+
+        // the border counts of the components analyzed so far, cached on the mesh and valid
+        // as long as the mesh's structural version has not changed
+        struct TopologyRecord {
+            int component;          // the index of the component's first vertex
+            std::size_t number_of_borders;
+            std::size_t largest_border_size;
+        };
+
+        struct TopologyCache {
+            TopologyCache() : version(0) {}
+            std::size_t version;
+            std::vector<TopologyRecord> records;
+        };
+
+    }
+    // \endcond
+
 
     SurfaceMeshTopology::SurfaceMeshTopology(const SurfaceMeshComponent *comp) {
         component_ = comp;
@@ -35,6 +55,26 @@ namespace easy3d {
 
         number_of_borders_ = 0;
         largest_border_size_ = 0;
+        if (comp->n_vertices() == 0)
+            return;
+
+        // reuse the cached result if the mesh has not been structurally edited since it was
+        // computed. The cache is kept in a model property of a type unknown to the file io,
+        // so it is never serialized.
+        auto cache = mesh->model_property<details::TopologyCache>("SurfaceMeshTopology:cache");
+        const int key = comp->vertices().front().idx();
+        if (cache[0].version == mesh->structural_version()) {
+            for (const auto &record : cache[0].records) {
+                if (record.component == key) {
+                    number_of_borders_ = record.number_of_borders;
+                    largest_border_size_ = record.largest_border_size;
+                    return;
+                }
+            }
+        } else {
+            cache[0].version = mesh->structural_version();
+            cache[0].records.clear();
+        }
 
         auto is_marked = mesh->add_halfedge_property<bool>("SurfaceMeshTopology:is_marked");
 
@@ -53,6 +93,9 @@ namespace easy3d {
         }
 
         mesh->remove_halfedge_property(is_marked);
+
+        const details::TopologyRecord record = {key, number_of_borders_, largest_border_size_};
+        cache[0].records.push_back(record);
     }
 
 
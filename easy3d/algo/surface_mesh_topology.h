@@ -33,6 +33,9 @@ namespace easy3d {
     class SurfaceMeshComponent;
 
     /// \brief Compute various topological characteristics of a surface mesh component.
+    /// \details The border counts are cached on the mesh and keyed to its structural version
+    ///     (see SurfaceMesh::structural_version()), so querying an unmodified mesh repeatedly
+    ///     costs O(1); only structural edits trigger a recount.
     /// \class SurfaceMeshTopology easy3d/algo/surface_mesh_topology.h
     class SurfaceMeshTopology {
     public:
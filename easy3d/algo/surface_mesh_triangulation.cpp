@@ -37,8 +37,27 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
     void SurfaceMeshTriangulation::triangulate(Objective o) {
-        for (auto f: mesh_->faces())
-            triangulate(f, o);
+        objective_ = o;
+
+        // Planning the triangulation of a face only reads the mesh and every face is
+        // independent, so all faces are planned in parallel; the topology changes are
+        // applied in one serial pass afterwards.
+        const int num_faces = static_cast<int>(mesh_->faces_size());
+        std::vector<Plan> plans(num_faces);
+        std::vector<char> has_plan(num_faces, 0);
+#pragma omp parallel for schedule(dynamic, 1024)
+        for (int i = 0; i < num_faces; ++i) {
+            const SurfaceMesh::Face f(i);
+            if (mesh_->has_garbage() && mesh_->is_deleted(f))
+                continue;
+            if (compute_plan(f, plans[i]))
+                has_plan[i] = 1;
+        }
+
+        for (int i = 0; i < num_faces; ++i) {
+            if (has_plan[i])
+                apply_plan(plans[i]);
+        }
     }
 
     //-----------------------------------------------------------------------------
@@ -47,39 +66,44 @@ namespace easy3d {
         // store objective
         objective_ = o;
 
+        Plan plan;
+        if (compute_plan(f, plan))
+            apply_plan(plan);
+    }
+
+    //-----------------------------------------------------------------------------
 
+    bool SurfaceMeshTriangulation::compute_plan(SurfaceMesh::Face f, Plan &plan) const {
         // collect polygon halfedges
         SurfaceMesh::Halfedge h0 = mesh_->halfedge(f);
-        halfedges_.clear();
-        vertices_.clear();
+        std::vector<SurfaceMesh::Halfedge> &halfedges = plan.halfedges;
+        std::vector<SurfaceMesh::Vertex> &vertices = plan.vertices;
         SurfaceMesh::Halfedge h = h0;
         do {
             if (!mesh_->is_manifold(mesh_->target(h))) {
                 std::cerr << "[SurfaceMeshTriangulation] Non-manifold polygon\n";
-                return;
+                return false;
             }
 
-            halfedges_.push_back(h);
-            vertices_.push_back(mesh_->target(h));
+            halfedges.push_back(h);
+            vertices.push_back(mesh_->target(h));
         } while ((h = mesh_->next(h)) != h0);
 
         // do we have at least four vertices?
-        const int n = halfedges_.size();
-        if (n <= 3) return;
+        const int n = halfedges.size();
+        if (n <= 3) return false;
 
         // compute minimal triangulation by dynamic programming
-        weight_.clear();
-        weight_.resize(n, std::vector<float>(n, FLT_MAX));
-        index_.clear();
-        index_.resize(n, std::vector<int>(n, 0));
+        std::vector<std::vector<float> > weight(n, std::vector<float>(n, FLT_MAX));
+        std::vector<std::vector<int> > index(n, std::vector<int>(n, 0));
 
         int i, j, m, k, imin;
         float w, wmin;
 
         // initialize 2-gons
         for (i = 0; i < n - 1; ++i) {
-            weight_[i][i + 1] = 0.0;
-            index_[i][i + 1] = -1;
+            weight[i][i + 1] = 0.0;
+            index[i][i + 1] = -1;
         }
 
         // n-gons with n>2
@@ -94,10 +118,10 @@ namespace easy3d {
                 for (m = i + 1; m < k; ++m) {
                     switch (objective_) {
                         case MIN_AREA:
-                            w = weight_[i][m] + compute_weight(i, m, k) + weight_[m][k];
+                            w = weight[i][m] + compute_weight(vertices, i, m, k) + weight[m][k];
                             break;
                         case MAX_ANGLE:
-                            w = std::max(weight_[i][m], std::max(compute_weight(i, m, k), weight_[m][k]));
+                            w = std::max(weight[i][m], std::max(compute_weight(vertices, i, m, k), weight[m][k]));
                             break;
                         default:
                             // should never happen
@@ -111,12 +135,12 @@ namespace easy3d {
                     }
                 }
 
-                weight_[i][k] = wmin;
-                index_[i][k] = imin;
+                weight[i][k] = wmin;
+                index[i][k] = imin;
             }
         }
 
-        // now add triangles to mesh
+        // record the diagonals, in insertion order
         std::vector<ivec2> todo;
         todo.reserve(n);
         todo.push_back(ivec2(0, n - 1));
@@ -127,29 +151,31 @@ namespace easy3d {
             int end = tri[1];
             if (end - start < 2)
                 continue;
-            int split = index_[start][end];
+            int split = index[start][end];
 
-            insert_edge(start, split);
-            insert_edge(split, end);
+            plan.diagonals.emplace_back(start, split);
+            plan.diagonals.emplace_back(split, end);
 
             todo.push_back(ivec2(start, split));
             todo.push_back(ivec2(split, end));
         }
+        return true;
+    }
 
+    //-----------------------------------------------------------------------------
 
-        // clean up
-        weight_.clear();
-        index_.clear();
-        halfedges_.clear();
-        vertices_.clear();
+    void SurfaceMeshTriangulation::apply_plan(Plan &plan) {
+        for (std::size_t i = 0; i < plan.diagonals.size(); ++i)
+            insert_edge(plan, plan.diagonals[i].first, plan.diagonals[i].second);
     }
 
     //-----------------------------------------------------------------------------
 
-    float SurfaceMeshTriangulation::compute_weight(int i, int j, int k) const {
-        const SurfaceMesh::Vertex a = vertices_[i];
-        const SurfaceMesh::Vertex b = vertices_[j];
-        const SurfaceMesh::Vertex c = vertices_[k];
+    float SurfaceMeshTriangulation::compute_weight(const std::vector<SurfaceMesh::Vertex> &vertices,
+                                                   int i, int j, int k) const {
+        const SurfaceMesh::Vertex a = vertices[i];
+        const SurfaceMesh::Vertex b = vertices[j];
+        const SurfaceMesh::Vertex c = vertices[k];
 
         // if one of the potential edges already exists as NON-boundary edge
         // this would result in an invalid triangulation
@@ -205,11 +231,11 @@ namespace easy3d {
 
     //-----------------------------------------------------------------------------
 
-    bool SurfaceMeshTriangulation::insert_edge(int i, int j) {
-        SurfaceMesh::Halfedge h0 = halfedges_[i];
-        SurfaceMesh::Halfedge h1 = halfedges_[j];
-        SurfaceMesh::Vertex v0 = vertices_[i];
-        SurfaceMesh::Vertex v1 = vertices_[j];
+    bool SurfaceMeshTriangulation::insert_edge(Plan &plan, int i, int j) {
+        SurfaceMesh::Halfedge h0 = plan.halfedges[i];
+        SurfaceMesh::Halfedge h1 = plan.halfedges[j];
+        SurfaceMesh::Vertex v0 = plan.vertices[i];
+        SurfaceMesh::Vertex v1 = plan.vertices[j];
 
         // does edge already exist?
         if (mesh_->find_halfedge(v0, v1).is_valid()) {
@@ -53,7 +53,10 @@ namespace easy3d {
 
         SurfaceMeshTriangulation(SurfaceMesh *mesh);
 
-        //! \brief triangulate all faces
+        //! \brief triangulate all faces.
+        //! \details The optimal triangulation of each face is independent of the others, so
+        //! the faces are planned in parallel batches; only the topology changes are applied
+        //! to the mesh afterwards, in one serial pass.
         void triangulate(Objective obj = MIN_AREA);
 
         //! \brief triangulate a particular face f
@@ -61,8 +64,23 @@ namespace easy3d {
 
     private:
 
-        // compute the weight of the triangle (i,j,k).
-        float compute_weight(int i, int j, int k) const;
+        // the triangulation of one face: its boundary ring and the diagonals to insert
+        // (as index pairs into the ring, in insertion order)
+        struct Plan {
+            std::vector<SurfaceMesh::Halfedge> halfedges;
+            std::vector<SurfaceMesh::Vertex> vertices;
+            std::vector< std::pair<int, int> > diagonals;
+        };
+
+        // compute the optimal triangulation of face f (read-only, thus thread-safe).
+        // returns false if the face needs no triangulation or cannot be triangulated.
+        bool compute_plan(SurfaceMesh::Face f, Plan &plan) const;
+
+        // insert the planned diagonals into the mesh
+        void apply_plan(Plan &plan);
+
+        // compute the weight of the triangle (i,j,k) of the polygon's vertex ring.
+        float compute_weight(const std::vector<SurfaceMesh::Vertex> &vertices, int i, int j, int k) const;
 
         // does edge (a,b) exist?
         bool is_edge(SurfaceMesh::Vertex a, SurfaceMesh::Vertex b) const;
@@ -70,8 +88,8 @@ namespace easy3d {
         // does edge (a,b) exist and is non-boundary?
         bool is_interior_edge(SurfaceMesh::Vertex a, SurfaceMesh::Vertex b) const;
 
-        // add edges from vertex i to j
-        bool insert_edge(int i, int j);
+        // add edges from vertex i to j of the polygon's ring
+        bool insert_edge(Plan &plan, int i, int j);
 
 
     private:
@@ -79,12 +97,6 @@ namespace easy3d {
         // mesh and properties
         SurfaceMesh *mesh_;
         SurfaceMesh::VertexProperty <vec3> points_;
-        std::vector<SurfaceMesh::Halfedge> halfedges_;
-        std::vector<SurfaceMesh::Vertex> vertices_;
-
-        // data for computing optimal triangulation
-        std::vector<std::vector<float> > weight_;
-        std::vector<std::vector<int> > index_;
     };
 
 } // namespace easy3d
@@ -25,7 +25,7 @@
 #include <easy3d/algo/tessellator.h>
 
 #include <vector>
-#include <unordered_map>
+#include <cstring>
 
 #include <easy3d/core/hash.h>
 #include <easy3d/util/logging.h>
@@ -39,6 +39,9 @@ namespace easy3d {
     namespace details {
 
         // VertexManager manages the actual vertices to make sure that the points are unique.
+        // The lookup uses a preallocated open-addressing hash table (linear probing, power-of-two
+        // capacity) keyed on the bit-exact vertex data: two vertices are merged only if all their
+        // data fields are identical, so a hash collision can never merge two distinct points.
         class VertexManager {
         public:
             VertexManager() {}
@@ -50,42 +53,80 @@ namespace easy3d {
                 return unique_vertices_;
             }
 
+            // pre-allocates for n unique vertices (at most half of the table gets occupied,
+            // keeping the probe sequences short).
+            void reserve(std::size_t n) {
+                unique_vertices_.reserve(n);
+                std::size_t capacity = MIN_CAPACITY;
+                while (capacity < n * 2)
+                    capacity <<= 1;
+                rehash(capacity);
+            }
+
             inline Tessellator::Vertex *find_or_create(const Tessellator::Vertex &v) {
-                uint64_t key = hash(v.begin(), v.end());
-                auto pos = hash_table_.find(key);
-                if (pos == hash_table_.end()) {
-                    auto vertex = new Tessellator::Vertex(v, v.index);
-                    hash_table_[key] = unique_vertices_.size();
-                    unique_vertices_.push_back(vertex);
-                    return vertex;
-                } else {
-#ifndef NDEBUG
-                    if (distance2(vec3(unique_vertices_[pos->second]->data()), vec3(v.data())) > 1e-6) {
-                        LOG_FIRST_N(ERROR, 5) << "bad: two distinct points have the same hash key\n"
-                                              << "\t\tpoint: " << vec3(unique_vertices_[pos->second]->data()) << " <-> "
-                                              << vec3(v.data()) << "\n" << "\t\thash key: " << key;
-                    }
-#endif
-                    return unique_vertices_[pos->second];
+                if ((unique_vertices_.size() + 1) * 2 > table_.size())
+                    rehash(table_.empty() ? std::size_t(MIN_CAPACITY) : table_.size() * 2);
+                std::size_t slot = hash_bytes(v.data(), v.size() * sizeof(double)) & (table_.size() - 1);
+                while (table_[slot] != NO_ENTRY) {
+                    Tessellator::Vertex *cached = unique_vertices_[table_[slot]];
+                    if (equal(*cached, v))
+                        return cached;
+                    slot = (slot + 1) & (table_.size() - 1);
                 }
+                auto vertex = new Tessellator::Vertex(v, v.index);
+                table_[slot] = unique_vertices_.size();
+                unique_vertices_.push_back(vertex);
+                return vertex;
             }
 
             inline void clear() {
                 for (auto vertex : unique_vertices_)
                     delete vertex;
                 unique_vertices_.clear();
-                hash_table_.clear();
+                table_.clear();
             }
 
-            inline std::size_t vertex_id(const Tessellator::Vertex &v) {
-                return hash_table_[hash(v.begin(), v.end())];
+            inline std::size_t vertex_id(const Tessellator::Vertex &v) const {
+                if (table_.empty())
+                    return 0;
+                std::size_t slot = hash_bytes(v.data(), v.size() * sizeof(double)) & (table_.size() - 1);
+                while (table_[slot] != NO_ENTRY) {
+                    if (equal(*unique_vertices_[table_[slot]], v))
+                        return table_[slot];
+                    slot = (slot + 1) & (table_.size() - 1);
+                }
+                return 0; // cannot happen for vertices that went through find_or_create()
             }
 
         private:
+            static bool equal(const Tessellator::Vertex &a, const Tessellator::Vertex &b) {
+                return a.size() == b.size() &&
+                       std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+            }
+
+            // (re)allocates the table and re-inserts the existing vertices.
+            void rehash(std::size_t capacity) {
+                if (capacity <= table_.size())
+                    return;
+                table_.assign(capacity, std::size_t(NO_ENTRY));
+                for (std::size_t i = 0; i < unique_vertices_.size(); ++i) {
+                    const Tessellator::Vertex *v = unique_vertices_[i];
+                    std::size_t slot = hash_bytes(v->data(), v->size() * sizeof(double)) & (capacity - 1);
+                    while (table_[slot] != NO_ENTRY)
+                        slot = (slot + 1) & (capacity - 1);
+                    table_[slot] = i;
+                }
+            }
+
+            enum : std::size_t {
+                NO_ENTRY = static_cast<std::size_t>(-1),
+                MIN_CAPACITY = 1024
+            };
+
             std::vector<Tessellator::Vertex *> unique_vertices_;
 
-            // key -> index
-            std::unordered_map<uint64_t, std::size_t> hash_table_;
+            // slot -> index into 'unique_vertices_' (NO_ENTRY for an empty slot)
+            std::vector<std::size_t> table_;
         };
     }
     //  \endcond
@@ -138,6 +179,11 @@ namespace easy3d {
     }
 
 
+    void Tessellator::reserve(std::size_t n) {
+        reinterpret_cast<details::VertexManager *>(vertex_manager_)->reserve(n);
+    }
+
+
     void Tessellator::begin_polygon(const vec3 &normal) {
         num_elements_in_polygon_ = 0;
         TessNormal(get_tess(tess_obj_), normal.x, normal.y, normal.z);
@@ -152,6 +152,16 @@ namespace easy3d {
          */
         void set_winding_rule(WindingRule rule);
 
+        /**
+         * \brief Pre-allocate storage for the expected number of unique vertices.
+         * \details The tessellator removes duplicate vertices, and the lookup structure grows on demand as vertices
+         *        are added. When the number of vertices is (roughly) known in advance, e.g., when rebuilding the
+         *        rendering buffers of a large model, reserving the storage up front avoids the repeated growing and
+         *        rehashing of the lookup structure.
+         * @param n The expected number of unique vertices.
+         */
+        void reserve(std::size_t n);
+
         /**
          * @brief Begin the tessellation of a complex polygon.
          * @details This function lets the user supply the polygon normal if known (to improve robustness or to achieve
@@ -32,6 +32,7 @@
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/string.h>
 #include <easy3d/util/progress.h>
+#include <easy3d/util/thread_pool.h>
 
 #define STB_TRUETYPE_IMPLEMENTATION
 
@@ -67,6 +68,7 @@ namespace easy3d {
 
         ready_ = false;
         font_data_.clear();
+        glyph_cache_.clear();
 
         auto read_font_file = [](const std::string &font_file, std::vector<unsigned char> &data) -> int {
             auto fp = fopen(font_file.c_str(), "rb");
@@ -177,24 +179,48 @@ namespace easy3d {
     }
 
 
+    const TextMesher::CachedGlyph *TextMesher::_get_glyph(int codepoint, int font_size) {
+        const long long key = (static_cast<long long>(codepoint) << 32) | static_cast<long long>(font_size);
+        auto pos = glyph_cache_.find(key);
+        if (pos != glyph_cache_.end())
+            return &pos->second;
+
+        CachedGlyph glyph;
+        float x = 0.0f, y = 0.0f;
+        if (_generate_contours(codepoint, x, y, font_size, glyph.contours)) {
+            // resolve intersections and determine interior/exterior for the char.
+            csg::tessellate(glyph.contours, Tessellator::WINDING_ODD);
+        }
+        glyph.advance = x;
+
+        return &(glyph_cache_[key] = glyph);
+    }
+
+
     bool TextMesher::_generate_contours(const std::wstring &text, float x, float y, int font_size,
                                         std::vector<std::vector<Polygon2> > &results, bool collision_free) {
         if (!ready_)
             return false;
 
+        // instantiate a cached glyph at the pen position
+        auto instantiate = [](const CachedGlyph *glyph, float x, float y, std::vector<Polygon2> &contours) {
+            for (const auto &contour : glyph->contours) {
+                Polygon2 c = contour;
+                for (auto &p : c)
+                    p += vec2(x, y);
+                contours.push_back(c);
+            }
+        };
+
         if (collision_free) {
             std::vector<Polygon2> all_contours;
             for (int i = 0; i < text.size(); ++i) {
                 const int codepoint = static_cast<int>(text[i]);
                 //std::cout << i << ": " << string::to_string({text[i]}) << ", codepoint: " << codepoint << std::endl;
-                std::vector<Polygon2> contours;
-                if (_generate_contours(codepoint, x, y, font_size, contours)) {
-                    if (collision_free) {
-                        // resolve intersections and determine interior/exterior for each char.
-                        csg::tessellate(contours, Tessellator::WINDING_ODD);
-                        all_contours.insert(all_contours.end(), contours.begin(), contours.end());
-                    }
-                }
+                const CachedGlyph *glyph = _get_glyph(codepoint, font_size);
+                if (!glyph->contours.empty())
+                    instantiate(glyph, x, y, all_contours);
+                x += glyph->advance;
             }
             // compute the union of all characters.
             csg::tessellate(all_contours, Tessellator::WINDING_NONZERO); // the union of the neighboring chars
@@ -203,12 +229,13 @@ namespace easy3d {
             for (int i = 0; i < text.size(); ++i) {
                 const int codepoint = static_cast<int>(text[i]);
                 //std::cout << i << ": " << string::to_string({text[i]}) << ", codepoint: " << codepoint << std::endl;
-                std::vector<Polygon2> contours;
-                if (_generate_contours(codepoint, x, y, font_size, contours)) {
-                    // resolve intersections and determine interior/exterior for each char.
-                    csg::tessellate(contours, Tessellator::WINDING_ODD);
+                const CachedGlyph *glyph = _get_glyph(codepoint, font_size);
+                if (!glyph->contours.empty()) {
+                    std::vector<Polygon2> contours;
+                    instantiate(glyph, x, y, contours);
                     results.push_back(contours);
                 }
+                x += glyph->advance;
             }
         }
 
@@ -262,9 +289,34 @@ namespace easy3d {
             return false;
         }
 
-        ProgressLogger progress(contours.size());
-        for (const auto &contour : contours) {
-            extrude(mesh, contour, height);
+        // the characters are independent of each other, so they are extruded in parallel. Grain
+        // size 1 because the per-character cost varies a lot (e.g., 'i' vs '@').
+        std::vector<SurfaceMesh *> pieces(contours.size(), nullptr);
+        ThreadPool::global().parallel_for(0, contours.size(), [&](std::size_t i) {
+            pieces[i] = extrude(contours[i], height);
+        }, 1);
+
+        // appending the pieces to the output mesh must be serial
+        ProgressLogger progress(pieces.size());
+        for (auto piece : pieces) {
+            // when canceled, keep the characters appended so far but still free the rest
+            if (progress.is_canceled()) {
+                delete piece;
+                continue;
+            }
+            if (piece) {
+                const int offset = static_cast<int>(mesh->n_vertices());
+                auto points = piece->get_vertex_property<vec3>("v:point");
+                for (auto v : piece->vertices())
+                    mesh->add_vertex(points[v]);
+                for (auto f : piece->faces()) {
+                    std::vector<SurfaceMesh::Vertex> vertices;
+                    for (auto v : piece->vertices(f))
+                        vertices.push_back(SurfaceMesh::Vertex(v.idx() + offset));
+                    mesh->add_face(vertices);
+                }
+                delete piece;
+            }
             progress.next();
         }
 
@@ -27,6 +27,7 @@
 #define EASY3D_ALGO_TEXT_MESHER_H
 
 #include <string>
+#include <unordered_map>
 
 #include <easy3d/core/types.h>
 
@@ -134,6 +135,24 @@ namespace easy3d {
          */
         bool _generate_contours(int codepoint, float &x, float &y, int font_size, std::vector<Polygon2> &contours);
 
+        // a character meshed at the origin (see _get_glyph())
+        struct CachedGlyph {
+            std::vector<Polygon2> contours; // the tessellated (i.e., intersection-free) contours
+            float advance;                  // the x advance to the subsequent character
+            CachedGlyph() : advance(0.0f) {}
+        };
+
+        /**
+         * @brief Return the cached glyph of a character, generating it on first use.
+         * @details The expensive part of meshing a character (extracting its outlines and resolving their
+         *      intersections with the tessellator) depends only on the character and the font size, so the
+         *      result is generated at the origin, cached, and every occurrence is instantiated by translating
+         *      a copy to the pen position. The cache is cleared when the font changes.
+         * @note The contours of the returned glyph are empty if the character has no geometry (e.g., a space)
+         *      or is not supported by the font; its advance is still valid.
+         */
+        const CachedGlyph *_get_glyph(int codepoint, int font_size);
+
     private:
         void *font_;
         bool ready_;
@@ -144,6 +163,9 @@ namespace easy3d {
         // Controls the smoothness of the curved corners. A greater value results in a smooth transitions but more
         // vertices. Suggested value is 4.
         unsigned short bezier_steps_;
+
+        // the cached glyphs of the current font. Key: (codepoint, font_size). See _get_glyph().
+        std::unordered_map<long long, CachedGlyph> glyph_cache_;
     };
 
 }
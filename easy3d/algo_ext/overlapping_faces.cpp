@@ -24,6 +24,11 @@
 
 #include <easy3d/algo_ext/overlapping_faces.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <map>
 #include <set>
 #include <unordered_map>
 
@@ -31,9 +36,31 @@
 #include <easy3d/core/manifold_builder.h>
 #include <easy3d/util/logging.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 namespace easy3d {
 
+    namespace details {
+
+        // \cond
+
+        // Pack a quantized 3D cell coordinate into a hash key. 21 bits per axis (offset to
+        // keep the coordinates non-negative) are plenty for any mesh whose extent is a
+        // reasonable multiple of the cell size.
+        inline std::uint64_t cell_key(int x, int y, int z) {
+            const std::uint64_t mask = (1u << 21) - 1;
+            return ((static_cast<std::uint64_t>(x + (1 << 20)) & mask) << 42) |
+                   ((static_cast<std::uint64_t>(y + (1 << 20)) & mask) << 21) |
+                    (static_cast<std::uint64_t>(z + (1 << 20)) & mask);
+        }
+
+        // \endcond
+
+    } // namespace details
+
 
     OverlappingFaces::Triangles OverlappingFaces::mesh_to_cgal_triangle_list(SurfaceMesh* mesh) {
         auto prop = mesh->get_vertex_property<vec3>("v:point");
@@ -157,28 +184,119 @@ namespace easy3d {
 
         triangle_faces_ = mesh_to_cgal_triangle_list(mesh);
 
-        // bounding boxes of the triangles
-        std::vector<Box> boxes;
-        for (TrianglesIterator it = triangle_faces_.begin(); it != triangle_faces_.end(); ++it) {
-            if (!it->triangle.is_degenerate())
-                boxes.push_back(Box(it->triangle.bbox(), it));
+        // Candidate pruning by a spatial hash of the quantized triangle centroids. Two
+        // overlapping triangles (duplicate or folding) have intersecting bounding boxes, so
+        // with a cell size of twice the largest triangle extent their centroids fall into the
+        // same or adjacent cells - only those pairs need the exact test. Compared to the
+        // earlier all-pairs box intersection this never materializes the full candidate list:
+        // the mesh is swept in blocks of cells along its longest axis, and only the hash of
+        // the current and the next block is kept alive.
+
+        const int num_triangles = static_cast<int>(triangle_faces_.size());
+        if (num_triangles == 0)
+            return;
+
+        // centroids, quantized cells, and the cell size (from the largest triangle extent)
+        std::vector<CGAL::Bbox_3> bboxes(num_triangles);
+        double max_extent = 0.0;
+        CGAL::Bbox_3 mesh_bbox = triangle_faces_[0].triangle.bbox();
+        for (int i = 0; i < num_triangles; ++i) {
+            bboxes[i] = triangle_faces_[i].triangle.bbox();
+            max_extent = std::max(max_extent, bboxes[i].xmax() - bboxes[i].xmin());
+            max_extent = std::max(max_extent, bboxes[i].ymax() - bboxes[i].ymin());
+            max_extent = std::max(max_extent, bboxes[i].zmax() - bboxes[i].zmin());
+            mesh_bbox = mesh_bbox + bboxes[i];
+        }
+        const double cell_size = 2.0 * max_extent + dist_threshold;
+        if (cell_size <= 0.0)
+            return;
+
+        auto cell_of = [cell_size](const CGAL::Bbox_3& b, int axis) -> int {
+            const double c = (b.min(axis) + b.max(axis)) * 0.5;     // centroid of the box
+            return static_cast<int>(std::floor(c / cell_size));
+        };
+
+        // group the triangles into blocks of cells along the longest axis of the mesh
+        int sweep_axis = 0;
+        if (mesh_bbox.ymax() - mesh_bbox.ymin() > mesh_bbox.xmax() - mesh_bbox.xmin())
+            sweep_axis = 1;
+        if (mesh_bbox.zmax() - mesh_bbox.zmin() > mesh_bbox.max(sweep_axis) - mesh_bbox.min(sweep_axis))
+            sweep_axis = 2;
+
+        std::map< int, std::vector<int> > blocks;   // cell coordinate along the sweep axis -> triangles
+        for (int i = 0; i < num_triangles; ++i) {
+            if (!triangle_faces_[i].triangle.is_degenerate())
+                blocks[cell_of(bboxes[i], sweep_axis)].push_back(i);
         }
-        std::vector< std::pair<TrianglesIterator, TrianglesIterator> > intersecting_boxes;
-        auto cb = [&intersecting_boxes](const Box &a, const Box &b) {
-            intersecting_boxes.push_back({ a.handle(), b.handle() });
+
+        const double sqr_eps = dist_threshold * dist_threshold;
+        const double eps = dist_threshold;
+
+        // the spatial hash of one block of cells
+        typedef std::unordered_map< std::uint64_t, std::vector<int> > SpatialHash;
+        auto build_hash = [&](const std::vector<int>& triangles, SpatialHash& hash) {
+            hash.clear();
+            for (int i : triangles)
+                hash[details::cell_key(cell_of(bboxes[i], 0), cell_of(bboxes[i], 1), cell_of(bboxes[i], 2))].push_back(i);
         };
-        CGAL::box_self_intersection_d(boxes.begin(), boxes.end(), cb);
-
-        double sqr_eps = dist_threshold * dist_threshold;
-        for (const auto& b : intersecting_boxes) {
-            const Triangle& ta = *b.first;
-            const Triangle& tb = *b.second;
-
-            auto type = do_overlap(ta, tb, sqr_eps);
-            if (type == OT_SAME)
-                duplicate_faces.emplace_back(std::make_pair(ta.face, tb.face));
-            else if (type == OT_FOLDING)
-                folding_faces.emplace_back(std::make_pair(ta.face, tb.face));
+
+        std::vector< std::pair<int, int> > candidates;
+        std::vector<char> types;
+        for (auto block = blocks.begin(); block != blocks.end(); ++block) {
+            SpatialHash hash;
+            build_hash(block->second, hash);
+            auto next_block = std::next(block);
+            if (next_block != blocks.end() && next_block->first == block->first + 1) {
+                SpatialHash next_hash;
+                build_hash(next_block->second, next_hash);
+                hash.insert(next_hash.begin(), next_hash.end());
+            }
+
+            // candidate pairs: same or adjacent cells, overlapping (eps-enlarged) boxes.
+            // Triangles of the next block only answer queries here, they never issue them,
+            // so a cross-block pair is found exactly once; within the block, the index
+            // order breaks the tie.
+            candidates.clear();
+            for (int a : block->second) {
+                const int cx = cell_of(bboxes[a], 0);
+                const int cy = cell_of(bboxes[a], 1);
+                const int cz = cell_of(bboxes[a], 2);
+                for (int dx = -1; dx <= 1; ++dx) {
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dz = -1; dz <= 1; ++dz) {
+                            auto pos = hash.find(details::cell_key(cx + dx, cy + dy, cz + dz));
+                            if (pos == hash.end())
+                                continue;
+                            for (int b : pos->second) {
+                                if (b <= a && cell_of(bboxes[b], sweep_axis) == block->first)
+                                    continue;   // same block: handled when the roles are swapped
+                                if (bboxes[a].xmin() > bboxes[b].xmax() + eps || bboxes[b].xmin() > bboxes[a].xmax() + eps ||
+                                    bboxes[a].ymin() > bboxes[b].ymax() + eps || bboxes[b].ymin() > bboxes[a].ymax() + eps ||
+                                    bboxes[a].zmin() > bboxes[b].zmax() + eps || bboxes[b].zmin() > bboxes[a].zmax() + eps)
+                                    continue;
+                                candidates.emplace_back(a, b);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // the exact tests - the expensive part - run in parallel
+            const int num_candidates = static_cast<int>(candidates.size());
+            types.assign(num_candidates, OT_NONE);
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (int i = 0; i < num_candidates; ++i) {
+                types[i] = static_cast<char>(do_overlap(triangle_faces_[candidates[i].first],
+                                                        triangle_faces_[candidates[i].second], sqr_eps));
+            }
+            for (int i = 0; i < num_candidates; ++i) {
+                const Triangle& ta = triangle_faces_[candidates[i].first];
+                const Triangle& tb = triangle_faces_[candidates[i].second];
+                if (types[i] == OT_SAME)
+                    duplicate_faces.emplace_back(std::make_pair(ta.face, tb.face));
+                else if (types[i] == OT_FOLDING)
+                    folding_faces.emplace_back(std::make_pair(ta.face, tb.face));
+            }
         }
     }
 
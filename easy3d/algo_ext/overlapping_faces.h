@@ -33,7 +33,6 @@
 
 #include <CGAL/Simple_cartesian.h>
 #include <CGAL/intersections.h>	// Triangle triangle intersection
-#include <CGAL/box_intersection_d.h>
 
 #include <easy3d/core/surface_mesh.h>
 
@@ -53,6 +52,9 @@ namespace easy3d {
           * \details Two triangle faces are said duplicate if they have the same geometry (vertices within a distance
           *         threshold). Two triangle faces are said folding if they are coplanar, share one edge (i.e., have
           *         the same edge geometry), and partially overlap.
+          *         Candidate pairs are pruned by a spatial hash of the quantized triangle centroids and the exact
+          *         tests run in parallel; the mesh is swept in spatial blocks, so the peak memory does not depend
+          *         on the number of candidate pairs.
           * \param duplicate_faces Returns the duplicate face pairs found.
           * \param folding_faces Returns the folding face pairs found.
           * \param dist_threshold Two vertices are considered coincident if there distance is smaller than it.
@@ -96,10 +98,8 @@ namespace easy3d {
             std::vector<SurfaceMesh::Vertex> vertices;
         };
 
-        // Axis-align boxes for all-pairs self-intersection detection
         typedef std::vector<Triangle>				Triangles;
         typedef typename Triangles::iterator		TrianglesIterator;
-        typedef CGAL::Box_intersection_d::Box_with_handle_d<double, 3, TrianglesIterator>	Box;
 
     private:
         Triangles mesh_to_cgal_triangle_list(SurfaceMesh* esh);
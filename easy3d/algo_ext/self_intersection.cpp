@@ -28,8 +28,13 @@
 #include <easy3d/util/logging.h>
 #include <easy3d/algo_ext/surfacer.h>
 
+#include <atomic>
 #include <queue>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define REMESH_INTERSECTIONS_TIMING
 
 #ifdef REMESH_INTERSECTIONS_TIMING
@@ -69,25 +74,30 @@ namespace easy3d {
 
         mesh_to_cgal_triangle_list(input_mesh);
 
-        // bounding boxes of the triangles
-        std::vector<Box> boxes;
-        for (TrianglesIterator it = triangle_faces_.begin(); it != triangle_faces_.end(); ++it) {
-            if (!it->triangle.is_degenerate())
-                boxes.push_back(Box(it->triangle.bbox(), it));
-        }
-        std::vector<std::pair<TrianglesIterator, TrianglesIterator> > intersecting_boxes;
-        auto cb = [&intersecting_boxes](const Box &a, const Box &b) {
-            intersecting_boxes.push_back({a.handle(), b.handle()});
-        };
-        CGAL::box_self_intersection_d(boxes.begin(), boxes.end(), cb);
-
-        for (const auto &b : intersecting_boxes) {
-            const Triangle &ta = *b.first;
-            const Triangle &tb = *b.second;
-            if (do_intersect(ta, tb)) {
-                auto fa = original_face[ta.index];
-                auto fb = original_face[tb.index];
-                result.emplace_back(std::make_pair(fa, fb));
+        const auto &pairs = candidate_pairs();
+
+#ifdef _OPENMP
+        if (omp_get_max_threads() > 1 && pairs.size() > 1) {
+            // the exact pair tests are independent: run them on worker threads
+            const auto &hits = test_candidate_pairs(pairs, false);
+            for (std::size_t k = 0; k < pairs.size(); ++k) {
+                if (hits[k]) {
+                    auto fa = original_face[triangle_faces_[pairs[k].first].index];
+                    auto fb = original_face[triangle_faces_[pairs[k].second].index];
+                    result.emplace_back(std::make_pair(fa, fb));
+                }
+            }
+        } else
+#endif
+        {
+            for (const auto &p : pairs) {
+                const Triangle &ta = triangle_faces_[p.first];
+                const Triangle &tb = triangle_faces_[p.second];
+                if (do_intersect(ta, tb)) {
+                    auto fa = original_face[ta.index];
+                    auto fb = original_face[tb.index];
+                    result.emplace_back(std::make_pair(fa, fb));
+                }
             }
         }
 
@@ -105,6 +115,167 @@ namespace easy3d {
     }
 
 
+    bool SelfIntersection::any_intersection(SurfaceMesh *input_mesh) {
+        if (!input_mesh)
+            return false;
+
+        if (!input_mesh->is_triangle_mesh()) {
+            LOG(WARNING) << "input mesh is not a triangulated";
+            return false;
+        }
+
+        construct_intersection_ = false;
+        offending_.clear();
+        total_comb_duplicate_face_ = 0;
+        total_geom_duplicate_face_ = 0;
+
+        mesh_to_cgal_triangle_list(input_mesh);
+
+        const auto &pairs = candidate_pairs();
+
+#ifdef _OPENMP
+        if (omp_get_max_threads() > 1 && pairs.size() > 1) {
+            const auto &hits = test_candidate_pairs(pairs, true);
+            for (const auto h : hits) {
+                if (h)
+                    return true;
+            }
+            return false;
+        }
+#endif
+
+        for (const auto &p : pairs) {
+            if (do_intersect(triangle_faces_[p.first], triangle_faces_[p.second]))
+                return true;
+        }
+        return false;
+    }
+
+
+    std::vector<std::pair<int, int> > SelfIntersection::candidate_pairs() {
+        // bounding boxes of the triangles
+        std::vector<Box> boxes;
+        for (TrianglesIterator it = triangle_faces_.begin(); it != triangle_faces_.end(); ++it) {
+            if (!it->triangle.is_degenerate())
+                boxes.push_back(Box(it->triangle.bbox(), it));
+        }
+
+        const TrianglesIterator first = triangle_faces_.begin();
+        std::vector<std::pair<int, int> > pairs;
+
+#ifdef _OPENMP
+        const int num_threads = omp_get_max_threads();
+        if (num_threads > 1 && boxes.size() > 1) {
+            // partition the boxes and sweep the partitions pairwise in parallel. Every task
+            // works on its own copies of the two partitions, since the sweep reorders the
+            // boxes it is given. A pair with boxes from partitions i and j is reported by
+            // exactly one task, so no duplicates arise.
+            const std::size_t num_parts = num_threads;
+            const std::size_t part_size = (boxes.size() + num_parts - 1) / num_parts;
+            std::vector<std::pair<std::size_t, std::size_t> > tasks;
+            for (std::size_t i = 0; i < num_parts; ++i) {
+                for (std::size_t j = i; j < num_parts; ++j)
+                    tasks.emplace_back(i, j);
+            }
+            std::vector<std::vector<std::pair<int, int> > > task_pairs(tasks.size());
+
+#pragma omp parallel for schedule(dynamic)
+            for (int t = 0; t < static_cast<int>(tasks.size()); ++t) {
+                const std::size_t bi = std::min(tasks[t].first * part_size, boxes.size());
+                const std::size_t ei = std::min(bi + part_size, boxes.size());
+                const std::size_t bj = std::min(tasks[t].second * part_size, boxes.size());
+                const std::size_t ej = std::min(bj + part_size, boxes.size());
+                if (bi == ei || bj == ej)
+                    continue;
+
+                auto &out = task_pairs[t];
+                auto cb = [&out, first](const Box &a, const Box &b) {
+                    out.emplace_back(static_cast<int>(a.handle() - first),
+                                     static_cast<int>(b.handle() - first));
+                };
+
+                std::vector<Box> part_i(boxes.begin() + bi, boxes.begin() + ei);
+                if (tasks[t].first == tasks[t].second)
+                    CGAL::box_self_intersection_d(part_i.begin(), part_i.end(), cb);
+                else {
+                    std::vector<Box> part_j(boxes.begin() + bj, boxes.begin() + ej);
+                    CGAL::box_intersection_d(part_i.begin(), part_i.end(),
+                                             part_j.begin(), part_j.end(), cb);
+                }
+            }
+
+            for (const auto &tp : task_pairs)
+                pairs.insert(pairs.end(), tp.begin(), tp.end());
+            return pairs;
+        }
+#endif
+
+        auto cb = [&pairs, first](const Box &a, const Box &b) {
+            pairs.emplace_back(static_cast<int>(a.handle() - first),
+                               static_cast<int>(b.handle() - first));
+        };
+        CGAL::box_self_intersection_d(boxes.begin(), boxes.end(), cb);
+        return pairs;
+    }
+
+
+    std::vector<unsigned char> SelfIntersection::test_candidate_pairs(
+            const std::vector<std::pair<int, int> > &pairs, bool early_exit) {
+#ifdef _OPENMP
+        const int num_threads = omp_get_max_threads();
+#else
+        const int num_threads = 1;
+#endif
+        // Every worker tests against its own copy of the exact triangles. The lazy-exact
+        // number types of the kernel are reference counted and predicate evaluation updates
+        // the shared representation, which is not safe across threads (see also the remark
+        // on the CDT loop in remesh()). The copies are rebuilt from the double coordinates,
+        // so they represent exactly the same values.
+        std::vector<SelfIntersection> workers(num_threads);
+        for (auto &w : workers) {
+            w.construct_intersection_ = construct_intersection_;
+            w.total_comb_duplicate_face_ = 0;
+            w.total_geom_duplicate_face_ = 0;
+            w.build_triangle_list(mesh_);
+        }
+
+        std::vector<unsigned char> hits(pairs.size(), 0);
+        std::atomic<bool> found(false);
+
+#pragma omp parallel num_threads(num_threads)
+        {
+#ifdef _OPENMP
+            SelfIntersection &w = workers[omp_get_thread_num()];
+#else
+            SelfIntersection &w = workers[0];
+#endif
+#pragma omp for schedule(dynamic, 1024)
+            for (int k = 0; k < static_cast<int>(pairs.size()); ++k) {
+                if (early_exit && found.load(std::memory_order_relaxed))
+                    continue;
+                const Triangle &ta = w.triangle_faces_[pairs[k].first];
+                const Triangle &tb = w.triangle_faces_[pairs[k].second];
+                if (w.do_intersect(ta, tb)) {
+                    hits[k] = 1;
+                    if (early_exit)
+                        found.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // merge the workers' findings
+        for (auto &w : workers) {
+            for (auto &itr : w.offending_) {
+                auto &list = offending_[itr.first];
+                list.insert(list.end(), itr.second.begin(), itr.second.end());
+            }
+            total_comb_duplicate_face_ += w.total_comb_duplicate_face_;
+            total_geom_duplicate_face_ += w.total_geom_duplicate_face_;
+        }
+        return hits;
+    }
+
+
     void SelfIntersection::mark_offensive(int f) {
         if (offending_.count(f) == 0) {
             // first time marking, initialize with new id and empty list
@@ -351,9 +522,6 @@ namespace easy3d {
             delete mesh_;
         mesh_ = new SurfaceMesh(*input_mesh);
 
-        triangle_faces_.clear();
-        original_face.clear();
-
         // degenerate faces will be removed. This remembers the original face
         auto to_input_face = mesh_->add_face_property<SurfaceMesh::Face>("f:original_face");
         for (auto f : mesh_->faces())
@@ -361,11 +529,20 @@ namespace easy3d {
 
         Surfacer::remove_degenerate_faces(mesh_);
 
-        auto prop = mesh_->get_vertex_property<vec3>("v:point");
-        for (auto f : mesh_->faces()) {
+        build_triangle_list(mesh_);
+    }
+
+
+    void SelfIntersection::build_triangle_list(SurfaceMesh *mesh) {
+        triangle_faces_.clear();
+        original_face.clear();
+
+        auto to_input_face = mesh->get_face_property<SurfaceMesh::Face>("f:original_face");
+        auto prop = mesh->get_vertex_property<vec3>("v:point");
+        for (auto f : mesh->faces()) {
             std::vector<Point_3> points;
             std::vector<SurfaceMesh::Vertex> vertices;
-            for (auto v : mesh_->vertices(f)) {
+            for (auto v : mesh->vertices(f)) {
                 const vec3 &p = prop[v];
                 points.push_back(Point_3(p.x, p.y, p.z));
                 vertices.push_back(v);
@@ -74,6 +74,16 @@ namespace easy3d {
         std::vector<std::pair<SurfaceMesh::Face, SurfaceMesh::Face> >
         detect(SurfaceMesh *mesh, bool construct = false);
 
+        /**
+         * \brief Test whether the mesh has at least one pair of intersecting faces.
+         * \details Intended for pass/fail gating. In contrast to detect(), the search stops at the
+         * first intersecting pair found, so a self-intersecting model is typically rejected long
+         * before all candidate pairs have been tested.
+         * @param mesh The input mesh.
+         * @return \c true if any two faces of \p mesh intersect.
+         */
+        bool any_intersection(SurfaceMesh *mesh);
+
         /**
          * \brief Detect and remesh the intersecting faces.
          * @param mesh The input mesh. If self intersection exists, it carries the remeshed model. Otherwise it remains
@@ -129,6 +139,21 @@ namespace easy3d {
 
         void mesh_to_cgal_triangle_list(SurfaceMesh *mesh);
 
+        // fills 'triangle_faces_' with exact triangles built from the vertex positions of an
+        // already cleaned mesh (degenerate faces removed). Every worker thread builds its own
+        // list this way, so no lazy-exact CGAL objects are ever shared across threads.
+        void build_triangle_list(SurfaceMesh *mesh);
+
+        // the candidate pairs (as indices into 'triangle_faces_') whose bounding boxes overlap.
+        // the pairwise box sweeps over a partition of the boxes run in parallel.
+        std::vector<std::pair<int, int> > candidate_pairs();
+
+        // runs the exact tests on the candidate pairs with one worker per thread and merges the
+        // workers' offending lists and statistics into this instance. The returned flags mark
+        // the intersecting pairs. If early_exit is true, the search stops at the first hit.
+        std::vector<unsigned char> test_candidate_pairs(
+                const std::vector<std::pair<int, int> > &pairs, bool early_exit);
+
         // test if two triangles intersect
         bool do_intersect(const Triangle &A, const Triangle &B);
 
@@ -38,6 +38,9 @@
 #include <CGAL/Polygon_mesh_processing/clip.h>
 #include <CGAL/Polygon_mesh_slicer.h>
 
+#include <cstdint>
+#include <cstring>
+
 
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 typedef CGAL::Surface_mesh<K::Point_3>                      CGALMesh;
@@ -92,6 +95,52 @@ namespace easy3d {
         }
 
 
+        std::vector<Surfacer::Polyline> to_easy3d(const std::vector<std::vector<K::Point_3> > &input) {
+            std::vector<Surfacer::Polyline> polylines(input.size());
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                const std::vector<K::Point_3> &pl = input[i];
+                polylines[i].resize(pl.size());
+                for (std::size_t j = 0; j < pl.size(); ++j) {
+                    const auto &p = pl[j];
+                    polylines[i][j] = vec3(
+                            CGAL::to_double(p.x()),
+                            CGAL::to_double(p.y()),
+                            CGAL::to_double(p.z())
+                    );
+                }
+            }
+            return polylines;
+        }
+
+
+        // a cheap fingerprint of a mesh, used to detect geometry or connectivity changes
+        // between calls. Hashing the positions and face corners is orders of magnitude
+        // cheaper than rebuilding the CGAL-side mesh.
+        std::size_t fingerprint(SurfaceMesh *mesh) {
+            std::size_t h = 14695981039346656037ull;
+            auto mix = [&h](std::size_t k) {
+                h ^= k;
+                h *= 1099511628211ull;
+            };
+            mix(mesh->n_vertices());
+            mix(mesh->n_faces());
+            auto points = mesh->get_vertex_property<vec3>("v:point");
+            for (auto v : mesh->vertices()) {
+                const vec3 &p = points[v];
+                std::uint32_t bits[3];
+                std::memcpy(bits, &p, sizeof(bits));
+                mix(bits[0]);
+                mix(bits[1]);
+                mix(bits[2]);
+            }
+            for (auto f : mesh->faces()) {
+                for (auto v : mesh->vertices(f))
+                    mix(static_cast<std::size_t>(v.idx()));
+            }
+            return h;
+        }
+
+
         void to_cgal(const std::vector<vec3> &input_points,
                      const std::vector<Surfacer::Polygon> &input_polygons,
                      std::vector<K::Point_3> &points,
@@ -442,23 +491,6 @@ namespace easy3d {
 
         typedef std::vector<K::Point_3> CGALPolyline;
 
-        auto to_easy3d = [](std::vector<CGALPolyline>& input) -> std::vector<Surfacer::Polyline> {
-            std::vector<Surfacer::Polyline> polylines(input.size());
-            for (std::size_t i = 0; i < input.size(); ++i) {
-                const CGALPolyline &pl = input[i];
-                polylines[i].resize(pl.size());
-                for (std::size_t j = 0; j < pl.size(); ++j) {
-                    const auto &p = pl[j];
-                    polylines[i][j] = vec3(
-                            CGAL::to_double(p.x()),
-                            CGAL::to_double(p.y()),
-                            CGAL::to_double(p.z())
-                    );
-                }
-            }
-            return polylines;
-        };
-
         CGALMesh mesh;
         details::to_cgal(input_mesh, mesh);
         // Slicer constructor from the mesh
@@ -472,7 +504,7 @@ namespace easy3d {
             std::vector<CGALPolyline> lines;
             slicer(plane, std::back_inserter(lines));
 
-            result.push_back(to_easy3d(lines));
+            result.push_back(details::to_easy3d(lines));
         }
 
         return result;
@@ -605,9 +637,130 @@ namespace easy3d {
     }
 
 
+    bool Surfacer::does_self_intersect(SurfaceMesh *mesh) {
+        SelfIntersection msi;
+        return msi.any_intersection(mesh);
+    }
+
+
     bool Surfacer::remesh_self_intersections(SurfaceMesh *mesh, bool stitch /* = true */) {
         SelfIntersection msi;
         return msi.remesh(mesh, stitch);
     }
 
+
+    // \cond
+    struct SurfacerSession::Cache {
+        Cache() : slicer(nullptr), valid(false), fingerprint(0) {}
+
+        ~Cache() { delete slicer; }
+
+        CGALMesh mesh;
+        CGAL::Polygon_mesh_slicer<CGALMesh, K> *slicer; // built lazily on the first slice
+        bool valid;
+        std::size_t fingerprint;
+    };
+    // \endcond
+
+
+    SurfacerSession::SurfacerSession(SurfaceMesh *mesh)
+            : mesh_(mesh), cache_(new Cache) {
+    }
+
+
+    SurfacerSession::~SurfacerSession() {
+        delete cache_;
+    }
+
+
+    void SurfacerSession::validate() {
+        if (cache_->valid && details::fingerprint(mesh_) == cache_->fingerprint)
+            return;
+
+        details::to_cgal(mesh_, cache_->mesh);
+        delete cache_->slicer;
+        cache_->slicer = nullptr;
+
+        // compute the fingerprint after the conversion: to_cgal() may collect garbage,
+        // which changes the element indices
+        cache_->fingerprint = details::fingerprint(mesh_);
+        cache_->valid = true;
+    }
+
+
+    bool SurfacerSession::clip(const Plane3 &input_plane, SurfaceMesh *output, bool clip_volume) {
+        if (!mesh_->is_triangle_mesh()) {
+            LOG(WARNING) << "only triangle meshes can be clipped";
+            return false;
+        }
+
+        validate();
+
+        // clip a copy, so the cached conversion survives for the next call
+        CGALMesh mesh = cache_->mesh;
+
+        Plane_3 plane(input_plane.a(), input_plane.b(), input_plane.c(), input_plane.d());
+        bool status = CGAL::Polygon_mesh_processing::clip(
+                mesh,
+                plane,
+                CGAL::Polygon_mesh_processing::parameters::clip_volume(clip_volume)
+        );
+
+        details::to_easy3d(mesh, output);
+        return status;
+    }
+
+
+    void SurfacerSession::split(const Plane3 &input_plane, SurfaceMesh *output) {
+        if (!mesh_->is_triangle_mesh()) {
+            LOG(WARNING) << "only triangle meshes can be clipped";
+            return;
+        }
+
+        validate();
+
+        // split a copy, so the cached conversion survives for the next call
+        CGALMesh mesh = cache_->mesh;
+
+        Plane_3 plane(input_plane.a(), input_plane.b(), input_plane.c(), input_plane.d());
+        CGAL::Polygon_mesh_processing::split(mesh, plane);
+
+        details::to_easy3d(mesh, output);
+    }
+
+
+    std::vector<Surfacer::Polyline> SurfacerSession::slice(const Plane3 &input_plane) {
+        std::vector<Plane3> planes(1, input_plane);
+        const std::vector< std::vector<Surfacer::Polyline> > &result = slice(planes);
+        if (result.empty())
+            return std::vector<Surfacer::Polyline>();
+        return result[0];
+    }
+
+
+    std::vector< std::vector<Surfacer::Polyline> > SurfacerSession::slice(const std::vector<Plane3> &input_planes) {
+        std::vector< std::vector<Surfacer::Polyline> > result;
+        if (!mesh_->is_triangle_mesh()) {
+            LOG(WARNING) << "only triangle meshes can be clipped";
+            return result;
+        }
+
+        validate();
+
+        // the slicer (and its internal search structures) is reused across calls
+        if (!cache_->slicer)
+            cache_->slicer = new CGAL::Polygon_mesh_slicer<CGALMesh, K>(cache_->mesh);
+
+        for (const auto &input_plane : input_planes) {
+            Plane_3 plane(input_plane.a(), input_plane.b(), input_plane.c(), input_plane.d());
+
+            std::vector<std::vector<K::Point_3> > lines;
+            (*cache_->slicer)(plane, std::back_inserter(lines));
+
+            result.push_back(details::to_easy3d(lines));
+        }
+
+        return result;
+    }
+
 }
@@ -212,6 +212,17 @@ namespace easy3d {
         static std::vector<std::pair<SurfaceMesh::Face, SurfaceMesh::Face> >
         detect_self_intersections(SurfaceMesh *mesh);
 
+        /**
+         * \brief Tests if a triangle surface mesh self-intersects.
+         * \details This is the early-exit counterpart of detect_self_intersections(): the search
+         * stops at the first pair of intersecting faces found, which makes it well suited for
+         * fast pass/fail checks.
+         * \pre mesh.is_triangle_mesh().
+         * @param mesh The triangle surface mesh to be checked.
+         * @return \c true if \p mesh self-intersects.
+         */
+        static bool does_self_intersect(SurfaceMesh *mesh);
+
         /**
          * \brief Detects and remesh the intersecting faces.
          * \pre mesh.is_triangle_mesh().
@@ -285,6 +296,72 @@ namespace easy3d {
         static std::vector< std::vector<Polyline> > slice(SurfaceMesh *mesh, const std::vector<Plane3> &planes);
         //@}
     };
+
+
+    /**
+     * \brief A session for repeated clip/split/slice operations on the same mesh.
+     * \class SurfacerSession easy3d/algo_ext/surfacer.h
+     * \details The one-shot functions of Surfacer convert the input mesh into CGAL's representation
+     * on every call, which dominates the runtime of small repeated operations (e.g., hundreds of
+     * clips against the same base mesh in a CSG tool). A session converts the mesh once and keeps
+     * the CGAL-side copy (and, for slicing, the slicer with its internal search structures) across
+     * calls. The cached conversion is validated against a fingerprint of the mesh and is rebuilt
+     * transparently whenever the mesh's geometry or connectivity has changed.
+     *
+     * In contrast to the Surfacer functions, clip() and split() write their result to a separate
+     * output mesh and leave the session mesh untouched, so the next call can reuse the cache.
+     */
+    class SurfacerSession {
+    public:
+        //! \brief Construct a session operating on \p mesh. The mesh must outlive the session.
+        SurfacerSession(SurfaceMesh *mesh);
+
+        ~SurfacerSession();
+
+        /**
+         * \brief Clips the session mesh. Same as Surfacer::clip(), but the result is written to
+         * \p output and the session mesh remains unchanged.
+         * \pre mesh.is_triangle_mesh(), !does_self_intersect(SurfaceMesh* mesh).
+         * @param plane The clipping plane whose negative side defines the half-space to intersect
+         *        the mesh with.
+         * @param output The mesh receiving the clipped result. May be the session mesh itself, in
+         *        which case the cached conversion is rebuilt on the next call.
+         * @return \c true if the output surface mesh is manifold.
+         */
+        bool clip(const Plane3 &plane, SurfaceMesh *output, bool clip_volume = false);
+
+        /**
+         * \brief Splits the session mesh by a plane. Same as Surfacer::split(), but the result is
+         * written to \p output and the session mesh remains unchanged.
+         * \pre mesh.is_triangle_mesh(), !does_self_intersect(SurfaceMesh* mesh).
+         */
+        void split(const Plane3 &plane, SurfaceMesh *output);
+
+        /**
+         * \brief Computes the intersection of a plane with the session mesh.
+         * Same as Surfacer::slice(), reusing the cached conversion and slicer.
+         * \pre mesh.is_triangle_mesh(), !does_self_intersect(SurfaceMesh* mesh).
+         */
+        std::vector<Surfacer::Polyline> slice(const Plane3 &plane);
+
+        /**
+         * \brief Computes the intersection of a set of planes with the session mesh.
+         * Same as Surfacer::slice(), reusing the cached conversion and slicer.
+         * \pre mesh.is_triangle_mesh(), !does_self_intersect(SurfaceMesh* mesh).
+         */
+        std::vector< std::vector<Surfacer::Polyline> > slice(const std::vector<Plane3> &planes);
+
+    private:
+        // re-converts the mesh if it has changed since the cache was built
+        void validate();
+
+    private:
+        SurfaceMesh *mesh_;
+
+        // holds the CGAL-side data (defined in the .cpp to keep CGAL out of this header)
+        struct Cache;
+        Cache *cache_;
+    };
 }
 
 
@@ -27,6 +27,7 @@
 
 
 #include <vector>
+#include <limits>
 
 
 /**
@@ -41,6 +42,173 @@ namespace easy3d {
      */
     namespace curve {
 
+        /**
+         * \brief Evaluates a quadratic curve at \p num parameters uniformly spaced in [\p t0, \p t1].
+         * \details The curve is converted to the power basis once and the samples are produced by
+         *      forward differencing: each point costs two vector additions instead of a full
+         *      de Casteljau evaluation, so this is the interface to use when a curve has to be
+         *      sampled densely (glyph contours, centerline rendering). The first sample lies at
+         *      \p t0 and the last at \p t1.
+         * @param points Receives the \p num points; must have room for \p num elements.
+         */
+        template<typename Point>
+        inline
+        void quadratic(const Point &A, const Point &B, const Point &C,
+                       typename Point::FT t0, typename Point::FT t1, unsigned int num, Point *points) {
+            typedef typename Point::FT FT;
+            if (num == 0)
+                return;
+            // power-basis coefficients: P(t) = A + t * c1 + t^2 * c2
+            const Point c1 = FT(2) * (B - A);
+            const Point c2 = A - FT(2) * B + C;
+            const FT h = (num > 1) ? (t1 - t0) / static_cast<FT>(num - 1) : FT(0);
+            const Point d2 = (FT(2) * h * h) * c2;  // second difference (constant)
+            // the recurrence is re-seeded in blocks so rounding errors cannot accumulate over
+            // long runs (the amortized cost per sample stays at two vector additions).
+            for (unsigned int i = 0; i < num; ) {
+                const FT t = t0 + static_cast<FT>(i) * h;
+                Point P = A + t * c1 + (t * t) * c2;
+                Point d1 = h * c1 + (FT(2) * t * h + h * h) * c2;    // P(t+h) - P(t)
+                const unsigned int block_end = (num - i > 1024) ? i + 1024 : num;
+                for (; i < block_end; ++i) {
+                    points[i] = P;
+                    P += d1;
+                    d1 += d2;
+                }
+            }
+        }
+
+        /**
+         * \brief Evaluates a cubic curve at \p num parameters uniformly spaced in [\p t0, \p t1].
+         * \details The forward-differencing counterpart of the cubic de Casteljau evaluation; each
+         *      sample costs three vector additions. See quadratic() for details.
+         * @param points Receives the \p num points; must have room for \p num elements.
+         */
+        template<typename Point>
+        inline
+        void cubic(const Point &A, const Point &B, const Point &C, const Point &D,
+                   typename Point::FT t0, typename Point::FT t1, unsigned int num, Point *points) {
+            typedef typename Point::FT FT;
+            if (num == 0)
+                return;
+            // power-basis coefficients: P(t) = A + t * c1 + t^2 * c2 + t^3 * c3
+            const Point c1 = FT(3) * (B - A);
+            const Point c2 = FT(3) * (A - FT(2) * B + C);
+            const Point c3 = D - A + FT(3) * (B - C);
+            const FT h = (num > 1) ? (t1 - t0) / static_cast<FT>(num - 1) : FT(0);
+            const FT h2 = h * h, h3 = h2 * h;
+            const Point d3 = (FT(6) * h3) * c3;  // third difference (constant)
+            // re-seeded in blocks; see quadratic()
+            for (unsigned int i = 0; i < num; ) {
+                const FT t = t0 + static_cast<FT>(i) * h;
+                Point P = A + t * c1 + (t * t) * c2 + (t * t * t) * c3;
+                Point d1 = h * c1 + (FT(2) * t * h + h2) * c2 +
+                           (FT(3) * t * t * h + FT(3) * t * h2 + h3) * c3;
+                Point d2 = (FT(2) * h2) * c2 + (FT(6) * t * h2 + FT(6) * h3) * c3;
+                const unsigned int block_end = (num - i > 1024) ? i + 1024 : num;
+                for (; i < block_end; ++i) {
+                    points[i] = P;
+                    P += d1;
+                    d1 += d2;
+                    d2 += d3;
+                }
+            }
+        }
+
+
+        // \cond
+        namespace details {
+
+            // squared distance from P to the (infinite) line through A and B; falls back to the
+            // squared distance to A when the chord degenerates.
+            template<typename Point>
+            inline typename Point::FT squared_distance_to_line(const Point &P, const Point &A, const Point &B) {
+                typedef typename Point::FT FT;
+                const Point d = B - A;
+                const Point m = P - A;
+                const FT dd = dot(d, d);
+                if (dd <= std::numeric_limits<FT>::min())
+                    return dot(m, m);
+                const Point f = m - (dot(m, d) / dd) * d;
+                return dot(f, f);
+            }
+
+            template<typename Point>
+            inline void adaptive_quadratic(const Point &A, const Point &B, const Point &C,
+                                           std::vector<Point> &curve, typename Point::FT sqr_flatness, int depth) {
+                typedef typename Point::FT FT;
+                if (depth == 0 || squared_distance_to_line(B, A, C) <= sqr_flatness) {
+                    curve.push_back(A);
+                    return;
+                }
+                // split at t = 0.5 (de Casteljau)
+                const Point AB = FT(0.5) * (A + B);
+                const Point BC = FT(0.5) * (B + C);
+                const Point M = FT(0.5) * (AB + BC);
+                adaptive_quadratic(A, AB, M, curve, sqr_flatness, depth - 1);
+                adaptive_quadratic(M, BC, C, curve, sqr_flatness, depth - 1);
+            }
+
+            template<typename Point>
+            inline void adaptive_cubic(const Point &A, const Point &B, const Point &C, const Point &D,
+                                       std::vector<Point> &curve, typename Point::FT sqr_flatness, int depth) {
+                typedef typename Point::FT FT;
+                if (depth == 0 || (squared_distance_to_line(B, A, D) <= sqr_flatness &&
+                                   squared_distance_to_line(C, A, D) <= sqr_flatness)) {
+                    curve.push_back(A);
+                    return;
+                }
+                // split at t = 0.5 (de Casteljau)
+                const Point AB = FT(0.5) * (A + B);
+                const Point BC = FT(0.5) * (B + C);
+                const Point CD = FT(0.5) * (C + D);
+                const Point M = FT(0.5) * (AB + BC);
+                const Point N = FT(0.5) * (BC + CD);
+                const Point MN = FT(0.5) * (M + N);
+                adaptive_cubic(A, AB, M, MN, curve, sqr_flatness, depth - 1);
+                adaptive_cubic(MN, N, CD, D, curve, sqr_flatness, depth - 1);
+            }
+
+        }
+        // \endcond
+
+
+        /**
+         * \brief Tessellates a quadratic curve adaptively, subdividing only where the curve bends.
+         * \details The curve is recursively split until every segment deviates from its chord by
+         *      at most \p flatness, so flat regions get a single segment while tight bends get
+         *      many. For a given visual quality this produces far fewer points than a fixed step
+         *      count. Like the fixed-step overload, the end point is only appended when
+         *      \p include_end is \c true.
+         * @param curve Returns the sequence of points on the curve (appended).
+         * @param flatness The maximum distance allowed between the curve and its polyline
+         *      approximation, in the units of the control points.
+         */
+        template<typename Point>
+        inline
+        void adaptive_quadratic(const Point &A, const Point &B, const Point &C, std::vector<Point> &curve,
+                                typename Point::FT flatness, bool include_end = false) {
+            details::adaptive_quadratic(A, B, C, curve, flatness * flatness, 16);
+            if (include_end)
+                curve.push_back(C);
+        }
+
+        /**
+         * \brief Tessellates a cubic curve adaptively, subdividing only where the curve bends.
+         * \details See adaptive_quadratic().
+         * @param curve Returns the sequence of points on the curve (appended).
+         * @param flatness The maximum distance allowed between the curve and its polyline
+         *      approximation, in the units of the control points.
+         */
+        template<typename Point>
+        inline
+        void adaptive_cubic(const Point &A, const Point &B, const Point &C, const Point &D,
+                            std::vector<Point> &curve, typename Point::FT flatness, bool include_end = false) {
+            details::adaptive_cubic(A, B, C, D, curve, flatness * flatness, 16);
+            if (include_end)
+                curve.push_back(D);
+        }
+
         /**
          * \brief De Casteljau algorithm evaluating a quadratic or conic (second degree) curve from the given control
          * points \p A, \p B, and \p C. Works for both 2D and 3D.
@@ -81,11 +249,12 @@ namespace easy3d {
         void quadratic(const Point &A, const Point &B, const Point &C, std::vector<Point> &curve,
                        unsigned int bezier_steps = 4, bool include_end = false) {
             typedef typename Point::FT FT;
-            for (unsigned int i = 0; i < bezier_steps; i++) {
-                const FT t = static_cast<FT>(i) / bezier_steps;
-                const Point U = (1.0 - t) * A + t * B;
-                const Point V = (1.0 - t) * B + t * C;
-                curve.push_back((1.0 - t) * U + t * V);
+            if (bezier_steps > 0) {
+                // the samples at t = i / bezier_steps, i in [0, bezier_steps), by forward differencing
+                const std::size_t old_size = curve.size();
+                curve.resize(old_size + bezier_steps);
+                quadratic(A, B, C, FT(0), static_cast<FT>(bezier_steps - 1) / bezier_steps,
+                          bezier_steps, &curve[old_size]);
             }
 
             if (include_end)
@@ -133,14 +302,12 @@ namespace easy3d {
         void cubic(const Point &A, const Point &B, const Point &C, const Point &D, std::vector<Point> &curve,
                    unsigned int bezier_steps = 4, bool include_end = false) {
             typedef typename Point::FT FT;
-            for (unsigned int i = 0; i < bezier_steps; i++) {
-                const FT t = static_cast<FT>(i) / bezier_steps;
-                const Point U = (1.0 - t) * A + t * B;
-                const Point V = (1.0 - t) * B + t * C;
-                const Point W = (1.0 - t) * C + t * D;
-                const Point M = (1.0 - t) * U + t * V;
-                const Point N = (1.0 - t) * V + t * W;
-                curve.push_back((1.0 - t) * M + t * N);
+            if (bezier_steps > 0) {
+                // the samples at t = i / bezier_steps, i in [0, bezier_steps), by forward differencing
+                const std::size_t old_size = curve.size();
+                curve.resize(old_size + bezier_steps);
+                cubic(A, B, C, D, FT(0), static_cast<FT>(bezier_steps - 1) / bezier_steps,
+                      bezier_steps, &curve[old_size]);
             }
             if (include_end)
                 curve.push_back(D);
@@ -43,6 +43,10 @@
 
 #include <cmath>
 #include <cassert>
+#include <cstddef>
+#include <algorithm>
+
+#include <easy3d/core/mat.h>
 
 
 namespace easy3d {
@@ -627,6 +631,128 @@ namespace easy3d {
         }
     }
 
+
+    //----------------------------------------------------------------------------
+
+
+    /// \brief Closed-form eigen solver for 3 by 3 symmetric matrices.
+    /// \class SymmetricEigenSolver3 easy3d/core/eigen_solver.h
+    /// \details The eigenvalues are computed non-iteratively from the characteristic polynomial
+    ///     (the trigonometric method) and the eigenvectors from cross products of the rows of
+    ///     \f$A - \lambda I\f$, so a decomposition costs a fixed, small number of operations
+    ///     without the data-dependent iteration count of the general EigenSolver. This is the
+    ///     solver of choice for covariance analysis of local neighborhoods (e.g., normal
+    ///     estimation, PrincipalAxes), where millions of small decompositions dominate the
+    ///     run time; solve_batch() processes such a workload in parallel.
+    template <typename FT>
+    class SymmetricEigenSolver3
+    {
+    public:
+        /// \brief Computes the eigen-decomposition of the symmetric matrix \p A.
+        /// @param A The input matrix. Only the upper triangle is read, so a numerically slightly
+        ///     asymmetric matrix (e.g., an accumulated covariance) is fine.
+        /// @param eigen_values The eigenvalues, sorted in decreasing order.
+        /// @param eigen_vectors The corresponding (unit length) eigenvectors, stored as the
+        ///     columns of the matrix.
+        static void solve(const Mat3<FT>& A, Vec<3, FT>& eigen_values, Mat3<FT>& eigen_vectors);
+
+        /// \brief Decomposes a batch of \p num symmetric matrices, in parallel.
+        /// @param A The input matrices.
+        /// @param num The number of matrices.
+        /// @param eigen_values The per-matrix eigenvalues (array of size \p num, caller allocated).
+        /// @param eigen_vectors The per-matrix eigenvectors (array of size \p num, caller allocated).
+        static void solve_batch(const Mat3<FT>* A, std::size_t num,
+                                Vec<3, FT>* eigen_values, Mat3<FT>* eigen_vectors);
+
+    private:
+        // the unit eigenvector for eigenvalue 'lambda': the largest cross product of two rows
+        // of (A - lambda * I), which is robust against one of the rows (nearly) vanishing
+        static Vec<3, FT> eigen_vector(FT a00, FT a01, FT a02, FT a11, FT a12, FT a22, FT lambda);
+    };
+
+
+    template <typename FT>
+    inline Vec<3, FT> SymmetricEigenSolver3<FT>::eigen_vector(FT a00, FT a01, FT a02, FT a11, FT a12, FT a22, FT lambda)
+    {
+        const Vec<3, FT> r0(a00 - lambda, a01, a02);
+        const Vec<3, FT> r1(a01, a11 - lambda, a12);
+        const Vec<3, FT> r2(a02, a12, a22 - lambda);
+        const Vec<3, FT> c01 = cross(r0, r1);
+        const Vec<3, FT> c02 = cross(r0, r2);
+        const Vec<3, FT> c12 = cross(r1, r2);
+        const FT l01 = dot(c01, c01);
+        const FT l02 = dot(c02, c02);
+        const FT l12 = dot(c12, c12);
+        if (l01 >= l02 && l01 >= l12)
+            return c01 / std::sqrt(l01);
+        else if (l02 >= l12)
+            return c02 / std::sqrt(l02);
+        else
+            return c12 / std::sqrt(l12);
+    }
+
+
+    template <typename FT>
+    inline void SymmetricEigenSolver3<FT>::solve(const Mat3<FT>& A, Vec<3, FT>& eigen_values, Mat3<FT>& eigen_vectors)
+    {
+        const FT a00 = A(0, 0), a01 = A(0, 1), a02 = A(0, 2);
+        const FT a11 = A(1, 1), a12 = A(1, 2), a22 = A(2, 2);
+
+        const FT p1 = a01 * a01 + a02 * a02 + a12 * a12;
+        if (p1 == FT(0)) {  // the matrix is diagonal: sort the diagonal entries
+            const FT d[3] = { a00, a11, a22 };
+            int i0 = 0, i1 = 1, i2 = 2;
+            if (d[i0] < d[i1]) std::swap(i0, i1);
+            if (d[i0] < d[i2]) std::swap(i0, i2);
+            if (d[i1] < d[i2]) std::swap(i1, i2);
+            eigen_values = Vec<3, FT>(d[i0], d[i1], d[i2]);
+            const int order[3] = { i0, i1, i2 };
+            for (int c = 0; c < 3; ++c)
+                for (int r = 0; r < 3; ++r)
+                    eigen_vectors(r, c) = (r == order[c]) ? FT(1) : FT(0);
+            return;
+        }
+
+        // eigenvalues: the trigonometric solution of the characteristic polynomial of the
+        // shifted and scaled matrix B = (A - q * I) / p, whose eigenvalues are in [-2, 2]
+        const FT q = (a00 + a11 + a22) / FT(3);
+        const FT p2 = (a00 - q) * (a00 - q) + (a11 - q) * (a11 - q) + (a22 - q) * (a22 - q) + FT(2) * p1;
+        const FT p = std::sqrt(p2 / FT(6));
+        const FT b00 = (a00 - q) / p, b11 = (a11 - q) / p, b22 = (a22 - q) / p;
+        const FT b01 = a01 / p, b02 = a02 / p, b12 = a12 / p;
+        FT r = (b00 * (b11 * b22 - b12 * b12) -
+                b01 * (b01 * b22 - b12 * b02) +
+                b02 * (b01 * b12 - b11 * b02)) / FT(2);
+        r = std::min(std::max(r, FT(-1)), FT(1));   // clamp rounding noise, acos stays defined
+
+        const FT phi = std::acos(r) / FT(3);
+        const FT two_thirds_pi = FT(2.09439510239319549);
+        eigen_values[0] = q + FT(2) * p * std::cos(phi);                    // the largest
+        eigen_values[2] = q + FT(2) * p * std::cos(phi + two_thirds_pi);    // the smallest
+        eigen_values[1] = FT(3) * q - eigen_values[0] - eigen_values[2];
+
+        // eigenvectors of the extreme eigenvalues; the middle one completes the basis
+        const Vec<3, FT> v0 = eigen_vector(a00, a01, a02, a11, a12, a22, eigen_values[0]);
+        const Vec<3, FT> v2 = eigen_vector(a00, a01, a02, a11, a12, a22, eigen_values[2]);
+        const Vec<3, FT> v1 = cross(v2, v0);
+        for (int r_ = 0; r_ < 3; ++r_) {
+            eigen_vectors(r_, 0) = v0[r_];
+            eigen_vectors(r_, 1) = v1[r_];
+            eigen_vectors(r_, 2) = v2[r_];
+        }
+    }
+
+
+    template <typename FT>
+    inline void SymmetricEigenSolver3<FT>::solve_batch(const Mat3<FT>* A, std::size_t num,
+                                                       Vec<3, FT>* eigen_values, Mat3<FT>* eigen_vectors)
+    {
+        const int n = static_cast<int>(num);
+#pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+            solve(A[i], eigen_values[i], eigen_vectors[i]);
+    }
+
 }
 
 #endif  // EASY3D_CORE_EIGEN_SOLVER_H
@@ -44,6 +44,7 @@ namespace easy3d {
 
         deleted_vertices_ = deleted_edges_ = 0;
         garbage_ = false;
+        csr_valid_ = false;
     }
 
 
@@ -78,6 +79,7 @@ namespace easy3d {
             deleted_vertices_ = rhs.deleted_vertices_;
             deleted_edges_    = rhs.deleted_edges_;
             garbage_          = rhs.garbage_;
+            csr_valid_        = false;
         }
 
         return *this;
@@ -119,6 +121,7 @@ namespace easy3d {
             deleted_vertices_ = rhs.deleted_vertices_;
             deleted_edges_    = rhs.deleted_edges_;
             garbage_          = rhs.garbage_;
+            csr_valid_        = false;
         }
 
         return *this;
@@ -142,6 +145,7 @@ namespace easy3d {
 
         deleted_vertices_ = deleted_edges_ = 0;
         garbage_ = false;
+        csr_valid_ = false;
 
         //---- keep the standard properties and remove all the other properties
 
@@ -249,6 +253,47 @@ namespace easy3d {
     }
 
 
+    //-----------------------------------------------------------------------------
+
+
+    const Graph::AdjacencyCSR& Graph::adjacency_csr() const
+    {
+        if (csr_valid_)
+            return csr_;
+
+        const unsigned int nv = vertices_size();
+
+        // the offsets (a prefix sum over the valences; rows of deleted vertices stay empty)
+        csr_.offsets_.resize(nv + 1);
+        csr_.offsets_[0] = 0;
+        for (unsigned int i = 0; i < nv; ++i) {
+            const Vertex v(static_cast<int>(i));
+            const unsigned int n = (garbage_ && vdeleted_[v]) ?
+                    0u : static_cast<unsigned int>(vconn_[v].edges_.size());
+            csr_.offsets_[i + 1] = csr_.offsets_[i] + n;
+        }
+
+        // fill the rows in parallel: the destination ranges are disjoint
+        csr_.vertices_.resize(csr_.offsets_[nv]);
+        csr_.edges_.resize(csr_.offsets_[nv]);
+#pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(nv); ++i) {
+            const Vertex v(i);
+            if (garbage_ && vdeleted_[v])
+                continue;
+            unsigned int offset = csr_.offsets_[i];
+            for (auto e : vconn_[v].edges_) {
+                csr_.edges_[offset] = e;
+                csr_.vertices_[offset] = (econn_[e].source_ == v) ? econn_[e].target_ : econn_[e].source_;
+                ++offset;
+            }
+        }
+
+        csr_valid_ = true;
+        return csr_;
+    }
+
+
     //-----------------------------------------------------------------------------
 
     float Graph::edge_length(Edge e) const
@@ -570,6 +570,26 @@ namespace easy3d {
 			eprops_.resize(ne);
 		}
 
+		/// the memory (in bytes) occupied by the graph. \sa Model::memory_usage().
+		std::size_t memory_usage() const {
+			return vprops_.memory_usage() + eprops_.memory_usage() + mprops_.memory_usage();
+		}
+
+		/// appends one record per property array, reporting the bytes used and allocated
+		/// (the difference being reclaimable slack). \sa Model::memory_report().
+		void memory_report(std::vector<PropertyMemoryRecord> &records) const {
+			vprops_.memory_report(records);
+			eprops_.memory_report(records);
+			mprops_.memory_report(records);
+		}
+
+		/// releases the unused capacity of all property arrays. \sa Model::shrink_to_fit().
+		void shrink_to_fit() {
+			vprops_.shrink_to_fit();
+			eprops_.shrink_to_fit();
+			mprops_.shrink_to_fit();
+		}
+
         /// are there deleted vertices or edges?
         bool has_garbage() const { return garbage_; }
 
@@ -631,6 +651,74 @@ namespace easy3d {
         Vertex target(Edge e) const { return econn_[e].target_; }
 		//@}
 
+	public: //--------------------------------------------- CSR adjacency snapshot
+
+		/// \name CSR adjacency snapshot
+		//@{
+
+		/**
+		 * @brief A frozen CSR (compressed sparse row) snapshot of the graph adjacency.
+		 * @details The dynamic connectivity stores one incident-edge vector per vertex, which
+		 *      scatters the adjacency across the heap. This snapshot packs it into one offsets
+		 *      array plus contiguous neighbor/edge arrays, so read-mostly traversals (shortest
+		 *      paths, network analysis) walk sequential memory. Obtain it with adjacency_csr();
+		 *      it stays valid until the next topology edit of the graph.
+		 */
+		class AdjacencyCSR
+		{
+		public:
+			/// the packed neighbors (or incident edges) of one vertex; supports
+			/// C++11 range-based for loops
+			template <typename Handle>
+			struct Range
+			{
+				const Handle* begin() const { return begin_; }
+				const Handle* end() const   { return end_; }
+				std::size_t size() const    { return end_ - begin_; }
+				const Handle* begin_;
+				const Handle* end_;
+			};
+
+			/// returns the packed one-ring neighbors of vertex \c v
+			Range<Vertex> vertices(Vertex v) const {
+				Range<Vertex> range;
+				range.begin_ = vertices_.data() + offsets_[v.idx()];
+				range.end_   = vertices_.data() + offsets_[v.idx() + 1];
+				return range;
+			}
+
+			/// returns the packed incident edges of vertex \c v
+			Range<Edge> edges(Vertex v) const {
+				Range<Edge> range;
+				range.begin_ = edges_.data() + offsets_[v.idx()];
+				range.end_   = edges_.data() + offsets_[v.idx() + 1];
+				return range;
+			}
+
+			/// returns the valence of vertex \c v
+			unsigned int valence(Vertex v) const {
+				return offsets_[v.idx() + 1] - offsets_[v.idx()];
+			}
+
+		private:
+			friend class Graph;
+			std::vector<unsigned int>	offsets_;	// vertices_size() + 1 entries
+			std::vector<Vertex>			vertices_;	// packed one-ring neighbors
+			std::vector<Edge>			edges_;		// packed incident edges
+		};
+
+		/**
+		 * @brief Returns the CSR snapshot of the adjacency, (re)building it if necessary.
+		 * @details The snapshot is built lazily (in parallel) from the dynamic connectivity
+		 *      and cached; any topology edit (adding or deleting vertices or edges, clear(),
+		 *      collect_garbage(), assignment) invalidates it, so the next call rebuilds.
+		 *      Rows of deleted-but-not-yet-collected vertices are empty.
+		 * \attention The returned reference (and the ranges obtained from it) is valid only
+		 *      until the next topology edit.
+		 */
+		const AdjacencyCSR& adjacency_csr() const;
+		//@}
+
 	public: //--------------------------------------------------- property handling
 
 		/// \name Property handling
@@ -639,21 +727,21 @@ namespace easy3d {
 		/** add a vertex property of type \c T with name \c name and default value \c t.
 		 fails if a property named \c name exists already, since the name has to be unique.
 		 in this case it returns an invalid property */
-		template <class T> VertexProperty<T> add_vertex_property(const std::string& name, const T t = T())
+		template <class T> VertexProperty<T> add_vertex_property(const PropertyName& name, const T t = T())
 		{
 			return VertexProperty<T>(vprops_.add<T>(name, t));
 		}
 		/** add a edge property of type \c T with name \c name and default value \c t.
 		 fails if a property named \c name exists already, since the name has to be unique.
 		 in this case it returns an invalid property */
-		template <class T> EdgeProperty<T> add_edge_property(const std::string& name, const T t = T())
+		template <class T> EdgeProperty<T> add_edge_property(const PropertyName& name, const T t = T())
 		{
 			return EdgeProperty<T>(eprops_.add<T>(name, t));
 		}
 		/** add a model property of type \c T with name \c name and default value \c t.
 		 fails if a property named \c name exists already, since the name has to be unique.
 		 in this case it returns an invalid property */
-		template <class T> ModelProperty<T> add_model_property(const std::string& name, const T t = T())
+		template <class T> ModelProperty<T> add_model_property(const PropertyName& name, const T t = T())
 		{
 			return ModelProperty<T>(mprops_.add<T>(name, t));
 		}
@@ -661,19 +749,19 @@ namespace easy3d {
 
 		/** get the vertex property named \c name of type \c T. returns an invalid
 		 VertexProperty if the property does not exist or if the type does not match. */
-		template <class T> VertexProperty<T> get_vertex_property(const std::string& name) const
+		template <class T> VertexProperty<T> get_vertex_property(const PropertyName& name) const
 		{
 			return VertexProperty<T>(vprops_.get<T>(name));
 		}
 		/** get the edge property named \c name of type \c T. returns an invalid
 		 VertexProperty if the property does not exist or if the type does not match. */
-		template <class T> EdgeProperty<T> get_edge_property(const std::string& name) const
+		template <class T> EdgeProperty<T> get_edge_property(const PropertyName& name) const
 		{
 			return EdgeProperty<T>(eprops_.get<T>(name));
 		}
 		/** get the model property named \c name of type \c T. returns an invalid
 		 ModelProperty if the property does not exist or if the type does not match. */
-		template <class T> ModelProperty<T> get_model_property(const std::string& name) const
+		template <class T> ModelProperty<T> get_model_property(const PropertyName& name) const
 		{
 			return ModelProperty<T>(mprops_.get<T>(name));
 		}
@@ -681,20 +769,20 @@ namespace easy3d {
 
 		/** if a vertex property of type \c T with name \c name exists, it is returned.
 		 otherwise this property is added (with default value \c t) */
-		template <class T> VertexProperty<T> vertex_property(const std::string& name, const T t = T())
+		template <class T> VertexProperty<T> vertex_property(const PropertyName& name, const T t = T())
 		{
 			return VertexProperty<T>(vprops_.get_or_add<T>(name, t));
 		}
 		/** if an edge property of type \c T with name \c name exists, it is returned.
 		 otherwise this property is added (with default value \c t) */
-		template <class T> EdgeProperty<T> edge_property(const std::string& name, const T t = T())
+		template <class T> EdgeProperty<T> edge_property(const PropertyName& name, const T t = T())
 		{
 			return EdgeProperty<T>(eprops_.get_or_add<T>(name, t));
 		}
 
 		/** if a model property of type \c T with name \c name exists, it is returned.
 		otherwise this property is added (with default value \c t) */
-		template <class T> ModelProperty<T> model_property(const std::string& name, const T t = T())
+		template <class T> ModelProperty<T> model_property(const PropertyName& name, const T t = T())
 		{
 			return ModelProperty<T>(mprops_.get_or_add<T>(name, t));
 		}
@@ -737,19 +825,19 @@ namespace easy3d {
 
 		/** get the type_info \c T of vertex property \p name. returns an typeid(void)
 		 if the property does not exist or if the type does not match. */
-		const std::type_info& get_vertex_property_type(const std::string& name) const
+		const std::type_info& get_vertex_property_type(const PropertyName& name) const
 		{
 			return vprops_.get_type(name);
 		}
 		/** get the type_info \c T of edge property \p name. returns an typeid(void)
 		 if the property does not exist or if the type does not match. */
-		const std::type_info& get_edge_property_type(const std::string& name) const
+		const std::type_info& get_edge_property_type(const PropertyName& name) const
 		{
 			return eprops_.get_type(name);
 		}
 		/** get the type_info \c T of model property \p name. returns an typeid(void)
 		 if the property does not exist or if the type does not match. */
-		const std::type_info& get_model_property_type(const std::string& name) const
+		const std::type_info& get_model_property_type(const PropertyName& name) const
 		{
 			return mprops_.get_type(name);
 		}
@@ -882,6 +970,7 @@ namespace easy3d {
 		Vertex new_vertex()
 		{
 			vprops_.push_back();
+			csr_valid_ = false;
 			return Vertex(vertices_size() - 1);
 		}
 
@@ -889,6 +978,7 @@ namespace easy3d {
 		Edge new_edge()
 		{
 			eprops_.push_back();
+			csr_valid_ = false;
 			return Edge(edges_size() - 1);
 		}
 
@@ -910,6 +1000,10 @@ namespace easy3d {
 		unsigned int deleted_vertices_;
 		unsigned int deleted_edges_;
 		bool garbage_;
+
+		// lazily built CSR snapshot of the adjacency (see adjacency_csr())
+		mutable AdjacencyCSR	csr_;
+		mutable bool			csr_valid_;
 	};
 
 
@@ -27,6 +27,7 @@
 
 
 #include <cstdint>
+#include <cstring>
 #include <functional>
 
 
@@ -116,6 +117,129 @@ namespace easy3d
         }
     }
 
+
+    // \cond
+    namespace details {
+
+        // the primes, round, and avalanche functions of the XXH64 block hash
+        // (https://github.com/Cyan4973/xxHash; the algorithm is public domain)
+
+        inline uint64_t xxh64_rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+        inline uint64_t xxh64_read64(const unsigned char* p) {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));  // alignment-safe; compiles to a single load
+            return v;
+        }
+
+        inline uint32_t xxh64_read32(const unsigned char* p) {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        static const uint64_t XXH64_PRIME1 = 11400714785074694791ULL;
+        static const uint64_t XXH64_PRIME2 = 14029467366897019727ULL;
+        static const uint64_t XXH64_PRIME3 = 1609587929392839161ULL;
+        static const uint64_t XXH64_PRIME4 = 9650029242287828579ULL;
+        static const uint64_t XXH64_PRIME5 = 2870177450012600261ULL;
+
+        inline uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+            return xxh64_rotl(acc + input * XXH64_PRIME2, 31) * XXH64_PRIME1;
+        }
+
+        inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t val) {
+            return (acc ^ xxh64_round(0, val)) * XXH64_PRIME1 + XXH64_PRIME4;
+        }
+
+        inline uint64_t xxh64_avalanche(uint64_t h) {
+            h ^= h >> 33;
+            h *= XXH64_PRIME2;
+            h ^= h >> 29;
+            h *= XXH64_PRIME3;
+            h ^= h >> 32;
+            return h;
+        }
+
+    }
+    // \endcond
+
+
+    /**
+     * \brief Computes the hash value of a memory block (the XXH64 block hash).
+     * \details Unlike hash()/hash_combine(), which mix one element at a time, this function
+     *      consumes the input in 32-byte blocks over four independent accumulator lanes, so
+     *      the multiplies of consecutive lanes overlap in the pipeline; it is several times
+     *      faster on the bulk hashing done by vertex-welding and deduplication paths. The
+     *      input is hashed by its raw bit pattern (e.g., -0.0 and +0.0 hash differently);
+     *      canonicalize the bytes first if that distinction is unwanted.
+     * \note The computed values differ from those of the element-wise hash() functions.
+     */
+    inline uint64_t hash_bytes(const void* data, uint64_t length, uint64_t seed = 0) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        const unsigned char* const end = p + length;
+        uint64_t h;
+
+        if (length >= 32) {
+            uint64_t v1 = seed + details::XXH64_PRIME1 + details::XXH64_PRIME2;
+            uint64_t v2 = seed + details::XXH64_PRIME2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - details::XXH64_PRIME1;
+            do {
+                v1 = details::xxh64_round(v1, details::xxh64_read64(p));
+                v2 = details::xxh64_round(v2, details::xxh64_read64(p + 8));
+                v3 = details::xxh64_round(v3, details::xxh64_read64(p + 16));
+                v4 = details::xxh64_round(v4, details::xxh64_read64(p + 24));
+                p += 32;
+            } while (p + 32 <= end);
+
+            h = details::xxh64_rotl(v1, 1) + details::xxh64_rotl(v2, 7) +
+                details::xxh64_rotl(v3, 12) + details::xxh64_rotl(v4, 18);
+            h = details::xxh64_merge_round(h, v1);
+            h = details::xxh64_merge_round(h, v2);
+            h = details::xxh64_merge_round(h, v3);
+            h = details::xxh64_merge_round(h, v4);
+        } else
+            h = seed + details::XXH64_PRIME5;
+
+        h += length;
+
+        while (p + 8 <= end) {
+            h ^= details::xxh64_round(0, details::xxh64_read64(p));
+            h = details::xxh64_rotl(h, 27) * details::XXH64_PRIME1 + details::XXH64_PRIME4;
+            p += 8;
+        }
+        if (p + 4 <= end) {
+            h ^= uint64_t(details::xxh64_read32(p)) * details::XXH64_PRIME1;
+            h = details::xxh64_rotl(h, 23) * details::XXH64_PRIME2 + details::XXH64_PRIME3;
+            p += 4;
+        }
+        while (p < end) {
+            h ^= uint64_t(*p) * details::XXH64_PRIME5;
+            h = details::xxh64_rotl(h, 11) * details::XXH64_PRIME1;
+            ++p;
+        }
+
+        return details::xxh64_avalanche(h);
+    }
+
+
+    /**
+     * \brief Computes the hash values of an array of vectors, one value per vector.
+     * \details Each vector is hashed from its raw bit pattern with hash_bytes(). The vector
+     *      size is a small compile-time constant, so the per-vector hash fully inlines and
+     *      consecutive iterations pipeline/vectorize well -- this is the preferred interface
+     *      when millions of points need to be hashed (e.g., for vertex welding).
+     * \param values the vectors to be hashed.
+     * \param count the number of vectors.
+     * \param hashes receives the \p count hash values.
+     */
+    template <size_t DIM, typename FT>
+    inline void hash_range(const Vec<DIM, FT>* values, std::size_t count, uint64_t* hashes) {
+        for (std::size_t i = 0; i < count; ++i)
+            hashes[i] = hash_bytes(values + i, sizeof(Vec<DIM, FT>));
+    }
+
 } // namespace easy3d
 
 #endif  // EASY3D_CORE_HASH_H
\ No newline at end of file
@@ -26,6 +26,8 @@
 #define EASY3D_CORE_HEAP_H
 
 #include <vector>
+#include <iostream>
+#include <cassert>
 
 namespace easy3d {
 
@@ -230,6 +232,253 @@ namespace easy3d {
         HeapInterface interface_;
     };
 
+
+    //=============================================================================
+
+
+    /**
+     * \brief A cache-friendly 4-ary heap, a drop-in replacement for Heap.
+     * \class Heap4 easy3d/core/heap.h
+     * \details A 4-ary heap stores the four children of a node contiguously, so a sift-down
+     *        touches half as many levels as in a binary heap and each level's comparisons hit
+     *        one cache line instead of scattered nodes; this noticeably speeds up the millions
+     *        of heap operations in, e.g., a full mesh decimation. The interface (and the heap
+     *        position tracking through \c HeapInterface, typically backed by a property, see
+     *        Heap) is identical to Heap.
+     *
+     *        In addition, insertions and priority changes can be batched: while deferred
+     *        updates are enabled, insert() and update() do not sift and the heap order is
+     *        restored by a single linear-time rebuild when it is next needed (automatically,
+     *        before front(), pop_front(), and remove(), so enabling the mode is always safe):
+     *        \code
+     *            queue.set_deferred_updates(true);
+     *            for (auto v : mesh->vertices())
+     *                queue.insert(v);     // no sifting
+     *            v = queue.front();       // the heap is built here, in one O(n) pass
+     *        \endcode
+     *        Building a queue of n entries this way costs O(n) instead of O(n log n), and
+     *        re-prioritizing a large fraction of the entries costs one rebuild instead of one
+     *        sift per entry. For a handful of scattered changes between queries, eager updates
+     *        (the default) are cheaper. Note that applying a mixed batch by re-sifting only the
+     *        changed entries in arbitrary order would be cheaper still, but is not sound (the
+     *        sifts consult other entries whose keys also changed), hence the full rebuild.
+     */
+    template<class HeapEntry, class HeapInterface>
+    class Heap4 : private std::vector<HeapEntry> {
+    public:
+        typedef Heap4<HeapEntry, HeapInterface> This;
+
+        //! \brief Constructor
+        Heap4() : HeapVector(), deferred_(false), dirty_(false) {}
+
+        //! \brief Construct with a given \c HeapInterface.
+        Heap4(const HeapInterface &i) : HeapVector(), interface_(i), deferred_(false), dirty_(false) {}
+
+        //! \brief Destructor.
+        ~Heap4() {};
+
+        //! \brief clear the heap
+        void clear() {
+            HeapVector::clear();
+            dirty_ = false;
+        }
+
+        //! \brief is heap empty?
+        bool empty() { return HeapVector::empty(); }
+
+        //! \brief returns the size of heap
+        unsigned int size() { return (unsigned int) HeapVector::size(); }
+
+        //! \brief reserve space for N entries
+        void reserve(unsigned int n) { HeapVector::reserve(n); }
+
+        //! \brief reset heap position to -1 (not in heap)
+        void reset_heap_position(HeapEntry h) {
+            interface_.set_heap_position(h, -1);
+        }
+
+        //! \brief is an entry in the heap?
+        bool is_stored(HeapEntry h) {
+            return interface_.get_heap_position(h) != -1;
+        }
+
+        //! \brief insert the entry h. With deferred updates enabled, the sifting
+        //! is postponed until the heap order is next needed.
+        void insert(HeapEntry h) {
+            This::push_back(h);
+            if (deferred_) {
+                interface_.set_heap_position(h, size() - 1);
+                dirty_ = true;
+                return;
+            }
+            upheap(size() - 1);
+        }
+
+        //! \brief get the first entry
+        HeapEntry front() {
+            flush_updates();
+            assert(!empty());
+            return entry(0);
+        }
+
+        //! \brief delete the first entry
+        void pop_front() {
+            flush_updates();
+            assert(!empty());
+            interface_.set_heap_position(entry(0), -1);
+            if (size() > 1) {
+                entry(0, entry(size() - 1));
+                HeapVector::resize(size() - 1);
+                downheap(0);
+            } else
+                HeapVector::resize(size() - 1);
+        }
+
+        //! \brief remove an entry
+        void remove(HeapEntry h) {
+            flush_updates();
+            int pos = interface_.get_heap_position(h);
+            interface_.set_heap_position(h, -1);
+
+            assert(pos != -1);
+            assert((unsigned int) pos < size());
+
+            // last item ?
+            if ((unsigned int) pos == size() - 1)
+                HeapVector::resize(size() - 1);
+
+            else {
+                entry(pos, entry(size() - 1)); // move last elem to pos
+                HeapVector::resize(size() - 1);
+                downheap(pos);
+                upheap(pos);
+            }
+        }
+
+        //! \brief update an entry: change the key and update the position to
+        //! reestablish the heap property. With deferred updates enabled, the
+        //! sifting is postponed until the heap order is next needed.
+        void update(HeapEntry h) {
+            int pos = interface_.get_heap_position(h);
+            assert(pos != -1);
+            assert((unsigned int) pos < size());
+            if (deferred_) {
+                dirty_ = true;
+                return;
+            }
+            downheap(pos);
+            upheap(pos);
+        }
+
+        //! \brief enable/disable deferred updates (see the class documentation).
+        //! Disabling applies any pending changes immediately.
+        void set_deferred_updates(bool b) {
+            deferred_ = b;
+            if (!deferred_)
+                flush_updates();
+        }
+
+        //! \brief restore the heap order after deferred insertions/updates (one
+        //! linear-time rebuild). Called automatically by the operations that depend
+        //! on the heap order.
+        void flush_updates() {
+            if (!dirty_)
+                return;
+            dirty_ = false;
+            if (size() <= 1)    // trivially ordered
+                return;
+            for (int i = (int) parent(size() - 1); i >= 0; --i)
+                downheap(i);
+        }
+
+        //! \brief check heap condition
+        bool check() {
+            flush_updates();
+            bool ok(true);
+            unsigned int i, j;
+            for (i = 0; i < size(); ++i) {
+                const unsigned int c = child(i);
+                for (j = c; j < c + 4 && j < size(); ++j) {
+                    if (interface_.greater(entry(i), entry(j))) {
+                        std::cerr << "Heap condition violated\n";
+                        ok = false;
+                    }
+                }
+            }
+            return ok;
+        }
+
+    private:
+        // typedef
+        typedef std::vector<HeapEntry> HeapVector;
+
+        //! Upheap. Establish heap property.
+        void upheap(unsigned int idx) {
+            HeapEntry h = entry(idx);
+            unsigned int parentIdx;
+
+            while ((idx > 0) && interface_.less(h, entry(parentIdx = parent(idx)))) {
+                entry(idx, entry(parentIdx));
+                idx = parentIdx;
+            }
+
+            entry(idx, h);
+        }
+
+        //! Downheap. Establish heap property.
+        void downheap(unsigned int idx) {
+            HeapEntry h = entry(idx);
+            unsigned int s = size();
+
+            for (;;) {
+                unsigned int childIdx = child(idx);
+                if (childIdx >= s)
+                    break;
+
+                // the smallest of the (up to four, contiguous) children
+                const unsigned int end = (childIdx + 4 < s) ? childIdx + 4 : s;
+                for (unsigned int j = childIdx + 1; j < end; ++j) {
+                    if (interface_.less(entry(j), entry(childIdx)))
+                        childIdx = j;
+                }
+
+                if (interface_.less(h, entry(childIdx)))
+                    break;
+
+                entry(idx, entry(childIdx));
+                idx = childIdx;
+            }
+
+            entry(idx, h);
+        }
+
+        //! Get the entry at index idx
+        inline HeapEntry entry(unsigned int idx) {
+            assert(idx < size());
+            return (This::operator[](idx));
+        }
+
+        //! Set entry H to index idx and update H's heap position.
+        inline void entry(unsigned int idx, HeapEntry h) {
+            assert(idx < size());
+            This::operator[](idx) = h;
+            interface_.set_heap_position(h, idx);
+        }
+
+        //! Get parent's index
+        inline unsigned int parent(unsigned int i) { return (i - 1) >> 2; }
+
+        //! Get the first child's index (the four children are contiguous)
+        inline unsigned int child(unsigned int i) { return (i << 2) + 1; }
+
+        //! Instance of HeapInterface
+        HeapInterface interface_;
+
+        //! Deferred-update mode, and whether a rebuild is pending
+        bool deferred_;
+        bool dirty_;
+    };
+
 //=============================================================================
 } // namespace easy3d
 
@@ -25,6 +25,7 @@
 #include <easy3d/core/manifold_builder.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/file_system.h>
+#include <easy3d/util/tracing.h>
 
 
 namespace easy3d {
@@ -46,6 +47,25 @@ namespace easy3d {
     }
 
 
+    ManifoldBuilder::Session::Session()
+            : arena()
+            , copied_vertices_for_linking(16, SurfaceMesh::Vertex::Hash(), std::equal_to<SurfaceMesh::Vertex>(),
+                                          CopyRecord::allocator_type(arena))
+            , copied_vertices(16, SurfaceMesh::Vertex::Hash(), std::equal_to<SurfaceMesh::Vertex>(),
+                              CopyRecord::allocator_type(arena))
+            , outgoing_halfedges(16, std::hash<int>(), std::equal_to<int>(),
+                                 OutgoingHalfedges::allocator_type(arena)) {
+    }
+
+
+    ManifoldBuilder::VertexCopies& ManifoldBuilder::copies_of(CopyRecord& record, SurfaceMesh::Vertex v) {
+        auto pos = record.find(v);
+        if (pos == record.end())
+            pos = record.emplace(v, VertexCopies(VertexCopies::allocator_type(session_->arena))).first;
+        return pos->second;
+    }
+
+
     void ManifoldBuilder::begin_surface() {
         num_faces_less_three_vertices_ = 0;
         num_faces_duplicate_vertices = 0;
@@ -53,15 +73,15 @@ namespace easy3d {
         num_faces_unknown_topology_ = 0;
 
         face_vertices_.clear();
-        copied_vertices_.clear();
-        copied_vertices_for_linking_.clear();
-        outgoing_halfedges_.clear();
+        // all temporary maps/vectors of this session draw from one arena
+        session_.reset(new Session);
 
         original_vertex_ = mesh_->add_vertex_property<SurfaceMesh::Vertex>(name_original_vertex);
     }
 
 
     void ManifoldBuilder::end_surface(bool log_issues) {
+        EASY3D_TRACE_SCOPE("ManifoldBuilder::end_surface");
         // ----------------------------------------------------------------------------------
 
         // Step 1: Resolve non-manifold vertices (also collect data for the report).
@@ -79,27 +99,33 @@ namespace easy3d {
         // now all copy occurrences are known
         // mark all copied vertices in property "v:locked"
         auto locked = mesh_->vertex_property<bool>("v:locked");
-        std::size_t num_non_manifold_vertices = copied_vertices_.size();
+        std::size_t num_non_manifold_vertices = session_->copied_vertices.size();
         std::size_t num_copy_occurrences(0);
-        for (const auto& copies : copied_vertices_) {
+        for (const auto& copies : session_->copied_vertices) {
             LOG_IF(FATAL, copies.second.empty()) << "vertex " << copies.first << " not actually copied";
             num_copy_occurrences += copies.second.size();
             for (auto v : copies.second)
                 locked[v] = true;
         }
-        // Release memory immediately when not needed any more.
-        copied_vertices_.clear();
 
         // Query the number of non-manifold edges.
         std::size_t num_non_manifold_edges(0);
-        for (const auto &targets : outgoing_halfedges_) {
+        for (const auto &targets : session_->outgoing_halfedges) {
             const auto& halfedges = targets.second;
             std::set<int> tmp(halfedges.begin(), halfedges.end());
             num_non_manifold_edges += (halfedges.size() - tmp.size());
         }
 
-        // Release memory immediately when not needed any more.
-        outgoing_halfedges_.clear();
+        // Copies made just for linking faces (needed below for the report).
+        std::size_t num_linking_vertices = session_->copied_vertices_for_linking.size();
+        std::size_t num_linking_occurrences(0);
+        for (const auto &copies : session_->copied_vertices_for_linking) {
+            LOG_IF(FATAL, copies.second.empty()) << "vertex " << copies.first << " not actually copied";
+            num_linking_occurrences += copies.second.size();
+        }
+
+        // Release all session temporaries wholesale (one arena deallocation).
+        session_.reset();
 
         // ----------------------------------------------------------------------------------
 
@@ -198,15 +224,9 @@ namespace easy3d {
                 issues += "\n\t\t" + std::to_string(num_non_manifold_vertices) + " vertices copied ("
                           + std::to_string(num_copy_occurrences) + " occurrences)";
 
-                if (copied_vertices_for_linking_.size() > 0) {
-                    std::size_t occurrences(0);
-                    for (const auto &copies : copied_vertices_for_linking_) {
-                        LOG_IF(FATAL, copies.second.empty()) << "vertex " << copies.first << " not actually copied";
-                        occurrences += copies.second.size();
-                    }
-                    issues += ", among which " + std::to_string(copied_vertices_for_linking_.size()) + " vertices with "
-                              + std::to_string(occurrences) + " occurrences for linking new faces";
-                    copied_vertices_for_linking_.clear();
+                if (num_linking_vertices > 0) {
+                    issues += ", among which " + std::to_string(num_linking_vertices) + " vertices with "
+                              + std::to_string(num_linking_occurrences) + " occurrences for linking new faces";
                 }
             }
             if (num_isolated_vertices > 0)
@@ -234,6 +254,17 @@ namespace easy3d {
     }
 
 
+    SurfaceMesh::Vertex ManifoldBuilder::add_vertices(const std::vector<vec3> &points) {
+        DLOG_IF(ERROR, !original_vertex_) << "you must call begin_surface() before the constructing a surface mesh";
+        const SurfaceMesh::Vertex first = mesh_->add_vertices(points);
+        const int num = static_cast<int>(mesh_->vertices_size());
+#pragma omp parallel for
+        for (int i = first.idx(); i < num; ++i)
+            original_vertex_[SurfaceMesh::Vertex(i)] = SurfaceMesh::Vertex(i);
+        return first;
+    }
+
+
     bool ManifoldBuilder::vertices_valid(const std::vector<SurfaceMesh::Vertex> &vertices) {
         const std::size_t n = vertices.size();
 
@@ -328,7 +359,7 @@ namespace easy3d {
                         face_vertices_[t] = copy_vertex(vertices[t]);
 
                         // keep a record that this copy if for linking a face to the mesh. This is just for the report.
-                        copied_vertices_for_linking_[vertices[t]].push_back(face_vertices_[t]);
+                        copies_of(session_->copied_vertices_for_linking, vertices[t]).push_back(face_vertices_[t]);
                     }
                 }
             }
@@ -343,7 +374,11 @@ namespace easy3d {
             for (std::size_t s = 0, t = 1; s < n; ++s, ++t, t %= n) {
                 int s_idx = vertices[s].idx();
                 int t_idx = vertices[t].idx();
-                outgoing_halfedges_[s_idx].push_back(t_idx);
+                auto pos = session_->outgoing_halfedges.find(s_idx);
+                if (pos == session_->outgoing_halfedges.end())
+                    pos = session_->outgoing_halfedges.emplace(
+                            s_idx, Session::TargetList(Session::TargetList::allocator_type(session_->arena))).first;
+                pos->second.push_back(t_idx);
             }
         } else {
             ++num_faces_unknown_topology_;
@@ -367,8 +402,8 @@ namespace easy3d {
 
 
     SurfaceMesh::Vertex ManifoldBuilder::get(SurfaceMesh::Vertex v) {
-        auto pos = copied_vertices_.find(v);
-        if (pos == copied_vertices_.end()) { // no copies
+        auto pos = session_->copied_vertices.find(v);
+        if (pos == session_->copied_vertices.end()) { // no copies
             if (mesh_->is_border(v))
                 return v;
         } else { // has copies
@@ -388,7 +423,7 @@ namespace easy3d {
         const vec3 p = mesh_->position(v); // [Liangliang]: 'const vec3&' won't work because the vector is growing.
         auto new_v = mesh_->add_vertex(p);
         original_vertex_[new_v] = v;
-        copied_vertices_[v].push_back(new_v);
+        copies_of(session_->copied_vertices, v).push_back(new_v);
 
         // copy all vertex properties except "v:connectivity" and "v:deleted"
         auto &arrays = mesh_->vprops_.arrays();
@@ -422,7 +457,8 @@ namespace easy3d {
         // keep a record that the vertex copies are occurred in the 'resolve_non_manifold_vertices()' phase.
         // NOTE: not possible to reuse 'copied_vertices_', because this phase requires a clean record but some vertices
         //       might have already been copied in the previous phase (i.e., in add_face()).
-        CopyRecord copy_record;
+        CopyRecord copy_record(16, SurfaceMesh::Vertex::Hash(), std::equal_to<SurfaceMesh::Vertex>(),
+                               CopyRecord::allocator_type(session_->arena));
 
         std::vector<SurfaceMesh::Halfedge> non_manifold_cones;
         for (auto h : mesh->halfedges()) {
@@ -535,13 +571,13 @@ namespace easy3d {
                 // The star is manifold, so if it is the first time we have met that vertex,
                 // there is nothing to do, we just keep the same vertex.
                 mesh->set_out_halfedge(old_v, h); // to ensure halfedge(old_v, pm) stays valid
-                copy_record[old_v]; // so that we know we have met old_v already, next time, we'll have to duplicate
+                copies_of(copy_record, old_v); // so that we know we have met old_v already, next time, we'll have to duplicate
             } else {
                 // This is not the canonical star associated to 'v'.
                 // Create a new vertex, and move the whole star to that new vertex
                 auto last_h = mesh->opposite(mesh->next(h));
                 auto new_v = create_new_vertex_for_sector(h, last_h, mesh);
-                copy_record[old_v].push_back(new_v);
+                copies_of(copy_record, old_v).push_back(new_v);
                 nb_new_vertices = 1;
             }
         }
@@ -580,7 +616,7 @@ namespace easy3d {
 
                 if (must_create_new_vertex) {
                     auto new_v = create_new_vertex_for_sector(sector_start_h, sector_last_h, mesh);
-                    copy_record[old_v].push_back(new_v);
+                    copies_of(copy_record, old_v).push_back(new_v);
                     ++nb_new_vertices;
                 } else {
                     // Ensure that halfedge(old_v, pm) stays valid
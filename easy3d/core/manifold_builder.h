@@ -26,8 +26,10 @@
 #define EASY3D_CORE_MANIFOLD_BUILDER_H
 
 
+#include <memory>
 #include <unordered_map>
 #include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/memory_arena.h>
 
 
 namespace easy3d {
@@ -76,6 +78,16 @@ namespace easy3d {
          */
         SurfaceMesh::Vertex add_vertex(const vec3 &p);
 
+        /**
+         * @brief Add a batch of vertices to the mesh in one go. This is noticeably faster than
+         *        repeated add_vertex() calls when the number of vertices is known up front, as
+         *        the property arrays grow only once.
+         * @param points The 3D coordinates of the vertices.
+         * @return The first of the added vertices on success.
+         * @related add_vertex().
+         */
+        SurfaceMesh::Vertex add_vertices(const std::vector<vec3> &points);
+
         /**
          * @brief Add a face to the mesh.
          * @param vertices The vertices of the face.
@@ -146,7 +158,16 @@ namespace easy3d {
         //
         // The copied vertices: vertices in 'second' were copied from 'first'.
         // Usually only a small number of vertices will be copied, so no need to use vertex property.
-        typedef std::unordered_map<SurfaceMesh::Vertex, std::vector<SurfaceMesh::Vertex>, SurfaceMesh::Vertex::Hash> CopyRecord;
+        // All session-scoped containers draw from one MemoryArena (freed wholesale in end_surface()),
+        // so resolving heavily defective meshes does not hammer the heap with tiny allocations.
+        typedef std::vector<SurfaceMesh::Vertex, ArenaAllocator<SurfaceMesh::Vertex> > VertexCopies;
+        typedef std::unordered_map<SurfaceMesh::Vertex, VertexCopies, SurfaceMesh::Vertex::Hash,
+                std::equal_to<SurfaceMesh::Vertex>,
+                ArenaAllocator<std::pair<const SurfaceMesh::Vertex, VertexCopies> > > CopyRecord;
+
+        // Fetch (or create empty) the copy list of vertex v in the given record.
+        // The list is allocated from the session arena.
+        VertexCopies& copies_of(CopyRecord& record, SurfaceMesh::Vertex v);
 
         // Resolve the non-manifoldness of a vertex that is denoted by an incoming halfedge.
         // @param h The halfedge pointing to the non-manifold vertex.
@@ -168,22 +189,34 @@ namespace easy3d {
         // faces with unknown topology
         std::size_t num_faces_unknown_topology_;
 
-        // record for linking a face to the mesh
-        CopyRecord copied_vertices_for_linking_;
-        // all copy record
-        CopyRecord copied_vertices_;
+        // All temporary data of one begin_surface()/end_surface() session. The containers
+        // draw from the session arena; destroying the session releases everything wholesale.
+        struct Session {
+            MemoryArena arena;
+
+            // record for linking a face to the mesh
+            CopyRecord copied_vertices_for_linking;
+            // all copy record
+            CopyRecord copied_vertices;
+
+            // The record of all halfedges (each associated with a valid face) originating from a vertex.
+            // This is used for fast query of duplicate edges. All vertices are their original indices.
+            //  - first: the index of a vertex
+            //  - second: the indices of the target vertices
+            typedef std::vector<int, ArenaAllocator<int> > TargetList;
+            typedef std::unordered_map<int, TargetList, std::hash<int>, std::equal_to<int>,
+                    ArenaAllocator<std::pair<const int, TargetList> > > OutgoingHalfedges;
+            OutgoingHalfedges outgoing_halfedges;
+
+            Session();
+        };
+        std::unique_ptr<Session> session_;
 
         // The actual vertices after the face was successfully added to the mesh.
         std::vector<SurfaceMesh::Vertex> face_vertices_;
 
         // A vertex property to record the original vertex of each vertex.
         SurfaceMesh::VertexProperty <SurfaceMesh::Vertex> original_vertex_;
-
-        // The record of all halfedges (each associated with a valid face) originating from a vertex.
-        // This is used for fast query of duplicate edges. All vertices are their original indices.
-        //  - first: the index of a vertex
-        //  - second: the indices of the target vertices
-        std::unordered_map<int, std::vector<int> > outgoing_halfedges_;
     };
 
 }
@@ -788,30 +788,37 @@ namespace easy3d {
         return result;
     }
 
+    // The 3x3 and 4x4 products below are fully unrolled: the constant-bound triple loop is not
+    // reliably unrolled by every compiler (MSVC in particular), and the explicit sums expose
+    // independent multiply-adds to the instruction scheduler. These sizes dominate the
+    // transformation chains (e.g., Camera::modelViewProjectionMatrix()).
+
     template <typename T>
     inline Mat3<T> operator*(const Mat3<T> &lhs, const Mat3<T> &rhs) {
         Mat3<T> result;
-        for (size_t i = 0; i < 3; ++i) {
-            for (size_t j = 0; j < 3; ++j) {
-                result(i, j) = T(0);
-                for (size_t k = 0; k < 3; ++k) {
-                    result(i, j) += lhs(i, k) * rhs(k, j);
-                }
-            }
-        }
+        result(0, 0) = lhs(0, 0) * rhs(0, 0) + lhs(0, 1) * rhs(1, 0) + lhs(0, 2) * rhs(2, 0);
+        result(1, 0) = lhs(1, 0) * rhs(0, 0) + lhs(1, 1) * rhs(1, 0) + lhs(1, 2) * rhs(2, 0);
+        result(2, 0) = lhs(2, 0) * rhs(0, 0) + lhs(2, 1) * rhs(1, 0) + lhs(2, 2) * rhs(2, 0);
+
+        result(0, 1) = lhs(0, 0) * rhs(0, 1) + lhs(0, 1) * rhs(1, 1) + lhs(0, 2) * rhs(2, 1);
+        result(1, 1) = lhs(1, 0) * rhs(0, 1) + lhs(1, 1) * rhs(1, 1) + lhs(1, 2) * rhs(2, 1);
+        result(2, 1) = lhs(2, 0) * rhs(0, 1) + lhs(2, 1) * rhs(1, 1) + lhs(2, 2) * rhs(2, 1);
+
+        result(0, 2) = lhs(0, 0) * rhs(0, 2) + lhs(0, 1) * rhs(1, 2) + lhs(0, 2) * rhs(2, 2);
+        result(1, 2) = lhs(1, 0) * rhs(0, 2) + lhs(1, 1) * rhs(1, 2) + lhs(1, 2) * rhs(2, 2);
+        result(2, 2) = lhs(2, 0) * rhs(0, 2) + lhs(2, 1) * rhs(1, 2) + lhs(2, 2) * rhs(2, 2);
         return result;
     }
 
     template <typename T>
     inline Mat4<T> operator*(const Mat4<T> &lhs, const Mat4<T> &rhs) {
         Mat4<T> result;
-        for (size_t i = 0; i < 4; ++i) {
-            for (size_t j = 0; j < 4; ++j) {
-                result(i, j) = T(0);
-                for (size_t k = 0; k < 4; ++k) {
-                    result(i, j) += lhs(i, k) * rhs(k, j);
-                }
-            }
+        for (size_t j = 0; j < 4; ++j) {    // per column of rhs; the inner sums are unrolled
+            const T r0 = rhs(0, j), r1 = rhs(1, j), r2 = rhs(2, j), r3 = rhs(3, j);
+            result(0, j) = lhs(0, 0) * r0 + lhs(0, 1) * r1 + lhs(0, 2) * r2 + lhs(0, 3) * r3;
+            result(1, j) = lhs(1, 0) * r0 + lhs(1, 1) * r1 + lhs(1, 2) * r2 + lhs(1, 3) * r3;
+            result(2, j) = lhs(2, 0) * r0 + lhs(2, 1) * r1 + lhs(2, 2) * r2 + lhs(2, 3) * r3;
+            result(3, j) = lhs(3, 0) * r0 + lhs(3, 1) * r1 + lhs(3, 2) * r2 + lhs(3, 3) * r3;
         }
         return result;
     }
@@ -853,27 +860,22 @@ namespace easy3d {
     /*--------------------------- non-homogeneous version ------------------------*/
     template <typename T>
     inline Vec<3, T> operator*(const Mat3<T> &lhs, const Vec<3, T> &rhs) {
-        Vec<3, T> result;
-        for (size_t i = 0; i < 3; ++i) {
-            result[i] = 0;
-            for (size_t j = 0; j < 3; ++j) {
-                result[i] += lhs(i, j) * rhs[j];
-            }
-        }
-        return result;
+        // unrolled; see the matrix-matrix products above
+        return Vec<3, T>(
+            lhs(0, 0) * rhs[0] + lhs(0, 1) * rhs[1] + lhs(0, 2) * rhs[2],
+            lhs(1, 0) * rhs[0] + lhs(1, 1) * rhs[1] + lhs(1, 2) * rhs[2],
+            lhs(2, 0) * rhs[0] + lhs(2, 1) * rhs[1] + lhs(2, 2) * rhs[2]);
     }
 
     /*--------------------------- non-homogeneous version ------------------------*/
     template <typename T>
     inline Vec<4, T> operator*(const Mat4<T> &lhs, const Vec<4, T> &rhs) {
-        Vec<4, T> result;
-        for (size_t i = 0; i < 4; ++i) {
-            result[i] = 0;
-            for (size_t j = 0; j < 4; ++j) {
-                result[i] += lhs(i, j) * rhs[j];
-            }
-        }
-        return result;
+        // unrolled; see the matrix-matrix products above
+        return Vec<4, T>(
+            lhs(0, 0) * rhs[0] + lhs(0, 1) * rhs[1] + lhs(0, 2) * rhs[2] + lhs(0, 3) * rhs[3],
+            lhs(1, 0) * rhs[0] + lhs(1, 1) * rhs[1] + lhs(1, 2) * rhs[2] + lhs(1, 3) * rhs[3],
+            lhs(2, 0) * rhs[0] + lhs(2, 1) * rhs[1] + lhs(2, 2) * rhs[2] + lhs(2, 3) * rhs[3],
+            lhs(3, 0) * rhs[0] + lhs(3, 1) * rhs[1] + lhs(3, 2) * rhs[2] + lhs(3, 3) * rhs[3]);
     }
 
 
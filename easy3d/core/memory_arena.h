@@ -0,0 +1,158 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_CORE_MEMORY_ARENA_H
+#define EASY3D_CORE_MEMORY_ARENA_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+#include <cassert>
+
+
+namespace easy3d {
+
+    /**
+     * \brief A simple bump/slab allocation arena.
+     * \class MemoryArena easy3d/core/memory_arena.h
+     * \details The arena hands out memory from large slabs and never recycles individual
+     *      allocations; all memory is returned at once by clear() or by the destructor.
+     *      This turns millions of small short-lived allocations (e.g., the temporary maps
+     *      and vectors built while resolving non-manifoldness during mesh construction)
+     *      into a handful of slab allocations that are freed wholesale.
+     * \attention Objects allocated from the arena are NOT destructed by clear(); the arena
+     *      is intended for trivially destructible data or for containers that are destroyed
+     *      before the arena (their element deallocations are no-ops).
+     * \sa ArenaAllocator
+     */
+    class MemoryArena
+    {
+    public:
+        /// Construct an arena. \p block_size is the size of a slab (1 MB by default);
+        /// requests larger than a slab get a dedicated block.
+        explicit MemoryArena(std::size_t block_size = 1024 * 1024)
+                : block_size_(block_size), current_(nullptr), offset_(0), capacity_(0) {}
+
+        /// Destructor, releases all slabs.
+        ~MemoryArena() { clear(); }
+
+        /// Allocate \p n bytes aligned to \p alignment (must be a power of two).
+        void* allocate(std::size_t n, std::size_t alignment = alignof(double))
+        {
+            assert((alignment & (alignment - 1)) == 0);
+            std::size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (!current_ || aligned + n > capacity_) {
+                // a request larger than a slab gets its own dedicated block
+                const std::size_t size = (n > block_size_) ? n : block_size_;
+                current_ = static_cast<char*>(::malloc(size));
+                blocks_.push_back(current_);
+                capacity_ = size;
+                aligned = 0;
+            }
+            void* p = current_ + aligned;
+            offset_ = aligned + n;
+            return p;
+        }
+
+        /// Release all slabs at once. All memory obtained from the arena becomes invalid.
+        void clear()
+        {
+            for (std::size_t i = 0; i < blocks_.size(); ++i)
+                ::free(blocks_[i]);
+            blocks_.clear();
+            current_ = nullptr;
+            offset_ = capacity_ = 0;
+        }
+
+        /// The total number of bytes held by the arena's slabs.
+        std::size_t size_allocated() const
+        {
+            return blocks_.empty() ? 0 : (blocks_.size() - 1) * block_size_ + capacity_;
+        }
+
+    private:
+        // the arena owns raw memory: copying makes no sense
+        MemoryArena(const MemoryArena&);
+        MemoryArena& operator=(const MemoryArena&);
+
+    private:
+        std::size_t         block_size_;
+        std::vector<char*>  blocks_;
+        char*               current_;
+        std::size_t         offset_;
+        std::size_t         capacity_;
+    };
+
+
+    /**
+     * \brief An STL-compatible allocator drawing from a MemoryArena.
+     * \class ArenaAllocator easy3d/core/memory_arena.h
+     * \details deallocate() is a no-op; memory is reclaimed wholesale when the arena is
+     *      cleared or destroyed. The arena must outlive every container using it.
+     * \sa MemoryArena
+     */
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        typedef T                   value_type;
+        typedef T*                  pointer;
+        typedef const T*            const_pointer;
+        typedef T&                  reference;
+        typedef const T&            const_reference;
+        typedef std::size_t         size_type;
+        typedef std::ptrdiff_t      difference_type;
+
+        template <typename U> struct rebind { typedef ArenaAllocator<U> other; };
+
+        explicit ArenaAllocator(MemoryArena& arena) : arena_(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& rhs) : arena_(rhs.arena()) {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t) { /* reclaimed wholesale by the arena */ }
+
+        template <typename U, typename... Args>
+        void construct(U* p, Args&&... args) { ::new((void*)p) U(std::forward<Args>(args)...); }
+
+        template <typename U>
+        void destroy(U* p) { p->~U(); }
+
+        MemoryArena* arena() const { return arena_; }
+
+        template <typename U> bool operator==(const ArenaAllocator<U>& rhs) const { return arena_ == rhs.arena(); }
+        template <typename U> bool operator!=(const ArenaAllocator<U>& rhs) const { return arena_ != rhs.arena(); }
+
+    private:
+        MemoryArena* arena_;
+    };
+
+} // namespace easy3d
+
+#endif  // EASY3D_CORE_MEMORY_ARENA_H
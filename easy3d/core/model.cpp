@@ -43,8 +43,20 @@ namespace easy3d {
         if (!bbox_known_) {
             Box3& box = const_cast<Model*>(this)->bbox_;
             box.clear();
-            for (const auto& p : points())
-                box.add_point(p);
+
+            // parallel reduction: each thread builds a box over its chunk, then the chunk
+            // boxes are merged. Merging is a pure min/max, so the result does not depend
+            // on the thread schedule.
+            const std::vector<vec3>& pts = points();
+#pragma omp parallel
+            {
+                Box3 local;
+#pragma omp for nowait
+                for (int i = 0; i < (int)pts.size(); ++i)
+                    local.add_point(pts[i]);
+#pragma omp critical
+                box.add_box(local);
+            }
 
             if (box.is_valid())
                 const_cast<Model*>(this)->bbox_known_ = true;
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include <easy3d/core/types.h>
+#include <easy3d/core/properties.h>
 
 
 namespace easy3d {
@@ -61,7 +62,7 @@ namespace easy3d {
          * If the bounding box is unknown, it will be computed first. Otherwise it returns the known bounding box.
          * \see invalidate_bounding_box().
          */
-        const Box3& bounding_box() const;
+        virtual const Box3& bounding_box() const;
 
         /**
          * \brief Invalidates the bounding box of the model. So when bounding_box() is called, the bounding box will be
@@ -78,6 +79,19 @@ namespace easy3d {
         /** \brief Prints the names of all properties to an output stream (e.g., std::cout). */
         virtual void property_stats(std::ostream &output) const {}
 
+        /** \brief The memory (in bytes) occupied by the model, i.e., by all its property arrays
+         *      (including the connectivity and the geometry, which are stored as properties). */
+        virtual std::size_t memory_usage() const { return 0; }
+
+        /** \brief Appends one record per property array, reporting the bytes used and allocated.
+         *      The difference is the slack from vector growth; shrink_to_fit() reclaims it. */
+        virtual void memory_report(std::vector<PropertyMemoryRecord> &records) const {}
+
+        /** \brief Releases the unused capacity of all property arrays. Useful after loading or
+         *      after algorithms that grew the model element by element, where the vector growth
+         *      strategy can leave a substantial fraction of the allocation unused. */
+        virtual void shrink_to_fit() {}
+
         /** \brief Sets the renderer of this model. */
         void set_renderer(Renderer* r) { renderer_ = r; }
         /** \brief Gets the renderer of this model. */
@@ -0,0 +1,259 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_CORE_PAGED_ARRAY_H
+#define EASY3D_CORE_PAGED_ARRAY_H
+
+#include <cassert>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+namespace easy3d {
+
+    /**
+     * \brief A read-only array of elements stored in a file, paged into memory in fixed-size tiles.
+     * \class PagedArray easy3d/core/paged_array.h
+     * \details The array never loads the whole file: accessing an element faults in the tile that
+     *      contains it (a memory-mapped window of the file on POSIX systems, a plain block read on
+     *      Windows), and an LRU policy keeps at most \c max_resident tiles resident. This makes it
+     *      possible to iterate over datasets that are much larger than the available RAM, at the
+     *      cost of a tile lookup per access. Sequential (tile-by-tile) access patterns are cheap;
+     *      random access across many tiles causes eviction churn.
+     * \tparam T The element type. It must be trivially copyable, i.e., the file stores the raw
+     *      bytes of the elements (e.g., float, vec3).
+     */
+    template <typename T>
+    class PagedArray {
+    public:
+        /**
+         * \brief Constructor.
+         * \param tile_size The number of elements per tile.
+         * \param max_resident The maximum number of tiles kept in memory at any time.
+         */
+        PagedArray(std::size_t tile_size = 1024 * 1024, std::size_t max_resident = 64)
+                : size_(0), offset_(0), tile_size_(tile_size), max_resident_(max_resident)
+#ifndef _WIN32
+                , fd_(-1)
+#endif
+        {
+            assert(tile_size_ > 0 && max_resident_ > 0);
+        }
+
+        ~PagedArray() { close(); }
+
+        // a PagedArray owns file handles and mappings and thus cannot be copied
+        PagedArray(const PagedArray&) = delete;
+        PagedArray& operator=(const PagedArray&) = delete;
+
+        /**
+         * \brief Attaches the array to a file.
+         * \param file_name The file storing the raw element data.
+         * \param offset The byte offset of the first element within the file (e.g., to skip a
+         *      header).
+         * \param num The number of elements. If 0, it is derived from the file size.
+         * \return true on success.
+         */
+        bool open(const std::string& file_name, std::size_t offset = 0, std::size_t num = 0) {
+            close();
+#ifdef _WIN32
+            input_.open(file_name.c_str(), std::fstream::binary);
+            if (input_.fail())
+                return false;
+            input_.seekg(0, input_.end);
+            const std::size_t file_size = static_cast<std::size_t>(input_.tellg());
+#else
+            fd_ = ::open(file_name.c_str(), O_RDONLY);
+            if (fd_ < 0)
+                return false;
+            struct stat st;
+            if (::fstat(fd_, &st) != 0) {
+                ::close(fd_);
+                fd_ = -1;
+                return false;
+            }
+            const std::size_t file_size = static_cast<std::size_t>(st.st_size);
+#endif
+            if (file_size < offset) {
+                close();
+                return false;
+            }
+            offset_ = offset;
+            size_ = (num > 0) ? num : (file_size - offset) / sizeof(T);
+            if (offset_ + size_ * sizeof(T) > file_size) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        /// \brief Detaches the array from its file and releases all resident tiles.
+        void close() {
+            for (auto& entry : resident_)
+                release(entry.second);
+            resident_.clear();
+            lru_.clear();
+#ifdef _WIN32
+            if (input_.is_open())
+                input_.close();
+#else
+            if (fd_ >= 0) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+#endif
+            size_ = 0;
+            offset_ = 0;
+        }
+
+        /// \brief The number of elements.
+        std::size_t size() const { return size_; }
+        /// \brief Tests whether the array is empty.
+        bool empty() const { return size_ == 0; }
+
+        /// \brief The number of elements per tile.
+        std::size_t tile_size() const { return tile_size_; }
+        /// \brief The number of tiles.
+        std::size_t num_tiles() const { return (size_ + tile_size_ - 1) / tile_size_; }
+        /// \brief The number of tiles currently resident in memory.
+        std::size_t num_resident_tiles() const { return resident_.size(); }
+
+        /**
+         * \brief The elements of a tile. The tile is faulted in if it is not resident; the least
+         *      recently used tile is evicted if the residency limit is exceeded.
+         * \param t The tile index, in the range [0, num_tiles()).
+         * \param num Returns the number of elements in the tile (the last tile may be shorter).
+         * \return A pointer to the first element of the tile. The pointer remains valid until the
+         *      tile is evicted, i.e., until max_resident other tiles have been touched.
+         */
+        const T* tile_data(std::size_t t, std::size_t& num) const {
+            assert(t < num_tiles());
+            num = (t + 1 == num_tiles()) ? (size_ - t * tile_size_) : tile_size_;
+
+            auto pos = resident_.find(t);
+            if (pos != resident_.end()) {
+                lru_.splice(lru_.begin(), lru_, pos->second.lru_pos);
+                return pos->second.data;
+            }
+
+            // evict the least recently used tile(s) before faulting in a new one
+            while (resident_.size() >= max_resident_) {
+                auto victim = resident_.find(lru_.back());
+                release(victim->second);
+                resident_.erase(victim);
+                lru_.pop_back();
+            }
+
+            Tile tile = fetch(t, num);
+            lru_.push_front(t);
+            tile.lru_pos = lru_.begin();
+            resident_[t] = tile;
+            return tile.data;
+        }
+
+        /// \brief Read-only access to an element. Faults in the tile containing the element.
+        const T& operator[](std::size_t idx) const {
+            assert(idx < size_);
+            std::size_t num = 0;
+            const T* data = tile_data(idx / tile_size_, num);
+            return data[idx % tile_size_];
+        }
+
+    private:
+        struct Tile {
+            const T* data;
+#ifdef _WIN32
+            char* block;            // heap block holding the tile
+#else
+            void* mapping;          // the memory-mapped window (page aligned)
+            std::size_t mapping_size;
+#endif
+            typename std::list<std::size_t>::iterator lru_pos;
+        };
+
+        Tile fetch(std::size_t t, std::size_t num) const {
+            Tile tile;
+            const std::size_t byte_begin = offset_ + t * tile_size_ * sizeof(T);
+            const std::size_t byte_count = num * sizeof(T);
+#ifdef _WIN32
+            tile.block = new char[byte_count];
+            input_.seekg(static_cast<std::streamoff>(byte_begin), input_.beg);
+            input_.read(tile.block, static_cast<std::streamsize>(byte_count));
+            tile.data = reinterpret_cast<const T*>(tile.block);
+#else
+            // mmap requires a page-aligned file offset, so the window starts at the enclosing
+            // page boundary and the returned pointer compensates for the difference
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t aligned = byte_begin - (byte_begin % page);
+            tile.mapping_size = (byte_begin - aligned) + byte_count;
+            tile.mapping = ::mmap(nullptr, tile.mapping_size, PROT_READ, MAP_PRIVATE, fd_,
+                                  static_cast<off_t>(aligned));
+            assert(tile.mapping != MAP_FAILED);
+            tile.data = reinterpret_cast<const T*>(
+                    static_cast<const char*>(tile.mapping) + (byte_begin - aligned));
+#endif
+            return tile;
+        }
+
+        void release(Tile& tile) const {
+#ifdef _WIN32
+            delete[] tile.block;
+            tile.block = nullptr;
+#else
+            ::munmap(tile.mapping, tile.mapping_size);
+            tile.mapping = nullptr;
+#endif
+            tile.data = nullptr;
+        }
+
+    private:
+        std::size_t size_;
+        std::size_t offset_;
+        std::size_t tile_size_;
+        std::size_t max_resident_;
+
+        // residency bookkeeping (mutable: read access faults tiles in and reorders the LRU list)
+        mutable std::unordered_map<std::size_t, Tile> resident_;
+        mutable std::list<std::size_t> lru_;    // most recently used tile at the front
+
+#ifdef _WIN32
+        mutable std::ifstream input_;
+#else
+        int fd_;
+#endif
+    };
+
+} // namespace easy3d
+
+#endif  // EASY3D_CORE_PAGED_ARRAY_H
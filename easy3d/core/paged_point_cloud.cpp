@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <easy3d/core/paged_point_cloud.h>
+
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    PagedPointCloud::PagedPointCloud(std::size_t tile_size, std::size_t max_resident_tiles)
+            : points_(tile_size, max_resident_tiles)
+            , bbox_known_(false)
+    {
+    }
+
+
+    bool PagedPointCloud::open(const std::string& file_name) {
+        close();
+
+        // check size of types: the file stores raw float triplets
+        if (sizeof(vec3) != sizeof(float) * 3) {
+            LOG(ERROR) << "point coordinates must be \'float\'";
+            return false;
+        }
+
+        if (!points_.open(file_name)) {
+            LOG(ERROR) << "could not open file: " << file_name;
+            return false;
+        }
+
+        file_name_ = file_name;
+        return true;
+    }
+
+
+    void PagedPointCloud::close() {
+        points_.close();
+        file_name_.clear();
+        bbox_ = Box3();
+        bbox_known_ = false;
+    }
+
+
+    const Box3& PagedPointCloud::bounding_box() const {
+        if (!bbox_known_) {
+            Box3 box;
+            // one streaming pass over the tiles; at most max_resident tiles are in memory
+            for (std::size_t t = 0; t < points_.num_tiles(); ++t) {
+                std::size_t num = 0;
+                const vec3* points = points_.tile_data(t, num);
+                for (std::size_t i = 0; i < num; ++i)
+                    box.add_point(points[i]);
+            }
+            bbox_ = box;
+            bbox_known_ = true;
+        }
+        return bbox_;
+    }
+
+} // namespace easy3d
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_CORE_PAGED_POINT_CLOUD_H
+#define EASY3D_CORE_PAGED_POINT_CLOUD_H
+
+#include <string>
+
+#include <easy3d/core/types.h>
+#include <easy3d/core/paged_array.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief An out-of-core point cloud whose coordinates stay on disk and are streamed into
+     *      memory tile by tile.
+     * \class PagedPointCloud easy3d/core/paged_point_cloud.h
+     * \details Unlike PointCloud, which requires the whole cloud to be resident in RAM, a
+     *      PagedPointCloud attaches directly to a file of raw coordinates (the bxyz format, i.e.,
+     *      three consecutive floats per point) and pages tiles in on demand with an LRU residency
+     *      policy (see PagedArray). This makes it possible to work with clouds of billions of
+     *      points: client code (e.g., uploading tiles to a PointsDrawable, or feeding a
+     *      KdTreeSearch built per tile) iterates with tile_points() and only ever holds a bounded
+     *      number of tiles in memory.
+     */
+    class PagedPointCloud {
+    public:
+        /**
+         * \brief Constructor.
+         * \param tile_size The number of points per tile.
+         * \param max_resident_tiles The maximum number of tiles kept in memory at any time.
+         */
+        PagedPointCloud(std::size_t tile_size = 4 * 1024 * 1024, std::size_t max_resident_tiles = 16);
+
+        /**
+         * \brief Attaches the point cloud to a file storing raw coordinates (three consecutive
+         *      floats per point, i.e., the bxyz format). The file is not read here; tiles are
+         *      paged in on first access.
+         * \return true on success.
+         */
+        bool open(const std::string& file_name);
+
+        /// \brief Detaches from the file and releases all resident tiles.
+        void close();
+
+        /// \brief The file backing this point cloud.
+        const std::string& file_name() const { return file_name_; }
+
+        /// \brief The number of points.
+        std::size_t n_vertices() const { return points_.size(); }
+
+        /// \brief The number of tiles.
+        std::size_t num_tiles() const { return points_.num_tiles(); }
+
+        /// \brief The number of points per tile.
+        std::size_t tile_size() const { return points_.tile_size(); }
+
+        /**
+         * \brief The points of a tile. The tile is paged in if necessary.
+         * \param t The tile index, in the range [0, num_tiles()).
+         * \param num Returns the number of points in the tile (the last tile may be shorter).
+         * \return A pointer to the first point of the tile. The pointer remains valid until the
+         *      tile is evicted (see PagedArray::tile_data()).
+         */
+        const vec3* tile_points(std::size_t t, std::size_t& num) const {
+            return points_.tile_data(t, num);
+        }
+
+        /// \brief Read-only access to the position of a point. Pages in the enclosing tile, so
+        ///     random access across the whole cloud is expensive; prefer tile_points().
+        const vec3& position(std::size_t idx) const { return points_[idx]; }
+
+        /// \brief The paged coordinate array.
+        const PagedArray<vec3>& points() const { return points_; }
+
+        /// \brief The bounding box of the point cloud. The first call streams over all tiles;
+        ///     the result is cached for subsequent calls.
+        const Box3& bounding_box() const;
+
+    private:
+        std::string file_name_;
+        PagedArray<vec3> points_;
+
+        mutable Box3 bbox_;
+        mutable bool bbox_known_;
+    };
+
+} // namespace easy3d
+
+#endif  // EASY3D_CORE_PAGED_POINT_CLOUD_H
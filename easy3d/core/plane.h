@@ -27,6 +27,7 @@
 
 #include <easy3d/core/vec.h>
 #include <easy3d/core/line.h>
+#include <easy3d/core/box.h>
 #include <easy3d/util/logging.h>
 
 
@@ -130,6 +131,12 @@ namespace easy3d {
         ///   - -1: p is on the negative side
         int orient(const Point3& p) const;
 
+        /// \brief Batch version of orient(): classifies \p num points at once, writing one value
+        /// (1, 0, or -1, with the same meaning and tolerance as orient()) per point into
+        /// \p result. The loop is branch-free over contiguous arrays, so classifying a point
+        /// cloud against a clipping or cross-section plane runs at memory speed.
+        void orient(const Point3* points, std::size_t num, signed char* result) const;
+
         /// \brief Returns the constant memory address of the coefficients.
         const FT* data() const { return coeff_; }
         /// \brief Returns the memory address of the coefficients.
@@ -262,6 +269,17 @@ namespace easy3d {
     }
 
 
+    template <typename FT> inline
+    void GenericPlane<FT>::orient(const Point3* points, std::size_t num, signed char* result) const {
+        const FT a = coeff_[0], b = coeff_[1], c = coeff_[2], d = coeff_[3];
+        const FT eps = FT(1e-15);   // the same tolerance as the scalar orient()
+        for (std::size_t i = 0; i < num; ++i) {
+            const FT v = a * points[i].x + b * points[i].y + c * points[i].z + d;
+            result[i] = static_cast<signed char>((v >= eps) - (v <= -eps));
+        }
+    }
+
+
     template <typename FT> inline
     typename GenericPlane<FT>::Point3 GenericPlane<FT>::projection(const Point3& p) const {
         // the equation of the plane is Ax+By+Cz+D=0
@@ -366,6 +384,43 @@ namespace easy3d {
         return is >> plane[0] >> plane[1] >> plane[2] >> plane[3];
     }
 
+
+    /**
+     * \brief Conservatively tests \p num_boxes boxes against the convex volume bounded by the
+     *      \p num_planes inward-pointing \p planes (e.g., the six planes of a view frustum).
+     * \details For each box only the corner furthest along each plane's normal is evaluated:
+     *      \p results[i] is set to \c false only when box \c i lies entirely behind one of the
+     *      planes (it is certainly outside the volume), and to \c true otherwise. Invalid boxes
+     *      are reported inside. The per-box work is branch-free (the corner is selected by the
+     *      signs of the plane normal, which are hoisted out of the box loop), so culling
+     *      thousands of boxes per frame costs a few instructions each.
+     */
+    template <typename FT> inline
+    void boxes_intersect_frustum(const GenericPlane<FT>* planes, std::size_t num_planes,
+                                 const GenericBox<3, FT>* boxes, std::size_t num_boxes, bool* results) {
+        for (std::size_t k = 0; k < num_planes; ++k) {
+            const FT a = planes[k][0], b = planes[k][1], c = planes[k][2], d = planes[k][3];
+            const int sx = (a >= 0), sy = (b >= 0), sz = (c >= 0);
+            for (std::size_t i = 0; i < num_boxes; ++i) {
+                if (k > 0 && !results[i])
+                    continue;   // already behind an earlier plane
+                if (!boxes[i].is_valid()) {
+                    results[i] = true;
+                    continue;
+                }
+                // the corner of the box furthest along the plane's normal
+                const FT x = sx ? boxes[i].max(0) : boxes[i].min(0);
+                const FT y = sy ? boxes[i].max(1) : boxes[i].min(1);
+                const FT z = sz ? boxes[i].max(2) : boxes[i].min(2);
+                results[i] = (a * x + b * y + c * z + d >= 0);
+            }
+        }
+        if (num_planes == 0) {
+            for (std::size_t i = 0; i < num_boxes; ++i)
+                results[i] = true;
+        }
+    }
+
 }
 
 
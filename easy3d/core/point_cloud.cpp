@@ -25,7 +25,10 @@
 
 #include <easy3d/core/point_cloud.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <utility>
 
 namespace easy3d {
 
@@ -221,4 +224,114 @@ namespace easy3d {
         garbage_ = false;
     }
 
+
+    //-----------------------------------------------------------------------------
+
+
+    //  \cond
+    namespace details {
+
+        // spreads the lower 21 bits of v so that they occupy every third bit
+        inline std::uint64_t expand_bits(std::uint64_t v) {
+            v &= 0x1fffff;
+            v = (v | v << 32) & 0x1f00000000ffffULL;
+            v = (v | v << 16) & 0x1f0000ff0000ffULL;
+            v = (v | v << 8) & 0x100f00f00f00f00fULL;
+            v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+            v = (v | v << 2) & 0x1249249249249249ULL;
+            return v;
+        }
+
+        // the 64-bit Morton code of quantized coordinates (21 bits per axis)
+        inline std::uint64_t morton_code(std::uint64_t x, std::uint64_t y, std::uint64_t z) {
+            return expand_bits(x) | (expand_bits(y) << 1) | (expand_bits(z) << 2);
+        }
+    }
+    //  \endcond
+
+
+    std::vector<int> PointCloud::sort_spatially()
+    {
+        if (has_garbage())
+            collect_garbage();  // so the permutation covers the valid vertices only
+
+        const int num = static_cast<int>(n_vertices());
+        std::vector<int> old_to_new(num);
+        if (num == 0)
+            return old_to_new;
+
+        // querying the box now also flushes the dirty-vertex list of the cached box,
+        // whose indices would refer to the wrong vertices after the permutation
+        const Box3& box = bounding_box();
+
+        // quantize the coordinates into 21 bits per axis over the bounding box
+        const vec3 origin = box.min();
+        const auto quantize = [](float value, float base, double scale) -> std::uint64_t {
+            const double c = std::floor(double(value - base) * scale);
+            return static_cast<std::uint64_t>(std::min(std::max(c, 0.0), 2097151.0));
+        };
+        double scale[3];
+        for (int i = 0; i < 3; ++i)
+            scale[i] = box.range(i) > 0.0f ? 2097151.0 / box.range(i) : 0.0;
+
+        const std::vector<vec3>& pts = vpoint_.vector();
+        std::vector< std::pair<std::uint64_t, int> > codes(num);
+#pragma omp parallel for
+        for (int i = 0; i < num; ++i) {
+            const vec3& p = pts[i];
+            codes[i] = std::make_pair(
+                    details::morton_code(quantize(p.x, origin.x, scale[0]), quantize(p.y, origin.y, scale[1]),
+                                         quantize(p.z, origin.z, scale[2])),
+                    i);
+        }
+        std::sort(codes.begin(), codes.end());
+
+        // gather all vertex properties into the new order
+        std::vector<size_t> order(num);
+        for (int i = 0; i < num; ++i)
+            order[i] = codes[i].second;
+        vprops_.permute(order);
+
+        for (int i = 0; i < num; ++i)
+            old_to_new[codes[i].second] = i;
+        return old_to_new;
+    }
+
+
+    void PointCloud::attach_to(PropertyHistory &history)
+    {
+        history.track(&vprops_);
+        history.track(&mprops_);
+
+        // the garbage-collection bookkeeping lives outside the property containers and has
+        // to be captured/restored alongside them
+        PointCloud *cloud = this;
+        history.set_state_hooks(
+                [cloud]() -> std::vector<std::size_t> {
+                    return {cloud->deleted_vertices_, cloud->garbage_ ? std::size_t(1) : std::size_t(0)};
+                },
+                [cloud](const std::vector<std::size_t> &state) {
+                    cloud->deleted_vertices_ = static_cast<unsigned int>(state[0]);
+                    cloud->garbage_ = (state[1] != 0);
+                    cloud->invalidate_bounding_box();   // the restored positions may differ
+                });
+    }
+
+
+    //-----------------------------------------------------------------------------
+
+
+    const Box3& PointCloud::bounding_box() const
+    {
+        // merge only the vertices modified since the last query into the cached box
+        // (grow-only; a potential shrink must go through invalidate_bounding_box())
+        if (bbox_known_ && !dirty_vertices_.empty()) {
+            Box3& box = const_cast<PointCloud*>(this)->bbox_;
+            for (auto idx : dirty_vertices_)
+                box.add_point(vpoint_[Vertex(idx)]);
+        }
+        dirty_vertices_.clear();
+        return Model::bounding_box();
+    }
+
 } // namespace easy3d
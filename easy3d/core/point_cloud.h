@@ -269,12 +269,48 @@ namespace easy3d {
         /// @brief resize space for vertices and their currently associated properties.
         void resize(unsigned int nv) { vprops_.resize(nv); }
 
+        /// @brief the memory (in bytes) occupied by the cloud. \sa Model::memory_usage().
+        std::size_t memory_usage() const { return vprops_.memory_usage() + mprops_.memory_usage(); }
+
+        /// @brief appends one record per property array, reporting the bytes used and allocated
+        ///     (the difference being reclaimable slack). \sa Model::memory_report().
+        void memory_report(std::vector<PropertyMemoryRecord> &records) const {
+            vprops_.memory_report(records);
+            mprops_.memory_report(records);
+        }
+
+        /// @brief releases the unused capacity of all property arrays. \sa Model::shrink_to_fit().
+        void shrink_to_fit() {
+            vprops_.shrink_to_fit();
+            mprops_.shrink_to_fit();
+        }
+
         /// are there deleted vertices?
         bool has_garbage() const { return garbage_; }
 
         /// @brief remove deleted vertices
         void collect_garbage();
 
+        /// @brief reorders the vertices along a Morton (Z-order) space-filling curve, so that
+        ///     vertices close in space become close in memory. This improves the cache behavior
+        ///     of neighborhood-based traversals (and the GPU vertex cache when rendering) for
+        ///     clouds whose file ordering is spatially shuffled (e.g., raw LiDAR). All vertex
+        ///     properties are permuted accordingly (in a parallel gather). Deleted vertices are
+        ///     garbage-collected first.
+        /// @return the index mapping from the old order to the new one (i.e., the vertex that
+        ///     had index \c i now has index \c result[i]), for fixing up externally stored
+        ///     vertex indices.
+        std::vector<int> sort_spatially();
+
+        /// @brief attaches this cloud to an undo/redo history.
+        /// @details Registers the property containers of the cloud (and its garbage-collection
+        ///     state) with \p history, so that PropertyHistory::checkpoint(), undo(), and redo()
+        ///     capture and restore the complete cloud. Snapshots share the storage of unmodified
+        ///     properties (copy-on-write), so the memory cost of a history step is bounded by
+        ///     what the edits in between actually touched, not by the size of the cloud.
+        /// \attention The history must not outlive the cloud, and it must track only this cloud.
+        void attach_to(PropertyHistory &history);
+
         /// @brief deletes the vertex \c v from the cloud
         void delete_vertex(Vertex v);
 
@@ -301,40 +337,40 @@ namespace easy3d {
         /** @brief add a vertex property of type \c T with name \c name and default value \c t.
          fails if a property named \c name exists already, since the name has to be unique.
          in this case it returns an invalid property */
-        template <class T> VertexProperty<T> add_vertex_property(const std::string& name, const T t=T())
+        template <class T> VertexProperty<T> add_vertex_property(const PropertyName& name, const T t=T())
         {
             return VertexProperty<T>(vprops_.add<T>(name, t));
         }
         /** @brief add a model property of type \c T with name \c name and default value \c t.
         fails if a property named \c name exists already, since the name has to be unique.
         in this case it returns an invalid property */
-        template <class T> ModelProperty<T> add_model_property(const std::string& name, const T t = T())
+        template <class T> ModelProperty<T> add_model_property(const PropertyName& name, const T t = T())
         {
             return ModelProperty<T>(mprops_.add<T>(name, t));
         }
 
         /** @brief get the vertex property named \c name of type \c T. returns an invalid
          VertexProperty if the property does not exist or if the type does not match. */
-        template <class T> VertexProperty<T> get_vertex_property(const std::string& name) const
+        template <class T> VertexProperty<T> get_vertex_property(const PropertyName& name) const
         {
             return VertexProperty<T>(vprops_.get<T>(name));
         }
         /** @brief get the model property named \c name of type \c T. returns an invalid
         ModelProperty if the property does not exist or if the type does not match. */
-        template <class T> ModelProperty<T> get_model_property(const std::string& name) const
+        template <class T> ModelProperty<T> get_model_property(const PropertyName& name) const
         {
             return ModelProperty<T>(mprops_.get<T>(name));
         }
 
         /** @brief if a vertex property of type \c T with name \c name exists, it is returned.
          otherwise this property is added (with default value \c t) */
-        template <class T> VertexProperty<T> vertex_property(const std::string& name, const T t=T())
+        template <class T> VertexProperty<T> vertex_property(const PropertyName& name, const T t=T())
         {
             return VertexProperty<T>(vprops_.get_or_add<T>(name, t));
         }
         /** @brief if a model property of type \c T with name \c name exists, it is returned.
         otherwise this property is added (with default value \c t) */
-        template <class T> ModelProperty<T> model_property(const std::string& name, const T t = T())
+        template <class T> ModelProperty<T> model_property(const PropertyName& name, const T t = T())
         {
             return ModelProperty<T>(mprops_.get_or_add<T>(name, t));
         }
@@ -365,13 +401,13 @@ namespace easy3d {
 
         /** @brief get the type_info \c T of vertex property \p name. returns an typeid(void)
          if the property does not exist or if the type does not match. */
-        const std::type_info& get_vertex_property_type(const std::string& name) const
+        const std::type_info& get_vertex_property_type(const PropertyName& name) const
         {
             return vprops_.get_type(name);
         }
         /** @brief get the type_info \c T of model property \p name. returns an typeid(void)
         if the property does not exist or if the type does not match. */
-        const std::type_info& get_model_property_type(const std::string& name) const
+        const std::type_info& get_model_property_type(const PropertyName& name) const
         {
             return mprops_.get_type(name);
         }
@@ -435,6 +471,16 @@ namespace easy3d {
         /// @brief vector of vertex positions
         std::vector<vec3>& points() { return vpoint_.vector(); }
 
+        /// @brief The bounding box of the cloud. Before returning, pending dirty vertices (see
+        ///     mark_vertex_dirty()) are merged into the cached box, avoiding a full rescan.
+        const Box3& bounding_box() const;
+
+        /// @brief Marks vertex \c v as modified, so that the next bounding_box() query merges only
+        ///     the marked vertices into the cached box instead of rescanning all points.
+        /// @details This is a grow-only update: if a vertex may have moved inward (the box could
+        ///     shrink), call invalidate_bounding_box() instead.
+        void mark_vertex_dirty(Vertex v) { dirty_vertices_.push_back(v.idx()); }
+
         //@}
 
     private: //---------------------------------------------- allocate new elements
@@ -457,6 +503,9 @@ namespace easy3d {
 
         unsigned int	deleted_vertices_;
         bool			garbage_;
+
+        // vertices modified since the last bounding_box() query (cleared by the query)
+        mutable std::vector<int>    dirty_vertices_;
     };
 
 
@@ -0,0 +1,252 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/core/point_cloud_quantization.h>
+
+#include <cmath>
+
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    unsigned int PointCloudQuantization::encode_normal(const vec3& n)
+    {
+        // project onto the octahedron (the plane |x|+|y|+|z| = 1), then fold the lower
+        // hemisphere over the diagonals so the result lives in the unit square
+        const float len = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        float px = 0.0f, py = 0.0f;     // a degenerate input encodes as +z
+        if (len > 0.0f) {
+            px = n.x / len;
+            py = n.y / len;
+        }
+        if (n.z < 0.0f) {
+            const float fx = (1.0f - std::abs(py)) * (px >= 0.0f ? 1.0f : -1.0f);
+            const float fy = (1.0f - std::abs(px)) * (py >= 0.0f ? 1.0f : -1.0f);
+            px = fx;
+            py = fy;
+        }
+
+        const auto pack = [](float v) -> unsigned int {
+            const float c = (v * 0.5f + 0.5f) * 65535.0f + 0.5f;
+            return static_cast<unsigned int>(std::min(std::max(c, 0.0f), 65535.0f));
+        };
+        return pack(px) | (pack(py) << 16);
+    }
+
+
+    vec3 PointCloudQuantization::decode_normal(unsigned int code)
+    {
+        const float px = float(code & 0xffffu) / 65535.0f * 2.0f - 1.0f;
+        const float py = float(code >> 16) / 65535.0f * 2.0f - 1.0f;
+        vec3 n(px, py, 1.0f - std::abs(px) - std::abs(py));
+        if (n.z < 0.0f) {   // unfold the lower hemisphere
+            const float x = (1.0f - std::abs(py)) * (px >= 0.0f ? 1.0f : -1.0f);
+            const float y = (1.0f - std::abs(px)) * (py >= 0.0f ? 1.0f : -1.0f);
+            n.x = x;
+            n.y = y;
+        }
+        return normalize(n);
+    }
+
+
+    bool PointCloudQuantization::is_compressed(const PointCloud* cloud)
+    {
+        return cloud && cloud->get_vertex_property<Offset>("v:quantized_point");
+    }
+
+
+    bool PointCloudQuantization::compress(PointCloud* cloud)
+    {
+        if (!cloud) {
+            LOG(ERROR) << "null point cloud";
+            return false;
+        }
+        if (is_compressed(cloud)) {
+            LOG(WARNING) << "point cloud is already compressed";
+            return false;
+        }
+        if (cloud->n_vertices() == 0)
+            return false;
+
+        // reorder along the Morton curve (this also collects garbage), so each block of
+        // consecutive points covers a small spatial extent
+        cloud->sort_spatially();
+
+        const std::size_t num = cloud->n_vertices();
+        const std::vector<vec3>& points = cloud->points();
+        auto normals = cloud->get_vertex_property<vec3>("v:normal");
+        auto colors = cloud->get_vertex_property<vec3>("v:color");
+
+        auto offsets = cloud->add_vertex_property<Offset>("v:quantized_point");
+        auto blocks = cloud->add_model_property<std::vector<Block>>("q:blocks");
+        const std::size_t num_blocks = (num + block_size - 1) / block_size;
+        std::vector<Block>& block_table = blocks[0];
+        block_table.resize(num_blocks);
+
+        std::vector<Offset>& quantized = offsets.vector();  // detach (if shared) before the parallel loop
+        const int blocks_int = static_cast<int>(num_blocks);
+#pragma omp parallel for
+        for (int b = 0; b < blocks_int; ++b) {
+            const std::size_t begin = std::size_t(b) * block_size;
+            const std::size_t end = std::min(begin + block_size, num);
+
+            // the tight box of this run of points
+            vec3 bmin = points[begin], bmax = points[begin];
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                const vec3& p = points[i];
+                for (int c = 0; c < 3; ++c) {
+                    bmin[c] = std::min(bmin[c], p[c]);
+                    bmax[c] = std::max(bmax[c], p[c]);
+                }
+            }
+
+            Block& block = block_table[b];
+            block.origin = bmin;
+            float inv_scale[3];
+            for (int c = 0; c < 3; ++c) {
+                const float range = bmax[c] - bmin[c];
+                block.scale[c] = range / 65535.0f;
+                inv_scale[c] = range > 0.0f ? 65535.0f / range : 0.0f;  // degenerate axis -> offset 0
+            }
+
+            for (std::size_t i = begin; i < end; ++i) {
+                const vec3& p = points[i];
+                Offset& o = quantized[i];
+                const auto quantize = [](float value, float inv) -> unsigned short {
+                    const float c = value * inv + 0.5f;
+                    return static_cast<unsigned short>(std::min(std::max(c, 0.0f), 65535.0f));
+                };
+                o.x = quantize(p.x - block.origin.x, inv_scale[0]);
+                o.y = quantize(p.y - block.origin.y, inv_scale[1]);
+                o.z = quantize(p.z - block.origin.z, inv_scale[2]);
+            }
+        }
+
+        const int num_int = static_cast<int>(num);
+        if (normals) {
+            auto packed = cloud->add_vertex_property<unsigned int>("v:quantized_normal");
+            std::vector<unsigned int>& out = packed.vector();
+            const std::vector<vec3>& in = normals.vector();
+#pragma omp parallel for
+            for (int i = 0; i < num_int; ++i)
+                out[i] = encode_normal(in[i]);
+        }
+        if (colors) {
+            auto packed = cloud->add_vertex_property<unsigned int>("v:quantized_color");
+            std::vector<unsigned int>& out = packed.vector();
+            const std::vector<vec3>& in = colors.vector();
+#pragma omp parallel for
+            for (int i = 0; i < num_int; ++i) {
+                const vec3& c = in[i];
+                const auto to_byte = [](float v) -> unsigned int {
+                    return static_cast<unsigned int>(std::min(std::max(v * 255.0f + 0.5f, 0.0f), 255.0f));
+                };
+                out[i] = to_byte(c.x) | (to_byte(c.y) << 8) | (to_byte(c.z) << 16);
+            }
+        }
+
+        // release the raw float storage. The properties stay registered (with empty vectors),
+        // so the handles remain valid for decompress(); points().empty() is what the renderer
+        // and the algorithms check, so they take their no-geometry paths instead of reading
+        // stale data. Note that the container still counts n_vertices() vertices.
+        cloud->points().clear();
+        cloud->points().shrink_to_fit();
+        if (normals) {
+            normals.vector().clear();
+            normals.vector().shrink_to_fit();
+        }
+        if (colors) {
+            colors.vector().clear();
+            colors.vector().shrink_to_fit();
+        }
+        return true;
+    }
+
+
+    bool PointCloudQuantization::decompress(PointCloud* cloud)
+    {
+        if (!is_compressed(cloud)) {
+            LOG_IF(WARNING, cloud) << "point cloud is not compressed";
+            return false;
+        }
+
+        const View view(cloud);
+        const std::size_t num = cloud->n_vertices();
+        const int num_int = static_cast<int>(num);
+
+        std::vector<vec3>& points = cloud->points();
+        points.resize(num);
+#pragma omp parallel for
+        for (int i = 0; i < num_int; ++i)
+            points[i] = view.position(i);
+
+        if (view.has_normals()) {
+            auto normals = cloud->get_vertex_property<vec3>("v:normal");
+            std::vector<vec3>& out = normals.vector();
+            out.resize(num);
+#pragma omp parallel for
+            for (int i = 0; i < num_int; ++i)
+                out[i] = view.normal(i);
+        }
+        if (view.has_colors()) {
+            auto colors = cloud->get_vertex_property<vec3>("v:color");
+            std::vector<vec3>& out = colors.vector();
+            out.resize(num);
+#pragma omp parallel for
+            for (int i = 0; i < num_int; ++i)
+                out[i] = view.color(i);
+        }
+
+        cloud->remove_vertex_property("v:quantized_point");
+        cloud->remove_vertex_property("v:quantized_normal");
+        cloud->remove_vertex_property("v:quantized_color");
+        cloud->remove_model_property("q:blocks");
+        return true;
+    }
+
+
+    PointCloudQuantization::View::View(const PointCloud* cloud)
+        : offsets_(nullptr), normals_(nullptr), colors_(nullptr), blocks_(nullptr), size_(0)
+    {
+        if (!cloud)
+            return;
+        const auto offsets = cloud->get_vertex_property<Offset>("v:quantized_point");
+        const auto blocks = cloud->get_model_property<std::vector<Block>>("q:blocks");
+        if (!offsets || !blocks)
+            return;
+
+        offsets_ = offsets.data();
+        blocks_ = &blocks.vector()[0];
+        size_ = cloud->n_vertices();
+
+        const auto normals = cloud->get_vertex_property<unsigned int>("v:quantized_normal");
+        if (normals)
+            normals_ = normals.data();
+        const auto colors = cloud->get_vertex_property<unsigned int>("v:quantized_color");
+        if (colors)
+            colors_ = colors.data();
+    }
+
+} // namespace easy3d
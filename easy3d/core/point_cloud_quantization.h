@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_CORE_POINT_CLOUD_QUANTIZATION_H
+#define EASY3D_CORE_POINT_CLOUD_QUANTIZATION_H
+
+#include <easy3d/core/point_cloud.h>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Compressed in-memory storage mode for point clouds.
+     * \class PointCloudQuantization easy3d/core/point_cloud_quantization.h
+     *
+     * \details Massive clouds at 12 bytes per position (plus normals and colors) exceed the RAM
+     *      of analysis machines. compress() replaces the float attributes with quantized ones,
+     *      stored through the regular property mechanism:
+     *      - positions become 16-bit offsets within spatial blocks. A block is a contiguous run
+     *        of block_size points sharing an origin and scale (one table entry per block); the
+     *        cloud is reordered along a Morton curve first, so the points of a block are close
+     *        in space and the 16-bit resolution is spent on a small extent.
+     *      - normals are packed into a 16+16-bit octahedral encoding.
+     *      - colors are packed into 8 bits per channel.
+     *      This shrinks positions 2x and normals/colors 3x (36 -> 14 bytes per point when all
+     *      three attributes are present); the block table is negligible.
+     *
+     *      While compressed, positions are read through the decode-on-access View (in O(1) per
+     *      point); the raw points() vector is empty. The cloud must not be structurally modified
+     *      (no adding/deleting of vertices, no garbage collection) and must be decompress()ed
+     *      before saving to a file. Rendering keeps working: the drawable update decodes
+     *      transiently for the GPU upload (see buffers::update()).
+     */
+    class PointCloudQuantization {
+    public:
+        /// \brief The 16-bit offsets of a position within its block.
+        struct Offset {
+            Offset() : x(0), y(0), z(0) {}
+            unsigned short x, y, z;
+        };
+
+        /// \brief One spatial block: a contiguous run of block_size points quantized against a
+        ///     common origin and scale.
+        struct Block {
+            Block() : origin(0, 0, 0), scale(0, 0, 0) {}
+            vec3 origin;
+            vec3 scale;     ///< block extent / 65535, per axis (0 for a degenerate axis)
+        };
+
+        /// The number of points per block. The i'th point belongs to block i / block_size.
+        static const unsigned int block_size = 1024;
+
+    public:
+        /**
+         * \brief Switches \p cloud to the compressed storage mode.
+         * \details Garbage is collected and the points are reordered along a Morton curve (like
+         *      PointCloud::sort_spatially()) before quantization. The raw "v:point" (and, when
+         *      present, "v:normal" and "v:color") storage is released; other vertex properties
+         *      are left untouched.
+         * \return true on success (false for an empty or already compressed cloud).
+         */
+        static bool compress(PointCloud* cloud);
+
+        /// \brief Restores the float attributes from the quantized ones and removes the latter.
+        /// \return true on success (false if \p cloud is not compressed).
+        static bool decompress(PointCloud* cloud);
+
+        /// \brief Whether \p cloud is in the compressed storage mode.
+        static bool is_compressed(const PointCloud* cloud);
+
+        /// \brief Packs a unit normal into the 16+16-bit octahedral encoding.
+        static unsigned int encode_normal(const vec3& n);
+
+        /// \brief Unpacks a normal from the 16+16-bit octahedral encoding. The result is
+        ///     normalized; the worst-case angular error is about 0.01 degrees.
+        static vec3 decode_normal(unsigned int code);
+
+    public:
+        /**
+         * \brief Decode-on-access view of the attributes of a compressed cloud.
+         * \details Dereferencing is O(1) per point (no search; the block of point \c i is
+         *      \c i / block_size). The view holds raw pointers into the property arrays, so it
+         *      is invalidated by decompress() and by property changes.
+         */
+        class View {
+        public:
+            explicit View(const PointCloud* cloud);
+
+            /// \brief Whether the view is usable (i.e., the cloud is compressed).
+            bool is_valid() const { return offsets_ != nullptr; }
+
+            /// \brief The number of points.
+            std::size_t size() const { return size_; }
+
+            /// \brief The decoded position of point \p i.
+            vec3 position(std::size_t i) const {
+                const Offset& o = offsets_[i];
+                const Block& b = (*blocks_)[i / block_size];
+                return b.origin + vec3(float(o.x) * b.scale.x,
+                                       float(o.y) * b.scale.y,
+                                       float(o.z) * b.scale.z);
+            }
+
+            bool has_normals() const { return normals_ != nullptr; }
+            /// \brief The decoded normal of point \p i (normals must be present).
+            vec3 normal(std::size_t i) const { return decode_normal(normals_[i]); }
+
+            bool has_colors() const { return colors_ != nullptr; }
+            /// \brief The decoded color of point \p i (colors must be present).
+            vec3 color(std::size_t i) const {
+                const unsigned int c = colors_[i];
+                return vec3(float(c & 0xffu), float((c >> 8) & 0xffu), float((c >> 16) & 0xffu)) / 255.0f;
+            }
+
+        private:
+            const Offset* offsets_;
+            const unsigned int* normals_;
+            const unsigned int* colors_;
+            const std::vector<Block>* blocks_;
+            std::size_t size_;
+        };
+    };
+
+} // namespace easy3d
+
+
+#endif // EASY3D_CORE_POINT_CLOUD_QUANTIZATION_H
@@ -139,6 +139,9 @@ namespace easy3d {
         vpoint_   = add_vertex_property<vec3>("v:point");
 
         mprops_.push_back();
+
+        // no valid face partition yet
+        partition_faces_size_ = partition_cells_size_ = static_cast<unsigned int>(-1);
     }
 
 
@@ -175,6 +178,9 @@ namespace easy3d {
 
             // normals might be there, therefore use get_property
             fnormal_  = get_halfface_property<vec3>("f:normal");
+
+            // the cached face partition belongs to the previous topology
+            partition_faces_size_ = partition_cells_size_ = static_cast<unsigned int>(-1);
         }
 
         return *this;
@@ -219,6 +225,9 @@ namespace easy3d {
             eprops_.resize(rhs.n_edges());
             fprops_.resize(rhs.n_faces());
             mprops_.resize(1);
+
+            // the cached face partition belongs to the previous topology
+            partition_faces_size_ = partition_cells_size_ = static_cast<unsigned int>(-1);
         }
 
         return *this;
@@ -597,6 +606,23 @@ namespace easy3d {
     }
 
 
+    const std::vector<PolyMesh::Face>& PolyMesh::faces(bool border) const {
+        if (n_faces() != partition_faces_size_ || n_cells() != partition_cells_size_) {
+            border_faces_.clear();
+            interior_faces_.clear();
+            for (auto f : faces()) {
+                if (is_border(f))
+                    border_faces_.push_back(f);
+                else
+                    interior_faces_.push_back(f);
+            }
+            partition_faces_size_ = n_faces();
+            partition_cells_size_ = n_cells();
+        }
+        return border ? border_faces_ : interior_faces_;
+    }
+
+
     bool PolyMesh::is_tetraheral_mesh() const {
         for (auto f : faces()) {
             if (vertices(f).size() != 3)
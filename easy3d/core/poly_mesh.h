@@ -764,6 +764,33 @@ namespace easy3d {
             cprops_.resize(nc);
         }
 
+        /// the memory (in bytes) occupied by the mesh. \sa Model::memory_usage().
+        std::size_t memory_usage() const {
+            return vprops_.memory_usage() + eprops_.memory_usage() + hprops_.memory_usage() +
+                   fprops_.memory_usage() + cprops_.memory_usage() + mprops_.memory_usage();
+        }
+
+        /// appends one record per property array, reporting the bytes used and allocated
+        /// (the difference being reclaimable slack). \sa Model::memory_report().
+        void memory_report(std::vector<PropertyMemoryRecord> &records) const {
+            vprops_.memory_report(records);
+            eprops_.memory_report(records);
+            hprops_.memory_report(records);
+            fprops_.memory_report(records);
+            cprops_.memory_report(records);
+            mprops_.memory_report(records);
+        }
+
+        /// releases the unused capacity of all property arrays. \sa Model::shrink_to_fit().
+        void shrink_to_fit() {
+            vprops_.shrink_to_fit();
+            eprops_.shrink_to_fit();
+            hprops_.shrink_to_fit();
+            fprops_.shrink_to_fit();
+            cprops_.shrink_to_fit();
+            mprops_.shrink_to_fit();
+        }
+
         /// return whether vertex \c v is valid, i.e. the index is stores it within the array bounds.
         bool is_valid(Vertex v) const
         {
@@ -1301,6 +1328,15 @@ namespace easy3d {
             return is_border(halfface(f, 0)) || is_border(halfface(f, 1));
         }
 
+        /// \brief returns the faces on the border (if \p border is \c true) or in the interior
+        ///     (if \p border is \c false) of the mesh.
+        /// \details The interior/border partition of the faces is extracted on first use and then
+        ///     cached. A PolyMesh can only grow (elements cannot be removed), so the cache is
+        ///     refreshed only when the numbers of faces or cells have changed; modifying geometry
+        ///     or attributes on a fixed topology (e.g., visualizing time-varying cell data on a
+        ///     simulation mesh) keeps reusing the cached partition.
+        const std::vector<Face>& faces(bool border) const;
+
         /// find the edge (a,b)
         Edge find_edge(Vertex a, Vertex b) const;
 
@@ -1395,6 +1431,13 @@ namespace easy3d {
 
         VertexProperty<vec3>    vpoint_;
         HalfFaceProperty<vec3>  fnormal_;
+
+        // cached interior/border partition of the faces (see faces(bool)), keyed by the
+        // numbers of faces and cells at the time of extraction.
+        mutable std::vector<Face>   border_faces_;
+        mutable std::vector<Face>   interior_faces_;
+        mutable unsigned int        partition_faces_size_;
+        mutable unsigned int        partition_cells_size_;
     };
 
 
@@ -54,6 +54,12 @@ namespace easy3d {
         template <typename InputIterator>
         void add_points(InputIterator first, InputIterator last);
 
+        /// \brief Adds \p num points (with unit weights) in one call. Must be used between
+        ///        begin() and end(), like add_point(). This is noticeably faster than repeated
+        ///        add_point() calls: the accumulation runs over a flat array and the compiler
+        ///        can vectorize it.
+        void add_points(const Vec<DIM, FT>* points, int num);
+
         /// \brief The weighted average of the points.
         Vec<DIM, FT> center() const;
 
@@ -83,6 +89,52 @@ namespace easy3d {
 
 namespace easy3d {
 
+    namespace details {
+
+        // the generic (iterative) eigen solver
+        template <int DIM, typename FT>
+        inline void solve_inertia(FT** M, FT (&eigen_value)[DIM], FT (&axis)[DIM][DIM]) {
+            EigenSolver<FT> solver(DIM);
+            solver.solve(M, EigenSolver<FT>::DECREASING);
+
+            for (unsigned short i = 0; i < DIM; ++i) {
+                eigen_value[i] = solver.eigen_value(i);
+                for (unsigned short j = 0; j < DIM; ++j)
+                    axis[i][j] = solver.eigen_vector(j, i); // eigenvectors are stored in columns
+            }
+
+            // Normalize the eigen vectors
+            for (unsigned short i = 0; i < DIM; i++) {
+                FT sqr_len(0);
+                for (unsigned short j = 0; j < DIM; j++)
+                    sqr_len += (axis[i][j] * axis[i][j]);
+                FT s = std::sqrt(sqr_len);
+                s = (s > std::numeric_limits<FT>::min()) ? FT(1.0) / s : FT(0.0);
+                for (unsigned short j = 0; j < DIM; ++j)
+                    axis[i][j] *= s;
+            }
+        }
+
+        // the 3D case goes through the closed-form symmetric solver, which costs a fixed,
+        // small number of operations (it returns unit-length vectors, so no normalization)
+        template <typename FT>
+        inline void solve_inertia(FT** M, FT (&eigen_value)[3], FT (&axis)[3][3]) {
+            const Mat3<FT> A(M[0][0], M[0][1], M[0][2],
+                             M[1][0], M[1][1], M[1][2],
+                             M[2][0], M[2][1], M[2][2]);
+            Vec<3, FT> evals;
+            Mat3<FT> evecs;
+            SymmetricEigenSolver3<FT>::solve(A, evals, evecs);
+
+            for (unsigned short i = 0; i < 3; ++i) {
+                eigen_value[i] = evals[i];
+                for (unsigned short j = 0; j < 3; ++j)
+                    axis[i][j] = evecs(j, i);   // eigenvectors are stored in columns
+            }
+        }
+
+    }
+
 
     template <int DIM, typename FT>
     PrincipalAxes<DIM, FT>::PrincipalAxes() {
@@ -157,25 +209,7 @@ namespace easy3d {
                     M_[i][i] = std::numeric_limits<FT>::min();
             }
 
-            EigenSolver<FT> solver(DIM);
-            solver.solve(M_, EigenSolver<FT>::DECREASING);
-
-            for (unsigned short i=0; i<DIM; ++i) {
-                eigen_value_[i] = solver.eigen_value(i);
-                for (unsigned short j=0; j<DIM; ++j)
-                    axis_[i][j] = solver.eigen_vector(j, i); // eigenvectors are stored in columns
-            }
-
-            // Normalize the eigen vectors
-            for(unsigned short i=0; i<DIM; i++) {
-                FT sqr_len(0);
-                for(unsigned short j=0; j<DIM; j++)
-                    sqr_len += (axis_[i][j] * axis_[i][j]);
-                FT s = std::sqrt(sqr_len);
-                s = (s > std::numeric_limits<FT>::min()) ? FT(1.0) / s : FT(0.0);
-                for (unsigned short j = 0; j < DIM; ++j)
-                    axis_[i][j] *= s;
-            }
+            details::solve_inertia(M_, eigen_value_, axis_);
         }
     }
 
@@ -195,6 +229,37 @@ namespace easy3d {
     }
 
 
+    // Flat accumulation of a set of points with unit weights. The fixed-size local
+    // accumulators can be kept in registers and the loop vectorized, which repeated
+    // add_point() calls (accumulating through the heap-allocated M_) do not allow.
+    template <int DIM, typename FT>
+    inline void PrincipalAxes<DIM, FT>::add_points(const Vec<DIM, FT>* points, int num) {
+        FT center[DIM], cov[DIM][DIM];
+        for (unsigned short i = 0; i < DIM; ++i) {
+            center[i] = 0;
+            for (unsigned short j = 0; j < DIM; ++j)
+                cov[i][j] = 0;
+        }
+
+        for (int n = 0; n < num; ++n) {
+            const Vec<DIM, FT>& p = points[n];
+            for (unsigned short i = 0; i < DIM; ++i) {
+                center[i] += p[i];
+                for (unsigned short j = i; j < DIM; ++j)
+                    cov[i][j] += p[i] * p[j];
+            }
+        }
+
+        for (unsigned short i = 0; i < DIM; ++i) {
+            center_[i] += center[i];
+            for (unsigned short j = i; j < DIM; ++j)
+                M_[i][j] += cov[i][j];
+        }
+        nb_points_ += num;
+        sum_weights_ += FT(num);
+    }
+
+
     // add a set of point (it internally calls add_point())
     template <int DIM, typename FT>
     template <typename InputIterator >
@@ -41,15 +41,152 @@
 #define EASY3D_CORE_PROPERTIES_H
 
 #include <vector>
+#include <deque>
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <typeinfo>
+#include <unordered_map>
+#include <utility>
 #include <cassert>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 
 namespace easy3d {
 
+    /// \brief An interned property name.
+    /// \class PropertyName easy3d/core/properties.h
+    /// \details Property names are interned into small integer IDs (each distinct string is
+    ///     assigned an ID once, on first use), so name comparisons inside PropertyContainer are
+    ///     single integer compares instead of character-wise string comparisons, and lookups go
+    ///     through an integer-keyed index map in O(1). Construction from a string pays the
+    ///     interning cost (one hash of the string); construct frequently used names once and
+    ///     reuse them, e.g.,
+    ///     \code
+    ///         static const PropertyName pts("v:point");
+    ///         auto points = mesh->get_vertex_property<vec3>(pts);   // no string hashing
+    ///     \endcode
+    ///     All string-based property APIs accept a PropertyName implicitly, so existing call
+    ///     sites keep working unchanged.
+    class PropertyName
+    {
+    public:
+        /// Constructs an invalid name.
+        PropertyName() : id_(-1) {}
+
+        /// Interns \c name (implicit, so any API taking a PropertyName also accepts a string).
+        PropertyName(const std::string& name) : id_(intern(name)) {}
+        PropertyName(const char* name) : id_(intern(name)) {}
+
+        /// Returns the interned ID of the name (-1 for an invalid name).
+        int id() const { return id_; }
+
+        /// Returns the name as a string.
+        const std::string& string() const {
+            static const std::string invalid;
+            return (id_ >= 0) ? registry().names[id_] : invalid;
+        }
+
+        bool operator==(const PropertyName& rhs) const { return id_ == rhs.id_; }
+        bool operator!=(const PropertyName& rhs) const { return id_ != rhs.id_; }
+
+    private:
+        static int intern(const std::string& name) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> guard(reg.mutex);
+            auto pos = reg.index.find(name);
+            if (pos != reg.index.end())
+                return pos->second;
+            const int id = static_cast<int>(reg.names.size());
+            reg.names.push_back(name);  // a deque, so references stay valid
+            reg.index[name] = id;
+            return id;
+        }
+
+        struct Registry {
+            std::deque<std::string>              names;
+            std::unordered_map<std::string, int> index;
+            std::mutex                           mutex;
+        };
+        static Registry& registry() {
+            static Registry reg;
+            return reg;
+        }
+
+        int id_;
+    };
+
+
+    // \cond
+    namespace details {
+
+        // Global tuning for the storage of large property arrays (see
+        // PropertyContainer::set_large_array_tuning()). Function-local statics keep the
+        // header self-contained, like the PropertyName registry above.
+        struct LargeArrayTuning {
+            bool        enabled;
+            std::size_t threshold;  // in bytes
+            LargeArrayTuning() : enabled(false), threshold(2097152) {}
+        };
+
+        inline LargeArrayTuning& large_array_tuning() {
+            static LargeArrayTuning tuning;
+            return tuning;
+        }
+
+        // Applies the tuning to a freshly reserved array storage: advises the kernel to back
+        // the range with transparent huge pages, and first-touches the not yet used part in
+        // parallel, so on NUMA machines the pages are distributed across the nodes of the
+        // touching threads - matching the static partitioning of the parallel sweeps that
+        // traverse the array later - instead of all landing on the allocating thread's node.
+        // No-op for arrays below the threshold and on non-Linux platforms.
+        inline void tune_large_array(void* addr, std::size_t used_bytes, std::size_t allocated_bytes) {
+            const LargeArrayTuning& tuning = large_array_tuning();
+            if (!tuning.enabled || !addr || allocated_bytes < tuning.threshold)
+                return;
+    #ifdef __linux__
+            const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            char* const begin = static_cast<char*>(addr);
+            char* const end = begin + allocated_bytes;
+            // madvise() wants page-aligned addresses; the vector's allocation is not, so
+            // shrink the range inward to whole pages
+            char* const page_begin = reinterpret_cast<char*>(
+                (reinterpret_cast<std::uintptr_t>(begin) + page - 1) & ~std::uintptr_t(page - 1));
+            char* const page_end = reinterpret_cast<char*>(
+                reinterpret_cast<std::uintptr_t>(end) & ~std::uintptr_t(page - 1));
+        #ifdef MADV_HUGEPAGE
+            if (page_end > page_begin)
+                madvise(page_begin, static_cast<std::size_t>(page_end - page_begin), MADV_HUGEPAGE);
+        #endif
+            // pages holding the first used_bytes were touched already (their node is set);
+            // touch the remaining ones from parallel workers
+            char* touch_begin = reinterpret_cast<char*>(
+                (reinterpret_cast<std::uintptr_t>(begin + used_bytes) + page - 1) & ~std::uintptr_t(page - 1));
+            if (touch_begin < page_end) {
+                const long long num_pages = (page_end - touch_begin) / static_cast<long long>(page);
+    #pragma omp parallel for schedule(static)
+                for (long long i = 0; i < num_pages; ++i)
+                    touch_begin[i * static_cast<long long>(page)] = 0;
+            }
+    #else
+            (void)used_bytes;
+    #endif
+        }
+
+    }
+    // \endcond
+
+
+    //== CLASS DEFINITION =========================================================
+
     /// \brief Base class for a property array.
     /// \class BasePropertyArray easy3d/core/properties.h
     class BasePropertyArray
@@ -57,7 +194,7 @@ namespace easy3d {
     public:
 
         /// Default constructor
-        BasePropertyArray(const std::string& name) : name_(name) {}
+        BasePropertyArray(const std::string& name) : name_(name), name_id_(PropertyName(name).id()) {}
 
         /// Destructor.
         virtual ~BasePropertyArray() {}
@@ -83,9 +220,17 @@ namespace easy3d {
         /// Let two elements swap their storage place.
         virtual void swap(size_t i0, size_t i1) = 0;
 
+        /// Reorder the elements: element \c order[i] moves to position \c i.
+        virtual void permute(const std::vector<size_t>& order) = 0;
+
         /// Let copy 'from' -> 'to'.
         virtual void copy(size_t from, size_t to) = 0;
 
+        /// Adopt the storage of \c other (which must be of the same type): afterwards this
+        /// array shares the elements of \c other with copy-on-write semantics. Returns false
+        /// if the types do not match.
+        virtual bool assign(const BasePropertyArray& other) = 0;
+
         /// Return a deep copy of self.
         virtual BasePropertyArray* clone () const = 0;
 
@@ -95,20 +240,33 @@ namespace easy3d {
         /// Return the type_info of the property
         virtual const std::type_info& type() const = 0;
 
+        /// Return the memory (in bytes) occupied by the element storage. Storage shared
+        /// between copy-on-write clones is counted in full by each sharing array.
+        virtual std::size_t memory_usage() const = 0;
+
+        /// Return the memory (in bytes) actually used by the elements. The difference to
+        /// memory_usage() is the slack from the vector's growth strategy; shrink_to_fit()
+        /// reclaims it.
+        virtual std::size_t memory_used() const = 0;
+
         /// Return the name of the property
         const std::string& name() const { return name_; }
 
+        /// Return the interned ID of the property name (see PropertyName)
+        int name_id() const { return name_id_; }
+
         /// Set the name of the property
-        void set_name(const std::string& n) { name_ = n; }
+        void set_name(const std::string& n) { name_ = n; name_id_ = PropertyName(n).id(); }
 
         bool is_same (const BasePropertyArray& other)
         {
-            return (name() == other.name() && type() == other.type());
+            return (name_id_ == other.name_id_ && type() == other.type());
         }
 
     protected:
 
         std::string name_;
+        int         name_id_;
     };
 
 
@@ -117,6 +275,17 @@ namespace easy3d {
 
     /// \brief Implementation of a generic property array.
     /// \class PropertyArray easy3d/core/properties.h
+    /// \details The element storage is shared between clones with copy-on-write semantics: clone()
+    ///     (and thus copying a PropertyContainer, e.g., a whole SurfaceMesh) only shares the
+    ///     immutable storage in O(1), and the actual copy is made on the first write to one of the
+    ///     sharing arrays. Workflows that keep many copies of a model differing only in a few
+    ///     properties (e.g., deformed variants of one mesh) therefore pay memory only for what
+    ///     actually differs.
+    /// \attention Two copy-on-write caveats. Raw pointers/references obtained \em before a copy
+    ///     (data(), vector()) keep aliasing the shared storage until the owning array is written
+    ///     to again. And the first write after a copy is what clones the storage, so when several
+    ///     threads write concurrently into a freshly copied array, detach it once beforehand with
+    ///     any mutable access (e.g., vector()).
     template <class T>
     class PropertyArray : public BasePropertyArray
     {
@@ -127,36 +296,53 @@ namespace easy3d {
         typedef typename vector_type::reference         reference;
         typedef typename vector_type::const_reference   const_reference;
 
-        PropertyArray(const std::string& name, T t=T()) : BasePropertyArray(name), value_(t) {}
+        PropertyArray(const std::string& name, T t=T())
+            : BasePropertyArray(name), data_(std::make_shared<vector_type>()), value_(t) {}
 
 
     public: // virtual interface of BasePropertyArray
 
         virtual void reserve(size_t n)
         {
-            data_.reserve(n);
+            detach();
+            const size_t old_capacity = data_->capacity();
+            data_->reserve(n);
+            if (data_->capacity() != old_capacity)
+                tune_storage();     // huge pages / parallel first touch for large arrays
         }
 
         virtual void resize(size_t n)
         {
-            data_.resize(n, value_);
+            detach();
+            const size_t old_capacity = data_->capacity();
+            data_->resize(n, value_);
+            // here the new elements were already touched by their value-initialization, but
+            // the huge page advice still applies (the kernel merges the pages afterwards)
+            if (data_->capacity() != old_capacity)
+                tune_storage();
         }
 
         virtual void push_back()
         {
-            data_.push_back(value_);
+            detach();
+            const size_t old_capacity = data_->capacity();
+            data_->push_back(value_);
+            if (data_->capacity() != old_capacity)   // a doubling step of the growth strategy
+                tune_storage();
         }
 
         virtual void reset(size_t idx)
         {
-            data_[idx] = value_;
+            detach();
+            (*data_)[idx] = value_;
         }
 
         bool transfer(const BasePropertyArray& other)
         {
             const PropertyArray<T>* pa = dynamic_cast<const PropertyArray*>(&other);
             if(pa != nullptr){
-                std::copy((*pa).data_.begin(), (*pa).data_.end(), data_.end()-(*pa).data_.size());
+                detach();
+                std::copy(pa->data_->begin(), pa->data_->end(), data_->end()-pa->data_->size());
                 return true;
             }
             return false;
@@ -167,7 +353,8 @@ namespace easy3d {
             const PropertyArray<T>* pa = dynamic_cast<const PropertyArray*>(&other);
             if (pa != nullptr)
             {
-                data_[to] = (*pa)[from];
+                detach();
+                (*data_)[to] = (*pa)[from];
                 return true;
             }
 
@@ -176,25 +363,52 @@ namespace easy3d {
 
         virtual void shrink_to_fit()
         {
-            vector_type(data_).swap(data_);
+            if (detach())   // detaching already copies without the excess capacity
+                return;
+            vector_type(*data_).swap(*data_);
         }
 
         virtual void swap(size_t i0, size_t i1)
         {
-            T d(data_[i0]);
-            data_[i0]=data_[i1];
-            data_[i1]=d;
+            detach();
+            T d((*data_)[i0]);
+            (*data_)[i0]=(*data_)[i1];
+            (*data_)[i1]=d;
+        }
+
+        virtual void permute(const std::vector<size_t>& order)
+        {
+            assert(order.size() == data_->size());
+            // the elements are gathered into fresh storage (in parallel), which also
+            // detaches shared (copy-on-write) storage without an extra copy
+            auto gathered = std::make_shared<vector_type>(data_->size(), value_);
+#pragma omp parallel for
+            for (long long i = 0; i < static_cast<long long>(order.size()); ++i)
+                (*gathered)[i] = (*data_)[order[i]];
+            data_ = gathered;
         }
 
         virtual void copy(size_t from, size_t to)
         {
-            data_[to]=data_[from];
+            detach();
+            (*data_)[to]=(*data_)[from];
+        }
+
+        virtual bool assign(const BasePropertyArray& other)
+        {
+            const PropertyArray<T>* pa = dynamic_cast<const PropertyArray*>(&other);
+            if (pa != nullptr) {
+                data_ = pa->data_;  // shared again; copy-on-write protects both sides
+                value_ = pa->value_;
+                return true;
+            }
+            return false;
         }
 
         virtual BasePropertyArray* clone() const
         {
             PropertyArray<T>* p = new PropertyArray<T>(name_, value_);
-            p->data_ = data_;
+            p->data_ = data_;   // shared now; the storage is copied on the first write
             return p;
         }
 
@@ -206,40 +420,79 @@ namespace easy3d {
 
         virtual const std::type_info& type() const { return typeid(T); }
 
+        virtual std::size_t memory_usage() const { return data_->capacity() * sizeof(T); }
+
+        virtual std::size_t memory_used() const { return data_->size() * sizeof(T); }
+
 
     public:
 
         /// Get pointer to array (does not work for T==bool)
         const T* data() const
         {
-            return &data_[0];
+            return &(*data_)[0];
+        }
+
+        /// Get writable pointer to array (does not work for T==bool)
+        T* data()
+        {
+            detach();
+            return &(*data_)[0];
         }
 
 
         /// Get reference to the underlying vector
         std::vector<T>& vector()
         {
-            return data_;
+            detach();
+            return *data_;
+        }
+
+        /// Get const reference to the underlying vector
+        const std::vector<T>& vector() const
+        {
+            return *data_;
         }
 
 
         /// Access the i'th element. No range check is performed!
         reference operator[](size_t _idx)
         {
-            assert( size_t(_idx) < data_.size() );
-            return data_[_idx];
+            assert( size_t(_idx) < data_->size() );
+            detach();
+            return (*data_)[_idx];
         }
 
         /// Const access to the i'th element. No range check is performed!
         const_reference operator[](size_t _idx) const
         {
-            assert( size_t(_idx) < data_.size());
-            return data_[_idx];
+            assert( size_t(_idx) < data_->size());
+            return (*data_)[_idx];
         }
 
 
     private:
-        vector_type data_;
+        /// Applies the global large-array allocation tuning (see
+        /// PropertyContainer::set_large_array_tuning()) to a freshly grown storage.
+        void tune_storage()
+        {
+            details::tune_large_array(static_cast<void*>(data_->data()),
+                                      data_->size() * sizeof(T),
+                                      data_->capacity() * sizeof(T));
+        }
+
+        /// Copy-on-write: clones the storage if it is shared with other property arrays
+        /// (i.e., with copies of the owning container). Returns whether a copy was made.
+        bool detach()
+        {
+            if (data_.use_count() > 1) {
+                data_ = std::make_shared<vector_type>(*data_);
+                return true;
+            }
+            return false;
+        }
+
+        std::shared_ptr<vector_type> data_;
         value_type  value_;
     };
 
@@ -253,6 +506,37 @@ namespace easy3d {
         return nullptr;
     }
 
+    template <>
+    inline bool*
+    PropertyArray<bool>::data()
+    {
+        assert(false);
+        return nullptr;
+    }
+
+    // std::vector<bool> is bit-packed, so its capacity is in elements, not bytes
+    template <>
+    inline std::size_t
+    PropertyArray<bool>::memory_usage() const
+    {
+        return (data_->capacity() + 7) / 8;
+    }
+
+    template <>
+    inline std::size_t
+    PropertyArray<bool>::memory_used() const
+    {
+        return (data_->size() + 7) / 8;
+    }
+
+    // std::vector<bool> exposes no raw storage, and a bit-packed array is too small to be
+    // worth tuning anyway
+    template <>
+    inline void
+    PropertyArray<bool>::tune_storage()
+    {
+    }
+
 
 
     //== CLASS DEFINITION =========================================================
@@ -292,10 +576,24 @@ namespace easy3d {
         const_reference operator[](size_t i) const
         {
             assert(parray_ != nullptr);
-            return (*parray_)[i];
+            return array()[i];  // through the const array, so read access never detaches
         }
 
+        /// \brief Gets the raw data pointer of the property (does not work for T==bool).
+        /// \details The pointer stays valid as long as no element is added to or removed from the
+        ///     container and the property itself is not removed. Within such a region, hot loops
+        ///     (e.g., circulator traversals) can keep the base pointer in a register and index it
+        ///     directly, avoiding the double indirection of operator[] and enabling the compiler
+        ///     to vectorize.
         const T* data() const
+        {
+            assert(parray_ != nullptr);
+            return array().data();
+        }
+
+        /// \brief Gets the writable raw data pointer of the property (does not work for T==bool).
+        /// \details The same validity contract as the const overload applies.
+        T* data()
         {
             assert(parray_ != nullptr);
             return parray_->data();
@@ -310,7 +608,7 @@ namespace easy3d {
         const std::vector<T>& vector() const
         {
             assert(parray_ != nullptr);
-            return parray_->vector();
+            return array().vector();
         }
 
         PropertyArray<T>& array()
@@ -346,12 +644,41 @@ namespace easy3d {
     //== CLASS DEFINITION =========================================================
 
 
+    /// \brief The memory occupied by one property array (see PropertyContainer::memory_report()
+    ///     and Model::memory_report()). The property name carries the element kind prefix
+    ///     (e.g., "v:point", "f:normal"), so a flat list of records is self-describing.
+    struct PropertyMemoryRecord {
+        std::string name;       ///< the name of the property
+        std::size_t used;       ///< bytes actually used by the elements
+        std::size_t allocated;  ///< bytes allocated; the difference to \c used is reclaimable slack
+    };
+
+
     /// \brief Implementation of generic property container.
     /// \class PropertyContainer easy3d/core/properties.h
     class PropertyContainer
     {
     public:
 
+        /**
+         * \brief Globally enables (or disables) allocation tuning for large property arrays.
+         * \details When enabled, every property array whose storage reaches \p threshold_bytes
+         *      gets its freshly reserved memory advised to be backed by transparent huge pages
+         *      (fewer TLB misses in full-array sweeps) and first-touched by parallel workers, so
+         *      on NUMA machines the pages spread across the nodes of the threads that will later
+         *      traverse the array, instead of all landing on the node of the allocating thread.
+         *      The tuning hooks into reserve() - the usual load path, since the file readers
+         *      reserve up front - and is a no-op on non-Linux platforms.
+         * \param enabled Whether the tuning is applied. Off by default.
+         * \param threshold_bytes Arrays smaller than this are left alone. The default (2 MB) is
+         *      the x86-64 huge page size; smaller arrays cannot benefit.
+         */
+        static void set_large_array_tuning(bool enabled, std::size_t threshold_bytes = 2097152)
+        {
+            details::large_array_tuning().enabled = enabled;
+            details::large_array_tuning().threshold = threshold_bytes;
+        }
+
         // default constructor
         PropertyContainer() : size_(0) {}
 
@@ -371,10 +698,46 @@ namespace easy3d {
                 size_ = _rhs.size();
                 for (size_t i=0; i<parrays_.size(); ++i)
                     parrays_[i] = _rhs.parrays_[i]->clone();
+                index_ = _rhs.index_;
             }
             return *this;
         }
 
+        // Restores the state captured in a snapshot (an earlier copy of this container).
+        // Equivalent to assignment, except that property arrays present in both keep their
+        // identity, so Property handles into this container (e.g., the connectivity and point
+        // properties of a mesh) remain valid across the restore. Properties added after the
+        // snapshot was taken are dropped; removed ones are brought back. Every array merely
+        // re-shares the snapshot's storage (copy-on-write), so the cost is O(1) per array,
+        // independent of the number of elements.
+        void restore(const PropertyContainer& snapshot)
+        {
+            if (this == &snapshot)
+                return;
+            std::vector<BasePropertyArray*> restored;
+            restored.reserve(snapshot.parrays_.size());
+            for (size_t i=0; i<snapshot.parrays_.size(); ++i)
+            {
+                BasePropertyArray* kept = nullptr;
+                for (size_t j=0; j<parrays_.size(); ++j)
+                {
+                    if (parrays_[j] && parrays_[j]->is_same(*snapshot.parrays_[i])
+                        && parrays_[j]->assign(*snapshot.parrays_[i]))
+                    {
+                        kept = parrays_[j];
+                        parrays_[j] = nullptr;  // consumed
+                        break;
+                    }
+                }
+                restored.push_back(kept ? kept : snapshot.parrays_[i]->clone());
+            }
+            for (size_t i=0; i<parrays_.size(); ++i)
+                delete parrays_[i];     // whatever was not consumed is not part of the snapshot
+            parrays_.swap(restored);
+            size_ = snapshot.size_;
+            rebuild_index();
+        }
+
         void transfer(const PropertyContainer& _rhs)
         {
             for(std::size_t i=0; i<parrays_.size(); ++i){
@@ -405,6 +768,7 @@ namespace easy3d {
 
                 parrays_.push_back (_rhs.parrays_[i]->empty_clone());
                 parrays_.back()->resize(size_);
+                index_[parrays_.back()->name_id()] = parrays_.size() - 1;
             }
         }
 
@@ -425,6 +789,27 @@ namespace easy3d {
         // returns the number of property arrays
         size_t n_properties() const { return parrays_.size(); }
 
+        // returns the memory (in bytes) occupied by all property arrays
+        size_t memory_usage() const
+        {
+            size_t bytes = 0;
+            for (size_t i=0; i<parrays_.size(); ++i)
+                bytes += parrays_[i]->memory_usage();
+            return bytes;
+        }
+
+        // appends one PropertyMemoryRecord per property array
+        void memory_report(std::vector<PropertyMemoryRecord>& records) const
+        {
+            for (size_t i=0; i<parrays_.size(); ++i) {
+                PropertyMemoryRecord record;
+                record.name = parrays_[i]->name();
+                record.used = parrays_[i]->memory_used();
+                record.allocated = parrays_[i]->memory_usage();
+                records.push_back(record);
+            }
+        }
+
         // returns a vector of all property names
         std::vector<std::string> properties() const
         {
@@ -435,40 +820,47 @@ namespace easy3d {
         }
 
 
+        // finds the array of a property by its (interned) name in O(1).
+        // returns nullptr if it does not exist.
+        BasePropertyArray* find_array(const PropertyName& name) const
+        {
+            auto pos = index_.find(name.id());
+            return (pos != index_.end()) ? parrays_[pos->second] : nullptr;
+        }
+
+
         // add a property with name \c name and default value \c t
-        template <class T> Property<T> add(const std::string& name, const T t=T())
+        template <class T> Property<T> add(const PropertyName& name, const T t=T())
         {
             // if a property with this name already exists, return an invalid property
-            for (size_t i=0; i<parrays_.size(); ++i)
+            if (find_array(name))
             {
-                if (parrays_[i]->name() == name)
-                {
-                    LOG(ERROR) << "[PropertyContainer] A property with name \""
-                              << name << "\" already exists. Returning invalid property.";
-                    return Property<T>();
-                }
+                LOG(ERROR) << "[PropertyContainer] A property with name \""
+                          << name.string() << "\" already exists. Returning invalid property.";
+                return Property<T>();
             }
 
             // otherwise add the property
-            PropertyArray<T>* p = new PropertyArray<T>(name, t);
+            PropertyArray<T>* p = new PropertyArray<T>(name.string(), t);
             p->resize(size_);
             parrays_.push_back(p);
+            index_[p->name_id()] = parrays_.size() - 1;
             return Property<T>(p);
         }
 
 
         // get a property by its name. returns invalid property if it does not exist.
-        template <class T> Property<T> get(const std::string& name) const
+        template <class T> Property<T> get(const PropertyName& name) const
         {
-            for (size_t i=0; i<parrays_.size(); ++i)
-                if (parrays_[i]->name() == name)
-                    return Property<T>(dynamic_cast<PropertyArray<T>*>(parrays_[i]));
+            BasePropertyArray* array = find_array(name);
+            if (array)
+                return Property<T>(dynamic_cast<PropertyArray<T>*>(array));
             return Property<T>();
         }
 
 
         // returns a property if it exists, otherwise it creates it first.
-        template <class T> Property<T> get_or_add(const std::string& name, const T t=T())
+        template <class T> Property<T> get_or_add(const PropertyName& name, const T t=T())
         {
             Property<T> p = get<T>(name);
             if (!p) p = add<T>(name, t);
@@ -477,12 +869,10 @@ namespace easy3d {
 
 
         // get the type of property by its name. returns typeid(void) if it does not exist.
-        const std::type_info& get_type(const std::string& name) const
+        const std::type_info& get_type(const PropertyName& name) const
         {
-            for (size_t i=0; i<parrays_.size(); ++i)
-                if (parrays_[i]->name() == name)
-                    return parrays_[i]->type();
-            return typeid(void);
+            BasePropertyArray* array = find_array(name);
+            return array ? array->type() : typeid(void);
         }
 
 
@@ -497,6 +887,7 @@ namespace easy3d {
                     delete *it;
                     parrays_.erase(it);
                     h.reset();
+                    rebuild_index();    // the positions of the remaining arrays have shifted
                     return true;
                 }
             }
@@ -504,36 +895,30 @@ namespace easy3d {
         }
 
         // delete a property by name. Returns true on success.
-        bool remove(const std::string& name)
+        bool remove(const PropertyName& name)
         {
-            std::vector<BasePropertyArray*>::iterator it=parrays_.begin(), end=parrays_.end();
-            for (; it!=end; ++it)
-            {
-                if ((*it)->name() == name)
-                {
-                    delete *it;
-                    parrays_.erase(it);
-                    return true;
-                }
-            }
-            return false;
+            auto pos = index_.find(name.id());
+            if (pos == index_.end())
+                return false;
+            delete parrays_[pos->second];
+            parrays_.erase(parrays_.begin() + pos->second);
+            rebuild_index();    // the positions of the remaining arrays have shifted
+            return true;
         }
 
         // rename a property. Returns true on success.
-        bool rename(const std::string& old_name, const std::string& new_name)
+        bool rename(const PropertyName& old_name, const PropertyName& new_name)
         {
-            assert(!old_name.empty());
-            assert(!new_name.empty());
-            std::vector<BasePropertyArray*>::iterator it=parrays_.begin(), end=parrays_.end();
-            for (; it!=end; ++it)
-            {
-                if ((*it)->name() == old_name)
-                {
-                    (*it)->set_name(new_name);
-                    return true;
-                }
-            }
-            return false;
+            assert(!old_name.string().empty());
+            assert(!new_name.string().empty());
+            auto pos = index_.find(old_name.id());
+            if (pos == index_.end())
+                return false;
+            const size_t i = pos->second;
+            parrays_[i]->set_name(new_name.string());
+            index_.erase(pos);
+            index_[new_name.id()] = i;
+            return true;
         }
 
 
@@ -543,6 +928,7 @@ namespace easy3d {
             for (size_t i=0; i<parrays_.size(); ++i)
                 delete parrays_[i];
             parrays_.clear();
+            index_.clear();
             size_ = 0;
         }
 
@@ -570,6 +956,7 @@ namespace easy3d {
             for (std::size_t i=n; i<parrays_.size(); ++i)
                 delete parrays_[i];
             parrays_.resize(n);
+            rebuild_index();
         }
 
         // free unused space in all arrays
@@ -601,10 +988,33 @@ namespace easy3d {
                 parrays_[i]->swap(i0, i1);
         }
 
+        // apply a whole sequence of element swaps to all arrays, processing each
+        // array independently (and thus in parallel when OpenMP is available).
+        // This is much faster than calling swap() per pair, which touches every
+        // array for every single swap (e.g., during garbage collection).
+        void apply_swaps(const std::vector< std::pair<size_t, size_t> >& pairs) const
+        {
+#pragma omp parallel for
+            for (int i = 0; i < (int)parrays_.size(); ++i) {
+                BasePropertyArray* array = parrays_[i];
+                for (std::size_t j = 0; j < pairs.size(); ++j)
+                    array->swap(pairs[j].first, pairs[j].second);
+            }
+        }
+
+        // reorder the elements of all arrays: element order[i] moves to position i.
+        // Each array gathers its elements in parallel, see PropertyArray::permute().
+        void permute(const std::vector<size_t>& order) const
+        {
+            for (size_t i=0; i<parrays_.size(); ++i)
+                parrays_[i]->permute(order);
+        }
+
         // swap content with other Property_container
         void swap (PropertyContainer& other)
         {
             this->parrays_.swap (other.parrays_);
+            this->index_.swap (other.index_);
             std::swap(this->size_, other.size_);
         }
 
@@ -619,10 +1029,195 @@ namespace easy3d {
         std::vector<BasePropertyArray*>& arrays() { return parrays_; }
 
     private:
+        // rebuilds the name-ID -> array-position map (necessary whenever array positions shift)
+        void rebuild_index()
+        {
+            index_.clear();
+            for (size_t i=0; i<parrays_.size(); ++i)
+                index_[parrays_[i]->name_id()] = i;
+        }
+
         std::vector<BasePropertyArray*>  parrays_;
+        std::unordered_map<int, size_t>  index_;    // interned name ID -> position in parrays_
         size_t  size_;
     };
 
+
+    //== CLASS DEFINITION =========================================================
+
+    /// \brief A typed, cachable handle to a property of a PropertyContainer.
+    /// \class PropertyHandle easy3d/core/properties.h
+    /// \details A Property wraps a raw array pointer and thus dangles once the property is
+    ///     removed. A PropertyHandle instead stores the owning container and the interned
+    ///     property name and re-resolves the array on each use through the container's index
+    ///     map — an O(1) integer lookup, with no string comparison involved. Handles can
+    ///     therefore be cached across calls (e.g., as members of a class that repeatedly
+    ///     updates rendering buffers) and stay valid across property removal/re-addition and
+    ///     container restores; resolve() simply yields an invalid Property while the property
+    ///     does not exist. In debug builds, resolving asserts that the handle's type matches
+    ///     the actual type of the property.
+    template <class T>
+    class PropertyHandle
+    {
+    public:
+        /// Constructs an invalid handle.
+        PropertyHandle() : container_(nullptr) {}
+
+        /// Constructs a handle to the property \c name of \c container.
+        /// The property does not need to exist (yet).
+        PropertyHandle(PropertyContainer* container, const PropertyName& name)
+            : container_(container), name_(name) {}
+
+        /// Resolves the handle into a Property. Returns an invalid Property if the property
+        /// does not (or no longer) exist.
+        Property<T> resolve() const
+        {
+            if (!container_)
+                return Property<T>();
+            BasePropertyArray* array = container_->find_array(name_);
+            if (!array)
+                return Property<T>();
+            PropertyArray<T>* typed = dynamic_cast<PropertyArray<T>*>(array);
+            assert(typed != nullptr);   // the property exists, but with a different type
+            return Property<T>(typed);
+        }
+
+        /// Whether the property currently exists (with the expected type).
+        operator bool() const { return resolve(); }
+
+        /// Return the name of the property.
+        const PropertyName& name() const { return name_; }
+
+    private:
+        PropertyContainer* container_;
+        PropertyName       name_;
+    };
+
+
+    //== CLASS DEFINITION =========================================================
+
+    /// \brief Undo/redo history over a set of property containers.
+    /// \class PropertyHistory easy3d/core/properties.h
+    /// \details Records snapshots of the tracked containers (typically all containers of one
+    ///     model, see SurfaceMesh::attach_to() and PointCloud::attach_to()) and restores them on
+    ///     undo()/redo(). A snapshot only shares the storage of every property array
+    ///     (copy-on-write, see PropertyArray), so taking one is O(number of properties), and its
+    ///     memory cost is bounded by what the subsequent edits actually modify: arrays an editing
+    ///     operation never writes to keep sharing a single copy across the entire history,
+    ///     instead of being duplicated per step. Restoring goes through
+    ///     PropertyContainer::restore(), which re-shares storage and preserves the identity of
+    ///     the property arrays, so cached Property handles stay valid.
+    ///
+    ///     The intended workflow is to call checkpoint() right before applying an editing
+    ///     operation; no cooperation from the operation itself is required:
+    ///     \code
+    ///         PropertyHistory history;
+    ///         mesh->attach_to(history);
+    ///         history.checkpoint();                           // about to edit
+    ///         SurfaceMeshSmoothing(mesh).implicit_smoothing();
+    ///         ...
+    ///         history.undo();                                 // back to the checkpointed state
+    ///     \endcode
+    /// \attention A history tracks one fixed set of containers (one model); it must be cleared
+    ///     or discarded when elements of that set are destroyed.
+    class PropertyHistory
+    {
+    public:
+        /// Constructs an empty history keeping at most \c max_depth undo steps; when the limit
+        /// is exceeded, the oldest step is dropped.
+        explicit PropertyHistory(std::size_t max_depth = 100)
+            : max_depth_(max_depth > 0 ? max_depth : 1) {}
+
+        /// Adds a container to the tracked set. All containers must be tracked before the first
+        /// checkpoint() so that every snapshot covers the same set.
+        void track(PropertyContainer* container) { tracked_.push_back(container); }
+
+        /// Installs hooks for state that lives outside the tracked containers (e.g., the
+        /// garbage-collection counters of a mesh): \c capture is invoked whenever a snapshot is
+        /// recorded, \c restore whenever one is restored (with the captured values).
+        void set_state_hooks(const std::function<std::vector<std::size_t>()>& capture,
+                             const std::function<void(const std::vector<std::size_t>&)>& restore)
+        {
+            capture_state_ = capture;
+            restore_state_ = restore;
+        }
+
+        /// Records the current state as an undoable step and clears the redo list.
+        void checkpoint()
+        {
+            redo_.clear();
+            undo_.push_back(capture());
+            if (undo_.size() > max_depth_)
+                undo_.erase(undo_.begin());
+        }
+
+        /// Whether there is a state to undo/redo to.
+        bool can_undo() const { return !undo_.empty(); }
+        bool can_redo() const { return !redo_.empty(); }
+
+        /// Restores the most recent checkpointed state; the current state becomes redoable.
+        /// Returns false when there is nothing to undo.
+        bool undo()
+        {
+            if (undo_.empty())
+                return false;
+            redo_.push_back(capture());
+            apply(undo_.back());
+            undo_.pop_back();
+            return true;
+        }
+
+        /// Restores the most recently undone state. Returns false when there is nothing to redo.
+        bool redo()
+        {
+            if (redo_.empty())
+                return false;
+            undo_.push_back(capture());
+            apply(redo_.back());
+            redo_.pop_back();
+            return true;
+        }
+
+        /// Discards all recorded steps (the tracked set is kept).
+        void clear()
+        {
+            undo_.clear();
+            redo_.clear();
+        }
+
+    private:
+        struct Snapshot {
+            std::vector<PropertyContainer> containers;
+            std::vector<std::size_t>       state;
+        };
+
+        Snapshot capture() const
+        {
+            Snapshot s;
+            s.containers.reserve(tracked_.size());
+            for (std::size_t i=0; i<tracked_.size(); ++i)
+                s.containers.push_back(*tracked_[i]);   // shares all storage (copy-on-write)
+            if (capture_state_)
+                s.state = capture_state_();
+            return s;
+        }
+
+        void apply(const Snapshot& s) const
+        {
+            for (std::size_t i=0; i<tracked_.size(); ++i)
+                tracked_[i]->restore(s.containers[i]);
+            if (restore_state_)
+                restore_state_(s.state);
+        }
+
+        std::vector<PropertyContainer*> tracked_;
+        std::vector<Snapshot>           undo_;
+        std::vector<Snapshot>           redo_;
+        std::size_t                     max_depth_;
+        std::function<std::vector<std::size_t>()>               capture_state_;
+        std::function<void(const std::vector<std::size_t>&)>    restore_state_;
+    };
+
 } // namespace easy3d
 
 #endif // EASY3D_CORE_PROPERTIES_H
@@ -323,6 +323,30 @@ namespace easy3d {
          */
         static Quat slerp(const Quat<FT>& a, const Quat<FT>& b, FT t, bool allowFlip = true);
 
+        /**
+         * \brief Nlerp (Normalized Linear intERPolation) of Quaternions a and b, at time t.
+         * A linear blend of the coefficients followed by a normalization. It traverses the same
+         * arc as slerp() but at a slightly non-constant speed; for the small angular differences
+         * typical of dense resampling the two are indistinguishable, and nlerp() needs no
+         * trigonometry. \p allowFlip has the same meaning as in slerp().
+         */
+        static Quat nlerp(const Quat<FT>& a, const Quat<FT>& b, FT t, bool allowFlip = true);
+
+        /**
+         * \brief Batch slerp: interpolates a and b at each of the \p num times in \p t, writing
+         * the results into \p out.
+         * The angle between the two Quaternions and its trigonometry are computed once for the
+         * whole batch (the scalar slerp() re-derives them per call), so this is the interface to
+         * use when one pair of orientations is sampled densely (e.g., camera-path resampling,
+         * walkthrough export).
+         */
+        static void slerp(const Quat<FT>& a, const Quat<FT>& b, const FT* t, std::size_t num,
+                          Quat<FT>* out, bool allowFlip = true);
+
+        /** \brief Batch nlerp: the nlerp() counterpart of the batch slerp(). */
+        static void nlerp(const Quat<FT>& a, const Quat<FT>& b, const FT* t, std::size_t num,
+                          Quat<FT>* out, bool allowFlip = true);
+
         /**
          * \brief Returns the slerp interpolation of the two Quaternions a and b, at time t, using tangents tgA and tgB.
          * The resulting Quaternion is "between" a and b (result is a when t=0 and b for t=1).
@@ -666,6 +690,60 @@ namespace easy3d {
         return Quat(c1*a[0] + c2*b[0], c1*a[1] + c2*b[1], c1*a[2] + c2*b[2], c1*a[3] + c2*b[3]);
     }
 
+    template <typename FT>
+    Quat<FT> Quat<FT>::nlerp(const Quat<FT>& a, const Quat<FT>& b, FT t, bool allowFlip)
+    {
+        FT c1 = FT(1.0) - t;
+        const FT c2 = t;
+        if (allowFlip && (Quat<FT>::dot(a, b) < 0.0))
+            c1 = -c1;
+
+        Quat q(c1*a[0] + c2*b[0], c1*a[1] + c2*b[1], c1*a[2] + c2*b[2], c1*a[3] + c2*b[3]);
+        q.normalize();
+        return q;
+    }
+
+    template <typename FT>
+    void Quat<FT>::slerp(const Quat<FT>& a, const Quat<FT>& b, const FT* t, std::size_t num,
+                         Quat<FT>* out, bool allowFlip)
+    {
+        const FT cosAngle = Quat<FT>::dot(a, b);
+        const FT sign = (allowFlip && (cosAngle < 0.0)) ? FT(-1.0) : FT(1.0);
+
+        // Linear interpolation for close orientations (same threshold as the scalar slerp())
+        if ((1.0 - std::fabs(cosAngle)) < 0.01) {
+            for (std::size_t i = 0; i < num; ++i) {
+                const FT c1 = sign * (FT(1.0) - t[i]);
+                const FT c2 = t[i];
+                out[i] = Quat(c1*a[0] + c2*b[0], c1*a[1] + c2*b[1], c1*a[2] + c2*b[2], c1*a[3] + c2*b[3]);
+            }
+        }
+        else {
+            // Spherical interpolation; the angle and its sine are hoisted out of the loop
+            const FT angle = std::acos(std::fabs(cosAngle));
+            const FT sinAngle = std::sin(angle);
+            for (std::size_t i = 0; i < num; ++i) {
+                const FT c1 = sign * std::sin(angle * (FT(1.0) - t[i])) / sinAngle;
+                const FT c2 = std::sin(angle * t[i]) / sinAngle;
+                out[i] = Quat(c1*a[0] + c2*b[0], c1*a[1] + c2*b[1], c1*a[2] + c2*b[2], c1*a[3] + c2*b[3]);
+            }
+        }
+    }
+
+    template <typename FT>
+    void Quat<FT>::nlerp(const Quat<FT>& a, const Quat<FT>& b, const FT* t, std::size_t num,
+                         Quat<FT>* out, bool allowFlip)
+    {
+        const FT sign = (allowFlip && (Quat<FT>::dot(a, b) < 0.0)) ? FT(-1.0) : FT(1.0);
+        for (std::size_t i = 0; i < num; ++i) {
+            const FT c1 = sign * (FT(1.0) - t[i]);
+            const FT c2 = t[i];
+            Quat q(c1*a[0] + c2*b[0], c1*a[1] + c2*b[1], c1*a[2] + c2*b[2], c1*a[3] + c2*b[3]);
+            q.normalize();
+            out[i] = q;
+        }
+    }
+
     template <typename FT>
     Quat<FT> Quat<FT>::squad(const Quat<FT>& a, const Quat<FT>& tgA, const Quat<FT>& tgB, const Quat<FT>& b, FT t)
     {
@@ -763,6 +841,40 @@ namespace easy3d {
         return false;
     }
 
+
+    /**
+     * \brief Applies the rigid transformation (\p rotation, \p translation) to \p num points.
+     * \details Quat::rotate() expands the quaternion product for every point; here the quaternion
+     *      is converted to its 3x3 rotation matrix once, after which each point costs nine
+     *      multiplications over contiguous arrays. Use this when one pose is applied to many
+     *      points (e.g., transforming a model into a keyframe pose during walkthrough export).
+     *      \p points and \p result may alias.
+     */
+    template <typename FT> inline
+    void transform_points(const Quat<FT>& rotation, const Vec<3, FT>& translation,
+                          const Vec<3, FT>* points, std::size_t num, Vec<3, FT>* result) {
+        const FT q00 = FT(2.0) * rotation[0] * rotation[0];
+        const FT q11 = FT(2.0) * rotation[1] * rotation[1];
+        const FT q22 = FT(2.0) * rotation[2] * rotation[2];
+        const FT q01 = FT(2.0) * rotation[0] * rotation[1];
+        const FT q02 = FT(2.0) * rotation[0] * rotation[2];
+        const FT q03 = FT(2.0) * rotation[0] * rotation[3];
+        const FT q12 = FT(2.0) * rotation[1] * rotation[2];
+        const FT q13 = FT(2.0) * rotation[1] * rotation[3];
+        const FT q23 = FT(2.0) * rotation[2] * rotation[3];
+
+        const FT m00 = FT(1.0) - q11 - q22, m01 = q01 - q23,          m02 = q02 + q13;
+        const FT m10 = q01 + q23,           m11 = FT(1.0) - q22 - q00, m12 = q12 - q03;
+        const FT m20 = q02 - q13,           m21 = q12 + q03,          m22 = FT(1.0) - q11 - q00;
+
+        for (std::size_t i = 0; i < num; ++i) {
+            const Vec<3, FT> p = points[i];
+            result[i] = Vec<3, FT>(m00 * p.x + m01 * p.y + m02 * p.z + translation.x,
+                                   m10 * p.x + m11 * p.y + m12 * p.z + translation.y,
+                                   m20 * p.x + m21 * p.y + m22 * p.z + translation.z);
+        }
+    }
+
 }
 
 
@@ -25,6 +25,7 @@
 #ifndef EASY3D_CORE_RANDOM_H
 #define EASY3D_CORE_RANDOM_H
 
+#include <cstdint>
 #include <random>
 
 #include <easy3d/core/types.h>
@@ -43,6 +44,49 @@ namespace easy3d {
         return min + random_float() * (max - min);
     }
 
+    /**
+     * \brief A small, fast random number generator with an explicit state.
+     * \class RandomStream easy3d/core/random.h
+     * \details The functions above rely on std::rand(), whose hidden global state serializes (or
+     *      races) concurrent callers. A RandomStream is a self-contained generator, so every
+     *      thread or work item can own one, seeded independently. Streams created from different
+     *      seeds (e.g., a user seed combined with a work item index) produce independent
+     *      sequences, which makes parallel sampling both race-free and reproducible.
+     */
+    class RandomStream {
+    public:
+        /// \brief Creates a stream from a seed. The same seed always gives the same sequence.
+        explicit RandomStream(uint64_t seed) {
+            // splitmix64 scrambling: a well-distributed, never-zero state even when the
+            // seeds of different streams only differ in a few low bits
+            seed += UINT64_C(0x9e3779b97f4a7c15);
+            seed = (seed ^ (seed >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+            seed = (seed ^ (seed >> 27)) * UINT64_C(0x94d049bb133111eb);
+            state_ = seed ^ (seed >> 31);
+            if (state_ == 0)
+                state_ = UINT64_C(0x9e3779b97f4a7c15);
+        }
+
+        /// \brief Random 64-bit unsigned integer.
+        uint64_t next() {
+            // xorshift64* (Vigna, 2016)
+            state_ ^= state_ >> 12;
+            state_ ^= state_ << 25;
+            state_ ^= state_ >> 27;
+            return state_ * UINT64_C(0x2545f4914f6cdd1d);
+        }
+
+        /// \brief Random real in [0, 1).
+        float next_float() {
+            // the top 24 bits fill the full mantissa of a float
+            return float(next() >> 40) / float(1 << 24);
+        }
+
+    private:
+        uint64_t state_;
+    };
+
+
     /** \brief Generates a random color. The parameter \p allow_dark controls if too dark colors are allowed. */
     inline vec3 random_color(bool allow_dark = false) {
         static float min_rgb = 0.3f;
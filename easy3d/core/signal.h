@@ -26,23 +26,117 @@
 #define EASY3D_CORE_SIGNAL_H
 
 
-#include <unordered_map>
+#include <cstddef>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <vector>
 
 
 namespace easy3d {
 
+    // \cond
+    namespace details {
+
+        /// A fixed-capacity, in-place replacement for std::function<void(void)>: the bound
+        /// callable is stored inside the object itself (no heap allocation on connect, copy,
+        /// or emission) and dispatched through a single function pointer.
+        class InplaceSlot {
+        public:
+            InplaceSlot() : invoke_(nullptr), manage_(nullptr) {}
+
+            InplaceSlot(const InplaceSlot& rhs) : invoke_(nullptr), manage_(nullptr) { operator=(rhs); }
+
+            InplaceSlot& operator=(const InplaceSlot& rhs) {
+                if (this != &rhs) {
+                    reset();
+                    if (rhs.manage_) {
+                        rhs.manage_(Copy, &storage_, &rhs.storage_);
+                        invoke_ = rhs.invoke_;
+                        manage_ = rhs.manage_;
+                    }
+                }
+                return *this;
+            }
+
+            ~InplaceSlot() { reset(); }
+
+            template <class F>
+            void assign(const F& f) {
+                static_assert(sizeof(F) <= sizeof(Storage),
+                              "the bound callable does not fit into the in-place slot storage");
+                reset();
+                new (&storage_) F(f);
+                invoke_ = &invoke_stub<F>;
+                manage_ = &manage_stub<F>;
+            }
+
+            void invoke() const { invoke_(&storage_); }
+
+            operator bool() const { return invoke_ != nullptr; }
+
+        private:
+            void reset() {
+                if (manage_) {
+                    manage_(Destroy, &storage_, nullptr);
+                    invoke_ = nullptr;
+                    manage_ = nullptr;
+                }
+            }
+
+            enum Operation { Copy, Destroy };
+
+            template <class F>
+            static void invoke_stub(const void* storage) {
+                (*static_cast<const F*>(storage))();
+            }
+
+            template <class F>
+            static void manage_stub(Operation op, void* storage, const void* source) {
+                if (op == Copy)
+                    new (storage) F(*static_cast<const F*>(source));
+                else
+                    static_cast<F*>(storage)->~F();
+            }
+
+            // Large enough for the result of std::bind(member_function, owner) and a few
+            // extra bound arguments.
+            typedef std::aligned_storage<sizeof(void*) * 8>::type Storage;
+
+            void (*invoke_)(const void*);
+            void (*manage_)(Operation, void*, const void*);
+            Storage storage_;
+        };
+
+    }
+    // \endcond
+
+
     /**
      * \brief Implementation of a simple signal-slot mechanism. \par
      * \details Multiple slots (classes and their member functions) can be connected to a signal object.
      *        You can connect functions to the signal which will be called when
-     *        the trigger() method on the signal object is invoked. Any argument
-     *        passed to emit() will be passed to the given functions.
+     *        the trigger() method on the signal object is invoked.
      *        A typical usage of Signal in Easy3D is camera manipulation. When
      *        the camera has been manipulated, the viewer should be notified (e.g.,
      *        a repaint event should be triggered). This is done by calling
      *        to the viewer's update() function. So in Easy3D, the viewer's update
      *        function is connected to the camera.
+     *
+     *        The slots are stored in place (a small inline buffer holds the typical handful of
+     *        connections and the bound callables themselves), so connecting and triggering are
+     *        free of heap allocations and the per-emission cost is a plain indirect call.
+     *
+     *        Repeated identical notifications can be coalesced with batched emission: within a
+     *        Signal::Batch scope (or between begin_batch()/end_batch()), any number of trigger()
+     *        calls are delivered as a single notification when the scope ends. This avoids,
+     *        e.g., redundant viewer updates while an editing operation modifies a model many
+     *        times within one frame:
+     *        \code
+     *            Signal::Batch batch(*camera);
+     *            for (...)
+     *                camera->setPivotPoint(...);     // triggers many times
+     *        \endcode                                // the viewer is updated once, here
      * \attention Current implementation can hold only one single function of each owner.
      *            (can be easily extended to multiple ones if needed).
      *
@@ -52,6 +146,21 @@ namespace easy3d {
      */
     class Signal {
 	public:
+        Signal() : num_inline_(0), batch_depth_(0), pending_(false) {}
+
+        Signal(const Signal& rhs) : num_inline_(0), batch_depth_(0), pending_(false) { operator=(rhs); }
+
+        // copying a signal copies its connections (the batching state is not carried over)
+        Signal& operator=(const Signal& rhs) {
+            if (this != &rhs) {
+                num_inline_ = rhs.num_inline_;
+                for (std::size_t i = 0; i < num_inline_; ++i)
+                    inline_slots_[i] = rhs.inline_slots_[i];
+                overflow_ = rhs.overflow_;
+            }
+            return *this;
+        }
+
         /**
          * \brief Connect a slot to this signal.
          *  - If no overloaded function:  \par
@@ -65,8 +174,19 @@ namespace easy3d {
          */
         template < class Class, class Function, class... Args >
         void connect(Class&& owner, Function&& func, Args&&... args)  {
-            if (owner && func)
-                slots_[owner] = std::bind(func, owner, std::forward<Args>(args)...);
+            if (owner && func) {
+                Connection* c = find(owner);
+                if (!c) {
+                    if (num_inline_ < InlineSlots)
+                        c = &inline_slots_[num_inline_++];
+                    else {
+                        overflow_.push_back(Connection());
+                        c = &overflow_.back();
+                    }
+                    c->owner = owner;
+                }
+                c->slot.assign(std::bind(func, owner, std::forward<Args>(args)...));
+            }
         }
 
         /**
@@ -74,23 +194,103 @@ namespace easy3d {
          */
         template < class Class >
         void disconnect(Class&& owner)  {
-            slots_.erase(owner);
+            void* key = owner;
+            for (std::size_t i = 0; i < num_inline_; ++i) {
+                if (inline_slots_[i].owner == key) {
+                    // refill the vacated inline slot (the order of delivery is not specified)
+                    if (!overflow_.empty()) {
+                        inline_slots_[i] = overflow_.back();
+                        overflow_.pop_back();
+                    }
+                    else
+                        inline_slots_[i] = inline_slots_[--num_inline_];
+                    return;
+                }
+            }
+            for (std::size_t i = 0; i < overflow_.size(); ++i) {
+                if (overflow_[i].owner == key) {
+                    overflow_[i] = overflow_.back();
+                    overflow_.pop_back();
+                    return;
+                }
+            }
         }
 
         /**
-         * \brief Trigger all the connected slots.
+         * \brief Trigger all the connected slots. Within a batch (see Batch, begin_batch()),
+         *      the delivery is deferred and coalesced into a single notification.
          * \todo A better function name can be 'emit', but occupied by other software like Qt.
          *       Don't know how to still use 'emit'.
          */
-        template < class ... Args >
-        void trigger(Args&&... args) {
-            for(auto it : slots_) {
-                it.second(std::forward<Args>(args)...);
+        void trigger() {
+            if (batch_depth_ > 0) {
+                pending_ = true;
+                return;
+            }
+            deliver();
+        }
+
+        /// \brief Enters batched emission mode: subsequent trigger() calls are coalesced and
+        ///     delivered as one notification by the matching end_batch(). Batches nest; only
+        ///     the outermost end_batch() delivers. Prefer the scoped Signal::Batch guard.
+        void begin_batch() { ++batch_depth_; }
+
+        /// \brief Leaves batched emission mode, delivering the coalesced notification (if any
+        ///     trigger() occurred within the batch).
+        void end_batch() {
+            if (batch_depth_ > 0 && --batch_depth_ == 0 && pending_) {
+                pending_ = false;
+                deliver();
             }
         }
 
+        /// \brief Scoped guard for batched emission: all trigger() calls on the signal within
+        ///     the guard's lifetime are delivered as a single notification on destruction.
+        class Batch {
+        public:
+            Batch(Signal& signal) : signal_(signal) { signal_.begin_batch(); }
+            ~Batch() { signal_.end_batch(); }
+        private:
+            Batch(const Batch&);
+            Batch& operator=(const Batch&);
+            Signal& signal_;
+        };
+
     private:
-        std::unordered_map<void*, std::function<void(void)>> slots_;
+        struct Connection {
+            Connection() : owner(nullptr) {}
+            void*               owner;
+            details::InplaceSlot slot;
+        };
+
+        Connection* find(void* owner) {
+            for (std::size_t i = 0; i < num_inline_; ++i) {
+                if (inline_slots_[i].owner == owner)
+                    return &inline_slots_[i];
+            }
+            for (std::size_t i = 0; i < overflow_.size(); ++i) {
+                if (overflow_[i].owner == owner)
+                    return &overflow_[i];
+            }
+            return nullptr;
+        }
+
+        void deliver() {
+            for (std::size_t i = 0; i < num_inline_; ++i)
+                inline_slots_[i].slot.invoke();
+            for (std::size_t i = 0; i < overflow_.size(); ++i)
+                overflow_[i].slot.invoke();
+        }
+
+        // the typical number of connections is 1 or 2 (the viewers observing a camera); slots
+        // beyond the inline capacity spill into the overflow vector
+        static const std::size_t InlineSlots = 4;
+
+        Connection              inline_slots_[InlineSlots];
+        std::size_t             num_inline_;
+        std::vector<Connection> overflow_;
+        int                     batch_depth_;
+        bool                    pending_;
 	};
 
 }
@@ -0,0 +1,176 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_CORE_SIMD_H
+#define EASY3D_CORE_SIMD_H
+
+#include <cstddef>
+
+#include <easy3d/core/types.h>
+
+#if defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(_M_X64)
+#define EASY3D_HAS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define EASY3D_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+
+namespace easy3d {
+
+    /**
+     * \brief Explicitly vectorized batch kernels for hot loops over point/vector arrays.
+     * \details The element-wise Vec/Mat operators process one float at a time; these helpers
+     *      run over whole arrays so the full SIMD width (SSE2 on x86, NEON on ARM) is used.
+     *      Without SIMD support they fall back to the scalar operators and produce identical
+     *      results, so client code can call them unconditionally.
+     * \namespace easy3d::simd
+     */
+    namespace simd {
+
+        /// \brief Transform \p n points in place by the 4x4 matrix \p m.
+        /// \details Each point is treated as a homogeneous vector with w = 1 and the result is
+        ///     divided by the resulting w, exactly like the \c mat4 * \c vec3 operator.
+        inline void transform_points(const mat4& m, vec3* points, std::size_t n)
+        {
+#if defined(EASY3D_HAS_SSE2)
+            // one column of m per register: result = c0*x + c1*y + c2*z + c3
+            const __m128 c0 = _mm_set_ps(m(3, 0), m(2, 0), m(1, 0), m(0, 0));
+            const __m128 c1 = _mm_set_ps(m(3, 1), m(2, 1), m(1, 1), m(0, 1));
+            const __m128 c2 = _mm_set_ps(m(3, 2), m(2, 2), m(1, 2), m(0, 2));
+            const __m128 c3 = _mm_set_ps(m(3, 3), m(2, 3), m(1, 3), m(0, 3));
+            for (std::size_t i = 0; i < n; ++i) {
+                vec3& p = points[i];
+                __m128 r = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p.x)), _mm_mul_ps(c1, _mm_set1_ps(p.y))),
+                        _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p.z)), c3));
+                float tmp[4];
+                _mm_storeu_ps(tmp, r);
+                const float w = tmp[3];
+                p.x = tmp[0] / w;
+                p.y = tmp[1] / w;
+                p.z = tmp[2] / w;
+            }
+#elif defined(EASY3D_HAS_NEON)
+            const float32x4_t c0 = { m(0, 0), m(1, 0), m(2, 0), m(3, 0) };
+            const float32x4_t c1 = { m(0, 1), m(1, 1), m(2, 1), m(3, 1) };
+            const float32x4_t c2 = { m(0, 2), m(1, 2), m(2, 2), m(3, 2) };
+            const float32x4_t c3 = { m(0, 3), m(1, 3), m(2, 3), m(3, 3) };
+            for (std::size_t i = 0; i < n; ++i) {
+                vec3& p = points[i];
+                float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c3, c2, p.z), c1, p.y), c0, p.x);
+                float tmp[4];
+                vst1q_f32(tmp, r);
+                const float w = tmp[3];
+                p.x = tmp[0] / w;
+                p.y = tmp[1] / w;
+                p.z = tmp[2] / w;
+            }
+#else
+            for (std::size_t i = 0; i < n; ++i)
+                points[i] = m * points[i];
+#endif
+        }
+
+        /// \brief Transform \p n points from \p in to \p out by the 4x4 matrix \p m.
+        /// \sa transform_points(const mat4&, vec3*, std::size_t)
+        inline void transform_points(const mat4& m, const vec3* in, vec3* out, std::size_t n)
+        {
+            if (out != in) {
+                for (std::size_t i = 0; i < n; ++i)
+                    out[i] = in[i];
+            }
+            transform_points(m, out, n);
+        }
+
+        /// \brief Transform \p n direction vectors (e.g., normals) in place by the 3x3 matrix \p m.
+        /// \details No homogeneous divide is performed; for normals pass the inverse-transpose of
+        ///     the model matrix's upper-left 3x3 block.
+        inline void transform_vectors(const mat3& m, vec3* vectors, std::size_t n)
+        {
+#if defined(EASY3D_HAS_SSE2)
+            const __m128 c0 = _mm_set_ps(0.0f, m(2, 0), m(1, 0), m(0, 0));
+            const __m128 c1 = _mm_set_ps(0.0f, m(2, 1), m(1, 1), m(0, 1));
+            const __m128 c2 = _mm_set_ps(0.0f, m(2, 2), m(1, 2), m(0, 2));
+            for (std::size_t i = 0; i < n; ++i) {
+                vec3& v = vectors[i];
+                __m128 r = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v.x)), _mm_mul_ps(c1, _mm_set1_ps(v.y))),
+                        _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+                float tmp[4];
+                _mm_storeu_ps(tmp, r);
+                v.x = tmp[0];
+                v.y = tmp[1];
+                v.z = tmp[2];
+            }
+#elif defined(EASY3D_HAS_NEON)
+            const float32x4_t c0 = { m(0, 0), m(1, 0), m(2, 0), 0.0f };
+            const float32x4_t c1 = { m(0, 1), m(1, 1), m(2, 1), 0.0f };
+            const float32x4_t c2 = { m(0, 2), m(1, 2), m(2, 2), 0.0f };
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            for (std::size_t i = 0; i < n; ++i) {
+                vec3& v = vectors[i];
+                float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(zero, c2, v.z), c1, v.y), c0, v.x);
+                float tmp[4];
+                vst1q_f32(tmp, r);
+                v.x = tmp[0];
+                v.y = tmp[1];
+                v.z = tmp[2];
+            }
+#else
+            for (std::size_t i = 0; i < n; ++i)
+                vectors[i] = m * vectors[i];
+#endif
+        }
+
+        /// \brief Component-wise multiply-add over arrays of 4D vectors: dst[i] += src[i] * s.
+        /// \details Useful for accumulation passes (e.g., vertex skinning, blending of attribute
+        ///     arrays); vec4 is 16 bytes so each element maps to exactly one SIMD register.
+        inline void madd(vec4* dst, const vec4* src, float s, std::size_t n)
+        {
+#if defined(EASY3D_HAS_SSE2)
+            const __m128 sv = _mm_set1_ps(s);
+            for (std::size_t i = 0; i < n; ++i) {
+                __m128 d = _mm_loadu_ps(dst[i]);
+                __m128 v = _mm_loadu_ps(src[i]);
+                _mm_storeu_ps(dst[i], _mm_add_ps(d, _mm_mul_ps(v, sv)));
+            }
+#elif defined(EASY3D_HAS_NEON)
+            for (std::size_t i = 0; i < n; ++i) {
+                float32x4_t d = vld1q_f32(dst[i]);
+                float32x4_t v = vld1q_f32(src[i]);
+                vst1q_f32(dst[i], vmlaq_n_f32(d, v, s));
+            }
+#else
+            for (std::size_t i = 0; i < n; ++i)
+                dst[i] += src[i] * s;
+#endif
+        }
+
+    } // namespace simd
+
+} // namespace easy3d
+
+#endif  // EASY3D_CORE_SIMD_H
@@ -40,8 +40,11 @@
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/util/logging.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <utility>
 
 namespace easy3d {
 
@@ -50,7 +53,14 @@ namespace easy3d {
         // allocate standard properties
         // same list is used in operator=() and assign()
         vconn_    = add_vertex_property<VertexConnectivity>("v:connectivity");
+#ifdef EASY3D_SOA_CONNECTIVITY
+        hconn_face_   = add_halfedge_property<Face>("h:conn-face");
+        hconn_vertex_ = add_halfedge_property<Vertex>("h:conn-vertex");
+        hconn_next_   = add_halfedge_property<Halfedge>("h:conn-next");
+        hconn_prev_   = add_halfedge_property<Halfedge>("h:conn-prev");
+#else
         hconn_    = add_halfedge_property<HalfedgeConnectivity>("h:connectivity");
+#endif
         fconn_    = add_face_property<FaceConnectivity>("f:connectivity");
         vpoint_   = add_vertex_property<vec3>("v:point");
         vdeleted_ = add_vertex_property<bool>("v:deleted", false);
@@ -61,6 +71,7 @@ namespace easy3d {
 
         deleted_vertices_ = deleted_edges_ = deleted_faces_ = 0;
         garbage_ = false;
+        structural_version_ = 0;
     }
 
 
@@ -88,7 +99,14 @@ namespace easy3d {
 
             // property handles contain pointers, have to be reassigned
             vconn_    = vertex_property<VertexConnectivity>("v:connectivity");
+#ifdef EASY3D_SOA_CONNECTIVITY
+            hconn_face_   = halfedge_property<Face>("h:conn-face");
+            hconn_vertex_ = halfedge_property<Vertex>("h:conn-vertex");
+            hconn_next_   = halfedge_property<Halfedge>("h:conn-next");
+            hconn_prev_   = halfedge_property<Halfedge>("h:conn-prev");
+#else
             hconn_    = halfedge_property<HalfedgeConnectivity>("h:connectivity");
+#endif
             fconn_    = face_property<FaceConnectivity>("f:connectivity");
             vdeleted_ = vertex_property<bool>("v:deleted");
             edeleted_ = edge_property<bool>("e:deleted");
@@ -104,6 +122,7 @@ namespace easy3d {
             deleted_edges_    = rhs.deleted_edges_;
             deleted_faces_    = rhs.deleted_faces_;
             garbage_          = rhs.garbage_;
+            structural_version_ = rhs.structural_version_ + 1;
         }
 
         return *this;
@@ -143,17 +162,17 @@ namespace easy3d {
         // translate indices in halfedge -> face, halfedge -> target, halfedge -> prev, and halfedge -> next
         for (unsigned int i = nh; i < nh + other.halfedges_size(); i++) {
             Halfedge hi(i);
-            if (hconn_[hi].face_ != Face()) {
-                hconn_[hi].face_ = Face(hconn_[hi].face_.idx() + nf);
+            if (face(hi) != Face()) {
+                set_face(hi, Face(face(hi).idx() + nf));
             }
-            if (hconn_[hi].vertex_ != Vertex()) {
-                hconn_[hi].vertex_ = Vertex(hconn_[hi].vertex_.idx() + nv);
+            if (target(hi) != Vertex()) {
+                set_target(hi, Vertex(target(hi).idx() + nv));
             }
-            if (hconn_[hi].next_ != Halfedge()) {
-                hconn_[hi].next_ = Halfedge(hconn_[hi].next_.idx() + nh);
+            if (next(hi) != Halfedge()) {
+                set_next_only(hi, Halfedge(next(hi).idx() + nh));
             }
-            if (hconn_[hi].prev_ != Halfedge()) {
-                hconn_[hi].prev_ = Halfedge(hconn_[hi].prev_.idx() + nh);
+            if (prev(hi) != Halfedge()) {
+                set_prev_only(hi, Halfedge(prev(hi).idx() + nh));
             }
         }
 //        unsigned int inf_value = (std::numeric_limits<unsigned int>::max)();
@@ -205,6 +224,7 @@ namespace easy3d {
         deleted_vertices_ += other.deleted_vertices_;
         deleted_edges_ += other.deleted_edges_;
         deleted_faces_ += other.deleted_faces_;
+        ++structural_version_;
         return *this;
     }
 
@@ -225,7 +245,14 @@ namespace easy3d {
 
             // allocate standard properties
             vconn_    = add_vertex_property<VertexConnectivity>("v:connectivity");
+#ifdef EASY3D_SOA_CONNECTIVITY
+            hconn_face_   = add_halfedge_property<Face>("h:conn-face");
+            hconn_vertex_ = add_halfedge_property<Vertex>("h:conn-vertex");
+            hconn_next_   = add_halfedge_property<Halfedge>("h:conn-next");
+            hconn_prev_   = add_halfedge_property<Halfedge>("h:conn-prev");
+#else
             hconn_    = add_halfedge_property<HalfedgeConnectivity>("h:connectivity");
+#endif
             fconn_    = add_face_property<FaceConnectivity>("f:connectivity");
             vpoint_   = add_vertex_property<vec3>("v:point");
             vdeleted_ = add_vertex_property<bool>("v:deleted", false);
@@ -238,7 +265,14 @@ namespace easy3d {
 
             // copy properties from other mesh
             vconn_.array()     = rhs.vconn_.array();
+#ifdef EASY3D_SOA_CONNECTIVITY
+            hconn_face_.array()   = rhs.hconn_face_.array();
+            hconn_vertex_.array() = rhs.hconn_vertex_.array();
+            hconn_next_.array()   = rhs.hconn_next_.array();
+            hconn_prev_.array()   = rhs.hconn_prev_.array();
+#else
             hconn_.array()     = rhs.hconn_.array();
+#endif
             fconn_.array()     = rhs.fconn_.array();
             vpoint_.array()    = rhs.vpoint_.array();
             vdeleted_.array()  = rhs.vdeleted_.array();
@@ -257,6 +291,7 @@ namespace easy3d {
             deleted_edges_    = rhs.deleted_edges_;
             deleted_faces_    = rhs.deleted_faces_;
             garbage_          = rhs.garbage_;
+            structural_version_ = rhs.structural_version_ + 1;
         }
 
         return *this;
@@ -289,13 +324,26 @@ namespace easy3d {
 
         // get properties
         auto vconn = vertex_property<SurfaceMesh::VertexConnectivity>("v:connectivity");
-        auto hconn = halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
         auto fconn = face_property<SurfaceMesh::FaceConnectivity>("f:connectivity");
         auto point = vertex_property<vec3>("v:point");
 
         // read properties from file
         input.read((char*)vconn.data(), nv * sizeof(SurfaceMesh::VertexConnectivity)  );
+#ifdef EASY3D_SOA_CONNECTIVITY
+        // the file stores the halfedge connectivity as an array of structs: scatter into the SoA layout
+        std::vector<HalfedgeConnectivity> hconn(nh);
+        input.read((char*)hconn.data(), nh * sizeof(SurfaceMesh::HalfedgeConnectivity));
+        for (unsigned int i = 0; i < nh; ++i) {
+            const Halfedge h(i);
+            hconn_face_[h]   = hconn[i].face_;
+            hconn_vertex_[h] = hconn[i].vertex_;
+            hconn_next_[h]   = hconn[i].next_;
+            hconn_prev_[h]   = hconn[i].prev_;
+        }
+#else
+        auto hconn = halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
         input.read((char*)hconn.data(), nh * sizeof(SurfaceMesh::HalfedgeConnectivity));
+#endif
         input.read((char*)fconn.data(), nf * sizeof(SurfaceMesh::FaceConnectivity)    );
         input.read((char*)point.data(), nv * sizeof(vec3)                             );
 
@@ -341,13 +389,26 @@ namespace easy3d {
 
         // get properties
         auto vconn = get_vertex_property<SurfaceMesh::VertexConnectivity>("v:connectivity");
-        auto hconn = get_halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
         auto fconn = get_face_property<SurfaceMesh::FaceConnectivity>("f:connectivity");
         auto point = get_vertex_property<vec3>("v:point");
 
         // write properties to file
         output.write((char*)vconn.data(), nv * sizeof(SurfaceMesh::VertexConnectivity));
+#ifdef EASY3D_SOA_CONNECTIVITY
+        // the file stores the halfedge connectivity as an array of structs: gather from the SoA layout
+        std::vector<HalfedgeConnectivity> hconn(nh);
+        for (unsigned int i = 0; i < nh; ++i) {
+            const Halfedge h(i);
+            hconn[i].face_   = hconn_face_[h];
+            hconn[i].vertex_ = hconn_vertex_[h];
+            hconn[i].next_   = hconn_next_[h];
+            hconn[i].prev_   = hconn_prev_[h];
+        }
+        output.write((char*)hconn.data(), nh * sizeof(SurfaceMesh::HalfedgeConnectivity));
+#else
+        auto hconn = get_halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
         output.write((char*)hconn.data(), nh * sizeof(SurfaceMesh::HalfedgeConnectivity));
+#endif
         output.write((char*)fconn.data(), nf * sizeof(SurfaceMesh::FaceConnectivity));
         output.write((char*)point.data(), nv * sizeof(vec3));
 
@@ -383,11 +444,16 @@ namespace easy3d {
 
         deleted_vertices_ = deleted_edges_ = deleted_faces_ = 0;
         garbage_ = false;
+        ++structural_version_;
 
         //---- keep the standard properties and remove all the other properties
 
         vprops_.resize_property_array(3);   // "v:connectivity", "v:point", "v:deleted"
+#ifdef EASY3D_SOA_CONNECTIVITY
+        hprops_.resize_property_array(4);   // "h:conn-face", "h:conn-vertex", "h:conn-next", "h:conn-prev"
+#else
         hprops_.resize_property_array(1);   // "h:connectivity"
+#endif
         eprops_.resize_property_array(1);   // "e:deleted"
         fprops_.resize_property_array(2);   // "f:connectivity", "f:deleted"
         mprops_.clear();
@@ -416,6 +482,20 @@ namespace easy3d {
     //-----------------------------------------------------------------------------
 
 
+    SurfaceMesh::Vertex SurfaceMesh::add_vertices(const std::vector<vec3>& points)
+    {
+        const unsigned int first = vertices_size();
+        // one resize for every vertex property array (instead of points.size() push_backs)
+        vprops_.resize(first + points.size());
+        // block-copy the positions into the tail of "v:point"
+        std::copy(points.begin(), points.end(), vpoint_.vector().begin() + first);
+        return Vertex((int)first);
+    }
+
+
+    //-----------------------------------------------------------------------------
+
+
     void SurfaceMesh::property_stats(std::ostream& output) const
     {
         std::vector<std::string> props;
@@ -1061,15 +1141,18 @@ namespace easy3d {
         if (!fnormal_)
             fnormal_ = face_property<vec3>("f:normal");
 
-        FaceIterator fit, fend=faces_end();
-
+        // each face writes only its own normal, so the faces can be processed in parallel
         int num_degenerate = 0;
-        for (fit=faces_begin(); fit!=fend; ++fit) {
-            if (is_degenerate(*fit)) {
+#pragma omp parallel for reduction(+:num_degenerate)
+        for (int i = 0; i < (int)faces_size(); ++i) {
+            const Face f(i);
+            if (garbage_ && fdeleted_[f])
+                continue;
+            if (is_degenerate(f)) {
                 ++num_degenerate;
-                fnormal_[*fit] = vec3(0, 0, 1);
+                fnormal_[f] = vec3(0, 0, 1);
             } else
-                fnormal_[*fit] = compute_face_normal(*fit);
+                fnormal_[f] = compute_face_normal(f);
         }
 
         if (num_degenerate > 0)
@@ -1124,9 +1207,8 @@ namespace easy3d {
         if (!vnormal_)
             vnormal_ = vertex_property<vec3>("v:normal");
 
-        VertexIterator vit, vend=vertices_end();
-
 #if 0   // not stable for concave vertices
+        VertexIterator vit, vend=vertices_end();
         for (vit=vertices_begin(); vit!=vend; ++vit)
             vnormal_[*vit] = compute_vertex_normal(*vit);
 #else // the angle-weighted average of incident face average
@@ -1186,8 +1268,14 @@ namespace easy3d {
 
         if (!fnormal_)
             update_face_normals();
-        for (vit=vertices_begin(); vit!=vend; ++vit)
-            vnormal_[*vit] = angle_weighted_face_normals(*vit);
+        // reads positions/face normals only and writes its own normal: parallel over vertices
+#pragma omp parallel for
+        for (int i = 0; i < (int)vertices_size(); ++i) {
+            const Vertex v(i);
+            if (garbage_ && vdeleted_[v])
+                continue;
+            vnormal_[v] = angle_weighted_face_normals(v);
+        }
 #endif
     }
 
@@ -1738,6 +1826,7 @@ namespace easy3d {
                 set_out_halfedge(dest1, Halfedge());
                 deleted_vertices_++;
                 garbage_ = true;
+                ++structural_version_;
             }
         }
 
@@ -1748,6 +1837,7 @@ namespace easy3d {
                 set_out_halfedge(dest0, Halfedge());
                 deleted_vertices_++;
                 garbage_ = true;
+                ++structural_version_;
             }
         }
 
@@ -1769,12 +1859,14 @@ namespace easy3d {
             edeleted_[e0] = true;
             deleted_edges_++;
             garbage_ = true;
+            ++structural_version_;
         }
         auto e1 = edge(h1);
         if (!edeleted_[e1]) {
             edeleted_[e1] = true;
             deleted_edges_++;
             garbage_ = true;
+            ++structural_version_;
         }
     }
 
@@ -1917,6 +2009,7 @@ namespace easy3d {
         vdeleted_[vo]      = true; ++deleted_vertices_;
         edeleted_[edge(h)] = true; ++deleted_edges_;
         garbage_ = true;
+        ++structural_version_;
     }
 
 
@@ -1968,6 +2061,7 @@ namespace easy3d {
         if (fh.is_valid()) { fdeleted_[fh] = true; ++deleted_faces_; }
         edeleted_[edge(h0)] = true; ++deleted_edges_;
         garbage_ = true;
+        ++structural_version_;
     }
 
 
@@ -2004,6 +2098,7 @@ namespace easy3d {
             vdeleted_[v] = true;
             deleted_vertices_++;
             garbage_ = true;
+            ++structural_version_;
         }
     }
 
@@ -2136,6 +2231,7 @@ namespace easy3d {
             adjust_outgoing_halfedge(*v_it);
 
         garbage_ = true;
+        ++structural_version_;
     }
 
 
@@ -2153,23 +2249,25 @@ namespace easy3d {
         nH(halfedges_size()),
         nF(faces_size());
 
-        Vertex    v;
-        Halfedge  h;
-        Face      f;
-
-
-        // setup handle mapping
-        VertexProperty<Vertex>      vmap = add_vertex_property<Vertex>("v:garbage-collection");
-        HalfedgeProperty<Halfedge>  hmap = add_halfedge_property<Halfedge>("h:garbage-collection");
-        FaceProperty<Face>          fmap = add_face_property<Face>("f:garbage-collection");
+        // setup handle mapping (plain vectors: they are filled from the deleted flags
+        // up front and must not be shuffled by the swaps applied below)
+        std::vector<Vertex>     vmap(nV);
+        std::vector<Halfedge>   hmap(nH);
+        std::vector<Face>       fmap(nF);
         for (i=0; i<nV; ++i)
-            vmap[Vertex(i)] = Vertex(i);
+            vmap[i] = Vertex(i);
         for (i=0; i<nH; ++i)
-            hmap[Halfedge(i)] = Halfedge(i);
+            hmap[i] = Halfedge(i);
         for (i=0; i<nF; ++i)
-            fmap[Face(i)] = Face(i);
-
+            fmap[i] = Face(i);
 
+        // Determine the swap sequences from the deleted flags only, then apply each
+        // sequence to all property arrays of a container at once. This keeps the
+        // relocation order (and thus the resulting element order) identical to the
+        // old element-by-element compaction, but lets apply_swaps() remap every
+        // property array on its own worker thread instead of touching all arrays
+        // for every single swap.
+        std::vector< std::pair<size_t, size_t> > vswaps, eswaps, hswaps, fswaps;
 
         // remove deleted vertices
         if (nV > 0)
@@ -2183,12 +2281,16 @@ namespace easy3d {
                 while ( vdeleted_[Vertex(i1)] && i0 < i1)  --i1;
                 if (i0 >= i1) break;
 
-                // swap
-                vprops_.swap(i0, i1);
+                // record swap (i0 moves forward, i1 backward: no slot is revisited,
+                // so the flags can be read without actually swapping them here)
+                vswaps.push_back(std::make_pair(i0, i1));
+                std::swap(vmap[i0], vmap[i1]);
+                ++i0; --i1;
+                if (i0 > i1) break;
             };
 
             // remember new size
-            nV = vdeleted_[Vertex(i0)] ? i0 : i0+1;
+            nV = vdeleted_[vmap[i0]] ? i0 : i0+1;
         }
 
 
@@ -2204,14 +2306,18 @@ namespace easy3d {
                 while ( edeleted_[Edge(i1)] && i0 < i1)  --i1;
                 if (i0 >= i1) break;
 
-                // swap
-                eprops_.swap(i0, i1);
-                hprops_.swap(2*i0,   2*i1);
-                hprops_.swap(2*i0+1, 2*i1+1);
+                // record swap
+                eswaps.push_back(std::make_pair(i0, i1));
+                hswaps.push_back(std::make_pair(2*i0,   2*i1));
+                hswaps.push_back(std::make_pair(2*i0+1, 2*i1+1));
+                std::swap(hmap[2*i0],   hmap[2*i1]);
+                std::swap(hmap[2*i0+1], hmap[2*i1+1]);
+                ++i0; --i1;
+                if (i0 > i1) break;
             };
 
             // remember new size
-            nE = edeleted_[Edge(i0)] ? i0 : i0+1;
+            nE = edeleted_[Edge(hmap[2*i0].idx()/2)] ? i0 : i0+1;
             nH = 2*nE;
         }
 
@@ -2228,48 +2334,68 @@ namespace easy3d {
                 while ( fdeleted_[Face(i1)] && i0 < i1)  --i1;
                 if (i0 >= i1) break;
 
-                // swap
-                fprops_.swap(i0, i1);
+                // record swap
+                fswaps.push_back(std::make_pair(i0, i1));
+                std::swap(fmap[i0], fmap[i1]);
+                ++i0; --i1;
+                if (i0 > i1) break;
             };
 
             // remember new size
-            nF = fdeleted_[Face(i0)] ? i0 : i0+1;
+            nF = fdeleted_[fmap[i0]] ? i0 : i0+1;
         }
 
+        // invert the permutations: old index -> new index (what the connectivity
+        // updates below need)
+        {
+            std::vector<Vertex>     vinv(vmap.size());
+            std::vector<Halfedge>   hinv(hmap.size());
+            std::vector<Face>       finv(fmap.size());
+            for (std::size_t j = 0; j < vmap.size(); ++j)  vinv[vmap[j].idx()] = Vertex((int)j);
+            for (std::size_t j = 0; j < hmap.size(); ++j)  hinv[hmap[j].idx()] = Halfedge((int)j);
+            for (std::size_t j = 0; j < fmap.size(); ++j)  finv[fmap[j].idx()] = Face((int)j);
+            vmap.swap(vinv);
+            hmap.swap(hinv);
+            fmap.swap(finv);
+        }
+
+        // compact the property arrays, each array on its own worker thread
+        vprops_.apply_swaps(vswaps);
+        eprops_.apply_swaps(eswaps);
+        hprops_.apply_swaps(hswaps);
+        fprops_.apply_swaps(fswaps);
 
         // update vertex connectivity
+#pragma omp parallel for
         for (i=0; i<nV; ++i)
         {
-            v = Vertex(i);
+            Vertex v(i);
             if (!is_isolated(v))
-                set_out_halfedge(v, hmap[out_halfedge(v)]);
+                set_out_halfedge(v, hmap[out_halfedge(v).idx()]);
         }
 
 
         // update halfedge connectivity
+#pragma omp parallel for
         for (i=0; i<nH; ++i)
         {
-            h = Halfedge(i);
-            set_target(h, vmap[target(h)]);
-            set_next(h, hmap[next(h)]);
+            Halfedge h(i);
+            set_target(h, vmap[target(h).idx()]);
+            set_next_only(h, hmap[next(h).idx()]);
+            set_prev_only(h, hmap[prev(h).idx()]);
             if (!is_border(h))
-                set_face(h, fmap[face(h)]);
+                set_face(h, fmap[face(h).idx()]);
         }
 
 
         // update handles of faces
+#pragma omp parallel for
         for (i=0; i<nF; ++i)
         {
-            f = Face(i);
-            set_halfedge(f, hmap[halfedge(f)]);
+            Face f(i);
+            set_halfedge(f, hmap[halfedge(f).idx()]);
         }
 
-
-        // remove handle maps
-        remove_vertex_property(vmap);
-        remove_halfedge_property(hmap);
-        remove_face_property(fmap);
-
         // finally resize arrays
         vprops_.resize(nV); vprops_.shrink_to_fit();
         hprops_.resize(nH); hprops_.shrink_to_fit();
@@ -2278,6 +2404,7 @@ namespace easy3d {
 
         deleted_vertices_ = deleted_edges_ = deleted_faces_ = 0;
         garbage_ = false;
+        ++structural_version_;
 
 #if 1
         // [Liangliang]: It seems the outgoing halfedges of the vertices may be broken after garbage collection, e.g.,
@@ -2290,6 +2417,118 @@ namespace easy3d {
     }
 
 
+    //-----------------------------------------------------------------------------
+
+
+    //  \cond
+    namespace details {
+
+        // spreads the lower 21 bits of v so that they occupy every third bit
+        inline std::uint64_t expand_bits(std::uint64_t v) {
+            v &= 0x1fffff;
+            v = (v | v << 32) & 0x1f00000000ffffULL;
+            v = (v | v << 16) & 0x1f0000ff0000ffULL;
+            v = (v | v << 8) & 0x100f00f00f00f00fULL;
+            v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+            v = (v | v << 2) & 0x1249249249249249ULL;
+            return v;
+        }
+
+        // the 64-bit Morton code of quantized coordinates (21 bits per axis)
+        inline std::uint64_t morton_code(std::uint64_t x, std::uint64_t y, std::uint64_t z) {
+            return expand_bits(x) | (expand_bits(y) << 1) | (expand_bits(z) << 2);
+        }
+    }
+    //  \endcond
+
+
+    std::vector<int> SurfaceMesh::sort_vertices_spatially()
+    {
+        if (has_garbage())
+            collect_garbage();  // so the permutation covers the valid vertices only
+
+        const int nV = static_cast<int>(vertices_size());
+        std::vector<int> old_to_new(nV);
+        if (nV == 0)
+            return old_to_new;
+
+        const Box3& box = bounding_box();
+
+        // quantize the coordinates into 21 bits per axis over the bounding box
+        const vec3 origin = box.min();
+        const auto quantize = [](float value, float base, double scale) -> std::uint64_t {
+            const double c = std::floor(double(value - base) * scale);
+            return static_cast<std::uint64_t>(std::min(std::max(c, 0.0), 2097151.0));
+        };
+        double scale[3];
+        for (int i = 0; i < 3; ++i)
+            scale[i] = box.range(i) > 0.0f ? 2097151.0 / box.range(i) : 0.0;
+
+        const std::vector<vec3>& pts = vpoint_.vector();
+        std::vector< std::pair<std::uint64_t, int> > codes(nV);
+#pragma omp parallel for
+        for (int i = 0; i < nV; ++i) {
+            const vec3& p = pts[i];
+            codes[i] = std::make_pair(
+                    details::morton_code(quantize(p.x, origin.x, scale[0]), quantize(p.y, origin.y, scale[1]),
+                                         quantize(p.z, origin.z, scale[2])),
+                    i);
+        }
+        std::sort(codes.begin(), codes.end());
+
+        // gather all vertex properties (including the vertex connectivity) into the new order
+        std::vector<size_t> order(nV);
+        for (int i = 0; i < nV; ++i)
+            order[i] = codes[i].second;
+        vprops_.permute(order);
+
+        std::vector<Vertex> vmap(nV);   // old index -> new index
+        for (int i = 0; i < nV; ++i) {
+            old_to_new[codes[i].second] = i;
+            vmap[codes[i].second] = Vertex(i);
+        }
+
+        // remap the target vertices of the halfedges (the vertex-to-halfedge and
+        // face-to-halfedge references are unaffected: halfedges keep their indices)
+        const int nH = static_cast<int>(halfedges_size());
+        if (nH > 0) // detach once, so the parallel writes below cannot race on a shared (copy-on-write) array
+            set_target(Halfedge(0), target(Halfedge(0)));
+#pragma omp parallel for
+        for (int i = 0; i < nH; ++i) {
+            const Halfedge h(i);
+            set_target(h, vmap[target(h).idx()]);
+        }
+
+        return old_to_new;
+    }
+
+
+    void SurfaceMesh::attach_to(PropertyHistory &history)
+    {
+        history.track(&vprops_);
+        history.track(&hprops_);
+        history.track(&eprops_);
+        history.track(&fprops_);
+        history.track(&mprops_);
+
+        // the garbage-collection bookkeeping lives outside the property containers and has
+        // to be captured/restored alongside them
+        SurfaceMesh *mesh = this;
+        history.set_state_hooks(
+                [mesh]() -> std::vector<std::size_t> {
+                    return {mesh->deleted_vertices_, mesh->deleted_edges_,
+                            mesh->deleted_faces_, mesh->garbage_ ? std::size_t(1) : std::size_t(0)};
+                },
+                [mesh](const std::vector<std::size_t> &state) {
+                    mesh->deleted_vertices_ = static_cast<unsigned int>(state[0]);
+                    mesh->deleted_edges_ = static_cast<unsigned int>(state[1]);
+                    mesh->deleted_faces_ = static_cast<unsigned int>(state[2]);
+                    mesh->garbage_ = (state[3] != 0);
+                    mesh->invalidate_bounding_box();    // the restored positions may differ
+                });
+    }
+
+
     bool SurfaceMesh::is_degenerate(Face f) const {
         Halfedge h = halfedge(f);
         Halfedge hend = h;
@@ -167,6 +167,11 @@ namespace easy3d {
 
 
         /// This type stores the halfedge connectivity
+        /// \note When \c EASY3D_SOA_CONNECTIVITY is defined, the four fields are stored in separate
+        ///     contiguous property arrays (structure-of-arrays layout) instead of one array of this
+        ///     struct. Traversal loops (e.g., the circulators) then touch only the cache lines of the
+        ///     fields they actually read, which noticeably speeds up memory-bound algorithms on huge
+        ///     meshes. This struct remains the interchange type for both layouts.
         /// \sa VertexConnectivity, FaceConnectivity
         struct HalfedgeConnectivity
         {
@@ -984,6 +989,14 @@ namespace easy3d {
         /// add a new vertex with position \c p
         Vertex add_vertex(const vec3& p) { Vertex v = new_vertex(); vpoint_[v] = p; return v; }
 
+        /// \brief Add all vertices of \p points at once.
+        /// \details All vertex property arrays are grown by a single resize and the positions are
+        ///     copied in one block, instead of points.size() individual push_backs. This matters
+        ///     when building huge meshes: combined with reserve(), construction does not repeatedly
+        ///     reallocate every property array.
+        /// \return The first of the added vertices; the others follow consecutively.
+        Vertex add_vertices(const std::vector<vec3>& points);
+
         /// add a new face with vertex list \c vertices
         /// \param vertices The input vertices created by add_vertex().
         /// \sa add_triangle, add_quad
@@ -1046,12 +1059,67 @@ namespace easy3d {
             fprops_.resize(nf);
         }
 
+        /// \brief returns the memory (in bytes) occupied by the mesh, i.e., by all vertex,
+        ///     halfedge, edge, face, and model properties (including the connectivity and the
+        ///     vertex coordinates, which are stored as properties as well).
+        std::size_t memory_usage() const override {
+            return vprops_.memory_usage() + hprops_.memory_usage() + eprops_.memory_usage() +
+                   fprops_.memory_usage() + mprops_.memory_usage();
+        }
+
+        /// \brief appends one record per property array, reporting the bytes used and allocated
+        ///     (the difference being reclaimable slack). \sa Model::memory_report().
+        void memory_report(std::vector<PropertyMemoryRecord> &records) const override {
+            vprops_.memory_report(records);
+            hprops_.memory_report(records);
+            eprops_.memory_report(records);
+            fprops_.memory_report(records);
+            mprops_.memory_report(records);
+        }
+
+        /// \brief releases the unused capacity of all property arrays. \sa Model::shrink_to_fit().
+        void shrink_to_fit() override {
+            vprops_.shrink_to_fit();
+            hprops_.shrink_to_fit();
+            eprops_.shrink_to_fit();
+            fprops_.shrink_to_fit();
+            mprops_.shrink_to_fit();
+        }
+
         /// are there deleted vertices, edges or faces?
         bool has_garbage() const { return garbage_; }
 
         /// remove deleted vertices/edges/faces
         void collect_garbage();
 
+        /// \brief returns a counter that increases monotonically with every structural edit.
+        /// \details The counter is bumped whenever elements are added or deleted (also by
+        ///     clear(), join(), assignment, and collect_garbage(), which renumbers the
+        ///     elements). Purely geometric edits (moving vertices) and property edits leave it
+        ///     unchanged. Algorithms can thus cache derived topological quantities and reuse
+        ///     them as long as the version has not changed. \sa SurfaceMeshTopology.
+        std::size_t structural_version() const { return structural_version_; }
+
+        /// \brief reorders the vertices along a Morton (Z-order) space-filling curve, so that
+        ///     vertices close in space become close in memory. This improves the cache behavior
+        ///     of traversals that gather vertex data (and the GPU vertex cache when rendering)
+        ///     for meshes whose vertex ordering is spatially shuffled. All vertex properties are
+        ///     permuted accordingly (in a parallel gather) and the halfedge connectivity is
+        ///     updated; halfedges, edges, and faces keep their indices. Deleted elements are
+        ///     garbage-collected first.
+        /// \return the index mapping from the old order to the new one (i.e., the vertex that
+        ///     had index \c i now has index \c result[i]), for fixing up externally stored
+        ///     vertex indices.
+        std::vector<int> sort_vertices_spatially();
+
+        /// \brief attaches this mesh to an undo/redo history.
+        /// \details Registers all property containers of the mesh (and its garbage-collection
+        ///     state) with \p history, so that PropertyHistory::checkpoint(), undo(), and redo()
+        ///     capture and restore the complete mesh. Snapshots share the storage of unmodified
+        ///     properties (copy-on-write), so the memory cost of a history step is bounded by
+        ///     what the edits in between actually touched, not by the size of the mesh.
+        /// \attention The history must not outlive the mesh, and it must track only this mesh.
+        void attach_to(PropertyHistory &history);
 
         /// returns whether vertex \c v is deleted
         /// \sa collect_garbage()
@@ -1161,7 +1229,11 @@ namespace easy3d {
         /// returns the vertex the halfedge \c h points to
         Vertex target(Halfedge h) const
         {
+#ifdef EASY3D_SOA_CONNECTIVITY
+            return hconn_vertex_[h];
+#else
             return hconn_[h].vertex_;
+#endif
         }
 
         /// returns the vertex the halfedge \c h emanates from
@@ -1173,38 +1245,58 @@ namespace easy3d {
         /// sets the vertex the halfedge \c h points to to \c v
         void set_target(Halfedge h, Vertex v)
         {
+#ifdef EASY3D_SOA_CONNECTIVITY
+            hconn_vertex_[h] = v;
+#else
             hconn_[h].vertex_ = v;
+#endif
         }
 
         /// returns the face incident to halfedge \c h
         Face face(Halfedge h) const
         {
+#ifdef EASY3D_SOA_CONNECTIVITY
+            return hconn_face_[h];
+#else
             return hconn_[h].face_;
+#endif
         }
 
         /// sets the incident face to halfedge \c h to \c f
         void set_face(Halfedge h, Face f)
         {
+#ifdef EASY3D_SOA_CONNECTIVITY
+            hconn_face_[h] = f;
+#else
             hconn_[h].face_ = f;
+#endif
         }
 
         /// returns the next halfedge within the incident face
         Halfedge next(Halfedge h) const
         {
+#ifdef EASY3D_SOA_CONNECTIVITY
+            return hconn_next_[h];
+#else
             return hconn_[h].next_;
+#endif
         }
 
         /// sets the next halfedge of \c h within the face to \c nh
         void set_next(Halfedge h, Halfedge nh)
         {
-            hconn_[h].next_ = nh;
-            hconn_[nh].prev_ = h;
+            set_next_only(h, nh);
+            set_prev_only(nh, h);
         }
 
         /// returns the previous halfedge within the incident face
         Halfedge prev(Halfedge h) const
         {
+#ifdef EASY3D_SOA_CONNECTIVITY
+            return hconn_prev_[h];
+#else
             return hconn_[h].prev_;
+#endif
         }
 
         /// returns the opposite halfedge of \c h
@@ -1322,35 +1414,35 @@ namespace easy3d {
         /** add a vertex property of type \c T with name \c name and default value \c t.
          fails if a property named \c name exists already, since the name has to be unique.
          in this case it returns an invalid property */
-        template <class T> VertexProperty<T> add_vertex_property(const std::string& name, const T t=T())
+        template <class T> VertexProperty<T> add_vertex_property(const PropertyName& name, const T t=T())
         {
             return VertexProperty<T>(vprops_.add<T>(name, t));
         }
         /** add a halfedge property of type \c T with name \c name and default value \c t.
          fails if a property named \c name exists already, since the name has to be unique.
          in this case it returns an invalid property */
-        template <class T> HalfedgeProperty<T> add_halfedge_property(const std::string& name, const T t=T())
+        template <class T> HalfedgeProperty<T> add_halfedge_property(const PropertyName& name, const T t=T())
         {
             return HalfedgeProperty<T>(hprops_.add<T>(name, t));
         }
         /** add a edge property of type \c T with name \c name and default value \c t.
          fails if a property named \c name exists already, since the name has to be unique.
          in this case it returns an invalid property */
-        template <class T> EdgeProperty<T> add_edge_property(const std::string& name, const T t=T())
+        template <class T> EdgeProperty<T> add_edge_property(const PropertyName& name, const T t=T())
         {
             return EdgeProperty<T>(eprops_.add<T>(name, t));
         }
         /** add a face property of type \c T with name \c name and default value \c t.
          fails if a property named \c name exists already, since the name has to be unique.
          in this case it returns an invalid property */
-        template <class T> FaceProperty<T> add_face_property(const std::string& name, const T t=T())
+        template <class T> FaceProperty<T> add_face_property(const PropertyName& name, const T t=T())
         {
             return FaceProperty<T>(fprops_.add<T>(name, t));
         }
         /** add a model property of type \c T with name \c name and default value \c t.
          fails if a property named \c name exists already, since the name has to be unique.
          in this case it returns an invalid property */
-        template <class T> ModelProperty<T> add_model_property(const std::string& name, const T t=T())
+        template <class T> ModelProperty<T> add_model_property(const PropertyName& name, const T t=T())
         {
             return ModelProperty<T>(mprops_.add<T>(name, t));
         }
@@ -1358,31 +1450,31 @@ namespace easy3d {
 
         /** get the vertex property named \c name of type \c T. returns an invalid
          VertexProperty if the property does not exist or if the type does not match. */
-        template <class T> VertexProperty<T> get_vertex_property(const std::string& name) const
+        template <class T> VertexProperty<T> get_vertex_property(const PropertyName& name) const
         {
             return VertexProperty<T>(vprops_.get<T>(name));
         }
         /** get the halfedge property named \c name of type \c T. returns an invalid
          VertexProperty if the property does not exist or if the type does not match. */
-        template <class T> HalfedgeProperty<T> get_halfedge_property(const std::string& name) const
+        template <class T> HalfedgeProperty<T> get_halfedge_property(const PropertyName& name) const
         {
             return HalfedgeProperty<T>(hprops_.get<T>(name));
         }
         /** get the edge property named \c name of type \c T. returns an invalid
          VertexProperty if the property does not exist or if the type does not match. */
-        template <class T> EdgeProperty<T> get_edge_property(const std::string& name) const
+        template <class T> EdgeProperty<T> get_edge_property(const PropertyName& name) const
         {
             return EdgeProperty<T>(eprops_.get<T>(name));
         }
         /** get the face property named \c name of type \c T. returns an invalid
          VertexProperty if the property does not exist or if the type does not match. */
-        template <class T> FaceProperty<T> get_face_property(const std::string& name) const
+        template <class T> FaceProperty<T> get_face_property(const PropertyName& name) const
         {
             return FaceProperty<T>(fprops_.get<T>(name));
         }
         /** get the model property named \c name of type \c T. returns an invalid
          ModelProperty if the property does not exist or if the type does not match. */
-        template <class T> ModelProperty<T> get_model_property(const std::string& name) const
+        template <class T> ModelProperty<T> get_model_property(const PropertyName& name) const
         {
             return ModelProperty<T>(mprops_.get<T>(name));
         }
@@ -1390,32 +1482,32 @@ namespace easy3d {
 
         /** if a vertex property of type \c T with name \c name exists, it is returned.
          otherwise this property is added (with default value \c t) */
-        template <class T> VertexProperty<T> vertex_property(const std::string& name, const T t=T())
+        template <class T> VertexProperty<T> vertex_property(const PropertyName& name, const T t=T())
         {
             return VertexProperty<T>(vprops_.get_or_add<T>(name, t));
         }
         /** if a halfedge property of type \c T with name \c name exists, it is returned.
          otherwise this property is added (with default value \c t) */
-        template <class T> HalfedgeProperty<T> halfedge_property(const std::string& name, const T t=T())
+        template <class T> HalfedgeProperty<T> halfedge_property(const PropertyName& name, const T t=T())
         {
             return HalfedgeProperty<T>(hprops_.get_or_add<T>(name, t));
         }
         /** if an edge property of type \c T with name \c name exists, it is returned.
          otherwise this property is added (with default value \c t) */
-        template <class T> EdgeProperty<T> edge_property(const std::string& name, const T t=T())
+        template <class T> EdgeProperty<T> edge_property(const PropertyName& name, const T t=T())
         {
             return EdgeProperty<T>(eprops_.get_or_add<T>(name, t));
         }
         /** if a face property of type \c T with name \c name exists, it is returned.
          otherwise this property is added (with default value \c t) */
-        template <class T> FaceProperty<T> face_property(const std::string& name, const T t=T())
+        template <class T> FaceProperty<T> face_property(const PropertyName& name, const T t=T())
         {
             return FaceProperty<T>(fprops_.get_or_add<T>(name, t));
         }
 
          /** if a model property of type \c T with name \c name exists, it is returned.
          otherwise this property is added (with default value \c t) */
-        template <class T> ModelProperty<T> model_property(const std::string& name, const T t=T())
+        template <class T> ModelProperty<T> model_property(const PropertyName& name, const T t=T())
         {
             return ModelProperty<T>(mprops_.get_or_add<T>(name, t));
         }
@@ -1457,58 +1549,58 @@ namespace easy3d {
         bool remove_model_property(const std::string &n) { return mprops_.remove(n); }
 
         /// rename a vertex property given its name
-        bool rename_vertex_property(const std::string &old_name, const std::string &new_name) {
+        bool rename_vertex_property(const PropertyName &old_name, const PropertyName &new_name) {
             return vprops_.rename(old_name, new_name);
         }
 
         /// rename a face property given its name
-        bool rename_face_property(const std::string &old_name, const std::string &new_name) {
+        bool rename_face_property(const PropertyName &old_name, const PropertyName &new_name) {
             return fprops_.rename(old_name, new_name);
         }
 
         /// rename an edge property given its name
-        bool rename_edge_property(const std::string &old_name, const std::string &new_name) {
+        bool rename_edge_property(const PropertyName &old_name, const PropertyName &new_name) {
             return eprops_.rename(old_name, new_name);
         }
 
         /// rename a halfedge property given its name
-        bool rename_halfedge_property(const std::string &old_name, const std::string &new_name) {
+        bool rename_halfedge_property(const PropertyName &old_name, const PropertyName &new_name) {
             return hprops_.rename(old_name, new_name);
         }
 
         /// rename a model property given its name
-        bool rename_model_property(const std::string &old_name, const std::string &new_name) {
+        bool rename_model_property(const PropertyName &old_name, const PropertyName &new_name) {
             return mprops_.rename(old_name, new_name);
         }
 
 
         /** get the type_info \c T of vertex property \p name. returns an typeid(void)
          if the property does not exist or if the type does not match. */
-        const std::type_info& get_vertex_property_type(const std::string& name) const
+        const std::type_info& get_vertex_property_type(const PropertyName& name) const
         {
             return vprops_.get_type(name);
         }
         /** get the type_info \c T of halfedge property \p name. returns an typeid(void)
          if the property does not exist or if the type does not match. */
-        const std::type_info& get_halfedge_property_type(const std::string& name) const
+        const std::type_info& get_halfedge_property_type(const PropertyName& name) const
         {
             return hprops_.get_type(name);
         }
         /** get the type_info \c T of edge property \p name. returns an typeid(void)
          if the property does not exist or if the type does not match. */
-        const std::type_info& get_edge_property_type(const std::string& name) const
+        const std::type_info& get_edge_property_type(const PropertyName& name) const
         {
             return eprops_.get_type(name);
         }
         /** get the type_info \c T of face property \p name. returns an typeid(void)
          if the property does not exist or if the type does not match. */
-        const std::type_info& get_face_property_type(const std::string& name) const
+        const std::type_info& get_face_property_type(const PropertyName& name) const
         {
             return fprops_.get_type(name);
         }
         /** get the type_info \c T of model property \p name. returns an typeid(void)
          if the property does not exist or if the type does not match. */
-        const std::type_info& get_model_property_type(const std::string& name) const
+        const std::type_info& get_model_property_type(const PropertyName& name) const
         {
             return mprops_.get_type(name);
         }
@@ -1891,6 +1983,7 @@ namespace easy3d {
         Vertex new_vertex()
         {
             vprops_.push_back();
+            ++structural_version_;
             return Vertex(vertices_size()-1);
         }
 
@@ -1902,6 +1995,7 @@ namespace easy3d {
             eprops_.push_back();
             hprops_.push_back();
             hprops_.push_back();
+            ++structural_version_;
 
             Halfedge h0(halfedges_size()-2);
             Halfedge h1(halfedges_size()-1);
@@ -1916,6 +2010,7 @@ namespace easy3d {
         Face new_face()
         {
             fprops_.push_back();
+            ++structural_version_;
             return Face(faces_size()-1);
         }
 
@@ -1944,6 +2039,27 @@ namespace easy3d {
         /// twice by is_stitch_ok(), once per orientation of the edges.
         bool can_merge_vertices(Halfedge h0, Halfedge h1);
 
+        /// sets the next halfedge of \c h to \c nh without updating the prev link of \c nh.
+        /// Used internally where next/prev are rewired independently (e.g., join(), file readers).
+        void set_next_only(Halfedge h, Halfedge nh)
+        {
+#ifdef EASY3D_SOA_CONNECTIVITY
+            hconn_next_[h] = nh;
+#else
+            hconn_[h].next_ = nh;
+#endif
+        }
+
+        /// sets the previous halfedge of \c h to \c ph without updating the next link of \c ph.
+        void set_prev_only(Halfedge h, Halfedge ph)
+        {
+#ifdef EASY3D_SOA_CONNECTIVITY
+            hconn_prev_[h] = ph;
+#else
+            hconn_[h].prev_ = ph;
+#endif
+        }
+
     private: //------------------------------------------------------- private data
 
         PropertyContainer vprops_;
@@ -1953,7 +2069,15 @@ namespace easy3d {
         PropertyContainer mprops_;
 
         VertexProperty<VertexConnectivity>      vconn_;
+#ifdef EASY3D_SOA_CONNECTIVITY
+        // structure-of-arrays layout: one contiguous array per connectivity field
+        HalfedgeProperty<Face>      hconn_face_;
+        HalfedgeProperty<Vertex>    hconn_vertex_;
+        HalfedgeProperty<Halfedge>  hconn_next_;
+        HalfedgeProperty<Halfedge>  hconn_prev_;
+#else
         HalfedgeProperty<HalfedgeConnectivity>  hconn_;
+#endif
         FaceProperty<FaceConnectivity>          fconn_;
 
         VertexProperty<bool>  vdeleted_;
@@ -1968,6 +2092,7 @@ namespace easy3d {
         unsigned int deleted_edges_;
         unsigned int deleted_faces_;
         bool garbage_;
+        std::size_t structural_version_;
 
         // helper data for add_face()
         typedef std::pair<Halfedge, Halfedge>  NextCacheEntry;
@@ -127,6 +127,8 @@ namespace easy3d {
 
     /// \brief A 2D polygon of \p float type.
     typedef GenericPolygon<float> Polygon2;
+    /// \brief A preprocessed 2D polygon of \p float type, for bulk point-in-polygon tests.
+    typedef GenericPolygonTester<float> PolygonTester2;
 
 
     namespace geom {
@@ -0,0 +1,159 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/fileio/batch_convert.h>
+
+#include <atomic>
+#include <fstream>
+
+#include <easy3d/core/graph.h>
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/core/poly_mesh.h>
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/fileio/graph_io.h>
+#include <easy3d/fileio/point_cloud_io.h>
+#include <easy3d/fileio/poly_mesh_io.h>
+#include <easy3d/fileio/surface_mesh_io.h>
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/logging.h>
+#include <easy3d/util/progress.h>
+#include <easy3d/util/stop_watch.h>
+#include <easy3d/util/thread_pool.h>
+
+
+namespace easy3d {
+
+    namespace io {
+
+        std::size_t BatchConverter::run(const std::vector<std::string>& file_names,
+                                        const std::string& target_extension,
+                                        const std::string& target_directory)
+        {
+            results_.clear();
+            results_.resize(file_names.size());
+            if (file_names.empty())
+                return 0;
+
+            if (!target_directory.empty() && !file_system::is_directory(target_directory)) {
+                if (!file_system::create_directory(target_directory)) {
+                    LOG(ERROR) << "could not create directory: " << target_directory;
+                    return 0;
+                }
+            }
+
+            ProgressLogger progress(file_names.size());
+            std::atomic<std::size_t> num_converted(0);
+
+            // one file per task: at most one model per worker is in memory at any time, and
+            // big and small tiles balance over the workers
+            ThreadPool::global().parallel_for(0, file_names.size(), [&](std::size_t i) {
+                Result& result = results_[i];
+                result.source = file_names[i];
+                result.success = false;
+                result.num_vertices = 0;
+                result.seconds = 0.0;
+
+                const std::string dir = target_directory.empty()
+                        ? file_system::parent_directory(result.source) : target_directory;
+                result.target = dir + "/" + file_system::base_name(result.source) + "." + target_extension;
+
+                if (progress.is_canceled()) {
+                    result.message = "canceled";
+                    return;
+                }
+                if (result.target == result.source) {
+                    result.message = "target equals source";
+                    progress.next();
+                    return;
+                }
+
+                StopWatch w;
+                Model* model = nullptr;
+                switch (type_) {
+                    case POINT_CLOUD:   model = PointCloudIO::load(result.source);  break;
+                    case SURFACE_MESH:  model = SurfaceMeshIO::load(result.source); break;
+                    case GRAPH:         model = GraphIO::load(result.source);       break;
+                    case POLY_MESH:     model = PolyMeshIO::load(result.source);    break;
+                }
+                if (!model)
+                    result.message = "loading failed";
+                else {
+                    bool saved = false;
+                    switch (type_) {
+                        case POINT_CLOUD:
+                            saved = PointCloudIO::save(result.target, dynamic_cast<PointCloud*>(model));
+                            break;
+                        case SURFACE_MESH:
+                            saved = SurfaceMeshIO::save(result.target, dynamic_cast<SurfaceMesh*>(model));
+                            break;
+                        case GRAPH:
+                            saved = GraphIO::save(result.target, dynamic_cast<Graph*>(model));
+                            break;
+                        case POLY_MESH:
+                            saved = PolyMeshIO::save(result.target, dynamic_cast<PolyMesh*>(model));
+                            break;
+                    }
+                    if (saved) {
+                        result.success = true;
+                        result.num_vertices = model->points().size();
+                        ++num_converted;
+                    }
+                    else
+                        result.message = "saving failed";
+                    delete model;
+                }
+                result.seconds = w.elapsed_seconds(3);
+                progress.next();
+            }, 1);
+
+            LOG(INFO) << num_converted << " of " << file_names.size() << " files converted";
+            return num_converted;
+        }
+
+
+        bool BatchConverter::save_manifest(const std::string& file_name) const {
+            std::ofstream output(file_name.c_str());
+            if (output.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            std::size_t num_converted = 0;
+            for (const auto& result : results_) {
+                if (result.success) {
+                    output << "ok\t" << result.source << "\t" << result.target << "\t"
+                           << result.num_vertices << " vertices\t" << result.seconds << " s\n";
+                    ++num_converted;
+                }
+                else
+                    output << "failed\t" << result.source << "\t" << result.target << "\t"
+                           << result.message << "\n";
+            }
+            output << "# " << num_converted << " of " << results_.size() << " files converted\n";
+            return !output.fail();
+        }
+
+    } // namespace io
+
+} // namespace easy3d
@@ -0,0 +1,109 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_FILEIO_BATCH_CONVERT_H
+#define EASY3D_FILEIO_BATCH_CONVERT_H
+
+#include <string>
+#include <vector>
+
+
+namespace easy3d {
+
+    namespace io {
+
+        /**
+         * \brief Parallel batch conversion of model files between the supported formats.
+         * \class BatchConverter easy3d/fileio/batch_convert.h
+         *
+         * \details The converter distributes the files of a job over the workers of the global
+         * thread pool. Every file is processed independently (load, save, release), so at most
+         * one model per worker is in memory at any time: thousands of tiles can be converted
+         * with bounded memory, and the workers keep the disk busy instead of one core. The
+         * outcome of every file is recorded and can be written as a manifest.
+         *
+         * Example usage (converting a set of LAS tiles to the \c bin format):
+         *      \code
+         *      BatchConverter converter(BatchConverter::POINT_CLOUD);
+         *      converter.run(tiles, "bin");
+         *      converter.save_manifest("conversion.txt");
+         *      \endcode
+         *
+         * A run can be canceled from another thread (e.g., a GUI button) via progress::cancel();
+         * files not started by then are recorded as canceled.
+         */
+        class BatchConverter
+        {
+        public:
+            /// The kind of model stored in the files (it determines the IO class used).
+            enum Type {
+                POINT_CLOUD,    ///< handled by PointCloudIO
+                SURFACE_MESH,   ///< handled by SurfaceMeshIO
+                GRAPH,          ///< handled by GraphIO
+                POLY_MESH       ///< handled by PolyMeshIO
+            };
+
+            /// The record of one file of a conversion job.
+            struct Result {
+                std::string source;         ///< the input file
+                std::string target;         ///< the output file
+                bool        success;        ///< whether the conversion succeeded
+                std::string message;        ///< the failure reason (empty on success)
+                std::size_t num_vertices;   ///< the number of vertices of the converted model
+                double      seconds;        ///< the wall time spent on this file
+            };
+
+            BatchConverter(Type type) : type_(type) {}
+
+            /**
+             * \brief Converts every file of \p file_names to the format of \p target_extension.
+             * \param file_names The input files.
+             * \param target_extension The extension (without the dot) determining the output
+             *      format, e.g., "bin" or "ply".
+             * \param target_directory Where the output files go. Empty (the default) places
+             *      every output file next to its input file.
+             * \return The number of successfully converted files. The per-file outcomes are
+             *      available from results().
+             */
+            std::size_t run(const std::vector<std::string>& file_names,
+                            const std::string& target_extension,
+                            const std::string& target_directory = "");
+
+            /// \brief The per-file outcomes of the last run, in the order of the input files.
+            const std::vector<Result>& results() const { return results_; }
+
+            /// \brief Writes the manifest of the last run: one line per file recording the
+            ///     outcome, vertex count, timing, and failure reason, plus a summary line.
+            bool save_manifest(const std::string& file_name) const;
+
+        private:
+            Type type_;
+            std::vector<Result> results_;
+        };
+
+    } // namespace io
+
+} // namespace easy3d
+
+#endif  // EASY3D_FILEIO_BATCH_CONVERT_H
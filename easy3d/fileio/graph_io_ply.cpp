@@ -50,9 +50,10 @@ namespace easy3d {
 
 
 			template <typename T, typename PropertyT>
-            inline void add_vertex_properties(Graph* graph, const std::vector<PropertyT>& properties)
+            // the parsed array is adopted (swapped) by the destination property storage, not copied
+            inline void add_vertex_properties(Graph* graph, std::vector<PropertyT>& properties)
 			{
-				for (const auto& p : properties) {
+				for (auto& p : properties) {
                     std::string name = p.name;
                     if (p.size() != graph->n_vertices()) {
                         LOG(ERROR) << "vertex property size (" << p.size() << ") does not match number of vertices (" << graph->n_vertices() << ")";
@@ -61,15 +62,16 @@ namespace easy3d {
 					if (name.find("v:") == std::string::npos)
 						name = "v:" + name;
                     auto prop = graph->vertex_property<T>(name);
-					prop.vector() = p;
+					prop.vector().swap(p);
 				}
 			}
 
 
 			template <typename T, typename PropertyT>
-            inline void add_edge_properties(Graph* graph, const std::vector<PropertyT>& properties)
+            // the parsed array is adopted (swapped) by the destination property storage, not copied
+            inline void add_edge_properties(Graph* graph, std::vector<PropertyT>& properties)
 			{
-				for (const auto& p : properties) {
+				for (auto& p : properties) {
                     std::string name = p.name;
                     if (p.size() != graph->n_edges()) {
                         LOG(ERROR) << "edge property size (" << p.size() << ") does not match number of edges (" << graph->n_edges() << ")";
@@ -78,7 +80,7 @@ namespace easy3d {
 					if (name.find("e:") == std::string::npos)
 						name = "e:" + name;
                     auto prop = graph->edge_property<T>(name);
-					prop.vector() = p;
+					prop.vector().swap(p);
 				}
 			}
 
@@ -120,16 +122,49 @@ namespace easy3d {
                 }
 			}
 
-            for (auto p : coordinates)
-                graph->add_vertex(p);
+            // Build the graph in bulk, binding the parsed arrays directly to the destination
+            // property storage: one resize, the coordinates array adopted as "v:point", and the
+            // connectivity filled in place. Going through add_vertex()/add_edge() per element
+            // costs a property-container resize and edge-list reallocations for every call.
+            const std::size_t num_vertices = coordinates.size();
+            auto valid_edge = [num_vertices](const std::vector<int>& e) -> bool {
+                return e.size() == 2 &&
+                       e[0] >= 0 && e[0] < static_cast<int>(num_vertices) &&
+                       e[1] >= 0 && e[1] < static_cast<int>(num_vertices);
+            };
+
+            std::size_t num_valid_edges = 0;
+            std::vector<int> degrees(num_vertices, 0);
+            for (const auto& e : edge_vertex_indices) {
+                if (valid_edge(e)) {
+                    ++num_valid_edges;
+                    ++degrees[e[0]];
+                    ++degrees[e[1]];
+                }
+            }
+            LOG_IF(ERROR, num_valid_edges != edge_vertex_indices.size())
+                    << (edge_vertex_indices.size() - num_valid_edges)
+                    << " edges ignored (property \'vertex_indices\' is not a pair of valid vertex indices)";
 
-            for (auto e : edge_vertex_indices) {
-                if (e.size() == 2)
-                    graph->add_edge(Graph::Vertex(e[0]), Graph::Vertex(e[1]));
-                else {
-                    LOG(ERROR) << "The size of edge property \'vertex_indices\' is not 2";
+            graph->resize(static_cast<unsigned int>(num_vertices), static_cast<unsigned int>(num_valid_edges));
+            graph->vertex_property<vec3>("v:point").vector().swap(coordinates);
+
+            auto vconn = graph->vertex_property<Graph::VertexConnectivity>("v:connectivity");
+            auto econn = graph->edge_property<Graph::EdgeConnectivity>("e:connectivity");
+
+            // reserve each per-vertex edge list once, so filling them never reallocates
+            for (std::size_t i = 0; i < num_vertices; ++i)
+                vconn[Graph::Vertex(static_cast<int>(i))].edges_.reserve(degrees[i]);
+
+            int edge_index = 0;
+            for (const auto& e : edge_vertex_indices) {
+                if (!valid_edge(e))
                     continue;
-                }
+                const Graph::Edge edge(edge_index++);
+                econn[edge].source_ = Graph::Vertex(e[0]);
+                econn[edge].target_ = Graph::Vertex(e[1]);
+                vconn[Graph::Vertex(e[0])].edges_.push_back(edge);
+                vconn[Graph::Vertex(e[1])].edges_.push_back(edge);
             }
 
 			// now let's add the properties
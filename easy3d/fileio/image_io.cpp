@@ -24,10 +24,14 @@
 
 #include <easy3d/fileio/image_io.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <memory>
 
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <3rd_party/stb/stb_image.h>
@@ -49,8 +53,9 @@ namespace easy3d {
     {
         data.clear();
 
-        // flag is non-zero to flip data vertically (so the first pixel in the output array is the bottom left)
-        stbi_set_flip_vertically_on_load(flip_vertically);
+        // flag is non-zero to flip data vertically (so the first pixel in the output array is the bottom left).
+        // The thread-local variant keeps concurrent decodes (e.g., the batch overload) independent.
+        stbi_set_flip_vertically_on_load_thread(flip_vertically ? 1 : 0);
 
         unsigned char* pixels = stbi_load(file_name.c_str(), &width, &height, &channels, requested_channels);
         if (pixels) {
@@ -65,6 +70,32 @@ namespace easy3d {
     }
 
 
+    bool ImageIO::load(
+            const std::vector<std::string>& file_names,
+            std::vector< std::vector<unsigned char> >& data,
+            std::vector<int>& widths,
+            std::vector<int>& heights,
+            std::vector<int>& channels,
+            int requested_channels,
+            bool flip_vertically)
+    {
+        const std::size_t num = file_names.size();
+        data.resize(num);
+        widths.resize(num);
+        heights.resize(num);
+        channels.resize(num);
+
+        std::atomic<bool> all_good(true);
+        // one image per task: decoding an image is heavy and the images may differ a lot in size
+        ThreadPool::global().parallel_for(0, num, [&](std::size_t i) {
+            if (!load(file_names[i], data[i], widths[i], heights[i], channels[i], requested_channels, flip_vertically))
+                all_good = false;
+        }, 1);
+
+        return all_good;
+    }
+
+
     bool ImageIO::save(
             const std::string& file_name,
             const std::vector<unsigned char>& data,
@@ -107,6 +138,38 @@ namespace easy3d {
     }
 
 
+    void ImageIO::save_async(
+            const std::string& file_name,
+            std::vector<unsigned char> data,
+            int width,
+            int height,
+            int channels,
+            bool flip_vertically)
+    {
+        if (data.empty()) {
+            LOG(ERROR) << "image data is empty";
+            return;
+        }
+
+        // the flip is done here on the private copy instead of by the encoder, because the
+        // encoder's flip flag is a process-wide global and the encode runs on a worker thread,
+        // concurrently with whatever other saves are going on.
+        if (flip_vertically) {
+            const std::size_t stride = static_cast<std::size_t>(width) * channels;
+            for (int r = 0; r < height / 2; ++r)
+                std::swap_ranges(data.begin() + r * stride,
+                                 data.begin() + (r + 1) * stride,
+                                 data.begin() + (height - 1 - r) * stride);
+        }
+
+        // C++11 lambdas cannot capture by move, hence the shared_ptr
+        auto pixels = std::make_shared< std::vector<unsigned char> >(std::move(data));
+        ThreadPool::global().run([file_name, pixels, width, height, channels]() {
+            save(file_name, *pixels, width, height, channels, false);   // failures are logged by save()
+        });
+    }
+
+
 
     namespace io {
 
@@ -91,6 +91,34 @@ namespace easy3d {
                 bool flip_vertically = true
                 );
 
+        /**
+         * \brief Load a batch of image files, decoding them in parallel on the global thread pool.
+         *
+         * \details Decoding compressed formats (PNG/JPG) is inherently sequential within one image,
+         *          but independent images decode concurrently, so converting a set of textures scales
+         *          with the number of cores. The outputs are resized to the number of files; entry i
+         *          corresponds to file i and is empty/unspecified if that file failed to load.
+         *
+         * \param file_names The image files to load.
+         * \param data  Outputs the image data, one entry per file (see the single-file overload).
+         * \param widths Outputs the image widths in pixels.
+         * \param heights Outputs the image heights in pixels.
+         * \param channels Outputs the numbers of 8-bit image channels per pixel.
+         * \param requested_channels User requested image channels (applied to all files).
+         * \param flip_vertically Flip the image data vertically if it is true (default value).
+         *
+         * \return Return true if all files loaded successfully, false if any of them failed.
+         */
+        static bool load(
+                const std::vector<std::string>& file_names,
+                std::vector< std::vector<unsigned char> >& data,
+                std::vector<int>& widths,
+                std::vector<int>& heights,
+                std::vector<int>& channels,
+                int requested_channels = 0,
+                bool flip_vertically = true
+                );
+
         /**
          * \brief Write image data into a file. The following formats are supported
          *        JPG/JPEG, PNG, BMP, and TGA. File format is determined by the file
@@ -119,6 +147,32 @@ namespace easy3d {
                 bool flip_vertically = false
                 );
 
+        /**
+         * \brief Write image data into a file asynchronously, encoding on a worker of the global
+         *        thread pool.
+         *
+         * \details The function returns as soon as the encode task has been queued, so the calling
+         *          thread (e.g., the render thread taking a snapshot) never blocks on PNG/JPG
+         *          compression. The image data is taken by value; pass it with std::move() to avoid
+         *          the copy. Since the result is not available to the caller, failures are reported
+         *          through the log. Pending encodes finish before the global thread pool shuts down.
+         *
+         * \param file_name The file to which the image data will be save.
+         * \param data  The image data (see save()). Taken by value; moved into the encode task.
+         * \param width The width of the image, in pixels.
+         * \param height The height of the image, in pixels.
+         * \param channels The number of 8-bit image channels per pixel.
+         * \param flip_vertically Flip the image data vertically before writting.
+         */
+        static void save_async(
+                const std::string& file_name,
+                std::vector<unsigned char> data,
+                int width,
+                int height,
+                int channels,
+                bool flip_vertically = false
+                );
+
     };
 
 
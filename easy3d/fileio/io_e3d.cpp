@@ -0,0 +1,558 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/fileio/point_cloud_io.h>
+#include <easy3d/fileio/surface_mesh_io.h>
+#include <easy3d/fileio/poly_mesh_io.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/poly_mesh.h>
+#include <easy3d/util/logging.h>
+
+
+/** ----------------------------------------------------------
+ *
+ * The e3d format is a native binary cache: the property arrays of a model are
+ * dumped verbatim, prefixed by a header describing their names and value types.
+ * Reloading a cached model is therefore a single sequential read plus a pointer
+ * fixup - no tokenizing and no ManifoldBuilder pass. The files are written in
+ * the byte order of the machine (like the smesh and bin formats) and are meant
+ * for caching on the same machine, not for data exchange.
+ *
+ *----------------------------------------------------------*/
+
+
+namespace easy3d {
+
+    namespace io {
+
+        namespace internal {
+
+            static const char E3D_MAGIC[4] = { 'E', '3', 'D', '\n' };
+            static const std::uint32_t E3D_VERSION = 1;
+
+            // the kind of model stored in the file
+            enum ModelKind : std::uint32_t {
+                KIND_POINT_CLOUD = 1,
+                KIND_SURFACE_MESH = 2,
+                KIND_POLY_MESH = 3
+            };
+
+            // tags identifying the value type of a cached property array. Only trivially
+            // copyable types can be dumped verbatim; properties of other types are skipped.
+            enum DataType : std::uint32_t {
+                DT_NONE = 0,
+                DT_BOOL, DT_CHAR, DT_UCHAR, DT_INT, DT_UINT, DT_FLOAT, DT_DOUBLE,
+                DT_VEC2, DT_VEC3, DT_VEC4,
+                DT_SM_VERTEX, DT_SM_HALFEDGE, DT_SM_EDGE, DT_SM_FACE,
+                DT_SM_VERTEX_CONNECTIVITY, DT_SM_HALFEDGE_CONNECTIVITY, DT_SM_FACE_CONNECTIVITY
+            };
+
+            inline std::uint32_t tag_of(const std::type_info& type) {
+                if (type == typeid(bool))           return DT_BOOL;
+                if (type == typeid(char))           return DT_CHAR;
+                if (type == typeid(unsigned char))  return DT_UCHAR;
+                if (type == typeid(int))            return DT_INT;
+                if (type == typeid(unsigned int))   return DT_UINT;
+                if (type == typeid(float))          return DT_FLOAT;
+                if (type == typeid(double))         return DT_DOUBLE;
+                if (type == typeid(vec2))           return DT_VEC2;
+                if (type == typeid(vec3))           return DT_VEC3;
+                if (type == typeid(vec4))           return DT_VEC4;
+                if (type == typeid(SurfaceMesh::Vertex))    return DT_SM_VERTEX;
+                if (type == typeid(SurfaceMesh::Halfedge))  return DT_SM_HALFEDGE;
+                if (type == typeid(SurfaceMesh::Edge))      return DT_SM_EDGE;
+                if (type == typeid(SurfaceMesh::Face))      return DT_SM_FACE;
+                if (type == typeid(SurfaceMesh::VertexConnectivity))    return DT_SM_VERTEX_CONNECTIVITY;
+                if (type == typeid(SurfaceMesh::HalfedgeConnectivity))  return DT_SM_HALFEDGE_CONNECTIVITY;
+                if (type == typeid(SurfaceMesh::FaceConnectivity))      return DT_SM_FACE_CONNECTIVITY;
+                return DT_NONE;
+            }
+
+            inline void write_uint32(std::ostream& output, std::uint32_t value) {
+                output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+
+            inline std::uint32_t read_uint32(std::istream& input) {
+                std::uint32_t value = 0;
+                input.read(reinterpret_cast<char*>(&value), sizeof(value));
+                return value;
+            }
+
+            inline void write_uint64(std::ostream& output, std::uint64_t value) {
+                output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+
+            inline std::uint64_t read_uint64(std::istream& input) {
+                std::uint64_t value = 0;
+                input.read(reinterpret_cast<char*>(&value), sizeof(value));
+                return value;
+            }
+
+            inline void write_string(std::ostream& output, const std::string& str) {
+                write_uint32(output, static_cast<std::uint32_t>(str.size()));
+                output.write(str.data(), static_cast<std::streamsize>(str.size()));
+            }
+
+            inline std::string read_string(std::istream& input) {
+                const std::uint32_t len = read_uint32(input);
+                std::string str(len, '\0');
+                if (len > 0)
+                    input.read(&str[0], static_cast<std::streamsize>(len));
+                return str;
+            }
+
+            // the property block of a bool array: packed one byte per value, because
+            // std::vector<bool> does not expose contiguous storage
+            template <typename Access>
+            inline void write_bool_block(std::ostream& output, const Access& access,
+                                         const std::string& name, std::size_t num) {
+                const std::vector<bool>& values = access.template get<bool>(name).vector();
+                std::vector<unsigned char> bytes(num);
+                for (std::size_t i = 0; i < num; ++i)
+                    bytes[i] = values[i] ? 1 : 0;
+                output.write(reinterpret_cast<const char*>(bytes.data()),
+                             static_cast<std::streamsize>(num));
+            }
+
+            template <typename Access>
+            inline void read_bool_block(std::istream& input, const Access& access,
+                                        const std::string& name, std::size_t num) {
+                std::vector<unsigned char> bytes(num);
+                input.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(num));
+                std::vector<bool>& values = access.template ensure<bool>(name).vector();
+                for (std::size_t i = 0; i < num; ++i)
+                    values[i] = (bytes[i] != 0);
+            }
+
+            template <typename T, typename Access>
+            inline void write_block(std::ostream& output, const Access& access,
+                                    const std::string& name, std::size_t num) {
+                output.write(reinterpret_cast<const char*>(access.template get<T>(name).data()),
+                             static_cast<std::streamsize>(num * sizeof(T)));
+            }
+
+            template <typename T, typename Access>
+            inline void read_block(std::istream& input, const Access& access,
+                                   const std::string& name, std::size_t num) {
+                input.read(reinterpret_cast<char*>(access.template ensure<T>(name).data()),
+                           static_cast<std::streamsize>(num * sizeof(T)));
+            }
+
+            // writes one property container: the number of cached arrays, then for each array
+            // its name, its type tag, and the raw bytes of its data
+            template <typename Access>
+            void write_container(std::ostream& output, const Access& access, std::size_t num) {
+                std::vector<std::string> names;
+                for (const auto& name : access.names()) {
+                    if (tag_of(access.type(name)) != DT_NONE)
+                        names.push_back(name);
+                    else
+                        LOG(WARNING) << "property '" << name
+                                     << "' has a type that cannot be cached (skipped)";
+                }
+
+                write_uint32(output, static_cast<std::uint32_t>(names.size()));
+                for (const auto& name : names) {
+                    const std::uint32_t tag = tag_of(access.type(name));
+                    write_string(output, name);
+                    write_uint32(output, tag);
+                    switch (tag) {
+                        case DT_BOOL:   write_bool_block(output, access, name, num);        break;
+                        case DT_CHAR:   write_block<char>(output, access, name, num);       break;
+                        case DT_UCHAR:  write_block<unsigned char>(output, access, name, num);  break;
+                        case DT_INT:    write_block<int>(output, access, name, num);        break;
+                        case DT_UINT:   write_block<unsigned int>(output, access, name, num);   break;
+                        case DT_FLOAT:  write_block<float>(output, access, name, num);      break;
+                        case DT_DOUBLE: write_block<double>(output, access, name, num);     break;
+                        case DT_VEC2:   write_block<vec2>(output, access, name, num);       break;
+                        case DT_VEC3:   write_block<vec3>(output, access, name, num);       break;
+                        case DT_VEC4:   write_block<vec4>(output, access, name, num);       break;
+                        case DT_SM_VERTEX:      write_block<SurfaceMesh::Vertex>(output, access, name, num);    break;
+                        case DT_SM_HALFEDGE:    write_block<SurfaceMesh::Halfedge>(output, access, name, num);  break;
+                        case DT_SM_EDGE:        write_block<SurfaceMesh::Edge>(output, access, name, num);      break;
+                        case DT_SM_FACE:        write_block<SurfaceMesh::Face>(output, access, name, num);      break;
+                        case DT_SM_VERTEX_CONNECTIVITY:
+                            write_block<SurfaceMesh::VertexConnectivity>(output, access, name, num);    break;
+                        case DT_SM_HALFEDGE_CONNECTIVITY:
+                            write_block<SurfaceMesh::HalfedgeConnectivity>(output, access, name, num);  break;
+                        case DT_SM_FACE_CONNECTIVITY:
+                            write_block<SurfaceMesh::FaceConnectivity>(output, access, name, num);      break;
+                        default: break; // cannot happen: names with DT_NONE were filtered above
+                    }
+                }
+            }
+
+            template <typename Access>
+            bool read_container(std::istream& input, const Access& access, std::size_t num) {
+                const std::uint32_t num_arrays = read_uint32(input);
+                for (std::uint32_t i = 0; i < num_arrays && !input.fail(); ++i) {
+                    const std::string name = read_string(input);
+                    const std::uint32_t tag = read_uint32(input);
+                    switch (tag) {
+                        case DT_BOOL:   read_bool_block(input, access, name, num);          break;
+                        case DT_CHAR:   read_block<char>(input, access, name, num);         break;
+                        case DT_UCHAR:  read_block<unsigned char>(input, access, name, num);    break;
+                        case DT_INT:    read_block<int>(input, access, name, num);          break;
+                        case DT_UINT:   read_block<unsigned int>(input, access, name, num);     break;
+                        case DT_FLOAT:  read_block<float>(input, access, name, num);        break;
+                        case DT_DOUBLE: read_block<double>(input, access, name, num);       break;
+                        case DT_VEC2:   read_block<vec2>(input, access, name, num);         break;
+                        case DT_VEC3:   read_block<vec3>(input, access, name, num);         break;
+                        case DT_VEC4:   read_block<vec4>(input, access, name, num);         break;
+                        case DT_SM_VERTEX:      read_block<SurfaceMesh::Vertex>(input, access, name, num);      break;
+                        case DT_SM_HALFEDGE:    read_block<SurfaceMesh::Halfedge>(input, access, name, num);    break;
+                        case DT_SM_EDGE:        read_block<SurfaceMesh::Edge>(input, access, name, num);        break;
+                        case DT_SM_FACE:        read_block<SurfaceMesh::Face>(input, access, name, num);        break;
+                        case DT_SM_VERTEX_CONNECTIVITY:
+                            read_block<SurfaceMesh::VertexConnectivity>(input, access, name, num);      break;
+                        case DT_SM_HALFEDGE_CONNECTIVITY:
+                            read_block<SurfaceMesh::HalfedgeConnectivity>(input, access, name, num);    break;
+                        case DT_SM_FACE_CONNECTIVITY:
+                            read_block<SurfaceMesh::FaceConnectivity>(input, access, name, num);        break;
+                        default:
+                            LOG(ERROR) << "unknown property type tag " << tag
+                                       << " (file written by a newer version?)";
+                            return false;
+                    }
+                }
+                return !input.fail();
+            }
+
+            // adapters giving write_container()/read_container() uniform access to the
+            // property containers of the different model types
+
+            struct CloudVertexAccess {
+                PointCloud* cloud;
+                std::vector<std::string> names() const { return cloud->vertex_properties(); }
+                const std::type_info& type(const std::string& name) const { return cloud->get_vertex_property_type(name); }
+                template <typename T> PointCloud::VertexProperty<T> get(const std::string& name) const { return cloud->get_vertex_property<T>(name); }
+                template <typename T> PointCloud::VertexProperty<T> ensure(const std::string& name) const { return cloud->vertex_property<T>(name); }
+            };
+
+            struct MeshVertexAccess {
+                SurfaceMesh* mesh;
+                std::vector<std::string> names() const { return mesh->vertex_properties(); }
+                const std::type_info& type(const std::string& name) const { return mesh->get_vertex_property_type(name); }
+                template <typename T> SurfaceMesh::VertexProperty<T> get(const std::string& name) const { return mesh->get_vertex_property<T>(name); }
+                template <typename T> SurfaceMesh::VertexProperty<T> ensure(const std::string& name) const { return mesh->vertex_property<T>(name); }
+            };
+
+            struct MeshHalfedgeAccess {
+                SurfaceMesh* mesh;
+                std::vector<std::string> names() const { return mesh->halfedge_properties(); }
+                const std::type_info& type(const std::string& name) const { return mesh->get_halfedge_property_type(name); }
+                template <typename T> SurfaceMesh::HalfedgeProperty<T> get(const std::string& name) const { return mesh->get_halfedge_property<T>(name); }
+                template <typename T> SurfaceMesh::HalfedgeProperty<T> ensure(const std::string& name) const { return mesh->halfedge_property<T>(name); }
+            };
+
+            struct MeshEdgeAccess {
+                SurfaceMesh* mesh;
+                std::vector<std::string> names() const { return mesh->edge_properties(); }
+                const std::type_info& type(const std::string& name) const { return mesh->get_edge_property_type(name); }
+                template <typename T> SurfaceMesh::EdgeProperty<T> get(const std::string& name) const { return mesh->get_edge_property<T>(name); }
+                template <typename T> SurfaceMesh::EdgeProperty<T> ensure(const std::string& name) const { return mesh->edge_property<T>(name); }
+            };
+
+            struct MeshFaceAccess {
+                SurfaceMesh* mesh;
+                std::vector<std::string> names() const { return mesh->face_properties(); }
+                const std::type_info& type(const std::string& name) const { return mesh->get_face_property_type(name); }
+                template <typename T> SurfaceMesh::FaceProperty<T> get(const std::string& name) const { return mesh->get_face_property<T>(name); }
+                template <typename T> SurfaceMesh::FaceProperty<T> ensure(const std::string& name) const { return mesh->face_property<T>(name); }
+            };
+
+            struct PolyMeshVertexAccess {
+                PolyMesh* mesh;
+                std::vector<std::string> names() const { return mesh->vertex_properties(); }
+                const std::type_info& type(const std::string& name) const { return mesh->get_vertex_property_type(name); }
+                template <typename T> PolyMesh::VertexProperty<T> get(const std::string& name) const { return mesh->get_vertex_property<T>(name); }
+                template <typename T> PolyMesh::VertexProperty<T> ensure(const std::string& name) const { return mesh->vertex_property<T>(name); }
+            };
+
+            struct PolyMeshCellAccess {
+                PolyMesh* mesh;
+                std::vector<std::string> names() const { return mesh->cell_properties(); }
+                const std::type_info& type(const std::string& name) const { return mesh->get_cell_property_type(name); }
+                template <typename T> PolyMesh::CellProperty<T> get(const std::string& name) const { return mesh->get_cell_property<T>(name); }
+                template <typename T> PolyMesh::CellProperty<T> ensure(const std::string& name) const { return mesh->cell_property<T>(name); }
+            };
+
+            // writes the common file header; 'flags' records build options that affect the layout
+            inline void write_header(std::ostream& output, std::uint32_t kind, std::uint32_t flags) {
+                output.write(E3D_MAGIC, 4);
+                write_uint32(output, E3D_VERSION);
+                write_uint32(output, kind);
+                write_uint32(output, flags);
+            }
+
+            // checks the common file header; returns false on a mismatch so the caller can
+            // fall back to re-parsing the original file
+            inline bool read_header(std::istream& input, std::uint32_t expected_kind, std::uint32_t expected_flags) {
+                char magic[4];
+                input.read(magic, 4);
+                if (input.fail() || std::memcmp(magic, E3D_MAGIC, 4) != 0) {
+                    LOG(ERROR) << "not an e3d cache file";
+                    return false;
+                }
+                const std::uint32_t version = read_uint32(input);
+                if (version != E3D_VERSION) {
+                    LOG(ERROR) << "unsupported e3d version: " << version;
+                    return false;
+                }
+                const std::uint32_t kind = read_uint32(input);
+                if (kind != expected_kind) {
+                    LOG(ERROR) << "e3d file does not store the requested model type";
+                    return false;
+                }
+                const std::uint32_t flags = read_uint32(input);
+                if (flags != expected_flags) {
+                    LOG(ERROR) << "e3d file was written with different build options";
+                    return false;
+                }
+                return true;
+            }
+
+            inline std::uint32_t surface_mesh_flags() {
+#ifdef EASY3D_SOA_CONNECTIVITY
+                return 1;   // bit 0: halfedge connectivity stored as separate arrays
+#else
+                return 0;
+#endif
+            }
+
+        } // namespace internal
+
+
+        //-----------------------------------------------------------------------------
+
+
+        bool load_e3d(const std::string& file_name, PointCloud* cloud) {
+            if (!cloud) {
+                LOG(ERROR) << "null point cloud pointer";
+                return false;
+            }
+
+            std::ifstream input(file_name.c_str(), std::fstream::binary);
+            if (input.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            if (!internal::read_header(input, internal::KIND_POINT_CLOUD, 0))
+                return false;
+
+            const std::size_t nv = static_cast<std::size_t>(internal::read_uint64(input));
+            cloud->resize(static_cast<unsigned int>(nv));
+
+            internal::CloudVertexAccess vertices = { cloud };
+            return internal::read_container(input, vertices, nv) && cloud->n_vertices() > 0;
+        }
+
+
+        bool save_e3d(const std::string& file_name, const PointCloud* cloud) {
+            if (!cloud) {
+                LOG(ERROR) << "null point cloud pointer";
+                return false;
+            }
+
+            std::ofstream output(file_name.c_str(), std::fstream::binary);
+            if (output.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            internal::write_header(output, internal::KIND_POINT_CLOUD, 0);
+            internal::write_uint64(output, cloud->n_vertices());
+
+            internal::CloudVertexAccess vertices = { const_cast<PointCloud*>(cloud) };
+            internal::write_container(output, vertices, cloud->n_vertices());
+            return !output.fail();
+        }
+
+
+        //-----------------------------------------------------------------------------
+
+
+        bool load_e3d(std::istream& input, SurfaceMesh* mesh) {
+            if (!mesh) {
+                LOG(ERROR) << "null mesh pointer";
+                return false;
+            }
+
+            if (!internal::read_header(input, internal::KIND_SURFACE_MESH, internal::surface_mesh_flags()))
+                return false;
+
+            const std::size_t nv = static_cast<std::size_t>(internal::read_uint64(input));
+            const std::size_t ne = static_cast<std::size_t>(internal::read_uint64(input));
+            const std::size_t nf = static_cast<std::size_t>(internal::read_uint64(input));
+            mesh->resize(static_cast<unsigned int>(nv),
+                         static_cast<unsigned int>(ne),
+                         static_cast<unsigned int>(nf));
+
+            internal::MeshVertexAccess vertices = { mesh };
+            internal::MeshHalfedgeAccess halfedges = { mesh };
+            internal::MeshEdgeAccess edges = { mesh };
+            internal::MeshFaceAccess faces = { mesh };
+            return internal::read_container(input, vertices, nv) &&
+                   internal::read_container(input, halfedges, 2 * ne) &&
+                   internal::read_container(input, edges, ne) &&
+                   internal::read_container(input, faces, nf) &&
+                   mesh->n_faces() > 0;
+        }
+
+
+        bool save_e3d(std::ostream& output, const SurfaceMesh* mesh) {
+            if (!mesh) {
+                LOG(ERROR) << "null mesh pointer";
+                return false;
+            }
+
+            internal::write_header(output, internal::KIND_SURFACE_MESH, internal::surface_mesh_flags());
+            internal::write_uint64(output, mesh->n_vertices());
+            internal::write_uint64(output, mesh->n_edges());
+            internal::write_uint64(output, mesh->n_faces());
+
+            SurfaceMesh* m = const_cast<SurfaceMesh*>(mesh);
+            internal::MeshVertexAccess vertices = { m };
+            internal::MeshHalfedgeAccess halfedges = { m };
+            internal::MeshEdgeAccess edges = { m };
+            internal::MeshFaceAccess faces = { m };
+            internal::write_container(output, vertices, mesh->n_vertices());
+            internal::write_container(output, halfedges, mesh->n_halfedges());
+            internal::write_container(output, edges, mesh->n_edges());
+            internal::write_container(output, faces, mesh->n_faces());
+            return !output.fail();
+        }
+
+
+        bool load_e3d(const std::string& file_name, SurfaceMesh* mesh) {
+            std::ifstream input(file_name.c_str(), std::fstream::binary);
+            if (input.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+            return load_e3d(input, mesh);
+        }
+
+
+        bool save_e3d(const std::string& file_name, const SurfaceMesh* mesh) {
+            std::ofstream output(file_name.c_str(), std::fstream::binary);
+            if (output.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+            return save_e3d(output, mesh);
+        }
+
+
+        //-----------------------------------------------------------------------------
+
+
+        bool load_e3d(const std::string& file_name, PolyMesh* mesh) {
+            if (!mesh) {
+                LOG(ERROR) << "null mesh pointer";
+                return false;
+            }
+
+            std::ifstream input(file_name.c_str(), std::fstream::binary);
+            if (input.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            if (!internal::read_header(input, internal::KIND_POLY_MESH, 0))
+                return false;
+
+            const std::size_t nv = static_cast<std::size_t>(internal::read_uint64(input));
+            const std::size_t nc = static_cast<std::size_t>(internal::read_uint64(input));
+
+            // the PolyMesh connectivity is not trivially copyable and thus cannot be dumped
+            // verbatim: vertices and their properties are restored in bulk, and the cells
+            // are rebuilt from the stored vertex indices (no ManifoldBuilder involved)
+            mesh->resize(static_cast<unsigned int>(nv), 0, 0, 0);
+            internal::PolyMeshVertexAccess vertices = { mesh };
+            if (!internal::read_container(input, vertices, nv))
+                return false;
+
+            for (std::size_t c = 0; c < nc && !input.fail(); ++c) {
+                const std::uint32_t num_halffaces = internal::read_uint32(input);
+                std::vector<PolyMesh::HalfFace> halffaces(num_halffaces);
+                for (std::uint32_t h = 0; h < num_halffaces; ++h) {
+                    const std::uint32_t num_valence = internal::read_uint32(input);
+                    std::vector<PolyMesh::Vertex> vts(num_valence);
+                    for (std::uint32_t v = 0; v < num_valence; ++v)
+                        vts[v] = PolyMesh::Vertex(static_cast<int>(internal::read_uint32(input)));
+                    halffaces[h] = mesh->add_face(vts);
+                }
+                mesh->add_cell(halffaces);
+            }
+
+            internal::PolyMeshCellAccess cells = { mesh };
+            return internal::read_container(input, cells, nc) &&
+                   mesh->n_vertices() > 0 && mesh->n_faces() > 0 && mesh->n_cells() > 0;
+        }
+
+
+        bool save_e3d(const std::string& file_name, const PolyMesh* mesh) {
+            if (!mesh) {
+                LOG(ERROR) << "null mesh pointer";
+                return false;
+            }
+
+            std::ofstream output(file_name.c_str(), std::fstream::binary);
+            if (output.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            internal::write_header(output, internal::KIND_POLY_MESH, 0);
+            internal::write_uint64(output, mesh->n_vertices());
+            internal::write_uint64(output, mesh->n_cells());
+
+            internal::PolyMeshVertexAccess vertices = { const_cast<PolyMesh*>(mesh) };
+            internal::write_container(output, vertices, mesh->n_vertices());
+
+            for (auto c : mesh->cells()) {
+                internal::write_uint32(output, static_cast<std::uint32_t>(mesh->halffaces(c).size()));
+                for (auto h : mesh->halffaces(c)) {
+                    internal::write_uint32(output, static_cast<std::uint32_t>(mesh->vertices(h).size()));
+                    for (auto v : mesh->vertices(h))
+                        internal::write_uint32(output, static_cast<std::uint32_t>(v.idx()));
+                }
+            }
+
+            internal::PolyMeshCellAccess cells = { const_cast<PolyMesh*>(mesh) };
+            internal::write_container(output, cells, mesh->n_cells());
+            return !output.fail();
+        }
+
+    } // namespace io
+
+} // namespace easy3d
@@ -25,9 +25,23 @@
 #include <easy3d/fileio/ply_reader_writer.h>
 #include <easy3d/util/logging.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
 #include <cstring>
+#include <fstream>
+#include <sstream>
 #include <unordered_map>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
 
 // This PLY reader/writer is based on rply. Here is a simple benchmark comparing various libraries for ply file i/o
 // https://github.com/mhalber/ply_io_benchmark
@@ -91,6 +105,40 @@ namespace easy3d {
         }
 
 
+        // the per-component names used in the file for a vec3 property
+        static void vec3_property_names(const std::string &name, std::string *names) {
+            if (name == "point") {
+                names[0] = "x";
+                names[1] = "y";
+                names[2] = "z";
+            } else if (name == "normal") {
+                names[0] = "nx";
+                names[1] = "ny";
+                names[2] = "nz";
+            } else if (name == "color") {
+                names[0] = "r";
+                names[1] = "g";
+                names[2] = "b";
+            } else {
+                names[0] = name + "_x";
+                names[1] = name + "_y";
+                names[2] = name + "_z";
+            }
+        }
+
+
+        // the per-component names used in the file for a vec2 property
+        static void vec2_property_names(const std::string &name, std::string *names) {
+            if (name == "texcoord") {
+                names[0] = "texcoord_x";
+                names[1] = "texcoord_y";
+            } else {
+                names[0] = name + "_x";
+                names[1] = name + "_y";
+            }
+        }
+
+
         bool PlyWriter::write(
                 const std::string &file_name,
                 const std::vector<Element> &elements,
@@ -105,6 +153,11 @@ namespace easy3d {
             } else
                 mode = PLY_ASCII;
 
+            // try the gathered fast path first (binary little-endian files on POSIX systems).
+            // On failure the rply path below recreates the file from scratch.
+            if (mode == PLY_LITTLE_ENDIAN && write_gathered(file_name, elements, comment))
+                return true;
+
             p_ply ply = ply_create(file_name.c_str(), mode, nullptr, 0, nullptr);
             if (!ply) {
                 LOG(ERROR) << "failed to create ply file: " << file_name;
@@ -171,23 +224,7 @@ namespace easy3d {
                     const std::string &name = vec3_properties[j].name;
 
                     std::string names[3];
-                    if (name == "point") {
-                        names[0] = "x";
-                        names[1] = "y";
-                        names[2] = "z";
-                    } else if (name == "normal") {
-                        names[0] = "nx";
-                        names[1] = "ny";
-                        names[2] = "nz";
-                    } else if (name == "color") {
-                        names[0] = "r";
-                        names[1] = "g";
-                        names[2] = "b";
-                    } else {
-                        names[0] = name + "_x";
-                        names[1] = name + "_y";
-                        names[2] = name + "_z";
-                    }
+                    vec3_property_names(name, names);
 
                     for (std::size_t k = 0; k < 3; ++k) {
                         if (!ply_add_property(ply, names[k].data(), PLY_FLOAT, length_type, PLY_FLOAT)) {
@@ -205,13 +242,7 @@ namespace easy3d {
                     const std::string &name = vec2_properties[j].name;
 
                     std::string names[2];
-                    if (name == "texcoord") {
-                        names[0] = "texcoord_x";
-                        names[1] = "texcoord_y";
-                    } else {
-                        names[0] = name + "_x";
-                        names[1] = name + "_y";
-                    }
+                    vec2_property_names(name, names);
 
                     for (std::size_t k = 0; k < 2; ++k) {
                         if (!ply_add_property(ply, names[k].data(), PLY_FLOAT, length_type, PLY_FLOAT)) {
@@ -311,6 +342,244 @@ namespace easy3d {
         }
 
 
+#ifndef _WIN32
+
+        namespace details {
+
+            // Accumulates slices of the output file (zero-copy references into the property
+            // arrays, plus small staged pieces such as list counts and interleaved records)
+            // and submits them to the OS in large writev() batches. This replaces the
+            // per-scalar rply callbacks with a handful of system calls per gigabyte.
+            class GatheredFileWriter {
+            public:
+                explicit GatheredFileWriter(int fd) : fd_(fd), run_begin_(0) {
+                    staging_.reserve(STAGING_CAPACITY);
+                }
+
+                // queue a slice of caller-owned memory (must stay valid until the next flush)
+                bool queue(const void *data, std::size_t size) {
+                    if (size == 0)
+                        return true;
+                    close_staged_run();
+                    iovec iov;
+                    iov.iov_base = const_cast<void *>(data);
+                    iov.iov_len = size;
+                    iov_.push_back(iov);
+                    if (iov_.size() >= max_batch())
+                        return flush();
+                    return true;
+                }
+
+                // copy data into the staging buffer (for pieces that are small or not
+                // contiguous in memory, e.g., list counts and interleaved records)
+                bool stage(const void *data, std::size_t size) {
+                    if (size > STAGING_CAPACITY - staging_.size()) {
+                        if (!flush())
+                            return false;
+                        if (size > STAGING_CAPACITY)    // a record larger than the buffer
+                            return write_all(data, size);
+                    }
+                    const char *p = static_cast<const char *>(data);
+                    // never reallocates (capacity was reserved), so the queued iovec slices
+                    // pointing into the buffer stay valid
+                    staging_.insert(staging_.end(), p, p + size);
+                    return true;
+                }
+
+                // submit everything accumulated so far
+                bool flush() {
+                    close_staged_run();
+                    std::size_t idx = 0;
+                    while (idx < iov_.size()) {
+                        const int cnt = static_cast<int>(
+                                std::min<std::size_t>(iov_.size() - idx, max_batch()));
+                        const ssize_t written = ::writev(fd_, &iov_[idx], cnt);
+                        if (written < 0) {
+                            if (errno == EINTR)
+                                continue;
+                            return false;
+                        }
+                        // advance over the fully written slices, trim a partially written one
+                        std::size_t remaining = static_cast<std::size_t>(written);
+                        while (remaining > 0) {
+                            if (remaining >= iov_[idx].iov_len) {
+                                remaining -= iov_[idx].iov_len;
+                                ++idx;
+                            } else {
+                                iov_[idx].iov_base = static_cast<char *>(iov_[idx].iov_base) + remaining;
+                                iov_[idx].iov_len -= remaining;
+                                remaining = 0;
+                            }
+                        }
+                    }
+                    iov_.clear();
+                    staging_.clear();
+                    run_begin_ = 0;
+                    return true;
+                }
+
+            private:
+                // turn the staged bytes accumulated since the last queued slice into an iovec
+                void close_staged_run() {
+                    if (staging_.size() > run_begin_) {
+                        iovec iov;
+                        iov.iov_base = staging_.data() + run_begin_;
+                        iov.iov_len = staging_.size() - run_begin_;
+                        iov_.push_back(iov);
+                        run_begin_ = staging_.size();
+                    }
+                }
+
+                bool write_all(const void *data, std::size_t size) {
+                    const char *p = static_cast<const char *>(data);
+                    while (size > 0) {
+                        const ssize_t written = ::write(fd_, p, size);
+                        if (written < 0) {
+                            if (errno == EINTR)
+                                continue;
+                            return false;
+                        }
+                        p += written;
+                        size -= static_cast<std::size_t>(written);
+                    }
+                    return true;
+                }
+
+                // the number of slices submitted per writev() call
+                static std::size_t max_batch() {
+#ifdef IOV_MAX
+                    return IOV_MAX;
+#else
+                    return 16;  // the minimum POSIX guarantees
+#endif
+                }
+
+            private:
+                static const std::size_t STAGING_CAPACITY = 8 * 1024 * 1024;
+
+                int fd_;
+                std::vector<iovec> iov_;
+                std::vector<char> staging_;
+                std::size_t run_begin_;
+            };
+
+        }
+
+#endif  // !_WIN32
+
+
+        bool PlyWriter::write_gathered(const std::string &file_name, const std::vector<Element> &elements,
+                                       const std::string &comment) const {
+#ifdef _WIN32
+            // not implemented on Windows; the rply path handles it
+            (void) file_name; (void) elements; (void) comment;
+            return false;
+#else
+            if (is_big_endian())
+                return false;
+
+            // compose the header: the same declarations, names, and order as the rply path,
+            // so files written by either path are identical.
+            std::ostringstream header;
+            header << "ply\nformat binary_little_endian 1.0\n";
+            header << "comment Saved by Easy3D (Contact: liangliang.nan@gmail.com)\n";
+            if (!comment.empty())
+                header << "comment " << comment << "\n";
+            for (std::size_t i = 0; i < elements.size(); ++i) {
+                const Element &element = elements[i];
+                header << "element " << element.name << " " << element.num_instances << "\n";
+                for (std::size_t j = 0; j < element.int_list_properties.size(); ++j)
+                    header << "property list uint32 int " << element.int_list_properties[j].name << "\n";
+                for (std::size_t j = 0; j < element.float_list_properties.size(); ++j)
+                    header << "property list uint32 float " << element.float_list_properties[j].name << "\n";
+                for (std::size_t j = 0; j < element.vec3_properties.size(); ++j) {
+                    std::string names[3];
+                    vec3_property_names(element.vec3_properties[j].name, names);
+                    for (std::size_t k = 0; k < 3; ++k)
+                        header << "property float " << names[k] << "\n";
+                }
+                for (std::size_t j = 0; j < element.vec2_properties.size(); ++j) {
+                    std::string names[2];
+                    vec2_property_names(element.vec2_properties[j].name, names);
+                    for (std::size_t k = 0; k < 2; ++k)
+                        header << "property float " << names[k] << "\n";
+                }
+                for (std::size_t j = 0; j < element.float_properties.size(); ++j)
+                    header << "property float " << element.float_properties[j].name << "\n";
+                for (std::size_t j = 0; j < element.int_properties.size(); ++j)
+                    header << "property int " << element.int_properties[j].name << "\n";
+            }
+            header << "end_header\n";
+
+            const int fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                LOG(ERROR) << "failed to create ply file: " << file_name;
+                return false;
+            }
+
+            details::GatheredFileWriter out(fd);
+            const std::string &header_str = header.str();
+            bool ok = out.stage(header_str.data(), header_str.size());
+
+            for (std::size_t i = 0; i < elements.size() && ok; ++i) {
+                const Element &element = elements[i];
+                const std::size_t num = element.num_instances;
+
+                const std::size_t num_arrays =
+                        element.int_list_properties.size() + element.float_list_properties.size() +
+                        element.vec3_properties.size() + element.vec2_properties.size() +
+                        element.float_properties.size() + element.int_properties.size();
+                const bool has_lists =
+                        !element.int_list_properties.empty() || !element.float_list_properties.empty();
+
+                if (num_arrays == 1 && !has_lists) {
+                    // a single fixed-size property: the file payload of the element is exactly
+                    // the property array, so the whole array is queued without any copy.
+                    if (!element.vec3_properties.empty())
+                        ok = out.queue(element.vec3_properties[0].data(), num * sizeof(vec3));
+                    else if (!element.vec2_properties.empty())
+                        ok = out.queue(element.vec2_properties[0].data(), num * sizeof(vec2));
+                    else if (!element.float_properties.empty())
+                        ok = out.queue(element.float_properties[0].data(), num * sizeof(float));
+                    else
+                        ok = out.queue(element.int_properties[0].data(), num * sizeof(int));
+                    continue;
+                }
+
+                // the general case: interleave the per-instance records (in the same property
+                // order as the rply path) through the staging buffer.
+                for (std::size_t j = 0; j < num && ok; ++j) {
+                    for (std::size_t k = 0; k < element.int_list_properties.size() && ok; ++k) {
+                        const std::vector<int> &values = element.int_list_properties[k][j];
+                        const std::uint32_t count = static_cast<std::uint32_t>(values.size());
+                        ok = out.stage(&count, sizeof(count)) &&
+                             out.stage(values.data(), values.size() * sizeof(int));
+                    }
+                    for (std::size_t k = 0; k < element.float_list_properties.size() && ok; ++k) {
+                        const std::vector<float> &values = element.float_list_properties[k][j];
+                        const std::uint32_t count = static_cast<std::uint32_t>(values.size());
+                        ok = out.stage(&count, sizeof(count)) &&
+                             out.stage(values.data(), values.size() * sizeof(float));
+                    }
+                    for (std::size_t k = 0; k < element.vec3_properties.size() && ok; ++k)
+                        ok = out.stage(&element.vec3_properties[k][j], sizeof(vec3));
+                    for (std::size_t k = 0; k < element.vec2_properties.size() && ok; ++k)
+                        ok = out.stage(&element.vec2_properties[k][j], sizeof(vec2));
+                    for (std::size_t k = 0; k < element.float_properties.size() && ok; ++k)
+                        ok = out.stage(&element.float_properties[k][j], sizeof(float));
+                    for (std::size_t k = 0; k < element.int_properties.size() && ok; ++k)
+                        ok = out.stage(&element.int_properties[k][j], sizeof(int));
+                }
+            }
+
+            ok = ok && out.flush();
+            ::close(fd);
+            LOG_IF(ERROR, !ok) << "failed writing ply file: " << file_name;
+            return ok;
+#endif
+        }
+
+
         PlyReader::~PlyReader() {
             for (auto prop : list_properties_)
                 delete prop;
@@ -320,6 +589,11 @@ namespace easy3d {
 
 
         bool PlyReader::read(const std::string &file_name, std::vector<Element> &elements) {
+            // try the memory-mapped fast path first. It handles binary_little_endian files on
+            // little-endian machines and avoids the per-value callback dispatch of rply.
+            if (read_mapped(file_name, elements))
+                return (elements.size() > 0 && elements[0].num_instances > 0);
+
             p_ply ply = ply_open(file_name.c_str(), nullptr, 0, nullptr);
             if (!ply) {
                 LOG(ERROR) << "failed to open ply file: " << file_name;
@@ -558,6 +832,60 @@ namespace easy3d {
                     return false;
             }
 
+            // extract some standard vec3 properties, e.g., points, normals, colors, texture coords
+            inline void extract_standard_properties(std::vector<Element> &elements) {
+                for (auto &element : elements) {
+                    Vec3Property prop_point("point");
+                    if (details::extract_vector_property(element.float_properties, "x", "y", "z", prop_point) ||
+                        details::extract_vector_property(element.float_properties, "X", "Y", "Z", prop_point)) {
+                        element.vec3_properties.push_back(prop_point);
+                    }
+
+                    Vec2Property prop_texcoord("texcoord");
+                    if (details::extract_vector_property(element.float_properties, "texcoord_x", "texcoord_y", prop_texcoord)) {
+                        element.vec2_properties.push_back(prop_texcoord);
+                    }
+
+                    Vec3Property prop_normal("normal");
+                    if (details::extract_vector_property(element.float_properties, "nx", "ny", "nz", prop_normal)) {
+                        element.vec3_properties.push_back(prop_normal);
+                        // check if the normals are normalized
+                        if (!prop_normal.empty()) {
+                            const float len = length(prop_normal[0]);
+                            LOG_IF(WARNING, std::abs(1.0 - len) > epsilon<float>())
+                                            << "normals (defined on element '" << element.name
+                                            << "') not normalized (length of the first normal vector is " << len << ")";
+                        }
+                    }
+
+                    Vec3Property prop_color("color");
+                    if (details::extract_vector_property(element.float_properties, "r", "g", "b", prop_color))
+                        element.vec3_properties.push_back(prop_color);
+                    else if (details::extract_vector_property(element.int_properties, "red", "green", "blue", prop_color) ||
+                             details::extract_vector_property(element.int_properties, "diffuse_red", "diffuse_green",
+                                                              "diffuse_blue", prop_color)) {
+                        for (std::size_t i = 0; i < prop_color.size(); ++i)
+                            prop_color[i] /= 255.0f;
+                        element.vec3_properties.push_back(prop_color);
+                    }
+
+                    // "alpha" property is stored separately (if exists)
+                    FloatProperty prop_alpha("alpha");
+                    if (details::extract_named_property(element.float_properties, prop_alpha, "a"))
+                        element.float_properties.push_back(prop_alpha);
+
+                    else { // might be in Int format
+                        IntProperty temp("alpha");
+                        if (details::extract_named_property(element.int_properties, temp, "alpha")) {
+                            prop_alpha.resize(temp.size());
+                            for (std::size_t i = 0; i < prop_alpha.size(); ++i)
+                                prop_alpha[i] = temp[i] / 255.0f;
+                            element.float_properties.push_back(prop_alpha);
+                        }
+                    }
+                }
+            }
+
         } // namespace details
 
 
@@ -619,56 +947,347 @@ namespace easy3d {
             }
 
             // extract some standard vec3 properties, e.g., points, normals, colors, texture coords
-            for (auto &element : elements) {
-                Vec3Property prop_point("point");
-                if (details::extract_vector_property(element.float_properties, "x", "y", "z", prop_point) ||
-                    details::extract_vector_property(element.float_properties, "X", "Y", "Z", prop_point)) {
-                    element.vec3_properties.push_back(prop_point);
-                }
-
-                Vec2Property prop_texcoord("texcoord");
-                if (details::extract_vector_property(element.float_properties, "texcoord_x", "texcoord_y", prop_texcoord)) {
-                    element.vec2_properties.push_back(prop_texcoord);
-                }
-
-                Vec3Property prop_normal("normal");
-                if (details::extract_vector_property(element.float_properties, "nx", "ny", "nz", prop_normal)) {
-                    element.vec3_properties.push_back(prop_normal);
-                    // check if the normals are normalized
-                    if (!prop_normal.empty()) {
-                        const float len = length(prop_normal[0]);
-                        LOG_IF(WARNING, std::abs(1.0 - len) > epsilon<float>())
-                                        << "normals (defined on element '" << element.name
-                                        << "') not normalized (length of the first normal vector is " << len << ")";
-                    }
-                }
-
-                Vec3Property prop_color("color");
-                if (details::extract_vector_property(element.float_properties, "r", "g", "b", prop_color))
-                    element.vec3_properties.push_back(prop_color);
-                else if (details::extract_vector_property(element.int_properties, "red", "green", "blue", prop_color) ||
-                         details::extract_vector_property(element.int_properties, "diffuse_red", "diffuse_green",
-                                                          "diffuse_blue", prop_color)) {
-                    for (std::size_t i = 0; i < prop_color.size(); ++i)
-                        prop_color[i] /= 255.0f;
-                    element.vec3_properties.push_back(prop_color);
-                }
-
-                // "alpha" property is stored separately (if exists)
-                FloatProperty prop_alpha("alpha");
-                if (details::extract_named_property(element.float_properties, prop_alpha, "a"))
-                    element.float_properties.push_back(prop_alpha);
-
-                else { // might be in Int format
-                    IntProperty temp("alpha");
-                    if (details::extract_named_property(element.int_properties, temp, "alpha")) {
-                        prop_alpha.resize(temp.size());
-                        for (std::size_t i = 0; i < prop_alpha.size(); ++i)
-                            prop_alpha[i] = temp[i] / 255.0f;
-                        element.float_properties.push_back(prop_alpha);
+            details::extract_standard_properties(elements);
+        }
+
+
+        namespace details {
+
+            // the scalar data types that may appear in a ply file (both names of each type are accepted)
+            enum {
+                PLY_SCALAR_NONE = 0,
+                PLY_SCALAR_INT8, PLY_SCALAR_UINT8,
+                PLY_SCALAR_INT16, PLY_SCALAR_UINT16,
+                PLY_SCALAR_INT32, PLY_SCALAR_UINT32,
+                PLY_SCALAR_FLOAT32, PLY_SCALAR_FLOAT64
+            };
+
+            inline int ply_scalar_type(const std::string &name) {
+                if (name == "char" || name == "int8")       return PLY_SCALAR_INT8;
+                if (name == "uchar" || name == "uint8")     return PLY_SCALAR_UINT8;
+                if (name == "short" || name == "int16")     return PLY_SCALAR_INT16;
+                if (name == "ushort" || name == "uint16")   return PLY_SCALAR_UINT16;
+                if (name == "int" || name == "int32")       return PLY_SCALAR_INT32;
+                if (name == "uint" || name == "uint32")     return PLY_SCALAR_UINT32;
+                if (name == "float" || name == "float32")   return PLY_SCALAR_FLOAT32;
+                if (name == "double" || name == "float64")  return PLY_SCALAR_FLOAT64;
+                return PLY_SCALAR_NONE;
+            }
+
+            inline std::size_t ply_scalar_size(int type) {
+                switch (type) {
+                    case PLY_SCALAR_INT8:
+                    case PLY_SCALAR_UINT8:      return 1;
+                    case PLY_SCALAR_INT16:
+                    case PLY_SCALAR_UINT16:     return 2;
+                    case PLY_SCALAR_INT32:
+                    case PLY_SCALAR_UINT32:
+                    case PLY_SCALAR_FLOAT32:    return 4;
+                    case PLY_SCALAR_FLOAT64:    return 8;
+                    default:                    return 0;
+                }
+            }
+
+            inline bool ply_scalar_is_float(int type) {
+                return (type == PLY_SCALAR_FLOAT32 || type == PLY_SCALAR_FLOAT64);
+            }
+
+            // reads a scalar from a (possibly unaligned) memory location. memcpy avoids the
+            // undefined behavior of dereferencing a misaligned pointer.
+            template<typename T, typename ST>
+            inline T ply_fetch_scalar(const char *data) {
+                ST value;
+                std::memcpy(&value, data, sizeof(ST));
+                return static_cast<T>(value);
+            }
+
+            template<typename T>
+            inline T ply_scalar_value(const char *data, int type) {
+                switch (type) {
+                    case PLY_SCALAR_INT8:       return ply_fetch_scalar<T, std::int8_t>(data);
+                    case PLY_SCALAR_UINT8:      return ply_fetch_scalar<T, std::uint8_t>(data);
+                    case PLY_SCALAR_INT16:      return ply_fetch_scalar<T, std::int16_t>(data);
+                    case PLY_SCALAR_UINT16:     return ply_fetch_scalar<T, std::uint16_t>(data);
+                    case PLY_SCALAR_INT32:      return ply_fetch_scalar<T, std::int32_t>(data);
+                    case PLY_SCALAR_UINT32:     return ply_fetch_scalar<T, std::uint32_t>(data);
+                    case PLY_SCALAR_FLOAT32:    return ply_fetch_scalar<T, float>(data);
+                    case PLY_SCALAR_FLOAT64:    return ply_fetch_scalar<T, double>(data);
+                    default:                    return T(0);
+                }
+            }
+
+            // the per-element data layout described by a ply header
+            struct MappedPlyProperty {
+                std::string name;
+                bool        is_list;
+                int         length_type;    // for list properties only
+                int         value_type;
+            };
+
+            struct MappedPlyElement {
+                std::string name;
+                std::size_t num_instances;
+                std::vector<MappedPlyProperty> properties;
+            };
+
+        } // namespace details
+
+
+        bool PlyReader::read_mapped(const std::string &file_name, std::vector<Element> &elements) const {
+#ifdef _WIN32
+            // no POSIX memory mapping on Windows; the rply-based path is used instead
+            (void) file_name;
+            (void) elements;
+            return false;
+#else
+            // the fast path copies the mapped bytes verbatim, so it requires a little-endian
+            // machine. This is checked only once, i.e., when the file is opened.
+            if (PlyWriter::is_big_endian())
+                return false;
+
+            // parse the (textual) header and remember where the binary payload starts
+            std::ifstream input(file_name.c_str(), std::ios::binary);
+            if (input.fail())
+                return false;
+
+            std::string line;
+            if (!std::getline(input, line) || line.substr(0, 3) != "ply")
+                return false;
+
+            std::vector<details::MappedPlyElement> layout;
+            bool little_endian = false;
+            bool has_end_header = false;
+            while (std::getline(input, line)) {
+                if (!line.empty() && line[line.size() - 1] == '\r')     // headers written on Windows
+                    line.resize(line.size() - 1);
+
+                std::istringstream stream(line);
+                std::string keyword;
+                stream >> keyword;
+                if (keyword == "format") {
+                    std::string format;
+                    stream >> format;
+                    if (format != "binary_little_endian")   // ascii and big-endian take the rply path
+                        return false;
+                    little_endian = true;
+                } else if (keyword == "element") {
+                    details::MappedPlyElement element;
+                    element.num_instances = 0;
+                    stream >> element.name >> element.num_instances;
+                    layout.push_back(element);
+                } else if (keyword == "property") {
+                    if (layout.empty())
+                        return false;
+                    std::string type;
+                    stream >> type;
+                    details::MappedPlyProperty prop;
+                    if (type == "list") {
+                        std::string length_type, value_type;
+                        stream >> length_type >> value_type >> prop.name;
+                        prop.is_list = true;
+                        prop.length_type = details::ply_scalar_type(length_type);
+                        prop.value_type = details::ply_scalar_type(value_type);
+                        if (prop.length_type == details::PLY_SCALAR_NONE ||
+                            prop.value_type == details::PLY_SCALAR_NONE ||
+                            details::ply_scalar_is_float(prop.length_type))
+                            return false;
+                    } else {
+                        stream >> prop.name;
+                        prop.is_list = false;
+                        prop.length_type = details::PLY_SCALAR_NONE;
+                        prop.value_type = details::ply_scalar_type(type);
+                        if (prop.value_type == details::PLY_SCALAR_NONE)
+                            return false;
                     }
+                    layout.back().properties.push_back(prop);
+                } else if (keyword == "comment" || keyword == "obj_info") {
+                    continue;
+                } else if (keyword == "end_header") {
+                    has_end_header = true;
+                    break;
+                } else
+                    return false;   // unknown keyword: let rply report the issue
+            }
+            if (!little_endian || !has_end_header)
+                return false;
+            const std::size_t data_offset = static_cast<std::size_t>(input.tellg());
+            input.close();
+
+            // map the entire file into memory
+            const int fd = ::open(file_name.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < data_offset) {
+                ::close(fd);
+                return false;
+            }
+            const std::size_t file_size = static_cast<std::size_t>(st.st_size);
+            void *mapped = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);    // the mapping keeps its own reference to the file
+            if (mapped == MAP_FAILED)
+                return false;
+
+            const char *data = static_cast<const char *>(mapped) + data_offset;
+            const char *end = static_cast<const char *>(mapped) + file_size;
+
+            elements.clear();
+            bool good = true;
+            for (const auto &desc : layout) {
+                const std::size_t n = desc.num_instances;
+                if (n == 0)
+                    continue;
+
+                Element element(desc.name, n);
+
+                bool fixed_layout = true;
+                std::size_t stride = 0;
+                for (const auto &prop : desc.properties) {
+                    if (prop.is_list) {
+                        fixed_layout = false;
+                        break;
+                    }
+                    stride += details::ply_scalar_size(prop.value_type);
+                }
+
+                if (fixed_layout) {
+                    // homogeneous layout: every instance occupies exactly 'stride' bytes, so each
+                    // property is a column that can be copied in bulk with a constant stride.
+                    if (static_cast<std::size_t>(end - data) < stride * n) {
+                        good = false;
+                        break;
+                    }
+                    std::size_t column_offset = 0;
+                    for (const auto &prop : desc.properties) {
+                        const char *column = data + column_offset;
+                        if (details::ply_scalar_is_float(prop.value_type)) {
+                            FloatProperty values(prop.name);
+                            values.resize(n);
+                            if (prop.value_type == details::PLY_SCALAR_FLOAT32) {
+                                // the most common case: the column holds raw IEEE floats
+                                for (std::size_t i = 0; i < n; ++i)
+                                    std::memcpy(&values[i], column + i * stride, sizeof(float));
+                            } else {
+                                for (std::size_t i = 0; i < n; ++i)
+                                    values[i] = details::ply_scalar_value<float>(column + i * stride, prop.value_type);
+                            }
+                            element.float_properties.push_back(values);
+                        } else {
+                            IntProperty values(prop.name);
+                            values.resize(n);
+                            for (std::size_t i = 0; i < n; ++i)
+                                values[i] = details::ply_scalar_value<int>(column + i * stride, prop.value_type);
+                            element.int_properties.push_back(values);
+                        }
+                        column_offset += details::ply_scalar_size(prop.value_type);
+                    }
+                    data += stride * n;
+                } else {
+                    // variable layout (contains list properties, e.g., the face element): the
+                    // instances are walked with a cursor. Each property writes into a dedicated
+                    // slot so the relative order of the properties is preserved.
+                    struct Slot {
+                        int kind;           // 0: float, 1: int, 2: float list, 3: int list
+                        std::size_t index;  // index into the corresponding property vector
+                    };
+                    std::vector<Slot> slots;
+                    for (const auto &prop : desc.properties) {
+                        Slot slot;
+                        if (prop.is_list) {
+                            if (details::ply_scalar_is_float(prop.value_type)) {
+                                slot.kind = 2;
+                                slot.index = element.float_list_properties.size();
+                                element.float_list_properties.push_back(FloatListProperty(prop.name));
+                                element.float_list_properties.back().resize(n);
+                            } else {
+                                slot.kind = 3;
+                                slot.index = element.int_list_properties.size();
+                                element.int_list_properties.push_back(IntListProperty(prop.name));
+                                element.int_list_properties.back().resize(n);
+                            }
+                        } else {
+                            if (details::ply_scalar_is_float(prop.value_type)) {
+                                slot.kind = 0;
+                                slot.index = element.float_properties.size();
+                                element.float_properties.push_back(FloatProperty(prop.name));
+                                element.float_properties.back().resize(n);
+                            } else {
+                                slot.kind = 1;
+                                slot.index = element.int_properties.size();
+                                element.int_properties.push_back(IntProperty(prop.name));
+                                element.int_properties.back().resize(n);
+                            }
+                        }
+                        slots.push_back(slot);
+                    }
+
+                    const char *cursor = data;
+                    for (std::size_t i = 0; i < n && good; ++i) {
+                        for (std::size_t p = 0; p < desc.properties.size(); ++p) {
+                            const auto &prop = desc.properties[p];
+                            const Slot &slot = slots[p];
+                            if (prop.is_list) {
+                                const std::size_t length_size = details::ply_scalar_size(prop.length_type);
+                                if (static_cast<std::size_t>(end - cursor) < length_size) {
+                                    good = false;
+                                    break;
+                                }
+                                const int length = details::ply_scalar_value<int>(cursor, prop.length_type);
+                                cursor += length_size;
+                                const std::size_t value_size = details::ply_scalar_size(prop.value_type);
+                                if (length < 0 ||
+                                    static_cast<std::size_t>(end - cursor) < value_size * length) {
+                                    good = false;
+                                    break;
+                                }
+                                if (slot.kind == 2) {
+                                    auto &entry = element.float_list_properties[slot.index][i];
+                                    entry.resize(length);
+                                    for (int j = 0; j < length; ++j)
+                                        entry[j] = details::ply_scalar_value<float>(cursor + j * value_size, prop.value_type);
+                                } else {
+                                    auto &entry = element.int_list_properties[slot.index][i];
+                                    entry.resize(length);
+                                    for (int j = 0; j < length; ++j)
+                                        entry[j] = details::ply_scalar_value<int>(cursor + j * value_size, prop.value_type);
+                                }
+                                cursor += value_size * length;
+                            } else {
+                                const std::size_t value_size = details::ply_scalar_size(prop.value_type);
+                                if (static_cast<std::size_t>(end - cursor) < value_size) {
+                                    good = false;
+                                    break;
+                                }
+                                if (slot.kind == 0)
+                                    element.float_properties[slot.index][i] =
+                                            details::ply_scalar_value<float>(cursor, prop.value_type);
+                                else
+                                    element.int_properties[slot.index][i] =
+                                            details::ply_scalar_value<int>(cursor, prop.value_type);
+                                cursor += value_size;
+                            }
+                        }
+                    }
+                    if (!good)
+                        break;
+                    data = cursor;
                 }
+
+                elements.push_back(element);
+            }
+
+            ::munmap(mapped, file_size);
+
+            if (!good) {
+                // truncated or inconsistent payload: discard and fall back to the rply path
+                elements.clear();
+                return false;
             }
+
+            // extract some standard vec3 properties, e.g., points, normals, colors, texture coords
+            details::extract_standard_properties(elements);
+            return !elements.empty();
+#endif
         }
 
     } // namespace io
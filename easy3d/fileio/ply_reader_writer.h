@@ -110,6 +110,15 @@ namespace easy3d {
 			// Meanwhile, convert the "list" intermediate representation into the user requested format.
 			void collect_elements(std::vector<Element>& elements) const;
 
+			// A memory-mapped fast path for binary_little_endian files read on little-endian machines.
+			// The file is mapped into memory and the property data is copied in bulk (strided column
+			// copies for elements with a fixed per-instance layout) directly into the element property
+			// arrays, bypassing the per-value rply callbacks. The endianness is checked once when the
+			// file is opened. Returns false if the file does not qualify (ASCII or big-endian format,
+			// unknown property types, or mapping not available), in which case the caller falls back
+			// to the generic rply-based implementation.
+			bool read_mapped(const std::string& file_name, std::vector<Element>& elements) const;
+
 		private:
             // For simpler code, it is possible to save all data as properties of type PLY_LIST with value type double.
             // This can allow us to use a single callback function to handle all the properties. However, the
@@ -157,6 +166,15 @@ namespace easy3d {
 
 			/// returns endianness of the system.
 			static bool is_big_endian();
+
+        private:
+            /// The gathered fast path for binary_little_endian files. Instead of pushing every
+            /// scalar through the per-value rply callback, it queues large slices of the
+            /// property arrays (and staged interleaved records) directly to the OS with
+            /// scatter/gather I/O. Returns false if this platform/file cannot take the fast
+            /// path, in which case the caller falls back to rply.
+            bool write_gathered(const std::string& file_name, const std::vector<Element>& elements,
+                                const std::string& comment) const;
 		};
 
 	} // namespace io
@@ -56,6 +56,8 @@ namespace easy3d {
 			success = io::load_bxyz(file_name, cloud);
 		else if (ext == "las" || ext == "laz")
 			success = io::load_las(file_name, cloud);
+		else if (ext == "e3d")
+			success = io::load_e3d(file_name, cloud);
         else if (ext == "vg")
             success = io::PointCloudIO_vg::load_vg(file_name, cloud);
         else if (ext == "bvg")
@@ -113,6 +115,8 @@ namespace easy3d {
             success = io::save_bxyz(final_name, cloud);
 		else if (ext == "las" || ext == "laz")
             success = io::save_las(final_name, cloud);
+		else if (ext == "e3d")
+            success = io::save_e3d(final_name, cloud);
         else if (ext == "vg")
             success = io::PointCloudIO_vg::save_vg(file_name, cloud);
         else if (ext == "bvg")
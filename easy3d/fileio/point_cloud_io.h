@@ -96,6 +96,14 @@ namespace easy3d {
         /// \brief Saves a point cloud to an \c las/laz format file.
         /// \details Internally it uses the LASlib of martin.isenburg@rapidlasso.com. See http://rapidlasso.com
 		bool save_las(const std::string& file_name, const PointCloud* cloud);
+
+        /// \brief Reads point cloud from an \c e3d cache file (the native binary cache format).
+		bool load_e3d(const std::string& file_name, PointCloud* cloud);
+        /// \brief Saves a point cloud to an \c e3d cache file (the native binary cache format).
+        /// \details The property arrays are dumped verbatim, so reloading the cloud is a single
+        /// sequential read. The files are machine specific (native byte order) and not intended
+        /// for data exchange.
+		bool save_e3d(const std::string& file_name, const PointCloud* cloud);
 	};
 
 
@@ -24,8 +24,16 @@
 
 #include <easy3d/fileio/point_cloud_io.h>
 
+#include <cstring>
 #include <fstream>
 
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <easy3d/core/point_cloud.h>
 
 
@@ -34,9 +42,98 @@ namespace easy3d {
 
 	namespace io {
 
+#ifndef WIN32
+
+		namespace details {
+			// \cond
+
+			// Reads the three blocks from a read-only mapping of the whole file. The kernel pages the
+			// data in lazily while the blocks are bulk-copied into the properties, which avoids the
+			// user-space buffering of stream I/O and lets the block sizes be validated against the real
+			// file size up front. Returns false (without logging) if the file cannot be mapped or is
+			// malformed; the caller then falls back to the stream reader.
+			bool load_bin_mapped(const std::string& file_name, PointCloud* cloud) {
+				const int fd = ::open(file_name.c_str(), O_RDONLY);
+				if (fd < 0)
+					return false;
+
+				struct stat st;
+				if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(int))) {
+					::close(fd);
+					return false;
+				}
+				const std::size_t size = static_cast<std::size_t>(st.st_size);
+
+				char* data = static_cast<char*>(::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+				::close(fd);	// the mapping keeps the file referenced
+				if (data == MAP_FAILED)
+					return false;
+#ifdef POSIX_MADV_SEQUENTIAL
+				::posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+				const char* ptr = data;
+				const char* end = data + size;
+				auto read_count = [&](int& n) -> bool {
+					if (ptr + sizeof(int) > end)
+						return false;
+					std::memcpy(&n, ptr, sizeof(int));
+					ptr += sizeof(int);
+					return true;
+				};
+				auto read_vec3s = [&](vec3* dst, int n) -> bool {
+					if (ptr + n * sizeof(vec3) > end)
+						return false;
+					std::memcpy(dst, ptr, n * sizeof(vec3));
+					ptr += n * sizeof(vec3);
+					return true;
+				};
+
+				int num = 0;
+				bool ok = read_count(num) && num > 0;
+				if (ok) {
+					cloud->resize(num);
+					auto points = cloud->vertex_property<vec3>("v:point");
+					ok = read_vec3s(points.data(), num);
+				}
+
+				int num_colors = 0;
+				if (ok && read_count(num_colors) && num_colors > 0) {
+					auto colors = cloud->vertex_property<vec3>("v:color");
+					ok = (num_colors == num) && read_vec3s(colors.data(), num_colors);
+				}
+
+				int num_normals = 0;
+				if (ok && read_count(num_normals) && num_normals > 0) {
+					auto normals = cloud->vertex_property<vec3>("v:normal");
+					ok = (num_normals == num) && read_vec3s(normals.data(), num_normals);
+					if (ok) {
+						// check if the normals are normalized
+						const float len = length(normals[PointCloud::Vertex(0)]);
+						LOG_IF(WARNING, std::abs(1.0 - len) > epsilon<float>())
+										<< "normals not normalized (length of the first normal vector is " << len << ")";
+					}
+				}
+
+				::munmap(data, size);
+				return ok;
+			}
+
+			// \endcond
+		} // namespace details
+
+#endif // !WIN32
+
 
 		// three blocks storing points, colors (optional), and normals (optional)
 		bool load_bin(const std::string& file_name, PointCloud* cloud) {
+#ifndef WIN32
+			// fast path: map the file and bulk-copy the blocks (see details::load_bin_mapped())
+			if (details::load_bin_mapped(file_name, cloud))
+				return true;
+			cloud->clear();
+			// fall through to the stream reader, which reports what went wrong
+#endif
 			std::ifstream input(file_name.c_str(), std::fstream::binary);
 			if (input.fail()) {
                 LOG(ERROR) << "could not open file: " << file_name;
@@ -23,12 +23,17 @@
  */
 
 #include <easy3d/fileio/point_cloud_io.h>
+#include <easy3d/fileio/point_cloud_io_las.h>
 
 #include <cassert>
 #include <algorithm>
+#include <cfloat>   // for DBL_EPSILON, FLT_MIN
 #include <climits>  // for USHRT_MAX
 
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/progress.h>
+#include <easy3d/util/thread_pool.h>
 #include <3rd_party/LAStools/LASlib/inc/lasreader.hpp>
 #include <3rd_party/LAStools/LASlib/inc/laswriter.hpp>
 
@@ -39,83 +44,165 @@ namespace easy3d {
 	namespace io {
 
 
-		bool load_las(const std::string& file_name, PointCloud* cloud)
+		// appends the current point of the reader to the cloud, with the coordinates
+		// relative to the first point (x0, y0, z0) of the file.
+		static void add_las_point(PointCloud* cloud,
+								  PointCloud::VertexProperty<vec3> colors,
+								  PointCloud::VertexProperty<int> classification,
+								  LASpoint& p, double x0, double y0, double z0)
 		{
-			LASreadOpener lasreadopener;
-			lasreadopener.set_file_name(file_name.c_str(), true);
+			// compute the actual coordinates as double floating point values
+			p.compute_coordinates();
+			double x = p.coordinates[0] - x0;
+			double y = p.coordinates[1] - y0;
+			double z = p.coordinates[2] - z0;
 
-			LASreader* lasreader = lasreadopener.open();
-			if (!lasreader || lasreader->npoints <= 0) {
-                LOG(ERROR) << "could not open file: " << file_name;
-				lasreader->close();
-				delete lasreader;
-				return false;
+			float r, g, b;
+			if (p.have_rgb) { // some file may have rgb
+				r = float(p.get_R()) / USHRT_MAX;
+				g = float(p.get_G()) / USHRT_MAX;
+				b = float(p.get_B()) / USHRT_MAX;
 			}
+			else // in case color doesn't exist, use intensity
+				r = g = b = p.intensity % 255 / 255.0f;
+
+			PointCloud::Vertex v = cloud->add_vertex(vec3(float(x), float(y), float(z)));
+			colors[v] = vec3(r, g, b);
+			classification[v] = p.classification;
+		}
+
+
+		PointCloudIO_las::PointCloudIO_las(const std::string& file_name, std::size_t chunk_size)
+			: file_name_(file_name)
+			, chunk_size_(chunk_size)
+			, reader_(nullptr)
+			, next_index_(0)
+			, x0_(0), y0_(0), z0_(0)
+		{
+		}
+
+
+		PointCloudIO_las::~PointCloudIO_las()
+		{
+			if (reader_) {
+				reader_->close();
+				delete reader_;
+			}
+		}
 
-			std::size_t num = lasreader->npoints;
-			LOG(INFO) << "reading " << num << " points...";
 
-			// read the first point
-			if (!lasreader->read_point()) {
+		bool PointCloudIO_las::open()
+		{
+			if (reader_)
+				return true;
+
+			LASreadOpener lasreadopener;
+			lasreadopener.set_file_name(file_name_.c_str(), true);
+
+			reader_ = lasreadopener.open();
+			if (!reader_ || reader_->npoints <= 0) {
+				LOG(ERROR) << "could not open file: " << file_name_;
+				if (reader_) {
+					reader_->close();
+					delete reader_;
+					reader_ = nullptr;
+				}
+				return false;
+			}
+
+			// Liangliang: las format usually represent very large area of urban scenes and some coordinates
+			//			   may have very large values. In order to render the points properly in OpenGL, I
+			//			   record the relative positions to the first point stored in the file.
+			if (!reader_->read_point()) {
 				LOG(ERROR) << "failed reading point";
-				lasreader->close();
-				delete lasreader;
+				reader_->close();
+				delete reader_;
+				reader_ = nullptr;
 				return false;
 			}
+			reader_->point.compute_coordinates();
+			x0_ = reader_->point.coordinates[0];
+			y0_ = reader_->point.coordinates[1];
+			z0_ = reader_->point.coordinates[2];
+			LOG(INFO) << "first point (" << x0_ << " " << y0_ << " " << z0_ << ")";
+
+			reader_->seek(0);
+			return true;
+		}
+
+
+		std::size_t PointCloudIO_las::num_points()
+		{
+			if (!open())
+				return 0;
+			return static_cast<std::size_t>(reader_->npoints);
+		}
+
+
+		PointCloud* PointCloudIO_las::load_preview(std::size_t num)
+		{
+			if (!open())
+				return nullptr;
+
+			const long long total = reader_->npoints;
+			const long long stride = std::max<long long>(1, total / static_cast<long long>(num));
 
+			PointCloud* cloud = new PointCloud;
 			PointCloud::VertexProperty<vec3> colors = cloud->add_vertex_property<vec3>("v:color");
 			PointCloud::VertexProperty<int>  classification = cloud->add_vertex_property<int>("v:classification");
 
-			// Liangliang: las format usually represent very large area of urban scenes and some coordinates
-			//			   may have very large values. In order to render the points properly in OpenGL, I
-			//			   record the relative positions to the first point stored in the file.
-			LASpoint& p0 = lasreader->point;
-			float r, g, b;
-			if (p0.have_rgb) { // some file may have rgb
-				r = float(p0.get_R()) / USHRT_MAX;
-				g = float(p0.get_G()) / USHRT_MAX;
-				b = float(p0.get_B()) / USHRT_MAX;
+			// seeking lets the preview skip most of the file, so it is ready long before the
+			// full-resolution data (LAZ files decompress at chunk granularity, still far less
+			// work than decoding every point).
+			for (long long i = 0; i < total; i += stride) {
+				if (!reader_->seek(i) || !reader_->read_point())
+					break;
+				add_las_point(cloud, colors, classification, reader_->point, x0_, y0_, z0_);
 			}
-			else // in case color doesn't exist, use intensity
-				r = g = b = p0.intensity % 255 / 255.0f;
+			LOG(INFO) << "preview of " << cloud->n_vertices() << " points (out of " << total << ")";
 
-			PointCloud::Vertex v = cloud->add_vertex(vec3(0, 0, 0));
-			colors[v] = vec3(r, g, b);
-			classification[v] = p0.classification;
+			// the preview does not consume the stream
+			reader_->seek(next_index_);
+			return cloud;
+		}
 
-			// compute the actual coordinates as double floating point values
-			p0.compute_coordinates();
-			double x0 = p0.coordinates[0];
-			double y0 = p0.coordinates[1];
-			double z0 = p0.coordinates[2];
-			LOG(INFO) << "first point (" << x0 << " " << y0 << " " << z0 << ")";
-
-			// now we read the remaining points...
-			while (lasreader->read_point()) {
-				LASpoint& p = lasreader->point;
-
-				// compute the actual coordinates as double floating point values
-				p.compute_coordinates();
-				double x = p.coordinates[0] - x0;
-				double y = p.coordinates[1] - y0;
-				double z = p.coordinates[2] - z0;
-
-				float r, g, b;
-				if (p.have_rgb) { // some file may have rgb
-					r = float(p.get_R()) / USHRT_MAX;
-					g = float(p.get_G()) / USHRT_MAX;
-					b = float(p.get_B()) / USHRT_MAX;
-				}
-				else // in case color doesn't exist, use intensity
-					r = g = b = p.intensity % 255 / 255.0f;
 
-				v = cloud->add_vertex(vec3(float(x), float(y), float(z)));
-				colors[v] = vec3(r, g, b);
-				classification[v] = p.classification;
+		std::size_t PointCloudIO_las::load_next(PointCloud* cloud)
+		{
+			if (!cloud) {
+				LOG(ERROR) << "null input point cloud pointer";
+				return 0;
 			}
+			if (!open())
+				return 0;
+			if (next_index_ >= reader_->npoints)
+				return 0;
+
+			PointCloud::VertexProperty<vec3> colors = cloud->vertex_property<vec3>("v:color");
+			PointCloud::VertexProperty<int>  classification = cloud->vertex_property<int>("v:classification");
 
-			lasreader->close();
-			delete lasreader;
+			if (!reader_->seek(next_index_))
+				return 0;
+
+			std::size_t count = 0;
+			while (count < chunk_size_ && reader_->read_point()) {
+				add_las_point(cloud, colors, classification, reader_->point, x0_, y0_, z0_);
+				++count;
+			}
+			next_index_ += count;
+			return count;
+		}
+
+
+		bool load_las(const std::string& file_name, PointCloud* cloud)
+		{
+			PointCloudIO_las stream(file_name);
+			const std::size_t num = stream.num_points();
+			if (num == 0)
+				return false;
+			LOG(INFO) << "reading " << num << " points...";
+
+			while (stream.load_next(cloud) > 0) {}
 			return cloud->n_vertices() > 0;
 		}
 
@@ -178,7 +265,7 @@ namespace easy3d {
 				lasheader.point_data_record_length = 28;
 			}
 
-			// init point 
+			// init point
 			LASpoint laspoint;
 			laspoint.init(&lasheader, lasheader.point_data_format, lasheader.point_data_record_length, 0);
 
@@ -189,23 +276,71 @@ namespace easy3d {
 				return false;
 			}
 
-			// write points
-			if (colors) {
-				for (auto v : cloud->vertices()) {
-					const vec3& p = points[v];
-					laspoint.coordinates[0] = p[0];
-					laspoint.coordinates[1] = p[1];
-					laspoint.coordinates[2] = p[2];
-
-					// populate the point
-					laspoint.compute_XYZ();
-
-					const vec3& c = colors[v];
-					laspoint.set_R(static_cast<unsigned short>(c[0] * USHRT_MAX));
-					laspoint.set_G(static_cast<unsigned short>(c[1] * USHRT_MAX));
-					laspoint.set_B(static_cast<unsigned short>(c[2] * USHRT_MAX));
+			// The cloud is consumed in chunks through a two-buffer pipeline: while the writer
+			// thread feeds the current chunk to LASlib (which does the LAZ compression and the
+			// disk writes), the next chunk is quantized on the worker threads. Compressing the
+			// chunks themselves in parallel is not possible with LASlib - its arithmetic coder
+			// is sequential within one stream - but the quantization is a good third of the
+			// export cost, and overlapping it keeps the compressor busy. The chunk boundaries
+			// also give the export its cancellation points, so it can run on a background
+			// thread and be aborted from the GUI at any time.
+			struct LasRecord {
+				I32 X, Y, Z;
+				U16 R, G, B;
+				U16 intensity;
+			};
+			const std::size_t num = cloud->n_vertices();
+			const std::size_t chunk_size = 1024 * 1024;
+			const float height = std::max<float>(box.range(2), FLT_MIN);
+
+			// quantizes the points [begin, begin + size) of the cloud into records
+			auto prepare = [&](std::size_t begin, std::size_t size, std::vector<LasRecord>& records) {
+				records.resize(size);
+				ThreadPool::global().parallel_for(0, size, [&](std::size_t i) {
+					const vec3& p = points[PointCloud::Vertex(static_cast<int>(begin + i))];
+					LasRecord& r = records[i];
+					r.X = lasheader.get_X(p[0]);
+					r.Y = lasheader.get_Y(p[1]);
+					r.Z = lasheader.get_Z(p[2]);
+					if (colors) {
+						const vec3& c = colors[PointCloud::Vertex(static_cast<int>(begin + i))];
+						r.R = static_cast<U16>(c[0] * USHRT_MAX);
+						r.G = static_cast<U16>(c[1] * USHRT_MAX);
+						r.B = static_cast<U16>(c[2] * USHRT_MAX);
+					}
+					else // if the model doesn't have color, I store the height values as the intensity
+						r.intensity = static_cast<U16>((p[2] - box.min(2)) / height * 255);
+				});
+			};
+
+			ProgressLogger progress(num);
+			std::vector<LasRecord> current, next;
+			prepare(0, std::min(chunk_size, num), current);
+
+			bool canceled = false;
+			for (std::size_t begin = 0; begin < num && !canceled; begin += chunk_size) {
+				// the next chunk is prepared while this one is compressed and written
+				const std::size_t next_begin = begin + chunk_size;
+				if (next_begin < num) {
+					const std::size_t next_size = std::min(chunk_size, num - next_begin);
+					ThreadPool::global().run([&prepare, &next, next_begin, next_size]() {
+						prepare(next_begin, next_size, next);
+					});
+				}
 
-					laspoint.set_gps_time(0.0006 * v.idx());
+				for (std::size_t i = 0; i < current.size(); ++i) {
+					const LasRecord& r = current[i];
+					laspoint.set_X(r.X);
+					laspoint.set_Y(r.Y);
+					laspoint.set_Z(r.Z);
+					if (colors) {
+						laspoint.set_R(r.R);
+						laspoint.set_G(r.G);
+						laspoint.set_B(r.B);
+					}
+					else
+						laspoint.set_intensity(r.intensity);
+					laspoint.set_gps_time(0.0006 * (begin + i));
 
 					// write the point
 					laswriter->write_point(&laspoint);
@@ -213,28 +348,12 @@ namespace easy3d {
 					// add it to the inventory
 					laswriter->update_inventory(&laspoint);
 				}
-			}
-			else {
-				// if the model doesn't have color, I store the height values as the intensity
-				const Box3& box = cloud->bounding_box();
-                const float ht = box.range(2);
-				for (auto v : cloud->vertices()) {
-					const vec3& p = points[v];
-					laspoint.coordinates[0] = p[0];
-					laspoint.coordinates[1] = p[1];
-					laspoint.coordinates[2] = p[2];
-
-					// populate the point
-					laspoint.compute_XYZ();
-                    laspoint.set_intensity(static_cast<unsigned short>((p[2] - box.min(2)) / ht * 255));
-					laspoint.set_gps_time(0.0006 * v.idx());
 
-					// write the point
-					laswriter->write_point(&laspoint);
+				ThreadPool::global().wait();
+				current.swap(next);
 
-					// add it to the inventory
-					laswriter->update_inventory(&laspoint);
-				}
+				canceled = progress.is_canceled();
+				progress.notify(std::min(next_begin, num));
 			}
 
 			// update the header
@@ -242,10 +361,18 @@ namespace easy3d {
 
 			// close the writer
 			I64 total_bytes = laswriter->close();
-			LOG(INFO) << total_bytes << " bytes for " << laswriter->npoints << " points";
+			const I64 num_written = laswriter->npoints;
 			delete laswriter;
 
-			return laswriter->npoints > 0;
+			if (canceled) {
+				// a partial LAS/LAZ file is of no use - discard it
+				file_system::delete_file(file_name);
+				LOG(INFO) << "saving canceled (" << num_written << " of " << num << " points written)";
+				return false;
+			}
+
+			LOG(INFO) << total_bytes << " bytes for " << num_written << " points";
+			return num_written > 0;
 		}
 
 	}
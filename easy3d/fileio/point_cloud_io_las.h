@@ -0,0 +1,102 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_FILEIO_POINT_CLOUD_IO_LAS_H
+#define EASY3D_FILEIO_POINT_CLOUD_IO_LAS_H
+
+#include <string>
+
+class LASreader;
+
+namespace easy3d {
+
+	class PointCloud;
+
+	namespace io {
+
+		/**
+		 * \brief Streaming reader for LiDAR point clouds in LAS/LAZ format (based on LASlib).
+		 * \class PointCloudIO_las easy3d/fileio/point_cloud_io_las.h
+		 *
+		 * \details In contrast to load_las(), which materializes the entire point cloud before
+		 * returning, this class emits the points in chunks, and it can first deliver a
+		 * constant-size evenly sampled preview of the cloud. This way an application can show
+		 * the cloud (almost) immediately and progressively refine it while the full-resolution
+		 * data is still being read (e.g., on a background thread).
+		 *
+		 * As in load_las(), all coordinates are stored relative to the first point of the file,
+		 * so the preview and the full-resolution cloud live in the same local frame.
+		 *
+		 * Example usage:
+		 *      \code
+		 *		PointCloudIO_las stream(file_name);
+		 *		PointCloud* preview = stream.load_preview();  // show this one right away
+		 *		PointCloud* cloud = new PointCloud;
+		 *		while (stream.load_next(cloud) > 0) {
+		 *			// show the growing cloud (and discard the preview once done)
+		 *		}
+		 *		\endcode
+		 */
+
+		class PointCloudIO_las
+		{
+		public:
+			/// \param file_name The name of the LAS/LAZ file to read.
+			/// \param chunk_size The (maximum) number of points delivered by each load_next() call.
+			PointCloudIO_las(const std::string& file_name, std::size_t chunk_size = 4 * 1024 * 1024);
+			~PointCloudIO_las();
+
+			/// \brief The total number of points in the file (0 if the file could not be opened).
+			std::size_t num_points();
+
+			/// \brief Reads an evenly sampled preview of (at most) \p num points.
+			/// \details The sample is taken with a constant stride over the whole file, so it
+			///          covers the full extent of the cloud. Reading it does not consume the
+			///          stream: subsequent load_next() calls still deliver every point.
+			/// \return The preview cloud (nullptr if the file could not be opened).
+			PointCloud* load_preview(std::size_t num = 2 * 1024 * 1024);
+
+			/// \brief Reads the next chunk of points and appends them to \p cloud.
+			/// \return The number of points appended (0 when the whole file has been read).
+			std::size_t load_next(PointCloud* cloud);
+
+		private:
+			bool open();
+
+		private:
+			std::string		file_name_;
+			std::size_t		chunk_size_;
+
+			LASreader*		reader_;
+			long long		next_index_;	// index of the first point of the next chunk
+
+			// the coordinates of the first point of the file (the local frame origin)
+			double			x0_, y0_, z0_;
+		};
+
+	} // namespace io
+
+} // namespace easy3d
+
+#endif  // EASY3D_FILEIO_POINT_CLOUD_IO_LAS_H
@@ -25,7 +25,10 @@
 #include <easy3d/fileio/point_cloud_io_ptx.h>
 
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <vector>
 
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/util/file_system.h>
@@ -195,6 +198,224 @@ namespace easy3d {
 			}
 		}
 
+
+		PointCloud* PointCloudIO_ptx::load_all() {
+			std::ifstream input(file_name_.c_str(), std::fstream::binary);
+			if (input.fail()) {
+				LOG(ERROR) << "could not open file: " << file_name_;
+				return nullptr;
+			}
+
+			// get length of file
+			input.seekg(0, input.end);
+			std::streamoff length = input.tellg();
+			input.seekg(0, input.beg);
+			if (length <= 0)
+				return nullptr;
+
+			// read the entire file into memory. Parsing from a single buffer allows the scan
+			// blocks to be decoded in parallel.
+			const std::size_t data_size = static_cast<std::size_t>(length);
+			std::vector<char> buffer(data_size + 1);
+			input.read(buffer.data(), length);
+			buffer[data_size] = '\0';   // so strtof() never runs past the end of the buffer
+			input.close();
+
+			// the byte range, point count, and registration matrix of one scan
+			struct Scan {
+				std::size_t begin;
+				std::size_t end;
+				unsigned int num;
+				mat4 trans;
+			};
+
+			//--------------------------------------------------------------------------
+			// pass 1 (sequential): parse the per-scan headers and locate the scan blocks.
+			// Only the line structure of the blocks is inspected here (a memchr() walk);
+			// the expensive number parsing is left to the parallel pass.
+
+			const char* data = buffer.data();
+			std::size_t pos = 0;
+			auto next_line = [&](const char*& line, const char*& line_end) -> bool {
+				if (pos >= data_size)
+					return false;
+				line = data + pos;
+				const char* nl = static_cast<const char*>(std::memchr(line, '\n', data_size - pos));
+				line_end = nl ? nl : data + data_size;
+				pos = static_cast<std::size_t>(line_end - data) + 1;
+				return true;
+			};
+			// parses up to 'wanted' floats from one line; returns the number actually parsed
+			auto parse_floats = [](const char* line, const char* line_end, float* values, int wanted) -> int {
+				int count = 0;
+				const char* cursor = line;
+				while (count < wanted) {
+					char* parse_end = nullptr;
+					const float value = std::strtof(cursor, &parse_end);
+					// strtof() skips leading whitespace (including newlines), so reject
+					// values that were actually taken from the next line
+					if (parse_end == cursor || parse_end > line_end)
+						break;
+					values[count++] = value;
+					cursor = parse_end;
+				}
+				return count;
+			};
+
+			std::vector<Scan> scans;
+			while (pos < data_size) {
+				const char *line, *line_end;
+
+				// the two count lines
+				if (!next_line(line, line_end))
+					break;
+				char* parse_end = nullptr;
+				const unsigned long height = std::strtoul(line, &parse_end, 10);
+				if (parse_end == line)  // tolerate trailing blank lines
+					continue;
+				unsigned long width = 0;
+				if (next_line(line, line_end))
+					width = std::strtoul(line, &parse_end, 10);
+				if (height == 0 || width == 0) {
+					LOG_IF(ERROR, !scans.empty()) << "failed reading the header of scan #" << scans.size();
+					LOG_IF(ERROR, scans.empty()) << "unrecognized file format: height == 0 || width == 0";
+					break;
+				}
+
+				Scan scan;
+				scan.num = static_cast<unsigned int>(width * height);
+
+				// skip the sensor position/axes (unused, as in load_next())
+				for (int i = 0; i < 4; ++i)
+					next_line(line, line_end);
+
+				// read the cloud transformation matrix (transposed in the file, i.e., the
+				// last row is the translation)
+				vec4 v4[4];
+				bool ok = true;
+				for (int i = 0; i < 4 && ok; ++i)
+					ok = next_line(line, line_end) && parse_floats(line, line_end, v4[i], 4) == 4;
+				if (!ok) {
+					LOG(ERROR) << "failed reading the transformation matrix of scan #" << scans.size();
+					break;
+				}
+				scan.trans = mat4(v4[0], v4[1], v4[2], v4[3]);
+
+				// locate the end of the scan block (exactly 'num' lines)
+				scan.begin = pos;
+				unsigned int remaining = scan.num;
+				while (remaining > 0 && pos < data_size) {
+					const char* nl = static_cast<const char*>(std::memchr(data + pos, '\n', data_size - pos));
+					pos = nl ? static_cast<std::size_t>(nl - data) + 1 : data_size;
+					--remaining;
+				}
+				scan.end = pos;
+				if (remaining > 0) {
+					LOG(WARNING) << "scan #" << scans.size() << " is truncated ("
+								 << remaining << " of its " << scan.num << " points are missing)";
+					scan.num -= remaining;
+				}
+				scans.push_back(scan);
+			}
+
+			if (scans.empty())
+				return nullptr;
+
+			//--------------------------------------------------------------------------
+			// pass 2 (parallel): decode the scan blocks, applying the per-scan transformation
+
+			const int num_scans = static_cast<int>(scans.size());
+			LOG(INFO) << "loading " << num_scans << " sub scans of "
+					  << file_system::simple_name(file_name_) << "...";
+
+			std::vector< std::vector<vec3> > scan_points(num_scans);
+			std::vector< std::vector<vec3> > scan_colors(num_scans);
+			ProgressLogger progress(num_scans);
+			int num_done = 0;
+
+#pragma omp parallel for schedule(dynamic)
+			for (int s = 0; s < num_scans; ++s) {
+				const Scan& scan = scans[s];
+				const char* p = data + scan.begin;
+				const char* scan_end = data + scan.end;
+				std::vector<vec3>& points = scan_points[s];
+				std::vector<vec3>& colors = scan_colors[s];
+				points.reserve(scan.num);
+
+				// whether this scan has color is decided by its first point line
+				bool first = true;
+				bool has_color = false;
+				while (p < scan_end) {
+					const char* line_end = static_cast<const char*>(std::memchr(p, '\n', scan_end - p));
+					if (!line_end)
+						line_end = scan_end;
+
+					float values[7];    // x y z intensity [r g b]
+					const int count = parse_floats(p, line_end, values, 7);
+					if (first) {
+						has_color = (count >= 7);
+						if (has_color)
+							colors.reserve(scan.num);
+						first = false;
+					}
+					if (count >= 3) {
+						points.push_back(scan.trans * vec3(values[0], values[1], values[2]));
+						if (has_color) {
+							if (count >= 7)
+								colors.push_back(vec3(values[4], values[5], values[6]) / 255.0f);
+							else    // (0, 0, 0) is the reserved "no color" value
+								colors.push_back(vec3(0.0f, 0.0f, 0.0f));
+						}
+					}
+
+					p = line_end + 1;
+				}
+
+#pragma omp critical
+				{
+					progress.notify(++num_done);
+				}
+			}
+
+			//--------------------------------------------------------------------------
+			// concatenate the scans into preallocated ranges of a single cloud
+
+			std::size_t total = 0;
+			bool has_colors = false;
+			for (int s = 0; s < num_scans; ++s) {
+				total += scan_points[s].size();
+				has_colors = has_colors || !scan_colors[s].empty();
+			}
+			if (total == 0)
+				return nullptr;
+
+			PointCloud* cloud = new PointCloud;
+			cloud->set_name(file_system::name_less_extension(file_name_));
+			cloud->resize(static_cast<unsigned int>(total));
+
+			PointCloud::VertexProperty<vec3> points = cloud->get_vertex_property<vec3>("v:point");
+			std::size_t offset = 0;
+			for (int s = 0; s < num_scans; ++s) {
+				std::memcpy(points.data() + offset, scan_points[s].data(), scan_points[s].size() * sizeof(vec3));
+				offset += scan_points[s].size();
+			}
+
+			if (has_colors) {
+				// scans without color keep the default (0, 0, 0), i.e., "no color"
+				PointCloud::VertexProperty<vec3> colors = cloud->add_vertex_property<vec3>("v:color");
+				offset = 0;
+				for (int s = 0; s < num_scans; ++s) {
+					if (!scan_colors[s].empty())
+						std::memcpy(colors.data() + offset, scan_colors[s].data(),
+									scan_colors[s].size() * sizeof(vec3));
+					offset += scan_points[s].size();
+				}
+			}
+
+			LOG(INFO) << "loaded " << total << " points from " << num_scans << " sub scans";
+			return cloud;
+		}
+
 	} // namespace io
 
 } // namespace easy3d
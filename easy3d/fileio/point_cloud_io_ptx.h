@@ -129,6 +129,17 @@ namespace easy3d {
 			/// \brief Reads a single point cloud from the file.
 			PointCloud* load_next();
 
+			/**
+			 * \brief Reads all the point clouds (scans) of the file at once, concatenated into a single cloud.
+			 * \details The per-scan headers are located in a first, sequential pass over the file; the scan
+			 * blocks are then decoded in parallel (each scan is independent and carries its own registration
+			 * matrix) and copied into preallocated ranges of the returned cloud. For the multi-scan files
+			 * produced by terrestrial scanners (often 60+ scans per file), this is much faster than loading
+			 * the scans one by one with load_next().
+			 * \return The concatenated point cloud (\c nullptr on failure).
+			 */
+			PointCloud* load_all();
+
 		private:
 			std::ifstream*		input_;
 			LineInputStream*	in_;
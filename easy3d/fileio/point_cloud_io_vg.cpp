@@ -325,7 +325,11 @@ namespace easy3d {
         }
 
 
-        bool PointCloudIO_vg::load_bvg(const std::string& file_name, PointCloud* cloud) {
+        // the first int of a legacy binary VG file is the (positive) point count; the current format
+        // puts a negative version tag in front so the two can be told apart.
+        static const int bvg_version_tag = -2;
+
+        bool PointCloudIO_vg::load_bvg(const std::string& file_name, PointCloud* cloud, bool load_groups) {
             std::ifstream input(file_name.c_str(), std::fstream::binary);
             if (input.fail()) {
                 LOG(ERROR) << "could not open file: " << file_name;
@@ -334,6 +338,15 @@ namespace easy3d {
 
             int num;
             input.read((char*)(&num), sizeof(int));
+            bool compressed = false;
+            if (num < 0) {
+                if (num != bvg_version_tag) {
+                    LOG(ERROR) << "unknown binary VG format version: " << -num;
+                    return false;
+                }
+                compressed = true;
+                input.read((char*)(&num), sizeof(int));
+            }
             if (num <= 0) {
                 LOG(ERROR) << "no point exists in file'" << file_name << "'";
                 return false;
@@ -361,11 +374,58 @@ namespace easy3d {
 
             //////////////////////////////////////////////////////////////////////////
 
+            if (!load_groups)   // the group blocks are at the end of the file, so simply stop here
+                return true;
+
+            return read_binary_groups(input, cloud, compressed);
+        }
+
+
+        bool PointCloudIO_vg::load_bvg_groups(const std::string& file_name, PointCloud* cloud) {
+            std::ifstream input(file_name.c_str(), std::fstream::binary);
+            if (input.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            int num;
+            input.read((char*)(&num), sizeof(int));
+            bool compressed = false;
+            if (num < 0) {
+                if (num != bvg_version_tag) {
+                    LOG(ERROR) << "unknown binary VG format version: " << -num;
+                    return false;
+                }
+                compressed = true;
+                input.read((char*)(&num), sizeof(int));
+            }
+            if (num != cloud->n_vertices()) {
+                LOG(ERROR) << "point number in file (" << num << ") differs from that of the point cloud ("
+                           << cloud->n_vertices() << ")";
+                return false;
+            }
+
+            // skip the points block, then the colors and normals blocks (if they exist)
+            input.seekg(num * sizeof(vec3), std::ios::cur);
+            input.read((char*)(&num), sizeof(int));
+            input.seekg(num * sizeof(vec3), std::ios::cur);
+            input.read((char*)(&num), sizeof(int));
+            input.seekg(num * sizeof(vec3), std::ios::cur);
+            if (input.fail()) {
+                LOG(ERROR) << "failed seeking to the vertex group blocks";
+                return false;
+            }
+
+            return read_binary_groups(input, cloud, compressed);
+        }
+
+
+        bool PointCloudIO_vg::read_binary_groups(std::istream& input, PointCloud* cloud, bool compressed) {
             int num_groups = 0;
             input.read((char*)&num_groups, sizeof(int));
             for (int i = 0; i<num_groups; ++i) {
                 VertexGroup g;
-                read_binary_group(input, g);
+                read_binary_group(input, g, compressed);
                 g.primitive_index_ = i;
 
                 if (!g.empty()) {
@@ -381,14 +441,14 @@ namespace easy3d {
                 input.read((char*)&num_children, sizeof(int));
                 for (int j = 0; j<num_children; ++j) {
                     VertexGroup child;
-                    read_binary_group(input, child);
+                    read_binary_group(input, child, compressed);
                     if (!child.empty()) {
                         g.children_.push_back(child);
                     }
                 }
             }
 
-            return true;
+            return !input.fail();
         }
 
 
@@ -404,6 +464,8 @@ namespace easy3d {
             auto cls = cloud->get_vertex_property<vec3>("v:color");
             auto nms = cloud->get_vertex_property<vec3>("v:normal");
 
+            output.write((char*)&bvg_version_tag, sizeof(int));
+
             // write the points block
             std::size_t num = points.size();
             output.write((char*)&num, sizeof(int));
@@ -453,7 +515,7 @@ namespace easy3d {
 
 
         // for binary file format, no string stuff except labels. we add size info before each label
-        void PointCloudIO_vg::read_binary_group(std::istream& input, VertexGroup& group) {
+        void PointCloudIO_vg::read_binary_group(std::istream& input, VertexGroup& group, bool compressed) {
             group.clear();
 
             int type;
@@ -484,7 +546,23 @@ namespace easy3d {
             int num_points = 0;
             input.read((char*)&num_points, sizeof(int));
             group.resize(num_points);
-            input.read((char*)group.data(), num_points * sizeof(int));
+            if (compressed) {
+                // membership is stored as sorted index runs: (start, count) pairs
+                int num_runs = 0;
+                input.read((char*)&num_runs, sizeof(int));
+                std::vector<int> runs(num_runs * 2);
+                input.read((char*)runs.data(), num_runs * 2 * sizeof(int));
+                std::size_t offset = 0;
+                for (int r = 0; r < num_runs; ++r) {
+                    const int start = runs[r * 2];
+                    const int count = runs[r * 2 + 1];
+                    for (int k = 0; k < count; ++k)
+                        group[offset++] = start + k;
+                }
+                LOG_IF(ERROR, offset != group.size()) << "sizes don't match";
+            }
+            else
+                input.read((char*)group.data(), num_points * sizeof(int));
         }
 
 
@@ -511,7 +589,22 @@ namespace easy3d {
 
             std::size_t num_point = g.size();
             output.write((char*)&num_point, sizeof(int));
-            output.write((char*)g.data(), num_point * sizeof(int));
+
+            // membership as sorted index runs: groups collected from the per-vertex properties list
+            // their points in increasing order, and segmented clouds are dominated by long consecutive
+            // ranges, so the runs are a small fraction of the plain index list.
+            std::vector<int> runs;  // interleaved (start, count) pairs
+            for (std::size_t i = 0; i < num_point; ++i) {
+                if (!runs.empty() && g[i] == runs[runs.size() - 2] + runs.back())
+                    ++runs.back();
+                else {
+                    runs.push_back(g[i]);
+                    runs.push_back(1);
+                }
+            }
+            int num_runs = static_cast<int>(runs.size() / 2);
+            output.write((char*)&num_runs, sizeof(int));
+            output.write((char*)runs.data(), num_runs * 2 * sizeof(int));
         }
 
 
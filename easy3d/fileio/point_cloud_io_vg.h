@@ -113,13 +113,33 @@ namespace easy3d {
 
             /**
              * \brief Reads a point cloud from a binary file.
+             * \details The current binary format stores group membership as sorted index runs (start/count
+             * pairs), which are much smaller than the plain index lists of the legacy format. Files written
+             * in the legacy format are still recognized and loaded.
              * \param file_name The file name.
              * \param cloud The point cloud to write to.
+             * \param load_groups \c true to also decode the segmentation information. Pass \c false to load
+             *      only the points (and colors/normals); the group blocks sit at the end of the file and are
+             *      then not even touched, so a segmented point cloud opens as fast as an unsegmented one.
+             *      The groups can be loaded later by load_bvg_groups() when they are actually needed.
              * \return The status of the operation
              *      \arg true if succeeded
              *      \arg false if failed
              */
-            static bool load_bvg(const std::string& file_name, PointCloud* cloud);
+            static bool load_bvg(const std::string& file_name, PointCloud* cloud, bool load_groups = true);
+            /**
+             * \brief Reads only the vertex group information from a binary file.
+             * \details This is the second half of the deferred loading scheme: after a point cloud has been
+             * loaded with load_bvg(file_name, cloud, false), call this function on first access to the
+             * segmentation to populate the "v:primitive_type" and "v:primitive_index" properties. The point
+             * blocks are skipped by seeking, so only the (compact) group records are read.
+             * \param file_name The file name (must be the file the cloud was loaded from).
+             * \param cloud The point cloud to write to.
+             * \return The status of the operation
+             *      \arg true if succeeded
+             *      \arg false if failed
+             */
+            static bool load_bvg_groups(const std::string& file_name, PointCloud* cloud);
             /**
              * \brief Saves a point_cloud to a binary file.
              * \param file_name The file name.
@@ -171,9 +191,13 @@ namespace easy3d {
             static void read_ascii_group(std::istream& input, VertexGroup& g);
             static void write_ascii_group(std::ostream& output, const VertexGroup& g);
 
-            static void read_binary_group(std::istream& input, VertexGroup& g);
+            // 'compressed' denotes the current format (membership stored as sorted index runs);
+            // the legacy format stores membership as plain index lists.
+            static void read_binary_group(std::istream& input, VertexGroup& g, bool compressed);
             static void write_binary_group(std::ostream& output, const VertexGroup& g);
 
+            static bool read_binary_groups(std::istream& input, PointCloud* cloud, bool compressed);
+
             static int num_group_parameters(int type);
 
             static std::vector<float> get_group_parameters(const VertexGroup& g);
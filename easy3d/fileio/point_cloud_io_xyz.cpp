@@ -24,10 +24,11 @@
 
 #include <easy3d/fileio/point_cloud_io.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 
 #include <easy3d/core/point_cloud.h>
-#include <easy3d/util/line_stream.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/progress.h>
 
@@ -37,33 +38,99 @@ namespace easy3d {
 	namespace io {
 
 		bool load_xyz(const std::string& file_name, PointCloud* cloud) {
-			std::ifstream input(file_name.c_str());
+			std::ifstream input(file_name.c_str(), std::fstream::binary);
 			if (input.fail()) {
                 LOG(ERROR) << "could not open file: " << file_name;
 				return false;
 			}
 
-			io::LineInputStream in(input);
-
 			// get length of file
             input.seekg(0, input.end);
             std::streamoff length = input.tellg();
             input.seekg(0, input.beg);
+            if (length <= 0)
+                return false;
+
+            // read the entire file into memory. Parsing from a single buffer allows the file to
+            // be split into byte ranges that are processed in parallel.
+            const std::size_t data_size = static_cast<std::size_t>(length);
+            std::vector<char> buffer(data_size + 1);
+            input.read(buffer.data(), length);
+            buffer[data_size] = '\0';   // so strtof() never runs past the end of the buffer
+            input.close();
+
+            // chunk boundaries, snapped to newline boundaries so every chunk holds whole lines
+            const std::size_t chunk_size = 16 * 1024 * 1024;
+            std::vector<std::size_t> boundaries;
+            boundaries.push_back(0);
+            for (std::size_t pos = chunk_size; pos < data_size; pos += chunk_size) {
+                while (pos < data_size && buffer[pos] != '\n')
+                    ++pos;
+                if (pos + 1 < data_size)
+                    boundaries.push_back(pos + 1);
+            }
+            boundaries.push_back(data_size);
+
+            const int num_chunks = static_cast<int>(boundaries.size()) - 1;
+            std::vector< std::vector<vec3> > chunk_points(num_chunks);
             ProgressLogger progress(length);
+            std::size_t processed = 0;
+
+#pragma omp parallel for schedule(dynamic)
+            for (int c = 0; c < num_chunks; ++c) {
+                const char* p = buffer.data() + boundaries[c];
+                const char* chunk_end = buffer.data() + boundaries[c + 1];
+                std::vector<vec3>& points = chunk_points[c];
+                points.reserve((boundaries[c + 1] - boundaries[c]) / 20);   // a line is rarely shorter
+
+                while (p < chunk_end) {
+                    const char* line_end = static_cast<const char*>(std::memchr(p, '\n', chunk_end - p));
+                    if (!line_end)
+                        line_end = chunk_end;
+
+                    if (*p != '#') {    // skip comment lines
+                        const char* cursor = p;
+                        vec3 v;
+                        bool ok = true;
+                        for (unsigned char i = 0; i < 3; ++i) {
+                            char* parse_end = nullptr;
+                            v[i] = std::strtof(cursor, &parse_end);
+                            // strtof() skips leading whitespace (including newlines), so reject
+                            // values that were actually taken from the next line
+                            if (parse_end == cursor || parse_end > line_end) {
+                                ok = false;
+                                break;
+                            }
+                            cursor = parse_end;
+                        }
+                        if (ok)
+                            points.push_back(v);
+                    }
+
+                    p = line_end + 1;
+                }
+
+#pragma omp critical
+                {
+                    processed += boundaries[c + 1] - boundaries[c];
+                    progress.notify(processed);
+                }
+            }
 
-			vec3 p;
-			while (!input.eof()) {
-				in.get_line();;
-				if (in.current_line()[0] != '#') {
-					in >> p;
-					if (!in.fail()) {
-						cloud->add_vertex(p);
-
-                        std::streamoff pos = input.tellg();
-                        progress.notify(pos);
-					}
-				}
-			}
+            // concatenate the per-chunk vertex arrays in a single pass
+            std::size_t total = 0;
+            for (int c = 0; c < num_chunks; ++c)
+                total += chunk_points[c].size();
+            if (total == 0)
+                return false;
+
+            cloud->resize(static_cast<unsigned int>(total));
+            PointCloud::VertexProperty<vec3> points = cloud->get_vertex_property<vec3>("v:point");
+            std::size_t offset = 0;
+            for (int c = 0; c < num_chunks; ++c) {
+                std::memcpy(points.data() + offset, chunk_points[c].data(), chunk_points[c].size() * sizeof(vec3));
+                offset += chunk_points[c].size();
+            }
 
 			return true;
 		}
@@ -47,8 +47,12 @@ namespace easy3d {
         const std::string& ext = file_system::extension(file_name, true);
         if (ext == "plm")
             success = io::load_plm(file_name, mesh);
+        else if (ext == "bplm")
+            success = io::load_bplm(file_name, mesh);
         else if (ext == "pmesh")
             success = io::load_pmesh(file_name, mesh);
+        else if (ext == "e3d")
+            success = io::load_e3d(file_name, mesh);
         else if (ext.empty()){
             LOG(ERROR) << "unknown file format: no extension" << ext;
             success = false;
@@ -103,8 +107,12 @@ namespace easy3d {
             }
             success = io::save_plm(final_name, mesh);
         }
+        else if (ext == "bplm")
+            success = io::save_bplm(final_name, mesh);
         else if (ext == "pmesh")
             success = io::save_pmesh(final_name, mesh);
+        else if (ext == "e3d")
+            success = io::save_e3d(final_name, mesh);
         else {
             LOG(ERROR) << "unknown file format: " << ext;
             success = false;
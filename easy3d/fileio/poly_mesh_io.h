@@ -70,11 +70,26 @@ namespace easy3d {
         /// Saves a polyhedral mesh to a \p PLM format file.
         bool save_plm(const std::string& file_name, const PolyMesh* mesh);
 
+        /// \brief Reads a polyhedral mesh from a binary \p PLM format file.
+        /// \details The binary variant stores the element counts in the header and the cell
+        /// connectivity as flat index blocks, so the property arrays are sized once, the blocks are
+        /// read in bulk, and the halfface topology is derived in parallel passes instead of being
+        /// reconstructed cell by cell. For large FEM meshes (tens of millions of tetrahedra) this
+        /// loads orders of magnitude faster than the ASCII format.
+        bool load_bplm(const std::string& file_name, PolyMesh* mesh);
+        /// Saves a polyhedral mesh to a binary \p PLM format file.
+        bool save_bplm(const std::string& file_name, const PolyMesh* mesh);
+
         /// Reads a polyhedral mesh from a \p PMESH format file.
         bool load_pmesh(const std::string& file_name, PolyMesh* mesh);
         /// Saves a polyhedral mesh to a \p PMESH format file.
         bool save_pmesh(const std::string& file_name, const PolyMesh* mesh);
 
+        /// Reads a polyhedral mesh from an \p e3d cache file (the native binary cache format).
+        bool load_e3d(const std::string& file_name, PolyMesh* mesh);
+        /// Saves a polyhedral mesh to an \p e3d cache file (the native binary cache format).
+        bool save_e3d(const std::string& file_name, const PolyMesh* mesh);
+
     } // namespace io
 
 } // namespace easy3d
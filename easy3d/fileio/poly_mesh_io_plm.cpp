@@ -24,8 +24,12 @@
 
 #include <easy3d/fileio/poly_mesh_io.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
+#include <vector>
 
 #include <easy3d/core/poly_mesh.h>
 
@@ -118,6 +122,404 @@ namespace easy3d {
             return true;
         }
 
+
+        //-----------------------------------------------------------------------------
+        // The binary PLM variant. All counts are stored in the header so the loader can
+        // size every array up front; the cell connectivity follows as flat index blocks.
+        // Layout (integers are 32-bit):
+        //      int  num_vertices
+        //      int  num_cells
+        //      int  num_records        // sum of the per-cell face counts
+        //      int  num_indices        // total number of vertex indices over all records
+        //      vec3 positions[num_vertices]
+        //      int  cell_face_counts[num_cells]
+        //      int  valences[num_records]
+        //      int  indices[num_indices]
+        //-----------------------------------------------------------------------------
+
+
+        namespace details {
+
+            // \cond
+
+            // the lexicographically smallest cyclic rotation of a vertex sequence
+            inline std::vector<int> canonical_rotation(const std::vector<int>& vts) {
+                const std::size_t n = vts.size();
+                std::size_t best = 0;
+                for (std::size_t i = 1; i < n; ++i) {
+                    for (std::size_t k = 0; k < n; ++k) {
+                        const int a = vts[(i + k) % n];
+                        const int b = vts[(best + k) % n];
+                        if (a != b) {
+                            if (a < b)
+                                best = i;
+                            break;
+                        }
+                    }
+                }
+                std::vector<int> result(n);
+                for (std::size_t k = 0; k < n; ++k)
+                    result[k] = vts[(best + k) % n];
+                return result;
+            }
+
+            // FNV-1a over the vertex indices of a canonical sequence
+            struct VertexSequenceHash {
+                std::size_t operator()(const std::vector<int>& vts) const {
+                    std::uint64_t h = 14695981039346656037ull;
+                    for (int v : vts) {
+                        h ^= static_cast<std::uint64_t>(v);
+                        h *= 1099511628211ull;
+                    }
+                    return static_cast<std::size_t>(h);
+                }
+            };
+
+            // \endcond
+
+        } // namespace details
+
+
+        bool load_bplm(const std::string& file_name, PolyMesh* mesh)
+        {
+            if (!mesh) {
+                LOG(ERROR) << "null mesh pointer";
+                return false;
+            }
+
+            std::ifstream input(file_name.c_str(), std::fstream::binary);
+            if (input.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            int header[4];
+            input.read(reinterpret_cast<char*>(header), sizeof(header));
+            const int num_vertices = header[0];
+            const int num_cells = header[1];
+            const int num_records = header[2];
+            const int num_indices = header[3];
+            if (input.fail() || num_vertices <= 0 || num_cells <= 0 || num_records <= 0 || num_indices <= 0) {
+                LOG(ERROR) << "invalid header in file: " << file_name;
+                return false;
+            }
+
+            std::vector<vec3> positions(num_vertices);
+            std::vector<int> cell_face_counts(num_cells);
+            std::vector<int> valences(num_records);
+            std::vector<int> indices(num_indices);
+            input.read(reinterpret_cast<char*>(positions.data()), num_vertices * sizeof(vec3));
+            input.read(reinterpret_cast<char*>(cell_face_counts.data()), num_cells * sizeof(int));
+            input.read(reinterpret_cast<char*>(valences.data()), num_records * sizeof(int));
+            input.read(reinterpret_cast<char*>(indices.data()), num_indices * sizeof(int));
+            if (input.fail()) {
+                LOG(ERROR) << "file ended prematurely: " << file_name;
+                return false;
+            }
+
+            // Pass 1 (sequential): identify the unique faces and edges. A face is keyed by the
+            // rotation- and orientation-independent canonical form of its vertex sequence, an
+            // edge by its packed endpoint pair, so the hash lookups replace the linear
+            // find_half_face()/find_edge() scans that add_face() performs per cell.
+            typedef std::pair<int, bool> FaceEntry;     // face index + whether the key is the forward orientation
+            std::unordered_map<std::vector<int>, FaceEntry, details::VertexSequenceHash> face_indices;
+            face_indices.reserve(num_records);
+            std::unordered_map<std::uint64_t, int> edge_indices;
+            edge_indices.reserve(num_indices);
+
+            std::vector<int> face_offsets(1, 0);        // CSR offsets into face_vts/face_edges
+            std::vector<int> face_vts;                  // the forward vertex sequence of each face
+            std::vector<int> face_edges;                // the boundary edge at each face corner
+            face_vts.reserve(num_indices / 2);          // every interior face occurs in two cells
+            face_edges.reserve(num_indices / 2);
+            std::vector<int> edge_vts;                  // endpoint pairs, in order of first encounter
+            std::vector<int> halfface_cells;            // the cell using each halfface (-1 = boundary)
+            std::vector<int> cell_halffaces(num_records);
+
+            std::vector<int> record;
+            std::size_t cursor = 0;     // into indices
+            std::size_t r = 0;          // into valences
+            bool good = true;
+            for (int c = 0; c < num_cells && good; ++c) {
+                if (cell_face_counts[c] < 1 || r + cell_face_counts[c] > valences.size()) {
+                    good = false;
+                    break;
+                }
+                for (int f = 0; f < cell_face_counts[c] && good; ++f, ++r) {
+                    const std::size_t valence = valences[r];
+                    if (valences[r] < 3 || cursor + valence > indices.size()) {
+                        good = false;
+                        break;
+                    }
+                    record.assign(indices.begin() + cursor, indices.begin() + cursor + valence);
+                    cursor += valence;
+                    for (int v : record) {
+                        if (v < 0 || v >= num_vertices) {
+                            good = false;
+                            break;
+                        }
+                    }
+                    if (!good)
+                        break;
+
+                    const std::vector<int> forward = details::canonical_rotation(record);
+                    const std::vector<int> reversed =
+                            details::canonical_rotation(std::vector<int>(record.rbegin(), record.rend()));
+                    const bool forward_is_key = !(reversed < forward);
+                    const std::vector<int>& key = forward_is_key ? forward : reversed;
+
+                    int halfface = -1;
+                    auto pos = face_indices.find(key);
+                    if (pos == face_indices.end()) {
+                        const int face = static_cast<int>(face_offsets.size()) - 1;
+                        face_indices[key] = FaceEntry(face, forward_is_key);
+                        face_vts.insert(face_vts.end(), record.begin(), record.end());
+                        for (std::size_t i = 0; i < valence; ++i) {
+                            const int s = record[i];
+                            const int t = record[(i + 1) % valence];
+                            const std::uint64_t ekey =
+                                    (static_cast<std::uint64_t>(std::min(s, t)) << 32) |
+                                     static_cast<std::uint64_t>(std::max(s, t));
+                            auto epos = edge_indices.find(ekey);
+                            int edge;
+                            if (epos == edge_indices.end()) {
+                                edge = static_cast<int>(edge_vts.size()) / 2;
+                                edge_indices[ekey] = edge;
+                                edge_vts.push_back(s);
+                                edge_vts.push_back(t);
+                            }
+                            else
+                                edge = epos->second;
+                            face_edges.push_back(edge);
+                        }
+                        face_offsets.push_back(static_cast<int>(face_vts.size()));
+                        halfface_cells.push_back(-1);
+                        halfface_cells.push_back(-1);
+                        halfface = 2 * face;
+                    }
+                    else {
+                        const bool same_orientation = (forward_is_key == pos->second.second);
+                        halfface = 2 * pos->second.first + (same_orientation ? 0 : 1);
+                    }
+                    cell_halffaces[r] = halfface;
+                    halfface_cells[halfface] = c;
+                }
+            }
+            if (!good || r != valences.size() || cursor != indices.size()) {
+                LOG(ERROR) << "inconsistent cell connectivity in file: " << file_name;
+                return false;
+            }
+
+            const int num_faces = static_cast<int>(face_offsets.size()) - 1;
+            const int num_edges = static_cast<int>(edge_vts.size()) / 2;
+
+            // size all property arrays once and adopt the coordinates
+            mesh->resize(num_vertices, num_edges, num_faces, num_cells);
+            mesh->vertex_property<vec3>("v:point").vector().swap(positions);
+
+            auto vconn = mesh->vertex_property<PolyMesh::VertexConnectivity>("v:connectivity");
+            auto econn = mesh->edge_property<PolyMesh::EdgeConnectivity>("e:connectivity");
+            auto hconn = mesh->halfface_property<PolyMesh::HalfFaceConnectivity>("h:connectivity");
+            auto cconn = mesh->cell_property<PolyMesh::CellConnectivity>("c:connectivity");
+
+            // Pass 2 (parallel): the halfface topology. Each face owns the halfface pair
+            // (2f, 2f+1), so the iterations are independent.
+#pragma omp parallel for schedule(dynamic, 4096)
+            for (int f = 0; f < num_faces; ++f) {
+                auto& hc = hconn[PolyMesh::HalfFace(2 * f)];
+                auto& oc = hconn[PolyMesh::HalfFace(2 * f + 1)];
+                const int begin = face_offsets[f];
+                const int end = face_offsets[f + 1];
+                hc.vertices_.reserve(end - begin);
+                for (int k = begin; k < end; ++k) {
+                    hc.vertices_.push_back(PolyMesh::Vertex(face_vts[k]));
+                    hc.edges_.insert(PolyMesh::Edge(face_edges[k]));
+                }
+                oc.vertices_.assign(hc.vertices_.rbegin(), hc.vertices_.rend());
+                oc.edges_ = hc.edges_;
+                hc.opposite_ = PolyMesh::HalfFace(2 * f + 1);
+                oc.opposite_ = PolyMesh::HalfFace(2 * f);
+                hc.cell_ = PolyMesh::Cell(halfface_cells[2 * f]);
+                oc.cell_ = PolyMesh::Cell(halfface_cells[2 * f + 1]);
+            }
+
+#pragma omp parallel for
+            for (int e = 0; e < num_edges; ++e)
+                econn[PolyMesh::Edge(e)].vertices_ = { PolyMesh::Vertex(edge_vts[2 * e]),
+                                                       PolyMesh::Vertex(edge_vts[2 * e + 1]) };
+
+            // Pass 3 (parallel): the per-cell incidences
+            std::vector<int> cell_offsets(num_cells + 1, 0);
+            for (int c = 0; c < num_cells; ++c)
+                cell_offsets[c + 1] = cell_offsets[c] + cell_face_counts[c];
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (int c = 0; c < num_cells; ++c) {
+                auto& cc = cconn[PolyMesh::Cell(c)];
+                cc.halffaces_.reserve(cell_face_counts[c]);
+                for (int k = cell_offsets[c]; k < cell_offsets[c + 1]; ++k) {
+                    const int h = cell_halffaces[k];
+                    cc.halffaces_.push_back(PolyMesh::HalfFace(h));
+                    const int f = h / 2;
+                    for (int i = face_offsets[f]; i < face_offsets[f + 1]; ++i) {
+                        cc.vertices_.insert(PolyMesh::Vertex(face_vts[i]));
+                        cc.edges_.insert(PolyMesh::Edge(face_edges[i]));
+                    }
+                }
+            }
+
+            // Pass 4 (parallel): the per-vertex and per-edge incidences. The inverse relations
+            // are bucketed into CSR ranges first (cheap integer counting), so each element's
+            // sets are then filled by exactly one thread.
+            {
+                std::vector<int> edge_begin(num_vertices + 1, 0);
+                for (int v : edge_vts)
+                    ++edge_begin[v + 1];
+                for (int v = 0; v < num_vertices; ++v)
+                    edge_begin[v + 1] += edge_begin[v];
+                std::vector<int> vertex_edges(edge_begin[num_vertices]);
+                std::vector<int> where(edge_begin.begin(), edge_begin.end() - 1);
+                for (int e = 0; e < num_edges; ++e) {
+                    vertex_edges[where[edge_vts[2 * e]]++] = e;
+                    vertex_edges[where[edge_vts[2 * e + 1]]++] = e;
+                }
+
+                std::vector<int> face_begin(num_vertices + 1, 0);
+                for (int v : face_vts)
+                    ++face_begin[v + 1];
+                for (int v = 0; v < num_vertices; ++v)
+                    face_begin[v + 1] += face_begin[v];
+                std::vector<int> vertex_faces(face_begin[num_vertices]);
+                where.assign(face_begin.begin(), face_begin.end() - 1);
+                for (int f = 0; f < num_faces; ++f) {
+                    for (int k = face_offsets[f]; k < face_offsets[f + 1]; ++k)
+                        vertex_faces[where[face_vts[k]]++] = f;
+                }
+
+                std::vector<int> cell_begin(num_vertices + 1, 0);
+                for (int c = 0; c < num_cells; ++c) {
+                    for (auto v : cconn[PolyMesh::Cell(c)].vertices_)
+                        ++cell_begin[v.idx() + 1];
+                }
+                for (int v = 0; v < num_vertices; ++v)
+                    cell_begin[v + 1] += cell_begin[v];
+                std::vector<int> vertex_cells(cell_begin[num_vertices]);
+                where.assign(cell_begin.begin(), cell_begin.end() - 1);
+                for (int c = 0; c < num_cells; ++c) {
+                    for (auto v : cconn[PolyMesh::Cell(c)].vertices_)
+                        vertex_cells[where[v.idx()]++] = c;
+                }
+
+#pragma omp parallel for schedule(dynamic, 4096)
+                for (int v = 0; v < num_vertices; ++v) {
+                    auto& vc = vconn[PolyMesh::Vertex(v)];
+                    for (int k = edge_begin[v]; k < edge_begin[v + 1]; ++k) {
+                        const int e = vertex_edges[k];
+                        vc.edges_.insert(PolyMesh::Edge(e));
+                        vc.vertices_.insert(PolyMesh::Vertex(edge_vts[2 * e] + edge_vts[2 * e + 1] - v));
+                    }
+                    for (int k = face_begin[v]; k < face_begin[v + 1]; ++k) {
+                        vc.halffaces_.insert(PolyMesh::HalfFace(2 * vertex_faces[k]));
+                        vc.halffaces_.insert(PolyMesh::HalfFace(2 * vertex_faces[k] + 1));
+                    }
+                    for (int k = cell_begin[v]; k < cell_begin[v + 1]; ++k)
+                        vc.cells_.insert(PolyMesh::Cell(vertex_cells[k]));
+                }
+            }
+
+            {
+                std::vector<int> face_begin(num_edges + 1, 0);
+                for (int e : face_edges)
+                    ++face_begin[e + 1];
+                for (int e = 0; e < num_edges; ++e)
+                    face_begin[e + 1] += face_begin[e];
+                std::vector<int> incident_faces(face_begin[num_edges]);
+                std::vector<int> where(face_begin.begin(), face_begin.end() - 1);
+                for (int f = 0; f < num_faces; ++f) {
+                    for (int k = face_offsets[f]; k < face_offsets[f + 1]; ++k)
+                        incident_faces[where[face_edges[k]]++] = f;
+                }
+
+                std::vector<int> cell_begin(num_edges + 1, 0);
+                for (int c = 0; c < num_cells; ++c) {
+                    for (auto e : cconn[PolyMesh::Cell(c)].edges_)
+                        ++cell_begin[e.idx() + 1];
+                }
+                for (int e = 0; e < num_edges; ++e)
+                    cell_begin[e + 1] += cell_begin[e];
+                std::vector<int> incident_cells(cell_begin[num_edges]);
+                where.assign(cell_begin.begin(), cell_begin.end() - 1);
+                for (int c = 0; c < num_cells; ++c) {
+                    for (auto e : cconn[PolyMesh::Cell(c)].edges_)
+                        incident_cells[where[e.idx()]++] = c;
+                }
+
+#pragma omp parallel for schedule(dynamic, 4096)
+                for (int e = 0; e < num_edges; ++e) {
+                    auto& ec = econn[PolyMesh::Edge(e)];
+                    for (int k = face_begin[e]; k < face_begin[e + 1]; ++k) {
+                        ec.halffaces_.insert(PolyMesh::HalfFace(2 * incident_faces[k]));
+                        ec.halffaces_.insert(PolyMesh::HalfFace(2 * incident_faces[k] + 1));
+                    }
+                    for (int k = cell_begin[e]; k < cell_begin[e + 1]; ++k)
+                        ec.cells_.insert(PolyMesh::Cell(incident_cells[k]));
+                }
+            }
+
+            return (mesh->n_vertices() > 0 && mesh->n_faces() > 0 && mesh->n_cells() > 0);
+        }
+
+
+        //-----------------------------------------------------------------------------
+
+
+        bool save_bplm(const std::string& file_name, const PolyMesh* mesh)
+        {
+            if (!mesh) {
+                LOG(ERROR) << "null mesh pointer";
+                return false;
+            }
+
+            if (mesh->n_vertices() == 0 || mesh->n_faces() == 0 || mesh->n_cells() == 0) {
+                LOG(ERROR) << "polyhedral mesh is empty";
+                return false;
+            }
+
+            std::ofstream output(file_name.c_str(), std::fstream::binary);
+            if (output.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            // flatten the cell connectivity, collecting the totals for the header
+            std::vector<int> cell_face_counts, valences, indices;
+            cell_face_counts.reserve(mesh->n_cells());
+            for (auto c : mesh->cells()) {
+                cell_face_counts.push_back(static_cast<int>(mesh->halffaces(c).size()));
+                for (auto h : mesh->halffaces(c)) {
+                    const auto& vts = mesh->vertices(h);
+                    valences.push_back(static_cast<int>(vts.size()));
+                    for (auto v : vts)
+                        indices.push_back(v.idx());
+                }
+            }
+
+            const int header[4] = {
+                    static_cast<int>(mesh->n_vertices()),
+                    static_cast<int>(mesh->n_cells()),
+                    static_cast<int>(valences.size()),
+                    static_cast<int>(indices.size())
+            };
+            output.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+            auto points = mesh->get_vertex_property<vec3>("v:point");
+            output.write(reinterpret_cast<const char*>(points.data()), mesh->n_vertices() * sizeof(vec3));
+            output.write(reinterpret_cast<const char*>(cell_face_counts.data()), cell_face_counts.size() * sizeof(int));
+            output.write(reinterpret_cast<const char*>(valences.data()), valences.size() * sizeof(int));
+            output.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(int));
+
+            return !output.fail();
+        }
+
     }
 
 }
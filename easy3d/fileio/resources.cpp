@@ -24,6 +24,19 @@
 
 #include <easy3d/fileio/resources.h>
 #include <easy3d/util/file_system.h>
+#include <easy3d/util/logging.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 
 namespace easy3d {
@@ -59,6 +72,235 @@ namespace easy3d {
         }
 
 
+        // ------------------------- packed resource bundle -------------------------
+
+        namespace details {
+            // \cond
+            // the pack file layout: the 8-byte magic "E3DPACK1", a uint64 entry count, then per
+            // entry a uint32 name length, the name, and the uint64 offset/size of its bytes
+            // within the file, followed by the concatenated bytes of all entries.
+            static const char PACK_MAGIC[8] = {'E', '3', 'D', 'P', 'A', 'C', 'K', '1'};
+
+            struct Entry {
+                std::size_t offset;
+                std::size_t size;
+            };
+
+            // the loaded pack: one mapping of the whole file plus an index into it
+            struct Pack {
+                Pack() : mapping(nullptr), size(0)
+#ifndef _WIN32
+                       , fd(-1)
+#endif
+                {}
+                const char* mapping;
+                std::size_t size;
+#ifdef _WIN32
+                std::vector<char> storage;  // plain whole-file read on Windows (see PagedArray)
+#else
+                int fd;
+#endif
+                std::unordered_map<std::string, Entry> index;
+            };
+
+            static Pack pack_;
+            static bool default_pack_attempted_ = false;
+
+            // the pack deployed next to the resource directory is picked up on first access
+            static void ensure_default_pack() {
+                if (default_pack_attempted_ || pack_.mapping)
+                    return;
+                default_pack_attempted_ = true;
+                const std::string file_name = directory() + ".e3dpack";
+                if (file_system::is_file(file_name))
+                    load_pack(file_name);
+            }
+
+            template <typename T>
+            static bool read_value(const char* data, std::size_t size, std::size_t& pos, T& value) {
+                if (pos + sizeof(T) > size)
+                    return false;
+                std::memcpy(&value, data + pos, sizeof(T));
+                pos += sizeof(T);
+                return true;
+            }
+            // \endcond
+        }
+
+
+        bool load_pack(const std::string& file_name) {
+            unload_pack();
+
+#ifdef _WIN32
+            std::ifstream input(file_name.c_str(), std::fstream::binary);
+            if (input.fail()) {
+                LOG(WARNING) << "could not open resource pack: " << file_name;
+                return false;
+            }
+            input.seekg(0, input.end);
+            const std::size_t file_size = static_cast<std::size_t>(input.tellg());
+            input.seekg(0, input.beg);
+            details::pack_.storage.resize(file_size);
+            input.read(details::pack_.storage.data(), static_cast<std::streamsize>(file_size));
+            details::pack_.mapping = details::pack_.storage.data();
+            details::pack_.size = file_size;
+#else
+            details::pack_.fd = ::open(file_name.c_str(), O_RDONLY);
+            if (details::pack_.fd < 0) {
+                LOG(WARNING) << "could not open resource pack: " << file_name;
+                return false;
+            }
+            struct stat st;
+            if (::fstat(details::pack_.fd, &st) != 0) {
+                unload_pack();
+                return false;
+            }
+            details::pack_.size = static_cast<std::size_t>(st.st_size);
+            void* mapping = ::mmap(nullptr, details::pack_.size, PROT_READ, MAP_PRIVATE,
+                                   details::pack_.fd, 0);
+            if (mapping == MAP_FAILED) {
+                LOG(WARNING) << "could not map resource pack: " << file_name;
+                unload_pack();
+                return false;
+            }
+            details::pack_.mapping = static_cast<const char*>(mapping);
+#endif
+
+            // parse the index
+            const char* data = details::pack_.mapping;
+            const std::size_t size = details::pack_.size;
+            if (size < sizeof(details::PACK_MAGIC) + sizeof(uint64_t) ||
+                std::memcmp(data, details::PACK_MAGIC, sizeof(details::PACK_MAGIC)) != 0) {
+                LOG(WARNING) << "not a resource pack: " << file_name;
+                unload_pack();
+                return false;
+            }
+            std::size_t pos = sizeof(details::PACK_MAGIC);
+            uint64_t num_entries = 0;
+            details::read_value(data, size, pos, num_entries);
+            for (uint64_t i = 0; i < num_entries; ++i) {
+                uint32_t name_length = 0;
+                if (!details::read_value(data, size, pos, name_length) || pos + name_length > size) {
+                    LOG(WARNING) << "corrupt resource pack: " << file_name;
+                    unload_pack();
+                    return false;
+                }
+                const std::string name(data + pos, name_length);
+                pos += name_length;
+                uint64_t offset = 0, entry_size = 0;
+                if (!details::read_value(data, size, pos, offset) ||
+                    !details::read_value(data, size, pos, entry_size) ||
+                    offset + entry_size > size) {
+                    LOG(WARNING) << "corrupt resource pack: " << file_name;
+                    unload_pack();
+                    return false;
+                }
+                details::pack_.index[name] = details::Entry{
+                        static_cast<std::size_t>(offset), static_cast<std::size_t>(entry_size)};
+            }
+
+            LOG(INFO) << "resource pack loaded: " << file_name
+                      << " (" << details::pack_.index.size() << " entries)";
+            return true;
+        }
+
+
+        void unload_pack() {
+#ifdef _WIN32
+            std::vector<char>().swap(details::pack_.storage);
+#else
+            if (details::pack_.mapping)
+                ::munmap(const_cast<char*>(details::pack_.mapping), details::pack_.size);
+            if (details::pack_.fd >= 0) {
+                ::close(details::pack_.fd);
+                details::pack_.fd = -1;
+            }
+#endif
+            details::pack_.mapping = nullptr;
+            details::pack_.size = 0;
+            details::pack_.index.clear();
+        }
+
+
+        bool pack_has(const std::string& name) {
+            details::ensure_default_pack();
+            return details::pack_.index.find(name) != details::pack_.index.end();
+        }
+
+
+        const char* pack_data(const std::string& name, std::size_t& size) {
+            details::ensure_default_pack();
+            auto pos = details::pack_.index.find(name);
+            if (pos == details::pack_.index.end()) {
+                size = 0;
+                return nullptr;
+            }
+            size = pos->second.size;
+            return details::pack_.mapping + pos->second.offset;
+        }
+
+
+        bool pack_text(const std::string& name, std::string& text) {
+            std::size_t size = 0;
+            const char* data = pack_data(name, size);
+            if (!data)
+                return false;
+            text.assign(data, size);
+            return true;
+        }
+
+
+        bool create_pack(const std::string& dir, const std::string& file_name) {
+            if (!file_system::is_directory(dir)) {
+                LOG(WARNING) << "not a directory: " << dir;
+                return false;
+            }
+
+            std::vector<std::string> files;
+            file_system::get_files_parallel(dir, files, true);
+            if (files.empty()) {
+                LOG(WARNING) << "directory contains no files: " << dir;
+                return false;
+            }
+
+            std::ofstream output(file_name.c_str(), std::fstream::binary);
+            if (output.fail()) {
+                LOG(WARNING) << "could not create resource pack: " << file_name;
+                return false;
+            }
+
+            // the index size is known in advance, so the entry offsets can be computed before
+            // anything is written
+            std::vector<std::string> names(files.size());
+            std::vector<std::string> contents(files.size());
+            std::size_t index_size = sizeof(details::PACK_MAGIC) + sizeof(uint64_t);
+            for (std::size_t i = 0; i < files.size(); ++i) {
+                names[i] = files[i].substr(dir.size() + 1);
+                file_system::read_file_to_string(files[i], contents[i]);
+                index_size += sizeof(uint32_t) + names[i].size() + 2 * sizeof(uint64_t);
+            }
+
+            output.write(details::PACK_MAGIC, sizeof(details::PACK_MAGIC));
+            const uint64_t num_entries = files.size();
+            output.write(reinterpret_cast<const char*>(&num_entries), sizeof(num_entries));
+            uint64_t offset = index_size;
+            for (std::size_t i = 0; i < files.size(); ++i) {
+                const uint32_t name_length = static_cast<uint32_t>(names[i].size());
+                output.write(reinterpret_cast<const char*>(&name_length), sizeof(name_length));
+                output.write(names[i].data(), name_length);
+                const uint64_t entry_size = contents[i].size();
+                output.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+                output.write(reinterpret_cast<const char*>(&entry_size), sizeof(entry_size));
+                offset += entry_size;
+            }
+            for (std::size_t i = 0; i < files.size(); ++i)
+                output.write(contents[i].data(), static_cast<std::streamsize>(contents[i].size()));
+
+            LOG(INFO) << "resource pack created: " << file_name << " (" << files.size() << " entries)";
+            return !output.fail();
+        }
+
+
 
         // const int bunny_num_vertices = 453;
         // const int bunny_num_faces = 902;
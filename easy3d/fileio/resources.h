@@ -49,6 +49,45 @@ namespace easy3d {
 		/// Resource directory (containing color maps, shaders, textures, etc.)
         extern std::string directory();
 
+        /// \name Packed resource bundle
+        /// A pack stores the whole resource directory (shaders, color maps, textures, fonts) in
+        /// a single file that is memory-mapped once, so a cold start performs one open instead
+        /// of dozens of small reads — the small reads are what make network installs slow.
+        /// Entries are located through an in-memory index in O(1). Callers fall back to the
+        /// individual files on disk when no pack is loaded or an entry is missing, so a pack is
+        /// an optional deployment optimization, not a requirement.
+        /// A pack named "<resource directory>.e3dpack" is picked up automatically on first
+        /// access; create one with create_pack() at install/deployment time.
+        /// @{
+
+        /// \brief Loads a packed resource bundle. Replaces a previously loaded pack.
+        /// \return true on success.
+        bool load_pack(const std::string& file_name);
+
+        /// \brief Releases the loaded pack (if any). Pointers returned by pack_data() become
+        ///     invalid.
+        void unload_pack();
+
+        /// \brief Whether the loaded pack contains entry \p name. Entry names are relative to
+        ///     the resource directory and use forward slashes, e.g.,
+        ///     "shaders/surface/surface_color.vert".
+        bool pack_has(const std::string& name);
+
+        /// \brief The raw bytes of entry \p name (nullptr if no pack is loaded or the entry
+        ///     does not exist). The pointer remains valid until unload_pack().
+        const char* pack_data(const std::string& name, std::size_t& size);
+
+        /// \brief Reads entry \p name into \p text.
+        /// \return false if no pack is loaded or the entry does not exist.
+        bool pack_text(const std::string& name, std::string& text);
+
+        /// \brief Creates a packed resource bundle from the contents of directory \p dir
+        ///     (recursively; entry names are the paths relative to \p dir).
+        /// \return true on success.
+        bool create_pack(const std::string& dir, const std::string& file_name);
+
+        /// @}
+
     } // namespace resource
 
 } // namespace easy3d
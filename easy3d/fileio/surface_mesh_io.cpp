@@ -58,6 +58,10 @@ namespace easy3d {
 			success = io::load_stl(file_name, mesh);
         else if (ext == "trilist")
             success = io::load_trilist(file_name, mesh);
+        else if (ext == "e3d")
+            success = io::load_e3d(file_name, mesh);
+        else if (ext == "e3dc")
+            success = io::load_e3dc(file_name, mesh);
 
 		//	else if (ext == "plg")
 		//        serializer = new MeshSerializer_plg();
@@ -119,6 +123,10 @@ namespace easy3d {
             success = io::save_off(final_name, mesh);
 		else if (ext == "stl")
             success = io::save_stl(final_name, mesh);
+        else if (ext == "e3d")
+            success = io::save_e3d(final_name, mesh);
+        else if (ext == "e3dc")
+            success = io::save_e3dc(final_name, mesh);
 
 		//	else if (ext == "plg")
 		//        serializer = new MeshSerializer_plg();
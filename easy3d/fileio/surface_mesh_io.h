@@ -26,6 +26,7 @@
 #define EASY3D_FILEIO_SURFACE_MESH_IO_H
 
 
+#include <iosfwd>
 #include <string>
 
 
@@ -93,6 +94,23 @@ namespace easy3d {
 		/// Mainly used for easy saving some triangles for debugging.
         bool load_trilist(const std::string& file_name, SurfaceMesh* mesh);
 
+        /// Reads a surface mesh from an \p e3d cache file (the native binary cache format).
+        bool load_e3d(const std::string& file_name, SurfaceMesh* mesh);
+        /// Saves a surface mesh to an \p e3d cache file (the native binary cache format).
+        bool save_e3d(const std::string& file_name, const SurfaceMesh* mesh);
+        /// Reads a surface mesh in the \p e3d layout from a stream (e.g., a memory-backed one).
+        bool load_e3d(std::istream& input, SurfaceMesh* mesh);
+        /// Writes a surface mesh in the \p e3d layout to a stream (e.g., a memory-backed one).
+        bool save_e3d(std::ostream& output, const SurfaceMesh* mesh);
+
+        /// Reads a surface mesh from an \p e3dc file (the compressed interchange format:
+        /// quantized delta-coded attributes and connectivity, entropy-coded in parallel).
+        bool load_e3dc(const std::string& file_name, SurfaceMesh* mesh);
+        /// Saves a surface mesh to an \p e3dc file (the compressed interchange format).
+        /// \attention The format is lossy (positions are quantized to 16 bits per axis over
+        ///     the bounding box) and custom properties are not transferred.
+        bool save_e3dc(const std::string& file_name, const SurfaceMesh* mesh);
+
 	} // namespace io
 
 } // namespace easy3d
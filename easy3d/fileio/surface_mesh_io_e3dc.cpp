@@ -0,0 +1,663 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/fileio/surface_mesh_io.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <queue>
+#include <vector>
+
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/point_cloud_quantization.h>
+#include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
+
+
+/** ----------------------------------------------------------
+ *
+ * The e3dc format is a compressed interchange format for surface meshes,
+ * intended for network transfer (unlike the e3d cache, it is byte-order
+ * independent in practice since all multi-byte values go through varints or
+ * little-endian helpers, and it does not dump raw property arrays).
+ *
+ * Attributes are quantized (positions and texture coordinates to 16 bits per
+ * component over their bounding box, normals to a 16+16-bit octahedral code,
+ * colors to 8 bits per channel) and delta-coded against the previous element,
+ * which turns the typically coherent vertex order of a mesh into streams of
+ * small residuals. Connectivity is delta-coded the same way: each face stores
+ * its valence and its vertex indices as differences from the previously
+ * written index. Every stream is then split into 1 MB chunks that are
+ * entropy-coded independently (canonical Huffman, with a verbatim fallback
+ * for incompressible chunks), so both encoding and decoding parallelize over
+ * the chunks on the global thread pool.
+ *
+ * The format is lossy by design: positions are reproduced to within
+ * bounding-box-extent / 65535 per axis and normals to within ~0.01 degrees.
+ * Custom properties are not transferred (use e3d or ply for those).
+ *
+ *----------------------------------------------------------*/
+
+
+namespace easy3d {
+
+    namespace io {
+
+        namespace e3dc {
+
+            static const char MAGIC[4] = { 'E', '3', 'D', 'C' };
+            static const std::uint32_t VERSION = 1;
+            static const std::size_t CHUNK_SIZE = 1024 * 1024;
+
+            // attribute presence bits in the header
+            enum : std::uint32_t {
+                HAS_NORMALS = 1,
+                HAS_COLORS = 2,
+                HAS_TEXCOORDS = 4
+            };
+
+            // ---------------------------------------------------------------- little-endian scalars
+
+            inline void write_uint32(std::ostream& output, std::uint32_t value) {
+                unsigned char b[4] = { (unsigned char)(value), (unsigned char)(value >> 8),
+                                       (unsigned char)(value >> 16), (unsigned char)(value >> 24) };
+                output.write(reinterpret_cast<const char*>(b), 4);
+            }
+
+            inline std::uint32_t read_uint32(std::istream& input) {
+                unsigned char b[4] = { 0, 0, 0, 0 };
+                input.read(reinterpret_cast<char*>(b), 4);
+                return std::uint32_t(b[0]) | (std::uint32_t(b[1]) << 8) |
+                       (std::uint32_t(b[2]) << 16) | (std::uint32_t(b[3]) << 24);
+            }
+
+            inline void write_uint64(std::ostream& output, std::uint64_t value) {
+                write_uint32(output, std::uint32_t(value));
+                write_uint32(output, std::uint32_t(value >> 32));
+            }
+
+            inline std::uint64_t read_uint64(std::istream& input) {
+                const std::uint64_t lo = read_uint32(input);
+                const std::uint64_t hi = read_uint32(input);
+                return lo | (hi << 32);
+            }
+
+            inline void write_float(std::ostream& output, float value) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, 4);
+                write_uint32(output, bits);
+            }
+
+            inline float read_float(std::istream& input) {
+                const std::uint32_t bits = read_uint32(input);
+                float value;
+                std::memcpy(&value, &bits, 4);
+                return value;
+            }
+
+            // ---------------------------------------------------------------- varint / zigzag
+
+            inline void append_varint(std::vector<unsigned char>& out, std::uint64_t v) {
+                while (v >= 0x80) {
+                    out.push_back(static_cast<unsigned char>(v) | 0x80);
+                    v >>= 7;
+                }
+                out.push_back(static_cast<unsigned char>(v));
+            }
+
+            inline std::uint64_t read_varint(const unsigned char*& p) {
+                std::uint64_t v = 0;
+                int shift = 0;
+                while (*p & 0x80) {
+                    v |= std::uint64_t(*p & 0x7f) << shift;
+                    shift += 7;
+                    ++p;
+                }
+                v |= std::uint64_t(*p) << shift;
+                ++p;
+                return v;
+            }
+
+            inline std::uint64_t zigzag(std::int64_t v) {
+                return (std::uint64_t(v) << 1) ^ std::uint64_t(v >> 63);
+            }
+
+            inline std::int64_t unzigzag(std::uint64_t v) {
+                return std::int64_t(v >> 1) ^ -std::int64_t(v & 1);
+            }
+
+            // ---------------------------------------------------------------- canonical Huffman
+
+            // assigns canonical codes from the code lengths: symbols sorted by (length, value)
+            // get consecutive codes, shifted left when the length grows. The decoder rebuilds
+            // the per-length tables from the same 256 lengths.
+            inline void build_canonical(const unsigned char lengths[256], std::uint32_t codes[256],
+                                        int sorted_symbols[256], std::uint32_t first_code[64],
+                                        int first_index[64], int count[64], int& max_len) {
+                for (int l = 0; l < 64; ++l) {
+                    count[l] = 0;
+                    first_code[l] = 0;
+                    first_index[l] = 0;
+                }
+                max_len = 0;
+                for (int s = 0; s < 256; ++s) {
+                    if (lengths[s] > 0) {
+                        ++count[lengths[s]];
+                        max_len = std::max(max_len, int(lengths[s]));
+                    }
+                }
+                std::uint32_t code = 0;
+                int index = 0;
+                for (int l = 1; l <= max_len; ++l) {
+                    code <<= 1;
+                    first_code[l] = code;
+                    first_index[l] = index;
+                    for (int s = 0; s < 256; ++s) {
+                        if (lengths[s] == l) {
+                            codes[s] = code++;
+                            sorted_symbols[index++] = s;
+                        }
+                    }
+                }
+            }
+
+            // entropy-codes one chunk. The output starts with a one-byte flag: 0 means the
+            // chunk is stored verbatim (incompressible), 1 means 256 code lengths followed
+            // by the MSB-first bitstream.
+            inline void encode_chunk(const unsigned char* data, std::size_t size,
+                                     std::vector<unsigned char>& out) {
+                out.clear();
+                if (size == 0)
+                    return;
+
+                std::uint64_t freq[256] = { 0 };
+                for (std::size_t i = 0; i < size; ++i)
+                    ++freq[data[i]];
+
+                // Huffman code lengths (parent-pointer tree; at most 511 nodes)
+                unsigned char lengths[256] = { 0 };
+                int parent[512];
+                typedef std::pair<std::uint64_t, int> WeightedNode;
+                std::priority_queue<WeightedNode, std::vector<WeightedNode>, std::greater<WeightedNode> > heap;
+                for (int s = 0; s < 256; ++s) {
+                    if (freq[s] > 0)
+                        heap.push(WeightedNode(freq[s], s));
+                }
+                if (heap.size() == 1)
+                    lengths[heap.top().second] = 1;
+                else {
+                    int num_nodes = 256;
+                    while (heap.size() > 1) {
+                        const WeightedNode a = heap.top(); heap.pop();
+                        const WeightedNode b = heap.top(); heap.pop();
+                        parent[a.second] = num_nodes;
+                        parent[b.second] = num_nodes;
+                        heap.push(WeightedNode(a.first + b.first, num_nodes));
+                        ++num_nodes;
+                    }
+                    const int root = num_nodes - 1;
+                    for (int s = 0; s < 256; ++s) {
+                        if (freq[s] > 0) {
+                            int len = 0;
+                            for (int n = s; n != root; n = parent[n])
+                                ++len;
+                            lengths[s] = static_cast<unsigned char>(len);
+                        }
+                    }
+                }
+
+                // fall back to verbatim storage when coding would not help
+                std::uint64_t total_bits = 0;
+                for (int s = 0; s < 256; ++s)
+                    total_bits += freq[s] * lengths[s];
+                if (256 + (total_bits + 7) / 8 >= size) {
+                    out.reserve(size + 1);
+                    out.push_back(0);
+                    out.insert(out.end(), data, data + size);
+                    return;
+                }
+
+                std::uint32_t codes[256];
+                int sorted_symbols[256], first_index[64], count[64], max_len;
+                std::uint32_t first_code[64];
+                build_canonical(lengths, codes, sorted_symbols, first_code, first_index, count, max_len);
+
+                out.reserve(257 + std::size_t((total_bits + 7) / 8));
+                out.push_back(1);
+                out.insert(out.end(), lengths, lengths + 256);
+
+                std::uint64_t acc = 0;
+                int num_bits = 0;
+                for (std::size_t i = 0; i < size; ++i) {
+                    const int s = data[i];
+                    acc = (acc << lengths[s]) | codes[s];
+                    num_bits += lengths[s];
+                    while (num_bits >= 8) {
+                        out.push_back(static_cast<unsigned char>(acc >> (num_bits - 8)));
+                        num_bits -= 8;
+                    }
+                }
+                if (num_bits > 0)
+                    out.push_back(static_cast<unsigned char>(acc << (8 - num_bits)));
+            }
+
+            inline bool decode_chunk(const unsigned char* data, std::size_t encoded_size,
+                                     unsigned char* out, std::size_t raw_size) {
+                if (raw_size == 0)
+                    return true;
+                if (encoded_size < 1)
+                    return false;
+                const unsigned char* p = data;
+                if (*p++ == 0) {
+                    if (encoded_size < raw_size + 1)
+                        return false;
+                    std::memcpy(out, p, raw_size);
+                    return true;
+                }
+                if (encoded_size < 257)
+                    return false;
+
+                unsigned char lengths[256];
+                std::memcpy(lengths, p, 256);
+                p += 256;
+
+                std::uint32_t codes[256], first_code[64];
+                int sorted_symbols[256], first_index[64], count[64], max_len;
+                build_canonical(lengths, codes, sorted_symbols, first_code, first_index, count, max_len);
+                if (max_len == 0)
+                    return false;
+
+                const unsigned char* end = data + encoded_size;
+                std::uint32_t code = 0;
+                int len = 0, bit = 0;
+                unsigned char byte = 0;
+                for (std::size_t i = 0; i < raw_size; ++i) {
+                    for (;;) {
+                        if (bit == 0) {
+                            if (p >= end)
+                                return false;
+                            byte = *p++;
+                            bit = 8;
+                        }
+                        code = (code << 1) | ((byte >> --bit) & 1);
+                        ++len;
+                        if (len > max_len)
+                            return false;
+                        if (count[len] > 0 && code - first_code[len] < std::uint32_t(count[len])) {
+                            out[i] = static_cast<unsigned char>(
+                                    sorted_symbols[first_index[len] + (code - first_code[len])]);
+                            code = 0;
+                            len = 0;
+                            break;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            // ---------------------------------------------------------------- chunked streams
+
+            // writes a byte stream as independently entropy-coded chunks (encoded in parallel)
+            inline void write_stream(std::ostream& output, const std::vector<unsigned char>& raw) {
+                const std::size_t num_chunks = (raw.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+                std::vector< std::vector<unsigned char> > encoded(num_chunks);
+                ThreadPool::global().parallel_for(0, num_chunks, [&](std::size_t i) {
+                    const std::size_t begin = i * CHUNK_SIZE;
+                    encode_chunk(raw.data() + begin, std::min(CHUNK_SIZE, raw.size() - begin), encoded[i]);
+                }, 1);
+
+                write_uint64(output, raw.size());
+                write_uint32(output, static_cast<std::uint32_t>(num_chunks));
+                for (std::size_t i = 0; i < num_chunks; ++i) {
+                    write_uint64(output, encoded[i].size());
+                    output.write(reinterpret_cast<const char*>(encoded[i].data()),
+                                 static_cast<std::streamsize>(encoded[i].size()));
+                }
+            }
+
+            // the inverse of write_stream (chunks are decoded in parallel)
+            inline bool read_stream(std::istream& input, std::vector<unsigned char>& raw) {
+                const std::uint64_t raw_size = read_uint64(input);
+                const std::uint32_t num_chunks = read_uint32(input);
+                if (!input.good() || num_chunks != (raw_size + CHUNK_SIZE - 1) / CHUNK_SIZE)
+                    return false;
+
+                std::vector< std::vector<unsigned char> > encoded(num_chunks);
+                for (std::uint32_t i = 0; i < num_chunks; ++i) {
+                    const std::uint64_t size = read_uint64(input);
+                    encoded[i].resize(size);
+                    input.read(reinterpret_cast<char*>(encoded[i].data()), static_cast<std::streamsize>(size));
+                }
+                if (!input.good())
+                    return false;
+
+                raw.resize(raw_size);
+                std::vector<char> ok(num_chunks, 1);
+                ThreadPool::global().parallel_for(0, std::size_t(num_chunks), [&](std::size_t i) {
+                    const std::size_t begin = i * CHUNK_SIZE;
+                    ok[i] = decode_chunk(encoded[i].data(), encoded[i].size(), raw.data() + begin,
+                                         std::min(CHUNK_SIZE, std::size_t(raw_size) - begin)) ? 1 : 0;
+                }, 1);
+                for (std::uint32_t i = 0; i < num_chunks; ++i) {
+                    if (!ok[i])
+                        return false;
+                }
+                return true;
+            }
+
+            // quantizes a value to 16 bits over [base, base + range]
+            inline std::uint16_t quantize16(float value, float base, float inv_scale) {
+                const float c = (value - base) * inv_scale + 0.5f;
+                return static_cast<std::uint16_t>(std::min(std::max(c, 0.0f), 65535.0f));
+            }
+
+        } // namespace e3dc
+
+
+        bool save_e3dc(const std::string& file_name, const SurfaceMesh* mesh)
+        {
+            if (!mesh || mesh->n_vertices() == 0 || mesh->n_faces() == 0) {
+                LOG(ERROR) << "surface mesh is null or empty";
+                return false;
+            }
+
+            std::ofstream output(file_name.c_str(), std::fstream::binary);
+            if (output.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            // a compact vertex numbering, so deleted-but-not-collected vertices do not leak
+            // into the file
+            std::vector<int> new_index(mesh->vertices_size(), -1);
+            int num_vertices = 0;
+            for (auto v : mesh->vertices())
+                new_index[v.idx()] = num_vertices++;
+
+            // the bounding box of the valid vertices defines the quantization grid
+            vec3 box_min(std::numeric_limits<float>::max());
+            vec3 box_max(-std::numeric_limits<float>::max());
+            for (auto v : mesh->vertices()) {
+                const vec3& p = mesh->position(v);
+                for (int c = 0; c < 3; ++c) {
+                    box_min[c] = std::min(box_min[c], p[c]);
+                    box_max[c] = std::max(box_max[c], p[c]);
+                }
+            }
+            float inv_scale[3];
+            for (int c = 0; c < 3; ++c) {
+                const float range = box_max[c] - box_min[c];
+                inv_scale[c] = range > 0.0f ? 65535.0f / range : 0.0f;
+            }
+
+            auto normals = mesh->get_vertex_property<vec3>("v:normal");
+            auto colors = mesh->get_vertex_property<vec3>("v:color");
+            auto texcoords = mesh->get_vertex_property<vec2>("v:texcoord");
+            std::uint32_t flags = 0;
+            if (normals)    flags |= e3dc::HAS_NORMALS;
+            if (colors)     flags |= e3dc::HAS_COLORS;
+            if (texcoords)  flags |= e3dc::HAS_TEXCOORDS;
+
+            // positions: quantized, delta-coded against the previous vertex
+            std::vector<unsigned char> position_stream;
+            position_stream.reserve(std::size_t(num_vertices) * 4);
+            {
+                std::int64_t prev[3] = { 0, 0, 0 };
+                for (auto v : mesh->vertices()) {
+                    const vec3& p = mesh->position(v);
+                    for (int c = 0; c < 3; ++c) {
+                        const std::int64_t q = e3dc::quantize16(p[c], box_min[c], inv_scale[c]);
+                        e3dc::append_varint(position_stream, e3dc::zigzag(q - prev[c]));
+                        prev[c] = q;
+                    }
+                }
+            }
+
+            // connectivity: per face the valence, then each vertex index as a delta from the
+            // previously written index
+            std::vector<unsigned char> face_stream;
+            face_stream.reserve(std::size_t(mesh->n_faces()) * 5);
+            {
+                std::int64_t prev = 0;
+                for (auto f : mesh->faces()) {
+                    e3dc::append_varint(face_stream, mesh->valence(f));
+                    for (auto v : mesh->vertices(f)) {
+                        const std::int64_t index = new_index[v.idx()];
+                        e3dc::append_varint(face_stream, e3dc::zigzag(index - prev));
+                        prev = index;
+                    }
+                }
+            }
+
+            // optional attributes (all delta-coded like the positions)
+            std::vector<unsigned char> normal_stream, color_stream, texcoord_stream;
+            if (normals) {
+                std::int64_t prev[2] = { 0, 0 };
+                for (auto v : mesh->vertices()) {
+                    const std::uint32_t code = PointCloudQuantization::encode_normal(normals[v]);
+                    const std::int64_t q[2] = { code & 0xffff, code >> 16 };
+                    for (int c = 0; c < 2; ++c) {
+                        e3dc::append_varint(normal_stream, e3dc::zigzag(q[c] - prev[c]));
+                        prev[c] = q[c];
+                    }
+                }
+            }
+            if (colors) {
+                std::int64_t prev[3] = { 0, 0, 0 };
+                for (auto v : mesh->vertices()) {
+                    const vec3& c = colors[v];
+                    for (int i = 0; i < 3; ++i) {
+                        const std::int64_t q = static_cast<std::int64_t>(
+                                std::min(std::max(c[i] * 255.0f + 0.5f, 0.0f), 255.0f));
+                        e3dc::append_varint(color_stream, e3dc::zigzag(q - prev[i]));
+                        prev[i] = q;
+                    }
+                }
+            }
+            vec2 tex_min(0, 0), tex_max(0, 0);
+            if (texcoords) {
+                tex_min = vec2(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+                tex_max = -tex_min;
+                for (auto v : mesh->vertices()) {
+                    const vec2& t = texcoords[v];
+                    for (int c = 0; c < 2; ++c) {
+                        tex_min[c] = std::min(tex_min[c], t[c]);
+                        tex_max[c] = std::max(tex_max[c], t[c]);
+                    }
+                }
+                float tex_inv[2];
+                for (int c = 0; c < 2; ++c) {
+                    const float range = tex_max[c] - tex_min[c];
+                    tex_inv[c] = range > 0.0f ? 65535.0f / range : 0.0f;
+                }
+                std::int64_t prev[2] = { 0, 0 };
+                for (auto v : mesh->vertices()) {
+                    const vec2& t = texcoords[v];
+                    for (int c = 0; c < 2; ++c) {
+                        const std::int64_t q = e3dc::quantize16(t[c], tex_min[c], tex_inv[c]);
+                        e3dc::append_varint(texcoord_stream, e3dc::zigzag(q - prev[c]));
+                        prev[c] = q;
+                    }
+                }
+            }
+
+            output.write(e3dc::MAGIC, 4);
+            e3dc::write_uint32(output, e3dc::VERSION);
+            e3dc::write_uint32(output, flags);
+            e3dc::write_uint64(output, num_vertices);
+            e3dc::write_uint64(output, mesh->n_faces());
+            for (int c = 0; c < 3; ++c) e3dc::write_float(output, box_min[c]);
+            for (int c = 0; c < 3; ++c) e3dc::write_float(output, box_max[c]);
+            for (int c = 0; c < 2; ++c) e3dc::write_float(output, tex_min[c]);
+            for (int c = 0; c < 2; ++c) e3dc::write_float(output, tex_max[c]);
+
+            e3dc::write_stream(output, position_stream);
+            e3dc::write_stream(output, face_stream);
+            if (normals)    e3dc::write_stream(output, normal_stream);
+            if (colors)     e3dc::write_stream(output, color_stream);
+            if (texcoords)  e3dc::write_stream(output, texcoord_stream);
+
+            return output.good();
+        }
+
+
+        bool load_e3dc(const std::string& file_name, SurfaceMesh* mesh)
+        {
+            if (!mesh) {
+                LOG(ERROR) << "null mesh pointer";
+                return false;
+            }
+
+            std::ifstream input(file_name.c_str(), std::fstream::binary);
+            if (input.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            char magic[4];
+            input.read(magic, 4);
+            if (!input.good() || std::memcmp(magic, e3dc::MAGIC, 4) != 0) {
+                LOG(ERROR) << "not an e3dc file: " << file_name;
+                return false;
+            }
+            const std::uint32_t version = e3dc::read_uint32(input);
+            if (version != e3dc::VERSION) {
+                LOG(ERROR) << "unsupported e3dc version: " << version;
+                return false;
+            }
+
+            const std::uint32_t flags = e3dc::read_uint32(input);
+            const std::uint64_t num_vertices = e3dc::read_uint64(input);
+            const std::uint64_t num_faces = e3dc::read_uint64(input);
+            vec3 box_min, box_max;
+            for (int c = 0; c < 3; ++c) box_min[c] = e3dc::read_float(input);
+            for (int c = 0; c < 3; ++c) box_max[c] = e3dc::read_float(input);
+            vec2 tex_min, tex_max;
+            for (int c = 0; c < 2; ++c) tex_min[c] = e3dc::read_float(input);
+            for (int c = 0; c < 2; ++c) tex_max[c] = e3dc::read_float(input);
+            if (!input.good())
+                return false;
+
+            std::vector<unsigned char> position_stream, face_stream;
+            if (!e3dc::read_stream(input, position_stream) || !e3dc::read_stream(input, face_stream)) {
+                LOG(ERROR) << "corrupted e3dc file: " << file_name;
+                return false;
+            }
+            std::vector<unsigned char> normal_stream, color_stream, texcoord_stream;
+            if ((flags & e3dc::HAS_NORMALS) && !e3dc::read_stream(input, normal_stream))
+                return false;
+            if ((flags & e3dc::HAS_COLORS) && !e3dc::read_stream(input, color_stream))
+                return false;
+            if ((flags & e3dc::HAS_TEXCOORDS) && !e3dc::read_stream(input, texcoord_stream))
+                return false;
+
+            float scale[3];
+            for (int c = 0; c < 3; ++c)
+                scale[c] = (box_max[c] - box_min[c]) / 65535.0f;
+
+            mesh->reserve(static_cast<unsigned int>(num_vertices),
+                          static_cast<unsigned int>(num_faces * 3 / 2),
+                          static_cast<unsigned int>(num_faces));
+
+            {
+                const unsigned char* p = position_stream.data();
+                std::int64_t prev[3] = { 0, 0, 0 };
+                for (std::uint64_t i = 0; i < num_vertices; ++i) {
+                    vec3 position;
+                    for (int c = 0; c < 3; ++c) {
+                        prev[c] += e3dc::unzigzag(e3dc::read_varint(p));
+                        position[c] = box_min[c] + float(prev[c]) * scale[c];
+                    }
+                    mesh->add_vertex(position);
+                }
+            }
+
+            {
+                const unsigned char* p = face_stream.data();
+                std::int64_t prev = 0;
+                std::vector<SurfaceMesh::Vertex> face;
+                for (std::uint64_t i = 0; i < num_faces; ++i) {
+                    const std::uint64_t valence = e3dc::read_varint(p);
+                    face.resize(valence);
+                    for (std::uint64_t j = 0; j < valence; ++j) {
+                        prev += e3dc::unzigzag(e3dc::read_varint(p));
+                        if (prev < 0 || std::uint64_t(prev) >= num_vertices) {
+                            LOG(ERROR) << "corrupted e3dc file: vertex index out of range";
+                            return false;
+                        }
+                        face[j] = SurfaceMesh::Vertex(static_cast<int>(prev));
+                    }
+                    mesh->add_face(face);
+                }
+            }
+
+            if (flags & e3dc::HAS_NORMALS) {
+                auto normals = mesh->add_vertex_property<vec3>("v:normal");
+                const unsigned char* p = normal_stream.data();
+                std::int64_t prev[2] = { 0, 0 };
+                for (std::uint64_t i = 0; i < num_vertices; ++i) {
+                    prev[0] += e3dc::unzigzag(e3dc::read_varint(p));
+                    prev[1] += e3dc::unzigzag(e3dc::read_varint(p));
+                    const std::uint32_t code = std::uint32_t(prev[0]) | (std::uint32_t(prev[1]) << 16);
+                    normals[SurfaceMesh::Vertex(static_cast<int>(i))] = PointCloudQuantization::decode_normal(code);
+                }
+            }
+            if (flags & e3dc::HAS_COLORS) {
+                auto colors = mesh->add_vertex_property<vec3>("v:color");
+                const unsigned char* p = color_stream.data();
+                std::int64_t prev[3] = { 0, 0, 0 };
+                for (std::uint64_t i = 0; i < num_vertices; ++i) {
+                    vec3 color;
+                    for (int c = 0; c < 3; ++c) {
+                        prev[c] += e3dc::unzigzag(e3dc::read_varint(p));
+                        color[c] = float(prev[c]) / 255.0f;
+                    }
+                    colors[SurfaceMesh::Vertex(static_cast<int>(i))] = color;
+                }
+            }
+            if (flags & e3dc::HAS_TEXCOORDS) {
+                auto texcoords = mesh->add_vertex_property<vec2>("v:texcoord");
+                float tex_scale[2];
+                for (int c = 0; c < 2; ++c)
+                    tex_scale[c] = (tex_max[c] - tex_min[c]) / 65535.0f;
+                const unsigned char* p = texcoord_stream.data();
+                std::int64_t prev[2] = { 0, 0 };
+                for (std::uint64_t i = 0; i < num_vertices; ++i) {
+                    vec2 texcoord;
+                    for (int c = 0; c < 2; ++c) {
+                        prev[c] += e3dc::unzigzag(e3dc::read_varint(p));
+                        texcoord[c] = tex_min[c] + float(prev[c]) * tex_scale[c];
+                    }
+                    texcoords[SurfaceMesh::Vertex(static_cast<int>(i))] = texcoord;
+                }
+            }
+
+            return mesh->n_faces() > 0;
+        }
+
+    } // namespace io
+
+} // namespace easy3d
@@ -24,7 +24,16 @@
 
 #include <easy3d/fileio/surface_mesh_io.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <unordered_map>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/manifold_builder.h>
@@ -79,25 +88,16 @@ namespace easy3d {
             ManifoldBuilder builder(mesh);
             builder.begin_surface();
 
+            // add the vertices in one batch (the property arrays grow only once).
+            // Should I create vertices later, to get rid of isolated vertices?
+            std::vector<vec3> points(fom->position_count - 1); // skip the dummy first point
+            std::memcpy(points.data(), fom->positions + 3, points.size() * sizeof(vec3));
 #ifdef  TRANSLATE_RELATIVE_TO_FIRST_POINT
-            // add vertices
-            // the first point
-            auto p0 = vec3(fom->positions + 3); // index starts from 1 and the first element is dummy
-            builder.add_vertex(vec3(0, 0, 0));
-
-            // remaining points
-            for (std::size_t v = 2; v < fom->position_count; ++v) {
-                // Should I create vertices later, to get rid of isolated vertices?
-                builder.add_vertex(vec3(fom->positions + v * 3) - p0);
-            }
-#else
-            // add vertices
-            // skip the first point
-            for (std::size_t v = 1; v < fom->position_count; ++v) {
-                // Should I create vertices later, to get rid of isolated vertices?
-                builder.add_vertex(vec3(fom->positions + v * 3));
-            }
+            const vec3 p0 = points[0];
+            for (std::size_t v = 0; v < points.size(); ++v)
+                points[v] -= p0;
 #endif
+            builder.add_vertices(points);
 
             // create texture coordinate property if texture coordinates present
             SurfaceMesh::HalfedgeProperty<vec2> prop_texcoords;
@@ -129,11 +129,13 @@ namespace easy3d {
 //                    std::cout << "group name: " << std::string(grp.name) << std::endl;
 
                 unsigned int idx = 0;
+                std::vector<SurfaceMesh::Vertex> vertices;  // hoisted out of the face loop to
+                std::vector<unsigned int> texcoord_ids;     // avoid an allocation per face
                 for (unsigned int jj = 0; jj < grp.face_count; ++jj) {
                     // number of vertices in the face
                     unsigned int fv = fom->face_vertices[grp.face_offset + jj];
-                    std::vector<SurfaceMesh::Vertex> vertices;
-                    std::vector<unsigned int> texcoord_ids;
+                    vertices.clear();
+                    texcoord_ids.clear();
                     for (unsigned int kk = 0; kk < fv; ++kk) {  // for each vertex in the face
                         const fastObjIndex &mi = fom->indices[grp.index_offset + idx];
                         if (mi.p)
@@ -806,6 +808,96 @@ namespace easy3d {
     namespace io {
 
 
+        namespace details {
+
+            // \cond
+
+            // appends the decimal digits of an unsigned integer
+            inline char* append_uint(char* p, std::uint64_t value) {
+                char tmp[20];
+                int n = 0;
+                do {
+                    tmp[n++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value > 0);
+                while (n > 0)
+                    *p++ = tmp[--n];
+                return p;
+            }
+
+            // Appends a floating point value like printf("%.*f", precision, value), but through
+            // branch-light fixed-point integer arithmetic instead of the locale-aware printf
+            // machinery (an order of magnitude faster, and the digit loops vectorize well).
+            // Values outside the fixed-point range (and NaN/infinity) take the printf route.
+            inline char* append_float(char* p, double value, int precision) {
+                static const std::uint64_t pow10[] = {
+                        1, 10, 100, 1000, 10000, 100000, 1000000,
+                        10000000, 100000000, 1000000000, 10000000000ull
+                };
+                const std::uint64_t scale = pow10[precision];
+                if (!(std::fabs(value) * scale < 1.8e18))   // also catches NaN and infinity
+                    return p + std::sprintf(p, "%.*f", precision, value);
+                if (std::signbit(value)) {
+                    *p++ = '-';
+                    value = -value;
+                }
+                const std::uint64_t fixed = static_cast<std::uint64_t>(value * scale + 0.5);
+                p = append_uint(p, fixed / scale);
+                *p++ = '.';
+                std::uint64_t fraction = fixed % scale;
+                for (int i = precision - 1; i >= 0; --i) {
+                    p[i] = static_cast<char>('0' + fraction % 10);
+                    fraction /= 10;
+                }
+                return p + precision;
+            }
+
+            // Formats the elements [0, num) in parallel chunks and writes each chunk with a
+            // single large fwrite(), in order. 'format' appends the line(s) of one element and
+            // returns the new end of the buffer; 'max_element_chars' bounds the size of what a
+            // single element may append. The batching keeps the buffered text bounded,
+            // independent of the file size.
+            template <typename FormatFunc>
+            inline bool write_chunked(FILE* out, std::size_t num, std::size_t max_element_chars,
+                                      const FormatFunc& format) {
+                const std::size_t chunk_size = 64 * 1024;
+                const std::size_t num_chunks = (num + chunk_size - 1) / chunk_size;
+
+                int num_threads = 1;
+#ifdef _OPENMP
+                num_threads = omp_get_max_threads();
+#endif
+                const std::size_t chunks_per_batch = static_cast<std::size_t>(num_threads) * 4;
+                std::vector< std::vector<char> > buffers(
+                        std::min(chunks_per_batch, std::max(num_chunks, std::size_t(1))));
+
+                for (std::size_t batch = 0; batch < num_chunks; batch += chunks_per_batch) {
+                    const int batch_size = static_cast<int>(std::min(chunks_per_batch, num_chunks - batch));
+#pragma omp parallel for schedule(dynamic)
+                    for (int c = 0; c < batch_size; ++c) {
+                        std::vector<char>& buffer = buffers[c];
+                        const std::size_t begin = (batch + c) * chunk_size;
+                        const std::size_t end = std::min(num, begin + chunk_size);
+                        buffer.resize((end - begin) * max_element_chars);
+                        char* p = buffer.data();
+                        for (std::size_t i = begin; i < end; ++i)
+                            p = format(p, i);
+                        buffer.resize(p - buffer.data());
+                    }
+                    for (int c = 0; c < batch_size; ++c) {
+                        const std::vector<char>& buffer = buffers[c];
+                        if (fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size())
+                            return false;
+                    }
+                }
+                return true;
+            }
+
+            // \endcond
+
+        } // namespace details
+
+
         bool save_obj(const std::string &file_name, const SurfaceMesh *mesh) {
             if (!mesh) {
                 LOG(ERROR) << "null mesh pointer";
@@ -821,20 +913,50 @@ namespace easy3d {
             // comment
             fprintf(out, "# OBJ exported from Easy3D\n");
 
+            // The elements are formatted in parallel chunks (with the fixed-point float
+            // formatter) and written as large blocks; going through fprintf() per element
+            // dominates the export time of large meshes.
+
+            // the live elements, and the contiguous (1-based, per the OBJ format) indices they
+            // get in the file - they differ from the handle indices when the mesh has garbage
+            std::vector<SurfaceMesh::Vertex> live_vertices;
+            live_vertices.reserve(mesh->n_vertices());
+            std::vector<int> vertex_index(mesh->vertices_size(), 0);
+            for (auto v : mesh->vertices()) {
+                vertex_index[v.idx()] = static_cast<int>(live_vertices.size());
+                live_vertices.push_back(v);
+            }
+
             //vertices
             SurfaceMesh::VertexProperty<vec3> points = mesh->get_vertex_property<vec3>("v:point");
-            for (SurfaceMesh::VertexIterator vit = mesh->vertices_begin(); vit != mesh->vertices_end(); ++vit) {
-                const vec3 &p = points[*vit];
-                fprintf(out, "v %.10f %.10f %.10f\n", p[0], p[1], p[2]);
-            }
+            const std::size_t max_vertex_chars = 3 + 3 * 32 + 1;
+            bool good = details::write_chunked(out, live_vertices.size(), max_vertex_chars,
+                    [&points, &live_vertices](char* p, std::size_t i) -> char* {
+                        const vec3& v = points[live_vertices[i]];
+                        *p++ = 'v';
+                        for (int j = 0; j < 3; ++j) {
+                            *p++ = ' ';
+                            p = details::append_float(p, v[j], 10);
+                        }
+                        *p++ = '\n';
+                        return p;
+                    });
 
             //normals
             SurfaceMesh::VertexProperty<vec3> normals = mesh->get_vertex_property<vec3>("v:normal");
-            if (normals) {
-                for (SurfaceMesh::VertexIterator vit = mesh->vertices_begin(); vit != mesh->vertices_end(); ++vit) {
-                    const vec3 &p = normals[*vit];
-                    fprintf(out, "vn %.10f %.10f %.10f\n", p[0], p[1], p[2]);
-                }
+            if (normals && good) {
+                good = details::write_chunked(out, live_vertices.size(), max_vertex_chars,
+                        [&normals, &live_vertices](char* p, std::size_t i) -> char* {
+                            const vec3& n = normals[live_vertices[i]];
+                            *p++ = 'v';
+                            *p++ = 'n';
+                            for (int j = 0; j < 3; ++j) {
+                                *p++ = ' ';
+                                p = details::append_float(p, n[j], 10);
+                            }
+                            *p++ = '\n';
+                            return p;
+                        });
             }
 
             //optionally texture coordinates
@@ -851,35 +973,74 @@ namespace easy3d {
             }
 
             //if so then add
-            if (with_tex_coord) {
-                SurfaceMesh::HalfedgeProperty<vec2> tex_coord = mesh->get_halfedge_property<vec2>("h:texcoord");
-                for (SurfaceMesh::HalfedgeIterator hit = mesh->halfedges_begin();
-                     hit != mesh->halfedges_end(); ++hit) {
-                    const vec2 &pt = tex_coord[*hit];
-                    fprintf(out, "vt %.10f %.10f\n", pt[0], pt[1]);
+            std::vector<int> halfedge_index;
+            if (with_tex_coord && good) {
+                std::vector<SurfaceMesh::Halfedge> live_halfedges;
+                live_halfedges.reserve(mesh->n_halfedges());
+                halfedge_index.resize(mesh->halfedges_size(), 0);
+                for (auto h : mesh->halfedges()) {
+                    halfedge_index[h.idx()] = static_cast<int>(live_halfedges.size());
+                    live_halfedges.push_back(h);
                 }
+
+                SurfaceMesh::HalfedgeProperty<vec2> tex_coord = mesh->get_halfedge_property<vec2>("h:texcoord");
+                good = details::write_chunked(out, live_halfedges.size(), 4 + 2 * 32,
+                        [&tex_coord, &live_halfedges](char* p, std::size_t i) -> char* {
+                            const vec2& t = tex_coord[live_halfedges[i]];
+                            *p++ = 'v';
+                            *p++ = 't';
+                            for (int j = 0; j < 2; ++j) {
+                                *p++ = ' ';
+                                p = details::append_float(p, t[j], 10);
+                            }
+                            *p++ = '\n';
+                            return p;
+                        });
             }
 
             //faces
-            for (SurfaceMesh::FaceIterator fit = mesh->faces_begin(); fit != mesh->faces_end(); ++fit) {
-                fprintf(out, "f");
-                SurfaceMesh::VertexAroundFaceCirculator fvit = mesh->vertices(*fit), fvend = fvit;
-                SurfaceMesh::HalfedgeAroundFaceCirculator fhit = mesh->halfedges(*fit);
-                do {
-                    if (with_tex_coord) {
-                        // write vertex index, tex_coord index and normal index
-                        fprintf(out, " %d/%d/%d", (*fvit).idx() + 1, (*fhit).idx() + 1, (*fvit).idx() + 1);
-                        ++fhit;
-                    } else {
-                        // write vertex index and normal index
-                        fprintf(out, " %d//%d", (*fvit).idx() + 1, (*fvit).idx() + 1);
-                    }
-                } while (++fvit != fvend);
-                fprintf(out, "\n");
+            if (good) {
+                std::vector<SurfaceMesh::Face> live_faces;
+                live_faces.reserve(mesh->n_faces());
+                std::size_t max_valence = 3;
+                for (auto f : mesh->faces()) {
+                    max_valence = std::max(max_valence, std::size_t(mesh->valence(f)));
+                    live_faces.push_back(f);
+                }
+                const std::size_t max_face_chars = 2 + max_valence * (3 * 11 + 3);
+                good = details::write_chunked(out, live_faces.size(), max_face_chars,
+                        [mesh, with_tex_coord, &live_faces, &vertex_index, &halfedge_index](
+                                char* p, std::size_t i) -> char* {
+                            const SurfaceMesh::Face f = live_faces[i];
+                            *p++ = 'f';
+                            SurfaceMesh::VertexAroundFaceCirculator fvit = mesh->vertices(f), fvend = fvit;
+                            SurfaceMesh::HalfedgeAroundFaceCirculator fhit = mesh->halfedges(f);
+                            do {
+                                *p++ = ' ';
+                                if (with_tex_coord) {
+                                    // write vertex index, tex_coord index and normal index
+                                    p = details::append_uint(p, vertex_index[(*fvit).idx()] + 1);
+                                    *p++ = '/';
+                                    p = details::append_uint(p, halfedge_index[(*fhit).idx()] + 1);
+                                    *p++ = '/';
+                                    p = details::append_uint(p, vertex_index[(*fvit).idx()] + 1);
+                                    ++fhit;
+                                } else {
+                                    // write vertex index and normal index
+                                    p = details::append_uint(p, vertex_index[(*fvit).idx()] + 1);
+                                    *p++ = '/';
+                                    *p++ = '/';
+                                    p = details::append_uint(p, vertex_index[(*fvit).idx()] + 1);
+                                }
+                            } while (++fvit != fvend);
+                            *p++ = '\n';
+                            return p;
+                        });
             }
 
             fclose(out);
-            return true;
+            LOG_IF(ERROR, !good) << "failed writing file: " << file_name;
+            return good;
         }
 
 
@@ -26,11 +26,18 @@
 #include <easy3d/core/types.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/manifold_builder.h>
-#include <easy3d/util/line_stream.h>
 #include <easy3d/util/logging.h>
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
-#include <cstring> // for strlen()
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 #define RESOLVE_NONMANIFOLDNESS    1
@@ -40,18 +47,39 @@ namespace easy3d {
 	namespace io {
 
         namespace details {
-            // Some OFF files may skip lines or may have comments starting with '#'
-            static void get_line(LineInputStream& in) {
-                in.get_line() ;
-                const char* p =  in.current_line().c_str();
-                while (!in.eof() && (
-                        (strlen(p) == 0 || !isprint(*p)) || // empty line
-                        (strlen(p) > 0 && p[0] == '#')
-                )) {
-                    in.get_line() ;
-                    p = in.current_line().c_str();
+            // \cond
+
+            // a line counts (like in the stream-based parser before) unless it is empty, is a
+            // comment starting with '#', or its first character is not printable
+            static inline bool valid_line(const char* p, const char* end) {
+                return p < end && *p != '\n' && *p != '#' && isprint(static_cast<unsigned char>(*p));
+            }
+
+            // advances to the beginning of the next line
+            static inline const char* next_line(const char* p, const char* end) {
+                const char* n = static_cast<const char*>(memchr(p, '\n', end - p));
+                return n ? (n + 1) : end;
+            }
+
+            // Walks 'count' valid lines from 'pos' and records the start of every 'stride'-th one,
+            // so the recorded chunks can be re-walked and parsed independently (and in parallel).
+            // Returns the position right after the last counted line ('end' if the file is short).
+            static const char* collect_chunks(const char* pos, const char* end, std::size_t count,
+                                              std::size_t stride, std::vector<const char*>& chunks) {
+                chunks.clear();
+                std::size_t i = 0;
+                while (i < count && pos < end) {
+                    if (valid_line(pos, end)) {
+                        if (i % stride == 0)
+                            chunks.push_back(pos);
+                        ++i;
+                    }
+                    pos = next_line(pos, end);
                 }
+                return pos;
             }
+
+            // \endcond
         }
 
 		bool load_off(const std::string& file_name, SurfaceMesh* mesh)
@@ -61,7 +89,7 @@ namespace easy3d {
 				return false;
 			}
 
-            std::ifstream in(file_name.c_str()) ;
+            std::ifstream in(file_name.c_str(), std::fstream::binary);
             if(in.fail()) {
 				LOG(ERROR) << "Could not open file: " << file_name;
                 return false ;
@@ -69,84 +97,193 @@ namespace easy3d {
 
             mesh->clear();
 
-#if RESOLVE_NONMANIFOLDNESS
-            ManifoldBuilder builder(mesh);
-            builder.begin_surface();
-#endif
+            // Read the whole file and scan the tokens in place with strtod/strtol. This avoids the
+            // per-value overhead of stream extraction, and the vertex and face blocks can then be
+            // parsed in parallel chunks (the same architecture as the xyz reader).
+            in.seekg(0, std::ios::end);
+            const std::size_t data_size = in.tellg();
+            in.seekg(0, std::ios::beg);
+            std::vector<char> buffer(data_size + 1);
+            in.read(buffer.data(), data_size);
+            buffer[data_size] = '\0';
+
+            const char* pos = buffer.data();
+            const char* end = buffer.data() + data_size;
+            while (pos < end && !details::valid_line(pos, end))
+                pos = details::next_line(pos, end);
 
             // Vertex index starts by 0 in off format.
-
-            LineInputStream input(in) ;
-            details::get_line(input) ;
-
-            std::string magic ;
-            input >> magic ;
-
-            // NOFF is for Grimage "visual shapes".
-            if(magic != "OFF" && magic != "NOFF") {
-				LOG(ERROR) << "Not an OFF file. Key word is: " << magic;
+            // NOFF is for Grimage "visual shapes"; its element counts follow the key word on the
+            // same line.
+            char* cursor = nullptr;
+            if (strncmp(pos, "NOFF", 4) == 0)
+                cursor = const_cast<char*>(pos) + 4;
+            else if (strncmp(pos, "OFF", 3) == 0) {
+                pos = details::next_line(pos, end);
+                while (pos < end && !details::valid_line(pos, end))
+                    pos = details::next_line(pos, end);
+                cursor = const_cast<char*>(pos);
+            }
+            else {
+                const char* token_end = pos;
+                while (token_end < end && !isspace(static_cast<unsigned char>(*token_end)))
+                    ++token_end;
+				LOG(ERROR) << "Not an OFF file. Key word is: " << std::string(pos, token_end);
                 return false;
             }
 
-            if(magic != "NOFF") {
-                details::get_line(input) ;
+            char* parse_end = nullptr;
+            const std::size_t nb_vertices = strtoul(cursor, &parse_end, 10);
+            if (parse_end == cursor) {
+				LOG(ERROR) << "An error in the file header";
+                return false;
             }
-
-            int nb_vertices, nb_facets, nb_edges;
-            input >> nb_vertices >> nb_facets >> nb_edges;
-            if (input.fail()) {
-				LOG(ERROR) << "An error in the file header: " << input.current_line();
+            cursor = parse_end;
+            const std::size_t nb_facets = strtoul(cursor, &parse_end, 10);
+            if (parse_end == cursor) {
+				LOG(ERROR) << "An error in the file header";
                 return false;
             }
+            cursor = parse_end;
+            strtoul(cursor, &parse_end, 10);    // the edge count; edges are ignored anyway
+            pos = details::next_line(parse_end, end);
+
+            const std::size_t lines_per_chunk = 4096;
+            std::vector<const char*> chunks;
+
+            // ------------------------------------------------------------------------------------
+            // the vertex block: every chunk parses its lines straight into the preallocated array
+
+            const char* faces_pos = details::collect_chunks(pos, end, nb_vertices, lines_per_chunk, chunks);
+
+            std::vector<vec3> points(nb_vertices, vec3(0, 0, 0));
+            std::size_t num_failed = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+:num_failed)
+            for (int c = 0; c < static_cast<int>(chunks.size()); ++c) {
+                const char* p = chunks[c];
+                const std::size_t base = static_cast<std::size_t>(c) * lines_per_chunk;
+                const std::size_t count = std::min(lines_per_chunk, nb_vertices - base);
+                std::size_t i = 0;
+                while (i < count && p < end) {
+                    if (details::valid_line(p, end)) {
+                        const char* line_end = static_cast<const char*>(memchr(p, '\n', end - p));
+                        if (!line_end)
+                            line_end = end;
+                        char* q = const_cast<char*>(p);
+                        char* q_end = nullptr;
+                        vec3 v;
+                        bool good = true;
+                        for (int k = 0; k < 3; ++k) {   // extra fields (e.g., NOFF normals) are ignored
+                            const double value = strtod(q, &q_end);
+                            if (q_end == q || q_end > line_end) {
+                                good = false;
+                                break;
+                            }
+                            v[k] = static_cast<float>(value);
+                            q = q_end;
+                        }
+                        if (good)
+                            points[base + i] = v;
+                        else
+                            ++num_failed;
+                        ++i;
+                    }
+                    p = details::next_line(p, end);
+                }
+                num_failed += count - i;    // the file ended early
+            }
+            LOG_IF(ERROR, num_failed > 0) << "failed parsing " << num_failed << " of the "
+                                          << nb_vertices << " vertices";
 
-            for (int i = 0; i < nb_vertices; i++) {
-                vec3 p;
-                details::get_line(input);
-                input >> p;
-                if (!input.fail()) {
 #if RESOLVE_NONMANIFOLDNESS
-                    builder.add_vertex(p);
+            ManifoldBuilder builder(mesh);
+            builder.begin_surface();
+            for (std::size_t i = 0; i < nb_vertices; ++i)
+                builder.add_vertex(points[i]);
 #else
-                    mesh->add_vertex(p);
+            for (std::size_t i = 0; i < nb_vertices; ++i)
+                mesh->add_vertex(points[i]);
 #endif
-                }
-                else {
-                    LOG_FIRST_N(ERROR, 1) << "failed reading the " << i << "_th vertex from file (this is the first record)";
-                }
-            }
 
-            for (int i = 0; i < nb_facets; i++) {
-                int nb_vertices;
-                details::get_line(input);
-                input >> nb_vertices;
-
-				if (!input.fail()) {
-					std::vector<SurfaceMesh::Vertex> vertices;
-					for (int j = 0; j < nb_vertices; j++) {
-						int index;
-						input >> index;
-						if (!input.fail()) {
-                            vertices.emplace_back(SurfaceMesh::Vertex(index));
-                        }
-                        else {
-                            LOG_FIRST_N(ERROR, 1) << "failed reading the " << j << "_th vertex of the " << i << "_th face from file (this is the first record)";
+            // ------------------------------------------------------------------------------------
+            // the face block: chunks are tokenized in parallel into flat (valence, indices...)
+            // buffers and fed to the builder one batch at a time, in file order. The batching keeps
+            // the memory for the decoded indices bounded, independent of the file size.
+
+            details::collect_chunks(faces_pos, end, nb_facets, lines_per_chunk, chunks);
+
+            int num_threads = 1;
+#ifdef _OPENMP
+            num_threads = omp_get_max_threads();
+#endif
+            const std::size_t chunks_per_batch = static_cast<std::size_t>(num_threads) * 4;
+            std::vector< std::vector<int> > chunk_data(std::min(chunks_per_batch, std::max(chunks.size(), std::size_t(1))));
+
+            std::size_t num_failed_faces = 0;
+            std::vector<SurfaceMesh::Vertex> vertices;
+            for (std::size_t batch = 0; batch < chunks.size(); batch += chunks_per_batch) {
+                const int batch_size = static_cast<int>(std::min(chunks_per_batch, chunks.size() - batch));
+#pragma omp parallel for schedule(dynamic) reduction(+:num_failed_faces)
+                for (int c = 0; c < batch_size; ++c) {
+                    std::vector<int>& data = chunk_data[c];
+                    data.clear();
+                    const char* p = chunks[batch + c];
+                    const std::size_t base = (batch + c) * lines_per_chunk;
+                    const std::size_t count = std::min(lines_per_chunk, nb_facets - base);
+                    std::size_t i = 0;
+                    while (i < count && p < end) {
+                        if (details::valid_line(p, end)) {
+                            const char* line_end = static_cast<const char*>(memchr(p, '\n', end - p));
+                            if (!line_end)
+                                line_end = end;
+                            char* q = const_cast<char*>(p);
+                            char* q_end = nullptr;
+                            const long valence = strtol(q, &q_end, 10);
+                            bool good = (q_end != q && q_end <= line_end && valence > 0);
+                            if (good) {
+                                q = q_end;
+                                const std::size_t record_begin = data.size();
+                                data.push_back(static_cast<int>(valence));
+                                for (long j = 0; j < valence; ++j) {
+                                    const long index = strtol(q, &q_end, 10);
+                                    if (q_end == q || q_end > line_end) {
+                                        good = false;
+                                        data.resize(record_begin);  // drop the partial record
+                                        break;
+                                    }
+                                    data.push_back(static_cast<int>(index));
+                                    q = q_end;
+                                }
+                            }
+                            if (!good)
+                                ++num_failed_faces;
+                            ++i;
                         }
-					}
+                        p = details::next_line(p, end);
+                    }
+                    num_failed_faces += count - i;  // the file ended early
+                }
+
+                // feed this batch to the builder, in file order
+                for (int c = 0; c < batch_size; ++c) {
+                    const std::vector<int>& data = chunk_data[c];
+                    for (std::size_t k = 0; k < data.size(); ) {
+                        const int valence = data[k++];
+                        vertices.clear();
+                        for (int j = 0; j < valence; ++j)
+                            vertices.emplace_back(SurfaceMesh::Vertex(data[k++]));
 #if RESOLVE_NONMANIFOLDNESS
-					builder.add_face(vertices);
+                        builder.add_face(vertices);
 #else
-                    mesh->add_face(vertices);
+                        mesh->add_face(vertices);
 #endif
-				}
-                else {
-                    LOG_FIRST_N(ERROR, 1) << "failed reading the " << i << "_th face from file (this is the first record)";
+                    }
                 }
             }
+            LOG_IF(ERROR, num_failed_faces > 0) << "failed parsing " << num_failed_faces << " of the "
+                                                << nb_facets << " faces";
 
             // for mesh models, we can simply ignore the edges.
-//            for (int i = 0; i < nb_edges; i++) {
-//                // read the edges
-//            }
 
 #if RESOLVE_NONMANIFOLDNESS
             builder.end_surface();
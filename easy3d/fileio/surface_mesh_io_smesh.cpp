@@ -77,13 +77,25 @@ namespace easy3d {
 
             // get properties
             auto vconn = mesh->vertex_property<SurfaceMesh::VertexConnectivity>("v:connectivity");
-			auto hconn = mesh->halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
 			auto fconn = mesh->face_property<SurfaceMesh::FaceConnectivity>("f:connectivity");
 			auto point = mesh->vertex_property<vec3>("v:point");
 
             // read properties from file
             input.read((char*)vconn.data(), nv * sizeof(SurfaceMesh::VertexConnectivity)  );
+#ifdef EASY3D_SOA_CONNECTIVITY
+            // the file stores the halfedge connectivity as an array of structs: scatter into the SoA layout
+            std::vector<SurfaceMesh::HalfedgeConnectivity> hconn(nh);
             input.read((char*)hconn.data(), nh * sizeof(SurfaceMesh::HalfedgeConnectivity));
+            for (unsigned int i = 0; i < nh; ++i) {
+                const SurfaceMesh::Halfedge h(i);
+                mesh->set_face(h, hconn[i].face_);
+                mesh->set_target(h, hconn[i].vertex_);
+                mesh->set_next(h, hconn[i].next_);
+            }
+#else
+            auto hconn = mesh->halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
+            input.read((char*)hconn.data(), nh * sizeof(SurfaceMesh::HalfedgeConnectivity));
+#endif
             input.read((char*)fconn.data(), nf * sizeof(SurfaceMesh::FaceConnectivity)    );
             input.read((char*)point.data(), nv * sizeof(vec3)                             );
 
@@ -129,13 +141,26 @@ namespace easy3d {
 
             // get properties
 			auto vconn = mesh->get_vertex_property<SurfaceMesh::VertexConnectivity>("v:connectivity");
-            auto hconn = mesh->get_halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
             auto fconn = mesh->get_face_property<SurfaceMesh::FaceConnectivity>("f:connectivity");
             auto point = mesh->get_vertex_property<vec3>("v:point");
 
             // write properties to file
             output.write((char*)vconn.data(), nv * sizeof(SurfaceMesh::VertexConnectivity));
+#ifdef EASY3D_SOA_CONNECTIVITY
+            // the file stores the halfedge connectivity as an array of structs: gather from the SoA layout
+            std::vector<SurfaceMesh::HalfedgeConnectivity> hconn(nh);
+            for (unsigned int i = 0; i < nh; ++i) {
+                const SurfaceMesh::Halfedge h(i);
+                hconn[i].face_   = mesh->face(h);
+                hconn[i].vertex_ = mesh->target(h);
+                hconn[i].next_   = mesh->next(h);
+                hconn[i].prev_   = mesh->prev(h);
+            }
+            output.write((char*)hconn.data(), nh * sizeof(SurfaceMesh::HalfedgeConnectivity));
+#else
+            auto hconn = mesh->get_halfedge_property<SurfaceMesh::HalfedgeConnectivity>("h:connectivity");
             output.write((char*)hconn.data(), nh * sizeof(SurfaceMesh::HalfedgeConnectivity));
+#endif
             output.write((char*)fconn.data(), nf * sizeof(SurfaceMesh::FaceConnectivity));
             output.write((char*)point.data(), nv * sizeof(vec3));
 
@@ -24,13 +24,20 @@
 
 #include <easy3d/fileio/surface_mesh_io.h>
 
+#include <atomic>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <map>
 #include <fstream>
 #include <cfloat>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <easy3d/core/surface_mesh.h>
+#include <easy3d/core/hash.h>
 #include <easy3d/core/manifold_builder.h>
 #include <easy3d/util/logging.h>
 
@@ -80,6 +87,132 @@ namespace easy3d {
 		//-----------------------------------------------------------------------------
 
 
+        // hashes the bit patterns of the coordinates with the block hash of hash.h.
+        // -0.0 is mapped to +0.0 so that both representations of zero hash identically;
+        // equality itself is tested with the float comparison operators.
+        static inline std::size_t hash_point(const vec3& p)
+        {
+            std::uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            for (int i = 0; i < 3; ++i) {
+                if (bits[i] == 0x80000000u)     // -0.0f
+                    bits[i] = 0;
+            }
+            return static_cast<std::size_t>(hash_bytes(bits, sizeof(bits)));
+        }
+
+
+        // parses a binary STL file: the facet records have a fixed size, so the corner
+        // positions of all facets are gathered in parallel, and duplicate vertices are
+        // merged with a lock-free open-addressing hash table keyed on the coordinate
+        // bit patterns (matching the exact comparison of the serial reader).
+        static bool load_binary_stl(const std::string& file_name, SurfaceMesh* mesh)
+        {
+            std::ifstream input(file_name.c_str(), std::fstream::binary);
+            if (input.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            input.seekg(0, input.end);
+            const std::size_t file_size = static_cast<std::size_t>(input.tellg());
+            input.seekg(0, input.beg);
+            if (file_size < 84) {   // 80-byte header + triangle count
+                LOG(ERROR) << "invalid binary STL file: " << file_name;
+                return false;
+            }
+            std::vector<char> buffer(file_size);
+            input.read(buffer.data(), static_cast<std::streamsize>(file_size));
+            input.close();
+
+            std::uint32_t nT = 0;
+            std::memcpy(&nT, buffer.data() + 80, sizeof(nT));
+            const std::size_t stride = 50;  // normal (12) + three vertices (36) + attributes (2)
+            if (nT == 0 || file_size < 84 + std::size_t(nT) * stride) {
+                LOG(ERROR) << "invalid binary STL file: " << file_name;
+                return false;
+            }
+            const char* facets = buffer.data() + 84;
+
+            // gather the corner positions of all facets (the normals are not used)
+            const std::size_t num_corners = std::size_t(nT) * 3;
+            std::vector<vec3> corners(num_corners);
+#pragma omp parallel for
+            for (int t = 0; t < static_cast<int>(nT); ++t)
+                std::memcpy(&corners[std::size_t(t) * 3], facets + std::size_t(t) * stride + 12,
+                            3 * sizeof(vec3));
+
+            // concurrent open-addressing hash table: a slot stores the index of the first
+            // corner with that position, or -1 if empty. Linear probing; the capacity is a
+            // power of two at least twice the number of corners, so the load factor stays
+            // below 0.5.
+            std::size_t capacity = 64;
+            while (capacity < num_corners * 2)
+                capacity <<= 1;
+            const std::size_t mask = capacity - 1;
+            std::vector< std::atomic<int> > table(capacity);
+#pragma omp parallel for
+            for (long long i = 0; i < static_cast<long long>(capacity); ++i)
+                table[i].store(-1, std::memory_order_relaxed);
+
+            // for every corner, the index of the representative corner with the same position
+            std::vector<int> ref(num_corners);
+#pragma omp parallel for
+            for (long long i = 0; i < static_cast<long long>(num_corners); ++i) {
+                const vec3& p = corners[i];
+                std::size_t slot = hash_point(p) & mask;
+                for (;;) {
+                    int cur = table[slot].load(std::memory_order_relaxed);
+                    if (cur < 0) {
+                        if (table[slot].compare_exchange_weak(cur, static_cast<int>(i),
+                                                              std::memory_order_relaxed))
+                        {
+                            ref[i] = static_cast<int>(i);
+                            break;
+                        }
+                        continue;   // another thread claimed the slot; re-examine it
+                    }
+                    if (corners[cur] == p) {
+                        ref[i] = cur;
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+            }
+
+            // build the mesh. The vertices are added in order of first occurrence (which is
+            // deterministic), the faces through the ManifoldBuilder as in the serial path.
+            mesh->clear();
+            ManifoldBuilder builder(mesh);
+            builder.begin_surface();
+
+            std::vector<int> vertex_of(num_corners, -1);    // representative corner -> vertex index
+            for (std::size_t i = 0; i < num_corners; ++i) {
+                const int rep = ref[i];
+                if (vertex_of[rep] < 0)
+                    vertex_of[rep] = builder.add_vertex(corners[rep]).idx();
+            }
+
+            std::vector<SurfaceMesh::Vertex> vertices(3);
+            for (std::size_t t = 0; t < nT; ++t) {
+                for (std::size_t i = 0; i < 3; ++i)
+                    vertices[i] = SurfaceMesh::Vertex(vertex_of[ref[t * 3 + i]]);
+
+                // Add face only if it is not degenerated
+                if ((vertices[0] != vertices[1]) &&
+                    (vertices[0] != vertices[2]) &&
+                    (vertices[1] != vertices[2]))
+                    builder.add_face(vertices);
+            }
+
+            builder.end_surface();
+            return mesh->n_faces() > 0;
+        }
+
+
+		//-----------------------------------------------------------------------------
+
+
 		bool load_stl(const std::string& file_name, SurfaceMesh* mesh)
 		{
 			if (!mesh) {
@@ -88,23 +221,16 @@ namespace easy3d {
 			}
 
 			char                            line[100], *c;
-			unsigned int                    i, nT;
+			unsigned int                    i;
 			vec3                           p;
 			SurfaceMesh::Vertex               v;
 			std::vector<SurfaceMesh::Vertex>  vertices(3);
-			size_t n_items(0);
 
 			CmpVec comp(FLT_MIN);
 			std::map<vec3, SurfaceMesh::Vertex, CmpVec>            vMap(comp);
 			std::map<vec3, SurfaceMesh::Vertex, CmpVec>::iterator  vMapIt;
 
 
-			// clear mesh
-			mesh->clear();
-
-            ManifoldBuilder builder(mesh);
-            builder.begin_surface();
-
 			// open file (in ASCII mode)
 			FILE* in = fopen(file_name.c_str(), "r");
             if (!in) {
@@ -120,62 +246,22 @@ namespace easy3d {
 				(strncmp(line, "solid", 5) != 0));
 
 
-			// parse binary STL
+			// parse binary STL (chunked, parallel)
 			if (binary)
 			{
-				// re-open file in binary mode
 				fclose(in);
-				in = fopen(file_name.c_str(), "rb");
-				if (!in) return false;
-
-				// skip dummy header
-				n_items = fread(line, 1, 80, in);
-				assert(n_items > 0);
-
-				// read number of triangles
-				read(in, nT);
-
-				// read triangles
-				while (nT)
-				{
-					// skip triangle normal
-					n_items = fread(line, 1, 12, in);
-					assert(n_items > 0);
-					// triangle's vertices
-					for (i = 0; i < 3; ++i)
-					{
-						read(in, p);
+				return load_binary_stl(file_name, mesh);
+			}
 
-						// has vector been referenced before?
-						if ((vMapIt = vMap.find(p)) == vMap.end())
-						{
-							// No : add vertex and remember idx/vector mapping
-							v = builder.add_vertex(p);
-							vertices[i] = v;
-							vMap[p] = v;
-						}
-						else
-						{
-							// Yes : get index from map
-							vertices[i] = vMapIt->second;
-						}
-					}
 
-					// Add face only if it is not degenerated
-					if ((vertices[0] != vertices[1]) &&
-						(vertices[0] != vertices[2]) &&
-						(vertices[1] != vertices[2]))
-						builder.add_face(vertices);
+			// clear mesh
+			mesh->clear();
 
-					n_items = fread(line, 1, 2, in);
-					assert(n_items > 0);
-					--nT;
-				}
-			}
+            ManifoldBuilder builder(mesh);
+            builder.begin_surface();
 
 
 			// parse ASCII STL
-			else
 			{
 				// parse line by line
 				while (in && !feof(in) && fgets(line, 100, in))
@@ -233,7 +319,10 @@ namespace easy3d {
 
 		//-----------------------------------------------------------------------------
 
-        // currently we save in ASCII format
+        // Saves in the binary format: the facet records have a fixed size (50 bytes), so they
+        // are assembled into flat chunk buffers on all cores and written as large blocks. This
+        // is both an order of magnitude smaller and far faster to write (and to parse back)
+        // than formatting the facets through stream operators in the ASCII dialect.
 		bool save_stl(const std::string& file_name, const SurfaceMesh* mesh)
 		{
 			if (!mesh) {
@@ -248,14 +337,8 @@ namespace easy3d {
 			}
 
 			auto fnormals = mesh->get_face_property<vec3>("f:normal");
-			if (!fnormals)
-			{
-				fnormals = const_cast<SurfaceMesh*>(mesh)->add_face_property<vec3>("f:normal");
-				for (auto f : mesh->faces())
-					fnormals[f] = mesh->compute_face_normal(f);
-			}
 
-			std::ofstream ofs(file_name.c_str());
+			std::ofstream ofs(file_name.c_str(), std::fstream::binary);
             if (ofs.fail()) {
                 LOG(ERROR) << "could not open file: " << file_name;
                 return false;
@@ -263,28 +346,64 @@ namespace easy3d {
 
 			auto points = mesh->get_vertex_property<vec3>("v:point");
 
-			ofs << "solid stl" << std::endl;
-			vec3 n;
-			vec3 p;
-
+			// the live faces (they differ from the handle indices when the mesh has garbage)
+			std::vector<SurfaceMesh::Face> faces;
+			faces.reserve(mesh->n_faces());
 			for (auto f : mesh->faces())
-			{
-				n = fnormals[f];
-				ofs << "  facet normal ";
-				ofs << n[0] << " " << n[1] << " " << n[2] << std::endl;
-				ofs << "    outer loop" << std::endl;
-				for (auto v : mesh->vertices(f))
-				{
-					p = points[v];
-					ofs << "      vertex ";
-					ofs << p[0] << " " << p[1] << " " << p[2] << std::endl;
+				faces.push_back(f);
+
+			// 80-byte header + triangle count
+			char header[80] = "binary STL exported from Easy3D";
+			ofs.write(header, sizeof(header));
+			const std::uint32_t nT = static_cast<std::uint32_t>(faces.size());
+			ofs.write(reinterpret_cast<const char*>(&nT), sizeof(nT));
+
+			// the facet records: normal (12) + three vertices (36) + attributes (2), packed.
+			// The chunks are assembled in parallel; the buffered data stays bounded (the
+			// chunks of one batch), independent of the mesh size.
+			const std::size_t stride = 50;
+			const std::size_t chunk_size = 64 * 1024;
+			const std::size_t num_chunks = (faces.size() + chunk_size - 1) / chunk_size;
+
+			int num_threads = 1;
+#ifdef _OPENMP
+			num_threads = omp_get_max_threads();
+#endif
+			const std::size_t chunks_per_batch = static_cast<std::size_t>(num_threads) * 4;
+			std::vector< std::vector<char> > buffers(
+					std::min(chunks_per_batch, std::max(num_chunks, std::size_t(1))));
+
+			bool good = true;
+			for (std::size_t batch = 0; batch < num_chunks && good; batch += chunks_per_batch) {
+				const int batch_size = static_cast<int>(std::min(chunks_per_batch, num_chunks - batch));
+#pragma omp parallel for schedule(dynamic)
+				for (int c = 0; c < batch_size; ++c) {
+					const std::size_t begin = (batch + c) * chunk_size;
+					const std::size_t end = std::min(faces.size(), begin + chunk_size);
+					std::vector<char>& buffer = buffers[c];
+					buffer.resize((end - begin) * stride);
+					for (std::size_t i = begin; i < end; ++i) {
+						char* record = buffer.data() + (i - begin) * stride;
+						const SurfaceMesh::Face f = faces[i];
+						const vec3 n = fnormals ? fnormals[f] : mesh->compute_face_normal(f);
+						std::memcpy(record, &n, sizeof(vec3));
+						std::size_t offset = sizeof(vec3);
+						for (auto v : mesh->vertices(f)) {
+							std::memcpy(record + offset, &points[v], sizeof(vec3));
+							offset += sizeof(vec3);
+						}
+						record[48] = record[49] = 0;    // the attribute byte count
+					}
+				}
+				for (int c = 0; c < batch_size && good; ++c) {
+					ofs.write(buffers[c].data(), static_cast<std::streamsize>(buffers[c].size()));
+					good = !ofs.fail();
 				}
-				ofs << "    endloop" << std::endl;
-				ofs << "  endfacet" << std::endl;
 			}
-			ofs << "endsolid" << std::endl;
+
 			ofs.close();
-			return true;
+			LOG_IF(ERROR, !good) << "failed writing file: " << file_name;
+			return good;
 		}
 
 	} // namespace io
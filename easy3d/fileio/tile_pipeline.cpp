@@ -0,0 +1,320 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/fileio/tile_pipeline.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/fileio/surface_mesh_io.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    //  \cond
+    namespace details {
+
+        // a read-only stream over a mapped shared-memory segment, so the parent can hand
+        // the bytes to io::load_e3d() without copying them into a string first
+        class MemoryStreamBuffer : public std::streambuf {
+        public:
+            MemoryStreamBuffer(char* data, std::size_t size) {
+                setg(data, data, data + size);
+            }
+        };
+
+        // the name of the segment carrying the result of one tile. The parent pid keeps
+        // concurrent pipelines of different runs apart.
+        inline std::string segment_name(int parent_pid, std::size_t tile_index) {
+            char name[64];
+            std::snprintf(name, sizeof(name), "/easy3d_tile_%d_%zu", parent_pid, tile_index);
+            return std::string(name);
+        }
+    }
+    //  \endcond
+
+
+    int TilePipeline::add_stage(const std::string& name, Stage stage)
+    {
+        if (!stage) {
+            LOG(ERROR) << "null stage function: " << name;
+            return -1;
+        }
+        StageRecord record;
+        record.name = name;
+        record.func = stage;
+        stages_.push_back(record);
+        return static_cast<int>(stages_.size()) - 1;
+    }
+
+
+    void TilePipeline::add_dependency(int stage, int dependency)
+    {
+        if (stage < 0 || stage >= static_cast<int>(stages_.size()) ||
+            dependency < 0 || dependency >= static_cast<int>(stages_.size()) || stage == dependency) {
+            LOG(ERROR) << "invalid stage dependency: " << stage << " after " << dependency;
+            return;
+        }
+        stages_[stage].dependencies.push_back(dependency);
+    }
+
+
+    bool TilePipeline::topological_order(std::vector<int>& order) const
+    {
+        // Kahn's algorithm; stages without unresolved dependencies are emitted in
+        // registration order, so independent stages keep a stable, predictable order
+        const int num = static_cast<int>(stages_.size());
+        std::vector<int> remaining(num);
+        for (int s = 0; s < num; ++s)
+            remaining[s] = static_cast<int>(stages_[s].dependencies.size());
+
+        order.clear();
+        std::vector<bool> emitted(num, false);
+        while (static_cast<int>(order.size()) < num) {
+            int picked = -1;
+            for (int s = 0; s < num; ++s) {
+                if (!emitted[s] && remaining[s] == 0) {
+                    picked = s;
+                    break;
+                }
+            }
+            if (picked < 0) {
+                LOG(ERROR) << "stage dependencies contain a cycle";
+                return false;
+            }
+            emitted[picked] = true;
+            order.push_back(picked);
+            for (int s = 0; s < num; ++s) {
+                if (!emitted[s]) {
+                    for (auto d : stages_[s].dependencies) {
+                        if (d == picked)
+                            --remaining[s];
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+
+    SurfaceMesh* TilePipeline::process_tile(const std::string& tile_file, const std::vector<int>& order) const
+    {
+        SurfaceMesh* mesh = SurfaceMeshIO::load(tile_file);
+        if (!mesh) {
+            LOG(ERROR) << "failed to load tile: " << tile_file;
+            return nullptr;
+        }
+        for (auto s : order) {
+            if (!stages_[s].func(tile_file, mesh)) {
+                LOG(ERROR) << "stage '" << stages_[s].name << "' failed on tile: " << tile_file;
+                delete mesh;
+                return nullptr;
+            }
+        }
+        return mesh;
+    }
+
+
+#ifndef _WIN32
+
+    bool TilePipeline::run(const std::vector<std::string>& tile_files, int num_processes,
+                           const ResultCallback& on_finished)
+    {
+        std::vector<int> order;
+        if (!topological_order(order))
+            return false;
+        if (tile_files.empty())
+            return true;
+
+        const int num_workers = std::min(num_processes, static_cast<int>(tile_files.size()));
+        if (num_workers < 2) {
+            // in-process execution (also the path a worker-less debugging session wants)
+            for (const auto& tile : tile_files) {
+                SurfaceMesh* mesh = process_tile(tile, order);
+                if (on_finished)
+                    on_finished(tile, mesh);
+                else
+                    delete mesh;
+            }
+            return true;
+        }
+
+        // one pipe carries the completion records of all workers to the parent. A record is
+        // 16 bytes (tile index, payload size), far below PIPE_BUF, so concurrent writes do
+        // not interleave.
+        int completion_pipe[2];
+        if (pipe(completion_pipe) != 0) {
+            LOG(ERROR) << "could not create the completion pipe: " << strerror(errno);
+            return false;
+        }
+
+        const int parent_pid = getpid();
+        std::vector<pid_t> workers;
+        for (int w = 0; w < num_workers; ++w) {
+            const pid_t pid = fork();
+            if (pid < 0) {
+                LOG(ERROR) << "could not fork worker process: " << strerror(errno);
+                for (auto running : workers)
+                    waitpid(running, nullptr, 0);
+                close(completion_pipe[0]);
+                close(completion_pipe[1]);
+                return false;
+            }
+            if (pid == 0) {
+                // ---- worker: claims tiles by static partition, runs all stages of a tile
+                // in this process (no intermediate I/O), and publishes the result through a
+                // shared-memory segment in the flat e3d layout
+                close(completion_pipe[0]);
+                for (std::size_t i = w; i < tile_files.size(); i += num_workers) {
+                    std::uint64_t record[2] = { i, 0 };
+
+                    SurfaceMesh* mesh = process_tile(tile_files[i], order);
+                    if (mesh) {
+                        std::ostringstream buffer(std::ios::binary);
+                        if (io::save_e3d(buffer, mesh)) {
+                            const std::string& bytes = buffer.str();
+                            const std::string name = details::segment_name(parent_pid, i);
+                            const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+                            if (fd >= 0 && ftruncate(fd, static_cast<off_t>(bytes.size())) == 0) {
+                                void* address = mmap(nullptr, bytes.size(), PROT_WRITE, MAP_SHARED, fd, 0);
+                                if (address != MAP_FAILED) {
+                                    std::memcpy(address, bytes.data(), bytes.size());
+                                    munmap(address, bytes.size());
+                                    record[1] = bytes.size();
+                                }
+                            }
+                            if (fd >= 0)
+                                close(fd);
+                            if (record[1] == 0)
+                                shm_unlink(name.c_str());
+                        }
+                        delete mesh;
+                    }
+
+                    if (write(completion_pipe[1], record, sizeof(record)) != sizeof(record))
+                        _exit(1);
+                }
+                close(completion_pipe[1]);
+                _exit(0);
+            }
+            workers.push_back(pid);
+        }
+        close(completion_pipe[1]);
+
+        // ---- parent: collect one completion record per tile, map each segment, and rebuild
+        // the mesh straight from the shared bytes
+        std::size_t received = 0;
+        bool ok = true;
+        while (received < tile_files.size()) {
+            std::uint64_t record[2];
+            const ssize_t got = read(completion_pipe[0], record, sizeof(record));
+            if (got == 0)
+                break;      // all workers exited; missing tiles are reported below
+            if (got != sizeof(record))
+                continue;
+            ++received;
+
+            const std::size_t index = static_cast<std::size_t>(record[0]);
+            const std::size_t size = static_cast<std::size_t>(record[1]);
+            SurfaceMesh* mesh = nullptr;
+            if (size > 0) {
+                const std::string name = details::segment_name(parent_pid, index);
+                const int fd = shm_open(name.c_str(), O_RDONLY, 0600);
+                if (fd >= 0) {
+                    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (address != MAP_FAILED) {
+                        details::MemoryStreamBuffer buffer(static_cast<char*>(address), size);
+                        std::istream input(&buffer);
+                        mesh = new SurfaceMesh;
+                        mesh->set_name(tile_files[index]);
+                        if (!io::load_e3d(input, mesh)) {
+                            delete mesh;
+                            mesh = nullptr;
+                        }
+                        munmap(address, size);
+                    }
+                    close(fd);
+                }
+                shm_unlink(name.c_str());
+                LOG_IF(ERROR, !mesh) << "could not map the result of tile: " << tile_files[index];
+            }
+            if (on_finished)
+                on_finished(tile_files[index], mesh);
+            else
+                delete mesh;
+        }
+
+        if (received < tile_files.size()) {
+            LOG(ERROR) << "worker processes exited before delivering all tiles ("
+                       << received << " of " << tile_files.size() << " received)";
+            ok = false;
+        }
+        close(completion_pipe[0]);
+        for (auto pid : workers) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                ok = false;
+        }
+        return ok;
+    }
+
+#else   // _WIN32
+
+    bool TilePipeline::run(const std::vector<std::string>& tile_files, int num_processes,
+                           const ResultCallback& on_finished)
+    {
+        std::vector<int> order;
+        if (!topological_order(order))
+            return false;
+
+        LOG_IF(WARNING, num_processes > 1)
+                << "multi-process execution is not available on this platform "
+                << "(processing the tiles sequentially)";
+        for (const auto& tile : tile_files) {
+            SurfaceMesh* mesh = process_tile(tile, order);
+            if (on_finished)
+                on_finished(tile, mesh);
+            else
+                delete mesh;
+        }
+        return true;
+    }
+
+#endif
+
+} // namespace easy3d
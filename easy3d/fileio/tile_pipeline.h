@@ -0,0 +1,119 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_FILEIO_TILE_PIPELINE_H
+#define EASY3D_FILEIO_TILE_PIPELINE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace easy3d {
+
+    class SurfaceMesh;
+
+    /**
+     * \brief Multi-process driver for tiled processing pipelines.
+     * \class TilePipeline easy3d/fileio/tile_pipeline.h
+     *
+     * \details City-scale datasets are processed as tiles through a sequence of algorithm
+     *      stages. Running every stage as its own process and serializing to disk in between
+     *      wastes a large share of the wall time on intermediate file I/O. This driver takes
+     *      a DAG of stages and a list of tile files, distributes the tiles over forked worker
+     *      processes, and runs all stages of a tile in dependency order within one worker -
+     *      so between stages the model simply stays in memory. Only the final result of each
+     *      tile crosses a process boundary, through a POSIX shared-memory segment holding the
+     *      flat e3d property layout (the parent reconstructs the mesh from the mapped bytes
+     *      without parsing; see io::load_e3d(std::istream&, SurfaceMesh*)).
+     *
+     *      Stages registered after fork() run in the worker processes: they must not rely on
+     *      shared mutable state, open windows, or touch the GPU. On platforms without fork()
+     *      (Windows), run() processes the tiles sequentially in the calling process.
+     *
+     *      Typical use:
+     *      \code
+     *          TilePipeline pipeline;
+     *          const int simplify = pipeline.add_stage("simplify", ...);
+     *          const int repair = pipeline.add_stage("repair", ...);
+     *          pipeline.add_dependency(simplify, repair);  // repair runs first
+     *          pipeline.run(tile_files, 8, [](const std::string& tile, SurfaceMesh* mesh) {
+     *              ...     // runs in the parent; takes ownership of mesh
+     *          });
+     *      \endcode
+     */
+    class TilePipeline {
+    public:
+        /// \brief A stage transforms the mesh of a tile in place.
+        ///     Return false to mark the tile as failed (its remaining stages are skipped).
+        typedef std::function<bool(const std::string& tile_name, SurfaceMesh* mesh)> Stage;
+
+        /// \brief Called in the parent process for every finished tile. \p mesh is the
+        ///     processed model (ownership passes to the callback) or \c nullptr if the tile
+        ///     failed to load or a stage rejected it.
+        typedef std::function<void(const std::string& tile_name, SurfaceMesh* mesh)> ResultCallback;
+
+    public:
+        /// \brief Registers a stage and returns its id (used for declaring dependencies).
+        int add_stage(const std::string& name, Stage stage);
+
+        /// \brief Declares that \p stage must run after \p dependency (ids from add_stage()).
+        void add_dependency(int stage, int dependency);
+
+        /// \brief The number of registered stages.
+        std::size_t num_stages() const { return stages_.size(); }
+
+        /**
+         * \brief Processes the tiles.
+         * \details Each tile file is loaded with SurfaceMeshIO::load(), passed through the
+         *      stages in a topological order of the dependency graph, and handed to
+         *      \p on_finished in the parent process. Tiles are processed by up to
+         *      \p num_processes forked workers (values < 2 select in-process execution).
+         * \return false if the dependency graph has a cycle or a worker could not be
+         *      created; individual tile failures are reported through \p on_finished and do
+         *      not abort the run.
+         */
+        bool run(const std::vector<std::string>& tile_files, int num_processes,
+                 const ResultCallback& on_finished);
+
+    private:
+        // the stage order respecting the dependencies; false if the graph has a cycle
+        bool topological_order(std::vector<int>& order) const;
+
+        // runs all stages on one tile; returns nullptr if loading or a stage failed
+        SurfaceMesh* process_tile(const std::string& tile_file, const std::vector<int>& order) const;
+
+    private:
+        struct StageRecord {
+            std::string name;
+            Stage func;
+            std::vector<int> dependencies;
+        };
+        std::vector<StageRecord> stages_;
+    };
+
+} // namespace easy3d
+
+
+#endif // EASY3D_FILEIO_TILE_PIPELINE_H
@@ -23,8 +23,12 @@
  */
 
 
+#include <algorithm>
+#include <cstring>
+
 #include <easy3d/gui/picker.h>
 #include <easy3d/renderer/framebuffer_object.h>
+#include <easy3d/renderer/opengl.h>
 #include <easy3d/renderer/opengl_error.h>
 
 
@@ -33,15 +37,25 @@ namespace easy3d {
 
     FramebufferObject *Picker::fbo_ = 0;
 
+    unsigned int Picker::pbos_[2] = {0, 0};
+    int Picker::pbo_index_ = 0;
+    int Picker::pbo_regions_[2][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}};
+
 
     Picker::Picker(const Camera *cam)
-            : camera_(cam), use_gpu_if_supported_(true) {
+            : camera_(cam), use_gpu_if_supported_(true), use_async_readback_(false) {
     }
 
 
     Picker::~Picker() {
         delete fbo_;
         fbo_ = nullptr;
+
+        if (pbos_[0] != 0) {
+            glDeleteBuffers(2, pbos_);
+            pbos_[0] = pbos_[1] = 0;
+            pbo_regions_[0][2] = pbo_regions_[1][2] = 0;
+        }
     }
 
 
@@ -62,6 +76,59 @@ namespace easy3d {
     }
 
 
+    bool Picker::read_color_async(unsigned char rgba[4], int gl_x, int gl_y) {
+        // The transferred region is larger than the queried pixel, so the result of the previous
+        // transfer is still usable after a (small) cursor motion between two picks.
+        const int radius = 16;
+        const int x = std::max(gl_x - radius, 0);
+        const int y = std::max(gl_y - radius, 0);
+        const int w = std::min(gl_x + radius + 1, fbo_->width()) - x;
+        const int h = std::min(gl_y + radius + 1, fbo_->height()) - y;
+
+        if (pbos_[0] == 0) {
+            glGenBuffers(2, pbos_);    easy3d_debug_log_gl_error;
+        }
+
+        fbo_->activate_read_buffer(0);                  easy3d_debug_log_gl_error;
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);            easy3d_debug_log_gl_error;
+
+        // issue the transfer of this pick's region. glReadPixels() returns immediately because the
+        // target is a buffer object; the actual transfer overlaps with the subsequent rendering.
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos_[pbo_index_]);                          easy3d_debug_log_gl_error;
+        glBufferData(GL_PIXEL_PACK_BUFFER, w * h * 4, nullptr, GL_STREAM_READ);         easy3d_debug_log_gl_error;
+        glReadPixels(x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);                   easy3d_debug_log_gl_error;
+        pbo_regions_[pbo_index_][0] = x;
+        pbo_regions_[pbo_index_][1] = y;
+        pbo_regions_[pbo_index_][2] = w;
+        pbo_regions_[pbo_index_][3] = h;
+
+        // collect the result of the transfer issued by the previous pick (one-frame latency)
+        bool has_result = false;
+        const int other = 1 - pbo_index_;
+        const int *region = pbo_regions_[other];
+        if (region[2] > 0 && // a transfer has been issued before
+            gl_x >= region[0] && gl_x < region[0] + region[2] &&
+            gl_y >= region[1] && gl_y < region[1] + region[3])
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos_[other]);   easy3d_debug_log_gl_error;
+            const unsigned char *data = reinterpret_cast<const unsigned char *>(
+                    glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));                   easy3d_debug_log_gl_error;
+            if (data) {
+                const int offset = ((gl_y - region[1]) * region[2] + (gl_x - region[0])) * 4;
+                std::memcpy(rgba, data + offset, 4);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);            easy3d_debug_log_gl_error;
+                has_result = true;
+            }
+        }
+
+        // bind to 0 for conventional pixel operations. See http://www.songho.ca/opengl/gl_pbo.html
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);          easy3d_debug_log_gl_error;
+
+        pbo_index_ = other;
+        return has_result;
+    }
+
+
     void Picker::screen_to_opengl(int x, int y, int &gl_x, int &gl_y, int width, int height) const {
         float dpi_scaling_x = width / static_cast<float>(camera()->screenWidth());
         float dpi_scaling_y = height / static_cast<float>(camera()->screenHeight());
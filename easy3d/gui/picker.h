@@ -47,6 +47,22 @@ namespace easy3d {
         /// \brief Returns the pointer of the camera.
         const Camera *camera() const { return camera_; }
 
+        /**
+         * \brief Whether asynchronous pixel readback is used. \see set_async_readback(bool).
+         */
+        bool async_readback() const { return use_async_readback_; }
+
+        /**
+         * \brief Enable/Disable asynchronous pixel readback. Default: disabled.
+         * \details When enabled, the picked pixels are transferred through a pair of pixel buffer objects: every
+         *      pick issues a non-blocking transfer of a small region around the cursor and collects the result of
+         *      the transfer issued by the previous pick. This avoids stalling the GPU pipeline (useful when picking
+         *      on every mouse move, e.g., hover highlighting), at the price of the result being one frame old. A
+         *      blocking read is used as fallback when no previous result is available (e.g., the first pick, or the
+         *      cursor moved out of the previously transferred region).
+         */
+        void set_async_readback(bool b) { use_async_readback_ = b; }
+
         /**
          * \brief Construct a picking line.
          * @param x The cursor x-coordinate, relative to the left edge of the content area.
@@ -119,13 +135,25 @@ namespace easy3d {
         // prepare a frame buffer for the offscreen rendering
         void setup_framebuffer(int width, int height);
 
+        // Read the color at (gl_x, gl_y) from the bound fbo_ through the pixel buffer objects.
+        // A non-blocking transfer of a small region around (gl_x, gl_y) is issued and the result of the
+        // transfer issued by the previous call is collected. Returns false if no result is available yet
+        // (the caller should then fall back to a blocking read). \see set_async_readback(bool).
+        bool read_color_async(unsigned char rgba[4], int gl_x, int gl_y);
+
     protected:
         const Camera *camera_;
 
         bool use_gpu_if_supported_; // use GPU if supported
+        bool use_async_readback_;   // non-blocking pixel transfer with one-frame latency
 
         // All the picking tasks can share the same framebuffer
         static FramebufferObject *fbo_;
+
+        // The pixel buffer objects for the asynchronous readback (shared like the framebuffer).
+        static unsigned int pbos_[2];
+        static int pbo_index_;
+        static int pbo_regions_[2][4]; // the regions (x, y, w, h) the pending transfers cover
     };
 
 }
@@ -0,0 +1,355 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <easy3d/gui/picker_bvh.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <easy3d/core/point_cloud.h>
+
+
+namespace easy3d {
+
+    namespace details {
+
+        // intersect a ray (origin + t * dir, with inv_dir the component-wise inverse of dir) with a
+        // bounding box. Returns false if no t within [0, t_max] is inside the box.
+        inline bool ray_intersects_box(const Box3 &box, const vec3 &origin, const vec3 &inv_dir, float t_max) {
+            float t0 = 0.0f;
+            float t1 = t_max;
+            for (unsigned char i = 0; i < 3; ++i) {
+                float t_near = (box.min()[i] - origin[i]) * inv_dir[i];
+                float t_far = (box.max()[i] - origin[i]) * inv_dir[i];
+                if (t_near > t_far)
+                    std::swap(t_near, t_far);
+                t0 = std::max(t0, t_near);
+                t1 = std::min(t1, t_far);
+                if (t0 > t1)
+                    return false;
+            }
+            return true;
+        }
+
+        // the axis along which a box extends most
+        inline unsigned char longest_axis(const Box3 &box) {
+            unsigned char axis = 0;
+            if (box.range(1) > box.range(axis)) axis = 1;
+            if (box.range(2) > box.range(axis)) axis = 2;
+            return axis;
+        }
+
+    }
+
+
+    //  \cond
+
+    std::unordered_map<const SurfaceMesh *, SurfaceMeshBVH *> SurfaceMeshBVH::cache_;
+    std::unordered_map<const PointCloud *, PointCloudBVH *> PointCloudBVH::cache_;
+
+    //  \endcond
+
+
+    SurfaceMeshBVH::SurfaceMeshBVH(SurfaceMesh *mesh, unsigned int max_faces_per_leaf)
+            : mesh_(mesh), num_faces_(mesh->n_faces()) {
+        faces_.reserve(mesh->n_faces());
+        for (auto f : mesh->faces()) {
+            FaceRef ref;
+            ref.face = f;
+            for (auto v : mesh->vertices(f))
+                ref.box.add_point(mesh->position(v));
+            ref.center = (ref.box.min() + ref.box.max()) * 0.5f;
+            faces_.push_back(ref);
+        }
+
+        if (!faces_.empty()) {
+            nodes_.reserve(2 * faces_.size() / std::max<unsigned int>(max_faces_per_leaf, 1));
+            build(0, static_cast<int>(faces_.size()), std::max<unsigned int>(max_faces_per_leaf, 1));
+        }
+    }
+
+
+    int SurfaceMeshBVH::build(int start, int count, unsigned int max_faces_per_leaf) {
+        const int idx = static_cast<int>(nodes_.size());
+        nodes_.push_back(Node());
+
+        Box3 box;       // the bounding box of the faces
+        Box3 centers;   // the bounding box of the face centroids (determines the split axis)
+        for (int i = start; i < start + count; ++i) {
+            box.add_box(faces_[i].box);
+            centers.add_point(faces_[i].center);
+        }
+
+        const unsigned char axis = details::longest_axis(centers);
+        if (count <= static_cast<int>(max_faces_per_leaf) || centers.range(axis) <= 0.0f) {
+            // a leaf node (also when all centroids coincide and no split is possible)
+            Node &node = nodes_[idx];
+            node.box = box;
+            node.left_child = node.right_child = -1;
+            node.start = start;
+            node.count = count;
+            return idx;
+        }
+
+        // median split: half of the faces go to each side
+        const int mid = start + count / 2;
+        std::nth_element(faces_.begin() + start, faces_.begin() + mid, faces_.begin() + start + count,
+                         [axis](const FaceRef &a, const FaceRef &b) { return a.center[axis] < b.center[axis]; });
+
+        // the recursion may reallocate nodes_, so the node is filled in afterwards
+        const int left = build(start, count / 2, max_faces_per_leaf);
+        const int right = build(mid, count - count / 2, max_faces_per_leaf);
+
+        Node &node = nodes_[idx];
+        node.box = box;
+        node.left_child = left;
+        node.right_child = right;
+        node.start = start;
+        node.count = count;
+        return idx;
+    }
+
+
+    bool SurfaceMeshBVH::intersect_face(SurfaceMesh::Face face, const OrientedLine3 &line) const {
+        // Uses Plucker coordinates (see OrientedLine)
+        Sign face_sign = ZERO;
+        for (auto h : mesh_->halfedges(face)) {
+            auto s = mesh_->source(h);
+            auto t = mesh_->target(h);
+            const OrientedLine3 edge_line(mesh_->position(t), mesh_->position(s));
+            Sign sign = OrientedLine3::side(line, edge_line);
+            if (sign != ZERO) {
+                if (face_sign != ZERO && sign != face_sign)
+                    return false;
+                face_sign = sign;
+            }
+        }
+        return true;
+    }
+
+
+    SurfaceMesh::Face SurfaceMeshBVH::intersect(const vec3 &p_near, const vec3 &p_far) const {
+        SurfaceMesh::Face result;
+        if (nodes_.empty())
+            return result;
+
+        const OrientedLine3 oline(p_near, p_far);
+        const Line3 line = Line3::from_two_points(p_near, p_far);
+
+        const vec3 dir = p_far - p_near;
+        const float length2 = dot(dir, dir);
+        vec3 inv_dir;
+        for (unsigned char i = 0; i < 3; ++i)
+            inv_dir[i] = (dir[i] != 0.0f) ? 1.0f / dir[i] : FLT_MAX;
+
+        float best_t = FLT_MAX;     // w.r.t. the (unnormalized) ray parameterization
+
+        int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = nodes_[stack[--top]];
+            // a subtree is visited only if its box is hit closer than the best hit found so far
+            if (!details::ray_intersects_box(node.box, p_near, inv_dir, best_t))
+                continue;
+
+            if (node.left_child < 0) { // a leaf: test its faces
+                for (int i = node.start; i < node.start + node.count; ++i) {
+                    const FaceRef &ref = faces_[i];
+                    if (!intersect_face(ref.face, oline))
+                        continue;
+
+                    // the hit position is the intersection with the supporting plane of the face
+                    auto h = mesh_->halfedge(ref.face);
+                    const Plane3 plane(mesh_->position(mesh_->target(h)), mesh_->compute_face_normal(ref.face));
+                    vec3 p;
+                    if (plane.intersect(line, p)) {
+                        const float t = dot(p - p_near, dir) / length2;
+                        if (t >= 0.0f && t < best_t) {
+                            best_t = t;
+                            result = ref.face;
+                        }
+                    }
+                }
+            } else {
+                stack[top++] = node.right_child;
+                stack[top++] = node.left_child;
+            }
+        }
+
+        return result;
+    }
+
+
+    SurfaceMeshBVH *SurfaceMeshBVH::fetch(SurfaceMesh *mesh) {
+        auto pos = cache_.find(mesh);
+        if (pos != cache_.end()) {
+            if (pos->second->num_faces_ == mesh->n_faces())
+                return pos->second;
+            // the model has changed: discard and rebuild
+            delete pos->second;
+            cache_.erase(pos);
+        }
+
+        SurfaceMeshBVH *bvh = new SurfaceMeshBVH(mesh);
+        cache_[mesh] = bvh;
+        return bvh;
+    }
+
+
+    void SurfaceMeshBVH::invalidate(const SurfaceMesh *mesh /* = nullptr */) {
+        if (mesh) {
+            auto pos = cache_.find(mesh);
+            if (pos != cache_.end()) {
+                delete pos->second;
+                cache_.erase(pos);
+            }
+        } else {
+            for (auto &entry : cache_)
+                delete entry.second;
+            cache_.clear();
+        }
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////
+
+
+    PointCloudBVH::PointCloudBVH(PointCloud *cloud, unsigned int max_points_per_leaf)
+            : cloud_(cloud), num_points_(cloud->n_vertices()) {
+        indices_.resize(cloud->n_vertices());
+        for (std::size_t i = 0; i < indices_.size(); ++i)
+            indices_[i] = static_cast<int>(i);
+
+        if (!indices_.empty()) {
+            nodes_.reserve(2 * indices_.size() / std::max<unsigned int>(max_points_per_leaf, 1));
+            build(0, static_cast<int>(indices_.size()), std::max<unsigned int>(max_points_per_leaf, 1));
+        }
+    }
+
+
+    int PointCloudBVH::build(int start, int count, unsigned int max_points_per_leaf) {
+        const int idx = static_cast<int>(nodes_.size());
+        nodes_.push_back(Node());
+
+        const auto &points = cloud_->get_vertex_property<vec3>("v:point").vector();
+
+        Box3 box;
+        for (int i = start; i < start + count; ++i)
+            box.add_point(points[indices_[i]]);
+
+        const unsigned char axis = details::longest_axis(box);
+        if (count <= static_cast<int>(max_points_per_leaf) || box.range(axis) <= 0.0f) {
+            // a leaf node (also when all points coincide and no split is possible)
+            Node &node = nodes_[idx];
+            node.box = box;
+            node.left_child = node.right_child = -1;
+            node.start = start;
+            node.count = count;
+            return idx;
+        }
+
+        // median split: half of the points go to each side
+        const int mid = start + count / 2;
+        std::nth_element(indices_.begin() + start, indices_.begin() + mid, indices_.begin() + start + count,
+                         [axis, &points](int a, int b) { return points[a][axis] < points[b][axis]; });
+
+        // the recursion may reallocate nodes_, so the node is filled in afterwards
+        const int left = build(start, count / 2, max_points_per_leaf);
+        const int right = build(mid, count - count / 2, max_points_per_leaf);
+
+        Node &node = nodes_[idx];
+        node.box = box;
+        node.left_child = left;
+        node.right_child = right;
+        node.start = start;
+        node.count = count;
+        return idx;
+    }
+
+
+    void PointCloudBVH::collect(const std::function<int(const Box3 &)> &classify,
+                                std::vector<Range> &ranges) const {
+        ranges.clear();
+        if (nodes_.empty())
+            return;
+
+        int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = nodes_[stack[--top]];
+
+            const int c = classify(node.box);
+            if (c == OUTSIDE)
+                continue;
+
+            if (c == INSIDE) { // the whole subtree is taken, no need to test the points
+                ranges.push_back(Range{node.start, node.count, true});
+                continue;
+            }
+
+            if (node.left_child < 0) { // a leaf: its points still have to be tested by the caller
+                ranges.push_back(Range{node.start, node.count, false});
+            } else {
+                stack[top++] = node.right_child;
+                stack[top++] = node.left_child;
+            }
+        }
+    }
+
+
+    PointCloudBVH *PointCloudBVH::fetch(PointCloud *cloud) {
+        auto pos = cache_.find(cloud);
+        if (pos != cache_.end()) {
+            if (pos->second->num_points_ == cloud->n_vertices())
+                return pos->second;
+            // the model has changed: discard and rebuild
+            delete pos->second;
+            cache_.erase(pos);
+        }
+
+        PointCloudBVH *bvh = new PointCloudBVH(cloud);
+        cache_[cloud] = bvh;
+        return bvh;
+    }
+
+
+    void PointCloudBVH::invalidate(const PointCloud *cloud /* = nullptr */) {
+        if (cloud) {
+            auto pos = cache_.find(cloud);
+            if (pos != cache_.end()) {
+                delete pos->second;
+                cache_.erase(pos);
+            }
+        } else {
+            for (auto &entry : cache_)
+                delete entry.second;
+            cache_.clear();
+        }
+    }
+
+}
@@ -0,0 +1,176 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_GUI_PICKER_BVH_H
+#define EASY3D_GUI_PICKER_BVH_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <easy3d/core/types.h>
+#include <easy3d/core/surface_mesh.h>
+
+
+namespace easy3d {
+
+    class PointCloud;
+
+    /**
+     * \brief A bounding volume hierarchy over the faces of a surface mesh, accelerating the CPU picking path.
+     * \class SurfaceMeshBVH easy3d/gui/picker_bvh.h
+     * \details A single-ray query descends the hierarchy instead of testing every face, so a pick is
+     *      logarithmic in the number of faces. The hierarchies are cached per model (shared by all pickers,
+     *      like the picking framebuffer) and rebuilt when the number of faces of a model has changed.
+     *      Pure geometry edits (i.e., moving vertices) cannot be detected, so call invalidate() after
+     *      modifying a model's geometry.
+     * \see PointCloudBVH, SurfaceMeshPicker
+     */
+    class SurfaceMeshBVH {
+    public:
+        SurfaceMeshBVH(SurfaceMesh *mesh, unsigned int max_faces_per_leaf = 8);
+
+        /**
+         * \brief Find the face hit first (i.e., closest to \p p_near) by the ray from \p p_near to \p p_far.
+         * \details The same side test (using Plucker coordinates, \see OrientedLine) as the brute-force
+         *      implementation is used, so general polygonal faces are handled.
+         * \return The picked face (invalid if the ray misses the mesh).
+         */
+        SurfaceMesh::Face intersect(const vec3 &p_near, const vec3 &p_far) const;
+
+        /// \brief Return the hierarchy of \p mesh, building (or rebuilding) it if necessary.
+        static SurfaceMeshBVH *fetch(SurfaceMesh *mesh);
+
+        /// \brief Discard the cached hierarchy of \p mesh (all cached hierarchies if \p mesh is \c nullptr).
+        static void invalidate(const SurfaceMesh *mesh = nullptr);
+
+    private:
+        // face stores its bounding box, its centroid (for the median split), and the face handle
+        struct FaceRef {
+            Box3 box;
+            vec3 center;
+            SurfaceMesh::Face face;
+        };
+
+        // node of the hierarchy. The faces of its subtree are faces_[start, start + count).
+        struct Node {
+            Box3 box;
+            int left_child;     // -1 for a leaf
+            int right_child;
+            int start;
+            int count;
+        };
+
+        // recursive part of the construction; returns the index of the created node
+        int build(int start, int count, unsigned int max_faces_per_leaf);
+
+        // does the ray (given as an oriented line) pass through the face? Same test as the
+        // brute-force implementation. TODO: check if this works also for non-convex faces.
+        bool intersect_face(SurfaceMesh::Face face, const OrientedLine3 &line) const;
+
+    private:
+        SurfaceMesh *mesh_;
+        unsigned int num_faces_;    // to detect element changes of the model
+
+        std::vector<FaceRef> faces_;
+        std::vector<Node> nodes_;
+
+        // the cached hierarchies, one per model
+        static std::unordered_map<const SurfaceMesh *, SurfaceMeshBVH *> cache_;
+    };
+
+
+    /**
+     * \brief A bounding volume hierarchy over the points of a point cloud, accelerating region selections.
+     * \class PointCloudBVH easy3d/gui/picker_bvh.h
+     * \details A region query classifies the bounding box of a subtree at once: subtrees entirely outside
+     *      the region are pruned, and the points of subtrees entirely inside the region are taken without
+     *      testing them one by one. Caching/invalidation behaves as in SurfaceMeshBVH.
+     * \see SurfaceMeshBVH, PointCloudPicker
+     */
+    class PointCloudBVH {
+    public:
+        PointCloudBVH(PointCloud *cloud, unsigned int max_points_per_leaf = 256);
+
+        /// The classification of a bounding box against the query region. \see collect().
+        enum Classification {
+            OUTSIDE = -1,   ///< entirely outside the region: the subtree is pruned
+            PARTIAL = 0,    ///< undecided: the traversal descends (points of leaves are tested one by one)
+            INSIDE = 1      ///< entirely inside the region: all points of the subtree are taken
+        };
+
+        /// A contiguous range of indices(). \see collect().
+        struct Range {
+            int start;
+            int count;
+            bool inside;    // all points of the range are known to be inside the region
+        };
+
+        /**
+         * \brief Traverse the hierarchy with a region predicate, collecting the surviving subtrees.
+         * \param classify Classifies the bounding box of a subtree against the query region. It may be
+         *      conservative: returning PARTIAL is always correct (just slower).
+         * \param ranges Returns the taken subtrees and the undecided leaves as contiguous ranges of
+         *      indices(). Points of ranges marked \c inside are known to be inside the region; the
+         *      others still have to be tested by the caller. The ranges are disjoint, so they can be
+         *      processed in parallel.
+         */
+        void collect(const std::function<int(const Box3 &)> &classify, std::vector<Range> &ranges) const;
+
+        /// \brief The point indices, partitioned into contiguous subtree ranges. \see collect().
+        const std::vector<int> &indices() const { return indices_; }
+
+        /// \brief Return the hierarchy of \p cloud, building (or rebuilding) it if necessary.
+        static PointCloudBVH *fetch(PointCloud *cloud);
+
+        /// \brief Discard the cached hierarchy of \p cloud (all cached hierarchies if \p cloud is \c nullptr).
+        static void invalidate(const PointCloud *cloud = nullptr);
+
+    private:
+        // node of the hierarchy. The points of its subtree are indices_[start, start + count).
+        struct Node {
+            Box3 box;
+            int left_child;     // -1 for a leaf
+            int right_child;
+            int start;
+            int count;
+        };
+
+        // recursive part of the construction; returns the index of the created node
+        int build(int start, int count, unsigned int max_points_per_leaf);
+
+    private:
+        PointCloud *cloud_;
+        unsigned int num_points_;   // to detect element changes of the model
+
+        std::vector<int> indices_;  // the point indices, partitioned into contiguous subtree ranges
+        std::vector<Node> nodes_;
+
+        // the cached hierarchies, one per model
+        static std::unordered_map<const PointCloud *, PointCloudBVH *> cache_;
+    };
+
+}
+
+#endif  // EASY3D_GUI_PICKER_BVH_H
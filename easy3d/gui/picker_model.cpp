@@ -34,11 +34,23 @@
 #include <easy3d/renderer/drawable_lines.h>
 #include <easy3d/renderer/drawable_triangles.h>
 #include <easy3d/renderer/framebuffer_object.h>
+#include <easy3d/renderer/shader_manager.h>
+#include <easy3d/renderer/shader_program.h>
 #include <easy3d/util/logging.h>
 
 
 namespace easy3d {
 
+    // the number of picking ids a model occupies: an instanced drawable gets one id per instance,
+    // so the individual occurrences can be distinguished (see Drawable::update_instance_buffer()).
+    static int num_picking_ids(Model *model) {
+        Drawable *drawable = model->renderer()->get_triangles_drawable("faces");
+        if (drawable && drawable->num_instances() > 0)
+            return static_cast<int>(drawable->num_instances());
+        return 1;
+    }
+
+
     ModelPicker::ModelPicker(const Camera *cam) : Picker(cam) {
         use_gpu_if_supported_ = true;
     }
@@ -51,6 +63,13 @@ namespace easy3d {
 
 
     Model *ModelPicker::pick(const std::vector<Model *> &models, int x, int y) {
+        int instance_id = 0;
+        return pick(models, x, y, instance_id);
+    }
+
+
+    Model *ModelPicker::pick(const std::vector<Model *> &models, int x, int y, int &instance_id) {
+        instance_id = 0;
         if (models.empty())
             return nullptr;
 
@@ -78,16 +97,25 @@ namespace easy3d {
         states_.clear();
         draw(models);
 
-        // --- Maybe this is not necessary ---------
-        glFlush();
-        glFinish();
-        // -----------------------------------------
-
         int gl_x, gl_y;
         screen_to_opengl(x, y, gl_x, gl_y, width, height);
 
         unsigned char c[4];
-        fbo_->read_color(c, gl_x, gl_y);
+        if (use_async_readback_) {
+            // non-blocking transfer: the result is from the transfer issued by the previous pick.
+            // Fall back to a blocking read when no result is available (e.g., the first pick, or
+            // the cursor moved out of the previously transferred region).
+            if (!read_color_async(c, gl_x, gl_y))
+                fbo_->read_color(c, gl_x, gl_y);
+        }
+        else {
+            // --- Maybe this is not necessary ---------
+            glFlush();
+            glFinish();
+            // -----------------------------------------
+
+            fbo_->read_color(c, gl_x, gl_y);
+        }
 
         // switch back to the previous fbo
         fbo_->release(); easy3d_debug_log_gl_error; easy3d_debug_log_frame_buffer_error;
@@ -99,11 +127,20 @@ namespace easy3d {
 
         //--------------------------------------------------------------------------
 
-        // Convert the color back to an integer ID
+        // Convert the color back to an integer ID. Each model occupies the contiguous id range
+        // [base, base + num_picking_ids), so the owner (and the instance within it) can be resolved.
         int id = rgb::rgba(c[0], c[1], c[2], c[3]);
-        if (id >= 0 && id < models.size()) {
-            //LOG(INFO) << "selected model " << models[id]->name();
-            return models[id];
+        if (id >= 0) {
+            int base = 0;
+            for (auto model : models) {
+                const int num = num_picking_ids(model);
+                if (id < base + num) {
+                    //LOG(INFO) << "selected model " << model->name();
+                    instance_id = id - base;
+                    return model;
+                }
+                base += num;
+            }
         }
 
         return nullptr;
@@ -112,24 +149,34 @@ namespace easy3d {
 
     // draw the scene
     void ModelPicker::draw(const std::vector<Model *> &models) {
+        int base = 0;   // the first picking id of the current model
         for (std::size_t i = 0; i < models.size(); ++i) {
             Model *model = models[i];
-            if (!model->renderer()->is_visible())
+            const int num = num_picking_ids(model);
+            if (!model->renderer()->is_visible()) {
+                base += num;    // invisible models still consume their id range
                 continue;
+            }
 
             // the color used to render this model
             int r, g, b, a;
-            rgb::encode(static_cast<int>(i), r, g, b, a);
+            rgb::encode(base, r, g, b, a);
             const vec4 color(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
 
-            if (dynamic_cast<SurfaceMesh *>(model))
-                draw(model->renderer()->get_triangles_drawable("faces"), color);
+            if (dynamic_cast<SurfaceMesh *>(model)) {
+                Drawable *drawable = model->renderer()->get_triangles_drawable("faces");
+                if (drawable && drawable->num_instances() > 0)
+                    draw_instanced(drawable, base);
+                else
+                    draw(drawable, color);
+            }
             else if (dynamic_cast<PointCloud *>(model))
                 draw(model->renderer()->get_points_drawable("vertices"), color);
             else if (dynamic_cast<Graph *>(model)) {
                 draw(model->renderer()->get_points_drawable("vertices"), color);
                 draw(model->renderer()->get_lines_drawable("edges"), color);
             }
+            base += num;
         }
     }
 
@@ -153,4 +200,35 @@ namespace easy3d {
         drawable->set_state(states_[drawable]);
     }
 
+
+    // draw an instanced drawable. The vertex shader encodes (base_id + gl_InstanceID) into the color,
+    // so every instance can be identified individually.
+    void ModelPicker::draw_instanced(Drawable *drawable, int base_id) {
+        if (!drawable)
+            return;
+
+        ShaderProgram *program = ShaderManager::get_program("surface/surface_color_instanced");
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes;
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"));
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::COLOR, "vtx_color"));
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::NORMAL, "vtx_normal"));
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::ATTRIB_1, "vtx_instance_matrix"));
+            program = ShaderManager::create_program_from_files("surface/surface_color_instanced", attributes);
+        }
+        if (!program)
+            return;
+
+        program->bind();
+        // only the MVP member of the shared per-frame block matters here (lighting is off)
+        ShaderProgram::FrameBlock frame_block;
+        frame_block.MVP = camera()->modelViewProjectionMatrix();
+        ShaderProgram::upload_block("FrameBlock", &frame_block, sizeof(frame_block));
+        program->set_uniform("lighting", false)    // the fragment shader then outputs the id color unshaded
+                ->set_uniform("picking", true)
+                ->set_uniform("picking_id", base_id);
+        drawable->gl_draw(false);
+        program->release();
+    }
+
 }
@@ -60,12 +60,27 @@ namespace easy3d {
          */
         Model *pick(const std::vector<Model *> &models, int x, int y);
 
+        /**
+         * \brief Pick a model from a set of models, also resolving the instance for instanced drawables.
+         * \details A model rendered with instancing (see Drawable::update_instance_buffer()) occupies one
+         *          picking id per instance, so the individual occurrence under the cursor can be identified.
+         * @param models The models
+         * @param x The cursor x-coordinate, relative to the left edge of the content area.
+         * @param y The cursor y-coordinate, relative to the top edge of the content area.
+         * @param instance_id Receives the index of the picked instance (in the order of the transformations
+         *          passed to Drawable::update_instance_buffer()), or 0 for an ordinary model.
+         * @return The picked model.
+         */
+        Model *pick(const std::vector<Model *> &models, int x, int y, int &instance_id);
+
     private:
 
         // render each model of the scene with a unique color
         void draw(const std::vector<Model *> &models);
         // render the drawable with color
         void draw(Drawable *drawable, const vec4 &color);
+        // render an instanced drawable so that every instance receives its own picking color
+        void draw_instanced(Drawable *drawable, int base_id);
 
     private:
 
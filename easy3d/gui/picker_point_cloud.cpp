@@ -23,7 +23,12 @@
  */
 
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
 #include <easy3d/gui/picker_point_cloud.h>
+#include <easy3d/gui/picker_bvh.h>
 #include <easy3d/core/point_cloud.h>
 #include <easy3d/renderer/renderer.h>
 #include <easy3d/renderer/shader_program.h>
@@ -38,6 +43,88 @@
 namespace easy3d {
 
 
+    namespace details {
+
+        // does the segment (a, b) intersect the rectangle [xmin, xmax] x [ymin, ymax]?
+        // (Liang-Barsky clipping; only the acceptance test is needed)
+        bool segment_intersects_rect(const vec2 &a, const vec2 &b,
+                                     float xmin, float xmax, float ymin, float ymax) {
+            const float dx = b.x - a.x;
+            const float dy = b.y - a.y;
+            float t0 = 0.0f, t1 = 1.0f;
+
+            const float p[4] = {-dx, dx, -dy, dy};
+            const float q[4] = {a.x - xmin, xmax - a.x, a.y - ymin, ymax - a.y};
+            for (int i = 0; i < 4; ++i) {
+                if (p[i] == 0.0f) {
+                    if (q[i] < 0.0f)
+                        return false; // parallel to and outside the boundary
+                } else {
+                    const float r = q[i] / p[i];
+                    if (p[i] < 0.0f) {
+                        if (r > t1) return false;
+                        if (r > t0) t0 = r;
+                    } else {
+                        if (r < t0) return false;
+                        if (r < t1) t1 = r;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // rasterize the polygon into a binary scanline mask of w x h cells covering [0, 1]^2
+        // (even-odd fill; a cell is set if its center is inside the polygon)
+        void rasterize_polygon(const std::vector<vec2> &polygon, int w, int h,
+                               std::vector<unsigned char> &mask) {
+            mask.assign(static_cast<std::size_t>(w) * h, 0);
+            std::vector<float> xs;
+            for (int row = 0; row < h; ++row) {
+                const float y = (row + 0.5f) / h;
+
+                // the intersections of the polygon edges with this scanline
+                xs.clear();
+                for (std::size_t i = 0; i < polygon.size(); ++i) {
+                    const vec2 &a = polygon[i];
+                    const vec2 &b = polygon[(i + 1) % polygon.size()];
+                    if ((a.y <= y && b.y > y) || (b.y <= y && a.y > y))
+                        xs.push_back(a.x + (y - a.y) / (b.y - a.y) * (b.x - a.x));
+                }
+                std::sort(xs.begin(), xs.end());
+
+                // fill the spans between every other pair of intersections
+                for (std::size_t i = 0; i + 1 < xs.size(); i += 2) {
+                    const int c0 = std::max(0, static_cast<int>(std::ceil(xs[i] * w - 0.5f)));
+                    const int c1 = std::min(w - 1, static_cast<int>(std::floor(xs[i + 1] * w - 0.5f)));
+                    for (int c = c0; c <= c1; ++c)
+                        mask[static_cast<std::size_t>(row) * w + c] = 1;
+                }
+            }
+        }
+
+        // is the rectangle [xmin, xmax] x [ymin, ymax] entirely inside the polygon?
+        bool rect_inside_polygon(float xmin, float xmax, float ymin, float ymax,
+                                 const std::vector<vec2> &polygon, const PolygonTester2 &tester) {
+            // all four corners must be inside ...
+            const vec2 corners[4] = {vec2(xmin, ymin), vec2(xmax, ymin),
+                                     vec2(xmax, ymax), vec2(xmin, ymax)};
+            bool inside[4];
+            tester.contains(corners, 4, inside);
+            if (!inside[0] || !inside[1] || !inside[2] || !inside[3])
+                return false;
+            // ... and no polygon edge may cross the rectangle
+            for (std::size_t i = 0; i < polygon.size(); ++i) {
+                const vec2 &a = polygon[i];
+                const vec2 &b = polygon[(i + 1) % polygon.size()];
+                if (segment_intersects_rect(a, b, xmin, xmax, ymin, ymax))
+                    return false;
+            }
+            return true;
+        }
+
+    }
+
+
     PointCloudPicker::PointCloudPicker(const Camera *cam)
             : Picker(cam) {
         use_gpu_if_supported_ = false;
@@ -122,25 +209,79 @@ namespace easy3d {
         if (ymin > ymax) std::swap(ymin, ymax);
 
         const auto &points = model->get_vertex_property<vec3>("v:point").vector();
-        int num = static_cast<int>(points.size());
         const mat4 &m = camera()->modelViewProjectionMatrix();
 
         auto &select = model->vertex_property<bool>("v:select").vector();
 
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
-            const vec3 &p = points[i];
-            float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
-            float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
-            //float z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]; // I don't need z
-            float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
-            x /= w;
-            y /= w;
-            x = 0.5f * x + 0.5f;
-            y = 0.5f * y + 0.5f;
-
-            if (x >= xmin && x <= xmax && y >= ymin && y <= ymax) {
-                select[i] = true;
+        // The bounding box of a subtree is projected onto the screen: the projection is a projective
+        // map, so the projected corners bound the projections of all points of the box (unless the
+        // box crosses the near plane, in which case the classification is left undecided).
+        auto project_box = [&m](const Box3 &box, float &bx_min, float &bx_max,
+                                float &by_min, float &by_max) -> bool {
+            bx_min = by_min = FLT_MAX;
+            bx_max = by_max = -FLT_MAX;
+            for (int c = 0; c < 8; ++c) {
+                const vec3 p((c & 1) ? box.max().x : box.min().x,
+                             (c & 2) ? box.max().y : box.min().y,
+                             (c & 4) ? box.max().z : box.min().z);
+                float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+                float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+                float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
+                if (w < FLT_MIN)
+                    return false;
+                x = 0.5f * (x / w) + 0.5f;
+                y = 0.5f * (y / w) + 0.5f;
+                bx_min = std::min(bx_min, x);
+                bx_max = std::max(bx_max, x);
+                by_min = std::min(by_min, y);
+                by_max = std::max(by_max, y);
+            }
+            return true;
+        };
+
+        // The hierarchy prunes subtrees entirely outside the rectangle and takes subtrees entirely
+        // inside it without testing their points one by one (the hierarchy is cached, so it is
+        // built only for the first selection of a model).
+        PointCloudBVH *bvh = PointCloudBVH::fetch(model);
+        std::vector<PointCloudBVH::Range> ranges;
+        bvh->collect(
+                [&](const Box3 &box) -> int {
+                    float bx_min, bx_max, by_min, by_max;
+                    if (!project_box(box, bx_min, bx_max, by_min, by_max))
+                        return PointCloudBVH::PARTIAL;
+                    if (bx_max < xmin || bx_min > xmax || by_max < ymin || by_min > ymax)
+                        return PointCloudBVH::OUTSIDE;
+                    if (bx_min >= xmin && bx_max <= xmax && by_min >= ymin && by_max <= ymax)
+                        return PointCloudBVH::INSIDE;
+                    return PointCloudBVH::PARTIAL;
+                },
+                ranges);
+
+        // the surviving ranges are disjoint, so they are processed in parallel
+        const std::vector<int> &indices = bvh->indices();
+        int num_ranges = static_cast<int>(ranges.size());
+#pragma omp parallel for schedule(dynamic)
+        for (int r = 0; r < num_ranges; ++r) {
+            const PointCloudBVH::Range &range = ranges[r];
+            for (int k = range.start; k < range.start + range.count; ++k) {
+                const int i = indices[k];
+                if (range.inside) {
+                    select[i] = true;
+                    continue;
+                }
+                const vec3 &p = points[i];
+                float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+                float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+                //float z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]; // I don't need z
+                float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
+                x /= w;
+                y /= w;
+                x = 0.5f * x + 0.5f;
+                y = 0.5f * y + 0.5f;
+
+                if (x >= xmin && x <= xmax && y >= ymin && y <= ymax) {
+                    select[i] = true;
+                }
             }
         }
 
@@ -199,13 +340,14 @@ namespace easy3d {
         int win_width = camera()->screenWidth();
         int win_height = camera()->screenHeight();
 
-        std::vector<vec2> region; // the transformed selection region
+        Polygon2 region; // the transformed selection region
         for (std::size_t i = 0; i < plg.size(); ++i) {
             const vec2 &p = plg[i];
             float x = p.x / float(win_width - 1);
             float y = 1.0f - p.y / float(win_height - 1);
             region.push_back(vec2(x, y));
         }
+        const PolygonTester2 tester(region); // the edges packed once for the corner tests below
 
         const Box2& box = plg.bbox();
         float xmin = box.min().x / (win_width - 1.0f);
@@ -216,26 +358,86 @@ namespace easy3d {
         if (ymin > ymax) std::swap(ymin, ymax);
 
         const auto &points = model->get_vertex_property<vec3>("v:point").vector();
-        int num = static_cast<int>(points.size());
         const mat4 &m = camera()->modelViewProjectionMatrix();
 
         auto &select = model->vertex_property<bool>("v:select").vector();
 
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
-            const vec3 &p = points[i];
-            float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
-            float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
-            //float z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]; // I don't need z
-            float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
-            x /= w;
-            y /= w;
-            x = 0.5f * x + 0.5f;
-            y = 0.5f * y + 0.5f;
-
-            if (x >= xmin && x <= xmax && y >= ymin && y <= ymax) {
-                if (geom::point_in_polygon(vec2(x, y), region))
+        // \see pick_vertices_cpu(PointCloud*, const Rect&, bool)
+        auto project_box = [&m](const Box3 &box, float &bx_min, float &bx_max,
+                                float &by_min, float &by_max) -> bool {
+            bx_min = by_min = FLT_MAX;
+            bx_max = by_max = -FLT_MAX;
+            for (int c = 0; c < 8; ++c) {
+                const vec3 p((c & 1) ? box.max().x : box.min().x,
+                             (c & 2) ? box.max().y : box.min().y,
+                             (c & 4) ? box.max().z : box.min().z);
+                float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+                float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+                float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
+                if (w < FLT_MIN)
+                    return false;
+                x = 0.5f * (x / w) + 0.5f;
+                y = 0.5f * (y / w) + 0.5f;
+                bx_min = std::min(bx_min, x);
+                bx_max = std::max(bx_max, x);
+                by_min = std::min(by_min, y);
+                by_max = std::max(by_max, y);
+            }
+            return true;
+        };
+
+        // The polygon is rasterized into a screen-resolution scanline mask once, turning the
+        // point-in-polygon test (linear in the number of lasso vertices) into a constant-time
+        // lookup for the points that still have to be tested.
+        std::vector<unsigned char> mask;
+        details::rasterize_polygon(region, win_width, win_height, mask);
+
+        // The hierarchy prunes subtrees entirely outside the lasso and takes subtrees entirely
+        // inside it without testing their points one by one (the hierarchy is cached, so it is
+        // built only for the first selection of a model).
+        PointCloudBVH *bvh = PointCloudBVH::fetch(model);
+        std::vector<PointCloudBVH::Range> ranges;
+        bvh->collect(
+                [&](const Box3 &box) -> int {
+                    float bx_min, bx_max, by_min, by_max;
+                    if (!project_box(box, bx_min, bx_max, by_min, by_max))
+                        return PointCloudBVH::PARTIAL;
+                    if (bx_max < xmin || bx_min > xmax || by_max < ymin || by_min > ymax)
+                        return PointCloudBVH::OUTSIDE;
+                    if (details::rect_inside_polygon(bx_min, bx_max, by_min, by_max, region, tester))
+                        return PointCloudBVH::INSIDE;
+                    return PointCloudBVH::PARTIAL;
+                },
+                ranges);
+
+        // the surviving ranges are disjoint, so they are processed in parallel
+        const std::vector<int> &indices = bvh->indices();
+        int num_ranges = static_cast<int>(ranges.size());
+#pragma omp parallel for schedule(dynamic)
+        for (int r = 0; r < num_ranges; ++r) {
+            const PointCloudBVH::Range &range = ranges[r];
+            for (int k = range.start; k < range.start + range.count; ++k) {
+                const int i = indices[k];
+                if (range.inside) {
                     select[i] = true;
+                    continue;
+                }
+                const vec3 &p = points[i];
+                float x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+                float y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+                //float z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]; // I don't need z
+                float w = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
+                x /= w;
+                y /= w;
+                x = 0.5f * x + 0.5f;
+                y = 0.5f * y + 0.5f;
+
+                if (x >= xmin && x <= xmax && y >= ymin && y <= ymax) {
+                    const int col = std::min(win_width - 1, std::max(0, static_cast<int>(x * win_width)));
+                    const int row = std::min(win_height - 1, std::max(0, static_cast<int>(y * win_height)));
+                    if (mask[static_cast<std::size_t>(row) * win_width + col])
+                        select[i] = true;
+                }
             }
         }
 
@@ -24,6 +24,7 @@
 
 
 #include <easy3d/gui/picker_surface_mesh.h>
+#include <easy3d/gui/picker_bvh.h>
 #include <easy3d/renderer/renderer.h>
 #include <easy3d/renderer/shader_program.h>
 #include <easy3d/renderer/shader_manager.h>
@@ -200,41 +201,12 @@ namespace easy3d {
 
 
     SurfaceMesh::Face SurfaceMeshPicker::pick_face_cpu(SurfaceMesh *model, int x, int y) {
-        int num = model->n_faces();
         const vec3 &p_near = unproject(x, y, 0);
         const vec3 &p_far = unproject(x, y, 1);
-        const OrientedLine3 oline(p_near, p_far);
-
-        std::vector<char> status(num, 0);
-#pragma omp parallel for
-        for (int i = 0; i < num; ++i) {
-            if (do_intersect(model, SurfaceMesh::Face(i), oline))
-                status[i] = 1;
-        }
-
-        picked_face_ = SurfaceMesh::Face();
-        double squared_distance = FLT_MAX;
-        const Line3 &line = picking_line(x, y);
-        for (int i = 0; i < num; ++i) {
-            if (status[i]) {
-                const SurfaceMesh::Face face(i);
-                const Plane3 plane = face_plane(model, face);
-
-                vec3 p;
-                if (plane.intersect(line, p)) {
-                    double s = distance2(p, p_near);
-                    if (s < squared_distance) {
-                        squared_distance = s;
-                        picked_face_ = face;
-                    }
-                } else {
-                    // If reached here, a parallel facet with distance less than hit resolution should be
-                    // the candidate. However, the picking line does not intersect the facet.
-                    // Logger::err(title()) << "should have intersection";
-                }
-            }
-        }
 
+        // The hierarchy descends to the faces along the picking line only, instead of testing all
+        // faces (the hierarchy is cached, so it is built only for the first pick of a model).
+        picked_face_ = SurfaceMeshBVH::fetch(model)->intersect(p_near, p_far);
         return picked_face_;
     }
 
@@ -274,16 +246,25 @@ namespace easy3d {
         drawable->gl_draw(false);
         program_->release();
 
-        // --- Maybe this is not necessary ---------
-        glFlush();
-        glFinish();
-        // -----------------------------------------
-
         int gl_x, gl_y;
         screen_to_opengl(x, y, gl_x, gl_y, width, height);
 
         unsigned char c[4];
-        fbo_->read_color(c, gl_x, gl_y);
+        if (use_async_readback_) {
+            // non-blocking transfer: the result is from the transfer issued by the previous pick.
+            // Fall back to a blocking read when no result is available (e.g., the first pick, or
+            // the cursor moved out of the previously transferred region).
+            if (!read_color_async(c, gl_x, gl_y))
+                fbo_->read_color(c, gl_x, gl_y);
+        }
+        else {
+            // --- Maybe this is not necessary ---------
+            glFlush();
+            glFinish();
+            // -----------------------------------------
+
+            fbo_->read_color(c, gl_x, gl_y);
+        }
 
         // switch back to the previous fbo
         fbo_->release(); easy3d_debug_log_gl_error; easy3d_debug_log_frame_buffer_error;
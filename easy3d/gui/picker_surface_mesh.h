@@ -161,31 +161,11 @@ namespace easy3d {
         // selection implemented in GPU (using shader program)
         SurfaceMesh::Face pick_face_gpu(SurfaceMesh *model, int x, int y);
 
-        // selection implemented in CPU (with OpenMP if supported)
+        // selection implemented in CPU (accelerated by a cached bounding volume hierarchy)
         SurfaceMesh::Face pick_face_cpu(SurfaceMesh *model, int x, int y);
 
         Plane3 face_plane(SurfaceMesh *model, SurfaceMesh::Face face) const;
 
-        /**
-         * TODO: check if this works also for non-convex faces.
-         */
-        inline bool do_intersect(SurfaceMesh *model, SurfaceMesh::Face picked_face, const OrientedLine3 &line) const {
-            // Uses Plucker coordinates (see OrientedLine)
-            Sign face_sign = ZERO;
-            for (auto h : model->halfedges(picked_face)) {
-                auto s = model->source(h);
-                auto t = model->target(h);
-                const OrientedLine3 edge_line(model->position(t), model->position(s));
-                Sign sign = OrientedLine3::side(line, edge_line);
-                if (sign != ZERO) {
-                    if (face_sign != ZERO && sign != face_sign)
-                        return false;
-                    face_sign = sign;
-                }
-            }
-            return true;
-        }
-
     private:
         ShaderProgram *program_;
         unsigned int hit_resolution_;     // in pixels
@@ -23,6 +23,11 @@
  */
 
 #include <easy3d/kdtree/kdtree_search.h>
+#include <easy3d/util/logging.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 
 namespace easy3d {
@@ -37,4 +42,92 @@ namespace easy3d {
     {
     }
 
+
+    namespace details {
+        static const char index_file_magic[8] = { 'E', '3', 'D', 'K', 'D', 'T', 'R', 'E' };
+    }
+
+
+    bool KdTreeSearch::write_index_header(FILE *file, unsigned int backend, std::size_t num_points)
+    {
+        const std::uint64_t num = num_points;
+        return fwrite(details::index_file_magic, sizeof(details::index_file_magic), 1, file) == 1 &&
+               fwrite(&backend, sizeof(backend), 1, file) == 1 &&
+               fwrite(&num, sizeof(num), 1, file) == 1;
+    }
+
+
+    bool KdTreeSearch::read_index_header(FILE *file, unsigned int backend, std::size_t num_points)
+    {
+        char magic[8];
+        unsigned int file_backend = 0;
+        std::uint64_t file_num_points = 0;
+        if (fread(magic, sizeof(magic), 1, file) != 1 ||
+            fread(&file_backend, sizeof(file_backend), 1, file) != 1 ||
+            fread(&file_num_points, sizeof(file_num_points), 1, file) != 1) {
+            LOG(WARNING) << "failed reading the index file header";
+            return false;
+        }
+        if (std::memcmp(magic, details::index_file_magic, sizeof(magic)) != 0 || file_backend != backend) {
+            LOG(WARNING) << "the file was not written by save() of this kd-tree backend";
+            return false;
+        }
+        if (file_num_points != static_cast<std::uint64_t>(num_points)) {
+            LOG(WARNING) << "the index was built from a different point cloud (" << file_num_points
+                         << " points in the file, " << num_points << " in the cloud)";
+            return false;
+        }
+        return true;
+    }
+
+
+    bool KdTreeSearch::save(const std::string &file_name) const
+    {
+        (void) file_name;
+        LOG(WARNING) << "saving the index is not supported by this kd-tree backend";
+        return false;
+    }
+
+
+    bool KdTreeSearch::load(PointCloud *cloud, const std::string &file_name)
+    {
+        (void) cloud;
+        (void) file_name;
+        LOG(WARNING) << "loading an index is not supported by this kd-tree backend";
+        return false;
+    }
+
+
+    void KdTreeSearch::find_closest_k_points(const vec3 *queries, std::size_t num, int k, int *neighbors) const
+    {
+        std::vector<int> indices;
+        for (std::size_t i = 0; i < num; ++i) {
+            indices.clear();
+            find_closest_k_points(queries[i], k, indices);
+            int *out = neighbors + i * k;
+            const int found = std::min(k, static_cast<int>(indices.size()));
+            for (int j = 0; j < found; ++j)
+                out[j] = indices[j];
+            for (int j = found; j < k; ++j)
+                out[j] = -1;
+        }
+    }
+
+
+    void KdTreeSearch::find_points_in_range(const vec3 *queries, std::size_t num, float squared_radius,
+                                            std::vector<std::size_t> &offsets, std::vector<int> &neighbors) const
+    {
+        offsets.resize(num + 1);
+        neighbors.clear();
+
+        std::vector<int> indices;
+        for (std::size_t i = 0; i < num; ++i) {
+            offsets[i] = neighbors.size();
+            indices.clear();
+            find_points_in_range(queries[i], squared_radius, indices);
+            neighbors.insert(neighbors.end(), indices.begin(), indices.end());
+        }
+        offsets[num] = neighbors.size();
+    }
+
 } // namespace easy3d
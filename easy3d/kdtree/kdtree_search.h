@@ -26,6 +26,8 @@
 #define EASY3D_KD_TREE_SEARCH_H
 
 
+#include <cstdio>
+#include <string>
 #include <vector>
 #include <easy3d/core/types.h>
 
@@ -97,6 +99,48 @@ namespace easy3d {
          * \brief Finalizes the construction of a KdTree.
          */
         virtual void end() = 0;
+
+        /**
+         * \brief Specifies the tolerated relative error of the nearest neighbor queries.
+         * \param eps With a non-zero \p eps, a query may return neighbors whose distance is up
+         *      to a factor of (1 + eps) of the true nearest distance. Allowing 1-2% approximate
+         *      neighbors (eps = 0.01 ... 0.02) gives a large query speedup for applications that
+         *      can tolerate it (e.g., normal estimation, simplification). The default of 0
+         *      requests exact search.
+         * \attention Only honored by backends with approximate search support (currently
+         *      KdTreeSearch_FLANN); the other backends always search exactly.
+         */
+        virtual void set_accuracy(float eps) { (void) eps; }
+        /// @}
+
+        /// \name Persistent indices
+        /// @{
+
+        /**
+         * \brief Saves the built index to a binary file, so a later session can load() it instead
+         *      of rebuilding the tree.
+         * \details Intended for fixed reference clouds that are queried session after session:
+         *      restoring the index of a large cloud is a sequential read, while rebuilding it
+         *      takes minutes. Only supported by backends whose index can be serialized (currently
+         *      KdTreeSearch_NanoFLANN and KdTreeSearch_ETH); the other backends log a warning and
+         *      return false.
+         * \param file_name The file to write.
+         * \return true on success.
+         */
+        virtual bool save(const std::string &file_name) const;
+
+        /**
+         * \brief Restores an index previously written by save(), replacing any existing index.
+         * \details The file only stores the search structure, so \p cloud must be the same point
+         *      cloud (same points, same order) the index was built from; the point count is
+         *      verified, the point data is not. Loading a stale index against a modified cloud
+         *      gives wrong query results.
+         * \param cloud The point cloud the index was built from.
+         * \param file_name The file written by save() of the same backend.
+         * \return true on success (false on I/O errors, a file from a different backend, or a
+         *      point count mismatch).
+         */
+        virtual bool load(PointCloud *cloud, const std::string &file_name);
         /// @}
 
         /// \name Closest point query
@@ -141,6 +185,23 @@ namespace easy3d {
          * \param neighbors The indices of the neighbors found.
          */
         virtual void find_closest_k_points(const vec3 &p, int k, std::vector<int> &neighbors) const = 0;
+
+        /**
+         * \brief Queries the K nearest neighbors for a batch of points.
+         * \param queries The query points.
+         * \param num The number of query points.
+         * \param k The number of required neighbors per query point.
+         * \param neighbors The indices of the neighbors found, written into this caller-provided
+         *      buffer of (at least) \p num * \p k entries: the neighbors of query point \c i
+         *      occupy entries [i * k, i * k + k). Entries are set to -1 when fewer than \p k
+         *      neighbors are found.
+         * \details This is noticeably faster than issuing the queries one by one: the per-query
+         *      result vectors (and their allocations) are gone, and backends whose queries are
+         *      thread-safe (KdTreeSearch_FLANN and KdTreeSearch_NanoFLANN) process the batch in
+         *      parallel. The other backends use this serial default implementation (their
+         *      3rd-party query kernels keep global state, see the note above).
+         */
+        virtual void find_closest_k_points(const vec3 *queries, std::size_t num, int k, int *neighbors) const;
         /// @}
 
         /// @name Fixed radius search
@@ -165,7 +226,36 @@ namespace easy3d {
          * \param neighbors The indices of the neighbors found.
          */
         virtual void find_points_in_range(const vec3 &p, float squared_radius, std::vector<int> &neighbors) const = 0;
+
+        /**
+         * \brief Queries the nearest neighbors within a fixed range for a batch of points.
+         * \param queries The query points.
+         * \param num The number of query points.
+         * \param squared_radius The search range (which is required to be \b squared).
+         * \param offsets Filled with \p num + 1 entries: the neighbors of query point \c i are
+         *      neighbors[offsets[i]] ... neighbors[offsets[i + 1] - 1]. This compressed layout
+         *      (CSR) stores the variable-length results of all the queries in two flat arrays.
+         * \param neighbors The concatenated indices of the neighbors found.
+         * \details Unlike the k nearest neighbors, the result size of a range query is not known
+         *      beforehand, so the results are returned compressed instead of in a caller-provided
+         *      buffer. Backends whose queries are thread-safe (KdTreeSearch_FLANN and
+         *      KdTreeSearch_NanoFLANN) process the batch in parallel; the other backends use this
+         *      serial default implementation.
+         * \attention The order of the neighbors within the list of a query point is
+         *      backend-dependent; in particular, the query point itself is not guaranteed to be
+         *      the first entry of its own list.
+         */
+        virtual void find_points_in_range(const vec3 *queries, std::size_t num, float squared_radius,
+                                          std::vector<std::size_t> &offsets, std::vector<int> &neighbors) const;
         /// @}
+
+    protected:
+        // The shared header of the persistent index files: a magic string, the id of the backend
+        // that wrote the file, and the number of points the index was built from. The backend id
+        // keeps a file from being fed to a backend with a different payload format; the point
+        // count catches loading an index against the wrong cloud.
+        static bool write_index_header(FILE *file, unsigned int backend, std::size_t num_points);
+        static bool read_index_header(FILE *file, unsigned int backend, std::size_t num_points);
     };
 
 } // namespace easy3d
@@ -26,6 +26,7 @@
 
 #include <easy3d/kdtree/kdtree_search_ann.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/util/tracing.h>
 
 #include <3rd_party/kd_tree/ANN/ANN.h>
 
@@ -80,7 +81,8 @@ namespace easy3d {
     }
 
 
-    void KdTreeSearch_ANN::end()  {
+    void KdTreeSearch_ANN::end() {
+        EASY3D_TRACE_SCOPE("KdTreeSearch_ANN::end");
         tree_ = new ANNkd_tree(points_, points_num_, 3);
     }
 
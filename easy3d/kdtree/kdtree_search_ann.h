@@ -109,6 +109,11 @@ namespace easy3d {
                 const vec3 &p, int k,
                 std::vector<int> &neighbors
         ) const override;
+
+        /// Bring in the batch overload. The queries of this backend are not thread-safe
+        /// (ANN's search kernel keeps global state), so the batch runs serially; see
+        /// KdTreeSearch::find_closest_k_points(const vec3*, std::size_t, int, int*).
+        using KdTreeSearch::find_closest_k_points;
         /// @}
 
         /// @name Fixed radius search
@@ -147,6 +152,11 @@ namespace easy3d {
                 const vec3 &p, float squared_radius,
                 std::vector<int> &neighbors
         ) const override;
+
+        /// Bring in the batch overload (serial for this backend, see the note for the batch
+        /// k nearest neighbors query above); see
+        /// KdTreeSearch::find_points_in_range(const vec3*, std::size_t, float, std::vector<std::size_t>&, std::vector<int>&).
+        using KdTreeSearch::find_points_in_range;
         /// @}
 
 #ifndef DOXYGEN
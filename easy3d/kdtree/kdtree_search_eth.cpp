@@ -24,6 +24,7 @@
 
 #include <easy3d/kdtree/kdtree_search_eth.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/util/tracing.h>
 
 #include <3rd_party/kd_tree/ETH_Kd_Tree/kdTree.h>
 
@@ -55,7 +56,8 @@ namespace easy3d {
     }
 
 
-    void KdTreeSearch_ETH::end()  {
+    void KdTreeSearch_ETH::end() {
+        EASY3D_TRACE_SCOPE("KdTreeSearch_ETH::end");
         int maxBucketSize = 16 ;	// number of points per bucket
         tree_ = new kdtree::KdTree(reinterpret_cast<kdtree::Vector3D*>(points_), points_num_, maxBucketSize);
     }
@@ -68,6 +70,53 @@ namespace easy3d {
     }
 
 
+    bool KdTreeSearch_ETH::save(const std::string& file_name) const {
+        if (!tree_) {
+            LOG(WARNING) << "no index to save (the tree has not been built)";
+            return false;
+        }
+
+        FILE* file = fopen(file_name.c_str(), "wb");
+        if (!file) {
+            LOG(WARNING) << "could not open file: " << file_name;
+            return false;
+        }
+
+        bool ok = write_index_header(file, 2, static_cast<std::size_t>(points_num_));
+        if (ok)  // the ETH tree serializes itself (it owns a permuted copy of the points)
+            get_tree(tree_)->save(file);
+        ok = ok && ferror(file) == 0;
+        fclose(file);
+        return ok;
+    }
+
+
+    bool KdTreeSearch_ETH::load(PointCloud* cloud, const std::string& file_name) {
+        FILE* file = fopen(file_name.c_str(), "rb");
+        if (!file) {
+            LOG(WARNING) << "could not open file: " << file_name;
+            return false;
+        }
+
+        if (!read_index_header(file, 2, cloud->n_vertices())) {
+            fclose(file);
+            return false;
+        }
+
+        kdtree::KdTree* tree = kdtree::KdTree::load(file);
+        fclose(file);
+        if (!tree) {
+            LOG(WARNING) << "failed reading the index from file: " << file_name;
+            return false;
+        }
+
+        begin();
+        add_point_cloud(cloud);
+        tree_ = tree;
+        return true;
+    }
+
+
     int KdTreeSearch_ETH::find_closest_point(const vec3& p) const {
         kdtree::Vector3D v3d( p.x, p.y, p.z );
         get_tree(tree_)->setNOfNeighbours( 1 );
@@ -61,6 +61,14 @@ namespace easy3d {
         virtual void end();
         /// @}
 
+        /// \name Persistent indices
+        /// @{
+        /// \brief Saves the built index to a binary file. See KdTreeSearch::save().
+        virtual bool save(const std::string &file_name) const;
+        /// \brief Restores an index previously written by save(). See KdTreeSearch::load().
+        virtual bool load(PointCloud *cloud, const std::string &file_name);
+        /// @}
+
         /// \name Closest point query
         /// @{
 
@@ -108,6 +116,11 @@ namespace easy3d {
                 const vec3 &p, int k,
                 std::vector<int> &neighbors
         ) const;
+
+        /// Bring in the batch overload. The queries of this backend are not thread-safe
+        /// (the ETH kd-tree keeps global query state), so the batch runs serially; see
+        /// KdTreeSearch::find_closest_k_points(const vec3*, std::size_t, int, int*).
+        using KdTreeSearch::find_closest_k_points;
         /// @}
 
         /// @name Fixed radius search
@@ -137,6 +150,11 @@ namespace easy3d {
                 const vec3 &p, float squared_radius,
                 std::vector<int> &neighbors
         ) const;
+
+        /// Bring in the batch overload (serial for this backend, see the note for the batch
+        /// k nearest neighbors query above); see
+        /// KdTreeSearch::find_points_in_range(const vec3*, std::size_t, float, std::vector<std::size_t>&, std::vector<int>&).
+        using KdTreeSearch::find_points_in_range;
         /// @}
 
 
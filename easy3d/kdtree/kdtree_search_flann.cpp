@@ -24,9 +24,12 @@
 
 #include <easy3d/kdtree/kdtree_search_flann.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/util/tracing.h>
 
 #include <3rd_party/kd_tree/FLANN/flann.hpp>
 
+#include <algorithm>
+
 
 #define get_tree(x) (reinterpret_cast<const flann::Index< flann::L2<float> > *>(x))
 
@@ -39,6 +42,7 @@ namespace easy3d {
 
         //checks_ = 32;
         checks_ = flann::FLANN_CHECKS_AUTOTUNED;
+        eps_ = 0.0f;    // exact search
     }
 
 
@@ -51,13 +55,18 @@ namespace easy3d {
         checks_ = chk;
     }
 
+    void KdTreeSearch_FLANN::set_accuracy(float eps) {
+        eps_ = eps;
+    }
+
     void KdTreeSearch_FLANN::begin()  {
         delete get_tree(tree_);
         tree_ = nullptr;
     }
 
 
-    void KdTreeSearch_FLANN::end()  {
+    void KdTreeSearch_FLANN::end() {
+        EASY3D_TRACE_SCOPE("KdTreeSearch_FLANN::end");
         flann::Matrix<float> dataset(points_, points_num_, 3);
 
         // construct a single kd-tree optimized for searching lower dimensionality data
@@ -81,7 +90,7 @@ namespace easy3d {
         std::vector< std::vector<int> >		indices;
         std::vector< std::vector<float> >	dists;
 
-        get_tree(tree_)->knnSearch(query, indices, dists, 1, flann::SearchParams(checks_));
+        get_tree(tree_)->knnSearch(query, indices, dists, 1, flann::SearchParams(checks_, eps_));
 
         squared_distance = dists[0][0];
         return indices[0][0];
@@ -103,7 +112,7 @@ namespace easy3d {
         std::vector< std::vector<int> >		indices;
         std::vector< std::vector<float> >	dists;
 
-        get_tree(tree_)->knnSearch(query, indices, dists, k, flann::SearchParams(checks_));
+        get_tree(tree_)->knnSearch(query, indices, dists, k, flann::SearchParams(checks_, eps_));
 
         neighbors = indices[0];
         squared_distances = dists[0];
@@ -119,6 +128,25 @@ namespace easy3d {
     }
 
 
+    void KdTreeSearch_FLANN::find_closest_k_points(
+        const vec3* queries, std::size_t num, int k, int* neighbors
+    )  const
+    {
+        // FLANN queries are thread-safe, so the batch is distributed over all cores. The
+        // neighbor indices go directly into the caller-provided buffer.
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(num); ++i) {
+            flann::Matrix<float> query(const_cast<float*>(queries[i].data()), 1, 3);
+            flann::Matrix<int> indices(neighbors + i * k, 1, k);
+            std::vector<float> dists_row(k);
+            flann::Matrix<float> dists(dists_row.data(), 1, k);
+            const int found = get_tree(tree_)->knnSearch(query, indices, dists, k, flann::SearchParams(checks_, eps_));
+            for (int j = found; j < k; ++j)
+                neighbors[i * k + j] = -1;
+        }
+    }
+
+
     void KdTreeSearch_FLANN::find_points_in_range(
         const vec3& p, float squared_radius, std::vector<int>& neighbors, std::vector<float>& squared_distances
         )  const {
@@ -127,7 +155,7 @@ namespace easy3d {
         std::vector< std::vector<int> >		indices;
         std::vector< std::vector<float> >	dists;
 
-        get_tree(tree_)->radiusSearch(query, indices, dists, squared_radius, flann::SearchParams(checks_));
+        get_tree(tree_)->radiusSearch(query, indices, dists, squared_radius, flann::SearchParams(checks_, eps_));
 
         size_t num = indices[0].size();
         neighbors.resize(num);
@@ -148,4 +176,34 @@ namespace easy3d {
     }
 
 
+    void KdTreeSearch_FLANN::find_points_in_range(
+        const vec3* queries, std::size_t num, float squared_radius,
+        std::vector<std::size_t>& offsets, std::vector<int>& neighbors
+    )  const
+    {
+        // The result size of a range query is not known beforehand, so the queries first run in
+        // parallel into per-query lists. A prefix sum over the list sizes then gives the offsets,
+        // and the lists are copied into the compressed result (again in parallel).
+        std::vector< std::vector<int> > rows(num);
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(num); ++i) {
+            flann::Matrix<float> query(const_cast<float*>(queries[i].data()), 1, 3);
+            std::vector< std::vector<int> >     indices;
+            std::vector< std::vector<float> >   dists;
+            get_tree(tree_)->radiusSearch(query, indices, dists, squared_radius, flann::SearchParams(checks_, eps_));
+            rows[i].swap(indices[0]);
+        }
+
+        offsets.resize(num + 1);
+        offsets[0] = 0;
+        for (std::size_t i = 0; i < num; ++i)
+            offsets[i + 1] = offsets[i] + rows[i].size();
+
+        neighbors.resize(offsets[num]);
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(num); ++i)
+            std::copy(rows[i].begin(), rows[i].end(), neighbors.begin() + offsets[i]);
+    }
+
+
 } // namespace easy3d
@@ -54,6 +54,14 @@ namespace easy3d {
          */
         void set_checks(int chk);
 
+        /**
+         * \brief Specifies the tolerated relative error of the nearest neighbor queries.
+         * \param eps FLANN's eps-approximate search: a query may return neighbors whose distance
+         * is up to a factor of (1 + eps) of the true nearest distance. The default value 0
+         * requests exact search. See KdTreeSearch::set_accuracy().
+         */
+        virtual void set_accuracy(float eps);
+
         /// \name Tree construction
         /// @{
         /**
@@ -119,6 +127,14 @@ namespace easy3d {
                 const vec3 &p, int k,
                 std::vector<int> &neighbors
         ) const;
+
+        /**
+         * \brief Queries the K nearest neighbors for a batch of points.
+         * \details See KdTreeSearch::find_closest_k_points(const vec3*, std::size_t, int, int*)
+         *      for the buffer layout. The queries of this backend are thread-safe, so the batch
+         *      is processed in parallel and the results are written directly into \p neighbors.
+         */
+        virtual void find_closest_k_points(const vec3 *queries, std::size_t num, int k, int *neighbors) const;
         /// @}
 
         /// @name Fixed radius search
@@ -148,6 +164,15 @@ namespace easy3d {
                 const vec3 &p, float squared_radius,
                 std::vector<int> &neighbors
         ) const;
+
+        /**
+         * \brief Queries the nearest neighbors within a fixed range for a batch of points.
+         * \details See KdTreeSearch::find_points_in_range(const vec3*, std::size_t, float,
+         *      std::vector<std::size_t>&, std::vector<int>&) for the compressed result layout.
+         *      The queries of this backend are thread-safe, so the batch is processed in parallel.
+         */
+        virtual void find_points_in_range(const vec3 *queries, std::size_t num, float squared_radius,
+                                          std::vector<std::size_t> &offsets, std::vector<int> &neighbors) const;
         /// @}
 
     protected:
@@ -155,6 +180,7 @@ namespace easy3d {
         float *points_; // reference of the original point cloud data
 
         void *tree_;
+        float eps_;     // allowed relative error of approximate queries (0 = exact)
         int checks_;
     };
 
@@ -24,9 +24,12 @@
 
 #include <easy3d/kdtree/kdtree_search_nanoflann.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/util/tracing.h>
 
 #include <3rd_party/kd_tree/nanoflann/nanoflann.hpp>
 
+#include <algorithm>
+
 
 using namespace nanoflann;
 
@@ -87,6 +90,7 @@ namespace easy3d {
 
 
     void KdTreeSearch_NanoFLANN::end() {
+        EASY3D_TRACE_SCOPE("KdTreeSearch_NanoFLANN::end");
         PointSet* pset = new PointSet(points_);
         KdTree* tree = new KdTree(pset);
         tree->buildIndex();
@@ -99,6 +103,62 @@ namespace easy3d {
     }
 
 
+    bool KdTreeSearch_NanoFLANN::save(const std::string& file_name) const {
+        if (!tree_) {
+            LOG(WARNING) << "no index to save (the tree has not been built)";
+            return false;
+        }
+
+        FILE* file = fopen(file_name.c_str(), "wb");
+        if (!file) {
+            LOG(WARNING) << "could not open file: " << file_name;
+            return false;
+        }
+
+        bool ok = write_index_header(file, 1, points_->size());
+        if (ok)  // NanoFLANN serializes its own index (the point data stays with the cloud)
+            const_cast<KdTree*>(get_tree(tree_))->saveIndex(file);
+        ok = ok && ferror(file) == 0;
+        fclose(file);
+        return ok;
+    }
+
+
+    bool KdTreeSearch_NanoFLANN::load(PointCloud* cloud, const std::string& file_name) {
+        FILE* file = fopen(file_name.c_str(), "rb");
+        if (!file) {
+            LOG(WARNING) << "could not open file: " << file_name;
+            return false;
+        }
+
+        if (!read_index_header(file, 1, cloud->n_vertices())) {
+            fclose(file);
+            return false;
+        }
+
+        begin();
+        add_point_cloud(cloud);
+        PointSet* pset = new PointSet(points_);
+        KdTree* tree = new KdTree(pset);    // the constructor does not build the index
+        bool ok = true;
+        try {
+            tree->loadIndex(file);
+        }
+        catch (const std::exception& e) {   // NanoFLANN throws on truncated files
+            LOG(WARNING) << "failed reading the index from file: " << file_name << " (" << e.what() << ")";
+            ok = false;
+        }
+        fclose(file);
+
+        if (!ok) {
+            delete tree;
+            return false;
+        }
+        tree_ = tree;
+        return true;
+    }
+
+
     int KdTreeSearch_NanoFLANN::find_closest_point(const vec3& p, float& squared_distance) const {
         std::size_t index;
 
@@ -132,6 +192,30 @@ namespace easy3d {
     }
 
 
+    void KdTreeSearch_NanoFLANN::find_closest_k_points(
+        const vec3* queries, std::size_t num, int k, int* neighbors
+    )  const
+    {
+        // NanoFLANN queries are thread-safe, so the batch is distributed over all cores.
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(num); ++i) {
+            std::vector<size_t> indices(k);
+            std::vector<float>  sqr_distances(k);
+
+            nanoflann::KNNResultSet<float> result_set(k);
+            result_set.init(&indices[0], &sqr_distances[0]);
+            get_tree(tree_)->findNeighbors(result_set, queries[i], nanoflann::SearchParams(10));
+
+            int* out = neighbors + i * k;
+            const int found = static_cast<int>(result_set.size());
+            for (int j = 0; j < found; ++j)
+                out[j] = static_cast<int>(indices[j]);
+            for (int j = found; j < k; ++j)
+                out[j] = -1;
+        }
+    }
+
+
     void KdTreeSearch_NanoFLANN::find_closest_k_points(
         const vec3& p, int k, std::vector<int>& neighbors
     )  const
@@ -168,4 +252,36 @@ namespace easy3d {
     }
 
 
+    void KdTreeSearch_NanoFLANN::find_points_in_range(
+        const vec3* queries, std::size_t num, float squared_radius,
+        std::vector<std::size_t>& offsets, std::vector<int>& neighbors
+    )  const
+    {
+        // The result size of a range query is not known beforehand, so the queries first run in
+        // parallel into per-query lists. A prefix sum over the list sizes then gives the offsets,
+        // and the lists are copied into the compressed result (again in parallel).
+        std::vector< std::vector<int> > rows(num);
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(num); ++i) {
+            std::vector<std::pair<std::size_t, float> > matches;
+            nanoflann::SearchParams params;
+            params.sorted = false;
+            const std::size_t found = get_tree(tree_)->radiusSearch(queries[i], squared_radius, matches, params);
+            rows[i].resize(found);
+            for (std::size_t j = 0; j < found; ++j)
+                rows[i][j] = static_cast<int>(matches[j].first);
+        }
+
+        offsets.resize(num + 1);
+        offsets[0] = 0;
+        for (std::size_t i = 0; i < num; ++i)
+            offsets[i + 1] = offsets[i] + rows[i].size();
+
+        neighbors.resize(offsets[num]);
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(num); ++i)
+            std::copy(rows[i].begin(), rows[i].end(), neighbors.begin() + offsets[i]);
+    }
+
+
 } // namespace easy3d
@@ -60,6 +60,14 @@ namespace easy3d {
         virtual void end();
         /// @}
 
+        /// \name Persistent indices
+        /// @{
+        /// \brief Saves the built index to a binary file. See KdTreeSearch::save().
+        virtual bool save(const std::string &file_name) const;
+        /// \brief Restores an index previously written by save(). See KdTreeSearch::load().
+        virtual bool load(PointCloud *cloud, const std::string &file_name);
+        /// @}
+
         /// \name Closest point query
         /// @{
 
@@ -107,6 +115,14 @@ namespace easy3d {
                 const vec3 &p, int k,
                 std::vector<int> &neighbors
         ) const;
+
+        /**
+         * \brief Queries the K nearest neighbors for a batch of points.
+         * \details See KdTreeSearch::find_closest_k_points(const vec3*, std::size_t, int, int*)
+         *      for the buffer layout. The queries of this backend are thread-safe, so the batch
+         *      is processed in parallel and the results are written directly into \p neighbors.
+         */
+        virtual void find_closest_k_points(const vec3 *queries, std::size_t num, int k, int *neighbors) const;
         /// @}
 
         /// @name Fixed radius search
@@ -136,6 +152,15 @@ namespace easy3d {
                 const vec3 &p, float squared_radius,
                 std::vector<int> &neighbors
         ) const;
+
+        /**
+         * \brief Queries the nearest neighbors within a fixed range for a batch of points.
+         * \details See KdTreeSearch::find_points_in_range(const vec3*, std::size_t, float,
+         *      std::vector<std::size_t>&, std::vector<int>&) for the compressed result layout.
+         *      The queries of this backend are thread-safe, so the batch is processed in parallel.
+         */
+        virtual void find_points_in_range(const vec3 *queries, std::size_t num, float squared_radius,
+                                          std::vector<std::size_t> &offsets, std::vector<int> &neighbors) const;
         /// @}
 
     protected:
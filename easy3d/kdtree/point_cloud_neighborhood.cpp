@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/kdtree/point_cloud_neighborhood.h>
+#include <easy3d/kdtree/kdtree_search_nanoflann.h>
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    PointCloudNeighborhood::PointCloudNeighborhood() {
+    }
+
+
+    void PointCloudNeighborhood::clear() {
+        std::vector<std::size_t>().swap(offsets_);
+        std::vector<int>().swap(neighbors_);
+    }
+
+
+    void PointCloudNeighborhood::build_knn(PointCloud *cloud, int k, KdTreeSearch *tree) {
+        clear();
+        if (!cloud || cloud->n_vertices() == 0 || k <= 0) {
+            LOG_IF(ERROR, k <= 0) << "invalid number of neighbors: " << k;
+            return;
+        }
+
+        KdTreeSearch *kdtree = tree;
+        bool need_delete(false);
+        if (!kdtree) {
+            // the NanoFLANN backend has thread-safe queries, so the batch runs in parallel
+            kdtree = new KdTreeSearch_NanoFLANN;
+            kdtree->begin();
+            kdtree->add_point_cloud(cloud);
+            kdtree->end();
+            need_delete = true;
+        }
+
+        const std::size_t num = cloud->n_vertices();
+        const std::vector<vec3> &points = cloud->points();
+
+        std::vector<int> flat(num * k);
+        kdtree->find_closest_k_points(points.data(), num, k, flat.data());
+
+        if (need_delete)
+            delete kdtree;
+
+        // compress the fixed-stride buffer into CSR, dropping the -1 entries of points with
+        // fewer than k neighbors (this only happens for clouds with fewer than k points)
+        offsets_.resize(num + 1);
+        offsets_[0] = 0;
+        for (std::size_t i = 0; i < num; ++i) {
+            std::size_t found = 0;
+            while (found < static_cast<std::size_t>(k) && flat[i * k + found] >= 0)
+                ++found;
+            offsets_[i + 1] = offsets_[i] + found;
+        }
+
+        neighbors_.resize(offsets_[num]);
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(num); ++i) {
+            const std::size_t found = offsets_[i + 1] - offsets_[i];
+            for (std::size_t j = 0; j < found; ++j)
+                neighbors_[offsets_[i] + j] = flat[i * k + j];
+        }
+    }
+
+
+    void PointCloudNeighborhood::build_radius(PointCloud *cloud, float radius, KdTreeSearch *tree) {
+        clear();
+        if (!cloud || cloud->n_vertices() == 0 || radius <= 0.0f) {
+            LOG_IF(ERROR, radius <= 0.0f) << "invalid search radius: " << radius;
+            return;
+        }
+
+        KdTreeSearch *kdtree = tree;
+        bool need_delete(false);
+        if (!kdtree) {
+            // the NanoFLANN backend has thread-safe queries, so the batch runs in parallel
+            kdtree = new KdTreeSearch_NanoFLANN;
+            kdtree->begin();
+            kdtree->add_point_cloud(cloud);
+            kdtree->end();
+            need_delete = true;
+        }
+
+        const std::vector<vec3> &points = cloud->points();
+        kdtree->find_points_in_range(points.data(), points.size(), radius * radius, offsets_, neighbors_);
+
+        if (need_delete)
+            delete kdtree;
+    }
+
+} // namespace easy3d
@@ -0,0 +1,104 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_POINT_CLOUD_NEIGHBORHOOD_H
+#define EASY3D_POINT_CLOUD_NEIGHBORHOOD_H
+
+
+#include <cstddef>
+#include <vector>
+
+
+namespace easy3d {
+
+    class PointCloud;
+    class KdTreeSearch;
+
+    /**
+     * \brief Precomputed neighborhoods of all the points of a point cloud.
+     * \class PointCloudNeighborhood easy3d/kdtree/point_cloud_neighborhood.h
+     *
+     * \details Several point cloud algorithms (e.g., normal estimation, uniform simplification)
+     * start by querying the neighborhood of every point from a KdTreeSearch. When such stages run
+     * back-to-back on the same cloud, the same queries are paid for once per stage. This class
+     * computes all the neighborhoods once (in a parallel batch) and stores them in a compressed
+     * layout (CSR: an offset per point into one flat array of neighbor indices) that the
+     * algorithms then consume, e.g., PointCloudNormals::estimate() and
+     * PointCloudSimplification::uniform_simplification().
+     *
+     * \attention The cache stores indices into the point cloud it was built from; it becomes
+     * stale when the points change. The order of the neighbors within the list of a point is
+     * backend-dependent; in particular, the point itself is part of its own neighborhood but is
+     * not guaranteed to be the first entry.
+     */
+    class PointCloudNeighborhood {
+    public:
+        PointCloudNeighborhood();
+
+        /**
+         * \brief Computes the k nearest neighbors of every point of \p cloud.
+         * \param cloud The point cloud.
+         * \param k The number of neighbors per point (points of a degenerate cloud with fewer
+         *      than \p k points get shorter lists).
+         * \param kdtree A kdtree defined on this point cloud. If null, a new kdtree will be
+         *      built and used.
+         */
+        void build_knn(PointCloud *cloud, int k, KdTreeSearch *kdtree = nullptr);
+
+        /**
+         * \brief Computes, for every point of \p cloud, all the neighbors within a fixed range.
+         * \param cloud The point cloud.
+         * \param radius The search range (\b not squared).
+         * \param kdtree A kdtree defined on this point cloud. If null, a new kdtree will be
+         *      built and used.
+         */
+        void build_radius(PointCloud *cloud, float radius, KdTreeSearch *kdtree = nullptr);
+
+        /// \brief Discards the cached neighborhoods.
+        void clear();
+
+        /// \brief The number of points the neighborhoods were computed for (0 if not built).
+        std::size_t num_points() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+        /// \brief The number of neighbors of point \p i.
+        std::size_t size(std::size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+        /// \brief The neighbor indices of point \p i (valid for size(\p i) entries).
+        const int *neighbors(std::size_t i) const { return neighbors_.data() + offsets_[i]; }
+
+        /// \name Raw compressed storage
+        /// The neighbors of point \c i are neighbors()[offsets()[i]] ... neighbors()[offsets()[i + 1] - 1].
+        /// @{
+        const std::vector<std::size_t> &offsets() const { return offsets_; }
+        const std::vector<int> &neighbors() const { return neighbors_; }
+        /// @}
+
+    private:
+        std::vector<std::size_t> offsets_;
+        std::vector<int> neighbors_;
+    };
+
+} // namespace easy3d
+
+#endif  // EASY3D_POINT_CLOUD_NEIGHBORHOOD_H
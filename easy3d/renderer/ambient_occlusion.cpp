@@ -25,6 +25,7 @@
 #include <easy3d/renderer/ambient_occlusion.h>
 
 #include <random>
+#include <algorithm>
 
 #include <easy3d/core/model.h>
 #include <easy3d/renderer/camera.h>
@@ -60,8 +61,12 @@ namespace easy3d {
         : camera_(cam)
         , radius_(0.5f)
         , bias_(0.005f)
+        , resolution_scale_(1.0f)
+        , width_(0)
+        , height_(0)
         , geom_fbo_(nullptr)
         , ssao_fbo_(nullptr)
+        , filter_fbo_(nullptr)
         , noise_texture_(0)
     {
     }
@@ -70,6 +75,7 @@ namespace easy3d {
     AmbientOcclusion::~AmbientOcclusion() {
         delete geom_fbo_;
         delete ssao_fbo_;
+        delete filter_fbo_;
 
         if (glIsTexture(noise_texture_)) {
             glDeleteTextures(1, &noise_texture_);
@@ -80,25 +86,44 @@ namespace easy3d {
     }
 
 
-    void AmbientOcclusion::init(int w, int h)
+    void AmbientOcclusion::set_resolution_scale(float s) {
+        resolution_scale_ = std::min(1.0f, std::max(0.25f, s));
+    }
+
+
+    void AmbientOcclusion::init(int w, int h, bool with_geometry)
     {
         // Liangliang: using multsamples (i.e., 4) causes black screen in my macbook laptop.
         //             the bad call is at glReadPixels() with GL_UNSIGNED_BYTE.
         static int samples = 0;
-        if (geom_fbo_ == nullptr) {
-            geom_fbo_ = new FramebufferObject(w, h, samples);
-            geom_fbo_->add_depth_buffer(GL_DEPTH32F_STENCIL8);
-            geom_fbo_->add_color_texture(GL_RGB32F, GL_RGB, GL_FLOAT, GL_LINEAR); // position
-            geom_fbo_->add_color_texture(GL_RGB32F, GL_RGB, GL_FLOAT, GL_LINEAR); // normal
+        if (with_geometry) {
+            if (geom_fbo_ == nullptr) {
+                geom_fbo_ = new FramebufferObject(w, h, samples);
+                geom_fbo_->add_depth_buffer(GL_DEPTH32F_STENCIL8);
+                geom_fbo_->add_color_texture(GL_RGB32F, GL_RGB, GL_FLOAT, GL_LINEAR); // position
+                geom_fbo_->add_color_texture(GL_RGB32F, GL_RGB, GL_FLOAT, GL_LINEAR); // normal
+            }
+            geom_fbo_->ensure_size(w, h);
         }
-        geom_fbo_->ensure_size(w, h);
 
+        // the sampling pass runs at reduced resolution (the geometry buffers stay at full
+        // resolution: they drive the depth-aware upsampling)
+        const int sw = std::max(1, static_cast<int>(static_cast<float>(w) * resolution_scale_));
+        const int sh = std::max(1, static_cast<int>(static_cast<float>(h) * resolution_scale_));
         if (ssao_fbo_ == nullptr) {
-            ssao_fbo_ = new FramebufferObject(w, h, samples);
+            ssao_fbo_ = new FramebufferObject(sw, sh, samples);
             ssao_fbo_->add_color_texture(GL_R32F, GL_RED, GL_FLOAT, GL_LINEAR); // for ssao result
             ssao_fbo_->add_color_texture(GL_R32F, GL_RED, GL_FLOAT, GL_LINEAR); // for blur result
         }
-        ssao_fbo_->ensure_size(w, h);
+        ssao_fbo_->ensure_size(sw, sh);
+
+        if (resolution_scale_ < 1.0f) {
+            if (filter_fbo_ == nullptr) {
+                filter_fbo_ = new FramebufferObject(w, h, samples);
+                filter_fbo_->add_color_texture(GL_R32F, GL_RED, GL_FLOAT, GL_LINEAR); // for the upsampled result
+            }
+            filter_fbo_->ensure_size(w, h);
+        }
     }
 
 
@@ -143,20 +168,47 @@ namespace easy3d {
     unsigned int AmbientOcclusion::generate(const std::vector<Model*>& models) {
         int viewport[4];
         glGetIntegerv(GL_VIEWPORT, viewport);
-        init(viewport[2], viewport[3]);
+        width_ = viewport[2];
+        height_ = viewport[3];
+        init(width_, height_, true);
 
         geometry_pass(models);
 
-        ssao_pass();
+        ssao_pass(0);
 
-        blur_pass();
+        if (resolution_scale_ < 1.0f)
+            upsample_pass(0);
+        else
+            blur_pass();
+
+        return ssao_texture();
+    }
+
+
+    unsigned int AmbientOcclusion::generate(unsigned int depth_texture) {
+        int viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        width_ = viewport[2];
+        height_ = viewport[3];
+        init(width_, height_, false);
+
+        // positions and normals are reconstructed from the shared depth texture, so no
+        // geometry pass is needed here
+        ssao_pass(depth_texture);
+
+        if (resolution_scale_ < 1.0f)
+            upsample_pass(depth_texture);
+        else
+            blur_pass();
 
         return ssao_texture();
     }
 
 
     unsigned int AmbientOcclusion::ssao_texture() const {
-         return ssao_fbo_->color_texture(1);
+        if (resolution_scale_ < 1.0f)
+            return filter_fbo_->color_texture(0);
+        return ssao_fbo_->color_texture(1);
     }
 
 
@@ -226,15 +278,18 @@ namespace easy3d {
 	}
 
 
-    void AmbientOcclusion::ssao_pass() {
+    void AmbientOcclusion::ssao_pass(unsigned int depth_texture) {
+        // with a shared depth prepass, positions and normals are reconstructed from the depth values
         static const std::string name = "ssao/ssao";
-        ShaderProgram* program = ShaderManager::get_program(name);
+        static const std::string name_reconstruct = "ssao/ssao_reconstruct";
+        const std::string& program_name = (depth_texture != 0) ? name_reconstruct : name;
+        ShaderProgram* program = ShaderManager::get_program(program_name);
         if (!program) {
             std::vector<ShaderProgram::Attribute> attributes = {
                 ShaderProgram::Attribute(ShaderProgram::POSITION, "vertexMC"),
                 ShaderProgram::Attribute(ShaderProgram::TEXCOORD, "tcoordMC")
             };
-            program = ShaderManager::create_program_from_files(name, attributes);
+            program = ShaderManager::create_program_from_files(program_name, attributes);
         }
         if (!program)
             return;
@@ -254,11 +309,24 @@ namespace easy3d {
         program->set_uniform("PROJ", PROJ);
         program->set_uniform("radius", camera_->sceneRadius() * radius_);
         program->set_uniform("bias", bias_);
-        program->bind_texture("gPosition", geom_fbo_->color_texture(0), 0);	// position
-        program->bind_texture("gNormal", geom_fbo_->color_texture(1), 1);		// normal
-        program->bind_texture("texNoise", noise_texture_, 2); easy3d_debug_log_gl_error
+        if (depth_texture != 0) {
+            program->set_uniform("invPROJ", inverse(PROJ));
+            program->bind_texture("depthTexture", depth_texture, 0);
+            program->bind_texture("texNoise", noise_texture_, 1); easy3d_debug_log_gl_error
+        }
+        else {
+            program->bind_texture("gPosition", geom_fbo_->color_texture(0), 0);	// position
+            program->bind_texture("gNormal", geom_fbo_->color_texture(1), 1);		// normal
+            program->bind_texture("texNoise", noise_texture_, 2); easy3d_debug_log_gl_error
+        }
 
-        opengl::draw_full_screen_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0.0f);
+        if (resolution_scale_ < 1.0f) {
+            const int sw = std::max(1, static_cast<int>(static_cast<float>(width_) * resolution_scale_));
+            const int sh = std::max(1, static_cast<int>(static_cast<float>(height_) * resolution_scale_));
+            opengl::draw_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0, 0, sw, sh, width_, height_, 0.0f);
+        }
+        else
+            opengl::draw_full_screen_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0.0f);
         easy3d_debug_log_gl_error;
 
         program->release_texture(); easy3d_debug_log_gl_error
@@ -300,4 +368,41 @@ namespace easy3d {
 #endif
     }
 
+
+    void AmbientOcclusion::upsample_pass(unsigned int depth_texture) {
+        static const std::string name = "ssao/bilateral_upsample";
+        ShaderProgram* program = ShaderManager::get_program(name);
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes = {
+                ShaderProgram::Attribute(ShaderProgram::POSITION, "vertexMC"),
+                ShaderProgram::Attribute(ShaderProgram::TEXCOORD, "tcoordMC")
+            };
+            program = ShaderManager::create_program_from_files(name, attributes);
+        }
+        if (!program)
+            return;
+
+        filter_fbo_->bind(); easy3d_debug_log_gl_error
+        filter_fbo_->activate_draw_buffer(0);
+        glClear(GL_COLOR_BUFFER_BIT); easy3d_debug_log_gl_error
+
+        program->bind(); easy3d_debug_log_gl_error
+        program->bind_texture("ssaoInput", ssao_fbo_->color_texture(0), 0);
+        if (depth_texture != 0)
+            program->bind_texture("depthTexture", depth_texture, 1);
+        else
+            program->bind_texture("gPosition", geom_fbo_->color_texture(0), 1);
+        program->set_uniform("use_depth_texture", depth_texture != 0);
+        program->set_uniform("Znear", camera_->zNear());
+        program->set_uniform("Zfar", camera_->zFar());
+        opengl::draw_full_screen_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0.0f);
+        program->release_texture(); easy3d_debug_log_gl_error
+        program->release(); easy3d_debug_log_gl_error
+        filter_fbo_->release();
+
+#ifdef SNAPSHOT_BUFFERS
+        filter_fbo_->snapshot_color_ppm(0, "ssao_upsample.ppm");
+#endif
+    }
+
 } // namespace easy3d
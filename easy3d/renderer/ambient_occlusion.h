@@ -62,18 +62,38 @@ namespace easy3d {
         /// \brief Returns the bias.
         float bias() const { return bias_; }
 
+        /// \brief Sets the resolution scale at which the occlusion is computed. Valid range is
+        ///     [0.25, 1.0]: 1.0 (default) computes the effect at the full viewport resolution, 0.5 at
+        ///     half, and 0.25 at quarter resolution. A reduced-resolution result is upsampled back to
+        ///     the viewport resolution with a depth-aware filter, so silhouettes stay sharp while the
+        ///     expensive sampling pass runs on a fraction of the pixels (a big win on 4K monitors).
+        void  set_resolution_scale(float s);
+        /// \brief Returns the resolution scale.
+        float resolution_scale() const { return resolution_scale_; }
+
         /// \brief Generates the SSAO texture
         /// \return The SSAO texture ID
         virtual unsigned int generate(const std::vector<Model*>& models);
+
+        /// \brief Generates the SSAO texture from an existing depth texture, e.g., the depth texture
+        ///     of the EyeDomeLighting projection pass. Eye-space positions and normals are
+        ///     reconstructed from the depth values, so the geometry does not have to be rendered
+        ///     again into the internal FramebufferObject. This allows multiple effects to share a
+        ///     single depth prepass.
+        /// \return The SSAO texture ID
+        unsigned int generate(unsigned int depth_texture);
+
         /// \brief Returns the generated SSAO texture ID
         unsigned int ssao_texture() const;
 
     protected:
-        void init(int w, int h);
+        void init(int w, int h, bool with_geometry);
 
         void geometry_pass(const std::vector<Model*>& models);
-        void ssao_pass();
+        // depth_texture is 0 when the internal geometry buffers are used
+        void ssao_pass(unsigned int depth_texture);
         void blur_pass();
+        void upsample_pass(unsigned int depth_texture);
 
         void generate_noise(int width, int height);
 
@@ -82,9 +102,14 @@ namespace easy3d {
 
         float	radius_;
         float	bias_;
+        float	resolution_scale_;
+
+        int		width_;
+        int		height_;
 
         FramebufferObject*	geom_fbo_;
         FramebufferObject*	ssao_fbo_;
+        FramebufferObject*	filter_fbo_;	// for the depth-aware upsampling result
 
         std::vector<vec3> ssao_kernel_;
         unsigned int	  noise_texture_;
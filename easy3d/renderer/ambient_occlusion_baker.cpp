@@ -0,0 +1,200 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/ambient_occlusion_baker.h>
+
+#include <cmath>
+
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/framebuffer_object.h>
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/shader_manager.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/renderer/transform.h>
+#include <easy3d/util/logging.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace easy3d {
+
+    AmbientOcclusionBaker::AmbientOcclusionBaker()
+        : num_directions_(64)
+        , resolution_(1024)
+        , bias_(0.005f)
+        , fbo_(nullptr)
+    {
+    }
+
+
+    AmbientOcclusionBaker::~AmbientOcclusionBaker() {
+        delete fbo_;
+        easy3d_debug_log_gl_error;
+    }
+
+
+    std::vector<vec3> AmbientOcclusionBaker::sample_directions() const {
+        // a Fibonacci spiral covers the sphere nearly uniformly for any direction count
+        std::vector<vec3> directions(num_directions_);
+        const float golden_angle = static_cast<float>(M_PI) * (3.0f - std::sqrt(5.0f));
+        for (int i = 0; i < num_directions_; ++i) {
+            const float z = 1.0f - 2.0f * (float(i) + 0.5f) / float(num_directions_);
+            const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+            const float phi = golden_angle * float(i);
+            directions[i] = vec3(r * std::cos(phi), r * std::sin(phi), z);
+        }
+        return directions;
+    }
+
+
+    bool AmbientOcclusionBaker::bake(SurfaceMesh* mesh, bool modulate_vertex_colors) {
+        if (!mesh || mesh->n_faces() == 0) {
+            LOG(ERROR) << "surface mesh is null or empty";
+            return false;
+        }
+        if (num_directions_ <= 0 || resolution_ <= 0) {
+            LOG(ERROR) << "invalid baking parameters (directions: " << num_directions_
+                       << ", resolution: " << resolution_ << ")";
+            return false;
+        }
+
+        auto normals = mesh->get_vertex_property<vec3>("v:normal");
+        if (!normals) {
+            mesh->update_vertex_normals();
+            normals = mesh->get_vertex_property<vec3>("v:normal");
+        }
+
+        // the same depth-only program the shadow map pass uses
+        static const std::string name = "shadow/shadow_generate";
+        ShaderProgram* program = ShaderManager::get_program(name);
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes;
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"));
+            program = ShaderManager::create_program_from_files(name, attributes, std::vector<std::string>(), false);
+        }
+        if (!program)
+            return false;
+
+        // a transient drawable carrying the triangulated mesh (the baked result must not
+        // depend on the visibility or coloring state of the model's own drawables)
+        TrianglesDrawable drawable("ao_baking");
+        drawable.update_vertex_buffer(mesh->points());
+        std::vector<unsigned int> indices;
+        indices.reserve(mesh->n_faces() * 3);
+        for (auto f : mesh->faces()) {
+            // fan triangulation (exact for the triangle meshes this is meant for)
+            auto it = mesh->vertices(f).begin();
+            const unsigned int first = (*it).idx();
+            ++it;
+            unsigned int previous = (*it).idx();
+            ++it;
+            for (auto end = mesh->vertices(f).end(); it != end; ++it) {
+                indices.push_back(first);
+                indices.push_back(previous);
+                previous = (*it).idx();
+                indices.push_back(previous);
+            }
+        }
+        drawable.update_element_buffer(indices);
+
+        if (!fbo_) {
+            fbo_ = new FramebufferObject(resolution_, resolution_, 0);
+            fbo_->add_depth_buffer();
+        }
+        fbo_->ensure_size(resolution_, resolution_);
+
+        int viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        // the orthographic frustum encloses the bounding sphere from every direction
+        const Box3& box = mesh->bounding_box();
+        const vec3 center = box.center();
+        const float radius = box.diagonal() * 0.5f + 1e-6f;
+        const mat4 projection = transform::ortho(-radius, radius, -radius, radius, 0.1f * radius, 3.0f * radius);
+
+        const std::vector<vec3>& points = mesh->points();
+        const int num = static_cast<int>(mesh->n_vertices());
+        std::vector<float> visibility(num, 0.0f);
+        std::vector<float> weights(num, 0.0f);
+        std::vector<float> depths(std::size_t(resolution_) * resolution_);
+
+        for (const auto& direction : sample_directions()) {
+            const vec3 up = std::abs(direction.z) < 0.9f ? vec3(0, 0, 1) : vec3(1, 0, 0);
+            const mat4 view = transform::look_at(center + direction * (2.0f * radius), center, up);
+            const mat4 MVP = projection * view;
+
+            fbo_->bind();
+            fbo_->deactivate_draw_buffers();
+            glViewport(0, 0, resolution_, resolution_);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            program->bind();
+            program->set_uniform("MVP", MVP);   easy3d_debug_log_gl_error;
+            drawable.gl_draw(false);            easy3d_debug_log_gl_error;
+            program->release();
+            fbo_->read_depth(depths.data(), false);
+            fbo_->release();
+
+            // test each vertex against the depth map and accumulate the cosine-weighted
+            // visibility of this direction
+#pragma omp parallel for
+            for (int i = 0; i < num; ++i) {
+                const float weight = dot(normals[SurfaceMesh::Vertex(i)], direction);
+                if (weight <= 0.0f)
+                    continue;   // the direction lies below the surface at this vertex
+                const vec4 clip = MVP * vec4(points[i], 1.0f);
+                const float u = clip.x * 0.5f + 0.5f;
+                const float v = clip.y * 0.5f + 0.5f;
+                const float depth = clip.z * 0.5f + 0.5f;
+                const int px = std::min(resolution_ - 1, std::max(0, int(u * float(resolution_))));
+                const int py = std::min(resolution_ - 1, std::max(0, int(v * float(resolution_))));
+                weights[i] += weight;
+                if (depth <= depths[std::size_t(py) * resolution_ + px] + bias_)
+                    visibility[i] += weight;
+            }
+        }
+
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+        auto ao = mesh->vertex_property<float>("v:ao");
+        for (int i = 0; i < num; ++i)
+            ao[SurfaceMesh::Vertex(i)] = weights[i] > 0.0f ? visibility[i] / weights[i] : 1.0f;
+
+        if (modulate_vertex_colors) {
+            auto colors = mesh->get_vertex_property<vec3>("v:color");
+            if (!colors)
+                colors = mesh->add_vertex_property<vec3>("v:color", vec3(1, 1, 1));
+            for (auto v : mesh->vertices())
+                colors[v] *= ao[v];
+        }
+
+        LOG(INFO) << "ambient occlusion baked into 'v:ao' (" << num_directions_
+                  << " directions at " << resolution_ << "^2)";
+        return true;
+    }
+
+} // namespace easy3d
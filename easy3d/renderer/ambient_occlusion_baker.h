@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_AMBIENT_OCCLUSION_BAKER_H
+#define EASY3D_RENDERER_AMBIENT_OCCLUSION_BAKER_H
+
+#include <vector>
+
+#include <easy3d/core/types.h>
+
+
+namespace easy3d {
+
+    class SurfaceMesh;
+    class FramebufferObject;
+
+    /**
+     * \brief Offline baking of ambient occlusion into vertex properties.
+     * \class AmbientOcclusionBaker easy3d/renderer/ambient_occlusion_baker.h
+     *
+     * \details The screen-space AmbientOcclusion effect is recomputed every frame. For static
+     *      models (e.g., scan meshes) the occlusion can instead be baked once: this class
+     *      renders the mesh into a depth map from a set of directions distributed over the
+     *      sphere (the same depth-only pass the shadow map uses), tests each vertex against
+     *      the maps, and accumulates the cosine-weighted hemispherical visibility. The result
+     *      is stored in the \c "v:ao" vertex property (1 = fully open, 0 = fully occluded)
+     *      and can optionally be multiplied into \c "v:color", so production viewing gets the
+     *      occlusion for free and the SSAO pass can be switched off.
+     *
+     * \attention Baking issues OpenGL calls and therefore requires a current OpenGL context
+     *      (i.e., call it from the rendering thread of a viewer).
+     */
+    class AmbientOcclusionBaker {
+    public:
+        AmbientOcclusionBaker();
+        ~AmbientOcclusionBaker();
+
+        /// \brief The number of visibility directions (default: 64). More directions give a
+        ///     smoother result at proportionally higher baking cost.
+        void set_num_directions(int num) { num_directions_ = num; }
+        int num_directions() const { return num_directions_; }
+
+        /// \brief The resolution of the depth map rendered per direction (default: 1024).
+        void set_resolution(int resolution) { resolution_ = resolution; }
+        int resolution() const { return resolution_; }
+
+        /// \brief The depth comparison bias in normalized depth units (default: 0.005).
+        ///     Raise it if flat regions show self-occlusion speckles.
+        void set_bias(float bias) { bias_ = bias; }
+        float bias() const { return bias_; }
+
+        /**
+         * \brief Bakes the ambient occlusion of \p mesh into its \c "v:ao" vertex property.
+         * \param mesh The mesh. Vertex normals are computed if not present.
+         * \param modulate_vertex_colors If true, \c "v:color" is additionally multiplied by
+         *      the baked occlusion (the property is created as white if absent), so existing
+         *      color-property rendering picks the result up without any shader change.
+         * \return true on success.
+         */
+        bool bake(SurfaceMesh* mesh, bool modulate_vertex_colors = false);
+
+    private:
+        // directions spread over the unit sphere (a Fibonacci spiral)
+        std::vector<vec3> sample_directions() const;
+
+    private:
+        int num_directions_;
+        int resolution_;
+        float bias_;
+        FramebufferObject* fbo_;
+    };
+
+} // namespace easy3d
+
+
+#endif // EASY3D_RENDERER_AMBIENT_OCCLUSION_BAKER_H
@@ -59,10 +59,14 @@ namespace easy3d {
 
     void AverageColorBlending::init(int w, int h) {
         if (!fbo_) {
-            const int samples = 4;
+            // match the sample count of the framebuffer holding the opaque pass, so its depth
+            // buffer can be blitted here 1:1 (sample counts must agree for a multisample blit)
+            int samples = 0;
+            glGetIntegerv(GL_SAMPLES, &samples);
             fbo_ = new FramebufferObject(w, h, samples);
-            fbo_->add_color_texture(GL_RGBA32F, GL_RGBA, GL_FLOAT);
-            fbo_->add_color_texture(GL_R32F, GL_RED, GL_FLOAT);
+            fbo_->add_color_texture(GL_RGBA32F, GL_RGBA, GL_FLOAT);    // weighted color accumulation
+            fbo_->add_color_texture(GL_RG32F, GL_RG, GL_FLOAT);        // total opacity and fragment count
+            fbo_->add_depth_buffer();
         }
         fbo_->ensure_size(w, h);
 
@@ -130,23 +134,37 @@ namespace easy3d {
         const int h = viewport[3];
         init(w, h);
 
-        glDisable(GL_DEPTH_TEST);
+        // the framebuffer holding the opaque pass; its depth buffer is reused below
+        GLint opaque_fbo = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &opaque_fbo);
 
         // ---------------------------------------------------------------------
-        // 1. Accumulate Colors and Depth Complexity
+        // 1. Accumulate Weighted Colors and Depth Complexity (a single
+        //    geometry submission into both render targets)
         // ---------------------------------------------------------------------
         fbo_->bind();
         fbo_->activate_draw_buffers(0, 1);
         glClearColor(0, 0, 0, 0);
         glClear(GL_COLOR_BUFFER_BIT);
+
+        // Share the depth buffer of the opaque pass: blitting it here (instead of re-rendering
+        // the opaque geometry into this fbo) makes hidden transparent fragments fail the depth
+        // test, at the cost of a single buffer copy.
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, opaque_fbo);     easy3d_debug_log_gl_error;
+        glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_DEPTH_BUFFER_BIT, GL_NEAREST);     easy3d_debug_log_gl_error;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_->handle()); easy3d_debug_log_gl_error;
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);  // transparent fragments are tested against the opaque depth, but never write it
         glEnable(GL_BLEND);
         glBlendEquation(GL_FUNC_ADD);
         glBlendFunc(GL_ONE, GL_ONE);
         geometry_pass(surfaces);
+        glDepthMask(GL_TRUE);
         fbo_->release();
 
         // ---------------------------------------------------------------------
-        // 2. Approximate Blending
+        // 2. Resolve and Composite over the Opaque Pass
         // ---------------------------------------------------------------------
 
         static const std::string name = "transparency/average_color_blend";
@@ -161,17 +179,22 @@ namespace easy3d {
         if (!program)
             return;
 
-        glDisable(GL_BLEND);	easy3d_debug_log_gl_error;
-        glEnable(GL_DEPTH_TEST);
+        // the resolve shader outputs premultiplied alpha; blending it over the existing frame
+        // composites the transparent layers with the opaque image (pixels without transparent
+        // fragments are discarded in the shader, so the opaque pass shows through untouched)
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);	easy3d_debug_log_gl_error;
+        glDisable(GL_DEPTH_TEST);   // the fullscreen quad must not be clipped by the opaque depth
 
         program->bind();
-        program->set_uniform("BackgroundColor", bkg_color_);
         program->bind_texture("ColorTex0", fbo_->color_texture(0), 0);
         program->bind_texture("ColorTex1", fbo_->color_texture(1), 1);
         opengl::draw_full_screen_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0.0f);
         program->release_texture();
         program->release();
 
+        glDisable(GL_BLEND);	easy3d_debug_log_gl_error;
+        glEnable(GL_DEPTH_TEST);
+
         //////////////////////////////////////////////////////////////////////////
 
         // restore the default background color
@@ -36,9 +36,17 @@ namespace easy3d {
     class FramebufferObject;
 
     /**
-     * \brief Transparency effect using average color blending.
+     * \brief Transparency effect using weighted average color blending.
      *
-     * \details Optimization tip: rendering with multi-effects (e.g., shadowing, SSAO) can benefit from using a shared
+     * \details This is a single-geometry-pass approximation (in the spirit of the weighted
+     * blended order-independent transparency of McGuire and Bavoil, 2013): the transparent
+     * surfaces are submitted once, accumulating depth-weighted colors and per-pixel coverage
+     * statistics into two render targets, and a fullscreen pass resolves and composites the
+     * result over the opaque image. The depth buffer of the opaque pass is blitted in and
+     * shared, so occluded transparent fragments are rejected without re-rendering the opaque
+     * geometry.
+     *
+     * Optimization tip: rendering with multi-effects (e.g., shadowing, SSAO) can benefit from using a shared
      * geometry pass.
      *
      * \class AverageColorBlending easy3d/renderer/average_color_blending.h
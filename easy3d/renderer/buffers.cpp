@@ -26,6 +26,7 @@
 #include <easy3d/renderer/buffers.h>
 #include <easy3d/core/graph.h>
 #include <easy3d/core/point_cloud.h>
+#include <easy3d/core/point_cloud_quantization.h>
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/core/poly_mesh.h>
 #include <easy3d/renderer/renderer.h>
@@ -33,10 +34,16 @@
 #include <easy3d/renderer/drawable_lines.h>
 #include <easy3d/renderer/drawable_triangles.h>
 #include <easy3d/renderer/texture_manager.h>
+#include <easy3d/kdtree/point_cloud_neighborhood.h>
 #include <easy3d/algo/tessellator.h>
+#include <easy3d/util/tracing.h>
 
 #include <algorithm>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 namespace easy3d {
 
@@ -512,6 +519,44 @@ namespace easy3d {
             }
 
 
+            // Applies 'func(edge, slot)' to every edge of the graph, where 'slot' is the position
+            // of the edge in the drawable buffers (the running count of edges visited so far).
+            // Every edge owns its own slot, so when the graph has no garbage the loop runs in
+            // parallel without any synchronization. Deleted edges would make the slots
+            // non-contiguous, so graphs with garbage use the (serial) edge iterators instead.
+            template<typename Func>
+            void for_each_edge_slot(Graph *model, Func func) {
+                if (model->has_garbage()) {
+                    std::size_t slot = 0;
+                    for (auto e : model->edges())
+                        func(e, slot++);
+                } else {
+                    const int num = static_cast<int>(model->n_edges());
+#pragma omp parallel for
+                    for (int i = 0; i < num; ++i)
+                        func(Graph::Edge(i), static_cast<std::size_t>(i));
+                }
+            }
+
+
+            // The face counterpart of for_each_edge_slot(): applies 'func(face, slot)' to every
+            // face of the mesh, where 'slot' is the position of the face in the drawable buffers.
+            // Meshes with garbage fall back to the (serial) face iterators.
+            template<typename Func>
+            void for_each_face_slot(SurfaceMesh *model, Func func) {
+                if (model->has_garbage()) {
+                    std::size_t slot = 0;
+                    for (auto f : model->faces())
+                        func(f, slot++);
+                } else {
+                    const int num = static_cast<int>(model->n_faces());
+#pragma omp parallel for
+                    for (int i = 0; i < num; ++i)
+                        func(SurfaceMesh::Face(i), static_cast<std::size_t>(i));
+                }
+            }
+
+
             template<typename FT>
             void update(Graph *model, LinesDrawable *drawable, Graph::EdgeProperty<FT> prop) {
                 assert(model);
@@ -530,20 +575,15 @@ namespace easy3d {
                 details::clamp_scalar_field(prop.vector(), min_value, max_value, dummy_lower, dummy_upper);
 
                 auto points = model->get_vertex_property<vec3>("v:point");
-                std::vector<vec3> d_points;
-                d_points.reserve(model->n_edges() * 2);
-                std::vector<vec2> d_texcoords;
-                d_texcoords.reserve(model->n_edges() * 2);
-                for (auto e : model->edges()) {
-                    Graph::Vertex s = model->vertex(e, 0);
-                    Graph::Vertex t = model->vertex(e, 1);
-                    d_points.push_back(points[s]);
-                    d_points.push_back(points[t]);
-                    float coord_s = (prop[e] - min_value) / (max_value - min_value);
-                    d_texcoords.emplace_back(vec2(coord_s, 0.5f));
-                    float coord_t = (prop[e] - min_value) / (max_value - min_value);
-                    d_texcoords.emplace_back(vec2(coord_t, 0.5f));
-                }
+                std::vector<vec3> d_points(model->n_edges() * 2);
+                std::vector<vec2> d_texcoords(model->n_edges() * 2);
+                for_each_edge_slot(model, [&](Graph::Edge e, std::size_t i) {
+                    d_points[i * 2] = points[model->vertex(e, 0)];
+                    d_points[i * 2 + 1] = points[model->vertex(e, 1)];
+                    const float coord = (prop[e] - min_value) / (max_value - min_value);
+                    d_texcoords[i * 2] = vec2(coord, 0.5f);
+                    d_texcoords[i * 2 + 1] = vec2(coord, 0.5f);
+                });
                 drawable->update_vertex_buffer(d_points);
                 drawable->update_texcoord_buffer(d_texcoords);
                 drawable->release_element_buffer();
@@ -579,14 +619,11 @@ namespace easy3d {
                 }
                 drawable->update_texcoord_buffer(d_texcoords);
 
-                std::vector<unsigned int> indices;
-                indices.reserve(model->n_edges() * 2);
-                for (auto e : model->edges()) {
-                    Graph::Vertex s = model->vertex(e, 0);
-                    Graph::Vertex t = model->vertex(e, 1);
-                    indices.push_back(s.idx());
-                    indices.push_back(t.idx());
-                }
+                std::vector<unsigned int> indices(model->n_edges() * 2);
+                for_each_edge_slot(model, [&](Graph::Edge e, std::size_t i) {
+                    indices[i * 2] = model->vertex(e, 0).idx();
+                    indices[i * 2 + 1] = model->vertex(e, 1).idx();
+                });
                 drawable->update_element_buffer(indices);
                 drawable->set_impostor_type(LinesDrawable::CYLINDER);
             }
@@ -677,22 +714,22 @@ namespace easy3d {
                     model->update_vertex_normals();
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
-                    std::vector<unsigned int> d_indices;
-                    d_indices.reserve(model->n_faces() * 3);
-                    for (auto face : model->faces()) {
+                    // Each triangle owns the three index slots [i*3, i*3+2] and its own triangle
+                    // range entry, so the corner expansion runs in parallel on large meshes.
+                    auto triangle_range = model->face_property<std::pair<int, int> >("f:triangle_range");
+                    triangle_range.vector();    // detach once, so the parallel writes below cannot
+                                                // race on a shared (copy-on-write) array
+                    std::vector<unsigned int> d_indices(model->n_faces() * 3);
+                    for_each_face_slot(model, [&](SurfaceMesh::Face face, std::size_t i) {
+                        std::size_t s = i * 3;
                         for (auto h : model->halfedges(face))
-                            d_indices.push_back(model->target(h).idx());
-                    }
+                            d_indices[s++] = model->target(h).idx();
+                        const int idx = static_cast<int>(i);
+                        triangle_range[face] = std::make_pair(idx, idx);
+                    });
                     drawable->update_vertex_buffer(model->points());
                     drawable->update_element_buffer(d_indices);
                     drawable->update_normal_buffer(normals.vector());
-
-                    auto triangle_range = model->face_property<std::pair<int, int> >("f:triangle_range");
-                    int idx = 0;
-                    for (auto face : model->faces()) {
-                        triangle_range[face] = std::make_pair(idx, idx);
-                        ++idx;
-                    }
                 } else {
                     /**
                      * We use the Tessellator to eliminate duplicate vertices. This allows us to take advantage of element
@@ -722,6 +759,95 @@ namespace easy3d {
                     model->update_vertex_normals();
                     auto normals = model->get_vertex_property<vec3>("v:normal");
 
+#ifdef _OPENMP
+                    if (omp_get_max_threads() > 1) {
+                        // Tessellate the faces in parallel, one Tessellator per thread (a Tessellator
+                        // instance is not thread-safe). The static schedule assigns each thread one
+                        // contiguous block of faces in thread order, so concatenating the per-thread
+                        // buffers (with the vertex indices shifted) keeps the triangles in face order.
+                        // Duplicate vertices are then merged only within each block, which may send a
+                        // few more vertices to the GPU than the serial path, but the result renders
+                        // identically.
+                        const int num_threads = omp_get_max_threads();
+                        const int num_faces = static_cast<int>(model->faces_size());
+                        std::vector<std::size_t> num_triangles(num_faces, 0);
+                        std::vector< std::vector<vec3> > t_points(num_threads), t_normals(num_threads);
+                        std::vector< std::vector<int> > t_origins(num_threads);
+                        std::vector< std::vector< std::vector<unsigned int> > > t_indices(num_threads);
+#pragma omp parallel num_threads(num_threads)
+                        {
+                            const int t = omp_get_thread_num();
+                            Tessellator tess;
+                            tess.reserve(model->n_vertices() / num_threads + 1);
+#pragma omp for schedule(static)
+                            for (int fid = 0; fid < num_faces; ++fid) {
+                                SurfaceMesh::Face face(fid);
+                                if (model->is_deleted(face))
+                                    continue;
+                                tess.begin_polygon(model->compute_face_normal(face));
+                                tess.begin_contour();
+                                for (auto h : model->halfedges(face)) {
+                                    auto v = model->target(h);
+                                    Tessellator::Vertex vertex(points[v], v.idx());
+                                    vertex.append(normals[v]);
+                                    tess.add_vertex(vertex);
+                                }
+                                tess.end_contour();
+                                tess.end_polygon();
+                                num_triangles[fid] = tess.num_elements_in_polygon();
+                            }
+
+                            const std::vector<Tessellator::Vertex *> &vts = tess.vertices();
+                            t_points[t].reserve(vts.size());
+                            t_normals[t].reserve(vts.size());
+                            t_origins[t].reserve(vts.size());
+                            for (auto v : vts) {
+                                t_points[t].emplace_back(v->data());
+                                t_normals[t].emplace_back(v->data() + 3);
+                                t_origins[t].push_back(v->index);
+                            }
+                            t_indices[t] = tess.elements();
+                        }
+
+                        std::vector<vec3> d_points, d_normals;
+                        std::vector< std::vector<unsigned int> > d_indices;
+                        std::vector<unsigned int> d_origins;
+                        bool origins_valid = true;
+                        for (int t = 0; t < num_threads; ++t) {
+                            const unsigned int offset = static_cast<unsigned int>(d_points.size());
+                            d_points.insert(d_points.end(), t_points[t].begin(), t_points[t].end());
+                            d_normals.insert(d_normals.end(), t_normals[t].begin(), t_normals[t].end());
+                            for (auto id : t_origins[t]) {
+                                // vertices generated by the tessellation (intersections) have no origin
+                                origins_valid = origins_valid && id >= 0;
+                                d_origins.push_back(static_cast<unsigned int>(id));
+                            }
+                            for (auto &indices : t_indices[t]) {
+                                for (auto &id : indices)
+                                    id += offset;
+                                d_indices.push_back(indices);
+                            }
+                        }
+
+                        for (auto face : model->faces()) {
+                            std::size_t num = num_triangles[face.idx()];
+                            triangle_range[face] = std::make_pair(count_triangles, count_triangles + num - 1);
+                            count_triangles += num;
+                        }
+
+                        drawable->update_vertex_buffer(d_points);
+                        drawable->update_element_buffer(d_indices);
+                        drawable->update_normal_buffer(d_normals);
+                        // enables geometry-only refreshes without re-tessellating
+                        drawable->set_vertex_origins(origins_valid ? d_origins : std::vector<unsigned int>());
+
+                        DLOG(INFO) << "num of vertices in model/sent to GPU: " << model->n_vertices() << "/"
+                                   << d_points.size();
+                        return;
+                    }
+#endif
+
+                    tessellator.reserve(model->n_vertices());
                     for (auto face : model->faces()) {
                         tessellator.begin_polygon(model->compute_face_normal(face));
                         // tessellator.set_winding_rule(Tessellator::WINDING_NONZERO);  // or POSITIVE
@@ -742,13 +868,19 @@ namespace easy3d {
 
                     const std::vector<Tessellator::Vertex *> &vts = tessellator.vertices();
                     std::vector<vec3> d_points, d_normals;
+                    std::vector<unsigned int> d_origins;
+                    bool origins_valid = true;
                     d_points.reserve(vts.size());
                     d_normals.reserve(vts.size());
+                    d_origins.reserve(vts.size());
                     for (auto v :vts) {
                         std::size_t offset = 0;
                         d_points.emplace_back(v->data() + offset);
                         offset += 3;
                         d_normals.emplace_back(v->data() + offset);
+                        // vertices generated by the tessellation (intersections) have no origin
+                        origins_valid = origins_valid && v->index >= 0;
+                        d_origins.push_back(static_cast<unsigned int>(v->index));
                     }
 
                     const auto &d_indices = tessellator.elements();
@@ -756,6 +888,8 @@ namespace easy3d {
                     drawable->update_vertex_buffer(d_points);
                     drawable->update_element_buffer(d_indices);
                     drawable->update_normal_buffer(d_normals);
+                    // enables geometry-only refreshes without re-tessellating
+                    drawable->set_vertex_origins(origins_valid ? d_origins : std::vector<unsigned int>());
 
                     DLOG(INFO) << "num of vertices in model/sent to GPU: " << model->n_vertices() << "/"
                                << d_points.size();
@@ -1419,17 +1553,14 @@ namespace easy3d {
                 }
 
                 auto points = model->get_vertex_property<vec3>("v:point");
-                std::vector<vec3> d_points, d_colors;
-                d_points.reserve(model->n_edges() * 2);
-                d_colors.reserve(model->n_edges() * 2);
-                for (auto e : model->edges()) {
-                    Graph::Vertex s = model->vertex(e, 0);
-                    Graph::Vertex t = model->vertex(e, 1);
-                    d_points.push_back(points[s]);
-                    d_points.push_back(points[t]);
-                    d_colors.emplace_back(prop[e]);
-                    d_colors.emplace_back(prop[e]);
-                }
+                std::vector<vec3> d_points(model->n_edges() * 2);
+                std::vector<vec3> d_colors(model->n_edges() * 2);
+                for_each_edge_slot(model, [&](Graph::Edge e, std::size_t i) {
+                    d_points[i * 2] = points[model->vertex(e, 0)];
+                    d_points[i * 2 + 1] = points[model->vertex(e, 1)];
+                    d_colors[i * 2] = prop[e];
+                    d_colors[i * 2 + 1] = prop[e];
+                });
                 drawable->update_vertex_buffer(d_points);
                 drawable->update_color_buffer(d_colors);
                 drawable->release_element_buffer();
@@ -1451,14 +1582,11 @@ namespace easy3d {
 
                 drawable->update_texcoord_buffer(prop.vector());
 
-                std::vector<unsigned int> indices;
-                indices.reserve(model->n_edges() * 2);
-                for (auto e : model->edges()) {
-                    unsigned int s = model->vertex(e, 0).idx();
-                    unsigned int t = model->vertex(e, 1).idx();
-                    indices.push_back(s);
-                    indices.push_back(t);
-                }
+                std::vector<unsigned int> indices(model->n_edges() * 2);
+                for_each_edge_slot(model, [&](Graph::Edge e, std::size_t i) {
+                    indices[i * 2] = model->vertex(e, 0).idx();
+                    indices[i * 2 + 1] = model->vertex(e, 1).idx();
+                });
                 drawable->update_element_buffer(indices);
                 drawable->set_impostor_type(LinesDrawable::CYLINDER);
             }
@@ -1475,18 +1603,14 @@ namespace easy3d {
                 }
 
                 auto points = model->get_vertex_property<vec3>("v:point");
-                std::vector<vec3> d_points;
-                d_points.reserve(model->n_edges() * 2);
-                std::vector<vec2> d_texcoords;
-                d_texcoords.reserve(model->n_edges() * 2);
-                for (auto e : model->edges()) {
-                    Graph::Vertex s = model->vertex(e, 0);
-                    Graph::Vertex t = model->vertex(e, 1);
-                    d_points.push_back(points[s]);
-                    d_points.push_back(points[t]);
-                    d_texcoords.emplace_back(prop[e]);
-                    d_texcoords.emplace_back(prop[e]);
-                }
+                std::vector<vec3> d_points(model->n_edges() * 2);
+                std::vector<vec2> d_texcoords(model->n_edges() * 2);
+                for_each_edge_slot(model, [&](Graph::Edge e, std::size_t i) {
+                    d_points[i * 2] = points[model->vertex(e, 0)];
+                    d_points[i * 2 + 1] = points[model->vertex(e, 1)];
+                    d_texcoords[i * 2] = prop[e];
+                    d_texcoords[i * 2 + 1] = prop[e];
+                });
                 drawable->update_vertex_buffer(d_points);
                 drawable->update_texcoord_buffer(d_texcoords);
                 drawable->release_element_buffer();
@@ -1509,14 +1633,11 @@ namespace easy3d {
 
                 drawable->update_color_buffer(prop.vector());
 
-                std::vector<unsigned int> indices;
-                indices.reserve(model->n_edges() * 2);
-                for (auto e : model->edges()) {
-                    unsigned int s = model->vertex(e, 0).idx();
-                    unsigned int t = model->vertex(e, 1).idx();
-                    indices.push_back(s);
-                    indices.push_back(t);
-                }
+                std::vector<unsigned int> indices(model->n_edges() * 2);
+                for_each_edge_slot(model, [&](Graph::Edge e, std::size_t i) {
+                    indices[i * 2] = model->vertex(e, 0).idx();
+                    indices[i * 2 + 1] = model->vertex(e, 1).idx();
+                });
                 drawable->update_element_buffer(indices);
                 drawable->set_impostor_type(LinesDrawable::CYLINDER);
             }
@@ -1533,6 +1654,35 @@ namespace easy3d {
             assert(model);
             assert(drawable);
 
+            // a compressed cloud has no raw float attributes to hand to the drawable; decode
+            // them transiently for the GPU upload (the decoded copies are discarded right after)
+            if (PointCloudQuantization::is_compressed(model)) {
+                const PointCloudQuantization::View view(model);
+                const std::size_t num = view.size();
+
+                std::vector<vec3> points(num);
+#pragma omp parallel for
+                for (int i = 0; i < static_cast<int>(num); ++i)
+                    points[i] = view.position(i);
+                drawable->update_vertex_buffer(points);
+
+                if (view.has_normals()) {
+                    std::vector<vec3> normals(num);
+#pragma omp parallel for
+                    for (int i = 0; i < static_cast<int>(num); ++i)
+                        normals[i] = view.normal(i);
+                    drawable->update_normal_buffer(normals);
+                }
+                if (view.has_colors() && drawable->coloring_method() == State::COLOR_PROPERTY) {
+                    std::vector<vec3> colors(num);
+#pragma omp parallel for
+                    for (int i = 0; i < static_cast<int>(num); ++i)
+                        colors[i] = view.color(i);
+                    drawable->update_color_buffer(colors);
+                }
+                return;
+            }
+
             if (model->empty()) {
                 LOG(WARNING) << "model has no valid geometry";
                 return;
@@ -1609,6 +1759,48 @@ namespace easy3d {
         }
 
 
+        void update_splat_radii(PointCloud *model, PointsDrawable *drawable, int k) {
+            assert(model);
+            assert(drawable);
+
+            if (model->empty()) {
+                LOG(WARNING) << "model has no valid geometry";
+                return;
+            }
+
+            // the radii are cached in a vertex property, so switching back to the SPLAT imposter
+            // does not pay for the k-NN queries again
+            auto radius = model->get_vertex_property<float>("v:radius");
+            if (!radius) {
+                radius = model->add_vertex_property<float>("v:radius");
+
+                PointCloudNeighborhood nbhd;
+                nbhd.build_knn(model, k + 1);   // the point itself is part of its own neighborhood
+
+                const std::vector<vec3> &points = model->points();
+                std::vector<float> &radii = radius.vector();
+                const int num = static_cast<int>(points.size());
+#pragma omp parallel for
+                for (int i = 0; i < num; ++i) {
+                    // the average distance to the k nearest neighbors is the local sample
+                    // spacing, i.e., the gap a splat has to cover
+                    float sum = 0.0f;
+                    int count = 0;
+                    for (std::size_t t = 0; t < nbhd.size(i); ++t) {
+                        const int j = nbhd.neighbors(i)[t];
+                        if (j == i)
+                            continue;
+                        sum += distance(points[i], points[j]);
+                        ++count;
+                    }
+                    radii[i] = (count > 0) ? sum / count : 0.0f;
+                }
+            }
+
+            drawable->update_radius_buffer(radius.vector());
+        }
+
+
         void update(PointCloud *model, LinesDrawable *drawable, const std::string &field, float scale) {
             if (model->empty()) {
                 LOG(WARNING) << "model has no valid geometry";
@@ -2370,12 +2562,11 @@ namespace easy3d {
 
                 default: {// uniform color
                     // if reached here, we choose a uniform color.
-                    std::vector<unsigned int> indices;
-                    indices.reserve(model->n_edges() * 2);
-                    for (auto e : model->edges()) {
-                        indices.push_back(model->vertex(e, 0).idx());
-                        indices.push_back(model->vertex(e, 1).idx());
-                    }
+                    std::vector<unsigned int> indices(model->n_edges() * 2);
+                    details::for_each_edge_slot(model, [&](Graph::Edge e, std::size_t i) {
+                        indices[i * 2] = model->vertex(e, 0).idx();
+                        indices[i * 2 + 1] = model->vertex(e, 1).idx();
+                    });
                     auto points = model->get_vertex_property<vec3>("v:point");
                     drawable->update_vertex_buffer(points.vector());
                     drawable->update_element_buffer(indices);
@@ -2434,11 +2625,11 @@ namespace easy3d {
 
             if (model->is_tetraheral_mesh()) {
                 std::vector<unsigned int> d_indices;
-                for (auto f : model->faces()) {
-                    if (model->is_border(f) == border) {
-                        for (auto v : model->vertices(f))
-                            d_indices.push_back(v.idx());
-                    }
+                // the cached partition avoids scanning all faces on every update (the common
+                // case of time-varying data on a fixed topology only refreshes the buffers)
+                for (auto f : model->faces(border)) {
+                    for (auto v : model->vertices(f))
+                        d_indices.push_back(v.idx());
                 }
 
                 drawable->update_vertex_buffer(model->points());
@@ -2451,18 +2642,16 @@ namespace easy3d {
                  */
                 Tessellator tessellator;
 
-                for (auto f : model->faces()) {
-                    if (model->is_border(f) == border) {
-                        tessellator.begin_polygon(model->compute_face_normal(model->halfface(f, 0)));
-                        // tessellator.set_winding_rule(Tessellator::WINDING_NONZERO);  // or POSITIVE
-                        tessellator.begin_contour();
-                        for (auto v : model->vertices(f)) {
-                            Tessellator::Vertex vertex(model->position(v), v.idx());
-                            tessellator.add_vertex(vertex);
-                        }
-                        tessellator.end_contour();
-                        tessellator.end_polygon();
+                for (auto f : model->faces(border)) {
+                    tessellator.begin_polygon(model->compute_face_normal(model->halfface(f, 0)));
+                    // tessellator.set_winding_rule(Tessellator::WINDING_NONZERO);  // or POSITIVE
+                    tessellator.begin_contour();
+                    for (auto v : model->vertices(f)) {
+                        Tessellator::Vertex vertex(model->position(v), v.idx());
+                        tessellator.add_vertex(vertex);
                     }
+                    tessellator.end_contour();
+                    tessellator.end_polygon();
                 }
 
                 const std::vector<Tessellator::Vertex *> &vts = tessellator.vertices();
@@ -2486,6 +2675,7 @@ namespace easy3d {
 
 
         void update(Model *model, Drawable *drawable) {
+            EASY3D_TRACE_SCOPE("buffers::update");
             if (model->empty()) {
                 LOG(WARNING) << "model has no valid geometry";
                 return;
@@ -2546,6 +2736,81 @@ namespace easy3d {
                 }
             }
         }
+
+
+        bool update(Model *model, Drawable *drawable, std::size_t begin, std::size_t end) {
+            if (!model || !drawable || model->empty())
+                return false;
+
+            const std::vector<vec3> &points = model->points();
+            if (end <= begin || end > points.size())
+                return false;
+
+            // the partial update requires the vertex buffer to map 1:1 to the model's vertices; this rules out
+            // the buffers of tessellated polygonal meshes, texture-mapped drawables, vector fields, etc.
+            if (drawable->vertex_buffer() == 0 || drawable->num_vertices() != points.size())
+                return false;
+
+            if (!drawable->update_vertex_buffer(begin, end, points.data()))
+                return false;
+
+            if (drawable->normal_buffer() != 0) {
+                auto mesh = dynamic_cast<SurfaceMesh *>(model);
+                if (!mesh)
+                    return false;
+                auto normals = mesh->get_vertex_property<vec3>("v:normal");
+                if (!normals || !drawable->update_normal_buffer(begin, end, normals.vector().data()))
+                    return false;
+            }
+
+            return true;
+        }
+
+
+        bool update_geometry(Model *model, Drawable *drawable) {
+            if (!model || !drawable || model->empty())
+                return false;
+            if (drawable->vertex_buffer() == 0)     // the buffers have not been built yet
+                return false;
+
+            auto mesh = dynamic_cast<SurfaceMesh *>(model);
+            if (mesh && drawable->normal_buffer() != 0)
+                mesh->update_vertex_normals();      // a deformation changes the normals as well
+
+            const std::vector<vec3> &points = model->points();
+
+            // the buffers map 1:1 to the model's vertices: refresh them in place
+            if (drawable->num_vertices() == points.size())
+                return update(model, drawable, 0, points.size());
+
+            // tessellated drawables: re-scatter the positions (and normals) through the
+            // vertex-origin mapping cached when the buffers were built, keeping the index
+            // buffer and the tessellation
+            const std::vector<unsigned int> &origins = drawable->vertex_origins();
+            if (origins.size() != drawable->num_vertices())
+                return false;
+            if (drawable->normal_buffer() != 0 && !mesh)
+                return false;
+
+            std::vector<vec3> d_points(origins.size());
+            for (std::size_t i = 0; i < origins.size(); ++i) {
+                if (origins[i] >= points.size())
+                    return false;   // the mapping is stale (the model has changed shape)
+                d_points[i] = points[origins[i]];
+            }
+            drawable->update_vertex_buffer(d_points);
+
+            if (drawable->normal_buffer() != 0) {
+                auto normals = mesh->get_vertex_property<vec3>("v:normal");
+                if (!normals)
+                    return false;
+                std::vector<vec3> d_normals(origins.size());
+                for (std::size_t i = 0; i < origins.size(); ++i)
+                    d_normals[i] = normals[SurfaceMesh::Vertex(static_cast<int>(origins[i]))];
+                drawable->update_normal_buffer(d_normals);
+            }
+            return true;
+        }
     }
 
 }
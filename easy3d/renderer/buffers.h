@@ -54,6 +54,32 @@ namespace easy3d {
          * @param drawable  The drawable.
          */
         void update(Model* model, Drawable* drawable);
+
+        /**
+         * @brief Update only the vertex range [\p begin, \p end) of the render buffers of a drawable.
+         * @details The partial update re-uploads just the modified spans of the vertex buffer (and of the normal
+         *          buffer, from the "v:normal" property, if one exists), which makes small edits cheap on large
+         *          models. It requires that the drawable's buffers map 1:1 to the model's vertices, which holds
+         *          for the standard drawables of point clouds, graphs, and triangle meshes (but not, e.g., for
+         *          tessellated polygonal meshes or texture-mapped drawables).
+         * @return \c true on success. If \c false, the buffer layout does not permit a partial update (or the
+         *         buffers do not exist yet) and the caller should fall back to a full update().
+         * @attention The caller is responsible for refreshing derived data (e.g., vertex normals) beforehand.
+         */
+        bool update(Model* model, Drawable* drawable, std::size_t begin, std::size_t end);
+
+        /**
+         * @brief Update only the vertex geometry of the render buffers of a drawable.
+         * @details Re-uploads all vertex positions (recomputing the vertex normals first for surface meshes),
+         *          keeping the index buffer and the cached tessellation. This serves topology-neutral updates
+         *          (deformation, smoothing preview), where a full update() would needlessly re-tessellate and
+         *          rebuild the index buffers. It requires that the drawable's buffers map 1:1 to the model's
+         *          vertices, or that the drawable carries the vertex-origin mapping cached when its buffers were
+         *          built from a tessellation (see Drawable::vertex_origins()).
+         * @return \c true on success. If \c false, the buffer layout does not permit a geometry-only update (or
+         *         the buffers do not exist yet) and the caller should fall back to a full update().
+         */
+        bool update_geometry(Model* model, Drawable* drawable);
         //@}
 
         /// \name Render buffer update for PointCloud
@@ -76,6 +102,19 @@ namespace easy3d {
          * @param scale The length scale of the vectors w.r.t. (0.01 * radius) of the model's bounding sphere.
          */
         void update(PointCloud *model, LinesDrawable *drawable, const std::string& field, float scale);
+
+        /**
+         * @brief Update the per-point radius buffer of the SPLAT imposter of a point cloud drawable.
+         * @details The radius of a point is the average distance to its \p k nearest neighbors, i.e., the local
+         *          sample spacing: dense regions get small splats (little overdraw) and sparse regions get large
+         *          ones (no holes). The radii are computed once (in a parallel batch of kd-tree queries) and
+         *          cached in a vertex property "v:radius"; remove that property to force a recomputation.
+         * @param model     The model.
+         * @param drawable  The drawable.
+         * @param k The number of nearest neighbors the radius is derived from.
+         * @see PointsDrawable::update_radius_buffer().
+         */
+        void update_splat_radii(PointCloud *model, PointsDrawable *drawable, int k = 6);
         //@}
 
 
@@ -1505,6 +1505,40 @@ namespace easy3d {
 	}
 
 
+	/* Since all the plane normals point inside the frustum, a box is completely outside as soon as its
+	corner furthest along one plane's normal (the "positive vertex" of that plane) lies behind the plane. */
+	bool Camera::isVisible(const Box3 &box) const
+	{
+		if (!box.is_valid())
+			return true;
+
+		float frustum[6][4];
+		getFrustumPlanesCoefficients2(frustum);
+
+		for (int i = 0; i < 6; ++i) {
+			// the corner of the box furthest along the plane's normal
+			const float x = frustum[i][0] >= 0 ? box.max(0) : box.min(0);
+			const float y = frustum[i][1] >= 0 ? box.max(1) : box.min(1);
+			const float z = frustum[i][2] >= 0 ? box.max(2) : box.min(2);
+			if (frustum[i][0] * x + frustum[i][1] * y + frustum[i][2] * z + frustum[i][3] < 0)
+				return false;   // the whole box is behind this plane
+		}
+		return true;
+	}
+
+
+	void Camera::areVisible(const Box3 *boxes, std::size_t num, bool *results) const
+	{
+		float frustum[6][4];
+		getFrustumPlanesCoefficients2(frustum);
+
+		Plane3 planes[6];
+		for (int i = 0; i < 6; ++i)
+			planes[i] = Plane3(frustum[i][0], frustum[i][1], frustum[i][2], frustum[i][3]);
+		boxes_intersect_frustum(planes, 6, boxes, num, results);
+	}
+
+
     void Camera::trigger() {
 		projectionMatrixIsUpToDate_ = false;
 		modelViewMatrixIsUpToDate_ = false;
@@ -327,6 +327,23 @@ namespace easy3d {
 		void getFrustumPlanesCoefficients(float coef[6][4]) const;
 		void getFrustumPlanesCoefficients2(float coef[6][4]) const; // my version
 
+		/**
+		 * \brief Tests whether an axis-aligned box is (at least partially) inside the view frustum.
+		 * \details The box is tested against the six frustum planes, which makes the test conservative: a box
+		 * slightly outside a frustum corner may still be reported visible, but a visible box is never reported
+		 * invisible. This is the property needed for view-frustum culling. An invalid box is reported visible.
+		 */
+		bool isVisible(const Box3 &box) const;
+
+		/**
+		 * \brief Batch version of isVisible(): tests \p num boxes against the view frustum at once,
+		 * writing one flag per box into \p results.
+		 * \details The frustum planes are extracted once for the whole batch (isVisible() re-derives
+		 * them per call), so this is the interface to use when culling many boxes per frame (tiles,
+		 * BVH nodes, per-drawable bounds).
+		 */
+		void areVisible(const Box3 *boxes, std::size_t num, bool *results) const;
+
 	public:
 		void setType(Type type);
 
@@ -31,16 +31,33 @@
 #include <easy3d/renderer/opengl.h>
 #include <easy3d/renderer/drawable_lines.h>
 #include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/renderer.h>
 #include <easy3d/renderer/setting.h>
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/algo/surface_mesh_section.h>
 
 
 namespace easy3d {
 
 
+    // \cond
+    namespace details {
+
+        // the version of the section that has been uploaded to the model's cap drawable. Kept in
+        // a model property of a type unknown to the file io, so it is never serialized.
+        struct CapState {
+            CapState() : uploaded_version(0) {}
+            std::size_t uploaded_version;
+        };
+
+    }
+    // \endcond
+
+
     ClippingPlane::ClippingPlane()
             : manipulated_frame_(nullptr), enabled_(false), visible_(true),
               color_(setting::clipping_plane_color), cross_section_(false),
-              cross_section_width_(0.001f), scene_radius_(1.0f) {
+              cross_section_width_(0.001f), capping_(false), scene_radius_(1.0f) {
     }
 
 
@@ -96,6 +113,49 @@ namespace easy3d {
     }
 
 
+    void ClippingPlane::update_section_cap(Model *model) {
+        SurfaceMesh *mesh = dynamic_cast<SurfaceMesh *>(model);
+        const bool wanted = enabled_ && capping_ && !cross_section_ && mesh != nullptr;
+
+        auto renderer = model->renderer();
+        if (!renderer)
+            return;
+        auto cap = renderer->get_triangles_drawable("section_cap");
+        if (!wanted) {
+            if (cap)
+                cap->set_visible(false);
+            return;
+        }
+
+        SurfaceMeshSection section(mesh);
+        const std::vector<vec3> &triangles = section.cap_triangles(plane0());
+
+        auto state = mesh->model_property<details::CapState>("ClippingPlane:cap_state");
+        if (cap && state[0].uploaded_version == section.version()) {
+            cap->set_visible(!triangles.empty());
+            return; // neither the plane nor the mesh changed since the last upload
+        }
+
+        if (!cap)
+            cap = renderer->add_triangles_drawable("section_cap");
+
+        // the shader keeps the fragments on the opposite side of the normal (see set_program()),
+        // so nudge the cap slightly to that side to avoid it being clipped or z-fighting.
+        const vec3 &n = normal();
+        const vec3 offset = -n * (scene_radius_ * 1e-4f);
+        std::vector<vec3> points(triangles);
+        for (auto &p : points)
+            p += offset;
+        const std::vector<vec3> normals(points.size(), n);
+
+        cap->update_vertex_buffer(points);
+        cap->update_normal_buffer(normals);
+        cap->set_uniform_coloring(vec4(color_.x, color_.y, color_.z, 1.0f));
+        cap->set_visible(!points.empty());
+        state[0].uploaded_version = section.version();
+    }
+
+
     void ClippingPlane::set_program(ShaderProgram *program, bool plane_clipping_discard) {
         if (enabled_) {
             glEnable(GL_CLIP_DISTANCE0);
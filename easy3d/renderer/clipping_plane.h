@@ -32,6 +32,7 @@ namespace easy3d {
 
     class ManipulatedFrame;
     class Camera;
+    class Model;
     class ShaderProgram;
 
     /**
@@ -84,6 +85,21 @@ namespace easy3d {
         /// sets the thickness of the cross section.
         void set_cross_section_width(float w) { cross_section_width_ = w; }
 
+        /// returns whether the section is capped. \sa set_capping().
+        bool capping() const { return capping_; }
+        /// enables/disables capping of the section.
+        /// \details Clipping a closed surface leaves a hollow shell; with capping enabled, the
+        ///     section through every SurfaceMesh is closed by flat polygons on the plane (see
+        ///     SurfaceMeshSection), so solid parts still look solid. Capping applies to the
+        ///     single-plane mode, not to cross_section().
+        void set_capping(bool b) { capping_ = b; }
+
+        /// updates (and shows/hides) the cap drawable of \p model according to the current plane.
+        /// \details Called by the viewer for every model before its drawables are drawn. The cap
+        ///     is a TrianglesDrawable named "section_cap" managed in the model's renderer; its
+        ///     buffers are re-uploaded only when the plane or the mesh actually changed.
+        void update_section_cap(Model *model);
+
         /// setups the shader program for rendering.
         /// \param program The shader program.
         /// \param plane_clipping_discard Controls clipping plane behavior.
@@ -106,6 +122,7 @@ namespace easy3d {
         vec4 color_;
         bool cross_section_;
         float cross_section_width_;
+        bool capping_;
         float scene_radius_;
     };
 
@@ -24,7 +24,10 @@
 
 #include <easy3d/renderer/drawable.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 
 #include <easy3d/core/model.h>
 #include <easy3d/renderer/opengl.h>
@@ -33,6 +36,7 @@
 #include <easy3d/renderer/texture_manager.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/buffers.h>
+#include <easy3d/renderer/frame_statistics.h>
 #include <easy3d/renderer/setting.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/stop_watch.h>
@@ -40,11 +44,62 @@
 
 namespace easy3d {
 
+    // quantization of the vertex attributes for State::COMPACT_PRECISION (see state.h)
+    namespace details {
+
+        // IEEE 754 binary32 -> binary16, round to nearest
+        inline uint16_t float_to_half(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+            bits &= 0x7fffffffu;
+            if (bits >= 0x47800000u)    // magnitude too large for a half: infinity (NaN keeps a payload bit)
+                return sign | (bits > 0x7f800000u ? 0x7e00u : 0x7c00u);
+            if (bits < 0x38800000u) {   // too small for a normalized half: subnormal or zero
+                const uint32_t mantissa = (bits & 0x007fffffu) | 0x00800000u;
+                const int shift = 126 - static_cast<int>(bits >> 23);
+                if (shift > 24)
+                    return sign;
+                return sign | static_cast<uint16_t>((mantissa >> shift) + ((mantissa >> (shift - 1)) & 1u));
+            }
+            // normalized: re-bias the exponent; adding half of the discarded precision rounds to nearest
+            return sign | static_cast<uint16_t>((bits - 0x38000000u + 0x00001000u) >> 13);
+        }
+
+        // packs a unit (or near-unit) vector into GL_INT_2_10_10_10_REV (10 signed bits per component)
+        inline uint32_t pack_normal(const vec3 &n) {
+            uint32_t packed = 0;
+            for (int i = 0; i < 3; ++i) {
+                const float v = std::min(1.0f, std::max(-1.0f, n[i]));
+                const int q = static_cast<int>(v < 0.0f ? v * 511.0f - 0.5f : v * 511.0f + 0.5f);
+                packed |= (static_cast<uint32_t>(q) & 0x3ffu) << (10 * i);
+            }
+            return packed;
+        }
+
+        // packs a color into 8 bits per channel (RGBA; the alpha channel is opaque)
+        inline uint32_t pack_color(const vec3 &c) {
+            uint32_t packed = 0xffu << 24;
+            for (int i = 0; i < 3; ++i) {
+                const float v = std::min(1.0f, std::max(0.0f, c[i]));
+                packed |= static_cast<uint32_t>(v * 255.0f + 0.5f) << (8 * i);
+            }
+            return packed;
+        }
+
+    }
+
+
     Drawable::Drawable(const std::string &name, Model *model)
             : name_(name), model_(model), vao_(nullptr), num_vertices_(0), num_indices_(0),
-              update_needed_(false), update_func_(nullptr), vertex_buffer_(0), color_buffer_(0), normal_buffer_(0),
-              texcoord_buffer_(0), element_buffer_(0), storage_buffer_(0), current_storage_buffer_size_(0),
-              selection_buffer_(0), current_selection_buffer_size_(0) {
+              update_needed_(false), update_func_(nullptr), dirty_begin_(0), dirty_end_(0),
+              geometry_only_(false),
+              vertex_buffer_(0), color_buffer_(0), normal_buffer_(0),
+              texcoord_buffer_(0), element_buffer_(0), stream_buffer_capacity_(0), interleaved_(false),
+              storage_buffer_(0), current_storage_buffer_size_(0),
+              selection_buffer_(0), current_selection_buffer_size_(0),
+              instance_buffer_(0), num_instances_(0),
+              highlight_mask_buffer_(0), highlight_mask_texture_(0), highlight_mask_num_words_(0) {
         vao_ = new VertexArrayObject;
         material_ = Material(setting::material_ambient, setting::material_specular, setting::material_shininess);
     }
@@ -64,6 +119,30 @@ namespace easy3d {
     }
 
 
+    unsigned int Drawable::program_variant() const {
+        // bit 0: the textured code path; bit 1: the instanced program
+        unsigned int variant =
+                (texture() && (coloring_method() == State::SCALAR_FIELD ||
+                               coloring_method() == State::TEXTURED)) ? 1u : 0u;
+        if (num_instances() > 0)
+            variant |= 2u;
+        return variant;
+    }
+
+
+    std::size_t Drawable::sort_key() const {
+        // program first (type and variant), then texture, then the cheap uniform-like bits
+        std::size_t key = static_cast<std::size_t>(type());
+        key = (key << 6) | (program_variant() & 0x3fu);
+        key = (key << 24) | ((texture() ? texture()->id() : 0u) & 0xffffffu);
+        key = (key << 1) | (lighting() ? 1u : 0u);
+        key = (key << 1) | (lighting_two_sides() ? 1u : 0u);
+        key = (key << 1) | (distinct_back_color() ? 1u : 0u);
+        key = (key << 1) | (plane_clipping_discard() ? 1u : 0u);
+        return key;
+    }
+
+
     void Drawable::buffer_stats(std::ostream &output) const {
         if (vertex_buffer()) {
             std::cout << "\t" << name() << std::endl;
@@ -86,16 +165,52 @@ namespace easy3d {
             output << "\t\tindex buffer:      " << num_indices_ << " indices, "
                    << num_indices_ * sizeof(unsigned int) << " bytes" << std::endl;
         }
+        if (instance_buffer()) {
+            output << "\t\tinstance buffer:   " << num_instances_ << " transformations, "
+                   << num_instances_ * sizeof(mat4) << " bytes" << std::endl;
+        }
     }
 
 
     void Drawable::update() {
         bbox_.clear();
+        dirty_begin_ = 0;
+        dirty_end_ = static_cast<std::size_t>(-1); // request a full update
+        geometry_only_ = false;
+        update_needed_ = true;
+    }
+
+
+    void Drawable::update_geometry() {
+        bbox_.clear();
+        // a pending full rebuild covers (and must not be downgraded by) this request
+        if (update_needed_ && dirty_end_ == static_cast<std::size_t>(-1) && !geometry_only_)
+            return;
+        geometry_only_ = true;
+        update_needed_ = true;
+    }
+
+
+    void Drawable::mark_dirty(std::size_t begin, std::size_t end) {
+        if (end <= begin)
+            return;
+        if (dirty_end_ == static_cast<std::size_t>(-1)) // a full update is already pending
+            ;
+        else if (dirty_end_ > dirty_begin_) { // merge with the pending range
+            dirty_begin_ = std::min(dirty_begin_, begin);
+            dirty_end_ = std::max(dirty_end_, end);
+        } else {
+            dirty_begin_ = begin;
+            dirty_end_ = end;
+        }
         update_needed_ = true;
     }
 
 
     void Drawable::clear() {
+        vao_->release_stream_buffer(vertex_buffer_); // no-op unless the vertex buffer is streaming
+        stream_buffer_capacity_ = 0;
+
         VertexArrayObject::release_buffer(vertex_buffer_);
         VertexArrayObject::release_buffer(color_buffer_);
         VertexArrayObject::release_buffer(normal_buffer_);
@@ -103,13 +218,92 @@ namespace easy3d {
         VertexArrayObject::release_buffer(element_buffer_);
         VertexArrayObject::release_buffer(storage_buffer_);
         VertexArrayObject::release_buffer(selection_buffer_);
+        VertexArrayObject::release_buffer(instance_buffer_);
+        clear_highlight_mask();
 
         num_vertices_ = 0;
         num_indices_ = 0;
+        num_instances_ = 0;
         bbox_.clear();
     }
 
 
+    void Drawable::set_interleaved_mode(bool b) {
+        if (interleaved_ == b)
+            return;
+        interleaved_ = b;
+
+        // the existing buffers use the other layout, so rebuild from scratch
+        VertexArrayObject::release_buffer(vertex_buffer_);
+        VertexArrayObject::release_buffer(color_buffer_);
+        VertexArrayObject::release_buffer(normal_buffer_);
+        VertexArrayObject::release_buffer(texcoord_buffer_);
+        staged_points_.clear();
+        staged_colors_.clear();
+        staged_normals_.clear();
+        staged_texcoords_.clear();
+        update();
+    }
+
+
+    void Drawable::assemble_interleaved_buffer() {
+        if (!interleaved_ || staged_points_.empty())
+            return;
+
+        const std::size_t num = staged_points_.size();
+        const bool has_colors = (staged_colors_.size() == num);
+        const bool has_normals = (staged_normals_.size() == num);
+        const bool has_texcoords = (staged_texcoords_.size() == num);
+        LOG_IF(ERROR, !has_colors && !staged_colors_.empty()) << "color buffer ignored: size does not match number of vertices";
+        LOG_IF(ERROR, !has_normals && !staged_normals_.empty()) << "normal buffer ignored: size does not match number of vertices";
+        LOG_IF(ERROR, !has_texcoords && !staged_texcoords_.empty()) << "texcoord buffer ignored: size does not match number of vertices";
+
+        std::vector< std::pair<unsigned int, std::size_t> > attributes;
+        attributes.emplace_back(ShaderProgram::POSITION, 3);
+        if (has_normals)
+            attributes.emplace_back(ShaderProgram::NORMAL, 3);
+        if (has_colors)
+            attributes.emplace_back(ShaderProgram::COLOR, 3);
+        if (has_texcoords)
+            attributes.emplace_back(ShaderProgram::TEXCOORD, 2);
+
+        std::size_t stride = 0;
+        for (const auto &attr : attributes)
+            stride += attr.second;
+
+        std::vector<float> data;
+        data.reserve(num * stride);
+        for (std::size_t i = 0; i < num; ++i) {
+            const vec3 &p = staged_points_[i];
+            data.insert(data.end(), p.data(), p.data() + 3);
+            if (has_normals) {
+                const vec3 &n = staged_normals_[i];
+                data.insert(data.end(), n.data(), n.data() + 3);
+            }
+            if (has_colors) {
+                const vec3 &c = staged_colors_[i];
+                data.insert(data.end(), c.data(), c.data() + 3);
+            }
+            if (has_texcoords) {
+                const vec2 &t = staged_texcoords_[i];
+                data.insert(data.end(), t.data(), t.data() + 2);
+            }
+        }
+
+        bool success = vao_->create_interleaved_buffer(vertex_buffer_, attributes, data.data(),
+                                                       data.size() * sizeof(float));
+        LOG_IF(ERROR, !success) << "failed creating interleaved vertex buffer";
+        if (!success)
+            num_vertices_ = 0;
+
+        // the staged data has been uploaded; free the CPU-side copies
+        staged_points_.clear();   staged_points_.shrink_to_fit();
+        staged_colors_.clear();   staged_colors_.shrink_to_fit();
+        staged_normals_.clear();  staged_normals_.shrink_to_fit();
+        staged_texcoords_.clear();staged_texcoords_.shrink_to_fit();
+    }
+
+
     void Drawable::release_element_buffer() {
         VertexArrayObject::release_buffer(element_buffer_);
     }
@@ -167,12 +361,26 @@ namespace easy3d {
         }
 
         StopWatch w;
-        if (update_func_)
+        if (update_func_) {
+            vertex_origins_.clear();    // the custom function owns the buffer layout
             update_func_(model_, this);
+        }
+        else if (geometry_only_ && buffers::update_geometry(model_, this)) {
+            // positions (and normals) have been re-uploaded; the index buffer and the
+            // tessellation are kept
+        }
+        else if (dirty_end_ != static_cast<std::size_t>(-1) && dirty_end_ > dirty_begin_ &&
+                 buffers::update(model_, this, dirty_begin_, dirty_end_)) {
+            // only the marked vertex range has been re-uploaded
+        }
         else {
+            vertex_origins_.clear();    // rebuilt below (where the buffers come from a tessellation)
             buffers::update(model_, this);
         }
+        assemble_interleaved_buffer(); // no-op in the separate-buffers mode
         LOG_IF(INFO, w.elapsed_seconds() > 0.5) << "rendering buffers updated. " << w.time_string();
+        dirty_begin_ = dirty_end_ = 0;
+        geometry_only_ = false;
         update_needed_ = false;
     }
 
@@ -180,24 +388,68 @@ namespace easy3d {
     void Drawable::update_vertex_buffer(const std::vector<vec3> &vertices) {
         assert(vao_);
 
-        bool success = vao_->create_array_buffer(vertex_buffer_, ShaderProgram::POSITION, vertices.data(),
-                                                 vertices.size() * sizeof(vec3), 3);
-
-        LOG_IF(ERROR, !success) << "failed creating vertex buffer";
+        if (stream_buffer_capacity_ > 0) {
+            // the vertex buffer was a streaming one; unmap it before a regular buffer takes its place
+            vao_->release_stream_buffer(vertex_buffer_);
+            stream_buffer_capacity_ = 0;
+        }
 
-        if (!success)
-            num_vertices_ = 0;
+        if (interleaved_) {
+            staged_points_ = vertices;
+            num_vertices_ = vertices.size();
+        }
         else {
+            bool success = vao_->create_array_buffer(vertex_buffer_, ShaderProgram::POSITION, vertices.data(),
+                                                     vertices.size() * sizeof(vec3), 3);
+
+            LOG_IF(ERROR, !success) << "failed creating vertex buffer";
+
+            if (!success) {
+                num_vertices_ = 0;
+                return;
+            }
             num_vertices_ = vertices.size();
+        }
+
+        if (model())
+            bbox_ = model()->bounding_box();
+        else {
+            // update bounding box
+            bbox_.clear();
+            for (const auto &p : vertices)
+                bbox_.add_point(p);
+        }
+    }
+
+
+    void Drawable::stream_vertex_buffer(const std::vector<vec3> &vertices) {
+        assert(vao_);
 
-            if (model())
-                bbox_ = model()->bounding_box();
-            else {
-                // update bounding box
-                bbox_.clear();
-                for (const auto &p : vertices)
-                    bbox_.add_point(p);
+        const std::size_t size = vertices.size() * sizeof(vec3);
+        if (vertex_buffer_ == 0 || size > stream_buffer_capacity_) {
+            vao_->release_stream_buffer(vertex_buffer_);
+            if (!vao_->create_stream_buffer(vertex_buffer_, ShaderProgram::POSITION, size, 3)) {
+                // persistent mapping not available; plain re-upload
+                stream_buffer_capacity_ = 0;
+                update_vertex_buffer(vertices);
+                return;
             }
+            stream_buffer_capacity_ = size;
+        }
+
+        if (!vao_->update_stream_buffer(vertex_buffer_, ShaderProgram::POSITION, vertices.data(), size, 3)) {
+            num_vertices_ = 0;
+            return;
+        }
+        num_vertices_ = vertices.size();
+
+        if (model())
+            bbox_ = model()->bounding_box();
+        else {
+            // update bounding box
+            bbox_.clear();
+            for (const auto &p : vertices)
+                bbox_.add_point(p);
         }
     }
 
@@ -205,6 +457,21 @@ namespace easy3d {
     void Drawable::update_color_buffer(const std::vector<vec3> &colors) {
         assert(vao_);
 
+        if (interleaved_) {
+            staged_colors_ = colors;
+            return;
+        }
+
+        if (attribute_precision() == COMPACT_PRECISION) {
+            std::vector<uint32_t> packed(colors.size());
+            for (std::size_t i = 0; i < colors.size(); ++i)
+                packed[i] = details::pack_color(colors[i]);
+            bool success = vao_->create_array_buffer(color_buffer_, ShaderProgram::COLOR, packed.data(),
+                                                     packed.size() * sizeof(uint32_t), 4, GL_UNSIGNED_BYTE, true);
+            LOG_IF(ERROR, !success) << "failed updating color buffer";
+            return;
+        }
+
         bool success = vao_->create_array_buffer(color_buffer_, ShaderProgram::COLOR, colors.data(),
                                                  colors.size() * sizeof(vec3), 3);
         LOG_IF(ERROR, !success) << "failed updating color buffer";
@@ -213,6 +480,22 @@ namespace easy3d {
 
     void Drawable::update_normal_buffer(const std::vector<vec3> &normals) {
         assert(vao_);
+
+        if (interleaved_) {
+            staged_normals_ = normals;
+            return;
+        }
+
+        if (attribute_precision() == COMPACT_PRECISION) {
+            std::vector<uint32_t> packed(normals.size());
+            for (std::size_t i = 0; i < normals.size(); ++i)
+                packed[i] = details::pack_normal(normals[i]);
+            bool success = vao_->create_array_buffer(normal_buffer_, ShaderProgram::NORMAL, packed.data(),
+                                                     packed.size() * sizeof(uint32_t), 4, GL_INT_2_10_10_10_REV, true);
+            LOG_IF(ERROR, !success) << "failed updating normal buffer";
+            return;
+        }
+
         bool success = vao_->create_array_buffer(normal_buffer_, ShaderProgram::NORMAL, normals.data(),
                                                  normals.size() * sizeof(vec3), 3);
         LOG_IF(ERROR, !success) << "failed updating normal buffer";
@@ -222,12 +505,58 @@ namespace easy3d {
     void Drawable::update_texcoord_buffer(const std::vector<vec2> &texcoords) {
         assert(vao_);
 
+        if (interleaved_) {
+            staged_texcoords_ = texcoords;
+            return;
+        }
+
+        if (attribute_precision() == COMPACT_PRECISION) {
+            std::vector<uint16_t> packed(texcoords.size() * 2);
+            for (std::size_t i = 0; i < texcoords.size(); ++i) {
+                packed[i * 2] = details::float_to_half(texcoords[i].x);
+                packed[i * 2 + 1] = details::float_to_half(texcoords[i].y);
+            }
+            bool success = vao_->create_array_buffer(texcoord_buffer_, ShaderProgram::TEXCOORD, packed.data(),
+                                                     packed.size() * sizeof(uint16_t), 2, GL_HALF_FLOAT, false);
+            LOG_IF(ERROR, !success) << "failed updating texcoord buffer";
+            return;
+        }
+
         bool success = vao_->create_array_buffer(texcoord_buffer_, ShaderProgram::TEXCOORD, texcoords.data(),
                                                  texcoords.size() * sizeof(vec2), 2);
         LOG_IF(ERROR, !success) << "failed updating texcoord buffer";
     }
 
 
+    bool Drawable::update_vertex_buffer(std::size_t begin, std::size_t end, const vec3 *data) {
+        assert(vao_);
+
+        if (vertex_buffer_ == 0 || interleaved_ || stream_buffer_capacity_ > 0 ||
+            end <= begin || end > num_vertices_)
+            return false;
+
+        bool success = vao_->update_array_buffer(vertex_buffer_, GLintptr(begin * sizeof(vec3)),
+                                                 GLsizeiptr((end - begin) * sizeof(vec3)), data + begin);
+        LOG_IF(ERROR, !success) << "failed updating vertex buffer range";
+        if (success && model())
+            bbox_ = model()->bounding_box();
+        return success;
+    }
+
+
+    bool Drawable::update_normal_buffer(std::size_t begin, std::size_t end, const vec3 *data) {
+        assert(vao_);
+
+        if (normal_buffer_ == 0 || interleaved_ || end <= begin || end > num_vertices_)
+            return false;
+
+        bool success = vao_->update_array_buffer(normal_buffer_, GLintptr(begin * sizeof(vec3)),
+                                                 GLsizeiptr((end - begin) * sizeof(vec3)), data + begin);
+        LOG_IF(ERROR, !success) << "failed updating normal buffer range";
+        return success;
+    }
+
+
     void Drawable::update_element_buffer(const std::vector<unsigned int> &indices) {
         assert(vao_);
 
@@ -259,6 +588,36 @@ namespace easy3d {
     }
 
 
+    void Drawable::update_instance_buffer(const std::vector<mat4> &transforms) {
+        assert(vao_);
+
+        if (transforms.empty()) {
+            VertexArrayObject::release_buffer(instance_buffer_);
+            num_instances_ = 0;
+            return;
+        }
+
+        // dynamic: the instance transformations are expected to be updated incrementally
+        bool success = vao_->create_instance_buffer(instance_buffer_, ShaderProgram::ATTRIB_1, transforms.data(),
+                                                    transforms.size() * sizeof(mat4), true);
+        LOG_IF(ERROR, !success) << "failed updating instance buffer";
+        num_instances_ = success ? transforms.size() : 0;
+    }
+
+
+    bool Drawable::update_instance_buffer(std::size_t begin, std::size_t end, const mat4 *data) {
+        assert(vao_);
+
+        if (instance_buffer_ == 0 || end <= begin || end > num_instances_)
+            return false;
+
+        bool success = vao_->update_array_buffer(instance_buffer_, GLintptr(begin * sizeof(mat4)),
+                                                 GLsizeiptr((end - begin) * sizeof(mat4)), data + begin);
+        LOG_IF(ERROR, !success) << "failed updating instance buffer range";
+        return success;
+    }
+
+
     void Drawable::fetch_selection_buffer() {
         //    vao_->get_buffer_data(GL_SHADER_STORAGE_BUFFER, selection_buffer_, 0, selections_.size() * sizeof(uint32_t), selections_.data());
 
@@ -267,6 +626,55 @@ namespace easy3d {
     }
 
 
+    void Drawable::update_highlight_mask(const std::vector<int> &primitive_ids, std::size_t num_primitives) {
+        if (num_primitives == 0) {
+            clear_highlight_mask();
+            return;
+        }
+
+        // one bit per primitive, packed into 32-bit words (fetched with texelFetch in the shaders)
+        const std::size_t num_words = (num_primitives + 31) / 32;
+        std::vector<uint32_t> mask(num_words, 0);
+        for (std::size_t i = 0; i < primitive_ids.size(); ++i) {
+            const int id = primitive_ids[i];
+            if (id >= 0 && static_cast<std::size_t>(id) < num_primitives)
+                mask[id >> 5] |= (1u << (id & 31));
+        }
+
+        if (highlight_mask_buffer_ == 0)
+            glGenBuffers(1, &highlight_mask_buffer_);
+        glBindBuffer(GL_TEXTURE_BUFFER, highlight_mask_buffer_);    easy3d_debug_log_gl_error;
+        if (num_words != highlight_mask_num_words_) {
+            glBufferData(GL_TEXTURE_BUFFER, num_words * sizeof(uint32_t), mask.data(), GL_DYNAMIC_DRAW);
+            highlight_mask_num_words_ = num_words;
+        } else  // same mesh, different selection: re-upload in place (no reallocation)
+            glBufferSubData(GL_TEXTURE_BUFFER, 0, num_words * sizeof(uint32_t), mask.data());
+        easy3d_debug_log_gl_error;
+
+        if (highlight_mask_texture_ == 0) {
+            glGenTextures(1, &highlight_mask_texture_);
+            glBindTexture(GL_TEXTURE_BUFFER, highlight_mask_texture_);
+            glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, highlight_mask_buffer_);
+            glBindTexture(GL_TEXTURE_BUFFER, 0);
+            easy3d_debug_log_gl_error;
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+
+    void Drawable::clear_highlight_mask() {
+        if (highlight_mask_texture_ != 0) {
+            glDeleteTextures(1, &highlight_mask_texture_);
+            highlight_mask_texture_ = 0;
+        }
+        if (highlight_mask_buffer_ != 0) {
+            glDeleteBuffers(1, &highlight_mask_buffer_);
+            highlight_mask_buffer_ = 0;
+        }
+        highlight_mask_num_words_ = 0;
+    }
+
+
     void Drawable::gl_draw(bool with_storage_buffer /* = false */) const {
         if (update_needed_ || vertex_buffer_ == 0)
             const_cast<Drawable*>(this)->internal_update_buffers();
@@ -291,12 +699,21 @@ namespace easy3d {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer_);	easy3d_debug_log_gl_error;
 
             // index buffer must be bound if using glDrawElements()
-            glDrawElements(type(), GLsizei(num_indices_), GL_UNSIGNED_INT, nullptr);    easy3d_debug_log_gl_error;
+            if (num_instances_ > 0)
+                glDrawElementsInstanced(type(), GLsizei(num_indices_), GL_UNSIGNED_INT, nullptr,
+                                        GLsizei(num_instances_));
+            else
+                glDrawElements(type(), GLsizei(num_indices_), GL_UNSIGNED_INT, nullptr);
+            easy3d_debug_log_gl_error;
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);	easy3d_debug_log_gl_error;
-        } else
+        } else if (num_instances_ > 0)
+            glDrawArraysInstanced(type(), 0, GLsizei(num_vertices_), GLsizei(num_instances_));
+        else
             glDrawArrays(type(), 0, GLsizei(num_vertices_));
         easy3d_debug_log_gl_error;
 
+        FrameStatistics::count_draw_call(type(), element_buffer_ ? num_indices_ : num_vertices_, num_instances_);
+
         if (with_storage_buffer) {
             // Liangliang: I made stupid mistake here (confused by glBindBuffer() and glBindBufferBase())
             //glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
@@ -91,6 +91,28 @@ namespace easy3d {
         unsigned int element_buffer() const { return element_buffer_; }
         unsigned int storage_buffer() const { return storage_buffer_; }
         unsigned int selection_buffer() const { return selection_buffer_; }
+        unsigned int instance_buffer() const { return instance_buffer_; }
+
+        /// the number of vertices in the vertex buffer.
+        std::size_t num_vertices() const { return num_vertices_; }
+        /// the number of indices in the element buffer.
+        std::size_t num_indices() const { return num_indices_; }
+        /// the number of instances in the instance buffer (0 for an ordinary, non-instanced drawable).
+        std::size_t num_instances() const { return num_instances_; }
+
+        /**
+         * \brief Selects between the separate and the interleaved vertex buffer layouts.
+         * \details By default every vertex attribute (position, normal, color, texcoord) goes into its own buffer.
+         *        In the interleaved mode, all attributes of a vertex are stride-packed into a single buffer, which
+         *        keeps them adjacent in memory and improves the attribute fetch on GPUs with limited memory
+         *        bandwidth (e.g., integrated GPUs). The data passed to the update_xxx_buffer() functions is then
+         *        staged on the CPU and packed once by assemble_interleaved_buffer(), so the interleaving cost is
+         *        paid at update time, not per frame.
+         * \note Changing the mode releases the existing attribute buffers and triggers a buffer update.
+         */
+        void set_interleaved_mode(bool b);
+        /// whether the vertex attributes are interleaved in a single buffer. Default: false.
+        bool interleaved_mode() const { return interleaved_; }
 
         /**
          * \brief Creates/Updates a single buffer.
@@ -101,17 +123,58 @@ namespace easy3d {
          *    be duplicated in the vertex buffer.
          */
         void update_vertex_buffer(const std::vector<vec3> &vertices);
+
+        /**
+         * \brief Streams per-frame vertex positions through a persistently mapped ring buffer.
+         * \details Intended for geometry that changes every frame (e.g., a deformation preview): the update is a
+         *        plain memcpy into one of three sections of a persistently mapped buffer guarded by fences, which
+         *        avoids the full re-upload (and the driver stall) of update_vertex_buffer(). The ring is
+         *        (re)created whenever the data grows beyond its capacity. Falls back to update_vertex_buffer()
+         *        when GL_ARB_buffer_storage is not available.
+         */
+        void stream_vertex_buffer(const std::vector<vec3> &vertices);
+
         void update_color_buffer(const std::vector<vec3> &colors);
         void update_normal_buffer(const std::vector<vec3> &normals);
         void update_texcoord_buffer(const std::vector<vec2> &texcoords);
         void update_element_buffer(const std::vector<unsigned int> &elements);
 
+        /**
+         * \brief Updates only the sub-range [\p begin, \p end) of the existing vertex/normal buffer.
+         * \details The sub-range update requires that the buffer layout has not changed, i.e., \p data points to an
+         *        array with the same size and ordering as the one the buffer was created from. Fails (returning
+         *        \c false) when no buffer exists yet, or when the buffer is interleaved or streaming.
+         */
+        bool update_vertex_buffer(std::size_t begin, std::size_t end, const vec3 *data);
+        /// Updates only the sub-range [\p begin, \p end) of the existing normal buffer. \see update_vertex_buffer().
+        bool update_normal_buffer(std::size_t begin, std::size_t end, const vec3 *data);
+
         /**
          * \brief Updates the element buffer.
          * \note Each entry must have 2 (for LinesDrawable) or 3 elements (for TrianglesDrawable).
          */
         void update_element_buffer(const std::vector< std::vector<unsigned int> > &elements);
 
+        /**
+         * \brief Creates/Updates the per-instance transformation buffer, turning the drawable into an instanced one.
+         * \details An instanced drawable holds its geometry only once but is drawn \p transforms.size() times per
+         *        frame (glDrawElementsInstanced), each time transformed by the corresponding matrix. This renders
+         *        scenes containing many repetitions of the same mesh (e.g., thousands of identical valves in a
+         *        plant model) from a single copy of the vertex data with a single draw call, instead of one model
+         *        with full buffers per occurrence. Passing an empty vector reverts the drawable to ordinary,
+         *        non-instanced rendering.
+         * \note Instancing is supported for the plain color rendering of TrianglesDrawable; ModelPicker resolves
+         *        the picked instance. \see ModelPicker::pick().
+         */
+        void update_instance_buffer(const std::vector<mat4> &transforms);
+
+        /**
+         * \brief Updates only the sub-range [\p begin, \p end) of the existing instance transformation buffer.
+         * \details Much cheaper than a full re-upload when only a few instances have moved. Fails (returning
+         *        \c false) when no instance buffer exists or the range exceeds the number of instances.
+         */
+        bool update_instance_buffer(std::size_t begin, std::size_t end, const mat4 *data);
+
         /**
          * \brief Updates the selection buffer (internally based on a shader storage buffer)
          * \param index: the index of the binding point.
@@ -128,12 +191,44 @@ namespace easy3d {
          */
         void update_storage_buffer(const void *data, std::size_t datasize, unsigned int index = 0);
 
+        /**
+         * \brief Packs the staged vertex attributes into the single interleaved buffer.
+         * \details Only meaningful in the interleaved mode (no-op otherwise). It is called automatically after the
+         *        standard buffer update; clients that feed a drawable through the update_xxx_buffer() functions
+         *        directly must call it after the last attribute has been provided.
+         */
+        void assemble_interleaved_buffer();
+
         /// Releases the element buffer if existing vertex data is sufficient (may require duplicating vertex data).
         void release_element_buffer();
 
         /// Accesses data from the selection buffers
         void fetch_selection_buffer();
 
+        /**
+         * \brief Creates/updates the bit mask of highlighted primitives (rebuild-free highlighting).
+         * \details Stores one bit per primitive in a buffer texture that the fragment shaders index
+         *        by gl_PrimitiveID, so arbitrary (non-contiguous) selections can be highlighted.
+         *        Changing the selection re-uploads only this compact mask (num_primitives / 8
+         *        bytes); the vertex/color/element buffers are untouched, so the cost is independent
+         *        of the mesh size. Use set_highlight_range() instead when the highlighted
+         *        primitives form a single contiguous range.
+         * \param primitive_ids The indices of the primitives to be highlighted. Indices outside
+         *        [0, \p num_primitives) are ignored.
+         * \param num_primitives The total number of primitives of this drawable (triangles, lines,
+         *        or points, depending on the drawable type).
+         */
+        void update_highlight_mask(const std::vector<int> &primitive_ids, std::size_t num_primitives);
+
+        /// Removes the highlight mask and frees its GPU resources. \see update_highlight_mask().
+        void clear_highlight_mask();
+
+        /// whether a highlight mask exists. \see update_highlight_mask().
+        bool has_highlight_mask() const { return highlight_mask_texture_ != 0; }
+
+        /// the buffer texture holding the highlight mask. \see update_highlight_mask().
+        unsigned int highlight_mask_texture() const { return highlight_mask_texture_; }
+
         ///@}
 
         /// \name Rendering
@@ -142,10 +237,21 @@ namespace easy3d {
         /// The draw method.
         virtual void draw(const Camera *camera, bool with_storage_buffer) const = 0;
 
+        /**
+         * @brief A key that orders drawables by the GL state their draw() call binds.
+         * @details Drawables with equal keys use the same shader program and the same texture, so
+         *          drawing them consecutively avoids redundant program and texture binds. The key
+         *          orders first by program (drawable type and program variant), then by texture,
+         *          then by the remaining state bits. Viewer::draw_scene() sorts the visible
+         *          drawables of each frame by this key. Computing the key is O(1) (a few integer
+         *          shifts, no string handling), so it can be rebuilt every frame.
+         */
+        std::size_t sort_key() const;
+
         /// The internal draw method of this drawable.
         /// NOTE: this functions should be called when your shader program is in use,
         ///		 i.e., between glUseProgram(id) and glUseProgram(0);
-        void gl_draw(bool with_storage_buffer = false) const;
+        virtual void gl_draw(bool with_storage_buffer = false) const;
 
         /**
          * @brief Requests an update of the OpenGL buffers.
@@ -159,6 +265,36 @@ namespace easy3d {
          */
         void update();
 
+        /**
+         * @brief Requests a partial update of the OpenGL buffers.
+         * @details Marks the vertex range [\p begin, \p end) of the model as modified. At the rendering phase, only
+         *          the marked spans of the vertex/normal buffers are re-uploaded (ranges from several calls are
+         *          merged), provided the drawable's buffers map 1:1 to the model's vertices (e.g., the standard
+         *          drawables of point clouds, graphs, and triangle meshes); otherwise a full update is performed.
+         *          This makes small edits (e.g., dragging a handful of vertices) cheap on large models.
+         * @attention Use update() instead whenever the connectivity or the number of vertices has changed.
+         */
+        void mark_dirty(std::size_t begin, std::size_t end);
+
+        /**
+         * @brief Requests a geometry-only update of the OpenGL buffers.
+         * @details At the rendering phase, the vertex positions (and, for surface meshes, the recomputed vertex
+         *          normals) are re-uploaded while the index buffer and the cached tessellation are kept. This makes
+         *          per-iteration previews of deformations (e.g., SurfaceMeshSmoothing) much cheaper than update(),
+         *          which re-tessellates and rebuilds the index buffers from scratch. Drawables whose buffers cannot
+         *          be refreshed this way (see buffers::update_geometry()) fall back to a full update.
+         * @attention Use update() instead whenever the connectivity or the number of vertices has changed.
+         */
+        void update_geometry();
+
+        /**
+         * @brief The mapping from this drawable's vertices to the model's vertices, cached by buffers::update()
+         *        when the buffers were built from a tessellation. It enables geometry-only updates (see
+         *        update_geometry()) without re-tessellating; empty when the mapping is unknown.
+         */
+        const std::vector<unsigned int>& vertex_origins() const { return vertex_origins_; }
+        void set_vertex_origins(const std::vector<unsigned int>& origins) { vertex_origins_ = origins; }
+
         /**
          * @brief Setups how a drwable can update its OpenGL buffers. This function is required by only non-standard
          *        drawables for a special visualization purpose. Standard drawables can be automatically updated and
@@ -170,8 +306,15 @@ namespace easy3d {
         ///@}
 
     protected:
+        /// A small integer distinguishing the shader program variants draw() may use (e.g.,
+        /// textured vs. plain, instanced, impostor types). Folded into sort_key().
+        virtual unsigned int program_variant() const;
+
         VertexArrayObject *vao() const { return vao_; }
 
+        // manages an extra attribute buffer shared between time steps, so it needs the vao
+        friend class ScalarFieldPlayback;
+
         void internal_update_buffers();
 
         void clear();
@@ -190,17 +333,49 @@ namespace easy3d {
         bool update_needed_;
         std::function<void(Model*, Drawable*)> update_func_;
 
+        // the union of the vertex ranges marked by mark_dirty(). 'dirty_end_' == -1 requests a
+        // full update; 'dirty_end_' <= 'dirty_begin_' means nothing is marked.
+        std::size_t dirty_begin_;
+        std::size_t dirty_end_;
+
+        // a geometry-only update is pending (see update_geometry())
+        bool geometry_only_;
+        // see vertex_origins()
+        std::vector<unsigned int> vertex_origins_;
+
         unsigned int vertex_buffer_;
         unsigned int color_buffer_;
         unsigned int normal_buffer_;
         unsigned int texcoord_buffer_;
         unsigned int element_buffer_;
 
+        // interleaved layout: the attributes staged by the update_xxx_buffer() functions, consumed (and freed) by
+        // assemble_interleaved_buffer(). In this mode 'vertex_buffer_' holds the single stride-packed buffer.
+        // the section capacity (in bytes) of the streaming vertex buffer; 0 means the vertex
+        // buffer is a regular one (see stream_vertex_buffer()).
+        std::size_t stream_buffer_capacity_;
+
+        bool interleaved_;
+        std::vector<vec3> staged_points_;
+        std::vector<vec3> staged_colors_;
+        std::vector<vec3> staged_normals_;
+        std::vector<vec2> staged_texcoords_;
+
         unsigned int storage_buffer_;
         std::size_t current_storage_buffer_size_;
 
         unsigned int selection_buffer_;  // used for selection.
         std::size_t current_selection_buffer_size_; // in case the object is modified
+
+        // the per-instance transformations (see update_instance_buffer()).
+        unsigned int instance_buffer_;
+        std::size_t num_instances_;
+
+        // the bit mask of highlighted primitives, exposed to the fragment shaders as a buffer
+        // texture (see update_highlight_mask()).
+        unsigned int highlight_mask_buffer_;
+        unsigned int highlight_mask_texture_;
+        std::size_t  highlight_mask_num_words_;
     };
 
 }
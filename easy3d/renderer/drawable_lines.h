@@ -57,6 +57,11 @@ namespace easy3d {
         virtual void draw(const Camera* camera, bool with_storage_buffer = false) const override;
 
     protected:
+        // the impostor type selects a different shader program
+        unsigned int program_variant() const override {
+            return (static_cast<unsigned int>(impostor_type()) << 2) | Drawable::program_variant();
+        }
+
         // without texture
         void _draw_plain_lines(const Camera* camera, bool with_storage_buffer) const;
         void _draw_cylinders(const Camera* camera, bool with_storage_buffer) const;
@@ -31,13 +31,15 @@
 #include <easy3d/renderer/opengl.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/clipping_plane.h>
+#include <easy3d/renderer/vertex_array_object.h>
 #include <easy3d/util/logging.h>
 
 
 namespace easy3d {
 
     PointsDrawable::PointsDrawable(const std::string &name /*= ""*/, Model* model)
-            : Drawable(name, model), point_size_(2.0f), impostor_type_(PLAIN)
+            : Drawable(name, model), point_size_(2.0f), impostor_type_(PLAIN),
+              radius_buffer_(0), radius_scale_(1.0f), max_splat_size_(32.0f)
     {
         lighting_two_sides_ = setting::points_drawable_two_side_lighting;
         distinct_back_color_ = setting::points_drawable_distinct_backside_color;
@@ -46,6 +48,25 @@ namespace easy3d {
     }
 
 
+    PointsDrawable::~PointsDrawable() {
+        VertexArrayObject::release_buffer(radius_buffer_);
+    }
+
+
+    void PointsDrawable::update_radius_buffer(const std::vector<float> &radii) {
+        assert(vao());
+
+        if (radii.empty()) {
+            VertexArrayObject::release_buffer(radius_buffer_);
+            return;
+        }
+
+        bool success = vao()->create_array_buffer(radius_buffer_, ShaderProgram::ATTRIB_1, radii.data(),
+                                                  radii.size() * sizeof(float), 1);
+        LOG_IF(ERROR, !success) << "failed updating radius buffer";
+    }
+
+
     Drawable::Type PointsDrawable::type() const {
         return DT_POINTS;
     }
@@ -83,6 +104,10 @@ namespace easy3d {
                 else
                     _draw_surfels(camera, with_storage_buffer);
                 break;
+
+            case SPLAT:
+                _draw_splats(camera, with_storage_buffer);
+                break;
         }
     }
 
@@ -133,10 +158,17 @@ namespace easy3d {
                 ->set_uniform("hightlight_id_min",highlight_range().first)
                 ->set_uniform("hightlight_id_max",highlight_range().second);
 
+        // rebuild-free highlighting of arbitrary selections (see Drawable::update_highlight_mask())
+        program->set_uniform("use_highlight_mask", has_highlight_mask());
+        if (has_highlight_mask())
+            program->bind_texture("highlightMask", highlight_mask_texture(), 0, GL_TEXTURE_BUFFER);
+
         if (setting::clipping_plane)
             setting::clipping_plane->set_program(program, plane_clipping_discard());
 
         gl_draw(with_storage_buffer);
+        if (has_highlight_mask())
+            program->release_texture(GL_TEXTURE_BUFFER);
         program->release();
     }
 
@@ -240,6 +272,65 @@ namespace easy3d {
     }
 
 
+    void PointsDrawable::_draw_splats(const Camera *camera, bool with_storage_buffer) const {
+        if (vertex_buffer() == 0) {
+            LOG_FIRST_N(ERROR, 1) << "vertex buffer not created (this is the first record)";
+            return;
+        }
+        if (radius_buffer_ == 0) {
+            LOG_FIRST_N(ERROR, 1) << "radius buffer not created, drawing plain points instead "
+                                     "(this is the first record)";
+            _draw_plain_points(camera, with_storage_buffer);
+            return;
+        }
+
+        ShaderProgram *program = ShaderManager::get_program("points/points_splat_color");
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes;
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"));
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::COLOR, "vtx_color"));
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::NORMAL, "vtx_normal"));
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::ATTRIB_1, "vtx_radius"));
+            program = ShaderManager::create_program_from_files("points/points_splat_color", attributes);
+        }
+
+        if (!program)
+            return;
+
+        easy3d_debug_log_gl_error;
+        glEnable(GL_VERTEX_PROGRAM_POINT_SIZE); // starting from GL3.2, using GL_PROGRAM_POINT_SIZE
+
+        program->bind();
+        program->set_uniform("MV", camera->modelViewMatrix())
+                ->set_uniform("PROJ", camera->projectionMatrix())
+                ->set_uniform("screen_width", camera->screenWidth());
+
+        program->set_uniform("radius_scale", radius_scale_)
+                ->set_uniform("max_screen_size", max_splat_size_)
+                ->set_uniform("per_vertex_color",coloring_method() != State::UNIFORM_COLOR && color_buffer())
+                ->set_uniform("default_color",color())
+                ->set_uniform("eLightPos", setting::light_position)
+                ->set_uniform("lighting", normal_buffer() && lighting())
+                ->set_uniform("two_sides_lighting",lighting_two_sides());
+
+        program->set_block_uniform("Material", "ambient",material().ambient)
+                ->set_block_uniform("Material", "specular",material().specular)
+                ->set_block_uniform("Material", "shininess", &material().shininess);
+
+        program->set_uniform("highlight",highlight())
+                ->set_uniform("hightlight_id_min",highlight_range().first)
+                ->set_uniform("hightlight_id_max",highlight_range().second);
+
+        if (setting::clipping_plane)
+            setting::clipping_plane->set_program(program, plane_clipping_discard());
+
+        gl_draw(with_storage_buffer);
+        program->release();
+
+        glDisable(GL_VERTEX_PROGRAM_POINT_SIZE); // starting from GL3.2, using GL_PROGRAM_POINT_SIZE
+    }
+
+
     void PointsDrawable::_draw_plain_points_with_texture(const Camera *camera, bool with_storage_buffer) const {
         if (vertex_buffer() == 0) {
             LOG_FIRST_N(ERROR, 1) << "vertex buffer not created (this is the first record)";
@@ -40,14 +40,16 @@ namespace easy3d {
 	class PointsDrawable : public Drawable {
 	public:
         PointsDrawable(const std::string& name = "", Model* model = nullptr);
+        ~PointsDrawable() override;
 
         Type type() const override;
 
-        // a point imposter can be a sphere, or a surfel/disc
+        // a point imposter can be a sphere, a surfel/disc, or a density-adaptive splat
         enum ImposterType {
             PLAIN,
             SPHERE,
-            SURFEL
+            SURFEL,
+            SPLAT
         };
 
         /** Get/Set impostor type. */
@@ -58,15 +60,41 @@ namespace easy3d {
         float point_size() const { return point_size_; }
         void set_point_size(float s) { point_size_ = s; }
 
+        /**
+         * \brief Creates/Updates the per-point radius buffer used by the SPLAT imposter.
+         * \details With a global point size, dense regions of a scan overdraw massively while sparse regions show
+         *        holes. The SPLAT imposter instead gives every point its own world-space radius (typically derived
+         *        from the distance to its nearest neighbors, see buffers::update_splat_radii()), so each splat just
+         *        covers the local gap between samples. The screen-space extent of a splat is additionally bounded
+         *        by max_splat_size(), which caps the overdraw of close-up or very dense regions.
+         *        Passing an empty vector releases the buffer.
+         */
+        void update_radius_buffer(const std::vector<float> &radii);
+        unsigned int radius_buffer() const { return radius_buffer_; }
+
+        /** Get/Set the global scale applied to the per-point radii of the SPLAT imposter. Default: 1.0. */
+        float radius_scale() const { return radius_scale_; }
+        void set_radius_scale(float s) { radius_scale_ = s; }
+
+        /** Get/Set the screen-space bound of a splat, in pixels. Default: 32. */
+        float max_splat_size() const { return max_splat_size_; }
+        void set_max_splat_size(float s) { max_splat_size_ = s; }
+
         // Rendering.
         virtual void draw(const Camera* camera, bool with_storage_buffer = false) const override;
 
     protected:
+        // the impostor type selects a different shader program
+        unsigned int program_variant() const override {
+            return (static_cast<unsigned int>(impostor_type()) << 2) | Drawable::program_variant();
+        }
+
         // without texture
         void _draw_plain_points(const Camera* camera, bool with_storage_buffer) const;
         void _draw_spheres_sprite(const Camera* camera, bool with_storage_buffer) const;
         void _draw_spheres_geometry(const Camera* camera, bool with_storage_buffer) const;
         void _draw_surfels(const Camera* camera, bool with_storage_buffer) const;
+        void _draw_splats(const Camera* camera, bool with_storage_buffer) const;
 
         // textured
         void _draw_plain_points_with_texture(const Camera* camera, bool with_storage_buffer) const;
@@ -77,6 +105,11 @@ namespace easy3d {
 	private:
         float           point_size_;
         ImposterType    impostor_type_;
+
+        // the per-point radii of the SPLAT imposter (see update_radius_buffer())
+        unsigned int    radius_buffer_;
+        float           radius_scale_;
+        float           max_splat_size_;
 	};
 
 }
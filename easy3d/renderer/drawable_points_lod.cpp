@@ -0,0 +1,345 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/drawable_points_lod.h>
+
+#include <algorithm>
+#include <queue>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/vertex_array_object.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace details {
+
+        // the subsample of a node is one point per cell of a GRID_DIM^3 occupancy grid, so the node's
+        // point spacing is its cell size (and halves with each level, as the node extent does).
+        static const int GRID_DIM = 32;
+
+        // nodes with no more points than this keep all of them and become leaves
+        static const std::size_t BUCKET_SIZE = 4096;
+
+
+        struct OctreeNode {
+            OctreeNode(const vec3 &c, float e) : center(c), extent(e) {
+                for (int k = 0; k < 8; ++k)
+                    children[k] = nullptr;
+            }
+
+            ~OctreeNode() {
+                for (int k = 0; k < 8; ++k)
+                    delete children[k];
+            }
+
+            vec3 center;
+            float extent;
+            std::vector<unsigned int> samples;
+            OctreeNode *children[8];
+        };
+
+
+        // moves one point per occupied grid cell into the node's subsample and routes the remaining
+        // points to the octant they fall in; 'indices' is consumed.
+        static void sample_node(const std::vector<vec3> &points, std::vector<unsigned int> &indices,
+                                OctreeNode *node, std::vector<unsigned int> rest[8]) {
+            const float cell_size = 2.0f * node->extent / GRID_DIM;
+            const vec3 origin = node->center - vec3(node->extent, node->extent, node->extent);
+            std::vector<char> occupied(GRID_DIM * GRID_DIM * GRID_DIM, 0);
+
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                const unsigned int idx = indices[i];
+                const vec3 &p = points[idx];
+                const int x = std::min(std::max(static_cast<int>((p.x - origin.x) / cell_size), 0), GRID_DIM - 1);
+                const int y = std::min(std::max(static_cast<int>((p.y - origin.y) / cell_size), 0), GRID_DIM - 1);
+                const int z = std::min(std::max(static_cast<int>((p.z - origin.z) / cell_size), 0), GRID_DIM - 1);
+                const int cell = (x * GRID_DIM + y) * GRID_DIM + z;
+                if (!occupied[cell]) {
+                    occupied[cell] = 1;
+                    node->samples.push_back(idx);
+                } else {
+                    const int octant = (p.x >= node->center.x ? 1 : 0)
+                                       | (p.y >= node->center.y ? 2 : 0)
+                                       | (p.z >= node->center.z ? 4 : 0);
+                    rest[octant].push_back(idx);
+                }
+            }
+
+            indices.clear();
+            indices.shrink_to_fit();
+        }
+
+
+        static vec3 child_center(const vec3 &center, float child_extent, int octant) {
+            return vec3(center.x + (octant & 1 ? child_extent : -child_extent),
+                        center.y + (octant & 2 ? child_extent : -child_extent),
+                        center.z + (octant & 4 ? child_extent : -child_extent));
+        }
+
+
+        static OctreeNode *build_subtree(const std::vector<vec3> &points, std::vector<unsigned int> &indices,
+                                         const vec3 &center, float extent) {
+            OctreeNode *node = new OctreeNode(center, extent);
+            if (indices.size() <= BUCKET_SIZE) {
+                node->samples.swap(indices);
+                return node;
+            }
+
+            std::vector<unsigned int> rest[8];
+            sample_node(points, indices, node, rest);
+
+            for (int k = 0; k < 8; ++k) {
+                if (!rest[k].empty())
+                    node->children[k] = build_subtree(points, rest[k], child_center(center, extent * 0.5f, k),
+                                                      extent * 0.5f);
+            }
+            return node;
+        }
+
+    }
+
+
+    LodPointsDrawable::LodPointsDrawable(const std::string &name, Model *model)
+            : PointsDrawable(name, model), point_budget_(4000000), refinement_threshold_(2.0f),
+              num_points_selected_(0) {
+    }
+
+
+    void LodPointsDrawable::build(const PointCloud *cloud) {
+        nodes_.clear();
+        first_.clear();
+        count_.clear();
+        num_points_selected_ = 0;
+
+        if (!cloud || cloud->n_vertices() == 0) {
+            LOG(ERROR) << "no point cloud to build the octree from";
+            return;
+        }
+
+        const std::vector<vec3> &points = cloud->points();
+
+        // the root is the cube enclosing the cloud
+        const Box3 &box = cloud->bounding_box();
+        const vec3 center = box.center();
+        float extent = 0.0f;
+        for (int i = 0; i < 3; ++i)
+            extent = std::max(extent, box.range(i) * 0.5f);
+        extent *= 1.001f;   // so points on the boundary fall strictly inside
+
+        std::vector<unsigned int> indices(points.size());
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            indices[i] = static_cast<unsigned int>(i);
+
+        details::OctreeNode *root = new details::OctreeNode(center, extent);
+        if (indices.size() <= details::BUCKET_SIZE)
+            root->samples.swap(indices);
+        else {
+            std::vector<unsigned int> rest[8];
+            details::sample_node(points, indices, root, rest);
+
+            // the eight subtrees are independent, so they can be built concurrently
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (int k = 0; k < 8; ++k) {
+                if (!rest[k].empty())
+                    root->children[k] = details::build_subtree(points, rest[k],
+                                                               details::child_center(center, extent * 0.5f, k),
+                                                               extent * 0.5f);
+            }
+        }
+
+        // flatten the octree depth-first, so the points of any subtree form one contiguous range
+        struct StackItem {
+            details::OctreeNode *node;
+            int parent;
+            int slot;
+        };
+        std::vector<unsigned int> order;
+        order.reserve(points.size());
+        std::vector<StackItem> stack;
+        stack.push_back({root, -1, 0});
+        while (!stack.empty()) {
+            const StackItem item = stack.back();
+            stack.pop_back();
+
+            Node node;
+            node.center = item.node->center;
+            node.extent = item.node->extent;
+            node.spacing = 2.0f * item.node->extent / details::GRID_DIM;
+            node.offset = order.size();
+            node.count = item.node->samples.size();
+            for (int k = 0; k < 8; ++k)
+                node.children[k] = -1;
+            order.insert(order.end(), item.node->samples.begin(), item.node->samples.end());
+
+            const int index = static_cast<int>(nodes_.size());
+            nodes_.push_back(node);
+            if (item.parent >= 0)
+                nodes_[item.parent].children[item.slot] = index;
+
+            for (int k = 7; k >= 0; --k) {
+                if (item.node->children[k])
+                    stack.push_back({item.node->children[k], index, k});
+            }
+        }
+        delete root;
+
+        // upload the points (and the attributes the cloud has) in the octree order
+        std::vector<vec3> reordered(order.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            reordered[i] = points[order[i]];
+        update_vertex_buffer(reordered);
+
+        auto colors = cloud->get_vertex_property<vec3>("v:color");
+        if (colors) {
+            for (std::size_t i = 0; i < order.size(); ++i)
+                reordered[i] = colors[PointCloud::Vertex(static_cast<int>(order[i]))];
+            update_color_buffer(reordered);
+        }
+        auto normals = cloud->get_vertex_property<vec3>("v:normal");
+        if (normals) {
+            for (std::size_t i = 0; i < order.size(); ++i)
+                reordered[i] = normals[PointCloud::Vertex(static_cast<int>(order[i]))];
+            update_normal_buffer(reordered);
+        }
+
+        LOG(INFO) << "octree built: " << nodes_.size() << " nodes over " << points.size() << " points";
+    }
+
+
+    void LodPointsDrawable::refine(const Camera *camera) const {
+        first_.clear();
+        count_.clear();
+        num_points_selected_ = 0;
+        if (nodes_.empty())
+            return;
+
+        auto visible = [camera](const Node &node) -> bool {
+            Box3 box;
+            box.add_point(node.center - vec3(node.extent, node.extent, node.extent));
+            box.add_point(node.center + vec3(node.extent, node.extent, node.extent));
+            return camera->isVisible(box);
+        };
+        auto projected_size = [camera](const Node &node) -> float {
+            return node.extent / camera->pixelGLRatio(node.center);
+        };
+
+        // visit the nodes biggest on screen first, so the point budget is spent where it matters most
+        typedef std::pair<float, int> Entry;
+        std::priority_queue<Entry> queue;
+        if (visible(nodes_[0]))
+            queue.push(Entry(projected_size(nodes_[0]), 0));
+
+        std::size_t budget = point_budget_;
+        std::vector< std::pair<std::size_t, std::size_t> > ranges;
+        while (!queue.empty()) {
+            const int index = queue.top().second;
+            queue.pop();
+            const Node &node = nodes_[index];
+
+            if (node.count > budget) {
+                // out of budget: take what still fits from this node, and stop refining
+                if (budget > 0) {
+                    ranges.push_back(std::make_pair(node.offset, budget));
+                    budget = 0;
+                }
+                continue;
+            }
+            budget -= node.count;
+            if (node.count > 0)
+                ranges.push_back(std::make_pair(node.offset, node.count));
+
+            // descend only while the node's point spacing is still too coarse on screen
+            if (node.spacing > refinement_threshold_ * camera->pixelGLRatio(node.center)) {
+                for (int k = 0; k < 8; ++k) {
+                    const int child = node.children[k];
+                    if (child >= 0 && visible(nodes_[child]))
+                        queue.push(Entry(projected_size(nodes_[child]), child));
+                }
+            }
+        }
+
+        // merge adjacent ranges (frequent, because the flattening is depth-first)
+        std::sort(ranges.begin(), ranges.end());
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            if (!first_.empty() &&
+                static_cast<std::size_t>(first_.back()) + static_cast<std::size_t>(count_.back()) == ranges[i].first)
+                count_.back() += static_cast<int>(ranges[i].second);
+            else {
+                first_.push_back(static_cast<int>(ranges[i].first));
+                count_.push_back(static_cast<int>(ranges[i].second));
+            }
+            num_points_selected_ += ranges[i].second;
+        }
+    }
+
+
+    void LodPointsDrawable::draw(const Camera *camera, bool with_storage_buffer) const {
+        if (!nodes_.empty())
+            refine(camera);
+        PointsDrawable::draw(camera, with_storage_buffer);
+    }
+
+
+    void LodPointsDrawable::gl_draw(bool with_storage_buffer) const {
+        if (nodes_.empty()) {
+            // no octree (yet): behave like a plain points drawable
+            Drawable::gl_draw(with_storage_buffer);
+            return;
+        }
+        if (first_.empty())
+            return;     // nothing visible this frame
+
+        vao()->bind();
+
+        if (with_storage_buffer) {
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, selection_buffer_);
+            easy3d_debug_log_gl_error;
+            glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+            easy3d_debug_log_gl_error;
+        }
+
+        glMultiDrawArrays(GL_POINTS, first_.data(), count_.data(), static_cast<GLsizei>(first_.size()));
+        easy3d_debug_log_gl_error;
+
+        if (with_storage_buffer) {
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+            easy3d_debug_log_gl_error;
+        }
+
+        vao()->release();
+        easy3d_debug_log_gl_error;
+    }
+
+}
@@ -0,0 +1,119 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_DRAWABLE_POINTS_LOD_H
+#define EASY3D_RENDERER_DRAWABLE_POINTS_LOD_H
+
+#include <easy3d/renderer/drawable_points.h>
+
+
+namespace easy3d {
+
+    class PointCloud;
+
+    /**
+     * \brief A points drawable with a built-in octree LOD, for point clouds too large to draw in full.
+     * \class LodPointsDrawable easy3d/renderer/drawable_points_lod.h
+     * \details build() organizes the cloud into a nested octree: every node stores a subsample of its
+     * points at a spacing that halves with each level, and the remaining points sink into the children,
+     * so the union of the nodes visited along any root-to-leaf path reconstructs the full cloud. The
+     * reordered points live in a single GPU buffer (one contiguous range per node), uploaded once.
+     * Every frame, the octree is refined front-to-back by projected size: nodes outside the view
+     * frustum are skipped, a node's children are visited only while the node's point spacing is still
+     * coarser on screen than the refinement threshold, and traversal stops at the per-frame point
+     * budget. The selected ranges are then drawn with a single multi-draw call, so rendering cost is
+     * bounded by the budget instead of the cloud size.
+     *
+     * Rendering state (impostors, point size, coloring) is inherited from PointsDrawable unchanged.
+     * \see PointsDrawable
+     */
+
+    class LodPointsDrawable : public PointsDrawable {
+    public:
+        LodPointsDrawable(const std::string &name = "", Model *model = nullptr);
+
+        /**
+         * \brief Builds the octree over the cloud and uploads the reordered points (and, when present,
+         *        the per-vertex colors and normals) to the GPU. The subtrees below the root are built
+         *        in parallel.
+         * \note Must be called (again) when the point positions change.
+         */
+        void build(const PointCloud *cloud);
+
+        /// The number of octree nodes (0 before build() is called).
+        std::size_t num_nodes() const { return nodes_.size(); }
+
+        /**
+         * \brief The maximum number of points drawn per frame. Default: 4 million.
+         * \details When the budget is exhausted, the remaining (smallest on screen) nodes are dropped
+         *        for that frame.
+         */
+        void set_point_budget(std::size_t budget) { point_budget_ = budget; }
+        std::size_t point_budget() const { return point_budget_; }
+
+        /**
+         * \brief The screen-space point spacing (in pixels) below which a node is no longer refined.
+         *        Smaller values show more detail at a higher cost. Default: 2.
+         */
+        void set_refinement_threshold(float pixels) { refinement_threshold_ = pixels; }
+        float refinement_threshold() const { return refinement_threshold_; }
+
+        /// The number of points selected for the last frame.
+        std::size_t num_points_selected() const { return num_points_selected_; }
+
+        void draw(const Camera *camera, bool with_storage_buffer = false) const override;
+
+        /// Draws the node ranges selected for the current frame with a single multi-draw call.
+        void gl_draw(bool with_storage_buffer = false) const override;
+
+    private:
+        // one octree node; its subsample occupies [offset, offset + count) of the reordered points
+        struct Node {
+            vec3 center;
+            float extent;       // half of the node's edge length
+            float spacing;      // the spacing of the subsample kept in this node
+            std::size_t offset;
+            std::size_t count;
+            int children[8];    // indices into nodes_; -1 if absent
+        };
+
+        // selects the node ranges to draw for the given viewpoint (the refinement pass)
+        void refine(const Camera *camera) const;
+
+    private:
+        std::vector<Node> nodes_;   // nodes_[0] is the root
+
+        std::size_t point_budget_;
+        float refinement_threshold_;
+
+        // the ranges selected by refine(), merged and sorted by offset
+        mutable std::vector<int> first_;
+        mutable std::vector<int> count_;
+        mutable std::size_t num_points_selected_;
+    };
+
+}
+
+
+#endif  // EASY3D_RENDERER_DRAWABLE_POINTS_LOD_H
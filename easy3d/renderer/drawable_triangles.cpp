@@ -23,6 +23,7 @@
  */
 
 #include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/opengl.h>
 #include <easy3d/renderer/camera.h>
 #include <easy3d/renderer/shader_program.h>
 #include <easy3d/renderer/shader_manager.h>
@@ -68,31 +69,38 @@ namespace easy3d {
             return;
         }
 
-        ShaderProgram *program = ShaderManager::get_program("surface/surface_color");
+        // an instanced drawable additionally fetches the per-instance transformation (see
+        // Drawable::update_instance_buffer()), so it needs its own shader program
+        const std::string shader_name =
+                num_instances() > 0 ? "surface/surface_color_instanced" : "surface/surface_color";
+        ShaderProgram *program = ShaderManager::get_program(shader_name);
         if (!program) {
             std::vector<ShaderProgram::Attribute> attributes;
             attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"));
             attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::COLOR, "vtx_color"));
             attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::NORMAL, "vtx_normal"));
-            program = ShaderManager::create_program_from_files("surface/surface_color", attributes);
+            if (num_instances() > 0)
+                attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::ATTRIB_1, "vtx_instance_matrix"));
+            program = ShaderManager::create_program_from_files(shader_name, attributes);
         }
 
         if (!program)
             return;
 
-        const mat4 &MVP = camera->modelViewProjectionMatrix();
+        // the per-frame constants live in the shared "FrameBlock" uniform block; re-submitting
+        // unchanged data is skipped, so only the first drawable of a frame pays the upload
+        ShaderProgram::FrameBlock frame_block;
+        frame_block.MVP = camera->modelViewProjectionMatrix();
         // camera position is defined in world coordinate system.
-        const vec3 &wCamPos = camera->position();
+        frame_block.wCamPos = camera->position();
         // it can also be computed as follows:
         //const vec3& wCamPos = invMV * vec4(0, 0, 0, 1);
         const mat4 &MV = camera->modelViewMatrix();
-        const vec4 &wLightPos = inverse(MV) * setting::light_position;
+        frame_block.wLightPos = vec3(inverse(MV) * setting::light_position);
 
         program->bind();
-        program->set_uniform("MVP", MVP)
-                ->set_uniform("lighting",lighting())
-                ->set_uniform("wLightPos", wLightPos)
-                ->set_uniform("wCamPos", wCamPos)
+        ShaderProgram::upload_block("FrameBlock", &frame_block, sizeof(frame_block));
+        program->set_uniform("lighting",lighting())
                 ->set_uniform("two_sides_lighting",lighting_two_sides())
                 ->set_uniform("distinct_back_color",distinct_back_color())
                 ->set_uniform("backside_color",back_color())
@@ -107,6 +115,14 @@ namespace easy3d {
                 ->set_uniform("hightlight_id_min",highlight_range().first)
                 ->set_uniform("hightlight_id_max",highlight_range().second);
 
+        // rebuild-free highlighting of arbitrary selections (see Drawable::update_highlight_mask())
+        program->set_uniform("use_highlight_mask", has_highlight_mask());
+        if (has_highlight_mask())
+            program->bind_texture("highlightMask", highlight_mask_texture(), 1, GL_TEXTURE_BUFFER);
+
+        if (num_instances() > 0)    // may linger from a picking pass (see ModelPicker)
+            program->set_uniform("picking", false);
+
         if (setting::clipping_plane)
             setting::clipping_plane->set_program(program, plane_clipping_discard());
 
@@ -115,6 +131,8 @@ namespace easy3d {
         gl_draw(with_storage_buffer);
         if (is_ssao_enabled())
             program->release_texture();
+        if (has_highlight_mask())
+            program->release_texture(GL_TEXTURE_BUFFER);
 
         program->release();
     }
@@ -142,19 +160,20 @@ namespace easy3d {
         if (!program)
             return;
 
-        const mat4 &MVP = camera->modelViewProjectionMatrix();
+        // the per-frame constants live in the shared "FrameBlock" uniform block; re-submitting
+        // unchanged data is skipped, so only the first drawable of a frame pays the upload
+        ShaderProgram::FrameBlock frame_block;
+        frame_block.MVP = camera->modelViewProjectionMatrix();
         // camera position is defined in world coordinate system.
-        const vec3 &wCamPos = camera->position();
+        frame_block.wCamPos = camera->position();
         // it can also be computed as follows:
         //const vec3& wCamPos = invMV * vec4(0, 0, 0, 1);
         const mat4 &MV = camera->modelViewMatrix();
-        const vec4 &wLightPos = inverse(MV) * setting::light_position;
+        frame_block.wLightPos = vec3(inverse(MV) * setting::light_position);
 
         program->bind();
-        program->set_uniform("MVP", MVP)
-                ->set_uniform("lighting",lighting())
-                ->set_uniform("wLightPos", wLightPos)
-                ->set_uniform("wCamPos", wCamPos)
+        ShaderProgram::upload_block("FrameBlock", &frame_block, sizeof(frame_block));
+        program->set_uniform("lighting",lighting())
                 ->set_uniform("two_sides_lighting",lighting_two_sides())
                 ->set_uniform("distinct_back_color",distinct_back_color())
                 ->set_uniform("backside_color",back_color())
@@ -23,6 +23,9 @@
  */
 
 #include <easy3d/renderer/eye_dome_lighting.h>
+
+#include <algorithm>
+
 #include <easy3d/renderer/shader_manager.h>
 #include <easy3d/renderer/shader_program.h>
 #include <easy3d/renderer/framebuffer_object.h>
@@ -43,6 +46,7 @@ namespace easy3d {
         , compose_program_(nullptr)
         , blur_program_(nullptr)
         , low_res_factor_(2)
+        , resolution_scale_(1.0f)
         , z_near_(0.1f)
         , z_far_(1.0f)
         , width_(0)
@@ -66,9 +70,22 @@ namespace easy3d {
     }
 
 
+    void EyeDomeLighting::set_resolution_scale(float s)
+    {
+        resolution_scale_ = std::min(1.0f, std::max(0.25f, s));
+    }
+
+
+    unsigned int EyeDomeLighting::depth_texture() const
+    {
+        return projection_fbo_ ? projection_fbo_->depth_texture() : 0;
+    }
+
+
     void EyeDomeLighting::init_frame_buffers(int w, int h)
     {
         //  PROJECTION FBO and TEXTURES
+        // the projection pass captures the actual scene rendering, so it always runs in full resolution
         if (!projection_fbo_) {
             projection_fbo_ = new FramebufferObject(w, h, 0);
             projection_fbo_->add_color_texture();	// color render target for projection pass
@@ -76,20 +93,24 @@ namespace easy3d {
         }
         projection_fbo_->ensure_size(w, h);
 
+        // the shading buffers are scaled down when a reduced resolution is requested
+        const int sw = std::max(1, static_cast<int>(static_cast<float>(w) * resolution_scale_));
+        const int sh = std::max(1, static_cast<int>(static_cast<float>(h) * resolution_scale_));
+
         //  EDL-RES1 FBO and TEXTURE
         if (!high_fbo_) {
-            high_fbo_ = new FramebufferObject(w, h, 0);
+            high_fbo_ = new FramebufferObject(sw, sh, 0);
             high_fbo_->add_color_texture(GL_RGBA32F, GL_RGBA, GL_FLOAT);	// color render target for EDL full res pass
         }
-        high_fbo_->ensure_size(w, h);
+        high_fbo_->ensure_size(sw, sh);
 
         //  EDL-RES2 FBO and TEXTURE
         if (!low_fbo_) {
-            low_fbo_ = new FramebufferObject(w / low_res_factor_, h / low_res_factor_, 0);
+            low_fbo_ = new FramebufferObject(sw / low_res_factor_, sh / low_res_factor_, 0);
             low_fbo_->add_color_texture(GL_RGBA32F, GL_RGBA, GL_FLOAT);	// color render target for EDL low res pass
             low_fbo_->add_color_texture(GL_RGBA32F, GL_RGBA, GL_FLOAT);	// color render target for EDL low res bilateral filter pass
         }
-        low_fbo_->ensure_size(w / low_res_factor_, h / low_res_factor_);
+        low_fbo_->ensure_size(std::max(1, sw / low_res_factor_), std::max(1, sh / low_res_factor_));
     }
 
 
@@ -136,10 +157,12 @@ namespace easy3d {
             return;
 
         //  VARIABLES
+        const int sw = std::max(1, static_cast<int>(static_cast<float>(width_) * resolution_scale_));
+        const int sh = std::max(1, static_cast<int>(static_cast<float>(height_) * resolution_scale_));
         float d = 1.0f;
         float F_scale = 5.0f;
-        float SX = 1.0f / float(width_);
-        float SY = 1.0f / float(height_);
+        float SX = 1.0f / float(sw);
+        float SY = 1.0f / float(sh);
         float L[3] = { 0.0f, 0.0f, -1.0f };
 
         high_fbo_->bind();
@@ -163,7 +186,10 @@ namespace easy3d {
         float diag = scene_radius * 2.0f;
         shade_program_->set_uniform("SceneSize", diag);
 
-        opengl::draw_full_screen_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0.0f);
+        if (resolution_scale_ < 1.0f)
+            opengl::draw_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0, 0, sw, sh, width_, height_, 0.0f);
+        else
+            opengl::draw_full_screen_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0.0f);
 
         shade_program_->release_texture();
         shade_program_->release();
@@ -178,10 +204,14 @@ namespace easy3d {
             return;
 
         //  VARIABLES
+        const int sw = std::max(1, static_cast<int>(static_cast<float>(width_) * resolution_scale_));
+        const int sh = std::max(1, static_cast<int>(static_cast<float>(height_) * resolution_scale_));
+        const int lw = std::max(1, sw / low_res_factor_);
+        const int lh = std::max(1, sh / low_res_factor_);
         float d = 2.0f;
         float F_scale = 5.0f;
-        float SX = 1.0f / float(width_ / low_res_factor_);
-        float SY = 1.0f / float(height_ / low_res_factor_);
+        float SX = 1.0f / float(lw);
+        float SY = 1.0f / float(lh);
         float L[3] = { 0.0f, 0.0f, -1.0f };
 
         low_fbo_->bind();
@@ -201,7 +231,7 @@ namespace easy3d {
         shade_program_->set_uniform("Znear", z_near_);
         shade_program_->set_uniform("Zfar", z_far_);
 
-        opengl::draw_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0, 0, width_ / low_res_factor_, height_ / low_res_factor_, width_, height_, 0.0f);
+        opengl::draw_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0, 0, lw, lh, width_, height_, 0.0f);
 
         shade_program_->release_texture();
         shade_program_->release();
@@ -216,8 +246,10 @@ namespace easy3d {
             return;
 
         // shader parameters
-        float SX = 1.0f / float(width_ / low_res_factor_);
-        float SY = 1.0f / float(height_ / low_res_factor_);
+        const int lw = std::max(1, static_cast<int>(static_cast<float>(width_) * resolution_scale_) / low_res_factor_);
+        const int lh = std::max(1, static_cast<int>(static_cast<float>(height_) * resolution_scale_) / low_res_factor_);
+        float SX = 1.0f / float(lw);
+        float SY = 1.0f / float(lh);
         int EDL_Bilateral_N = 5;
         float EDL_Bilateral_Sigma = 2.5f;
 
@@ -235,7 +267,7 @@ namespace easy3d {
         blur_program_->set_uniform("N", EDL_Bilateral_N);
         blur_program_->set_uniform("sigma", EDL_Bilateral_Sigma);
 
-        opengl::draw_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0, 0, width_ / low_res_factor_, height_ / low_res_factor_, width_, height_, 0.0f);
+        opengl::draw_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0, 0, lw, lh, width_, height_, 0.0f);
 
         blur_program_->release_texture();
         blur_program_->release();
@@ -258,6 +290,12 @@ namespace easy3d {
         //  initial color texture
         compose_program_->bind_texture("s2_C", projection_fbo_->color_texture(), 0);
 
+        //  with reduced resolution shading, the full resolution depth drives the depth-aware upsampling
+        compose_program_->bind_texture("s2_D", projection_fbo_->depth_texture(), 3);
+        compose_program_->set_uniform("scaled", resolution_scale_ < 1.0f);
+        compose_program_->set_uniform("Znear", z_near_);
+        compose_program_->set_uniform("Zfar", z_far_);
+
         //-----------------------------------------------------------------------------
         // IMPORTANT since we enable depth writing hereafter
         glDisable(GL_BLEND);
@@ -0,0 +1,277 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/fragment_linked_lists.h>
+
+#include <vector>
+
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/opengl_info.h>
+#include <easy3d/renderer/shader_manager.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/renderer/primitives.h>
+#include <easy3d/renderer/setting.h>
+#include <easy3d/renderer/clipping_plane.h>
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    // the std430 layout of a fragment node in the shaders: vec4 color + float depth +
+    // uint next + 2 floats of padding
+    static const int NODE_SIZE = 32;
+
+
+    FragmentLinkedLists::FragmentLinkedLists(Camera* cam)
+        : camera_(cam)
+        , width_(0)
+        , height_(0)
+        , avg_layers_(8)
+        , head_texture_(0)
+        , nodes_buffer_(0)
+        , counter_buffer_(0)
+        , clear_buffer_(0)
+        , max_nodes_(0)
+    {
+    }
+
+
+    FragmentLinkedLists::~FragmentLinkedLists()
+    {
+        clear();
+    }
+
+
+    bool FragmentLinkedLists::is_supported() {
+        return OpenglInfo::is_supported("GL_ARB_shader_storage_buffer_object") &&
+               OpenglInfo::is_supported("GL_ARB_shader_atomic_counters") &&
+               OpenglInfo::is_supported("GL_ARB_shader_image_load_store");
+    }
+
+
+    void FragmentLinkedLists::clear()
+    {
+        if (glIsTexture(head_texture_)) {
+            glDeleteTextures(1, &head_texture_);
+            head_texture_ = 0;
+        }
+        if (nodes_buffer_ != 0) {
+            glDeleteBuffers(1, &nodes_buffer_);
+            nodes_buffer_ = 0;
+        }
+        if (counter_buffer_ != 0) {
+            glDeleteBuffers(1, &counter_buffer_);
+            counter_buffer_ = 0;
+        }
+        if (clear_buffer_ != 0) {
+            glDeleteBuffers(1, &clear_buffer_);
+            clear_buffer_ = 0;
+        }
+        max_nodes_ = 0;
+
+        easy3d_debug_log_gl_error;
+    }
+
+
+    void FragmentLinkedLists::init(int w, int h)
+    {
+        if (head_texture_ == 0) {
+            glGenTextures(1, &head_texture_);
+            glBindTexture(GL_TEXTURE_2D, head_texture_);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        if (nodes_buffer_ == 0)
+            glGenBuffers(1, &nodes_buffer_);
+        if (counter_buffer_ == 0) {
+            glGenBuffers(1, &counter_buffer_);
+            glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, counter_buffer_);
+            glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(unsigned int), nullptr, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+        }
+        if (clear_buffer_ == 0)
+            glGenBuffers(1, &clear_buffer_);
+
+        if (w != width_ || h != height_) {
+            glBindTexture(GL_TEXTURE_2D, head_texture_);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, w, h, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+            glBindTexture(GL_TEXTURE_2D, 0);
+
+            // the end-of-list marker for every pixel
+            const std::vector<unsigned int> heads(static_cast<std::size_t>(w) * h, 0xFFFFFFFFu);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, clear_buffer_);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, heads.size() * sizeof(unsigned int), heads.data(), GL_STATIC_DRAW);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            width_ = w;
+            height_ = h;
+        }
+
+        const unsigned int num_nodes = static_cast<unsigned int>(w) * h * avg_layers_;
+        if (num_nodes != max_nodes_) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, nodes_buffer_);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<std::size_t>(num_nodes) * NODE_SIZE, nullptr, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+            max_nodes_ = num_nodes;
+        }
+
+        // store the background color that will be restored later
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, bkg_color_);
+
+        easy3d_debug_log_gl_error;
+    }
+
+
+    void FragmentLinkedLists::geometry_pass(const std::vector<TrianglesDrawable*>& surfaces) {
+        static const std::string name = "transparency/fragment_lists_init";
+        ShaderProgram* program = ShaderManager::get_program(name);
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes = {
+                ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"),
+                ShaderProgram::Attribute(ShaderProgram::NORMAL, "vtx_normal")
+            };
+            program = ShaderManager::create_program_from_files(name, attributes);
+        }
+        if (!program)
+            return;
+
+        const mat4& MVP = camera_->modelViewProjectionMatrix();
+        // camera position is defined in world coordinate system.
+        const vec3& wCamPos = camera_->position();
+        const mat4& MV = camera_->modelViewMatrix();
+        const vec4& wLightPos = inverse(MV) * setting::light_position;
+
+        program->bind();
+        program->set_uniform("MVP", MVP);
+        program->set_uniform("wLightPos", wLightPos);
+        program->set_uniform("wCamPos", wCamPos);
+        program->set_uniform("MaxNodes", max_nodes_);
+
+        for (auto d : surfaces) {
+            if (d->is_visible()) {
+                program->set_uniform("smooth_shading", d->smooth_shading());
+                program->set_block_uniform("Material", "ambient", d->material().ambient);
+                program->set_block_uniform("Material", "specular", d->material().specular);
+                program->set_block_uniform("Material", "shininess", &d->material().shininess);
+                program->set_uniform("Alpha", d->opacity());
+                program->set_uniform("per_vertex_color", d->coloring_method() != State::UNIFORM_COLOR && d->color_buffer());
+                program->set_uniform("default_color", d->color());
+                if (setting::clipping_plane)
+                    setting::clipping_plane->set_program(program, d->plane_clipping_discard());
+                d->gl_draw(false);
+            }
+        }
+
+        program->release();
+    }
+
+
+    void FragmentLinkedLists::resolve_pass() {
+        static const std::string name = "transparency/fragment_lists_blend";
+        ShaderProgram* program = ShaderManager::get_program(name);
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes = {
+                ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"),
+                ShaderProgram::Attribute(ShaderProgram::TEXCOORD, "vtx_texcoord")
+            };
+            program = ShaderManager::create_program_from_files(name, attributes);
+        }
+        if (!program)
+            return;
+
+        program->bind();
+        program->set_uniform("BackgroundColor", bkg_color_);
+        opengl::draw_full_screen_quad(ShaderProgram::POSITION, ShaderProgram::TEXCOORD, 0.0f);
+        program->release();
+    }
+
+
+    void FragmentLinkedLists::draw(const std::vector<TrianglesDrawable*>& surfaces)
+    {
+        if (surfaces.empty())
+            return;
+
+        if (!is_supported()) {
+            LOG_FIRST_N(ERROR, 1) << "fragment linked lists require OpenGL 4.3; use DualDepthPeeling"
+                                     " or AverageColorBlending instead (this is the first record)";
+            return;
+        }
+
+        int viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        const int w = viewport[2];
+        const int h = viewport[3];
+        init(w, h);
+
+        // ---------------------------------------------------------------------
+        // 1. Reset the list heads and the node allocator
+        // ---------------------------------------------------------------------
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, clear_buffer_);
+        glBindTexture(GL_TEXTURE_2D, head_texture_);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        const unsigned int zero = 0;
+        glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, counter_buffer_);
+        glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(unsigned int), &zero);
+        glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+        glBindImageTexture(0, head_texture_, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32UI);
+        glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 0, counter_buffer_);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, nodes_buffer_);
+        easy3d_debug_log_gl_error;
+
+        // ---------------------------------------------------------------------
+        // 2. Build the per-pixel lists in a single geometry pass
+        // ---------------------------------------------------------------------
+        // fragments behind the opaque geometry are still rejected by the depth test, but
+        // the transparent fragments must neither write depth nor color here
+        glDepthMask(GL_FALSE);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        geometry_pass(surfaces);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_ATOMIC_COUNTER_BARRIER_BIT);
+        easy3d_debug_log_gl_error;
+
+        // ---------------------------------------------------------------------
+        // 3. Sort and blend the lists in a full-screen pass
+        // ---------------------------------------------------------------------
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        resolve_pass();
+        easy3d_debug_log_gl_error;
+
+        // restore the default background color
+        glClearColor(bkg_color_[0], bkg_color_[1], bkg_color_[2], bkg_color_[3]);
+    }
+
+
+} // namespace easy3d
@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_FRAGMENT_LINKED_LISTS_H
+#define EASY3D_RENDERER_FRAGMENT_LINKED_LISTS_H
+
+#include <vector>
+#include <easy3d/renderer/transparency.h>
+
+
+namespace easy3d {
+
+    class Camera;
+    class TrianglesDrawable;
+
+    /**
+     * \brief Transparency effect using per-pixel fragment linked lists (A-buffer).
+     *
+     * \class FragmentLinkedLists easy3d/renderer/fragment_linked_lists.h
+     *
+     * \details This is an order independent transparency (OIT) method that needs only a single
+     * geometry pass: every transparent fragment is appended to a per-pixel linked list stored
+     * in a shader storage buffer (an atomic counter allocates the nodes and an image holds the
+     * per-pixel list heads), and a full-screen resolve pass sorts each list by depth and blends
+     * the fragments back to front. Compared to DualDepthPeeling, which re-renders the geometry
+     * for every pair of peeled layers, the cost is largely independent of the depth complexity,
+     * which makes a big difference for heavy semi-transparent assemblies.
+     *
+     * The storage is bounded: on average avg_layers() fragments per pixel are kept (fragments
+     * beyond the budget are dropped for the frame), and the resolve pass sorts at most 64
+     * fragments per pixel.
+     *
+     * This method requires OpenGL 4.3 (shader storage buffers, atomic counters, and image
+     * load/store); use is_supported() to check availability and fall back to DualDepthPeeling
+     * or AverageColorBlending otherwise.
+     */
+
+    class FragmentLinkedLists : public Transparency
+    {
+    public:
+        /// \brief Constructor
+        /// \param cam The camera used in the view
+        FragmentLinkedLists(Camera* cam);
+        ~FragmentLinkedLists() override;
+
+        /// \brief Returns true if the hardware supports this method (requires OpenGL 4.3).
+        static bool is_supported();
+
+        /// \brief Sets the average number of transparent fragments stored per pixel.
+        /// \details It determines the size of the fragment buffer. It has to be a positive value.
+        ///     Default value is 8; increase it if heavy assemblies show dropped fragments.
+        void set_avg_layers(int n) { avg_layers_ = n; }
+
+        /// \brief Returns the average number of transparent fragments stored per pixel.
+        int  avg_layers() const { return avg_layers_; }
+
+        /// \brief Renders the scene (a set of surfaces) with transparency effect
+        void draw(const std::vector<TrianglesDrawable*>& surfaces) override;
+
+    protected:
+
+        // Allocate the head pointer image and the fragment/counter buffers.
+        void init(int w, int h);
+
+        // Render the geometry, appending the fragments to the per-pixel lists.
+        void geometry_pass(const std::vector<TrianglesDrawable*>& surfaces);
+
+        // Sort and blend the per-pixel lists in a full-screen pass.
+        void resolve_pass();
+
+        // Release graphics resources.
+        void clear();
+
+    private:
+        Camera* camera_;
+        float   bkg_color_[4];
+
+        int width_;
+        int height_;
+        int avg_layers_;
+
+        unsigned int head_texture_;     // per-pixel list heads (r32ui image)
+        unsigned int nodes_buffer_;     // the fragment nodes (shader storage buffer)
+        unsigned int counter_buffer_;   // the node allocator (atomic counter buffer)
+        unsigned int clear_buffer_;     // resets the list heads every frame
+        unsigned int max_nodes_;
+
+    private:
+        //copying disabled
+        FragmentLinkedLists(const FragmentLinkedLists&);
+        FragmentLinkedLists& operator=(const FragmentLinkedLists&);
+    };
+
+}
+
+#endif // EASY3D_RENDERER_FRAGMENT_LINKED_LISTS_H
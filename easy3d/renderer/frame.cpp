@@ -46,7 +46,7 @@ namespace easy3d {
 
 	  Its position() is (0,0,0) and it has an identity orientation() quat. The
 	  referenceFrame() and the constraint() are \c NULL. */
-    Frame::Frame() : constraint_(nullptr), referenceFrame_(nullptr) {}
+    Frame::Frame() : matrix_dirty_(true), constraint_(nullptr), referenceFrame_(nullptr) {}
 
 	/*! Creates a Frame with a position() and an orientation().
 
@@ -56,7 +56,7 @@ namespace easy3d {
 	 The Frame is defined in the world coordinate system (its referenceFrame() is \c
 	 NULL). It has a \c NULL associated constraint(). */
 	Frame::Frame(const vec3 &position, const quat &orientation)
-        : t_(position), q_(orientation), constraint_(nullptr), referenceFrame_(nullptr) {}
+        : t_(position), q_(orientation), matrix_dirty_(true), constraint_(nullptr), referenceFrame_(nullptr) {}
 
 	/*! Equal operator.
 
@@ -135,14 +135,21 @@ namespace easy3d {
 	  mathematical European representation (translation is on the last \e line
 	  instead of the last \e column).
 
-	  \note The scaling factor of the 4x4 matrix is 1.0. */
+	  \note The scaling factor of the 4x4 matrix is 1.0.
+
+	  \note The matrix is cached: it is recomputed only after the Frame has been
+	  modified, so repeated queries (e.g., when the same frame drives several
+	  models) cost a copy instead of a quaternion-to-matrix conversion. */
 	mat4 Frame::matrix() const
 	{
-		mat4 m = q_.matrix();
-		m[12] = t_[0];
-		m[13] = t_[1];
-		m[14] = t_[2];
-		return m;
+		if (matrix_dirty_) {
+			matrix_ = q_.matrix();
+			matrix_[12] = t_[0];
+			matrix_[13] = t_[1];
+			matrix_[14] = t_[2];
+			matrix_dirty_ = false;
+		}
+		return matrix_;
 	}
 
 
@@ -250,7 +257,7 @@ namespace easy3d {
 				rot(i, j) = m(i, j) / w;
 		}
 		q_.set_from_rotation_matrix(rot);
-        trigger();
+        frameModified();
 	}
 
 
@@ -280,7 +287,7 @@ namespace easy3d {
 		if (constraint())
 			constraint()->constrainTranslation(t, this);
 		t_ += t;
-        trigger();
+        frameModified();
 	}
 
 	/*! Rotates the Frame by \p q (defined in the Frame coordinate system): R = R*q.
@@ -305,7 +312,7 @@ namespace easy3d {
 			constraint()->constrainRotation(q, this);
 		q_ *= q;
 		q_.normalize(); // Prevents numerical drift
-        trigger();
+        frameModified();
 	}
 
 	/*! Makes the Frame rotate() by \p rotation around \p point.
@@ -332,7 +339,7 @@ namespace easy3d {
 		if (constraint())
 			constraint()->constrainTranslation(trans, this);
 		t_ += trans;
-        trigger();
+        frameModified();
 	}
 
 	/*! Same as rotateAroundPoint(), but with a \c const \p rotation quat.
@@ -374,7 +381,7 @@ namespace easy3d {
 			t_ = position;
 			q_ = orientation;
 		}
-        trigger();
+        frameModified();
 	}
 
 	/*! Same as successive calls to setTranslation() and then setRotation().
@@ -386,7 +393,7 @@ namespace easy3d {
 		const quat &rotation) {
 		t_ = translation;
 		q_ = rotation;
-        trigger();
+        frameModified();
 	}
 
 	/*! Sets the orientation() of the Frame, defined in the world coordinate system.
@@ -481,7 +488,7 @@ namespace easy3d {
 		translation = this->translation();
 		rotation = this->rotation();
 
-        trigger();
+        frameModified();
 	}
 
 	/*! Same as setPosition(), but \p position is modified so that the potential
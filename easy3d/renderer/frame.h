@@ -194,7 +194,7 @@ namespace easy3d {
         of the Frame. */
         void setTranslation(const vec3 &translation) {
             t_ = translation;
-            trigger();
+            frameModified();
         }
 
         void setTranslationWithConstraint(vec3 &translation);
@@ -211,7 +211,7 @@ namespace easy3d {
          setRotationWithConstraint() instead. */
         void setRotation(const quat &rotation) {
             q_ = rotation;
-            trigger();
+            frameModified();
         }
 
         void setRotationWithConstraint(quat &rotation);
@@ -391,11 +391,23 @@ namespace easy3d {
         }
         //@}
 
+    protected:
+        /*! Should be called whenever the position or orientation of the Frame changes:
+         invalidates the cached matrix() and emits the modified() signal. */
+        void frameModified() {
+            matrix_dirty_ = true;
+            trigger();
+        }
+
     private:
         // P o s i t i o n   a n d   o r i e n t a t i o n
         vec3 t_;
         quat q_;
 
+        // C a c h e d   m a t r i x  (recomputed by matrix() only after a modification)
+        mutable mat4 matrix_;
+        mutable bool matrix_dirty_;
+
         // C o n s t r a i n t s
         Constraint *constraint_;
 
@@ -0,0 +1,235 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/frame_capture.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/fileio/image_io.h>
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
+
+
+namespace easy3d {
+
+
+    FrameCapture::FrameCapture(unsigned int num_pbos, unsigned int max_pending_encodes)
+            : slots_(std::max(num_pbos, 2u)), ring_index_(0), recording_(false), frame_counter_(0),
+              num_captured_(0), num_dropped_(0), max_pending_encodes_(std::max(max_pending_encodes, 1u)),
+              pending_encodes_(0) {
+    }
+
+
+    FrameCapture::~FrameCapture() {
+        stop();
+        release_buffers();
+    }
+
+
+    bool FrameCapture::start(const std::string& directory, const std::string& base_name,
+                             const std::string& extension) {
+        if (recording_)
+            stop();
+
+        if (extension != "png" && extension != "jpg" && extension != "bmp" && extension != "tga" &&
+            extension != "ppm") {
+            LOG(ERROR) << "capture format must be png, jpg, bmp, tga, or ppm";
+            return false;
+        }
+
+        if (!file_system::is_directory(directory) && !file_system::create_directory(directory)) {
+            LOG(ERROR) << "could not create the capture directory: " << directory;
+            return false;
+        }
+
+        directory_ = directory;
+        base_name_ = base_name;
+        extension_ = extension;
+        frame_counter_ = 0;
+        num_captured_ = 0;
+        num_dropped_ = 0;
+        ring_index_ = 0;
+        recording_ = true;
+        return true;
+    }
+
+
+    void FrameCapture::stop() {
+        if (!recording_)
+            return;
+        recording_ = false;
+
+        // collect the frames still in the readback ring, oldest first. Blocking on the GPU is
+        // acceptable here: the animation is over and the render loop no longer needs the time.
+        for (std::size_t i = 0; i < slots_.size(); ++i) {
+            Slot& slot = slots_[(ring_index_ + i) % slots_.size()];
+            if (!slot.pending)
+                continue;
+            glClientWaitSync(reinterpret_cast<GLsync>(slot.fence), GL_SYNC_FLUSH_COMMANDS_BIT,
+                             GL_TIMEOUT_IGNORED);   easy3d_debug_log_gl_error;
+            collect(slot);
+        }
+
+        // wait until the queued frames have been encoded and written
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (pending_encodes_ > 0)
+            encodes_done_.wait(lock);
+
+        LOG_IF(WARNING, num_dropped_ > 0)
+                << num_dropped_ << " of " << (num_captured_ + num_dropped_)
+                << " frames were dropped. Consider a deeper readback ring, more encode slots, or a"
+                   " cheaper image format";
+        LOG(INFO) << num_captured_ << " frames captured into " << directory_;
+    }
+
+
+    bool FrameCapture::grab_frame() {
+        if (!recording_)
+            return false;
+
+        int viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        const int w = viewport[2];
+        const int h = viewport[3];
+        if (w <= 0 || h <= 0)
+            return false;
+
+        Slot& slot = slots_[ring_index_];
+        if (slot.pending) {
+            // the slot to reuse still holds the oldest in-flight transfer. If it has finished,
+            // collect it; if not, the GPU is more than a full ring behind, so this frame is
+            // dropped rather than stalling the render loop.
+            const GLenum state = glClientWaitSync(reinterpret_cast<GLsync>(slot.fence), 0, 0);
+            easy3d_debug_log_gl_error;
+            if (state == GL_ALREADY_SIGNALED || state == GL_CONDITION_SATISFIED)
+                collect(slot);
+            else {
+                ++num_dropped_;
+                ++frame_counter_;   // keep the numbering gap, so the drop is visible in the sequence
+                return false;
+            }
+        }
+
+        if (slot.pbo == 0) {
+            glGenBuffers(1, &slot.pbo);     easy3d_debug_log_gl_error;
+        }
+
+        // issue the transfer of this frame. glReadPixels() returns immediately because the target
+        // is a buffer object; the actual transfer overlaps with the rendering of the next frames.
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);                                easy3d_debug_log_gl_error;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);                       easy3d_debug_log_gl_error;
+        glBufferData(GL_PIXEL_PACK_BUFFER, w * h * 4, nullptr, GL_STREAM_READ); easy3d_debug_log_gl_error;
+        glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);       easy3d_debug_log_gl_error;
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);         easy3d_debug_log_gl_error;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);                              easy3d_debug_log_gl_error;
+
+        slot.width = w;
+        slot.height = h;
+        slot.frame_index = frame_counter_++;
+        slot.pending = true;
+
+        ring_index_ = (ring_index_ + 1) % slots_.size();
+        return true;
+    }
+
+
+    void FrameCapture::collect(Slot& slot) {
+        glDeleteSync(reinterpret_cast<GLsync>(slot.fence));     easy3d_debug_log_gl_error;
+        slot.fence = nullptr;
+        slot.pending = false;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);           easy3d_debug_log_gl_error;
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(
+                glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));   easy3d_debug_log_gl_error;
+        if (data) {
+            std::vector<unsigned char> pixels(data, data + slot.width * slot.height * 4);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);                easy3d_debug_log_gl_error;
+            encode(pixels, slot.width, slot.height, slot.frame_index);
+        }
+        else
+            ++num_dropped_;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);                  easy3d_debug_log_gl_error;
+    }
+
+
+    void FrameCapture::encode(std::vector<unsigned char>& pixels, int width, int height,
+                              std::size_t frame_index) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_encodes_ >= max_pending_encodes_) {
+                // the encoders are behind and the queue is at its memory bound: drop the frame
+                ++num_dropped_;
+                return;
+            }
+            ++pending_encodes_;
+        }
+
+        char buffer[2048];
+        std::snprintf(buffer, sizeof(buffer), "%s/%s_%06lu.%s", directory_.c_str(),
+                      base_name_.c_str(), static_cast<unsigned long>(frame_index), extension_.c_str());
+        const std::string file_name(buffer);
+
+        // C++11 lambdas cannot capture by move, hence the shared_ptr (see ImageIO::save_async())
+        auto data = std::make_shared< std::vector<unsigned char> >(std::move(pixels));
+        ThreadPool::global().run([this, file_name, data, width, height]() {
+            // the framebuffer is bottom-up; flip the private copy here on the worker, since the
+            // encoder's process-wide flip flag must not be touched from concurrent encodes
+            const std::size_t stride = static_cast<std::size_t>(width) * 4;
+            for (int r = 0; r < height / 2; ++r)
+                std::swap_ranges(data->begin() + r * stride,
+                                 data->begin() + (r + 1) * stride,
+                                 data->begin() + (height - 1 - r) * stride);
+
+            ImageIO::save(file_name, *data, width, height, 4);  // failures are logged by save()
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            --pending_encodes_;
+            encodes_done_.notify_all();
+        });
+
+        ++num_captured_;
+    }
+
+
+    void FrameCapture::release_buffers() {
+        for (auto& slot : slots_) {
+            if (slot.fence) {
+                glDeleteSync(reinterpret_cast<GLsync>(slot.fence));
+                slot.fence = nullptr;
+            }
+            if (slot.pbo != 0) {
+                glDeleteBuffers(1, &slot.pbo);
+                slot.pbo = 0;
+            }
+            slot.pending = false;
+        }
+    }
+
+}
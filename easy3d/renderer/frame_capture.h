@@ -0,0 +1,152 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_FRAME_CAPTURE_H
+#define EASY3D_RENDERER_FRAME_CAPTURE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Asynchronous capture of rendered frames into an image sequence.
+     * \class FrameCapture easy3d/renderer/frame_capture.h
+     *
+     * \details Capturing an animation (e.g., the playback of a KeyFrameInterpolator camera path)
+     *      with Viewer::snapshot() stalls the render loop twice per frame: glReadPixels() forces
+     *      a pipeline synchronization, and the image encode runs on the render thread. This class
+     *      decouples both. Frames are read back through a ring of pixel buffer objects, so the
+     *      GPU-to-CPU transfer of one frame overlaps with the rendering of the following ones,
+     *      and the completed transfers are handed to workers of the global thread pool for
+     *      encoding. Backpressure is handled by dropping: when the GPU transfers or the encoders
+     *      cannot keep up, grab_frame() skips the frame (and counts it) instead of blocking, so
+     *      the render loop always stays at full speed.
+     *
+     *      Typical use, from the rendering loop:
+     *      \code
+     *      capture.start("/path/to/sequence");
+     *      // ... for every frame, after the rendering:
+     *      capture.grab_frame();
+     *      // ... when the animation is done:
+     *      capture.stop();   // flushes the in-flight frames
+     *      \endcode
+     *      The resulting numbered image sequence can be turned into a video file by any offline
+     *      encoder. All methods except the counters must be called from the thread that owns the
+     *      OpenGL context.
+     */
+    class FrameCapture {
+    public:
+        /**
+         * \brief Creates a capture engine.
+         * \param num_pbos The depth of the readback ring, i.e., how many frames may be in flight
+         *      between the GPU and the CPU. Deeper rings tolerate slower transfers at the cost of
+         *      GPU memory (one viewport-sized buffer each).
+         * \param max_pending_encodes The number of frames that may be queued for encoding before
+         *      further frames are dropped. Bounds the CPU memory held by queued frames.
+         */
+        explicit FrameCapture(unsigned int num_pbos = 3, unsigned int max_pending_encodes = 8);
+
+        /// Stops the capture (flushing the in-flight frames) and releases the buffers.
+        ~FrameCapture();
+
+        /**
+         * \brief Starts recording. Frames are written to \p directory (created if necessary) as
+         *      base_name_000000.ext, base_name_000001.ext, ...
+         * \param extension Determines the image format. Only png, jpg, bmp, tga, and ppm are
+         *      supported.
+         * \return \c false if the directory cannot be created or the format is not supported.
+         */
+        bool start(const std::string& directory,
+                   const std::string& base_name = "frame",
+                   const std::string& extension = "png");
+
+        /// Stops recording. Collects the frames still in the readback ring (this may wait for the
+        /// GPU) and blocks until all queued frames have been encoded and written.
+        void stop();
+
+        /// Returns \c true if the capture engine is recording.
+        bool is_recording() const { return recording_; }
+
+        /**
+         * \brief Grabs the current read framebuffer. Call once per frame, after the frame has been
+         *      rendered. The method never blocks the render loop: it returns \c false when the
+         *      frame had to be dropped because the transfers or the encoders are behind.
+         */
+        bool grab_frame();
+
+        /// The number of frames handed to the encoders since start().
+        std::size_t num_captured() const { return num_captured_; }
+        /// The number of frames dropped since start() because the pipeline could not keep up.
+        std::size_t num_dropped() const { return num_dropped_; }
+
+    private:
+        // a slot of the readback ring: one pixel buffer object and its in-flight transfer
+        struct Slot {
+            Slot() : pbo(0), fence(nullptr), width(0), height(0), frame_index(0), pending(false) {}
+            unsigned int pbo;
+            void* fence;        // GLsync of the transfer, owned by the slot
+            int width, height;
+            std::size_t frame_index;
+            bool pending;       // a transfer has been issued and not collected yet
+        };
+
+        // collects the finished transfer of a slot and queues the frame for encoding.
+        // Assumption: the transfer has completed (the fence was signaled or waited for).
+        void collect(Slot& slot);
+        // queues a frame for encoding on the global thread pool (drops it when the queue is full)
+        void encode(std::vector<unsigned char>& pixels, int width, int height, std::size_t frame_index);
+        void release_buffers();
+
+    private:
+        std::vector<Slot> slots_;
+        std::size_t ring_index_;
+
+        bool recording_;
+        std::string directory_;
+        std::string base_name_;
+        std::string extension_;
+        std::size_t frame_counter_;
+
+        std::size_t num_captured_;
+        std::size_t num_dropped_;
+
+        // frames queued for encoding but not written yet (bounded by max_pending_encodes_)
+        unsigned int max_pending_encodes_;
+        std::size_t pending_encodes_;
+        std::mutex mutex_;
+        std::condition_variable encodes_done_;
+
+    private:
+        //copying disabled
+        FrameCapture(const FrameCapture&);
+        FrameCapture& operator=(const FrameCapture&);
+    };
+
+}
+
+#endif  // EASY3D_RENDERER_FRAME_CAPTURE_H
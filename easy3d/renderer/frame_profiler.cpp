@@ -0,0 +1,227 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/frame_profiler.h>
+
+#include <chrono>
+
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace details {
+
+        // the wall clock, in milliseconds
+        static double now_ms() {
+            using namespace std::chrono;
+            return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+        }
+
+        // enough slots for the timestamp results of the oldest frame to be available when
+        // its slot is reused (the driver typically keeps 1-2 frames in flight)
+        static const int num_slots = 4;
+
+        static const int history_length = 200;
+    }
+
+
+    //  \cond
+
+    bool FrameProfiler::enabled_ = false;
+    std::vector<FrameProfiler::FrameData> FrameProfiler::frames_;
+    int FrameProfiler::frame_index_ = 0;
+    FrameProfiler::FrameData *FrameProfiler::current_ = nullptr;
+    std::vector<int> FrameProfiler::open_sections_;
+    std::vector<unsigned int> FrameProfiler::free_queries_;
+
+    std::vector<FrameProfiler::Record> FrameProfiler::latest_;
+    double FrameProfiler::frame_cpu_time_ = 0.0;
+    double FrameProfiler::frame_gpu_time_ = 0.0;
+    std::vector<float> FrameProfiler::cpu_history_;
+    std::vector<float> FrameProfiler::gpu_history_;
+    int FrameProfiler::history_index_ = 0;
+
+    //  \endcond
+
+
+    void FrameProfiler::set_enabled(bool b) {
+        if (b && !glQueryCounter) {
+            LOG_FIRST_N(WARNING, 1) << "timestamp queries not supported by the driver, profiling unavailable"
+                                       " (this is the first record)";
+            return;
+        }
+        enabled_ = b;
+    }
+
+
+    unsigned int FrameProfiler::new_query() {
+        if (!free_queries_.empty()) {
+            const unsigned int id = free_queries_.back();
+            free_queries_.pop_back();
+            return id;
+        }
+        GLuint id = 0;
+        glGenQueries(1, &id); easy3d_debug_log_gl_error;
+        return id;
+    }
+
+
+    void FrameProfiler::begin_frame() {
+        if (!enabled_)
+            return;
+
+        if (frames_.empty()) {
+            frames_.resize(details::num_slots);
+            cpu_history_.resize(details::history_length, 0.0f);
+            gpu_history_.resize(details::history_length, 0.0f);
+        }
+
+        FrameData &frame = frames_[frame_index_];
+        if (frame.pending)
+            resolve(frame);
+
+        frame.sections.clear();
+        frame.query_start = new_query();
+        frame.query_end = new_query();
+        current_ = &frame;
+        open_sections_.clear();
+
+        glQueryCounter(frame.query_start, GL_TIMESTAMP);
+        frame.cpu_start = details::now_ms();
+    }
+
+
+    void FrameProfiler::end_frame() {
+        if (!enabled_ || !current_)
+            return;
+
+        // close sections left open (e.g., by an exception in a draw function)
+        while (!open_sections_.empty())
+            end_section();
+
+        current_->cpu_end = details::now_ms();
+        glQueryCounter(current_->query_end, GL_TIMESTAMP);
+
+        current_->pending = true;
+        current_ = nullptr;
+        frame_index_ = (frame_index_ + 1) % static_cast<int>(frames_.size());
+    }
+
+
+    void FrameProfiler::begin_section(const char *name) {
+        if (!enabled_ || !current_)
+            return;
+
+        SectionData section;
+        section.name = name;
+        section.depth = static_cast<int>(open_sections_.size());
+        section.query_start = new_query();
+        section.query_end = new_query();
+
+        open_sections_.push_back(static_cast<int>(current_->sections.size()));
+        current_->sections.push_back(section);
+
+        glQueryCounter(current_->sections.back().query_start, GL_TIMESTAMP);
+        current_->sections.back().cpu_start = details::now_ms();
+    }
+
+
+    void FrameProfiler::end_section() {
+        if (!enabled_ || !current_ || open_sections_.empty())
+            return;
+
+        SectionData &section = current_->sections[open_sections_.back()];
+        open_sections_.pop_back();
+
+        section.cpu_end = details::now_ms();
+        glQueryCounter(section.query_end, GL_TIMESTAMP);
+    }
+
+
+    void FrameProfiler::resolve(FrameData &frame) {
+        auto gpu_time = [](unsigned int query_start, unsigned int query_end) -> double {
+            GLuint64 start = 0, end = 0;
+            glGetQueryObjectui64v(query_start, GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(query_end, GL_QUERY_RESULT, &end);
+            return static_cast<double>(end - start) / 1000000.0;    // nanoseconds -> milliseconds
+        };
+
+        latest_.clear();
+        for (auto &section : frame.sections) {
+            Record record;
+            record.name = section.name;
+            record.depth = section.depth;
+            record.cpu_time = section.cpu_end - section.cpu_start;
+            record.gpu_time = gpu_time(section.query_start, section.query_end);
+            latest_.push_back(record);
+
+            free_queries_.push_back(section.query_start);
+            free_queries_.push_back(section.query_end);
+        }
+
+        frame_cpu_time_ = frame.cpu_end - frame.cpu_start;
+        frame_gpu_time_ = gpu_time(frame.query_start, frame.query_end);
+        free_queries_.push_back(frame.query_start);
+        free_queries_.push_back(frame.query_end);
+
+        cpu_history_[history_index_] = static_cast<float>(frame_cpu_time_);
+        gpu_history_[history_index_] = static_cast<float>(frame_gpu_time_);
+        history_index_ = (history_index_ + 1) % static_cast<int>(cpu_history_.size());
+
+        frame.pending = false;
+        easy3d_debug_log_gl_error;
+    }
+
+
+    void FrameProfiler::terminate() {
+        for (auto &frame : frames_) {
+            if (frame.pending) {
+                free_queries_.push_back(frame.query_start);
+                free_queries_.push_back(frame.query_end);
+                for (auto &section : frame.sections) {
+                    free_queries_.push_back(section.query_start);
+                    free_queries_.push_back(section.query_end);
+                }
+            }
+        }
+        if (!free_queries_.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(free_queries_.size()), free_queries_.data());
+            free_queries_.clear();
+        }
+
+        frames_.clear();
+        frame_index_ = 0;
+        current_ = nullptr;
+        open_sections_.clear();
+        latest_.clear();
+        cpu_history_.clear();
+        gpu_history_.clear();
+        history_index_ = 0;
+        enabled_ = false;
+    }
+
+}
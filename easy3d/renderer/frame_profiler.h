@@ -0,0 +1,154 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_FRAME_PROFILER_H
+#define EASY3D_RENDERER_FRAME_PROFILER_H
+
+#include <string>
+#include <vector>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Per-frame CPU/GPU profiling of the rendering pipeline.
+     *
+     * \class FrameProfiler easy3d/renderer/frame_profiler.h
+     *
+     * \details The profiler records, for every section of a frame (e.g., the shadow pass, the main pass, an
+     * overlay), the wall-clock time spent on the CPU and the time the GPU spent executing the enclosed
+     * commands (measured with OpenGL timestamp queries). The query results are read back a few frames later,
+     * when they are available without forcing a pipeline flush, so profiling does not stall the GPU (unlike
+     * OpenGLTimer, which blocks until its result is ready). The reported breakdown is therefore a few frames
+     * behind the displayed one. A ring buffer keeps the frame totals of the recent history for plotting,
+     * e.g., in an ImGui HUD (see Tutorial_201_Viewer_imgui).
+     *
+     * The viewer times its main stages already. To time a custom stage, enclose it in a scoped section:
+     *      \code
+     *      { FrameProfiler::Section section("my effect");
+     *          // rendering commands ...
+     *      }
+     *      \endcode
+     * Sections may nest. All methods must be called from the thread owning the OpenGL context. The profiler
+     * is disabled by default and costs nothing while disabled.
+     *
+     * \note make sure to call terminate() to destroy the query objects before the OpenGL context is deleted.
+     * \see OpenGLTimer
+     */
+    class FrameProfiler {
+    public:
+        /// One timed section of the latest resolved frame.
+        struct Record {
+            std::string name;
+            int depth;          ///< the nesting depth (0 for top-level sections)
+            double cpu_time;    ///< the CPU wall-clock time, in milliseconds
+            double gpu_time;    ///< the GPU execution time, in milliseconds
+        };
+
+        /// A scoped section: the constructor begins it, the destructor ends it.
+        class Section {
+        public:
+            Section(const char *name) { FrameProfiler::begin_section(name); }
+            ~Section() { FrameProfiler::end_section(); }
+        };
+
+        /// Enable/Disable profiling. Must be called with a current OpenGL context. Enabling fails (with a
+        /// warning) when the driver does not support timestamp queries.
+        static void set_enabled(bool b);
+        static bool is_enabled() { return enabled_; }
+
+        /// Mark the beginning of a frame. Called by the viewer's main loop.
+        static void begin_frame();
+        /// Mark the end of a frame. Called by the viewer's main loop.
+        static void end_frame();
+
+        /// Begin a named section. Prefer the scoped Section helper.
+        static void begin_section(const char *name);
+        /// End the innermost open section.
+        static void end_section();
+
+        /// The per-section breakdown of the latest resolved frame.
+        static const std::vector<Record> &sections() { return latest_; }
+        /// The CPU/GPU totals of the latest resolved frame, in milliseconds.
+        static double frame_cpu_time() { return frame_cpu_time_; }
+        static double frame_gpu_time() { return frame_gpu_time_; }
+
+        /// The ring buffers with the frame totals of the last history_size() frames, in milliseconds.
+        /// The entry at history_index() is the oldest one, its predecessor the most recent one.
+        static int history_size() { return static_cast<int>(cpu_history_.size()); }
+        static int history_index() { return history_index_; }
+        static const std::vector<float> &cpu_history() { return cpu_history_; }
+        static const std::vector<float> &gpu_history() { return gpu_history_; }
+
+        /// Destroy the query objects and discard all results.
+        static void terminate();
+
+    private:
+        // the bookkeeping of one section of a frame in flight
+        struct SectionData {
+            std::string name;
+            int depth;
+            double cpu_start;
+            double cpu_end;
+            unsigned int query_start;   // timestamp query issued when the section begins
+            unsigned int query_end;     // timestamp query issued when the section ends
+        };
+
+        // a frame whose timestamp queries may still be in flight
+        struct FrameData {
+            std::vector<SectionData> sections;
+            double cpu_start;
+            double cpu_end;
+            unsigned int query_start;
+            unsigned int query_end;
+            bool pending;
+            FrameData() : cpu_start(0.0), cpu_end(0.0), query_start(0), query_end(0), pending(false) {}
+        };
+
+        // read back the query results of a frame and publish them. By the time a slot is reused its
+        // queries are (almost always) available, so this does not wait in practice.
+        static void resolve(FrameData &frame);
+
+        // a recycled (or freshly generated) timestamp query object
+        static unsigned int new_query();
+
+        static bool enabled_;
+        static std::vector<FrameData> frames_;  // the slots, cycled through frame after frame
+        static int frame_index_;
+        static FrameData *current_;
+        static std::vector<int> open_sections_; // the indices of the open sections of the current frame
+        static std::vector<unsigned int> free_queries_;
+
+        // the published results (see resolve())
+        static std::vector<Record> latest_;
+        static double frame_cpu_time_;
+        static double frame_gpu_time_;
+        static std::vector<float> cpu_history_;
+        static std::vector<float> gpu_history_;
+        static int history_index_;
+    };
+
+}
+
+#endif  // EASY3D_RENDERER_FRAME_PROFILER_H
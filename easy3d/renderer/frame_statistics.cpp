@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/frame_statistics.h>
+
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/renderer/texture.h>
+
+
+namespace easy3d {
+
+    FrameStatistics::Counters FrameStatistics::current_;
+    FrameStatistics::Counters FrameStatistics::latest_;
+
+
+    void FrameStatistics::Counters::clear() {
+        draw_calls = 0;
+        program_binds = 0;
+        program_switches = 0;
+        texture_binds = 0;
+        texture_switches = 0;
+        buffer_uploads = 0;
+        buffer_upload_bytes = 0;
+        triangles = 0;
+    }
+
+
+    void FrameStatistics::new_frame() {
+        // the program/texture bind tallies live in their classes (they also drive the
+        // redundant-bind filtering there); collect them at the frame boundary
+        current_.program_binds = ShaderProgram::num_binds();
+        current_.program_switches = ShaderProgram::num_switches();
+        current_.texture_binds = Texture::num_binds();
+        current_.texture_switches = Texture::num_switches();
+        ShaderProgram::reset_bind_stats();
+        Texture::reset_bind_stats();
+
+        latest_ = current_;
+        current_.clear();
+    }
+
+
+    void FrameStatistics::count_draw_call(unsigned int type, std::size_t num_vertices, std::size_t num_instances) {
+        ++current_.draw_calls;
+
+        std::size_t triangles = 0;
+        switch (type) {
+            case GL_TRIANGLES:
+                triangles = num_vertices / 3;
+                break;
+            case GL_TRIANGLE_STRIP:
+            case GL_TRIANGLE_FAN:
+                triangles = num_vertices >= 3 ? num_vertices - 2 : 0;
+                break;
+            default:    // points and lines contribute no triangles
+                break;
+        }
+        current_.triangles += triangles * (num_instances > 0 ? num_instances : 1);
+    }
+
+}
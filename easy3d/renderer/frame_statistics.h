@@ -0,0 +1,95 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_FRAME_STATISTICS_H
+#define EASY3D_RENDERER_FRAME_STATISTICS_H
+
+#include <cstddef>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Per-frame counters of the OpenGL workload.
+     *
+     * \class FrameStatistics easy3d/renderer/frame_statistics.h
+     *
+     * \details While FrameProfiler answers "where does the time go", this collector answers
+     * "what is being submitted": the number of draw calls, shader program and texture binds
+     * (and how many of them actually switched the bound object, see ShaderProgram::num_binds()),
+     * buffer uploads with their byte volume, and the triangles submitted. The counters are
+     * tallied inside Drawable::gl_draw(), VertexArrayObject and the bind() calls of
+     * ShaderProgram/Texture, so they cover the model rendering path (overlay helpers in
+     * OpenglUtil/primitives are not counted). The viewer calls new_frame() at the top of
+     * every frame, which publishes the tallies of the finished frame and starts over; the
+     * published counters are shown, e.g., in the ImGui HUD (see Tutorial_201_Viewer_imgui).
+     *
+     * Counting is a few integer additions per call and is therefore always on. All methods
+     * must be called from the thread owning the OpenGL context.
+     *
+     * \see FrameProfiler
+     */
+    class FrameStatistics {
+    public:
+        /// The counters of one frame.
+        struct Counters {
+            unsigned int draw_calls;            ///< glDraw* calls issued by Drawable::gl_draw()
+            unsigned int program_binds;         ///< ShaderProgram::bind() calls
+            unsigned int program_switches;      ///< binds that changed the bound program
+            unsigned int texture_binds;         ///< Texture::bind() calls
+            unsigned int texture_switches;      ///< binds that changed the bound texture
+            unsigned int buffer_uploads;        ///< glBufferData/glBufferSubData calls
+            std::size_t  buffer_upload_bytes;   ///< bytes transferred by those uploads
+            std::size_t  triangles;             ///< triangles submitted (instances included)
+            Counters() { clear(); }
+            void clear();
+        };
+
+        /// Publish the tallies of the finished frame and start a new one. Called by the
+        /// viewer's main loop at the beginning of every frame.
+        static void new_frame();
+
+        /// The counters of the last completed frame.
+        static const Counters& last_frame() { return latest_; }
+
+        /// \name Tally hooks, called from the rendering internals.
+        //@{
+        /// Count one draw call of \p num_vertices vertices (or indices) with the given OpenGL
+        /// primitive \p type, drawn \p num_instances times (0 means non-instanced).
+        static void count_draw_call(unsigned int type, std::size_t num_vertices, std::size_t num_instances);
+        /// Count one buffer upload of \p bytes bytes.
+        static void count_buffer_upload(std::size_t bytes) {
+            ++current_.buffer_uploads;
+            current_.buffer_upload_bytes += bytes;
+        }
+        //@}
+
+    private:
+        static Counters current_;   // the frame being tallied
+        static Counters latest_;    // the published (last completed) frame
+    };
+
+}
+
+#endif  // EASY3D_RENDERER_FRAME_STATISTICS_H
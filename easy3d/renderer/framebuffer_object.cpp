@@ -771,6 +771,10 @@ namespace easy3d {
             return false;
         }
 
+        // binding for drawing may change the contents, so the resolved copies become stale
+        if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER)
+            resolved_up_to_date_.assign(resolved_up_to_date_.size(), 0);
+
         GLuint currentFbo = 0;
         switch (target)
         {
@@ -1021,7 +1025,13 @@ namespace easy3d {
             _prepare_resolve_fbo();
         }
 
+        // reallocating the buffers discards the resolved copies
+        if (resolved_fbo_->width() != width() || resolved_fbo_->height() != height())
+            resolved_up_to_date_.clear();
         resolved_fbo_->ensure_size(width(), height());	easy3d_debug_log_gl_error;
+
+        // one entry per color attachment, plus one for depth
+        resolved_up_to_date_.resize(color_attachments_.size() + 1, 0);
     }
 
 
@@ -1035,9 +1045,12 @@ namespace easy3d {
         if (texture && glIsTexture(texture)) {
             if (samaples() == 0 || !resolve)
                 return texture;
-            else { // resolve
+            else { // resolve (lazily: only this attachment, and only if it may have changed)
                 const_cast<FramebufferObject*>(this)->_prepare_resolve_fbo();
-                blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, index, index, GL_COLOR_BUFFER_BIT);	easy3d_debug_log_gl_error;
+                if (!resolved_up_to_date_[index]) {
+                    blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, index, index, GL_COLOR_BUFFER_BIT);	easy3d_debug_log_gl_error;
+                    resolved_up_to_date_[index] = 1;
+                }
                 return resolved_fbo_->color_texture(index);
             }
         }
@@ -1052,9 +1065,12 @@ namespace easy3d {
         if (depth_texture_ && glIsTexture(depth_texture_)) {
 			if (samaples() == 0 || !resolve)
                 return depth_texture_;
-            else { // resolve
+            else { // resolve (lazily: only if the contents may have changed)
                 const_cast<FramebufferObject*>(this)->_prepare_resolve_fbo();
-                blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, GL_DEPTH_BUFFER_BIT);	easy3d_debug_log_gl_error;
+                if (!resolved_up_to_date_[num_color_attachements()]) {
+                    blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, GL_DEPTH_BUFFER_BIT);	easy3d_debug_log_gl_error;
+                    resolved_up_to_date_[num_color_attachements()] = 1;
+                }
                 return resolved_fbo_->depth_texture();
             }
         }
@@ -1410,7 +1426,10 @@ namespace easy3d {
 
         else {
             const_cast<FramebufferObject*>(this)->_prepare_resolve_fbo();
-            blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, index, index, GL_COLOR_BUFFER_BIT);	easy3d_debug_log_gl_error;
+            if (!resolved_up_to_date_[index]) {
+                blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, index, index, GL_COLOR_BUFFER_BIT);	easy3d_debug_log_gl_error;
+                resolved_up_to_date_[index] = 1;
+            }
             resolved_fbo_->read_color(index, buffer, format, flip_vertically);
         }
 
@@ -1434,6 +1453,90 @@ namespace easy3d {
     }
 
 
+    bool FramebufferObject::read_color(unsigned int index, unsigned char* buffer, int x, int y, int w, int h, unsigned int format, bool flip_vertically /* = true */) const
+    {
+        if (!has_color_attachment(index)) {
+            LOG(ERROR) << "color attachment " << index << " does not exist";
+            return false;
+        }
+
+        unsigned int bytes_per_pixel = 0;
+        if (format == GL_RGB || format == GL_BGR)
+            bytes_per_pixel = 3;
+        else if (format == GL_RGBA || format == GL_BGRA)
+            bytes_per_pixel = 4;
+        else {
+            LOG(ERROR) << "to read color buffer, the format must be one of GL_RGB, GL_BGR, GL_RGBA, and GL_BGRA.";
+            return false;
+        }
+
+        if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > width_ || y + h > height_) {
+            LOG(ERROR) << "region outside the framebuffer";
+            return false;
+        }
+
+        glFinish();
+        if (samples_ <= 0) {
+            GLuint currentFbo = 0;
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, (GLint*)&currentFbo);	easy3d_debug_log_gl_error;
+            if (currentFbo != fbo_id_)
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_id_);		easy3d_debug_log_gl_error;
+
+            const_cast<FramebufferObject*>(this)->activate_read_buffer(index);
+
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);				easy3d_debug_log_gl_error;
+            glReadPixels(x, y, w, h, format, GL_UNSIGNED_BYTE, buffer);	easy3d_debug_log_gl_error;
+
+            if (currentFbo != fbo_id_)
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, currentFbo);		easy3d_debug_log_gl_error;
+
+            // flip vertically
+            if (flip_vertically) {
+                unsigned int row_size = w * bytes_per_pixel;
+                unsigned char* line = new unsigned char[row_size];
+                for (int i = 0, j = h - 1; i < h / 2; ++i, --j) {
+                    memcpy(line, buffer + i * row_size, row_size);
+                    memcpy(buffer + i * row_size, buffer + j * row_size, row_size);
+                    memcpy(buffer + j * row_size, line, row_size);
+                }
+                delete[] line;
+            }
+        }
+
+        else {
+            const_cast<FramebufferObject*>(this)->_prepare_resolve_fbo();
+            // resolve only the requested region, unless a full resolved copy is already available
+            if (!resolved_up_to_date_[index]) {
+                blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), x, y, x + w, y + h,
+                                 this, x, y, x + w, y + h, index, index, GL_COLOR_BUFFER_BIT);	easy3d_debug_log_gl_error;
+            }
+            return resolved_fbo_->read_color(index, buffer, x, y, w, h, format, flip_vertically);
+        }
+
+        return true;
+    }
+
+
+    bool FramebufferObject::read_color(unsigned int index, std::vector<unsigned char>& buffer, int x, int y, int w, int h, unsigned int format, bool flip_vertically /* = true */) const {
+        unsigned int bytes_per_pixel = 0;
+        if (format == GL_RGB || format == GL_BGR)
+            bytes_per_pixel = 3;
+        else if (format == GL_RGBA || format == GL_BGRA)
+            bytes_per_pixel = 4;
+        else {
+            LOG(ERROR) << "to read color buffer, the format must be one of GL_RGB, GL_BGR, GL_RGBA, and GL_BGRA.";
+            return false;
+        }
+        if (w <= 0 || h <= 0) {
+            LOG(ERROR) << "invalid region size";
+            return false;
+        }
+
+        buffer.resize(bytes_per_pixel * w * h);
+        return read_color(index, buffer.data(), x, y, w, h, format, flip_vertically);
+    }
+
+
     bool FramebufferObject::snapshot_color(unsigned int index, const std::string& file_name) const {
         if (!is_valid()) {
             LOG(ERROR) << "framebuffer not valid";
@@ -1516,7 +1619,10 @@ namespace easy3d {
 
         else {
             const_cast<FramebufferObject*>(this)->_prepare_resolve_fbo();
-            blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, GL_DEPTH_BUFFER_BIT);	easy3d_debug_log_gl_error;
+            if (!resolved_up_to_date_[num_color_attachements()]) {
+                blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, GL_DEPTH_BUFFER_BIT);	easy3d_debug_log_gl_error;
+                resolved_up_to_date_[num_color_attachements()] = 1;
+            }
             resolved_fbo_->read_depth(buffer, flip_vertically);
         }
 
@@ -1531,6 +1637,66 @@ namespace easy3d {
     }
 
 
+    bool FramebufferObject::read_depth(float* buffer, int x, int y, int w, int h, bool flip_vertically /* = true */) const
+    {
+        if (!has_depth_attachment()) {
+            LOG(ERROR) << "depth attachment does not exist";
+            return false;
+        }
+
+        if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > width_ || y + h > height_) {
+            LOG(ERROR) << "region outside the framebuffer";
+            return false;
+        }
+
+        glFinish();
+        if (samples_ <= 0) {
+            GLuint currentFbo = 0;
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, (GLint*)&currentFbo);	easy3d_debug_log_gl_error;
+            if (currentFbo != fbo_id_)
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_id_);		easy3d_debug_log_gl_error;
+
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);				easy3d_debug_log_gl_error;
+            glReadPixels(x, y, w, h, GL_DEPTH_COMPONENT, GL_FLOAT, buffer);	easy3d_debug_log_gl_error;
+
+            if (currentFbo != fbo_id_)
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, currentFbo);		easy3d_debug_log_gl_error;
+
+            // flip vertically
+            if (flip_vertically) {
+                for (int j = 0; j < h / 2; ++j) {
+                    float* row1 = buffer + j * w;
+                    float* row2 = buffer + (h - 1 - j) * w;
+                    for (int i = 0; i < w; ++i)
+                        std::swap(row1[i], row2[i]);
+                }
+            }
+        }
+
+        else {
+            const_cast<FramebufferObject*>(this)->_prepare_resolve_fbo();
+            // resolve only the requested region, unless a full resolved copy is already available
+            if (!resolved_up_to_date_[num_color_attachements()]) {
+                blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), x, y, x + w, y + h,
+                                 this, x, y, x + w, y + h, GL_DEPTH_BUFFER_BIT);	easy3d_debug_log_gl_error;
+            }
+            return resolved_fbo_->read_depth(buffer, x, y, w, h, flip_vertically);
+        }
+
+        return true;
+    }
+
+
+    bool FramebufferObject::read_depth(std::vector<float>& buffer, int x, int y, int w, int h, bool flip_vertically /* = true */) const {
+        if (w <= 0 || h <= 0) {
+            LOG(ERROR) << "invalid region size";
+            return false;
+        }
+        buffer.resize(w * h);
+        return read_depth(buffer.data(), x, y, w, h, flip_vertically);
+    }
+
+
     bool FramebufferObject::snapshot_depth(const std::string& file_name) const {
         std::vector<float> depths;
         bool got = read_depth(depths, true);
@@ -1580,7 +1746,12 @@ namespace easy3d {
 
         else {
             const_cast<FramebufferObject*>(this)->_prepare_resolve_fbo();
-            blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, index, index, GL_COLOR_BUFFER_BIT);	easy3d_debug_log_gl_error;
+            // resolve just the requested pixel (a fraction of a full-attachment resolve), unless
+            // a full resolved copy is already available
+            if (!resolved_up_to_date_[index]) {
+                blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), x, y, x + 1, y + 1,
+                                 this, x, y, x + 1, y + 1, index, index, GL_COLOR_BUFFER_BIT);	easy3d_debug_log_gl_error;
+            }
             resolved_fbo_->read_color(rgba, x, y, index);
         }
 
@@ -1614,7 +1785,12 @@ namespace easy3d {
 
         else {
             const_cast<FramebufferObject*>(this)->_prepare_resolve_fbo();
-            blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), this, GL_DEPTH_BUFFER_BIT);	easy3d_debug_log_gl_error;
+            // resolve just the requested pixel (a fraction of a full-attachment resolve), unless
+            // a full resolved copy is already available
+            if (!resolved_up_to_date_[num_color_attachements()]) {
+                blit_framebuffer(const_cast<FramebufferObject*>(resolved_fbo_), x, y, x + 1, y + 1,
+                                 this, x, y, x + 1, y + 1, GL_DEPTH_BUFFER_BIT);	easy3d_debug_log_gl_error;
+            }
             resolved_fbo_->read_depth(depth, x, y);
         }
 
@@ -1794,6 +1970,9 @@ namespace easy3d {
         // restore both READ and DRAW
         glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFbo); 	easy3d_debug_log_gl_error;
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFbo); 	easy3d_debug_log_gl_error;
+
+        // the target contents changed, so its resolved copies (if any) are stale
+        target->resolved_up_to_date_.assign(target->resolved_up_to_date_.size(), 0);
     }
 
 
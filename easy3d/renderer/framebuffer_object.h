@@ -285,6 +285,16 @@ namespace easy3d {
         bool read_depth(float* buffer, bool flip_vertically = true) const;
         bool read_depth(std::vector<float>& buffer, bool flip_vertically = true) const;
 
+        // Region variants of the above: read only the sub-rectangle (x, y, w, h) of the buffer.
+        // For multisample framebuffers only the requested region is resolved, which is much
+        // cheaper than a full-attachment resolve when a small region is needed (e.g., composite
+        // views, picking).
+        // NOTE: (x, y) in OpenGL coordinate system.
+        bool read_color(unsigned int index, unsigned char* buffer, int x, int y, int w, int h, unsigned int format, bool flip_vertically = true) const;
+        bool read_color(unsigned int index, std::vector<unsigned char>& buffer, int x, int y, int w, int h, unsigned int format, bool flip_vertically = true) const;
+        bool read_depth(float* buffer, int x, int y, int w, int h, bool flip_vertically = true) const;
+        bool read_depth(std::vector<float>& buffer, int x, int y, int w, int h, bool flip_vertically = true) const;
+
         // read the color at pixel (x, y) from the color render buffer attached to color attachment index.
         // returns false if the color attachment index does not exist.
         // NOTE: (x, y) in OpenGL coordinate system.
@@ -383,6 +393,11 @@ namespace easy3d {
 
         int samples_;
         FramebufferObject* resolved_fbo_;	// for multisample FBO,
+        // Which attachments of resolved_fbo_ hold an up-to-date copy (one entry per color
+        // attachment, plus one for depth). Resolves are performed lazily, per attachment, and
+        // skipped while the contents cannot have changed (i.e., until the fbo is bound for
+        // drawing or used as a blit target again).
+        mutable std::vector<char> resolved_up_to_date_;
 
         GLenum texture_target_;
 
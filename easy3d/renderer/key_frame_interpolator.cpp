@@ -42,6 +42,8 @@
 
 #include <easy3d/util/timer.h>
 
+#include <algorithm>
+
 
 namespace easy3d {
 
@@ -49,13 +51,8 @@ namespace easy3d {
     KeyFrameInterpolator::KeyFrameInterpolator(Frame *frame)
             : frame_(frame), period_(40)   // 25 frames per second
             , interpolationTime_(0.0), interpolationSpeed_(1.0), interpolationStarted_(false),
-              loopInterpolation_(false), pathIsValid_(false), valuesAreValid_(true), currentFrameValid_(false),
+              loopInterpolation_(false), pathIsValid_(false), valuesAreValid_(true), coefficientsAreValid_(false),
               path_drawable_(nullptr), cameras_drawable_(nullptr) {
-        if (keyFrames_.size() < 2)
-            return;
-
-        for (int i = 0; i < 4; ++i)
-            currentFrame_[i] = keyFrames_.begin();
     }
 
 
@@ -141,7 +138,7 @@ namespace easy3d {
 
         valuesAreValid_ = false;
         pathIsValid_ = false;
-        currentFrameValid_ = false;
+        coefficientsAreValid_ = false;
         resetInterpolation();
     }
 
@@ -163,9 +160,11 @@ namespace easy3d {
             delete f;
         }
         keyFrames_.clear();
+        times_.clear();
+        segments_.clear();
         pathIsValid_ = false;
         valuesAreValid_ = false;
-        currentFrameValid_ = false;
+        coefficientsAreValid_ = false;
 
         delete path_drawable_;
         path_drawable_ = nullptr;
@@ -192,45 +191,28 @@ namespace easy3d {
                 cameras_drawable_ = nullptr;
             }
 
-            if (!valuesAreValid_)
-                updateModifiedFrameValues();
+            if (!coefficientsAreValid_)
+                updateCoefficients();
 
             if (keyFrames_.front() == keyFrames_.back())
                 path_.push_back(Frame(keyFrames_.front()->position(), keyFrames_.front()->orientation()));
             else {
                 static Frame fr;
-                KeyFrame *kf_[4];
-                kf_[0] = keyFrames_.front();
-                kf_[1] = kf_[0];
-                int index = 1;
-                kf_[2] = (index < keyFrames_.size()) ? keyFrames_.at(index) : nullptr;
-                index++;
-                kf_[3] = (index < keyFrames_.size()) ? keyFrames_.at(index) : nullptr;
-
-                while (kf_[2]) {
-                    vec3 diff = kf_[2]->position() - kf_[1]->position();
-                    vec3 v1 = 3.0 * diff - 2.0 * kf_[1]->tgP() - kf_[2]->tgP();
-                    vec3 v2 = -2.0 * diff + kf_[1]->tgP() + kf_[2]->tgP();
-
-                    // cout << kf_[0]->time() << " , " << kf_[1]->time() << " , " << kf_[2]->time() << " , " << kf_[3]->time() << endl;
+                for (std::size_t i = 0; i + 1 < keyFrames_.size(); ++i) {
+                    const KeyFrame *kf1 = keyFrames_[i];
+                    const KeyFrame *kf2 = keyFrames_[i + 1];
+                    const SplineSegment &seg = segments_[i];
+
                     for (int step = 0; step < nbSteps; ++step) {
                         double alpha = step / static_cast<double>(nbSteps);
-                        fr.setPosition(kf_[1]->position() + alpha * (kf_[1]->tgP() + alpha * (v1 + alpha * v2)));
+                        fr.setPosition(kf1->position() + alpha * (kf1->tgP() + alpha * (seg.v1 + alpha * seg.v2)));
                         fr.setOrientation(
-                                quat::squad(kf_[1]->orientation(), kf_[1]->tgQ(), kf_[2]->tgQ(), kf_[2]->orientation(),
-                                            alpha));
+                                quat::squad(kf1->orientation(), kf1->tgQ(), kf2->tgQ(), kf2->orientation(), alpha));
                         path_.push_back(fr);
                     }
-
-                    // Shift
-                    kf_[0] = kf_[1];
-                    kf_[1] = kf_[2];
-                    kf_[2] = kf_[3];
-                    index++;
-                    kf_[3] = (index < keyFrames_.size()) ? keyFrames_.at(index) : nullptr;
                 }
                 // Add last KeyFrame
-                path_.push_back(Frame(kf_[1]->position(), kf_[1]->orientation()));
+                path_.push_back(Frame(keyFrames_.back()->position(), keyFrames_.back()->orientation()));
             }
             pathIsValid_ = true;
         }
@@ -354,60 +336,74 @@ namespace easy3d {
     }
 
 
-    void KeyFrameInterpolator::updateCurrentKeyFrameForTime(double time) {
+    void KeyFrameInterpolator::updateCoefficients() {
         // Assertion: times are sorted in monotone order.
         // Assertion: keyFrames_ is not empty
 
-        // TODO: Special case for loops when closed path is implemented !!
-        if (!currentFrameValid_)
-            // Recompute everything from scratch
-            currentFrame_[1] = keyFrames_.begin(); // points to the first one
-
-        while ((*currentFrame_[1])->time() > time) {
-            currentFrameValid_ = false;
-            if (currentFrame_[1] == keyFrames_.begin()) // alreay the first one
-                break;
-            --currentFrame_[1]; // points to the previous one
-        }
-
-        if (!currentFrameValid_)
-            currentFrame_[2] = currentFrame_[1];
+        if (!valuesAreValid_)
+            updateModifiedFrameValues();
 
-        while ((*currentFrame_[2])->time() < time) {
-            currentFrameValid_ = false;
-            if (*currentFrame_[2] == keyFrames_.back()) // already the last one
-                break;
-            ++currentFrame_[2];// points to the next one
+        times_.resize(keyFrames_.size());
+        for (std::size_t i = 0; i < keyFrames_.size(); ++i)
+            times_[i] = keyFrames_[i]->time();
+
+        // one set of spline coefficients per keyframe interval [i, i+1)
+        segments_.clear();
+        if (keyFrames_.size() > 1) {
+            segments_.resize(keyFrames_.size() - 1);
+            for (std::size_t i = 0; i + 1 < keyFrames_.size(); ++i) {
+                const KeyFrame *kf1 = keyFrames_[i];
+                const KeyFrame *kf2 = keyFrames_[i + 1];
+                const vec3 delta = kf2->position() - kf1->position();
+                segments_[i].v1 = 3.0 * delta - 2.0 * kf1->tgP() - kf2->tgP();
+                segments_[i].v2 = -2.0 * delta + kf1->tgP() + kf2->tgP();
+            }
         }
 
-        if (!currentFrameValid_) {
-            currentFrame_[1] = currentFrame_[2];
-            if ((currentFrame_[1] != keyFrames_.begin()) && (time < (*currentFrame_[2])->time()))
-                --currentFrame_[1];
+        coefficientsAreValid_ = true;
+    }
 
-            currentFrame_[0] = currentFrame_[1];
-            if (currentFrame_[0] != keyFrames_.begin())
-                --currentFrame_[0];
 
-            currentFrame_[3] = currentFrame_[2];
+    std::size_t KeyFrameInterpolator::intervalForTime(double time) const {
+        // times_ is sorted, so a binary search replaces the incremental walk of the keyframes.
+        // Times outside the path range are clamped to the first/last interval.
+        const auto pos = std::upper_bound(times_.begin(), times_.end(), time);
+        if (pos == times_.begin())
+            return 0;
+        std::size_t index = static_cast<std::size_t>(pos - times_.begin()) - 1;
+        if (index + 1 >= times_.size())  // time is at or beyond the last keyframe
+            index = times_.size() - 2;
+        return index;
+    }
 
-            if ((*currentFrame_[3]) != keyFrames_.back()) // has next
-                ++currentFrame_[3];
 
-            currentFrameValid_ = true;
-            splineCacheIsValid_ = false;
-        }
+    Frame KeyFrameInterpolator::evaluate(double time) const {
+        // Assertion: the coefficients are valid (see updateCoefficients()).
+        if (keyFrames_.size() == 1)
+            return Frame(keyFrames_.front()->position(), keyFrames_.front()->orientation());
 
-        // cout << "Time = " << time << " : " << currentFrame_[0]->peekNext()->time() << " , " <<
-        // next(currentFrame_[1])->time() << " , " << next(currentFrame_[2])->time() << " , " <<  currentFrame_[3]->peekNext()->time() << endl;
-    }
+        const std::size_t index = intervalForTime(time);
+        const KeyFrame *kf1 = keyFrames_[index];
+        const KeyFrame *kf2 = keyFrames_[index + 1];
+        const SplineSegment &seg = segments_[index];
 
+        double alpha;
+        const double dt = kf2->time() - kf1->time();
+        if (dt == 0.0)
+            alpha = 0.0;
+        else
+            alpha = (time - kf1->time()) / dt;
+        // clamp, so times outside the path range evaluate to the first/last keyframe
+        if (alpha < 0.0)
+            alpha = 0.0;
+        else if (alpha > 1.0)
+            alpha = 1.0;
 
-    void KeyFrameInterpolator::updateSplineCache() {
-        const vec3 &delta = (*currentFrame_[2])->position() - (*currentFrame_[1])->position();
-        v1 = 3.0 * delta - 2.0 * (*currentFrame_[1])->tgP() - (*currentFrame_[2])->tgP();
-        v2 = -2.0 * delta + (*currentFrame_[1])->tgP() + (*currentFrame_[2])->tgP();
-        splineCacheIsValid_ = true;
+        // Linear interpolation - debug
+        // vec3 pos = alpha*(kf2->position()) + (1.0-alpha)*(kf1->position());
+        const vec3 pos = kf1->position() + alpha * (kf1->tgP() + alpha * (seg.v1 + alpha * seg.v2));
+        const quat q = quat::squad(kf1->orientation(), kf1->tgQ(), kf2->tgQ(), kf2->orientation(), alpha);
+        return Frame(pos, q);
     }
 
 
@@ -417,27 +413,101 @@ namespace easy3d {
         if ((keyFrames_.empty()) || (!frame()))
             return;
 
-        if (!valuesAreValid_)
-            updateModifiedFrameValues();
+        if (!coefficientsAreValid_)
+            updateCoefficients();
+
+        const Frame fr = evaluate(time);
+        vec3 pos = fr.position();
+        quat q = fr.orientation();
+        frame()->setPositionAndOrientationWithConstraint(pos, q);
+    }
 
-        updateCurrentKeyFrameForTime(time);
 
-        if (!splineCacheIsValid_)
-            updateSplineCache();
+    Frame KeyFrameInterpolator::frameAtTime(double time) {
+        if (keyFrames_.empty())
+            return Frame();
 
-        double alpha;
-        const double dt = (*currentFrame_[2])->time() - (*currentFrame_[1])->time();
-        if (dt == 0.0)
-            alpha = 0.0;
-        else
-            alpha = (time - (*currentFrame_[1])->time()) / dt;
+        if (!coefficientsAreValid_)
+            updateCoefficients();
 
-        // Linear interpolation - debug
-        // vec3 pos = alpha*((*currentFrame_[2])->position()) + (1.0-alpha)*((*currentFrame_[1])->position());
-        vec3 pos = (*currentFrame_[1])->position() + alpha * ((*currentFrame_[1])->tgP() + alpha * (v1 + alpha * v2));
-        quat q = quat::squad((*currentFrame_[1])->orientation(), (*currentFrame_[1])->tgQ(),
-                             (*currentFrame_[2])->tgQ(), (*currentFrame_[2])->orientation(), alpha);
-        frame()->setPositionAndOrientationWithConstraint(pos, q);
+        return evaluate(time);
+    }
+
+
+    std::vector<Frame> KeyFrameInterpolator::interpolate() {
+        std::vector<Frame> frames;
+        if (keyFrames_.empty())
+            return frames;
+
+        if (!coefficientsAreValid_)
+            updateCoefficients();
+
+        // the same time step as the timer-driven playback
+        const double step = interpolationSpeed() * interpolationPeriod() / 1000.0;
+        if (step <= 0.0) {
+            LOG(ERROR) << "interpolating the entire path requires a positive time step (speed: "
+                       << interpolationSpeed() << ", period: " << interpolationPeriod() << " ms)";
+            return frames;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(static_cast<std::size_t>(duration() / step) + 2);
+        for (double time = firstTime(); time < lastTime(); time += step)
+            samples.push_back(time);
+        // make sure the last keyframe is reached (as the timer-driven playback does)
+        samples.push_back(lastTime());
+
+        frames.resize(samples.size());
+        if (keyFrames_.size() == 1) {
+            std::fill(frames.begin(), frames.end(),
+                      Frame(keyFrames_.front()->position(), keyFrames_.front()->orientation()));
+            return frames;
+        }
+
+        // The samples are resolved segment by segment: the runs of consecutive samples falling
+        // into the same keyframe interval share their endpoint orientations, so the first two
+        // slerps of the squad construction use the batch kernel (one angle/trigonometry setup
+        // per segment instead of per sample).
+        std::vector<float> ts;
+        std::vector<quat> ab, tg;
+        std::size_t i = 0;
+        while (i < samples.size()) {
+            const std::size_t index = intervalForTime(samples[i]);
+            std::size_t j = i + 1;
+            while (j < samples.size() && intervalForTime(samples[j]) == index)
+                ++j;
+
+            const KeyFrame *kf1 = keyFrames_[index];
+            const KeyFrame *kf2 = keyFrames_[index + 1];
+            const SplineSegment &seg = segments_[index];
+            const double dt = kf2->time() - kf1->time();
+
+            const std::size_t num = j - i;
+            ts.resize(num);
+            for (std::size_t k = 0; k < num; ++k) {
+                double alpha = (dt == 0.0) ? 0.0 : (samples[i + k] - kf1->time()) / dt;
+                // clamp, so times outside the path range evaluate to the first/last keyframe
+                if (alpha < 0.0)
+                    alpha = 0.0;
+                else if (alpha > 1.0)
+                    alpha = 1.0;
+                ts[k] = static_cast<float>(alpha);
+            }
+
+            ab.resize(num);
+            tg.resize(num);
+            quat::slerp(kf1->orientation(), kf2->orientation(), ts.data(), num, ab.data());
+            quat::slerp(kf1->tgQ(), kf2->tgQ(), ts.data(), num, tg.data(), false);
+            for (std::size_t k = 0; k < num; ++k) {
+                const float alpha = ts[k];
+                const vec3 pos = kf1->position() + alpha * (kf1->tgP() + alpha * (seg.v1 + alpha * seg.v2));
+                const quat q = quat::slerp(ab[k], tg[k], 2.0f * alpha * (1.0f - alpha), false);
+                frames[i + k] = Frame(pos, q);
+            }
+
+            i = j;
+        }
+        return frames;
     }
 
 #ifndef DOXYGEN
@@ -307,6 +307,22 @@ namespace easy3d {
          * If you simply want to change interpolationTime() but not the frame() state, use setInterpolationTime()
          * instead.  */
         virtual void interpolateAtTime(double time);
+
+        /*! Returns the Frame the interpolation would produce at time \p time (expressed in
+         * seconds), without modifying interpolationTime() or the frame() state.
+         *
+         * Times outside [firstTime(), lastTime()] evaluate to the first/last keyFrame. This is
+         * meant for code that needs to look ahead along the path while a playback is running,
+         * e.g., prefetching the data that will become visible (see TilePrefetcher). */
+        Frame frameAtTime(double time);
+
+        /*! Interpolates the entire path in one pass and returns the resulting frames.
+         *
+         * The path is sampled with the same time step as the timer-driven playback, i.e.,
+         * interpolationPeriod() * interpolationSpeed() milliseconds, and the last keyFrame is
+         * always included. This is intended for offline uses such as a walkthrough video exporter,
+         * where all the frames are needed at once. The frame() state is not affected. */
+        std::vector<Frame> interpolate();
         //@}
 
         /*! @name Path drawing */
@@ -326,7 +342,7 @@ namespace easy3d {
 
     private:
         virtual void update();
-        virtual void on_frame_modified() { valuesAreValid_ = false; pathIsValid_ = false; splineCacheIsValid_ = false; }
+        virtual void on_frame_modified() { valuesAreValid_ = false; pathIsValid_ = false; coefficientsAreValid_ = false; }
 
     private:
         // Copy constructor and operator= are declared private and undefined
@@ -334,9 +350,13 @@ namespace easy3d {
          KeyFrameInterpolator(const KeyFrameInterpolator& kfi);
          KeyFrameInterpolator& operator=(const KeyFrameInterpolator& kfi);
 
-        void updateCurrentKeyFrameForTime(double time);
         void updateModifiedFrameValues();
-        void updateSplineCache();
+        // precomputes the keyframe time table and the per-interval spline coefficients.
+        void updateCoefficients();
+        // returns the index of the keyframe interval [i, i+1) containing the given time.
+        std::size_t intervalForTime(double time) const;
+        // evaluates the spline at the given time (requires valid coefficients).
+        Frame evaluate(double time) const;
 
     #ifndef DOXYGEN
         // Internal private KeyFrame representation
@@ -358,14 +378,18 @@ namespace easy3d {
             double time_;
         };
 
+        // precomputed Catmull-Rom coefficients of a keyframe interval (see updateCoefficients())
+        struct SplineSegment
+        {
+            vec3 v1, v2;
+        };
+
     #endif
 
         // Key Frames
         mutable std::vector<KeyFrame*> keyFrames_;
         std::vector<Frame> path_;
 
-        std::vector<KeyFrame*>::iterator currentFrame_[4];
-
         // Associated frame
         Frame* frame_;
 
@@ -382,9 +406,11 @@ namespace easy3d {
         // Cached values and flags
         bool pathIsValid_;
         bool valuesAreValid_;
-        bool currentFrameValid_;
-        bool splineCacheIsValid_;
-        vec3 v1, v2;
+        // the keyframe time table and the per-interval spline coefficients, precomputed once per
+        // path edit so sampling only needs a binary interval lookup (see updateCoefficients()).
+        bool coefficientsAreValid_;
+        std::vector<double> times_;
+        std::vector<SplineSegment> segments_;
 
         LinesDrawable* path_drawable_;
         LinesDrawable* cameras_drawable_;
@@ -0,0 +1,273 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/multi_draw_batch.h>
+
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/clipping_plane.h>
+#include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/opengl_info.h>
+#include <easy3d/renderer/setting.h>
+#include <easy3d/renderer/shader_manager.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/renderer/vertex_array_object.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace details {
+
+        // the layout of one glMultiDrawElementsIndirect() command
+        struct DrawElementsIndirectCommand {
+            GLuint count;
+            GLuint instance_count;
+            GLuint first_index;
+            GLuint base_vertex;
+            GLuint base_instance;
+        };
+
+        // appends the full content of 'src' to 'dst' at the given byte offset, entirely on the GPU
+        static void copy_buffer(GLuint src, GLuint dst, std::size_t dst_offset, std::size_t size) {
+            glBindBuffer(GL_COPY_READ_BUFFER, src);             easy3d_debug_log_gl_error;
+            glBindBuffer(GL_COPY_WRITE_BUFFER, dst);            easy3d_debug_log_gl_error;
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0,
+                                static_cast<GLintptr>(dst_offset), static_cast<GLsizeiptr>(size));	easy3d_debug_log_gl_error;
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+    }
+
+
+    MultiDrawBatch::MultiDrawBatch()
+            : vao_(nullptr), vertex_buffer_(0), normal_buffer_(0), element_buffer_(0), indirect_buffer_(0),
+              color_buffer_(0), num_commands_(0), built_(false)
+    {
+        vao_ = new VertexArrayObject;
+    }
+
+
+    MultiDrawBatch::~MultiDrawBatch() {
+        clear();
+        delete vao_;
+    }
+
+
+    bool MultiDrawBatch::is_supported() {
+        return OpenglInfo::is_supported("GL_ARB_multi_draw_indirect") &&
+               OpenglInfo::is_supported("GL_ARB_shader_draw_parameters") &&
+               OpenglInfo::is_supported("GL_ARB_uniform_buffer_object");
+    }
+
+
+    bool MultiDrawBatch::add_drawable(TrianglesDrawable *d) {
+        if (!d || d->vertex_buffer() == 0 || d->normal_buffer() == 0 || d->element_buffer() == 0)
+            return false;
+
+        // the batch shader feeds the per-object color from the uniform buffer; textures and
+        // per-element colors cannot be expressed this way
+        if (d->texture() || d->coloring_method() != State::UNIFORM_COLOR)
+            return false;
+
+        if (drawables_.size() >= capacity())
+            return false;
+
+        if (!drawables_.empty()) {
+            // the first drawable determines the shading state of the whole batch
+            const TrianglesDrawable *ref = drawables_.front();
+            if (d->lighting() != ref->lighting() ||
+                d->lighting_two_sides() != ref->lighting_two_sides() ||
+                d->distinct_back_color() != ref->distinct_back_color() ||
+                d->back_color() != ref->back_color() ||
+                d->smooth_shading() != ref->smooth_shading() ||
+                d->plane_clipping_discard() != ref->plane_clipping_discard() ||
+                d->material().ambient != ref->material().ambient ||
+                d->material().specular != ref->material().specular ||
+                d->material().shininess != ref->material().shininess)
+                return false;
+        }
+
+        drawables_.push_back(d);
+        built_ = false;
+        return true;
+    }
+
+
+    bool MultiDrawBatch::build() {
+        if (!is_supported()) {
+            LOG_FIRST_N(WARNING, 1) << "indirect multi-draw batching not supported on this platform "
+                                       "(GL_ARB_multi_draw_indirect and GL_ARB_shader_draw_parameters required)";
+            return false;
+        }
+        if (drawables_.empty())
+            return false;
+
+        clear_buffers();
+
+        std::size_t total_vertices = 0, total_indices = 0;
+        for (auto d : drawables_) {
+            total_vertices += d->num_vertices();
+            total_indices += d->num_indices();
+        }
+        if (total_vertices == 0 || total_indices == 0)
+            return false;
+
+        // allocate the shared buffers (no data yet) and record the attribute bindings in the VAO
+        bool success = vao_->create_array_buffer(vertex_buffer_, ShaderProgram::POSITION, nullptr,
+                                                 total_vertices * sizeof(vec3), 3);
+        success = success && vao_->create_array_buffer(normal_buffer_, ShaderProgram::NORMAL, nullptr,
+                                                       total_vertices * sizeof(vec3), 3);
+        success = success && vao_->create_element_buffer(element_buffer_, nullptr,
+                                                         total_indices * sizeof(unsigned int));
+        if (!success) {
+            LOG(ERROR) << "failed creating the shared buffers of the batch";
+            clear_buffers();
+            return false;
+        }
+
+        // merge the drawables' buffers (GPU to GPU) and build the indirect commands. The index
+        // values are left untouched: every command carries the base vertex of its drawable.
+        std::vector<details::DrawElementsIndirectCommand> commands(drawables_.size());
+        std::vector<vec4> colors(drawables_.size());
+        std::size_t vertex_offset = 0, index_offset = 0;
+        for (std::size_t i = 0; i < drawables_.size(); ++i) {
+            const TrianglesDrawable *d = drawables_[i];
+            details::copy_buffer(d->vertex_buffer(), vertex_buffer_, vertex_offset * sizeof(vec3),
+                                 d->num_vertices() * sizeof(vec3));
+            details::copy_buffer(d->normal_buffer(), normal_buffer_, vertex_offset * sizeof(vec3),
+                                 d->num_vertices() * sizeof(vec3));
+            details::copy_buffer(d->element_buffer(), element_buffer_, index_offset * sizeof(unsigned int),
+                                 d->num_indices() * sizeof(unsigned int));
+
+            commands[i].count = static_cast<GLuint>(d->num_indices());
+            commands[i].instance_count = 1;
+            commands[i].first_index = static_cast<GLuint>(index_offset);
+            commands[i].base_vertex = static_cast<GLuint>(vertex_offset);
+            commands[i].base_instance = static_cast<GLuint>(i);
+            colors[i] = d->color();
+
+            vertex_offset += d->num_vertices();
+            index_offset += d->num_indices();
+        }
+
+        glGenBuffers(1, &indirect_buffer_);                 easy3d_debug_log_gl_error;
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer_);	easy3d_debug_log_gl_error;
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(details::DrawElementsIndirectCommand),
+                     commands.data(), GL_STATIC_DRAW);      easy3d_debug_log_gl_error;
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+        glGenBuffers(1, &color_buffer_);                    easy3d_debug_log_gl_error;
+        glBindBuffer(GL_UNIFORM_BUFFER, color_buffer_);     easy3d_debug_log_gl_error;
+        glBufferData(GL_UNIFORM_BUFFER, colors.size() * sizeof(vec4), colors.data(), GL_STATIC_DRAW);	easy3d_debug_log_gl_error;
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        num_commands_ = commands.size();
+        built_ = (glGetError() == GL_NO_ERROR);
+        return built_;
+    }
+
+
+    void MultiDrawBatch::draw(const Camera *camera) const {
+        if (!built_ || num_commands_ == 0)
+            return;
+
+        ShaderProgram *program = ShaderManager::get_program("surface/surface_color_batch");
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes;
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"));
+            attributes.emplace_back(ShaderProgram::Attribute(ShaderProgram::NORMAL, "vtx_normal"));
+            program = ShaderManager::create_program_from_files("surface/surface_color_batch", attributes);
+        }
+        if (!program)
+            return;
+
+        // the shading state of the whole batch comes from the first drawable (see add_drawable())
+        const TrianglesDrawable *state = drawables_.front();
+
+        ShaderProgram::FrameBlock frame_block;
+        frame_block.MVP = camera->modelViewProjectionMatrix();
+        frame_block.wCamPos = camera->position();
+        const mat4 &MV = camera->modelViewMatrix();
+        frame_block.wLightPos = vec3(inverse(MV) * setting::light_position);
+
+        program->bind();
+        ShaderProgram::upload_block("FrameBlock", &frame_block, sizeof(frame_block));
+        program->set_uniform("lighting", state->lighting())
+                ->set_uniform("two_sides_lighting", state->lighting_two_sides())
+                ->set_uniform("distinct_back_color", state->distinct_back_color())
+                ->set_uniform("backside_color", state->back_color())
+                ->set_uniform("smooth_shading", state->smooth_shading())
+                ->set_uniform("ssaoEnabled", false)
+                ->set_block_uniform("Material", "ambient", state->material().ambient)
+                ->set_block_uniform("Material", "specular", state->material().specular)
+                ->set_block_uniform("Material", "shininess", &state->material().shininess)
+                ->set_uniform("highlight", false)
+                ->set_uniform("hightlight_id_min", -1)
+                ->set_uniform("hightlight_id_max", -1);
+
+        if (setting::clipping_plane)
+            setting::clipping_plane->set_program(program, state->plane_clipping_discard());
+
+        // the per-object colors, indexed by gl_DrawIDARB in the vertex shader
+        const GLuint block = glGetUniformBlockIndex(program->get_program(), "BatchColors");		easy3d_debug_log_gl_error;
+        if (block != GL_INVALID_INDEX) {
+            glUniformBlockBinding(program->get_program(), block, 1);    easy3d_debug_log_gl_error;
+            glBindBufferBase(GL_UNIFORM_BUFFER, 1, color_buffer_);      easy3d_debug_log_gl_error;
+        }
+
+        vao_->bind();
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer_);         easy3d_debug_log_gl_error;
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer_);        easy3d_debug_log_gl_error;
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr,
+                                    static_cast<GLsizei>(num_commands_), 0);	easy3d_debug_log_gl_error;
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);                       easy3d_debug_log_gl_error;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);                       easy3d_debug_log_gl_error;
+        vao_->release();
+
+        if (block != GL_INVALID_INDEX)
+            glBindBufferBase(GL_UNIFORM_BUFFER, 1, 0);
+
+        program->release();
+    }
+
+
+    void MultiDrawBatch::clear() {
+        drawables_.clear();
+        clear_buffers();
+    }
+
+
+    void MultiDrawBatch::clear_buffers() {
+        VertexArrayObject::release_buffer(vertex_buffer_);
+        VertexArrayObject::release_buffer(normal_buffer_);
+        VertexArrayObject::release_buffer(element_buffer_);
+        VertexArrayObject::release_buffer(indirect_buffer_);
+        VertexArrayObject::release_buffer(color_buffer_);
+        num_commands_ = 0;
+        built_ = false;
+    }
+
+}
@@ -0,0 +1,125 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY_RENDERER_MULTI_DRAW_BATCH_H
+#define EASY_RENDERER_MULTI_DRAW_BATCH_H
+
+#include <cstddef>
+#include <vector>
+
+
+namespace easy3d {
+
+    class Camera;
+    class TrianglesDrawable;
+    class VertexArrayObject;
+
+    /**
+     * \brief Batches triangles drawables that share shading state into a single indirect multi-draw call.
+     * \class MultiDrawBatch easy3d/renderer/multi_draw_batch.h
+     * \details Scenes made of thousands of small component meshes are draw-call bound: every TrianglesDrawable
+     * binds its own buffers, sets its uniforms, and issues its own draw call. A MultiDrawBatch merges the
+     * vertex/normal/element buffers of compatible drawables (same lighting and material state, uniform coloring,
+     * no texture) into shared buffers on the GPU - the data is combined with glCopyBufferSubData and never
+     * round-trips through the CPU - and draws the whole batch with one glMultiDrawElementsIndirect() call.
+     * The per-object colors live in a uniform buffer indexed by the draw id in the batch shader.
+     *
+     * Typical usage:
+     *      \code
+     *          MultiDrawBatch batch;
+     *          for (auto d : drawables) {
+     *              if (!batch.add_drawable(d))
+     *                  ... // draw d individually (incompatible state, or the batch is full)
+     *          }
+     *          batch.build();       // once the drawables' rendering buffers are up to date
+     *          batch.draw(camera);  // every frame, instead of the individual draw calls
+     *      \endcode
+     *
+     * \note Requires GL_ARB_multi_draw_indirect and GL_ARB_shader_draw_parameters; use is_supported() to check
+     *       whether the platform qualifies. The batch references the drawables' GPU buffers only during build(),
+     *       so it must be rebuilt after any of the drawables updates its buffers.
+     */
+
+    class MultiDrawBatch {
+    public:
+        MultiDrawBatch();
+        ~MultiDrawBatch();
+
+        static bool is_supported();
+
+        /// The maximum number of drawables a single batch can hold (bounded by the per-object uniform buffer).
+        static std::size_t capacity() { return 1024; }
+
+        /**
+         * \brief Adds a drawable to the batch.
+         * \details The first drawable added determines the shading state of the batch; subsequent drawables must
+         *        match it. A drawable qualifies only if it uses uniform coloring without a texture and its
+         *        vertex/normal/element buffers exist (i.e., its buffers are up to date).
+         * \return \c false if the drawable cannot be batched (incompatible state, missing buffers, or the batch
+         *        is full), in which case it should be drawn individually.
+         */
+        bool add_drawable(TrianglesDrawable *d);
+
+        /// The number of drawables currently in the batch.
+        std::size_t num_drawables() const { return drawables_.size(); }
+
+        /**
+         * \brief Merges the buffers of the added drawables and builds the indirect-command and per-object color
+         *        buffers. Must be called (again) whenever a batched drawable has updated its rendering buffers.
+         * \return \c true on success.
+         */
+        bool build();
+
+        /// \brief Draws the whole batch with a single indirect multi-draw call.
+        void draw(const Camera *camera) const;
+
+        /// \brief Removes all drawables from the batch and releases the shared buffers.
+        void clear();
+
+    private:
+        // releases the shared GPU buffers (keeps the list of drawables)
+        void clear_buffers();
+
+    private:
+        std::vector<TrianglesDrawable *> drawables_;
+
+        VertexArrayObject *vao_;
+        unsigned int vertex_buffer_;
+        unsigned int normal_buffer_;
+        unsigned int element_buffer_;
+        unsigned int indirect_buffer_;
+        unsigned int color_buffer_;     // the per-object colors (a uniform buffer indexed by the draw id)
+
+        std::size_t num_commands_;
+        bool built_;
+
+    private:
+        //copying disabled
+        MultiDrawBatch(const MultiDrawBatch&);
+        MultiDrawBatch& operator=(const MultiDrawBatch&);
+    };
+
+}
+
+#endif  // EASY_RENDERER_MULTI_DRAW_BATCH_H
@@ -0,0 +1,186 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/occlusion_culling.h>
+
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/opengl_info.h>
+#include <easy3d/renderer/shader_manager.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    OcclusionCulling::OcclusionCulling()
+            : proxy_(nullptr), num_culled_(0) {
+    }
+
+
+    OcclusionCulling::~OcclusionCulling() {
+        clear();
+    }
+
+
+    bool OcclusionCulling::is_supported() {
+        return OpenglInfo::is_supported("GL_ARB_occlusion_query2");
+    }
+
+
+    void OcclusionCulling::draw(Drawable *drawable, const Camera *camera) {
+        if (!is_supported()) {
+            drawable->draw(camera, false);
+            return;
+        }
+
+        QueryState &state = states_[drawable];
+        if (state.query == 0) {
+            glGenQueries(1, &state.query);
+            easy3d_debug_log_gl_error;
+            state.visible = true;   // drawables start visible; the first frame settles the state
+            state.pending = false;
+        }
+
+        // harvest the previous result without blocking (this is the one-frame latency)
+        if (state.pending) {
+            GLuint available = 0;
+            glGetQueryObjectuiv(state.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            easy3d_debug_log_gl_error;
+            if (available) {
+                GLuint passed = 0;
+                glGetQueryObjectuiv(state.query, GL_QUERY_RESULT, &passed);
+                easy3d_debug_log_gl_error;
+                state.visible = (passed != 0);
+                state.pending = false;
+            }
+        }
+
+        if (state.pending) {
+            // the query is still in flight: draw by the last known state, don't issue a new one
+            if (state.visible)
+                drawable->draw(camera, false);
+            else
+                ++num_culled_;
+            return;
+        }
+
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, state.query);
+        easy3d_debug_log_gl_error;
+        if (state.visible)
+            drawable->draw(camera, false);
+        else {
+            // skip the geometry; its bounding box keeps probing until the drawable reappears
+            draw_proxy(drawable->bounding_box(), camera);
+            ++num_culled_;
+        }
+        glEndQuery(GL_ANY_SAMPLES_PASSED);
+        easy3d_debug_log_gl_error;
+        state.pending = true;
+    }
+
+
+    std::size_t OcclusionCulling::num_culled() {
+        const std::size_t count = num_culled_;
+        num_culled_ = 0;
+        return count;
+    }
+
+
+    void OcclusionCulling::forget(const Drawable *drawable) {
+        auto pos = states_.find(drawable);
+        if (pos != states_.end()) {
+            glDeleteQueries(1, &pos->second.query);
+            easy3d_debug_log_gl_error;
+            states_.erase(pos);
+        }
+    }
+
+
+    void OcclusionCulling::clear() {
+        for (auto &state : states_) {
+            glDeleteQueries(1, &state.second.query);
+            easy3d_debug_log_gl_error;
+        }
+        states_.clear();
+
+        delete proxy_;
+        proxy_ = nullptr;
+    }
+
+
+    void OcclusionCulling::draw_proxy(const Box3 &box, const Camera *camera) {
+        if (!box.is_valid())
+            return;
+
+        ShaderProgram *program = ShaderManager::get_program("selection/selection_single_primitive");
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes;
+            attributes.push_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"));
+            program = ShaderManager::create_program_from_files("selection/selection_single_primitive", attributes);
+        }
+        if (!program) {
+            LOG_FIRST_N(ERROR, 1) << "shader program not available, occlusion proxy not drawn (this is the first record)";
+            return;
+        }
+
+        if (!proxy_) {
+            proxy_ = new TrianglesDrawable("occlusion_proxy");
+            // the 12 triangles of a box, wound to face outward
+            static const unsigned int box_indices[] = {
+                    0, 2, 1, 1, 2, 3,   // x min
+                    4, 5, 6, 5, 7, 6,   // x max
+                    0, 1, 4, 1, 5, 4,   // y min
+                    2, 6, 3, 3, 6, 7,   // y max
+                    0, 4, 2, 2, 4, 6,   // z min
+                    1, 3, 5, 3, 7, 5    // z max
+            };
+            proxy_->update_element_buffer(std::vector<unsigned int>(box_indices, box_indices + 36));
+        }
+
+        std::vector<vec3> corners(8);
+        for (int i = 0; i < 8; ++i) {
+            corners[i] = vec3(i & 4 ? box.max(0) : box.min(0),
+                              i & 2 ? box.max(1) : box.min(1),
+                              i & 1 ? box.max(2) : box.min(2));
+        }
+        proxy_->update_vertex_buffer(corners);
+
+        // the proxy feeds the query only: no color or depth writes
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthMask(GL_FALSE);
+
+        program->bind();
+        program->set_uniform("MVP", camera->modelViewProjectionMatrix());
+        proxy_->gl_draw(false);
+        program->release();
+        easy3d_debug_log_gl_error;
+
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+    }
+
+}
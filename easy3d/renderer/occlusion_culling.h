@@ -0,0 +1,101 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_OCCLUSION_CULLING_H
+#define EASY3D_RENDERER_OCCLUSION_CULLING_H
+
+#include <unordered_map>
+
+#include <easy3d/core/types.h>
+
+
+namespace easy3d {
+
+    class Camera;
+    class Drawable;
+    class TrianglesDrawable;
+
+    /**
+     * \brief Hardware occlusion culling: skips drawables that were hidden by closer geometry last frame.
+     * \class OcclusionCulling easy3d/renderer/occlusion_culling.h
+     * \details Every drawable routed through draw() carries a GL_ANY_SAMPLES_PASSED occlusion query.
+     * A drawable that produced no visible samples (e.g., a room behind a wall in an indoor scan) is not
+     * rendered; instead, its bounding box is rasterized - without touching the color or depth buffer -
+     * under the same query, so the drawable pops back the frame after it becomes visible again. Query
+     * results are read without blocking, so the scheme costs no synchronization and tolerates one frame
+     * of latency: a drawable may be drawn (or skipped) one frame late, which is invisible in practice.
+     *
+     * Typical usage, replacing the plain draw calls of an occlusion-heavy scene:
+     *      \code
+     *          for (auto d : drawables)    // roughly front to back for the best culling rate
+     *              culling.draw(d, camera);
+     *      \endcode
+     *
+     * \note Drawables must be routed through the same OcclusionCulling instance every frame (the query
+     *       history is per drawable). When a drawable is deleted, call forget() with it.
+     */
+
+    class OcclusionCulling {
+    public:
+        OcclusionCulling();
+        ~OcclusionCulling();
+
+        static bool is_supported();
+
+        /// \brief Draws \p drawable with occlusion testing, or its bounding box proxy if it was occluded.
+        void draw(Drawable *drawable, const Camera *camera);
+
+        /// The number of drawables skipped (found occluded) since the last call of this function.
+        std::size_t num_culled();
+
+        /// \brief Discards the query history of \p drawable. Must be called when the drawable is deleted.
+        void forget(const Drawable *drawable);
+
+        /// \brief Discards all query history and releases the GPU queries and the proxy.
+        void clear();
+
+    private:
+        // rasterizes the bounding box without color/depth writes, to feed the occlusion query
+        void draw_proxy(const Box3 &box, const Camera *camera);
+
+    private:
+        struct QueryState {
+            unsigned int query;
+            bool visible;   // the last known result; drawables start visible
+            bool pending;   // a query is in flight, its result not yet available
+        };
+
+        std::unordered_map<const Drawable *, QueryState> states_;
+        TrianglesDrawable *proxy_;
+        std::size_t num_culled_;
+
+    private:
+        //copying disabled
+        OcclusionCulling(const OcclusionCulling&);
+        OcclusionCulling& operator=(const OcclusionCulling&);
+    };
+
+}
+
+#endif  // EASY3D_RENDERER_OCCLUSION_CULLING_H
@@ -65,7 +65,13 @@ namespace easy3d {
         }
 
 
+        // whether the KHR_debug message callback has been installed (see setup_gl_debug_callback()).
+        static bool debug_callback_active_ = false;
+
+
         bool check_gl_error(const std::string& file, const std::string& function, int line) {
+            if (debug_callback_active_) // the callback already reports errors as they occur
+                return true;
             GLenum error_code = glGetError();
             if (error_code != GL_NO_ERROR) {
                 const std::string& msg = gl_error_string(error_code);
@@ -81,6 +87,8 @@ namespace easy3d {
         }
 
         bool gl_error(std::string& log) {
+            if (debug_callback_active_) // the callback already reports errors as they occur
+                return true;
             GLenum error_code = glGetError();
             if (error_code != GL_NO_ERROR) {
                 const char* str = gl_error_string(error_code);
@@ -224,30 +232,40 @@ namespace easy3d {
                 switch (severity)
                 {
                 case GL_DEBUG_SEVERITY_HIGH:
-                    printf("debug : High - %s - %s : %s\n", strSource.c_str(), strType.c_str(), message);
+                    LOG(ERROR) << "GL debug (High - " << strSource << " - " << strType << "): " << message;
                     break;
                 case GL_DEBUG_SEVERITY_MEDIUM:
-                    printf("debug : Medium - %s - %s : %s\n", strSource.c_str(), strType.c_str(), message);
+                    LOG(WARNING) << "GL debug (Medium - " << strSource << " - " << strType << "): " << message;
                     break;
                 case GL_DEBUG_SEVERITY_LOW:
-                    printf("debug : Low - %s - %s : %s\n", strSource.c_str(), strType.c_str(), message);
+                    LOG(INFO) << "GL debug (Low - " << strSource << " - " << strType << "): " << message;
                     break;
                 default:
-                    printf("debug : comment - %s - %s : %s\n", strSource.c_str(), strType.c_str(), message);
+                    LOG(INFO) << "GL debug (Comment - " << strSource << " - " << strType << "): " << message;
                     break;
                 }
             }
         }
 
 
-        void setup_gl_debug_callback() {
+        bool setup_gl_debug_callback() {
             // glDebugMessageCallback requires OpenGL >= 4.3
             if (glDebugMessageCallback) {
                 glEnable(GL_DEBUG_OUTPUT);
                 glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
                 glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
                 glDebugMessageCallback(opengl_debug_callback, nullptr);  // no user data
+                debug_callback_active_ = true;
             }
+            else {
+                LOG_FIRST_N(WARNING, 1) << "the GL debug message callback requires OpenGL >= 4.3 (not supported by this context)";
+            }
+            return debug_callback_active_;
+        }
+
+
+        bool gl_debug_callback_active() {
+            return debug_callback_active_;
         }
 
     }
@@ -32,6 +32,20 @@
 namespace easy3d {
 
 
+// All the checks below poll the GL error state via glGetError(), and each query forces a
+// pipeline synchronization. Define EASY3D_DISABLE_GL_CHECKS (a CMake option, see the root
+// CMakeLists.txt) to compile them out entirely, e.g., for profiling or performance-critical
+// release builds. For rich diagnostics without any polling, enable the KHR_debug message
+// callback instead (see setup_gl_debug_callback() below and setting::gl_debug_output).
+#ifdef EASY3D_DISABLE_GL_CHECKS
+
+#define easy3d_gl_error
+#define easy3d_frame_buffer_error
+#define easy3d_log_gl_error
+#define easy3d_log_frame_buffer_error
+
+#else
+
 #define easy3d_gl_error {                                                   \
     opengl::check_gl_error(__FILE__, __FUNCTION__, __LINE__) ;              \
 }
@@ -58,6 +72,8 @@ namespace easy3d {
     << "\tinfo: " << log;                                                   \
 }
 
+#endif  // EASY3D_DISABLE_GL_CHECKS
+
 
 #ifndef NDEBUG
 #define easy3d_debug_gl_error				easy3d_gl_error
@@ -84,7 +100,15 @@ namespace easy3d {
         bool gl_error(std::string& log);
         bool frame_buffer_error(std::string& log);
 
-        void setup_gl_debug_callback();
+        // Installs the KHR_debug message callback (requires OpenGL >= 4.3), so the driver reports
+        // errors and performance warnings through the logger as they occur - no polling involved.
+        // While the callback is active, check_gl_error() and gl_error() return immediately without
+        // querying the GL error state (the callback already reported everything).
+        // returns false if the context does not support the callback.
+        bool setup_gl_debug_callback();
+
+        // Returns true if the KHR_debug message callback has been installed on this context.
+        bool gl_debug_callback_active();
 
     }
 
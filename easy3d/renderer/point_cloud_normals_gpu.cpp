@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/point_cloud_normals_gpu.h>
+
+#include <easy3d/core/point_cloud.h>
+#include <easy3d/kdtree/kdtree_search_nanoflann.h>
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/opengl_info.h>
+#include <easy3d/renderer/shader_manager.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/renderer/vertex_array_object.h>
+#include <easy3d/util/logging.h>
+#include <easy3d/util/stop_watch.h>
+
+
+namespace easy3d {
+
+    bool PointCloudNormalsGPU::is_supported() {
+        return OpenglInfo::is_supported("GL_VERSION_4_3") ||
+               (OpenglInfo::is_supported("GL_ARB_compute_shader") &&
+                OpenglInfo::is_supported("GL_ARB_shader_storage_buffer_object"));
+    }
+
+
+    bool PointCloudNormalsGPU::estimate(PointCloud *cloud, unsigned int k /* = 16 */,
+                                        bool compute_curvature /* = false */) const {
+        if (!cloud) {
+            LOG(ERROR) << "empty input point cloud";
+            return false;
+        }
+
+        if (!is_supported()) {
+            LOG(WARNING) << "compute shaders not supported on this platform (OpenGL >= 4.3 required)";
+            return false;
+        }
+
+        ShaderProgram* program = ShaderManager::get_program("compute/normal_estimation");
+        if (!program)
+            program = ShaderManager::create_compute_program_from_file("compute/normal_estimation");
+        if (!program)
+            return false;
+
+        const std::vector<vec3>& points = cloud->points();
+        const std::size_t num = points.size();
+        if (num == 0)
+            return false;
+
+        StopWatch w;
+        w.start();
+
+        LOG(INFO) << "building kd_tree and collecting neighborhoods...";
+        KdTreeSearch_NanoFLANN kdtree;
+        kdtree.begin();
+        kdtree.add_point_cloud(cloud);
+        kdtree.end();
+
+        std::vector<int> neighbors(num * k);
+        kdtree.find_closest_k_points(points.data(), num, static_cast<int>(k), neighbors.data());
+        LOG(INFO) << "done. " << w.time_string();
+
+        w.restart();
+        LOG(INFO) << "estimating normals on the GPU...";
+
+        std::vector<vec3>& normals = cloud->vertex_property<vec3>("v:normal").vector();
+        std::vector<float>* curvatures = nullptr;
+        if (compute_curvature)
+            curvatures = &(cloud->vertex_property<float>("v:curvature").vector());
+
+        VertexArrayObject vao;
+        GLuint points_buffer = 0, neighbors_buffer = 0, normals_buffer = 0, curvatures_buffer = 0;
+        bool success =
+                vao.create_storage_buffer(points_buffer, 0, points.data(), num * sizeof(vec3)) &&
+                vao.create_storage_buffer(neighbors_buffer, 1, neighbors.data(), neighbors.size() * sizeof(int)) &&
+                vao.create_storage_buffer(normals_buffer, 2, nullptr, num * sizeof(vec3)) &&
+                // always allocated (the shader declares the block), but written only when requested
+                vao.create_storage_buffer(curvatures_buffer, 3, nullptr, num * sizeof(float));
+
+        if (success) {
+            program->bind();
+            program->set_uniform("num_points", static_cast<unsigned int>(num));
+            program->set_uniform("k", static_cast<int>(k));
+            program->set_uniform("with_curvature", compute_curvature);
+            glDispatchCompute(static_cast<GLuint>((num + 63) / 64), 1, 1);  easy3d_debug_log_gl_error;
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);                 easy3d_debug_log_gl_error;
+            program->release();
+
+            vao.get_buffer_data(GL_SHADER_STORAGE_BUFFER, normals_buffer, 0,
+                                static_cast<GLsizeiptr>(num * sizeof(vec3)), normals.data());
+            if (compute_curvature)
+                vao.get_buffer_data(GL_SHADER_STORAGE_BUFFER, curvatures_buffer, 0,
+                                    static_cast<GLsizeiptr>(num * sizeof(float)), curvatures->data());
+        }
+
+        VertexArrayObject::release_buffer(points_buffer);
+        VertexArrayObject::release_buffer(neighbors_buffer);
+        VertexArrayObject::release_buffer(normals_buffer);
+        VertexArrayObject::release_buffer(curvatures_buffer);
+
+        LOG_IF(INFO, success) << "done. " << w.time_string();
+        return success;
+    }
+
+} // namespace easy3d
@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_POINT_CLOUD_NORMALS_GPU_H
+#define EASY3D_RENDERER_POINT_CLOUD_NORMALS_GPU_H
+
+
+namespace easy3d {
+
+    class PointCloud;
+
+    /**
+     * \brief Estimates the normals of a point cloud using an OpenGL compute shader.
+     * \class PointCloudNormalsGPU easy3d/renderer/point_cloud_normals_gpu.h
+     * \details The GPU counterpart of PointCloudNormals (in easy3d/algo/point_cloud_normals.h). The k
+     *      nearest neighbors of every point are collected on the CPU (using a kd-tree, which a compute
+     *      shader cannot traverse efficiently); the per-point covariance accumulation and eigen
+     *      decomposition - where most of the time goes - run on the GPU. Points and neighbor indices are
+     *      uploaded to shader storage buffers and the results are read back into the "v:normal" (and
+     *      optionally "v:curvature") vertex property.
+     *      This class lives in the renderer module (instead of next to PointCloudNormals in algo)
+     *      because it needs the OpenGL wrappers and algo does not depend on renderer.
+     * \attention Requires OpenGL 4.3 (compute shaders and shader storage buffer objects) and a valid,
+     *      current OpenGL context, i.e., it must be called from the thread owning the context (e.g.,
+     *      within the viewer).
+     */
+    class PointCloudNormalsGPU {
+    public:
+        /// \brief Queries if the required OpenGL features (compute shaders and shader storage buffer
+        ///        objects) are available.
+        static bool is_supported();
+
+        /**
+         * \brief Estimates the point cloud normals. The results are stored in the "v:normal" vertex
+         *        property.
+         * \param cloud The input point cloud.
+         * \param k The number of neighboring points to construct the covariance matrix.
+         * \param compute_curvature Also computes the curvatures, stored in the "v:curvature" vertex
+         *        property.
+         */
+        bool estimate(PointCloud* cloud, unsigned int k = 16, bool compute_curvature = false) const;
+    };
+
+} // namespace easy3d
+
+
+#endif  // EASY3D_RENDERER_POINT_CLOUD_NORMALS_GPU_H
@@ -30,6 +30,8 @@
 #include <easy3d/renderer/opengl.h>
 #include <easy3d/algo/tessellator.h>
 
+#include <cstring>
+
 
 namespace easy3d {
 
@@ -855,6 +857,184 @@ namespace easy3d {
         }
 
 
+        //------  instanced rendering of unit primitives -----
+
+        // a unit primitive mesh cached in GPU buffers, with a streaming per-instance buffer
+        struct InstancedPrimitive {
+            InstancedPrimitive() : vao(0), vertex_buffer(0), normal_buffer(0), instance_buffer(0),
+                                   num_vertices(0) {}
+            GLuint vao;
+            GLuint vertex_buffer;
+            GLuint normal_buffer;
+            GLuint instance_buffer;
+            int num_vertices;
+        };
+
+        // each instance occupies 19 floats in the instance buffer: a mat4 followed by a color
+        static const GLsizei instance_stride = sizeof(float) * 19;
+
+
+        static ShaderProgram* instanced_program() {
+            const std::string name = "primitives/primitives_instanced_color";
+            auto program = ShaderManager::get_program(name);
+            if (!program) {
+                std::vector<ShaderProgram::Attribute> attributes = {
+                        ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"),
+                        ShaderProgram::Attribute(ShaderProgram::NORMAL, "vtx_normal")
+                };
+                program = ShaderManager::create_program_from_files(name, attributes);
+            }
+            if (!program) {
+                LOG_FIRST_N(ERROR, 1) << "shader doesn't exist: " << name << " (this is the first record)";
+            }
+            return program;
+        }
+
+
+        // tessellates the unit primitive into its cached GPU buffers (done only once)
+        static void setup_instanced_primitive(InstancedPrimitive& prim, ShaderProgram* program,
+                                              const std::vector<vec3>& points, const std::vector<vec3>& normals) {
+            glGenVertexArrays(1, &prim.vao);    easy3d_debug_log_gl_error;
+            glBindVertexArray(prim.vao);        easy3d_debug_log_gl_error;
+
+            glGenBuffers(1, &prim.vertex_buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, prim.vertex_buffer);
+            glBufferData(GL_ARRAY_BUFFER, points.size() * sizeof(vec3), points.data(), GL_STATIC_DRAW);
+            glEnableVertexAttribArray(ShaderProgram::POSITION);
+            glVertexAttribPointer(ShaderProgram::POSITION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+            easy3d_debug_log_gl_error;
+
+            glGenBuffers(1, &prim.normal_buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, prim.normal_buffer);
+            glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(vec3), normals.data(), GL_STATIC_DRAW);
+            glEnableVertexAttribArray(ShaderProgram::NORMAL);
+            glVertexAttribPointer(ShaderProgram::NORMAL, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+            easy3d_debug_log_gl_error;
+
+            // the per-instance transformation and color, interleaved in one streaming buffer. A
+            // mat4 attribute occupies 4 consecutive attribute slots (one per column); the divisor
+            // makes the attributes advance per instance instead of per vertex.
+            glGenBuffers(1, &prim.instance_buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, prim.instance_buffer);
+            const int loc_matrix = program->get_attribute_location("instance_matrix");
+            for (int i = 0; i < 4; ++i) {
+                glEnableVertexAttribArray(loc_matrix + i);
+                glVertexAttribPointer(loc_matrix + i, 4, GL_FLOAT, GL_FALSE, instance_stride,
+                                      reinterpret_cast<void*>(sizeof(float) * 4 * i));
+                glVertexAttribDivisor(loc_matrix + i, 1);
+            }
+            const int loc_color = program->get_attribute_location("instance_color");
+            glEnableVertexAttribArray(loc_color);
+            glVertexAttribPointer(loc_color, 3, GL_FLOAT, GL_FALSE, instance_stride,
+                                  reinterpret_cast<void*>(sizeof(float) * 16));
+            glVertexAttribDivisor(loc_color, 1);
+            easy3d_debug_log_gl_error;
+
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindVertexArray(0);
+            prim.num_vertices = static_cast<int>(points.size());
+        }
+
+
+        static void draw_instanced_primitive(InstancedPrimitive& prim, ShaderProgram* program,
+                                             const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                             const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos) {
+            if (transforms.size() != colors.size()) {
+                LOG(ERROR) << "numbers of transforms (" << transforms.size() << ") and colors ("
+                           << colors.size() << ") do not match";
+                return;
+            }
+            if (transforms.empty())
+                return;
+
+            // pack and upload the instance data (the matrices are column-major, as the shader expects)
+            std::vector<float> data(transforms.size() * 19);
+            float* p = data.data();
+            for (std::size_t i = 0; i < transforms.size(); ++i) {
+                std::memcpy(p, static_cast<const float*>(transforms[i]), sizeof(float) * 16);
+                std::memcpy(p + 16, colors[i].data(), sizeof(float) * 3);
+                p += 19;
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, prim.instance_buffer);    easy3d_debug_log_gl_error;
+            glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_STREAM_DRAW);    easy3d_debug_log_gl_error;
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            program->bind();    easy3d_debug_log_gl_error;
+            program->set_uniform("MVP", MVP);
+            program->set_uniform("wLightPos", wLightPos);
+            program->set_uniform("wCamPos", wCamPos);
+            glBindVertexArray(prim.vao);    easy3d_debug_log_gl_error;
+            glDrawArraysInstanced(GL_TRIANGLES, 0, prim.num_vertices, static_cast<GLsizei>(transforms.size()));
+            easy3d_debug_log_gl_error;
+            glBindVertexArray(0);
+            program->release();
+        }
+
+
+        void draw_spheres_instanced(const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                    const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos) {
+            ShaderProgram* program = instanced_program();
+            if (!program)
+                return;
+
+            static InstancedPrimitive prim;
+            if (prim.vao == 0) {
+                std::vector<vec3> points, normals, tmp;
+                prepare_sphere(vec3(0, 0, 0), 1.0, 30, 20, vec3(1, 1, 1), points, normals, tmp);
+                setup_instanced_primitive(prim, program, points, normals);
+            }
+            draw_instanced_primitive(prim, program, transforms, colors, MVP, wLightPos, wCamPos);
+        }
+
+
+        void draw_cylinders_instanced(const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                      const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos) {
+            ShaderProgram* program = instanced_program();
+            if (!program)
+                return;
+
+            static InstancedPrimitive prim;
+            if (prim.vao == 0) {
+                std::vector<vec3> points, normals, tmp;
+                prepare_cylinder(1.0, 30, vec3(0, 0, 0), vec3(0, 0, 1), vec3(1, 1, 1), points, normals, tmp);
+                setup_instanced_primitive(prim, program, points, normals);
+            }
+            draw_instanced_primitive(prim, program, transforms, colors, MVP, wLightPos, wCamPos);
+        }
+
+
+        void draw_cones_instanced(const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                  const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos) {
+            ShaderProgram* program = instanced_program();
+            if (!program)
+                return;
+
+            static InstancedPrimitive prim;
+            if (prim.vao == 0) {
+                std::vector<vec3> points, normals, tmp;
+                prepare_cone(1.0, 30, vec3(0, 0, 0), vec3(0, 0, 1), vec3(1, 1, 1), points, normals, tmp);
+                setup_instanced_primitive(prim, program, points, normals);
+            }
+            draw_instanced_primitive(prim, program, transforms, colors, MVP, wLightPos, wCamPos);
+        }
+
+
+        void draw_tori_instanced(const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                 const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos) {
+            ShaderProgram* program = instanced_program();
+            if (!program)
+                return;
+
+            static InstancedPrimitive prim;
+            if (prim.vao == 0) {
+                std::vector<vec3> points, normals;
+                prepare_torus(1.0, 0.25, 50, 20, points, normals);
+                setup_instanced_primitive(prim, program, points, normals);
+            }
+            draw_instanced_primitive(prim, program, transforms, colors, MVP, wLightPos, wCamPos);
+        }
+
+
     }
 
 } // namespace easy3d
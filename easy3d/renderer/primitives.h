@@ -196,6 +196,52 @@ namespace easy3d {
          * \param hw_ratio The aspect ratio of the base quad defined as height/width (default 0.6).
          */
         void prepare_camera(std::vector<vec3>& points, float size, float hw_ratio = 0.6f);
+
+        //------  The following functions draw many copies of a unit primitive in a single draw call -----
+
+        /**
+         * @brief Draws a set of spheres using instanced rendering.
+         * \details The unit sphere (centered at the origin, radius 1) is tessellated only once and
+         *      cached in GPU buffers. Each instance carries its own transformation and color in a
+         *      per-instance buffer, so the whole set costs one buffer upload and one draw call,
+         *      instead of one tessellation and upload per sphere (as prepare_sphere() would).
+         *      This is the method of choice for drawing large numbers of identical primitives,
+         *      e.g., vertex/edge imposters and manipulator gizmos.
+         * @param transforms The transformation of each instance, mapping the unit primitive to its
+         *      pose. It is assumed to be composed of translations, rotations, and uniform scalings
+         *      (the normals are transformed by the upper-left 3x3 part).
+         * @param colors The color of each instance. Must have the same size as \p transforms.
+         * @param MVP The model-view-projection matrix of the camera.
+         * @param wLightPos The position of the light source, in the world coordinate system.
+         * @param wCamPos The position of the camera, in the world coordinate system.
+         */
+        void draw_spheres_instanced(const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                    const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos);
+
+        /**
+         * @brief Draws a set of cylinders using instanced rendering.
+         * \details The same as draw_spheres_instanced(), but for the unit cylinder (radius 1,
+         *      axis along +Z, from z = 0 to z = 1).
+         */
+        void draw_cylinders_instanced(const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                      const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos);
+
+        /**
+         * @brief Draws a set of cones using instanced rendering.
+         * \details The same as draw_spheres_instanced(), but for the unit cone (base radius 1 at
+         *      z = 0, apex at z = 1).
+         */
+        void draw_cones_instanced(const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                  const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos);
+
+        /**
+         * @brief Draws a set of tori using instanced rendering.
+         * \details The same as draw_spheres_instanced(), but for the unit torus (major radius 1,
+         *      minor radius 0.25, lying in the XOY plane). Note that the tube ratio is fixed: a
+         *      per-instance transformation can scale the torus, but not change the ratio.
+         */
+        void draw_tori_instanced(const std::vector<mat4>& transforms, const std::vector<vec3>& colors,
+                                 const mat4& MVP, const vec3& wLightPos, const vec3& wCamPos);
     }
 
 }
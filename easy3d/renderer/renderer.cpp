@@ -300,6 +300,18 @@ namespace easy3d {
     }
 
 
+    void Renderer::update_geometry() {
+        model_->invalidate_bounding_box();
+
+        for (auto d : points_drawables_)
+            d->update_geometry();
+        for (auto d : lines_drawables_)
+            d->update_geometry();
+        for (auto d : triangles_drawables_)
+            d->update_geometry();
+    }
+
+
     PointsDrawable* Renderer::get_points_drawable(const std::string& name) const {
         for (auto d : points_drawables_) {
             if (d->name() == name)
@@ -85,6 +85,16 @@ namespace easy3d {
          */
         void update();
 
+        /**
+         * @brief Invalidate only the vertex geometry of the rendering buffers.
+         * @details Use this instead of update() when vertex positions changed but the connectivity did not
+         *      (deformation, smoothing preview): positions and normals are re-uploaded while index buffers and
+         *      cached tessellations are kept, which makes per-iteration previews much cheaper on large meshes.
+         *      Drawables whose buffers cannot be refreshed this way fall back to a full update automatically.
+         * @attention Use update() whenever the connectivity or the number of vertices has changed.
+         */
+        void update_geometry();
+
         //-------------------- drawable management  -----------------------
 
         /**
@@ -0,0 +1,121 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/scalar_field_playback.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <easy3d/core/types.h>
+#include <easy3d/renderer/drawable.h>
+#include <easy3d/renderer/shader_program.h>
+#include <easy3d/renderer/vertex_array_object.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+
+    ScalarFieldPlayback::ScalarFieldPlayback(Drawable *drawable)
+            : drawable_(drawable), buffer_(0), num_values_(0), num_steps_(0), current_step_(0) {
+    }
+
+
+    ScalarFieldPlayback::~ScalarFieldPlayback() {
+        VertexArrayObject::release_buffer(buffer_);
+    }
+
+
+    bool ScalarFieldPlayback::upload(const std::vector< std::vector<float> > &steps) {
+        if (!drawable_ || !drawable_->vao()) {
+            LOG(ERROR) << "drawable does not exist or has no vertex array object";
+            return false;
+        }
+        if (steps.empty() || steps[0].empty()) {
+            LOG(ERROR) << "no time steps to upload";
+            return false;
+        }
+        const std::size_t num = steps[0].size();
+        for (const auto &step : steps) {
+            if (step.size() != num) {
+                LOG(ERROR) << "all time steps must have the same number of values";
+                return false;
+            }
+        }
+
+        // one global range, so the colors of the different time steps are comparable
+        float min_value = std::numeric_limits<float>::max();
+        float max_value = -std::numeric_limits<float>::max();
+        for (const auto &step : steps) {
+            for (auto value : step) {
+                min_value = std::min(min_value, value);
+                max_value = std::max(max_value, value);
+            }
+        }
+        const float range = (max_value > min_value) ? (max_value - min_value) : 1.0f;
+
+        std::vector<vec2> d_texcoords(steps.size() * num);
+        for (std::size_t i = 0; i < steps.size(); ++i) {
+            const std::vector<float> &step = steps[i];
+            vec2 *coords = d_texcoords.data() + i * num;
+            for (std::size_t j = 0; j < num; ++j)
+                coords[j] = vec2((step[j] - min_value) / range, 0.5f);
+        }
+
+        // a single upload; afterwards set_step() only moves the attribute pointer within the buffer
+        if (!drawable_->vao()->create_array_buffer(buffer_, ShaderProgram::TEXCOORD, d_texcoords.data(),
+                                                   d_texcoords.size() * sizeof(vec2), 2)) {
+            LOG(ERROR) << "failed uploading the time steps";
+            return false;
+        }
+
+        num_values_ = num;
+        num_steps_ = steps.size();
+        current_step_ = 0;
+        return true;
+    }
+
+
+    void ScalarFieldPlayback::set_step(std::size_t step) {
+        if (buffer_ == 0) {
+            LOG_FIRST_N(ERROR, 1) << "no time steps uploaded (upload() not called or failed?)";
+            return;
+        }
+        if (step >= num_steps_) {
+            LOG_FIRST_N(ERROR, 1) << "time step " << step << " out of range (only " << num_steps_ << " steps)";
+            return;
+        }
+
+        if (drawable_->vao()->set_array_buffer_offset(buffer_, ShaderProgram::TEXCOORD,
+                                                      step * num_values_ * sizeof(vec2), 2))
+            current_step_ = step;
+    }
+
+
+    void ScalarFieldPlayback::next_step() {
+        if (num_steps_ > 0)
+            set_step((current_step_ + 1) % num_steps_);
+    }
+
+}
@@ -0,0 +1,109 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_SCALAR_FIELD_PLAYBACK_H
+#define EASY3D_RENDERER_SCALAR_FIELD_PLAYBACK_H
+
+#include <cstddef>
+#include <vector>
+
+
+namespace easy3d {
+
+    class Drawable;
+
+    /**
+     * \brief Playback of time-varying scalar fields on a drawable.
+     *
+     * \class ScalarFieldPlayback easy3d/renderer/scalar_field_playback.h
+     *
+     * \details Visualizing simulation results (one scalar per vertex per time step) by calling
+     *      buffers::update() with a different field every step regenerates and re-uploads the full
+     *      buffers, which limits the playback to a few frames per second on large models. This class
+     *      instead uploads the texture coordinates of all time steps into a single vertex buffer
+     *      once. Selecting a time step then merely rebinds the texture-coordinate attribute of the
+     *      drawable to the offset of that step within the buffer - no data leaves the CPU, so the
+     *      animation runs at display rate and can be driven from an animation callback or a timer.
+     *
+     *      The drawable must already be set up for scalar field rendering, i.e., its coloring method
+     *      is State::SCALAR_FIELD (typically by calling buffers::update() once with the first step),
+     *      so that it colors the fragments by sampling the colormap texture with the texture
+     *      coordinates.
+     *
+     *      All time steps are normalized with one global [min, max] range, so the colors of
+     *      different time steps are directly comparable.
+     */
+    class ScalarFieldPlayback {
+    public:
+        /// \brief Creates a playback for \p drawable. The drawable must outlive this playback.
+        explicit ScalarFieldPlayback(Drawable *drawable);
+
+        /// \brief Releases the buffer holding the time steps. The drawable keeps showing the last
+        ///     selected time step until its buffers are updated again.
+        ~ScalarFieldPlayback();
+
+        /**
+         * \brief Uploads all time steps in a single buffer.
+         * \param steps One entry per time step, each holding one scalar per vertex of the drawable
+         *      (in the order the vertices were sent to the vertex buffer). All steps must have the
+         *      same number of values.
+         * \return \c true on success. Requires a current OpenGL context.
+         */
+        bool upload(const std::vector< std::vector<float> > &steps);
+
+        /// \brief The number of uploaded time steps.
+        std::size_t num_steps() const { return num_steps_; }
+
+        /// \brief The time step currently shown.
+        std::size_t current_step() const { return current_step_; }
+
+        /**
+         * \brief Shows time step \p step.
+         * \details This only rebinds the texture-coordinate attribute of the drawable to the
+         *      requested step (no data transfer), so it is cheap enough to be called every frame.
+         *      Requires a current OpenGL context.
+         */
+        void set_step(std::size_t step);
+
+        /// \brief Advances to the next time step, wrapping around after the last one. Intended for
+        ///     animation callbacks.
+        void next_step();
+
+    private:
+        Drawable *drawable_;
+        unsigned int buffer_;
+        std::size_t num_values_;    // number of scalars (i.e., vertices) per time step
+        std::size_t num_steps_;
+        std::size_t current_step_;
+
+    private:
+        //copying disabled
+        ScalarFieldPlayback(const ScalarFieldPlayback &);
+        ScalarFieldPlayback &operator=(const ScalarFieldPlayback &);
+    };
+
+}
+
+
+#endif  // EASY3D_RENDERER_SCALAR_FIELD_PLAYBACK_H
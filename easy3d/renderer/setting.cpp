@@ -33,6 +33,13 @@ namespace easy3d {
         // ui
         vec4 background_color = vec4(1.0f, 1.0f, 1.0f, 1.0f);
 
+        // the KHR_debug message callback
+#ifndef NDEBUG
+        bool gl_debug_output = true;
+#else
+        bool gl_debug_output = false;
+#endif
+
         // lighting
         vec4 light_position = vec4(0.27f, 0.27f, 0.92f, 0.0f);
 
@@ -39,6 +39,11 @@ namespace easy3d {
         // ui
         extern vec4 background_color;
 
+        // whether a viewer installs the KHR_debug message callback when it initializes its OpenGL
+        // context (see opengl::setup_gl_debug_callback()). Defaults to true in debug builds. Set it
+        // before creating the viewer to get rich GL diagnostics without any error polling.
+        extern bool gl_debug_output;
+
         // lighting
         extern vec4 light_position;  // light position defined in camera coordinate system
         // drawable lighting
@@ -23,17 +23,66 @@
  */
 
 #include <easy3d/renderer/shader_manager.h>
+#include <easy3d/renderer/opengl.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/fileio/resources.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/string.h>
 #include <easy3d/util/logging.h>
 
+#include <functional>
+
 
 namespace easy3d {
 
     std::unordered_map<std::string, ShaderProgram*>     ShaderManager::programs_;
     std::unordered_map<std::string, bool>				ShaderManager::attempt_load_program_; // avoid multiple attempt
+    bool ShaderManager::binary_cache_enabled_ = true;
+
+
+    namespace details {
+
+        // program binaries are driver specific, so the driver identification is part of the cache key
+        static std::string driver_identification() {
+            std::string id;
+            const char* vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+            const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+            const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+            if (vendor)   id += vendor;
+            if (renderer) id += renderer;
+            if (version)  id += version;
+            return id;
+        }
+
+        static std::string binary_cache_directory() {
+            return resource::directory() + "/shaders/binary_cache";
+        }
+
+        // e.g., "surface/surface_color" with key 123 -> ".../binary_cache/surface_surface_color_123.bin"
+        static std::string binary_cache_file(const std::string& program_name, std::size_t key) {
+            std::string name = program_name;
+            for (std::size_t i = 0; i < name.size(); ++i) {
+                const char c = name[i];
+                if (c == '/' || c == '\\' || c == ':' || c == '|' || c == '.')
+                    name[i] = '_';
+            }
+            return binary_cache_directory() + "/" + name + "_" + std::to_string(key) + ".bin";
+        }
+
+        // reads a shader source by its name relative to the shaders directory (e.g.,
+        // "surface/surface_color.vert"), preferring the packed resource bundle over the
+        // individual file. Returns false when the shader exists in neither.
+        static bool read_shader_source(const std::string& name, std::string& code) {
+            if (resource::pack_text("shaders/" + name, code))
+                return true;
+            const std::string file = resource::directory() + "/shaders/" + name;
+            if (!file_system::is_file(file))
+                return false;
+            file_system::read_file_to_string(file, code);
+            return true;
+        }
+
+    }
 
 
     ShaderProgram* ShaderManager::get_program(const std::string& shader_name) {
@@ -56,42 +105,58 @@ namespace easy3d {
         else if (!attempt_load_program_[base_name])
             return nullptr;
 
-        const std::string dir = resource::directory() + "/shaders/";
-        const std::string vs_file = dir + base_name + ".vert";
-        if (!file_system::is_file(vs_file)) {
-            LOG_FIRST_N(ERROR, 1) << "vertex shader file \'" << vs_file + " does not exist (this is the first record)";
+        // sources come from the packed resource bundle when one is deployed (a single mapped
+        // file instead of per-shader disk reads, see resource::load_pack()), and from the
+        // individual files under the resource directory otherwise
+        std::string vs_code, fs_code, gs_code;
+        if (!details::read_shader_source(base_name + ".vert", vs_code)) {
+            LOG_FIRST_N(ERROR, 1) << "vertex shader file \'" << resource::directory() + "/shaders/" + base_name
+                                  << ".vert\' does not exist (this is the first record)";
             attempt_load_program_[base_name] = false;
             return nullptr;
         }
-        const std::string fs_file = dir + base_name + ".frag";
-        if (!file_system::is_file(fs_file)) {
-            LOG_FIRST_N(ERROR, 1) << "fragment shader file \'" << fs_file + " does not exist (this is the first record)";
+        if (!details::read_shader_source(base_name + ".frag", fs_code)) {
+            LOG_FIRST_N(ERROR, 1) << "fragment shader file \'" << resource::directory() + "/shaders/" + base_name
+                                  << ".frag\' does not exist (this is the first record)";
             attempt_load_program_[base_name] = false;
             return nullptr;
         }
-        const std::string gs_file = dir + base_name + ".geom";
-        if (geom_shader && !file_system::is_file(gs_file)) {
-            LOG_FIRST_N(ERROR, 1) << "geometry shader file \'" << gs_file + " does not exist (this is the first record)";
+        if (geom_shader && !details::read_shader_source(base_name + ".geom", gs_code)) {
+            LOG_FIRST_N(ERROR, 1) << "geometry shader file \'" << resource::directory() + "/shaders/" + base_name
+                                  << ".geom\' does not exist (this is the first record)";
             attempt_load_program_[base_name] = false;
             return nullptr;
         }
 
         ShaderProgram* program = new ShaderProgram(base_name);
 
-        bool success = program->load_shader_from_file(ShaderProgram::VERTEX, vs_file);
+        // a cached binary of the same sources, outputs, and driver restores without compiling
+        std::string cache_file;
+        if (binary_cache_enabled_ && ShaderProgram::is_binary_supported()) {
+            std::string key_source = vs_code + fs_code + gs_code + details::driver_identification();
+            for (std::size_t i = 0; i < outputs.size(); ++i)
+                key_source += outputs[i];
+            cache_file = details::binary_cache_file(base_name, std::hash<std::string>()(key_source));
+            if (file_system::is_file(cache_file) && program->load_binary(cache_file)) {
+                programs_[base_name] = program;
+                return program;
+            }
+        }
+
+        bool success = program->load_shader_from_code(ShaderProgram::VERTEX, vs_code);
         if (!success) {
             delete program;
             return nullptr;
         }
 
-        success = program->load_shader_from_file(ShaderProgram::FRAGMENT, fs_file);
+        success = program->load_shader_from_code(ShaderProgram::FRAGMENT, fs_code);
         if (!success) {
             delete program;
             return nullptr;
         }
 
         if (geom_shader) {
-            success = program->load_shader_from_file(ShaderProgram::GEOMETRY, gs_file);
+            success = program->load_shader_from_code(ShaderProgram::GEOMETRY, gs_code);
             if (!success) {
                 delete program;
                 return nullptr;
@@ -108,6 +173,11 @@ namespace easy3d {
             return nullptr;
         }
 
+        if (!cache_file.empty()) {
+            file_system::create_directory(details::binary_cache_directory());
+            program->save_binary(cache_file);
+        }
+
         programs_[base_name] = program;
         return program;
     }
@@ -153,22 +223,44 @@ namespace easy3d {
 			return nullptr;
 		}
 
-		ShaderProgram* program = new ShaderProgram(name);
-
 		std::string vert_code;
         file_system::read_file_to_string(vert_file, vert_code);
 		if (!extra_vert_code.empty())
 			string::replace_substring(vert_code, "//INSERT", extra_vert_code);
+
+		std::string frag_code;
+        file_system::read_file_to_string(frag_file, frag_code);
+		if (!extra_frag_code.empty())
+			string::replace_substring(frag_code, "//INSERT", extra_frag_code);
+
+		std::string geom_code;
+		if (!geom_file_name.empty()) {
+            file_system::read_file_to_string(geom_file, geom_code);
+			if (!extra_geom_code.empty())
+				string::replace_substring(geom_code, "//INSERT", extra_geom_code);
+		}
+
+		ShaderProgram* program = new ShaderProgram(name);
+
+		// the extra code is already merged in, so the hash covers it
+		std::string cache_file;
+		if (binary_cache_enabled_ && ShaderProgram::is_binary_supported()) {
+			std::string key_source = vert_code + frag_code + geom_code + details::driver_identification();
+			for (std::size_t i = 0; i < outputs.size(); ++i)
+				key_source += outputs[i];
+			cache_file = details::binary_cache_file(name, std::hash<std::string>()(key_source));
+			if (file_system::is_file(cache_file) && program->load_binary(cache_file)) {
+				programs_[name] = program;
+				return program;
+			}
+		}
+
         bool success = program->load_shader_from_code(ShaderProgram::VERTEX, vert_code);
         if (!success) {
             delete program;
             return nullptr;
         }
-		
-		std::string frag_code;
-        file_system::read_file_to_string(frag_file, frag_code);
-		if (!extra_frag_code.empty())
-			string::replace_substring(frag_code, "//INSERT", extra_frag_code);
+
         success = program->load_shader_from_code(ShaderProgram::FRAGMENT, frag_code);
         if (!success) {
             delete program;
@@ -176,10 +268,6 @@ namespace easy3d {
         }
 
 		if (!geom_file_name.empty()) {
-			std::string geom_code;
-            file_system::read_file_to_string(geom_file, geom_code);
-			if (!extra_geom_code.empty())
-				string::replace_substring(geom_code, "//INSERT", extra_geom_code);
             success = program->load_shader_from_code(ShaderProgram::GEOMETRY, geom_code);
             if (!success) {
                 delete program;
@@ -197,11 +285,116 @@ namespace easy3d {
             return nullptr;
         }
 
+		if (!cache_file.empty()) {
+			file_system::create_directory(details::binary_cache_directory());
+			program->save_binary(cache_file);
+		}
+
 		programs_[name] = program;
 		return program;
 
 	}
 
+
+    // create a compute shader program from its source file specified by the file's base name.
+    ShaderProgram* ShaderManager::create_compute_program_from_file(const std::string& base_name)
+    {
+        std::unordered_map<std::string, bool>::iterator it = attempt_load_program_.find(base_name);
+        if (it == attempt_load_program_.end())
+            attempt_load_program_[base_name] = true;
+        else if (!attempt_load_program_[base_name])
+            return nullptr;
+
+        const std::string cs_file = resource::directory() + "/shaders/" + base_name + ".comp";
+        if (!file_system::is_file(cs_file)) {
+            LOG_FIRST_N(ERROR, 1) << "compute shader file \'" << cs_file + " does not exist (this is the first record)";
+            attempt_load_program_[base_name] = false;
+            return nullptr;
+        }
+
+        std::string cs_code;
+        file_system::read_file_to_string(cs_file, cs_code);
+
+        ShaderProgram* program = new ShaderProgram(base_name);
+
+        std::string cache_file;
+        if (binary_cache_enabled_ && ShaderProgram::is_binary_supported()) {
+            cache_file = details::binary_cache_file(
+                    base_name, std::hash<std::string>()(cs_code + details::driver_identification()));
+            if (file_system::is_file(cache_file) && program->load_binary(cache_file)) {
+                programs_[base_name] = program;
+                return program;
+            }
+        }
+
+        bool success = program->load_shader_from_code(ShaderProgram::COMPUTE, cs_code);
+        if (!success) {
+            delete program;
+            return nullptr;
+        }
+
+        success = program->link_program();	easy3d_debug_log_gl_error;
+        if (!success) {
+            delete program;
+            return nullptr;
+        }
+
+        if (!cache_file.empty()) {
+            file_system::create_directory(details::binary_cache_directory());
+            program->save_binary(cache_file);
+        }
+
+        programs_[base_name] = program;
+        return program;
+    }
+
+
+    int ShaderManager::warmup() {
+        const std::string dir = resource::directory() + "/shaders";
+        std::vector<std::string> files;
+        file_system::get_files(dir, files, true);
+
+        // Attribute locations are fixed by the AttribType values and every attribute name used in the
+        // code base maps to a single type, so binding the union of all known names links each program
+        // exactly as its real call site would (names a shader does not declare are ignored).
+        std::vector<ShaderProgram::Attribute> attributes;
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "vtx_position"));
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "vertexMC"));
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "ndc_position"));
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::POSITION, "coords"));
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::COLOR, "vtx_color"));
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::NORMAL, "vtx_normal"));
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::TEXCOORD, "vtx_texcoord"));
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::TEXCOORD, "tcoordMC"));
+        attributes.push_back(ShaderProgram::Attribute(ShaderProgram::TEXCOORD, "tex_coord"));
+
+        int count = 0;
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            const std::string& file = files[i];
+            const std::string ext = file_system::extension(file);
+            if (ext != "vert" && ext != "comp")
+                continue;
+            // the program name is the path relative to the shaders directory, without the extension
+            const std::string base_name = file.substr(dir.size() + 1, file.size() - dir.size() - 1 - 5);
+            if (get_program(base_name)) {
+                ++count;
+                continue;
+            }
+
+            if (ext == "comp") {
+                if (create_compute_program_from_file(base_name))
+                    ++count;
+            }
+            else if (file_system::is_file(dir + "/" + base_name + ".frag")) {
+                const bool geom_shader = file_system::is_file(dir + "/" + base_name + ".geom");
+                if (create_program_from_files(base_name, attributes, std::vector<std::string>(), geom_shader))
+                    ++count;
+            }
+        }
+        return count;
+    }
+
+
     std::vector<ShaderProgram*> ShaderManager::all_programs() {
         std::vector<ShaderProgram*> result;
 
@@ -68,6 +68,25 @@ namespace easy3d {
 			const std::vector<std::string>& outputs = std::vector<std::string>()
 		);
 
+        // create a compute shader program from its source file specified by the file's base name.
+        static ShaderProgram* create_compute_program_from_file(const std::string& file_base_name);
+
+        // Enable/Disable the on-disk shader binary cache (enabled by default). With the cache enabled,
+        // a successfully linked program is stored as a driver binary (GL_ARB_get_program_binary) in
+        // "shaders/binary_cache" under the resource directory, keyed by a hash of its sources and the
+        // driver identification strings. Later sessions restore the program with glProgramBinary()
+        // instead of compiling, removing the first-use hitch. A cache entry is ignored when the
+        // sources or the driver change, and rebuilt after the next successful link.
+        static void set_binary_cache(bool enabled) { binary_cache_enabled_ = enabled; }
+        static bool binary_cache() { return binary_cache_enabled_; }
+
+        // Precompile all programs under the "shaders" resource directory (every .vert/.frag pair, with
+        // the .geom when present), so no first-use compilation hitch is left for the session. Combined
+        // with the binary cache this also makes later sessions start warm. Returns the number of
+        // programs compiled or restored. Must be called with a current OpenGL context; expensive on
+        // the first run, cheap afterwards.
+        static int warmup();
+
         static std::vector<ShaderProgram*> all_programs();
 
         // destroy all shader programs.
@@ -80,6 +99,8 @@ namespace easy3d {
         // as find forces construction/copy/destruction of a std::sting copy of the const char*.
         static std::unordered_map<std::string, ShaderProgram*>	programs_;
         static std::unordered_map<std::string, bool>			attempt_load_program_; // avoid multiple attempt
+
+        static bool binary_cache_enabled_;
     };
 
 }
@@ -39,7 +39,9 @@
 
 #include <easy3d/renderer/shader_program.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 
@@ -72,6 +74,10 @@ namespace easy3d {
 
 	int ShaderProgram::spBlockCount = 1;
 
+    unsigned int ShaderProgram::num_binds_ = 0;
+    unsigned int ShaderProgram::num_switches_ = 0;
+    unsigned int ShaderProgram::last_bound_ = 0;
+
 
     bool ShaderProgram::is_supported() {
         return OpenglInfo::is_supported("GL_VERSION_2_0") || (
@@ -203,8 +209,21 @@ namespace easy3d {
 	}
 
 
+    bool ShaderProgram::is_binary_supported() {
+        if (!OpenglInfo::is_supported("GL_ARB_get_program_binary"))
+            return false;
+        int num_formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+        return num_formats > 0;
+    }
+
+
 	bool ShaderProgram::link_program() {
-		glLinkProgram(program_);	
+        // ask the driver to keep the binary retrievable, so the program can go into the shader cache
+        if (is_binary_supported())
+            glProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+		glLinkProgram(program_);
 
 		//we must check the linkage result
 		std::string log;
@@ -298,15 +317,34 @@ namespace easy3d {
 	}
 
 
+	bool ShaderProgram::upload_block(const std::string& name, const void* data, std::size_t size) {
+		if (spBlocks.count(name) == 0) {
+			LOG_FIRST_N(WARNING, 1) << "block " << name << " does not exist or is not active"
+			                        << " (this is the first record)";
+			return false;
+		}
+
+		UniformBlock& b = spBlocks[name];
+		const std::size_t num = std::min(size, static_cast<std::size_t>(b.size));
+		// uploading data identical to what the buffer holds is a no-op
+		if (std::memcmp(b.cache.data(), data, num) == 0)
+			return true;
+		std::memcpy(b.cache.data(), data, num);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, b.buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, num, data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		return true;
+	}
+
+
 	ShaderProgram* ShaderProgram::set_block(const std::string& name, const void *value) {
 		if (spBlocks.count(name) == 0) {
 			LOG(ERROR) << "warning: block " << name << " does not exist or is not active";
 			return this;
 		}
 
-		glBindBuffer(GL_UNIFORM_BUFFER, spBlocks[name].buffer);	
-		glBufferSubData(GL_UNIFORM_BUFFER, 0, spBlocks[name].size, value);	
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);	
+		upload_block(name, value, spBlocks[name].size);
 		return this;
 	}
 
@@ -318,16 +356,21 @@ namespace easy3d {
 			return this;
 		}
 
-		UniformBlock b = spBlocks[blockName];
+		UniformBlock& b = spBlocks[blockName];
 		if (b.uniformOffsets.count(uniformName) == 0) {
 			LOG(ERROR) << "warning: block/uniform " << blockName << "/" << uniformName << " does not exist or is not active";
 			return this;
 		}
 
 		BlockUniform bUni = b.uniformOffsets[uniformName];
-		glBindBuffer(GL_UNIFORM_BUFFER, b.buffer);	
-		glBufferSubData(GL_UNIFORM_BUFFER, bUni.offset, bUni.size, value);	
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);	
+		// uploading data identical to what the buffer holds is a no-op
+		if (std::memcmp(b.cache.data() + bUni.offset, value, bUni.size) == 0)
+			return this;
+		std::memcpy(b.cache.data() + bUni.offset, value, bUni.size);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, b.buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, bUni.offset, bUni.size, value);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 		return this;
 	}
 
@@ -339,16 +382,22 @@ namespace easy3d {
 			return this;
 		}
 
-		UniformBlock b = spBlocks[blockName];
+		UniformBlock& b = spBlocks[blockName];
 		if (b.uniformOffsets.count(uniformName) == 0) {
 			LOG(ERROR) << "warning: block/uniform " << blockName << "/" << uniformName << " does not exist or is not active";
 			return this;
 		}
 
 		BlockUniform bUni = b.uniformOffsets[uniformName];
-		glBindBuffer(GL_UNIFORM_BUFFER, b.buffer);	
-		glBufferSubData(GL_UNIFORM_BUFFER, bUni.offset + bUni.arrayStride * arrayIndex, bUni.arrayStride, value);	
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);	
+		const unsigned int offset = bUni.offset + bUni.arrayStride * arrayIndex;
+		// uploading data identical to what the buffer holds is a no-op
+		if (std::memcmp(b.cache.data() + offset, value, bUni.arrayStride) == 0)
+			return this;
+		std::memcpy(b.cache.data() + offset, value, bUni.arrayStride);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, b.buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, bUni.arrayStride, value);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 		return this;
 	}
 
@@ -641,7 +690,12 @@ namespace easy3d {
         // that the shader can execute given the current GL state.
 //        if (!is_program_valid())
 //            LOG(ERROR) << "program exists but not valid";
-		glUseProgram(program_);	
+        ++num_binds_;
+        if (program_ != last_bound_) {
+            ++num_switches_;
+            last_bound_ = program_;
+        }
+		glUseProgram(program_);
 	}
 
 
@@ -825,11 +879,14 @@ namespace easy3d {
 			if (!spBlocks.count(name)) {
 				// Get buffers size
 				block = spBlocks[name];
-				glGetActiveUniformBlockiv(program_, i, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);	
+				glGetActiveUniformBlockiv(program_, i, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
 				//printf("DataSize:%d\n", dataSize);
-				glGenBuffers(1, &block.buffer);	
-				glBindBuffer(GL_UNIFORM_BUFFER, block.buffer);	
-                glBufferData(GL_UNIFORM_BUFFER, dataSize, nullptr, GL_DYNAMIC_DRAW);
+				glGenBuffers(1, &block.buffer);
+				glBindBuffer(GL_UNIFORM_BUFFER, block.buffer);
+				// zero-initialized, so the CPU-side mirror used for skipping redundant uploads
+				// (see upload_block()) starts in sync with the buffer
+				block.cache.assign(dataSize, 0);
+                glBufferData(GL_UNIFORM_BUFFER, dataSize, block.cache.data(), GL_DYNAMIC_DRAW);
 				glUniformBlockBinding(program_, i, spBlockCount);	
 				glBindBufferRange(GL_UNIFORM_BUFFER, spBlockCount, block.buffer, 0, dataSize);	
 
@@ -43,6 +43,8 @@
 #include <vector>
 #include <string>
 
+#include <easy3d/core/types.h>
+
 
 namespace easy3d {
 
@@ -102,7 +104,10 @@ namespace easy3d {
 
         static bool is_supported();
 
-		// An unique 'name' of a shader will be convenient for determining if the 
+        // whether the driver can save/restore linked programs as binary blobs (GL_ARB_get_program_binary)
+        static bool is_binary_supported();
+
+		// An unique 'name' of a shader will be convenient for determining if the
 		// shader is the required one (e.g, provide the shader source file name.
 		ShaderProgram(const std::string& name = "unknown");
 		~ShaderProgram();
@@ -171,6 +176,14 @@ namespace easy3d {
 
 		void bind();	// start using the shader
 
+        // Per-frame state-change statistics. bind() counts every call; a call binding a program
+        // different from the one bound by the previous bind() additionally counts as a switch.
+        // Drawing drawables sorted by Drawable::sort_key() lowers the switch count; the counters
+        // make that measurable. Reset them once per frame (e.g., before drawing the scene).
+        static unsigned int num_binds() { return num_binds_; }
+        static unsigned int num_switches() { return num_switches_; }
+        static void reset_bind_stats() { num_binds_ = num_switches_ = 0; }
+
 		// generic function to set the uniform <name> to value
 		// NOTE: if your uniform is an array type, be careful to use the correct uniform names. For example, you have 
 		//		 'uniform vec2/float values[8]' in your shader code, the uniform name is 'values[0]' (not 'values').	
@@ -186,6 +199,32 @@ namespace easy3d {
 		// For float uniforms. Sets the uniform <name> to the float value
 		ShaderProgram* set_uniform(const std::string& name, float value);
 
+        /**
+         * The CPU-side layout of the std140 "FrameBlock" uniform block declared by the surface
+         * shaders. It gathers the per-frame constants (the model-view-projection matrix and the
+         * light/camera positions in world coordinates) that every drawable used to upload with
+         * individual glUniform*() calls. Since the buffer of a named block is shared by all
+         * programs declaring it and uploads are skipped when the data has not changed (see
+         * upload_block()), the constants reach the GPU once per frame instead of once per draw.
+         */
+        struct FrameBlock {
+            FrameBlock() : MVP(1.0f), wLightPos(0, 0, 1), padding0(0.0f),
+                           wCamPos(0, 0, 0), padding1(0.0f) {}
+            mat4 MVP;
+            vec3 wLightPos; float padding0; // std140 pads vec3 members to 16 bytes
+            vec3 wCamPos;   float padding1;
+        };
+
+        /**
+         * Uploads \p size bytes of \p data to the buffer of the named std140 uniform block. The
+         * buffer is shared by all programs declaring the block, so it does not matter through
+         * which program (or none: the method is static) the upload happens. The upload is
+         * skipped entirely when the data equals what the buffer already holds, which makes
+         * re-submitting unchanged per-frame or per-material constants free.
+         * \return \c false when no linked program declares the block (yet).
+         */
+        static bool upload_block(const std::string& name, const void* data, std::size_t size);
+
 		// sets a uniform block as a whole
 		ShaderProgram* set_block(const std::string& name, const void *value);
 
@@ -285,6 +324,9 @@ namespace easy3d {
             unsigned int buffer;
 			// binding index
             unsigned int bindingIndex;
+            // mirror of the buffer contents, used to skip uploads of unchanged data. The buffer
+            // is zero-initialized at creation so the mirror is always in sync.
+            std::vector<char> cache;
 			// uniforms information
 			// maps of std::string can be super slow when calling find with a string literal or const char* 
 			// as find forces construction/copy/destruction of a std::sting copy of the const char*.
@@ -307,6 +349,13 @@ namespace easy3d {
 		// stores the text string related to each type
 		static std::string spStringShaderTypes[ShaderProgram::NUM_SHADER_TYPES];
 
+        // the state-change statistics (see num_binds()). 'last_bound_' remembers the program of
+        // the previous bind() call; release() does not clear it, so rebinding the same program
+        // for consecutive drawables is not counted as a switch.
+        static unsigned int num_binds_;
+        static unsigned int num_switches_;
+        static unsigned int last_bound_;
+
         // the program handle
         unsigned int program_;
 
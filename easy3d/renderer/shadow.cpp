@@ -23,9 +23,14 @@
  */
 
 #include <easy3d/renderer/shadow.h>
+
+#include <algorithm>
+#include <cstring>
+
 #include <easy3d/renderer/shader_manager.h>
 #include <easy3d/renderer/shader_program.h>
 #include <easy3d/renderer/framebuffer_object.h>
+#include <easy3d/renderer/frame_profiler.h>
 #include <easy3d/renderer/camera.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/transform.h>
@@ -57,6 +62,10 @@ namespace easy3d {
         , virtual_background_color_(1.0f, 1.0f, 1.0f)
         , light_distance_(50.0f)
         , darkness_(0.6f)
+        , num_cascades_(1)
+        , static_fbo_(nullptr)
+        , cache_valid_(false)
+        , cached_size_(0)
     {
     }
 
@@ -71,6 +80,10 @@ namespace easy3d {
         delete fbo_;
         fbo_ = nullptr;
 
+        delete static_fbo_;
+        static_fbo_ = nullptr;
+        cache_valid_ = false;
+
         delete camera_frustum_;
         camera_frustum_ = nullptr;
 
@@ -88,6 +101,66 @@ namespace easy3d {
     }
 
 
+    void Shadow::set_num_cascades(int num) {
+        num_cascades_ = std::min(4, std::max(1, num));
+    }
+
+
+    void Shadow::set_dynamic_casters(const std::vector<TrianglesDrawable*>& casters) {
+        dynamic_casters_ = casters;
+        // the set of static casters has changed
+        cache_valid_ = false;
+    }
+
+
+    int Shadow::cascades() const {
+        // cascades split the perspective camera frustum; an orthographic camera uses a single map
+        if (camera_->type() == Camera::ORTHOGRAPHIC)
+            return 1;
+        return num_cascades_;
+    }
+
+
+    void Shadow::partition_casters(const std::vector<TrianglesDrawable*>& surfaces,
+                                   std::vector<TrianglesDrawable*>& statics,
+                                   std::vector<TrianglesDrawable*>& dynamics) const
+    {
+        for (auto d : surfaces) {
+            if (std::find(dynamic_casters_.begin(), dynamic_casters_.end(), d) != dynamic_casters_.end())
+                dynamics.push_back(d);
+            else
+                statics.push_back(d);
+        }
+    }
+
+
+    bool Shadow::static_map_valid(const std::vector<TrianglesDrawable*>& statics) const {
+        return cache_valid_ && static_fbo_ &&
+               cached_size_ == shadow_map_size_ &&
+               std::memcmp(&cached_shadow_matrix_, &shadow_matrices_[0], sizeof(mat4)) == 0 &&
+               cached_casters_ == statics;
+    }
+
+
+    void Shadow::record_static_map(const std::vector<TrianglesDrawable*>& statics) {
+        cache_valid_ = true;
+        cached_casters_ = statics;
+        cached_shadow_matrix_ = shadow_matrices_[0];
+        cached_size_ = shadow_map_size_;
+    }
+
+
+    void Shadow::draw_casters(ShaderProgram* program, const std::vector<TrianglesDrawable*>& casters) {
+        for (auto d : casters) {
+            if (d->is_visible()) {
+                if (setting::clipping_plane)
+                    setting::clipping_plane->set_program(program, d->plane_clipping_discard());
+                d->gl_draw(false);
+            }
+        }
+    }
+
+
     void Shadow::set_darkness(float darkness) {
         darkness_ = darkness;
         if (darkness_ < 0.0f)
@@ -98,12 +171,23 @@ namespace easy3d {
 
 
     void Shadow::ensure_fbo() {
+        // the cascades are laid out side by side in a horizontal atlas
         if (!fbo_) {
             const int samples = 0;
-            fbo_ = new FramebufferObject(shadow_map_size_, shadow_map_size_, samples);
+            fbo_ = new FramebufferObject(shadow_map_size_ * cascades(), shadow_map_size_, samples);
             fbo_->add_depth_texture(GL_DEPTH_COMPONENT32F, GL_LINEAR, GL_COMPARE_REF_TO_TEXTURE, GL_LEQUAL);
         }
-        fbo_->ensure_size(shadow_map_size_, shadow_map_size_);
+        fbo_->ensure_size(shadow_map_size_ * cascades(), shadow_map_size_);
+    }
+
+
+    void Shadow::ensure_static_fbo() {
+        if (!static_fbo_) {
+            const int samples = 0;
+            static_fbo_ = new FramebufferObject(shadow_map_size_ * cascades(), shadow_map_size_, samples);
+            static_fbo_->add_depth_texture(GL_DEPTH_COMPONENT32F, GL_LINEAR, GL_COMPARE_REF_TO_TEXTURE, GL_LEQUAL);
+        }
+        static_fbo_->ensure_size(shadow_map_size_ * cascades(), shadow_map_size_);
     }
 
 
@@ -136,6 +220,88 @@ namespace easy3d {
             vec4(0.5f, 0.5f, 0.5f, 1.0f)
         );
         shadow_matrix_ = clip2Tex * light_projection_matrix_ * light_view_matrix_;
+
+        compute_cascades();
+    }
+
+
+    void Shadow::compute_cascades() {
+        const int K = cascades();
+        cascade_splits_ = vec4(FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX);
+        if (K == 1) {
+            light_projection_matrices_[0] = light_projection_matrix_;
+            shadow_matrices_[0] = shadow_matrix_;
+            return;
+        }
+
+        const mat4 clip2Tex(
+            vec4(0.5f, 0.0f, 0.0f, 0.0f),
+            vec4(0.0f, 0.5f, 0.0f, 0.0f),
+            vec4(0.0f, 0.0f, 0.5f, 0.0f),
+            vec4(0.5f, 0.5f, 0.5f, 1.0f)
+        );
+
+        const float z_near = camera_->zNear();
+        const float z_far = camera_->zFar();
+        const vec3& eye = camera_->position();
+        const vec3& view_dir = camera_->viewDirection();
+        const vec3& up = camera_->upVector();
+        const vec3& right = camera_->rightVector();
+        const float tan_half_fov = std::tan(static_cast<float>(camera_->fieldOfView()) * 0.5f);
+        const float aspect = static_cast<float>(camera_->aspectRatio());
+        const float radius = camera_->sceneRadius();
+
+        // the practical split scheme: a blend of the uniform and the logarithmic schemes
+        const float lambda = 0.5f;
+
+        float slice_near = z_near;
+        for (int k = 0; k < K; ++k) {
+            const float si = static_cast<float>(k + 1) / K;
+            const float z_uniform = z_near + (z_far - z_near) * si;
+            const float z_log = z_near * std::pow(z_far / z_near, si);
+            const float slice_far = lambda * z_log + (1.0f - lambda) * z_uniform;
+
+            // the eight corners of this slice of the camera frustum, in world coordinates
+            vec3 corners[8];
+            int idx = 0;
+            for (int j = 0; j < 2; ++j) {
+                const float d = (j == 0) ? slice_near : slice_far;
+                const float hh = tan_half_fov * d;
+                const float hw = hh * aspect;
+                const vec3 c = eye + view_dir * d;
+                corners[idx++] = c - right * hw - up * hh;
+                corners[idx++] = c + right * hw - up * hh;
+                corners[idx++] = c + right * hw + up * hh;
+                corners[idx++] = c - right * hw + up * hh;
+            }
+
+            // fit an orthogonal light frustum to the slice, in the light's view space
+            float min_x = FLT_MAX, min_y = FLT_MAX, min_z = FLT_MAX;
+            float max_x = -FLT_MAX, max_y = -FLT_MAX, max_z = -FLT_MAX;
+            for (int i = 0; i < 8; ++i) {
+                const vec3 p = light_view_matrix_ * corners[i];
+                min_x = std::min(min_x, p.x);  max_x = std::max(max_x, p.x);
+                min_y = std::min(min_y, p.y);  max_y = std::max(max_y, p.y);
+                min_z = std::min(min_z, p.z);  max_z = std::max(max_z, p.z);
+            }
+            // pull the near plane toward the light, so casters outside the slice still cast into it
+            max_z += radius * 2.0f;
+
+            // note the inversion because the light looks at the neg. z axis
+            light_projection_matrices_[k] = transform::ortho(min_x, max_x, min_y, max_y, -max_z, -min_z);
+
+            // the atlas stores cascade k in the x range [k/K, (k+1)/K] of the texture
+            const mat4 atlas(
+                vec4(1.0f / K, 0.0f, 0.0f, 0.0f),
+                vec4(0.0f, 1.0f, 0.0f, 0.0f),
+                vec4(0.0f, 0.0f, 1.0f, 0.0f),
+                vec4(static_cast<float>(k) / K, 0.0f, 0.0f, 1.0f)
+            );
+            shadow_matrices_[k] = atlas * clip2Tex * light_projection_matrices_[k] * light_view_matrix_;
+
+            cascade_splits_[k] = slice_far;	// distance along the view direction
+            slice_near = slice_far;
+        }
     }
 
 
@@ -149,12 +315,18 @@ namespace easy3d {
         init();
 
         // generate shadow map
-        glViewport(0, 0, shadow_map_size_, shadow_map_size_);
-        shadow_map_pass(surfaces);          easy3d_debug_log_gl_error;
+        {
+            FrameProfiler::Section section("shadow map");
+            glViewport(0, 0, shadow_map_size_ * cascades(), shadow_map_size_);
+            shadow_map_pass(surfaces);          easy3d_debug_log_gl_error;
+        }
 
         // rendering
-        glViewport(0, 0, w, h);
-        render_pass(surfaces);      easy3d_debug_log_gl_error;
+        {
+            FrameProfiler::Section section("shadow render");
+            glViewport(0, 0, w, h);
+            render_pass(surfaces);      easy3d_debug_log_gl_error;
+        }
 
         // for debugging
     #ifdef SHOW_SHADOW_MAP_AND_LIGHT_FRUSTUM
@@ -182,24 +354,46 @@ namespace easy3d {
         if (!program)
             return;
 
-        fbo_->bind();
-        fbo_->deactivate_draw_buffers();
-        glClear(GL_DEPTH_BUFFER_BIT);
-        program->bind();
-        program->set_uniform("MVP", light_projection_matrix_ * light_view_matrix_);	easy3d_debug_log_gl_error;
-        for (auto d : surfaces) {
-            if (d->is_visible()) {
-                if (setting::clipping_plane)
-                    setting::clipping_plane->set_program(program, d->plane_clipping_discard());
-                d->gl_draw(false);
+        const int K = cascades();
+        std::vector<TrianglesDrawable*> statics, dynamics;
+        partition_casters(surfaces, statics, dynamics);
+
+        // the static casters are rendered into a persistent map, re-used until the light
+        // frustum, the map size, or the set of static casters changes
+        if (!static_map_valid(statics)) {
+            ensure_static_fbo();
+            static_fbo_->bind();
+            static_fbo_->deactivate_draw_buffers();
+            glClear(GL_DEPTH_BUFFER_BIT);
+            program->bind();
+            for (int k = 0; k < K; ++k) {
+                glViewport(k * shadow_map_size_, 0, shadow_map_size_, shadow_map_size_);
+                program->set_uniform("MVP", light_projection_matrices_[k] * light_view_matrix_);	easy3d_debug_log_gl_error;
+                draw_casters(program, statics);
+            }
+            program->release();
+            static_fbo_->release();
+            record_static_map(statics);
+        }
+
+        FramebufferObject::blit_framebuffer(fbo_, static_fbo_, GL_DEPTH_BUFFER_BIT);
+
+        // the dynamic casters are composited on top of the cached map every frame
+        if (!dynamics.empty()) {
+            fbo_->bind();
+            fbo_->deactivate_draw_buffers();
+            program->bind();
+            for (int k = 0; k < K; ++k) {
+                glViewport(k * shadow_map_size_, 0, shadow_map_size_, shadow_map_size_);
+                program->set_uniform("MVP", light_projection_matrices_[k] * light_view_matrix_);	easy3d_debug_log_gl_error;
+                draw_casters(program, dynamics);
             }
+            program->release();
+            fbo_->release();
         }
 
         // We can ignore background (background only receives shadows)
         //background_->draw(false);
-
-        program->release();
-        fbo_->release();
     }
 
 
@@ -222,7 +416,10 @@ namespace easy3d {
         const vec3& wCamPos = camera_->position();
         program->bind();
         program->set_uniform("MVP", MVP);                                  easy3d_debug_log_gl_error;
-        program->set_uniform("SHADOW", shadow_matrix_);                    easy3d_debug_log_gl_error;
+        program->set_uniform("SHADOW[0]", shadow_matrices_);               easy3d_debug_log_gl_error;
+        program->set_uniform("num_cascades", cascades());                  easy3d_debug_log_gl_error;
+        program->set_uniform("cascade_splits", cascade_splits_);           easy3d_debug_log_gl_error;
+        program->set_uniform("wViewDir", camera_->viewDirection());        easy3d_debug_log_gl_error;
         program->set_uniform("wLightPos", light_pos_);                     easy3d_debug_log_gl_error;
         program->set_uniform("wCamPos", wCamPos);                          easy3d_debug_log_gl_error;
         program->set_uniform("darkness", darkness_);                       easy3d_debug_log_gl_error;
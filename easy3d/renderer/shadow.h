@@ -35,6 +35,7 @@ namespace easy3d {
     class Frustum;
     class TrianglesDrawable;
     class FramebufferObject;
+    class ShaderProgram;
 
     // Code can be simplified by omitting frustum and use the Camera class instead.
     // check line 611, void Camera::setFOVToFitScene(), in camera.cpp.
@@ -83,6 +84,28 @@ namespace easy3d {
         /// dark/black). The default value is 0.6.
         void set_darkness(float darkness);
 
+        /// Query the number of shadow map cascades. \see set_num_cascades(int).
+        int num_cascades() const { return num_cascades_; }
+        /// Set the number of shadow map cascades. Values must be in [1, 4] and the default value is 1 (a single
+        /// map, the previous behavior). With cascades, the camera frustum is split into depth slices (using the
+        /// practical split scheme) and each slice gets its own slot in a shadow map atlas, so large site models
+        /// keep shadow resolution near the viewer without a huge single map.
+        /// \note Cascades require a perspective camera; with an orthographic camera (and in SoftShadow) a single
+        ///     map is used regardless of this value.
+        void set_num_cascades(int num);
+
+        /// The drawables that move relative to the scene (e.g., the model being manipulated). All other surfaces
+        /// passed to draw() are treated as static casters, whose shadow map is cached across frames and only
+        /// re-rendered when the light frustum, the map size, or the set of static casters changes. The dynamic
+        /// casters are rendered on top of the cached map every frame.
+        const std::vector<TrianglesDrawable*>& dynamic_casters() const { return dynamic_casters_; }
+        /// Set the dynamic casters. \see dynamic_casters().
+        void set_dynamic_casters(const std::vector<TrianglesDrawable*>& casters);
+
+        /// Invalidate the cached static shadow map, forcing it to be re-rendered in the next frame. Call this
+        /// after a static model has been edited (the cache cannot detect geometry changes by itself).
+        void invalidate_cache() { cache_valid_ = false; }
+
         /// Rendering the surfaces.
         void draw(const std::vector<TrianglesDrawable*>& surfaces);
 
@@ -92,6 +115,29 @@ namespace easy3d {
         virtual void shadow_map_pass(const std::vector<TrianglesDrawable*>& surfaces);
         virtual void render_pass(const std::vector<TrianglesDrawable*>& surfaces);
 
+        // The FBO holding the cached shadow map of the static casters (same layout as fbo_).
+        virtual void ensure_static_fbo();
+
+        // The number of cascades actually rendered. SoftShadow overrides this to 1 (its PCSS
+        // filtering is not cascade-aware); an orthographic camera also falls back to 1.
+        virtual int cascades() const;
+
+        // Split the surfaces into static and dynamic casters. \see set_dynamic_casters().
+        void partition_casters(const std::vector<TrianglesDrawable*>& surfaces,
+                               std::vector<TrianglesDrawable*>& statics,
+                               std::vector<TrianglesDrawable*>& dynamics) const;
+
+        // Is the cached static shadow map still usable for this frame?
+        bool static_map_valid(const std::vector<TrianglesDrawable*>& statics) const;
+        // Record the inputs the cached static shadow map was rendered from.
+        void record_static_map(const std::vector<TrianglesDrawable*>& statics);
+
+        // Render the casters with the shadow-map generation program (must be bound).
+        void draw_casters(ShaderProgram* program, const std::vector<TrianglesDrawable*>& casters);
+
+        // Compute the per-cascade light projections and shadow matrices.
+        void compute_cascades();
+
         void clear();
         void init();
 
@@ -131,6 +177,20 @@ namespace easy3d {
         mat4	light_view_matrix_;
         mat4	light_projection_matrix_;
 
+        // cascades (the shadow matrices contain the atlas remapping)
+        int		num_cascades_;
+        mat4	light_projection_matrices_[4];
+        mat4	shadow_matrices_[4];
+        vec4	cascade_splits_;	// the far distance of each cascade along the view direction
+
+        // caching of the static casters' shadow map
+        FramebufferObject*	static_fbo_;
+        std::vector<TrianglesDrawable*> dynamic_casters_;
+        bool	cache_valid_;
+        std::vector<TrianglesDrawable*> cached_casters_;
+        mat4	cached_shadow_matrix_;
+        int		cached_size_;
+
     private:
         //copying disabled
         Shadow(const Shadow&);
@@ -63,6 +63,16 @@ namespace easy3d {
     }
 
 
+    void SoftShadow::ensure_static_fbo() {
+        if (!static_fbo_) {
+            static_fbo_ = new FramebufferObject(shadow_map_size_, shadow_map_size_, 0);
+            static_fbo_->add_color_texture(GL_R32F, GL_RED, GL_FLOAT, GL_LINEAR);
+            static_fbo_->add_depth_texture(GL_DEPTH_COMPONENT32F, GL_LINEAR, GL_COMPARE_REF_TO_TEXTURE, GL_LEQUAL);
+        }
+        static_fbo_->ensure_size(shadow_map_size_, shadow_map_size_);
+    }
+
+
     void SoftShadow::shadow_map_pass(const std::vector<TrianglesDrawable*>& surfaces)
     {
         static const std::string name = "shadow/soft_shadow_generate";
@@ -77,36 +87,51 @@ namespace easy3d {
             return;
 
         // Pass 1 (shadow map generation)
-        fbo_->bind();
+        std::vector<TrianglesDrawable*> statics, dynamics;
+        partition_casters(surfaces, statics, dynamics);
 
-        // I will write the shadow map depth into the RED component, so the clear
-        // value must be set to 1.0f (in case the default clear value is changed).
-        float color[4];
-        glGetFloatv(GL_COLOR_CLEAR_VALUE, color);
+        // the static casters are rendered into a persistent map, re-used until the light
+        // frustum, the map size, or the set of static casters changes
+        if (!static_map_valid(statics)) {
+            ensure_static_fbo();
+            static_fbo_->bind();
 
-        glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
-        glClearDepthf(1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            // I will write the shadow map depth into the RED component, so the clear
+            // value must be set to 1.0f (in case the default clear value is changed).
+            float color[4];
+            glGetFloatv(GL_COLOR_CLEAR_VALUE, color);
 
-        program->bind();
-        program->set_uniform("MVP", light_projection_matrix_ * light_view_matrix_);	easy3d_debug_log_gl_error;
-        for (auto d : surfaces) {
-            if (d->is_visible()) {
-                if (setting::clipping_plane)
-                    setting::clipping_plane->set_program(program, d->plane_clipping_discard());
-                d->gl_draw(false);
-            }
-        }
+            glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+            glClearDepthf(1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // We can ignore background (background only receives shadows)
-        //background_->draw(false);
+            program->bind();
+            program->set_uniform("MVP", light_projection_matrix_ * light_view_matrix_);	easy3d_debug_log_gl_error;
+            draw_casters(program, statics);
 
-        program->release();
+            // We can ignore background (background only receives shadows)
+            //background_->draw(false);
+
+            program->release();
 
-        // restore the default color
-        glClearColor(color[0], color[1], color[2], color[3]);
+            // restore the default color
+            glClearColor(color[0], color[1], color[2], color[3]);
 
-        fbo_->release();
+            static_fbo_->release();
+            record_static_map(statics);
+        }
+
+        FramebufferObject::blit_framebuffer(fbo_, static_fbo_, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // the dynamic casters are composited on top of the cached map every frame
+        if (!dynamics.empty()) {
+            fbo_->bind();
+            program->bind();
+            program->set_uniform("MVP", light_projection_matrix_ * light_view_matrix_);	easy3d_debug_log_gl_error;
+            draw_casters(program, dynamics);
+            program->release();
+            fbo_->release();
+        }
     }
 
 
@@ -91,9 +91,14 @@ namespace easy3d {
 
     protected:
         virtual void ensure_fbo() override;
+        virtual void ensure_static_fbo() override;
         virtual void shadow_map_pass(const std::vector<TrianglesDrawable*>& surfaces) override;
         virtual void render_pass(const std::vector<TrianglesDrawable*>& surfaces) override;
 
+        // The PCSS blocker search and filtering are not cascade-aware, so a single shadow map
+        // is always used (the static/dynamic caster caching still applies).
+        virtual int cascades() const override { return 1; }
+
     protected:
         // The softness of the shadow, in [0, 1] (w.r.t. 10% of the light's size)
         float softness_;
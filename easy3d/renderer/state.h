@@ -71,6 +71,17 @@ namespace easy3d {
             VERTEX, FACE, EDGE, HALFEDGE
         };
 
+        /**
+         * The precision of the per-vertex normal, color, and texture coordinate attributes on the GPU.
+         * COMPACT_PRECISION packs normals into 10 bits per component (GL_INT_2_10_10_10_REV), texture
+         * coordinates into half floats, and colors into 8 bits per channel, which roughly halves the
+         * per-vertex memory and the vertex fetch bandwidth. The quantization is invisible for shading
+         * and coloring purposes; positions always remain full floats.
+         */
+        enum AttributePrecision {
+            FULL_PRECISION, COMPACT_PRECISION
+        };
+
         /**
          * Material definition.
          */
@@ -208,6 +219,14 @@ namespace easy3d {
         void enable_ssao(bool b) { ssao_enabled_ = b; }
         void set_ssao_texture(unsigned int tex) { ssao_texture_ = tex; }
 
+        /**
+         * The precision of the normal/color/texcoord buffers. Changing it takes effect the next time
+         * the buffers are updated. It applies to the one-buffer-per-attribute layout; the interleaved
+         * layout (see Drawable::set_interleaved_mode()) always stores full floats. \see AttributePrecision.
+         */
+        AttributePrecision attribute_precision() const { return attribute_precision_; }
+        void set_attribute_precision(AttributePrecision precision) { attribute_precision_ = precision; }
+
         /** Clamp the value range of a scalar field. */
         bool clamp_range() const { return clamp_range_; }
         void set_clamp_range(bool b) { clamp_range_ = b; }
@@ -271,6 +290,8 @@ namespace easy3d {
         bool ssao_enabled_;
         unsigned int ssao_texture_;
 
+        AttributePrecision attribute_precision_;
+
         bool clamp_range_;
         float clamp_lower_;
         float clamp_upper_;
@@ -0,0 +1,173 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/surface_mesh_lod.h>
+
+#include <cmath>
+
+#include <easy3d/core/surface_mesh.h>
+#include <easy3d/algo/surface_mesh_simplification.h>
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/drawable_triangles.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    namespace details {
+
+        // the average edge length, used as a (cheap) bound of the geometric deviation of a level
+        static float average_edge_length(const SurfaceMesh &mesh) {
+            if (mesh.n_edges() == 0)
+                return 0.0f;
+            float total = 0.0f;
+            for (auto e : mesh.edges())
+                total += mesh.edge_length(e);
+            return total / mesh.n_edges();
+        }
+
+
+        // uploads the current geometry of the mesh into a stand-alone drawable
+        static TrianglesDrawable *create_level_drawable(SurfaceMesh &mesh, const std::string &name) {
+            mesh.update_vertex_normals();
+            auto normals = mesh.get_vertex_property<vec3>("v:normal");
+
+            std::vector<unsigned int> indices;
+            indices.reserve(mesh.n_faces() * 3);
+            for (auto f : mesh.faces()) {
+                for (auto v : mesh.vertices(f))
+                    indices.push_back(static_cast<unsigned int>(v.idx()));
+            }
+
+            TrianglesDrawable *drawable = new TrianglesDrawable(name);
+            drawable->update_vertex_buffer(mesh.points());
+            drawable->update_normal_buffer(normals.vector());
+            drawable->update_element_buffer(indices);
+            return drawable;
+        }
+
+    }
+
+
+    SurfaceMeshLod::SurfaceMeshLod(SurfaceMesh *mesh)
+            : mesh_(mesh) {
+    }
+
+
+    SurfaceMeshLod::~SurfaceMeshLod() {
+        clear();
+    }
+
+
+    bool SurfaceMeshLod::generate(unsigned int num_levels, float reduction) {
+        if (!mesh_) {
+            LOG(ERROR) << "no mesh to generate the LOD chain from";
+            return false;
+        }
+        if (!mesh_->is_triangle_mesh()) {
+            LOG(ERROR) << "only triangle meshes can be simplified (model: " << mesh_->name() << ")";
+            return false;
+        }
+        if (reduction <= 0.0f || reduction >= 1.0f) {
+            LOG(ERROR) << "the reduction factor must be in (0, 1): " << reduction;
+            return false;
+        }
+
+        clear();
+
+        // the working copy is simplified further for every level, so the chain costs one
+        // simplification pass per level instead of starting from the full mesh each time.
+        SurfaceMesh copy = *mesh_;
+        const float base_error = details::average_edge_length(copy);
+
+        for (unsigned int i = 0; i < num_levels; ++i) {
+            if (i > 0) {
+                const unsigned int target = static_cast<unsigned int>(
+                        mesh_->n_vertices() * std::pow(reduction, static_cast<float>(i)));
+                if (target >= copy.n_vertices())
+                    break;  // no further reduction possible
+                SurfaceMeshSimplification simplifier(&copy);
+                simplifier.initialize();
+                simplifier.simplify(target);
+                copy.collect_garbage();
+            }
+
+            Level level;
+            level.drawable = details::create_level_drawable(copy, "lod" + std::to_string(i));
+            // the coarser the level, the longer its edges - the growth of the average edge length
+            // (relative to the input mesh) bounds how far the surface has moved.
+            level.error = (i == 0) ? 0.0f : std::max(0.0f, details::average_edge_length(copy) - base_error);
+            levels_.push_back(level);
+        }
+
+        return !levels_.empty();
+    }
+
+
+    TrianglesDrawable *SurfaceMeshLod::drawable(std::size_t level) const {
+        if (level >= levels_.size()) {
+            LOG(ERROR) << "level " << level << " does not exist (the chain has " << levels_.size() << " levels)";
+            return nullptr;
+        }
+        return levels_[level].drawable;
+    }
+
+
+    float SurfaceMeshLod::error(std::size_t level) const {
+        if (level >= levels_.size()) {
+            LOG(ERROR) << "level " << level << " does not exist (the chain has " << levels_.size() << " levels)";
+            return 0.0f;
+        }
+        return levels_[level].error;
+    }
+
+
+    int SurfaceMeshLod::select(const Camera *camera, float pixel_tolerance) const {
+        if (levels_.empty())
+            return -1;
+
+        // the world-space size of one pixel at the mesh, so error / ratio is the error in pixels
+        const float ratio = camera->pixelGLRatio(mesh_->bounding_box().center());
+        for (std::size_t i = levels_.size() - 1; i > 0; --i) {
+            if (levels_[i].error <= pixel_tolerance * ratio)
+                return static_cast<int>(i);
+        }
+        return 0;   // the full-detail level is always acceptable
+    }
+
+
+    void SurfaceMeshLod::draw(const Camera *camera, float pixel_tolerance) const {
+        const int level = select(camera, pixel_tolerance);
+        if (level >= 0)
+            levels_[level].drawable->draw(camera, false);
+    }
+
+
+    void SurfaceMeshLod::clear() {
+        for (auto &level : levels_)
+            delete level.drawable;
+        levels_.clear();
+    }
+
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_SURFACE_MESH_LOD_H
+#define EASY3D_RENDERER_SURFACE_MESH_LOD_H
+
+#include <cstddef>
+#include <vector>
+
+
+namespace easy3d {
+
+    class Camera;
+    class SurfaceMesh;
+    class TrianglesDrawable;
+
+    /**
+     * \brief Level-of-detail chain for a surface mesh, selected at runtime by screen-space error.
+     * \class SurfaceMeshLod easy3d/renderer/surface_mesh_lod.h
+     * \details generate() builds a chain of progressively simplified copies of the mesh (using
+     * SurfaceMeshSimplification) and uploads each level into its own TrianglesDrawable; the intermediate
+     * meshes are discarded afterwards, so only the GPU buffers remain. At render time, select() converts
+     * each level's geometric error into pixels with Camera::pixelGLRatio() and picks the coarsest level
+     * whose error stays below the given tolerance, so distant meshes are drawn with a fraction of their
+     * triangles while nearby ones keep full detail.
+     *
+     * Typical usage for a scene of many tiles:
+     *      \code
+     *          SurfaceMeshLod* lod = new SurfaceMeshLod(mesh);
+     *          lod->generate(4);               // once, with a current OpenGL context
+     *          ...
+     *          lod->draw(camera);              // every frame, instead of the full-detail drawable
+     *      \endcode
+     *
+     * \note The mesh must be a triangle mesh (the prerequisite of SurfaceMeshSimplification). Since
+     *       generate() creates OpenGL buffers, it must be called with a current OpenGL context.
+     */
+
+    class SurfaceMeshLod {
+    public:
+        explicit SurfaceMeshLod(SurfaceMesh *mesh);
+        ~SurfaceMeshLod();
+
+        /**
+         * \brief Generates the LOD chain.
+         * \param num_levels The number of levels, including level 0 (the full-detail mesh).
+         * \param reduction The fraction of vertices kept from one level to the next, in (0, 1).
+         * \return \c true on success (\c false if the mesh is not a triangle mesh).
+         */
+        bool generate(unsigned int num_levels = 4, float reduction = 0.35f);
+
+        /// The number of levels in the chain (0 if generate() has not been called).
+        std::size_t num_levels() const { return levels_.size(); }
+
+        /// The drawable of \p level. Level 0 is the full-detail mesh; higher levels are coarser.
+        TrianglesDrawable *drawable(std::size_t level) const;
+
+        /// The geometric error (in world units) of \p level. Level 0 has zero error.
+        float error(std::size_t level) const;
+
+        /**
+         * \brief Chooses the level to draw for the current viewpoint.
+         * \details Returns the coarsest level whose geometric error, projected at the mesh center, stays
+         *        within \p pixel_tolerance pixels on screen.
+         * \return The level index, or -1 if the chain is empty.
+         */
+        int select(const Camera *camera, float pixel_tolerance = 1.0f) const;
+
+        /// \brief Draws the level chosen by select() for the current viewpoint.
+        void draw(const Camera *camera, float pixel_tolerance = 1.0f) const;
+
+        /// \brief Releases all levels (and their GPU buffers).
+        void clear();
+
+    private:
+        struct Level {
+            TrianglesDrawable *drawable;
+            float error;    // geometric error in world units
+        };
+
+        SurfaceMesh *mesh_;
+        std::vector<Level> levels_;
+
+    private:
+        //copying disabled
+        SurfaceMeshLod(const SurfaceMeshLod&);
+        SurfaceMeshLod& operator=(const SurfaceMeshLod&);
+    };
+
+}
+
+#endif  // EASY3D_RENDERER_SURFACE_MESH_LOD_H
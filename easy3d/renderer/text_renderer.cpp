@@ -717,7 +717,8 @@ namespace easy3d {
 namespace easy3d {
 
 
-    TextRenderer::TextRenderer(float dpi_scale, int texture_size, bool mipmaps) {
+    TextRenderer::TextRenderer(float dpi_scale, int texture_size, bool mipmaps)
+            : batching_(false) {
         texture_size_ = geom::next_pow2(texture_size);
         stash_ = details::sth_create(texture_size_, texture_size_, mipmaps, 0, dpi_scale);
         easy3d_log_gl_error;
@@ -731,6 +732,13 @@ namespace easy3d {
 
 
     TextRenderer::~TextRenderer() {
+        for (auto &buf : buffers_) {
+            if (buf.vertex_buffer)
+                VertexArrayObject::release_buffer(buf.vertex_buffer);
+            if (buf.element_buffer)
+                VertexArrayObject::release_buffer(buf.element_buffer);
+            delete buf.vao;
+        }
         sth_delete(get_stash(stash_));
     }
 
@@ -848,7 +856,143 @@ namespace easy3d {
     }
 
 
+    void TextRenderer::begin_batch() const {
+        batching_ = true;
+        for (auto &entry : batch_)
+            entry.second.clear();
+    }
+
+
+    void TextRenderer::end_batch(const vec3 &font_color) const {
+        batching_ = false;
+        if (!stash_)
+            return;
+
+        const std::string name = "text/text";
+        auto program = ShaderManager::get_program(name);
+        if (!program) {
+            std::vector<ShaderProgram::Attribute> attributes = {
+                    ShaderProgram::Attribute(ShaderProgram::POSITION, "coords")};
+            program = ShaderManager::create_program_from_files(name, attributes);
+        }
+        if (!program) {
+            LOG_FIRST_N(ERROR, 1) << "shader doesn't exist: " << name << " (this is the first record)";
+            return;
+        }
+
+        int viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        const int w = viewport[2];
+        const int h = viewport[3];
+
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        program->bind();
+
+        for (const auto &entry : batch_) {
+            const std::vector<float> &quads = entry.second;
+            if (quads.empty())
+                continue;
+
+            // the persistent buffers of this font texture
+            BatchBuffer *buf = nullptr;
+            for (auto &b : buffers_) {
+                if (b.texture == entry.first) {
+                    buf = &b;
+                    break;
+                }
+            }
+            if (!buf) {
+                buffers_.push_back(BatchBuffer(entry.first));
+                buf = &buffers_.back();
+            }
+
+            // upload only when the labels (or the viewport) have changed since the previous batch;
+            // re-rendering an unchanged batch reuses the buffers as they are.
+            if (buf->width != w || buf->height != h || buf->quads != quads) {
+                buf->quads = quads;
+                buf->width = w;
+                buf->height = h;
+
+                const int nverts = static_cast<int>(quads.size() / 4);
+                // each vec4 represent x, y, u, and v
+                std::vector<vec4> vertices(nverts);
+                for (int i = 0; i < nverts; ++i) {
+                    vertices[i] = vec4(quads.data() + i * 4);
+                    vertices[i].x = 2.0f * vertices[i].x / w - 1.0f;
+                    vertices[i].y = 2.0f * vertices[i].y / h - 1.0f;
+                }
+
+                std::vector<unsigned int> indices(nverts / 4 * 6);
+                for (int j = 0; j < nverts / 4; ++j) {
+                    indices[j * 6 + 0] = j * 4;
+                    indices[j * 6 + 1] = j * 4 + 1;
+                    indices[j * 6 + 2] = j * 4 + 2;
+                    indices[j * 6 + 3] = j * 4;
+                    indices[j * 6 + 4] = j * 4 + 2;
+                    indices[j * 6 + 5] = j * 4 + 3;
+                }
+
+                if (!buf->vao)
+                    buf->vao = new VertexArrayObject;
+                if (buf->vertex_buffer)
+                    VertexArrayObject::release_buffer(buf->vertex_buffer);
+                if (buf->element_buffer)
+                    VertexArrayObject::release_buffer(buf->element_buffer);
+                buf->vao->create_array_buffer(buf->vertex_buffer, ShaderProgram::POSITION, vertices.data(),
+                                              vertices.size() * sizeof(vec4), 4, true);
+                buf->vao->create_element_buffer(buf->element_buffer, indices.data(),
+                                                indices.size() * sizeof(unsigned int), true);
+                buf->num_indices = static_cast<int>(indices.size());
+            }
+
+            program->bind_texture("textureID", buf->texture, 0)->set_uniform("font_color", font_color);
+            buf->vao->bind();
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buf->element_buffer);
+            glDrawElements(GL_TRIANGLES, buf->num_indices, GL_UNSIGNED_INT, nullptr);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            buf->vao->release();
+            program->release_texture();
+        }
+
+        program->release();
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        easy3d_debug_log_gl_error;
+    }
+
+
     void TextRenderer::flush_draw(const vec3 &font_color) const {
+        if (batching_) {
+            // only collect the quads; end_batch() uploads and renders them in one draw call per texture
+            struct details::sth_texture *texture = get_stash(stash_)->tt_textures;
+            short tt = 1;
+            while (texture) {
+                if (texture->nverts > 0) {
+                    std::vector<float> *quads = nullptr;
+                    for (auto &entry : batch_) {
+                        if (entry.first == texture->id) {
+                            quads = &entry.second;
+                            break;
+                        }
+                    }
+                    if (!quads) {
+                        batch_.push_back(std::make_pair(texture->id, std::vector<float>()));
+                        quads = &batch_.back().second;
+                    }
+                    quads->insert(quads->end(), texture->verts, texture->verts + texture->nverts * 4);
+                    texture->nverts = 0;
+                }
+                texture = texture->next;
+                if (!texture && tt) {
+                    texture = get_stash(stash_)->bm_textures;
+                    tt = 0;
+                }
+            }
+            return;
+        }
+
         const std::string name = "text/text";
         auto program = ShaderManager::get_program(name);
         if (!program) {
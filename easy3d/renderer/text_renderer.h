@@ -33,6 +33,8 @@
 
 namespace easy3d {
 
+    class VertexArrayObject;
+
     /**
      * \brief TextRenderer enables quick and easy string rendering in OpenGL applications.
      *
@@ -44,7 +46,8 @@ namespace easy3d {
      *    - switch between fonts;
      *    - change character spacing;
      *    - enable/disable kerning;
-     * \todo For a large number of strings/characters, it is necessary to separate buffer creation and rendering.
+     * For a large number of strings (e.g., annotation-heavy scenes with thousands of labels), use the batched
+     * rendering interface (see begin_batch()), which separates buffer creation from rendering.
      */
 
     class TextRenderer {
@@ -127,6 +130,29 @@ namespace easy3d {
                   int font_id = 0, const vec3 &font_color = vec3(0, 0, 0),
                   float line_spacing = 0.0f, bool upper_left = true) const;
 
+        // -------------------------------------------------------------------------------------------------------------
+        // Batched rendering of many strings
+
+        /**
+         * @brief Start collecting strings instead of rendering each draw() call immediately.
+         * @details By default, every call to draw() creates a vertex buffer, issues a draw call, and destroys the
+         *        buffer again, which makes text the frame-time leader once a scene carries thousands of labels.
+         *        Between begin_batch() and end_batch(), draw() only computes the glyph quads; end_batch() then
+         *        uploads all quads of the batch into a persistent vertex buffer and renders them with a single
+         *        draw call per font texture (usually one). The buffer is kept across frames and the upload is
+         *        skipped when the collected quads are identical to those of the previous batch, so re-rendering
+         *        an unchanged set of labels costs a single cheap draw call.
+         * @note All strings of a batch are rendered with the same font color (the one passed to end_batch());
+         *        the colors passed to the individual draw() calls are ignored while batching.
+         */
+        void begin_batch() const;
+
+        /**
+         * @brief Render all strings collected since begin_batch(). \see begin_batch().
+         * @param font_color The font color used for all strings of the batch.
+         */
+        void end_batch(const vec3 &font_color = vec3(0, 0, 0)) const;
+
         // -------------------------------------------------------------------------------------------------------------
 
         /**
@@ -196,6 +222,28 @@ namespace easy3d {
         void *stash_;
         std::vector<int> font_ids_;
         std::vector<std::string> font_names_;
+
+        // batched rendering (see begin_batch()). The glyph quads collected between begin_batch() and
+        // end_batch(), grouped by the font texture they sample from. Four floats (x, y, u, v) per
+        // vertex, four vertices per quad, in pixel coordinates.
+        mutable bool batching_;
+        mutable std::vector< std::pair<unsigned int, std::vector<float> > > batch_;
+
+        // the persistent buffers of a batch, one per font texture, kept across frames so that an
+        // unchanged batch can be re-rendered without uploading anything
+        struct BatchBuffer {
+            unsigned int texture;           // the font texture the quads sample from
+            VertexArrayObject *vao;
+            unsigned int vertex_buffer;
+            unsigned int element_buffer;
+            int num_indices;                // 6 per quad
+            int width, height;              // the viewport size the vertices were transformed for
+            std::vector<float> quads;       // the quads currently uploaded (pixel coordinates)
+            BatchBuffer(unsigned int tex)
+                    : texture(tex), vao(nullptr), vertex_buffer(0), element_buffer(0), num_indices(0),
+                      width(0), height(0) {}
+        };
+        mutable std::vector<BatchBuffer> buffers_;
     };
 
 }
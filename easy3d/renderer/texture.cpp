@@ -182,7 +182,17 @@ namespace easy3d {
     }
 
 
+    unsigned int Texture::num_binds_ = 0;
+    unsigned int Texture::num_switches_ = 0;
+    unsigned int Texture::last_bound_ = 0;
+
+
     void Texture::bind(int unit) {
+        ++num_binds_;
+        if (id_ != last_bound_) {
+            ++num_switches_;
+            last_bound_ = id_;
+        }
         glActiveTexture(GL_TEXTURE0 + unit);
         glBindTexture(GL_TEXTURE_2D, id_);
     }
@@ -77,6 +77,13 @@ namespace easy3d {
 
         void release();
 
+        // Per-frame state-change statistics, analogous to ShaderProgram::num_binds(): bind()
+        // counts every call; binding a texture different from the previously bound one
+        // additionally counts as a switch. Reset them once per frame.
+        static unsigned int num_binds() { return num_binds_; }
+        static unsigned int num_switches() { return num_switches_; }
+        static void reset_bind_stats() { num_binds_ = num_switches_ = 0; }
+
         int width() const { return sizes_[0]; }
 
         int height() const { return sizes_[1]; }
@@ -91,6 +98,11 @@ namespace easy3d {
         unsigned int id_;
         int sizes_[3];
 
+        // the state-change statistics (see num_binds())
+        static unsigned int num_binds_;
+        static unsigned int num_switches_;
+        static unsigned int last_bound_;
+
         std::string name_;
         WrapMode wrap_mode_;
         FilterMode filter_mode_;
@@ -23,17 +23,125 @@
  */
 
 #include <easy3d/renderer/texture_manager.h>
+#include <easy3d/renderer/opengl.h>
+#include <easy3d/renderer/opengl_error.h>
+#include <easy3d/renderer/opengl_info.h>
 #include <easy3d/fileio/image_io.h>
 #include <easy3d/core/random.h>
 #include <easy3d/util/logging.h>
 #include <easy3d/util/string.h>
 #include <easy3d/util/file_system.h>
 
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 
 namespace easy3d {
 
     std::unordered_map<std::string, Texture *>    TextureManager::textures_;
     std::unordered_map<std::string, bool>        TextureManager::attempt_load_texture_; // avoid multiple attempt
+    bool TextureManager::cache_to_disk_ = true;
+
+
+    namespace details {
+
+        // ---------------------------------------------------------------------------------------------
+        // the background decoding pipeline of request_async(): worker threads read and decode the image
+        // files; the GL upload of a finished job is done by the thread that polls for it.
+
+        struct DecodeJob {
+            std::string file;
+            int width;
+            int height;
+            int comp;
+            std::vector<unsigned char> data;
+            bool done;
+            bool failed;
+        };
+
+        static std::mutex jobs_mutex_;
+        static std::condition_variable jobs_condition_;
+        static std::deque< std::shared_ptr<DecodeJob> > pending_jobs_;
+        static std::unordered_map<std::string, std::shared_ptr<DecodeJob> > active_jobs_;
+        static std::vector<std::thread> workers_;
+        static bool workers_quit_ = false;
+
+
+        static void decode_worker() {
+            for (;;) {
+                std::shared_ptr<DecodeJob> job;
+                {
+                    std::unique_lock<std::mutex> lock(jobs_mutex_);
+                    jobs_condition_.wait(lock, []() { return workers_quit_ || !pending_jobs_.empty(); });
+                    if (workers_quit_)
+                        return;
+                    job = pending_jobs_.front();
+                    pending_jobs_.pop_front();
+                }
+
+                // flip the image vertically, so the first pixel in the output array is the bottom left
+                const bool success = ImageIO::load(job->file, job->data, job->width, job->height, job->comp, 0, true);
+
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                job->failed = !success || job->data.empty();
+                job->done = true;
+            }
+        }
+
+
+        static void ensure_workers() {
+            if (!workers_.empty())
+                return;
+            unsigned int num = std::thread::hardware_concurrency();
+            num = num > 1 ? num - 1 : 1;    // leave a core for the rendering thread
+            for (unsigned int i = 0; i < num; ++i)
+                workers_.push_back(std::thread(decode_worker));
+        }
+
+
+        static void stop_workers() {
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                workers_quit_ = true;
+            }
+            jobs_condition_.notify_all();
+            for (auto &worker : workers_)
+                worker.join();
+            workers_.clear();
+            workers_quit_ = false;
+            pending_jobs_.clear();
+            active_jobs_.clear();
+        }
+
+
+        // ---------------------------------------------------------------------------------------------
+        // the on-disk transcoded cache: the GPU-compressed mipmap chain of an image, ready for upload
+
+        static const char CACHE_MAGIC[4] = {'E', '3', 'D', 'T'};
+        static const int CACHE_VERSION = 1;
+
+        struct CacheHeader {
+            char magic[4];
+            int version;
+            long long source_time;      // to invalidate the cache when the image file changes
+            long long source_size;
+            int width;
+            int height;
+            int comp;
+            int internal_format;
+            int num_levels;
+        };
+
+        static std::string cache_name(const std::string &image_file) {
+            return image_file + ".e3d_tex";
+        }
+
+    }
 
 
     Texture* TextureManager::request(const std::string &image_file, Texture::WrapMode wrap, Texture::FilterMode filter) {
@@ -47,7 +155,24 @@ namespace easy3d {
             else if (!attempt_load_texture_[image_file])
                 return nullptr;
 
-            Texture *texture = Texture::create(image_file, wrap, filter);
+            Texture *texture = nullptr;
+            if (cache_to_disk_)     // a transcoded copy skips decoding, compression, and mipmapping
+                texture = load_cached(image_file, wrap, filter);
+
+            if (!texture && file_system::is_file(image_file)) {
+                int width = 0, height = 0, comp = 0;
+                std::vector<unsigned char> data;
+                // flip the image vertically, so the first pixel in the output array is the bottom left
+                if (ImageIO::load(image_file, data, width, height, comp, 0, true) && !data.empty()) {
+                    texture = create_from_decoded(data, width, height, comp, wrap, filter);
+                    if (texture) {
+                        texture->name_ = image_file;
+                        if (cache_to_disk_)
+                            write_cache(image_file, texture);
+                    }
+                }
+            }
+
             if (!texture) {
                 LOG_FIRST_N(ERROR, 1) << "failed creating texture from image file: " << image_file
                                       << " (this is the first record)";
@@ -61,6 +186,69 @@ namespace easy3d {
     }
 
 
+    Texture* TextureManager::request_async(const std::string &image_file, Texture::WrapMode wrap, Texture::FilterMode filter) {
+        std::unordered_map<std::string, Texture *>::iterator pos = textures_.find(image_file);
+        if (pos != textures_.end())
+            return pos->second;
+
+        std::unordered_map<std::string, bool>::iterator it = attempt_load_texture_.find(image_file);
+        if (it != attempt_load_texture_.end() && !it->second)
+            return nullptr;
+
+        // a transcoded copy needs no decoding, so it is not worth a round trip through the workers
+        if (cache_to_disk_) {
+            Texture *texture = load_cached(image_file, wrap, filter);
+            if (texture) {
+                attempt_load_texture_[image_file] = true;
+                textures_[image_file] = texture;
+                return texture;
+            }
+        }
+
+        std::shared_ptr<details::DecodeJob> job;
+        {
+            std::lock_guard<std::mutex> lock(details::jobs_mutex_);
+            auto jt = details::active_jobs_.find(image_file);
+            if (jt == details::active_jobs_.end()) {
+                // first request of this image: hand it to the workers
+                job.reset(new details::DecodeJob);
+                job->file = image_file;
+                job->width = job->height = job->comp = 0;
+                job->done = job->failed = false;
+                details::active_jobs_[image_file] = job;
+                details::pending_jobs_.push_back(job);
+                details::ensure_workers();
+                details::jobs_condition_.notify_one();
+                return nullptr;
+            }
+            job = jt->second;
+            if (!job->done)
+                return nullptr;     // still decoding; ask again next frame
+            details::active_jobs_.erase(jt);
+        }
+
+        if (job->failed) {
+            LOG_FIRST_N(ERROR, 1) << "failed creating texture from image file: " << image_file
+                                  << " (this is the first record)";
+            attempt_load_texture_[image_file] = false;
+            return nullptr;
+        }
+
+        Texture *texture = create_from_decoded(job->data, job->width, job->height, job->comp, wrap, filter);
+        if (!texture) {
+            attempt_load_texture_[image_file] = false;
+            return nullptr;
+        }
+        texture->name_ = image_file;
+        if (cache_to_disk_)
+            write_cache(image_file, texture);
+
+        attempt_load_texture_[image_file] = true;
+        textures_[image_file] = texture;
+        return texture;
+    }
+
+
     Texture* TextureManager::request(const std::string &file_name, int num_stripes, Texture::WrapMode wrap, Texture::FilterMode filter) {
         if (!file_system::is_file(file_name)) {
             LOG(ERROR) << "file does not exist: " << file_name;
@@ -146,10 +334,284 @@ namespace easy3d {
 
 
     void TextureManager::terminate() {
+        details::stop_workers();
+
         for (auto p : textures_)
             delete p.second;
         textures_.clear();
         attempt_load_texture_.clear();
     }
 
+
+    Texture *TextureManager::create_from_decoded(const std::vector<unsigned char> &data, int width, int height,
+                                                 int comp, Texture::WrapMode wrap_mode, Texture::FilterMode filter_mode) {
+        if (data.empty() || data.size() != static_cast<std::size_t>(width) * height * comp) {
+            LOG(ERROR) << "image data does not match the given size";
+            return nullptr;
+        }
+
+        GLenum wrap, min_filter, mag_filter;
+        switch (wrap_mode) {
+            case Texture::CLAMP_TO_EDGE:
+                wrap = GL_CLAMP_TO_EDGE;
+                break;
+            case Texture::REPEAT:
+                wrap = GL_REPEAT;
+                break;
+            default: {
+                LOG(ERROR) << "invalid wrap mode";
+                return nullptr;
+            }
+        }
+        switch (filter_mode) {      // minification samples the mipmap chain built below
+            case Texture::LINEAR:
+                min_filter = GL_LINEAR_MIPMAP_LINEAR;
+                mag_filter = GL_LINEAR;
+                break;
+            case Texture::NEAREST:
+                min_filter = GL_NEAREST_MIPMAP_NEAREST;
+                mag_filter = GL_NEAREST;
+                break;
+            default: {
+                LOG(ERROR) << "invalid filter mode";
+                return nullptr;
+            }
+        }
+
+        // let the driver transcode into its preferred compressed format, so the texture can be cached
+        // (and later re-uploaded) without ever decompressing again. Without compression support the
+        // texture is stored uncompressed and simply not cached.
+        const bool compress = cache_to_disk_ && OpenglInfo::is_supported("GL_ARB_texture_compression");
+        GLenum internal_format, format;
+        switch (comp) {
+            case 4:
+                internal_format = compress ? GL_COMPRESSED_RGBA : GL_RGBA8;
+                format = GL_RGBA;
+                break;
+            case 3:
+                internal_format = compress ? GL_COMPRESSED_RGB : GL_RGB8;
+                format = GL_RGB;
+                break;
+            case 2:
+                internal_format = compress ? GL_COMPRESSED_RG : GL_RG8;
+                format = GL_RG;
+                break;
+            case 1:
+                internal_format = compress ? GL_COMPRESSED_RED : GL_R8;
+                format = GL_RED;
+                break;
+            default: {
+                LOG(ERROR) << "invalid format";
+                return nullptr;
+            }
+        }
+
+        GLuint tex = 0;
+        glGenTextures(1, &tex);
+        easy3d_debug_log_gl_error;
+        if (!tex) {
+            LOG(ERROR) << "failed to generate an OpenGL texture";
+            return nullptr;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, tex);
+        easy3d_debug_log_gl_error;
+
+        int align;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &align);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+        easy3d_debug_log_gl_error;
+
+        // stage the pixels in a pixel buffer object, so the transfer to texture memory is a DMA the
+        // driver can schedule, instead of a client-memory copy it must finish synchronously.
+        GLuint pbo = 0;
+        glGenBuffers(1, &pbo);
+        easy3d_debug_log_gl_error;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, data.size(), data.data(), GL_STREAM_DRAW);
+        easy3d_debug_log_gl_error;
+        glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+        easy3d_debug_log_gl_error;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &pbo);
+
+        glGenerateMipmap(GL_TEXTURE_2D);
+        easy3d_debug_log_gl_error;
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, align);
+
+        Texture *texture = new Texture;
+        texture->wrap_mode_ = wrap_mode;
+        texture->filter_mode_ = filter_mode;
+        texture->sizes_[0] = width;
+        texture->sizes_[1] = height;
+        texture->sizes_[2] = comp;
+        texture->id_ = tex;
+        return texture;
+    }
+
+
+    Texture *TextureManager::load_cached(const std::string &image_file,
+                                         Texture::WrapMode wrap_mode, Texture::FilterMode filter_mode) {
+        const std::string cache_file = details::cache_name(image_file);
+        if (!file_system::is_file(cache_file) || !file_system::is_file(image_file))
+            return nullptr;
+
+        std::ifstream input(cache_file.c_str(), std::ios::binary);
+        if (input.fail())
+            return nullptr;
+
+        details::CacheHeader header;
+        input.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (input.fail()
+            || std::memcmp(header.magic, details::CACHE_MAGIC, 4) != 0
+            || header.version != details::CACHE_VERSION
+            || header.source_time != static_cast<long long>(file_system::time_stamp(image_file))
+            || header.source_size != static_cast<long long>(file_system::file_size(image_file)))
+            return nullptr;     // stale or foreign cache; the regular loading path rebuilds it
+
+        GLenum wrap, min_filter, mag_filter;
+        switch (wrap_mode) {
+            case Texture::CLAMP_TO_EDGE: wrap = GL_CLAMP_TO_EDGE; break;
+            case Texture::REPEAT: wrap = GL_REPEAT; break;
+            default: return nullptr;
+        }
+        switch (filter_mode) {
+            case Texture::LINEAR: min_filter = GL_LINEAR_MIPMAP_LINEAR; mag_filter = GL_LINEAR; break;
+            case Texture::NEAREST: min_filter = GL_NEAREST_MIPMAP_NEAREST; mag_filter = GL_NEAREST; break;
+            default: return nullptr;
+        }
+
+        GLuint tex = 0;
+        glGenTextures(1, &tex);
+        easy3d_debug_log_gl_error;
+        if (!tex)
+            return nullptr;
+
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header.num_levels - 1);
+        easy3d_debug_log_gl_error;
+
+        GLuint pbo = 0;
+        glGenBuffers(1, &pbo);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+
+        bool success = true;
+        std::vector<char> level_data;
+        for (int level = 0; level < header.num_levels && success; ++level) {
+            int level_width = 0, level_height = 0, level_size = 0;
+            input.read(reinterpret_cast<char *>(&level_width), sizeof(int));
+            input.read(reinterpret_cast<char *>(&level_height), sizeof(int));
+            input.read(reinterpret_cast<char *>(&level_size), sizeof(int));
+            if (input.fail() || level_size <= 0) {
+                success = false;
+                break;
+            }
+            level_data.resize(level_size);
+            input.read(level_data.data(), level_size);
+            if (input.fail()) {
+                success = false;
+                break;
+            }
+            // the level is already in the GPU's format: a direct DMA, no decoding or transcoding
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, level_size, level_data.data(), GL_STREAM_DRAW);
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, header.internal_format,
+                                   level_width, level_height, 0, level_size, nullptr);
+            easy3d_debug_log_gl_error;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &pbo);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (!success) {
+            glDeleteTextures(1, &tex);
+            return nullptr;
+        }
+
+        Texture *texture = new Texture;
+        texture->wrap_mode_ = wrap_mode;
+        texture->filter_mode_ = filter_mode;
+        texture->sizes_[0] = header.width;
+        texture->sizes_[1] = header.height;
+        texture->sizes_[2] = header.comp;
+        texture->id_ = tex;
+        texture->name_ = image_file;
+        return texture;
+    }
+
+
+    bool TextureManager::write_cache(const std::string &image_file, Texture *texture) {
+        glBindTexture(GL_TEXTURE_2D, texture->id());
+
+        // only compressed textures are cached: they re-upload without any transcoding and take a
+        // fraction of the disk space.
+        GLint compressed = GL_FALSE;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &compressed);
+        if (compressed == GL_FALSE) {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            return false;
+        }
+
+        GLint internal_format = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_format);
+
+        int num_levels = 1;
+        for (int size = std::max(texture->width(), texture->height()); size > 1; size /= 2)
+            ++num_levels;
+
+        const std::string cache_file = details::cache_name(image_file);
+        std::ofstream output(cache_file.c_str(), std::ios::binary);
+        if (output.fail()) {
+            LOG_FIRST_N(WARNING, 1) << "could not write texture cache file: " << cache_file
+                                    << " (this is the first record)";
+            glBindTexture(GL_TEXTURE_2D, 0);
+            return false;
+        }
+
+        details::CacheHeader header;
+        std::memcpy(header.magic, details::CACHE_MAGIC, 4);
+        header.version = details::CACHE_VERSION;
+        header.source_time = static_cast<long long>(file_system::time_stamp(image_file));
+        header.source_size = static_cast<long long>(file_system::file_size(image_file));
+        header.width = texture->width();
+        header.height = texture->height();
+        header.comp = texture->channels();
+        header.internal_format = internal_format;
+        header.num_levels = num_levels;
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        std::vector<char> level_data;
+        for (int level = 0; level < num_levels; ++level) {
+            GLint level_width = 0, level_height = 0, level_size = 0;
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &level_width);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &level_height);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &level_size);
+            easy3d_debug_log_gl_error;
+            if (level_size <= 0)
+                break;
+            level_data.resize(level_size);
+            glGetCompressedTexImage(GL_TEXTURE_2D, level, level_data.data());
+            easy3d_debug_log_gl_error;
+
+            output.write(reinterpret_cast<const char *>(&level_width), sizeof(int));
+            output.write(reinterpret_cast<const char *>(&level_height), sizeof(int));
+            output.write(reinterpret_cast<const char *>(&level_size), sizeof(int));
+            output.write(level_data.data(), level_size);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return !output.fail();
+    }
+
 } // namespace easy3d
\ No newline at end of file
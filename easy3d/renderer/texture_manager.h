@@ -96,20 +96,60 @@ namespace easy3d {
                                 Texture::WrapMode wrap = Texture::CLAMP_TO_EDGE,
                                 Texture::FilterMode filter = Texture::LINEAR);
 
+        /**
+         * @brief Request a texture from the image file, without blocking on the image decode.
+         * @details Behaves like request(), except that a texture not in memory yet is decoded by a
+         *          background worker thread and \c nullptr is returned until the decoded image is ready;
+         *          call this function again (e.g., every frame) to pick up the result. The GPU upload
+         *          happens on the caller's thread (the one owning the OpenGL context) through a pixel
+         *          buffer object, so a frame never stalls on reading and decoding a large image file.
+         *          When the disk cache is enabled and holds a transcoded copy of the image, the texture
+         *          is returned right away.
+         * @param image_file The full path to the image file.
+         * @return The texture, or \c nullptr if it is still being decoded (or failed to load).
+         */
+        static Texture *request_async(const std::string &image_file,
+                                      Texture::WrapMode wrap = Texture::CLAMP_TO_EDGE,
+                                      Texture::FilterMode filter = Texture::LINEAR);
+
+        /**
+         * @brief Enable/Disable the on-disk texture cache. Enabled by default.
+         * @details With the cache enabled, a texture created from an image file is transcoded once into
+         *          a GPU-compressed format with all mipmap levels, and stored next to the image (in a
+         *          ".e3d_tex" file). Subsequent loads of that image skip decoding, driver-side
+         *          compression, and mipmap generation: the ready-to-use levels are streamed to the GPU
+         *          directly. The cache is invalidated automatically when the image file changes.
+         * @note Caching requires the driver to support texture compression (GL_ARB_texture_compression).
+         */
+        static void set_disk_cache(bool enabled) { cache_to_disk_ = enabled; }
+        static bool disk_cache() { return cache_to_disk_; }
+
         /**
          * Release a texture (deallocate its memory).
          * @param texture The texture to be released.
          */
         static void release(const Texture *texture);
 
-        // destroy all textures.
+        // destroy all textures (and stop the background decoding workers).
         static void terminate();
 
+    private:
+        // creates a (compressed, mipmapped) texture from decoded image data, uploaded through a PBO
+        static Texture *create_from_decoded(const std::vector<unsigned char> &data, int width, int height,
+                                            int comp, Texture::WrapMode wrap, Texture::FilterMode filter);
+
+        // the on-disk transcoded cache of an image file
+        static Texture *load_cached(const std::string &image_file,
+                                    Texture::WrapMode wrap, Texture::FilterMode filter);
+        static bool write_cache(const std::string &image_file, Texture *texture);
+
     private:
         // maps of std::string can be super slow when calling find with a string literal or const char*
         // as find forces construction/copy/destruction of a std::sting copy of the const char*.
         static std::unordered_map<std::string, Texture *> textures_;
         static std::unordered_map<std::string, bool> attempt_load_texture_; // avoid multiple attempt
+
+        static bool cache_to_disk_;
     };
 
 
@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/renderer/tile_prefetcher.h>
+
+#include <chrono>
+#include <memory>
+
+#include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/key_frame_interpolator.h>
+#include <easy3d/renderer/manipulated_camera_frame.h>
+#include <easy3d/util/thread_pool.h>
+
+
+namespace easy3d {
+
+    namespace details {
+        // \cond
+        static double now_seconds() {
+            const auto t = std::chrono::steady_clock::now().time_since_epoch();
+            return std::chrono::duration<double>(t).count();
+        }
+        // \endcond
+    }
+
+
+    TilePrefetcher::TilePrefetcher()
+            : lookahead_(1.0f), max_loads_per_update_(4)
+            , has_history_(false), last_position_(0, 0, 0), last_time_(0.0) {
+    }
+
+
+    void TilePrefetcher::set_tiles(const std::vector<Box3>& tile_bboxes) {
+        tiles_ = tile_bboxes;
+        scheduled_.assign(tiles_.size(), 0);
+    }
+
+
+    void TilePrefetcher::reset() {
+        scheduled_.assign(tiles_.size(), 0);
+        has_history_ = false;
+    }
+
+
+    void TilePrefetcher::update(const Camera* camera, KeyFrameInterpolator* kfi /* = nullptr */) {
+        if (!camera || tiles_.empty() || !load_func_)
+            return;
+
+        // predict the camera pose lookahead_ seconds from now
+        Camera predicted(*camera);
+        bool have_prediction = false;
+        if (kfi && kfi->interpolationIsStarted() && kfi->numberOfKeyFrames() > 0) {
+            // the walkthrough follows the path: sample it ahead of the playback position
+            const double t = kfi->interpolationTime() + lookahead_ * kfi->interpolationSpeed();
+            const Frame fr = kfi->frameAtTime(t);
+            predicted.frame()->setPositionAndOrientation(fr.position(), fr.orientation());
+            have_prediction = true;
+        } else {
+            // free navigation: extrapolate the position along the current velocity. The
+            // orientation is kept, which is good enough since the frustum behind a turning
+            // camera mostly overlaps the predicted one.
+            const double now = details::now_seconds();
+            if (has_history_ && now > last_time_) {
+                const vec3 velocity = (camera->position() - last_position_) / static_cast<float>(now - last_time_);
+                predicted.frame()->setPosition(camera->position() + velocity * lookahead_);
+                have_prediction = true;
+            }
+            last_position_ = camera->position();
+            last_time_ = now;
+            has_history_ = true;
+        }
+        if (!have_prediction)
+            return;
+
+        // classify all tile boxes against the predicted frustum in one batch
+        std::unique_ptr<bool[]> visible(new bool[tiles_.size()]);
+        predicted.areVisible(tiles_.data(), tiles_.size(), visible.get());
+
+        // schedule the loads of the tiles about to become visible (bounded per call, so a
+        // teleporting camera does not flood the worker pool with stale requests)
+        std::size_t launched = 0;
+        for (std::size_t t = 0; t < tiles_.size() && launched < max_loads_per_update_; ++t) {
+            if (visible[t] && !scheduled_[t]) {
+                scheduled_[t] = 1;
+                const auto load = load_func_;
+                ThreadPool::global().run([load, t]() { load(t); });
+                ++launched;
+            }
+        }
+    }
+
+}   // namespace easy3d
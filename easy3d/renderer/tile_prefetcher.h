@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_RENDERER_TILE_PREFETCHER_H
+#define EASY3D_RENDERER_TILE_PREFETCHER_H
+
+#include <functional>
+#include <vector>
+
+#include <easy3d/core/types.h>
+
+
+namespace easy3d {
+
+    class Camera;
+    class KeyFrameInterpolator;
+
+    /**
+     * \brief Predictive prefetching of spatial tiles for walkthrough navigation.
+     * \class TilePrefetcher easy3d/renderer/tile_prefetcher.h
+     * \details When data is streamed in tiles (e.g., a PagedPointCloud served from a network
+     *      drive), loading a tile only once it enters the view frustum shows up as resolution
+     *      pop-in: the camera arrives before the data does. The prefetcher extrapolates the
+     *      camera a configurable time ahead — along the KeyFrameInterpolator path when a
+     *      playback is running, or along the current velocity otherwise — classifies the tile
+     *      bounding boxes against the predicted frustum, and schedules the tiles about to become
+     *      visible on the global thread pool before they are needed.
+     *
+     *      The prefetcher does not know how to load a tile; the client provides that as a
+     *      callback (e.g., touching PagedPointCloud::tile_points() to page the tile in, or
+     *      fetching an LOD level). The callback runs on a worker thread.
+     *
+     *      Usage example:
+     *      \code
+     *      TilePrefetcher prefetcher;
+     *      prefetcher.set_tiles(tile_bboxes);
+     *      prefetcher.set_load_func([&cloud](std::size_t t) {
+     *          std::size_t num;
+     *          cloud.tile_points(t, num);  // pages the tile in
+     *      });
+     *      // once per frame:
+     *      prefetcher.update(camera, kfi);
+     *      \endcode
+     */
+    class TilePrefetcher {
+    public:
+        TilePrefetcher();
+
+        /**
+         * \brief Registers the tile bounding boxes (one per tile, indexed as the load callback
+         *      expects them). Resets the scheduling state, so previously prefetched tiles may be
+         *      scheduled again.
+         */
+        void set_tiles(const std::vector<Box3>& tile_bboxes);
+
+        /**
+         * \brief Sets the function that loads one tile, identified by its index.
+         * \attention The function is executed on a worker of the global thread pool, possibly
+         *      for several tiles concurrently; it must be thread safe and must not touch any
+         *      OpenGL context.
+         */
+        void set_load_func(std::function<void(std::size_t)> func) { load_func_ = func; }
+
+        /// \brief How far ahead (in seconds) the camera is extrapolated. Default: 1 second.
+        void set_lookahead(float seconds) { lookahead_ = seconds; }
+        float lookahead() const { return lookahead_; }
+
+        /// \brief The maximum number of tile loads scheduled per update() call (so a fast camera
+        ///     cut does not flood the worker pool). Default: 4.
+        void set_max_loads_per_update(std::size_t num) { max_loads_per_update_ = num; }
+        std::size_t max_loads_per_update() const { return max_loads_per_update_; }
+
+        /**
+         * \brief Predicts the camera pose lookahead() seconds ahead and schedules the loads of
+         *      the tiles intersecting the predicted frustum. Call once per rendered frame.
+         * \param camera The camera of the viewer.
+         * \param kfi The interpolator driving the walkthrough; when it is interpolating, the
+         *      prediction follows the path. May be \c nullptr, in which case (and whenever no
+         *      playback is running) the current camera velocity is extrapolated instead.
+         */
+        void update(const Camera* camera, KeyFrameInterpolator* kfi = nullptr);
+
+        /// \brief Forgets the scheduling state and the motion history (e.g., after the camera
+        ///     jumped to an unrelated position, or after tiles have been evicted).
+        void reset();
+
+    private:
+        std::vector<Box3> tiles_;
+        std::vector<char> scheduled_;   // 1 for tiles whose load has been scheduled
+        std::function<void(std::size_t)> load_func_;
+
+        float lookahead_;
+        std::size_t max_loads_per_update_;
+
+        // motion history for the velocity-based extrapolation
+        bool   has_history_;
+        vec3   last_position_;
+        double last_time_;
+    };
+
+}   // namespace easy3d
+
+#endif  // EASY3D_RENDERER_TILE_PREFETCHER_H
@@ -333,6 +333,45 @@ namespace easy3d {
             return true;
         }
 
+        //----------------------- batched decomposition / composition -----------------------------
+
+        void decompose(const std::vector<mat4>& Ms, std::vector<vec3>& scalings, std::vector<quat>& rotations, std::vector<vec3>& translations) {
+            const std::size_t num = Ms.size();
+            scalings.resize(num);
+            rotations.resize(num);
+            translations.resize(num);
+            for (std::size_t i = 0; i < num; ++i)
+                decompose(Ms[i], scalings[i], rotations[i], translations[i]);
+        }
+
+        void decompose_no_scaling(const std::vector<mat4>& Ms, std::vector<quat>& rotations, std::vector<vec3>& translations) {
+            const std::size_t num = Ms.size();
+            rotations.resize(num);
+            translations.resize(num);
+            for (std::size_t i = 0; i < num; ++i)
+                decompose_no_scaling(Ms[i], rotations[i], translations[i]);
+        }
+
+        mat4 compose(const vec3& scaling, const quat& rotation, const vec3& translation) {
+            // M = T * R * S: scale the columns of the rotation matrix, then append the translation.
+            mat4 M = rotation.matrix();
+            for (int j = 0; j < 3; ++j) {
+                for (int i = 0; i < 3; ++i)
+                    M(i, j) *= scaling[j];
+            }
+            M(0, 3) = translation.x;
+            M(1, 3) = translation.y;
+            M(2, 3) = translation.z;
+            return M;
+        }
+
+        void compose(const std::vector<vec3>& scalings, const std::vector<quat>& rotations, const std::vector<vec3>& translations, std::vector<mat4>& Ms) {
+            const std::size_t num = scalings.size();
+            Ms.resize(num);
+            for (std::size_t i = 0; i < num; ++i)
+                Ms[i] = compose(scalings[i], rotations[i], translations[i]);
+        }
+
     }
 
 } // namespace easy3d
@@ -85,6 +85,44 @@ namespace easy3d {
          */
         bool decompose(const mat4& M, vec3& scaling, quat& rotation, vec3& translation, vec3& skew, vec4& persp);
 
+        /**
+         * @brief Decomposes a set of transformation matrices into their original components
+         *  @param Ms is the set of input transformation matrices
+         *  @param scalings receives the output scaling of each matrix (resized to Ms.size())
+         *  @param rotations receives the output rotation of each matrix (resized to Ms.size())
+         *  @param translations receives the output translation of each matrix (resized to Ms.size())
+         * \note This function can not handle skew and perspective transformation.
+         */
+        void decompose(const std::vector<mat4>& Ms, std::vector<vec3>& scalings, std::vector<quat>& rotations, std::vector<vec3>& translations);
+
+        /**
+         * @brief Decomposes a set of transformation matrices with no scaling into their original components
+         *  @param Ms is the set of input transformation matrices
+         *  @param rotations receives the output rotation of each matrix (resized to Ms.size())
+         *  @param translations receives the output translation of each matrix (resized to Ms.size())
+         * \note This function can not handle skew and perspective transformation.
+         */
+        void decompose_no_scaling(const std::vector<mat4>& Ms, std::vector<quat>& rotations, std::vector<vec3>& translations);
+
+        /**
+         * @brief Composes a transformation matrix from its components, i.e., M = T * R * S.
+         *  @param scaling the scaling for the x, y, z axes
+         *  @param rotation the rotation
+         *  @param translation the translation for the x, y, z axes
+         * \note This is the inverse of decompose(const mat4&, vec3&, quat&, vec3&).
+         */
+        mat4 compose(const vec3& scaling, const quat& rotation, const vec3& translation);
+
+        /**
+         * @brief Composes a set of transformation matrices from their components, i.e., M = T * R * S.
+         *  @param scalings the scaling of each matrix
+         *  @param rotations the rotation of each matrix
+         *  @param translations the translation of each matrix
+         *  @param Ms receives the output transformation matrices (resized to scalings.size())
+         * \note All input vectors must have the same size.
+         */
+        void compose(const std::vector<vec3>& scalings, const std::vector<quat>& rotations, const std::vector<vec3>& translations, std::vector<mat4>& Ms);
+
     }
 
 }
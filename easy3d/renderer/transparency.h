@@ -36,7 +36,7 @@ namespace easy3d {
     /**
      * \brief Base class for rendering with transparency
      * \class Transparency easy3d/renderer/transparency.h
-     * \see AverageColorBlending,
+     * \see AverageColorBlending, DualDepthPeeling, FragmentLinkedLists
      */
     class Transparency
     {
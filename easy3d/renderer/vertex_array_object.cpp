@@ -25,7 +25,9 @@
 #include <easy3d/renderer/vertex_array_object.h>
 
 #include <cassert>
+#include <cstring>
 
+#include <easy3d/renderer/frame_statistics.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/opengl_info.h>
 #include <easy3d/util/logging.h>
@@ -60,6 +62,19 @@ namespace easy3d {
 
 
 	VertexArrayObject::~VertexArrayObject() {
+        for (auto& entry : stream_buffers_) {
+            for (auto fence : entry.second.fences) {
+                if (fence)
+                    glDeleteSync(fence);
+            }
+            GLuint buffer = entry.first;
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &buffer);
+        }
+        stream_buffers_.clear();
+
 		if (id_ != 0) {
 			glDeleteVertexArrays(1, &id_);	easy3d_debug_log_gl_error;
 			id_ = 0;
@@ -101,6 +116,7 @@ namespace easy3d {
         glGenBuffers(1, &buffer);                       easy3d_debug_log_gl_error;
         glBindBuffer(GL_ARRAY_BUFFER, buffer);			easy3d_debug_log_gl_error;
         glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);		easy3d_debug_log_gl_error;
+        FrameStatistics::count_buffer_upload(size);
         glEnableVertexAttribArray(index);               easy3d_debug_log_gl_error;
         glVertexAttribPointer(index, int(dim), GL_FLOAT, GL_FALSE, 0, nullptr);		easy3d_debug_log_gl_error;
         if (glGetError() != GL_NO_ERROR) {
@@ -114,12 +130,90 @@ namespace easy3d {
 	}
 
 
+    bool VertexArrayObject::create_array_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size,
+                                                std::size_t dim, GLenum type, bool normalized, bool dynamic) {
+        release_buffer(buffer);
+		bind();
+        glGenBuffers(1, &buffer);                       easy3d_debug_log_gl_error;
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);			easy3d_debug_log_gl_error;
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);		easy3d_debug_log_gl_error;
+        FrameStatistics::count_buffer_upload(size);
+        glEnableVertexAttribArray(index);               easy3d_debug_log_gl_error;
+        glVertexAttribPointer(index, int(dim), type, normalized ? GL_TRUE : GL_FALSE, 0, nullptr);		easy3d_debug_log_gl_error;
+        if (glGetError() != GL_NO_ERROR) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);           easy3d_debug_log_gl_error;
+            glDeleteBuffers(1, &buffer);                easy3d_debug_log_gl_error;
+            buffer = 0;
+		}
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error;
+        release();
+        return (glGetError() == GL_NO_ERROR);
+	}
+
+
+    bool VertexArrayObject::create_interleaved_buffer(GLuint& buffer, const std::vector< std::pair<GLuint, std::size_t> >& attributes,
+                                                      const void* data, std::size_t size, bool dynamic) {
+        std::size_t stride = 0;
+        for (const auto& attr : attributes)
+            stride += attr.second;
+        stride *= sizeof(float);
+
+        release_buffer(buffer);
+        bind();
+        glGenBuffers(1, &buffer);                       easy3d_debug_log_gl_error;
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);			easy3d_debug_log_gl_error;
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);		easy3d_debug_log_gl_error;
+        FrameStatistics::count_buffer_upload(size);
+        std::size_t offset = 0;
+        for (const auto& attr : attributes) {
+            glEnableVertexAttribArray(attr.first);      easy3d_debug_log_gl_error;
+            glVertexAttribPointer(attr.first, int(attr.second), GL_FLOAT, GL_FALSE, GLsizei(stride),
+                                  reinterpret_cast<const void*>(offset));	easy3d_debug_log_gl_error;
+            offset += attr.second * sizeof(float);
+        }
+        if (glGetError() != GL_NO_ERROR) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);           easy3d_debug_log_gl_error;
+            glDeleteBuffers(1, &buffer);                easy3d_debug_log_gl_error;
+            buffer = 0;
+		}
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error;
+        release();
+        return (glGetError() == GL_NO_ERROR);
+	}
+
+
+    bool VertexArrayObject::create_instance_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size, bool dynamic) {
+        release_buffer(buffer);
+		bind();
+        glGenBuffers(1, &buffer);                       easy3d_debug_log_gl_error;
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);			easy3d_debug_log_gl_error;
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);		easy3d_debug_log_gl_error;
+        FrameStatistics::count_buffer_upload(size);
+        // a mat4 attribute is specified as four vec4 columns, each advancing once per instance
+        for (GLuint c = 0; c < 4; ++c) {
+            glEnableVertexAttribArray(index + c);       easy3d_debug_log_gl_error;
+            glVertexAttribPointer(index + c, 4, GL_FLOAT, GL_FALSE, GLsizei(16 * sizeof(float)),
+                                  reinterpret_cast<const void*>(c * 4 * sizeof(float)));	easy3d_debug_log_gl_error;
+            glVertexAttribDivisor(index + c, 1);        easy3d_debug_log_gl_error;
+        }
+        if (glGetError() != GL_NO_ERROR) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);           easy3d_debug_log_gl_error;
+            glDeleteBuffers(1, &buffer);                easy3d_debug_log_gl_error;
+            buffer = 0;
+		}
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error;
+        release();
+        return (glGetError() == GL_NO_ERROR);
+	}
+
+
     bool VertexArrayObject::create_element_buffer(GLuint &buffer, const void *data, std::size_t size, bool dynamic) {
         release_buffer(buffer);
 		bind();
         glGenBuffers(1, &buffer);                                           easy3d_debug_log_gl_error;
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);                      easy3d_debug_log_gl_error;
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);		easy3d_debug_log_gl_error;
+        FrameStatistics::count_buffer_upload(size);
         if (glGetError() != GL_NO_ERROR) {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);                       easy3d_debug_log_gl_error;
             glDeleteBuffers(1, &buffer);                                    easy3d_debug_log_gl_error;
@@ -131,6 +225,123 @@ namespace easy3d {
 	}
 
 
+    bool VertexArrayObject::update_array_buffer(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data) {
+		bind();
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);          easy3d_debug_log_gl_error;
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);		easy3d_debug_log_gl_error;
+        FrameStatistics::count_buffer_upload(static_cast<std::size_t>(size));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error;
+        release();
+        return (glGetError() == GL_NO_ERROR);
+	}
+
+
+    bool VertexArrayObject::set_array_buffer_offset(GLuint buffer, GLuint index, std::size_t offset, std::size_t dim) {
+		bind();
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);          easy3d_debug_log_gl_error;
+        glEnableVertexAttribArray(index);               easy3d_debug_log_gl_error;
+        glVertexAttribPointer(index, int(dim), GL_FLOAT, GL_FALSE, 0,
+                              reinterpret_cast<const void*>(offset));		easy3d_debug_log_gl_error;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error;
+        release();
+        return (glGetError() == GL_NO_ERROR);
+	}
+
+
+    bool VertexArrayObject::create_stream_buffer(GLuint& buffer, GLuint index, std::size_t size, std::size_t dim) {
+        if (!OpenglInfo::is_supported("GL_ARB_buffer_storage")) {
+            LOG_FIRST_N(WARNING, 1) << "persistently mapped buffers not supported on this platform (GL_ARB_buffer_storage required)";
+            return false;
+        }
+
+        release_stream_buffer(buffer);
+        release_buffer(buffer);
+		bind();
+        glGenBuffers(1, &buffer);                       easy3d_debug_log_gl_error;
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);			easy3d_debug_log_gl_error;
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size * 3), nullptr, flags);		easy3d_debug_log_gl_error;
+        void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(size * 3), flags);	easy3d_debug_log_gl_error;
+        glEnableVertexAttribArray(index);               easy3d_debug_log_gl_error;
+        glVertexAttribPointer(index, int(dim), GL_FLOAT, GL_FALSE, 0, nullptr);		easy3d_debug_log_gl_error;
+        if (!mapped || glGetError() != GL_NO_ERROR) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);           easy3d_debug_log_gl_error;
+            glDeleteBuffers(1, &buffer);                easy3d_debug_log_gl_error;
+            buffer = 0;
+            release();
+            return false;
+		}
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error;
+        release();
+
+        StreamState state;
+        state.mapped = mapped;
+        state.section_size = size;
+        state.section = 0;
+        state.fences[0] = state.fences[1] = state.fences[2] = nullptr;
+        stream_buffers_[buffer] = state;
+        return (glGetError() == GL_NO_ERROR);
+	}
+
+
+    bool VertexArrayObject::update_stream_buffer(GLuint buffer, GLuint index, const void* data, std::size_t size, std::size_t dim) {
+        auto pos = stream_buffers_.find(buffer);
+        if (pos == stream_buffers_.end()) {
+            LOG_FIRST_N(ERROR, 1) << "not a streaming buffer (create_stream_buffer() not called?)";
+            return false;
+        }
+        StreamState& state = pos->second;
+        if (size > state.section_size) {
+            LOG_FIRST_N(ERROR, 1) << "data size exceeds the section size of the streaming buffer";
+            return false;
+        }
+
+        // the GPU may still read from the section written two updates ago; the fence inserted
+        // when that section was left behind tells when it is safe to overwrite it.
+        const int section = (state.section + 1) % 3;
+        if (state.fences[section]) {
+            GLenum status;
+            do {
+                status = glClientWaitSync(state.fences[section], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+            } while (status == GL_TIMEOUT_EXPIRED);
+            glDeleteSync(state.fences[section]);
+            state.fences[section] = nullptr;
+        }
+
+        memcpy(static_cast<char*>(state.mapped) + section * state.section_size, data, size);
+        FrameStatistics::count_buffer_upload(size);
+
+        // all draw commands recorded so far read from the current section; fence it before rebinding
+        state.fences[state.section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);	easy3d_debug_log_gl_error;
+
+		bind();
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);			easy3d_debug_log_gl_error;
+        glEnableVertexAttribArray(index);               easy3d_debug_log_gl_error;
+        glVertexAttribPointer(index, int(dim), GL_FLOAT, GL_FALSE, 0,
+                              reinterpret_cast<const void*>(section * state.section_size));		easy3d_debug_log_gl_error;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error;
+        release();
+        state.section = section;
+        return (glGetError() == GL_NO_ERROR);
+	}
+
+
+    void VertexArrayObject::release_stream_buffer(GLuint& buffer) {
+        auto pos = stream_buffers_.find(buffer);
+        if (pos == stream_buffers_.end())
+            return;
+        for (auto fence : pos->second.fences) {
+            if (fence)
+                glDeleteSync(fence);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);          easy3d_debug_log_gl_error;
+        glUnmapBuffer(GL_ARRAY_BUFFER);                 easy3d_debug_log_gl_error;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);               easy3d_debug_log_gl_error;
+        stream_buffers_.erase(pos);
+        release_buffer(buffer);
+	}
+
+
     bool VertexArrayObject::create_storage_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size) {
         if (!OpenglInfo::is_supported("GL_ARB_shader_storage_buffer_object")) {
             LOG(ERROR) << "shader storage buffer object not supported on this platform";
@@ -141,6 +352,7 @@ namespace easy3d {
         glGenBuffers(1, &buffer);                                                   easy3d_debug_log_gl_error;
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);                             easy3d_debug_log_gl_error;
         glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(size), data, GL_DYNAMIC_DRAW);		easy3d_debug_log_gl_error;
+        FrameStatistics::count_buffer_upload(size);
         glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, buffer);                   easy3d_debug_log_gl_error;
         if (glGetError() != GL_NO_ERROR) {
             glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);                              easy3d_debug_log_gl_error;
@@ -157,6 +369,7 @@ namespace easy3d {
 		bind();
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);                     easy3d_debug_log_gl_error;
 		glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);		easy3d_debug_log_gl_error;
+        FrameStatistics::count_buffer_upload(static_cast<std::size_t>(size));
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);                          easy3d_debug_log_gl_error;
         release();                                                          easy3d_debug_log_gl_error;
         return (glGetError() == GL_NO_ERROR);
@@ -28,6 +28,9 @@
 #include <easy3d/renderer/opengl.h>
 
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 namespace easy3d {
@@ -74,10 +77,103 @@ namespace easy3d {
         bool create_array_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size, std::size_t dim, bool dynamic = false);
         bool create_element_buffer(GLuint& buffer, const void* data, std::size_t size, bool dynamic = false);
 
+        /**
+         * @brief Creates an OpenGL array buffer holding a vertex attribute of a non-float component
+         *        type (e.g., packed GL_INT_2_10_10_10_REV normals, GL_HALF_FLOAT texture coordinates,
+         *        or GL_UNSIGNED_BYTE colors) and uploads data to the buffer.
+         * @param type       The data type of each component.
+         * @param normalized Whether fixed-point components are mapped to [0, 1] (unsigned) or [-1, 1]
+         *                   (signed) when accessed; ignored for floating-point types.
+         * The other parameters are those of create_array_buffer().
+         * @return true on success.
+         */
+        bool create_array_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size, std::size_t dim,
+                                 GLenum type, bool normalized, bool dynamic = false);
+
+        /**
+         * @brief Creates a single OpenGL array buffer holding several interleaved (stride-packed) vertex attributes
+         *        and uploads data to the buffer. Compared to one buffer per attribute, the interleaved layout keeps
+         *        all attributes of a vertex adjacent in memory, which improves the attribute fetch on GPUs with
+         *        limited memory bandwidth (e.g., integrated GPUs).
+         * @param buffer     The name of the buffer object.
+         * @param attributes The per-vertex attributes in their packing order. Each entry is the index of the generic
+         *                   vertex attribute and its number of float components (must be 1, 2, 3, or 4).
+         * @param data       The pointer to the interleaved data.
+         * @param size       The size of the data in bytes.
+         * @param dynamic    The expected usage pattern is GL_STATIC_DRAW or GL_DYNAMIC_DRAW.
+         * @return true on success.
+         */
+        bool create_interleaved_buffer(GLuint& buffer, const std::vector< std::pair<GLuint, std::size_t> >& attributes,
+                                       const void* data, std::size_t size, bool dynamic = false);
+
+        /**
+         * @brief Creates an OpenGL array buffer holding per-instance mat4 transformations and uploads data
+         *        to the buffer. A mat4 attribute is specified as four vec4 columns on four consecutive
+         *        attribute locations, each advancing once per instance (glVertexAttribDivisor) instead of
+         *        once per vertex.
+         * @param buffer The name of the buffer object.
+         * @param index  The index of the first of the four generic vertex attributes.
+         * @param data   The pointer to the column-major matrices.
+         * @param size   The size of the data in bytes.
+         * @param dynamic The expected usage pattern is GL_STATIC_DRAW or GL_DYNAMIC_DRAW.
+         * @return true on success.
+         */
+        bool create_instance_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size, bool dynamic = false);
+
+        /**
+         * @brief Updates a sub-range of an existing array buffer (glBufferSubData). Much cheaper than re-creating
+         *        the buffer when only a small region of the data has changed.
+         * @param buffer The name of the buffer object.
+         * @param offset The offset into the buffer object's data store where data will be written, in bytes.
+         * @param size   The size of the data store region being written, in bytes.
+         * @param data   The pointer to the new data.
+         * @return true on success.
+         */
+        bool update_array_buffer(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data);
+
+        /**
+         * @brief Binds an existing array buffer to a vertex attribute starting at a byte offset into the
+         *        buffer's data store. This allows switching between several attribute sets stored in a
+         *        single buffer (e.g., per-time-step scalar fields) without any data transfer.
+         * @param buffer The name of the buffer object.
+         * @param index  The index of the generic vertex attribute to be enabled.
+         * @param offset The byte offset into the buffer object's data store where the attribute data starts.
+         * @param dim    The number of components per generic vertex attribute. Must be 1, 2, 3, 4.
+         * @return true on success.
+         */
+        bool set_array_buffer_offset(GLuint buffer, GLuint index, std::size_t offset, std::size_t dim);
+
 		// @param index: the index of the binding point.
         bool create_storage_buffer(GLuint& buffer, GLuint index, const void* data, std::size_t size);
         bool update_storage_buffer(GLuint& buffer, GLintptr offset, GLsizeiptr size, const void* data);
 
+        /**
+         * @brief Creates a persistently mapped streaming buffer for per-frame vertex attribute updates.
+         * @details The buffer is allocated with glBufferStorage at three times the requested size (triple
+         *        buffering) and stays mapped for its entire lifetime. Each call to update_stream_buffer() is then
+         *        a plain memcpy into the next section of the ring, guarded by fences so that a section is never
+         *        overwritten while the GPU may still read from it. This avoids the re-allocation and the implicit
+         *        synchronization of glBufferData() when the same buffer is re-uploaded every frame.
+         * @param buffer The name of the buffer object.
+         * @param index  The index of the generic vertex attribute to be enabled.
+         * @param size   The size of one section (i.e., of one update) in bytes.
+         * @param dim    The number of components per generic vertex attribute. Must be 1, 2, 3, 4.
+         * @return true on success. Requires GL_ARB_buffer_storage; when not supported, 'buffer' is left untouched
+         *        and the caller should fall back to create_array_buffer().
+         */
+        bool create_stream_buffer(GLuint& buffer, GLuint index, std::size_t size, std::size_t dim);
+
+        /**
+         * @brief Copies new data into the next section of a streaming buffer created by create_stream_buffer()
+         *        and rebinds the vertex attribute to that section.
+         * @param size The size of the data in bytes. Must not exceed the section size of the buffer.
+         * @return true on success.
+         */
+        bool update_stream_buffer(GLuint buffer, GLuint index, const void* data, std::size_t size, std::size_t dim);
+
+        // unmaps and frees the GPU memory of a streaming buffer (no-op for other buffers)
+        void release_stream_buffer(GLuint& buffer);
+
 		// free the GPU memory of the buffer specified by 'handle'
         static void release_buffer(GLuint& buffer);
 
@@ -102,6 +198,15 @@ namespace easy3d {
 	private:
 		GLuint	id_;
 
+        // the bookkeeping of a persistently mapped streaming buffer (see create_stream_buffer())
+        struct StreamState {
+            void*       mapped;         // the persistently mapped pointer (covers all three sections)
+            std::size_t section_size;   // the size of one section in bytes
+            int         section;        // the section the vertex attribute is currently bound to
+            GLsync      fences[3];      // per-section fences guarding against overwriting in-flight data
+        };
+        std::unordered_map<GLuint, StreamState> stream_buffers_;
+
     private:
         //copying disabled
         VertexArrayObject(const VertexArrayObject&);
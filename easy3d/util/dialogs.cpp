@@ -24,6 +24,7 @@
 
 #include <easy3d/util/dialogs.h>
 #include <easy3d/util/file_system.h>
+#include <easy3d/util/thread_pool.h>
 #include <3rd_party/portable_file_dialogs/portable_file_dialogs.h>
 
 
@@ -100,6 +101,34 @@ namespace easy3d {
     }
 
 
+    void dialog::open_async(
+            const std::string& title,
+            const std::string& default_directory,
+            const std::vector<std::string>& filters,
+            bool multiple,
+            std::function<void(const std::vector<std::string>&)> callback)
+    {
+        // the dialog itself lives in a subprocess (see portable_file_dialogs); only the wait for
+        // the user's choice blocks, and that wait is moved onto a worker thread here.
+        ThreadPool::global().run([=]() {
+            callback(open(title, default_directory, filters, multiple));
+        });
+    }
+
+
+    void dialog::save_async(
+            const std::string& title,
+            const std::string& default_file_name,
+            const std::vector<std::string>& filters,
+            bool confirm_overwrite,
+            std::function<void(const std::string&)> callback)
+    {
+        ThreadPool::global().run([=]() {
+            callback(save(title, default_file_name, filters, confirm_overwrite));
+        });
+    }
+
+
     void dialog::notify(
             const std::string& title,
             const std::string& message,
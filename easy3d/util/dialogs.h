@@ -25,6 +25,7 @@
 #ifndef EASY3D_UTIL_DIALOGS_H
 #define EASY3D_UTIL_DIALOGS_H
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -112,6 +113,42 @@ namespace easy3d
 
         // -----------------------------------------------------------------------------
 
+        /**
+         * \brief Open a native file open dialog without blocking the caller.
+         * \details The dialog runs on a worker of the global thread pool, so a render loop (or any
+         *      other work of the calling thread) keeps going while the dialog is shown. Once the
+         *      user has made a choice, \p callback is invoked with the selected file names (empty
+         *      if the dialog was cancelled).
+         * \attention The callback is executed on the worker thread. It must not touch the UI or
+         *      any OpenGL context directly; marshal the result back to the owner thread instead.
+         * \param callback The function to be invoked with the selected file names.
+         *      The other parameters are the same as those of open().
+         */
+        void open_async(
+                const std::string& title,
+                const std::string& default_directory,
+                const std::vector<std::string>& filters,
+                bool multiple,
+                std::function<void(const std::vector<std::string>&)> callback
+                );
+
+        /**
+         * \brief Open a native file save dialog without blocking the caller.
+         * \details See open_async() for the threading behavior. \p callback is invoked with the
+         *      chosen file name (empty if no file name was chosen).
+         * \attention The callback is executed on the worker thread. It must not touch the UI or
+         *      any OpenGL context directly; marshal the result back to the owner thread instead.
+         */
+        void save_async(
+                const std::string& title,
+                const std::string& default_file_name,
+                const std::vector<std::string>& filters,
+                bool confirm_overwrite,
+                std::function<void(const std::string&)> callback
+                );
+
+        // -----------------------------------------------------------------------------
+
         enum class Type {
              info = 0,
              warning,
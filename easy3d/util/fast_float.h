@@ -0,0 +1,227 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_UTIL_FAST_FLOAT_H
+#define EASY3D_UTIL_FAST_FLOAT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace easy3d {
+
+    namespace io {
+
+        /**
+         * \brief Fast parsing of decimal numbers from character ranges.
+         *
+         * \details The standard library conversions (strtod and stream extraction) dominate the
+         *      profile of the ASCII readers in easy3d/fileio, mostly due to locale handling and
+         *      per-character scanning. The parsers here classify and convert digits eight at a
+         *      time (SWAR: the eight bytes are loaded into one 64-bit word and checked/combined
+         *      with a few multiplications) and accumulate the decimal mantissa in an integer.
+         *      When mantissa and exponent are small enough that a single multiplication or
+         *      division by an exactly representable power of ten yields the correctly rounded
+         *      result (which covers virtually every coordinate in OBJ/OFF/XYZ files), that value
+         *      is returned directly; everything else - very long digit runs, extreme exponents,
+         *      and special forms like "inf", "nan" or hex floats - falls back to strtod, so the
+         *      results are always exactly those of the standard conversion.
+         *
+         * \attention The fast path expects '.' as the decimal separator, as all the file formats
+         *      parsed with it do. Input using a different separator simply ends the number at the
+         *      separator (the behavior strtod shows in the "C" locale regardless of the global
+         *      locale, which is what file parsers want).
+         */
+        namespace fast_float {
+
+            // \cond
+            namespace details {
+
+                inline uint64_t read8(const char* p) {
+                    uint64_t chunk;
+                    std::memcpy(&chunk, p, sizeof(chunk));
+                    return chunk;
+                }
+
+                // true if all eight bytes of the chunk are ASCII digits (little-endian SWAR test)
+                inline bool is_8digits(uint64_t chunk) {
+                    const uint64_t a = chunk + UINT64_C(0x4646464646464646);    // > '9' sets high nibble bits
+                    const uint64_t b = chunk - UINT64_C(0x3030303030303030);    // < '0' borrows
+                    return ((a | b) & UINT64_C(0x8080808080808080)) == 0;
+                }
+
+                // converts eight ASCII digits to their value with three multiplications
+                inline uint32_t parse_8digits(uint64_t chunk) {
+                    chunk -= UINT64_C(0x3030303030303030);
+                    chunk = (chunk * 10) + (chunk >> 8);                            // pairs
+                    chunk = ((chunk & UINT64_C(0x000000FF000000FF)) * (100 + (UINT64_C(1000000) << 32))
+                           + (((chunk >> 16) & UINT64_C(0x000000FF000000FF)) * (1 + (UINT64_C(10000) << 32)))) >> 32;
+                    return static_cast<uint32_t>(chunk);
+                }
+
+                inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+                // 10^0 .. 10^22 are exactly representable as doubles
+                inline const double* exact_powers_of_ten() {
+                    static const double powers[] = {
+                            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+                            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                    };
+                    return powers;
+                }
+
+                // the exact (but slower) route for everything the fast path cannot prove correct
+                inline const char* fallback(const char* begin, const char* end, double& value) {
+                    char buffer[128];
+                    const std::size_t len = (std::min<std::size_t>)(static_cast<std::size_t>(end - begin),
+                                                                    sizeof(buffer) - 1);
+                    std::memcpy(buffer, begin, len);
+                    buffer[len] = '\0';
+                    char* stop = nullptr;
+                    value = std::strtod(buffer, &stop);
+                    return begin + (stop - buffer);
+                }
+
+            }
+            // \endcond
+
+            /**
+             * \brief Parses a double from [\p begin, \p end).
+             * \details Leading blanks are skipped (as strtod does). On success, \p value receives
+             *      the number and the position just past it is returned. If no number could be
+             *      parsed, \p begin is returned and \p value is 0.
+             */
+            inline const char* parse_double(const char* begin, const char* end, double& value) {
+                value = 0.0;
+                const char* s = begin;
+                while (s < end && (*s == ' ' || *s == '\t'))
+                    ++s;
+
+                bool negative = false;
+                if (s < end && (*s == '+' || *s == '-')) {
+                    negative = (*s == '-');
+                    ++s;
+                }
+
+                if (end - s >= 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))    // hex floats
+                    return details::fallback(begin, end, value);
+
+                uint64_t mantissa = 0;
+                int num_digits = 0;
+                int exponent = 0;
+
+                // integer part, eight digits at a time while possible
+                while (end - s >= 8 && details::is_8digits(details::read8(s))) {
+                    mantissa = mantissa * UINT64_C(100000000) + details::parse_8digits(details::read8(s));
+                    num_digits += 8;
+                    s += 8;
+                }
+                while (s < end && details::is_digit(*s)) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*s - '0');
+                    ++num_digits;
+                    ++s;
+                }
+
+                // fraction
+                if (s < end && *s == '.') {
+                    ++s;
+                    while (end - s >= 8 && details::is_8digits(details::read8(s))) {
+                        mantissa = mantissa * UINT64_C(100000000) + details::parse_8digits(details::read8(s));
+                        num_digits += 8;
+                        exponent -= 8;
+                        s += 8;
+                    }
+                    while (s < end && details::is_digit(*s)) {
+                        mantissa = mantissa * 10 + static_cast<uint64_t>(*s - '0');
+                        ++num_digits;
+                        --exponent;
+                        ++s;
+                    }
+                }
+
+                if (num_digits == 0)    // no digits at all: "inf", "nan", "0x..." or garbage
+                    return details::fallback(begin, end, value);
+
+                // explicit exponent
+                if (s < end && (*s == 'e' || *s == 'E')) {
+                    const char* e = s + 1;
+                    bool exp_negative = false;
+                    if (e < end && (*e == '+' || *e == '-')) {
+                        exp_negative = (*e == '-');
+                        ++e;
+                    }
+                    if (e < end && details::is_digit(*e)) {     // otherwise the 'e' is not part of the number
+                        int exp_value = 0;
+                        while (e < end && details::is_digit(*e)) {
+                            if (exp_value < 10000)
+                                exp_value = exp_value * 10 + (*e - '0');
+                            ++e;
+                        }
+                        exponent += exp_negative ? -exp_value : exp_value;
+                        s = e;
+                    }
+                }
+
+                // fast path (Clinger): if the mantissa is exact in a double and the power of ten
+                // is exactly representable, one multiplication/division is correctly rounded
+                if (num_digits <= 19 && mantissa < (UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22) {
+                    value = static_cast<double>(mantissa);
+                    if (exponent < 0)
+                        value /= details::exact_powers_of_ten()[-exponent];
+                    else
+                        value *= details::exact_powers_of_ten()[exponent];
+                    if (negative)
+                        value = -value;
+                    return s;
+                }
+
+                return details::fallback(begin, end, value);
+            }
+
+            /// \brief Parses a float from [\p begin, \p end). \see parse_double().
+            inline const char* parse_float(const char* begin, const char* end, float& value) {
+                double d = 0.0;
+                const char* s = parse_double(begin, end, d);
+                value = static_cast<float>(d);
+                return s;
+            }
+
+            /// \brief Overload set for generic code parsing into either precision.
+            inline const char* parse_number(const char* begin, const char* end, double& value) {
+                return parse_double(begin, end, value);
+            }
+            /// \copydoc parse_number()
+            inline const char* parse_number(const char* begin, const char* end, float& value) {
+                return parse_float(begin, end, value);
+            }
+
+        }
+
+    }
+
+}
+
+#endif  // EASY3D_UTIL_FAST_FLOAT_H
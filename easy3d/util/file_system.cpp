@@ -25,6 +25,7 @@
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/string.h>
 #include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
 
 #include <fstream>
 #include <cassert>
@@ -307,6 +308,62 @@ namespace easy3d {
         }
 
 
+        // Lists a single directory and classifies its entries in the same pass, using the file
+        // type the OS already returns with the listing. This avoids the per-entry stat call that
+        // dominates get_files() on directories with many entries. Results are full paths.
+        static void scan_single_directory(const std::string& dir, std::vector<std::string>& files,
+                                          std::vector<std::string>& sub_dirs)
+        {
+    #if defined(WIN32) && !defined(__CYGWIN__)
+
+            std::string path = dir + "/*.*";
+            _finddata_t data;
+            intptr_t handle = _findfirst(path.c_str(), &data);
+            if (handle != -1) {
+                do {
+                    // "." and ".." seems always there on Windows
+                    if (std::strcmp(data.name, ".") == 0 || std::strcmp(data.name, "..") == 0)
+                        continue;
+                    if (data.attrib & _A_SUBDIR)
+                        sub_dirs.push_back(dir + "/" + data.name);
+                    else
+                        files.push_back(dir + "/" + data.name);
+                } while (_findnext(handle, &data) != -1);
+
+                _findclose(handle);
+            }
+    #else
+            DIR *handle = opendir(dir.c_str());
+            if (handle)
+            {
+                dirent *rc;
+                while ((rc = readdir(handle)) != nullptr) {
+                    // some OSs (e.g., macOS) may include ".", "..", and ".DS_Store" in directory entries
+                    if (std::strcmp(rc->d_name, ".") == 0 || std::strcmp(rc->d_name, "..") == 0 || std::strcmp(rc->d_name, ".DS_Store") == 0)
+                        continue;
+                    const std::string name = dir + "/" + rc->d_name;
+    #ifdef DT_DIR
+                    // not all file systems fill in d_type (e.g., XFS reports DT_UNKNOWN), so
+                    // fall back to stat for the entries where it is missing.
+                    if (rc->d_type == DT_DIR)
+                        sub_dirs.push_back(name);
+                    else if (rc->d_type == DT_REG)
+                        files.push_back(name);
+                    else
+    #endif
+                    {
+                        if (is_directory(name))
+                            sub_dirs.push_back(name);
+                        else if (is_file(name))
+                            files.push_back(name);
+                    }
+                }
+                closedir(handle);
+            }
+    #endif
+        }
+
+
         //_______________________OS-independent functions__________________________
 
 
@@ -617,6 +674,43 @@ namespace easy3d {
             }
         }
 
+        void get_files_parallel(const std::string& dir, std::vector<std::string>& result, bool recursive,
+                                const std::string& extension)
+        {
+            if (!is_directory(dir)) {
+                LOG(WARNING) << "directory does not exist: " << dir;
+                return;
+            }
+
+            // normalize the filter so "PLY", "ply", and ".ply" all match
+            std::string wanted = string::to_lowercase(extension);
+            if (!wanted.empty() && wanted[0] == '.')
+                wanted = wanted.substr(1);
+
+            // breadth-first: the directories of one level are independent of each other, so each
+            // level is scanned concurrently on the global thread pool.
+            std::vector<std::string> frontier(1, dir);
+            while (!frontier.empty()) {
+                std::vector< std::vector<std::string> > files(frontier.size());
+                std::vector< std::vector<std::string> > sub_dirs(frontier.size());
+                ThreadPool::global().parallel_for(0, frontier.size(),
+                    [&frontier, &files, &sub_dirs](std::size_t i) {
+                        scan_single_directory(frontier[i], files[i], sub_dirs[i]);
+                    }, 1);
+
+                std::vector<std::string> next;
+                for (std::size_t i = 0; i < frontier.size(); ++i) {
+                    for (std::size_t j = 0; j < files[i].size(); ++j) {
+                        if (wanted.empty() || file_system::extension(files[i][j], true) == wanted)
+                            result.push_back(files[i][j]);
+                    }
+                    if (recursive)
+                        next.insert(next.end(), sub_dirs[i].begin(), sub_dirs[i].end());
+                }
+                frontier.swap(next);
+            }
+        }
+
         void get_sub_directories(const std::string& dir, std::vector<std::string>& result, bool recursive) {
             std::vector<std::string> entries;
             get_directory_entries(dir, entries, recursive);
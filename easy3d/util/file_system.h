@@ -108,6 +108,24 @@ namespace easy3d {
          */
         void	get_files(const std::string& path, std::vector<std::string>& files, bool recursive);
 
+        /**
+         * @brief Queries file entries of a directory 'path', scanning subdirectories in parallel.
+         * @details Each directory is listed in a single pass that classifies its entries from the
+         *      information the OS already returns with the listing, avoiding the per-entry stat
+         *      calls of get_files(). Subdirectories of the same level are scanned concurrently on
+         *      the global thread pool, which matters for datasets organized as many thousands of
+         *      tile directories.
+         * @param path The full path of a directory.
+         * @param files Return the file entries of 'path'. Result strings are full paths.
+         * @param recursive Perform the query recursively if true.
+         * @param extension If not empty, only files with this extension (case-insensitive, with or
+         *        without the leading dot) are returned. Filtering during the scan avoids building
+         *        and then discarding the full entry list.
+         * @sa get_files(), get_directory_entries().
+         */
+        void	get_files_parallel(const std::string& path, std::vector<std::string>& files, bool recursive,
+                                   const std::string& extension = "");
+
         /**
          * @brief Query subdirectory entries of a directory 'path'.
          * @param path The full path of a directory.
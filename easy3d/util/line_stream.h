@@ -25,9 +25,12 @@
 #ifndef EASY3D_UTIL_LINE_STREAM_H
 #define EASY3D_UTIL_LINE_STREAM_H
 
+#include <cassert>
 #include <iostream>
 #include <sstream>
 
+#include <easy3d/util/fast_float.h>
+
 
 namespace easy3d {
 
@@ -78,7 +81,35 @@ namespace easy3d {
                 return *this;
             }
 
+            // floating-point extraction bypasses the stream (the standard extraction is by far
+            // the hottest part of the ASCII readers) and parses directly from the line buffer,
+            // keeping the stream position in sync
+            LineInputStream &operator>>(float &param) { return extract_number(param); }
+            LineInputStream &operator>>(double &param) { return extract_number(param); }
+
         private:
+            template<class T>
+            LineInputStream &extract_number(T &param) {
+                const std::streampos pos = line_in_->tellg();
+                if (pos < 0) {  // already at eof (or in a failed state): keep stream semantics
+                    *line_in_ >> param;
+                    return *this;
+                }
+                const char* begin = buffer_.c_str() + static_cast<std::size_t>(pos);
+                const char* end = buffer_.c_str() + buffer_.size();
+                while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r'))
+                    ++begin;
+                T value;
+                const char* stop = fast_float::parse_number(begin, end, value);
+                if (stop == begin) {    // not a number: let the stream set its failure state
+                    *line_in_ >> param;
+                    return *this;
+                }
+                param = value;
+                line_in_->seekg(static_cast<std::streamoff>(stop - buffer_.c_str()));
+                return *this;
+            }
+
             std::istream &in_;
             std::istringstream *line_in_;
             std::string buffer_;
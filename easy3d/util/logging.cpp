@@ -27,7 +27,11 @@
 
 #include <3rd_party/glog/src/utilities.h>
 
+#include <atomic>
+#include <cstdio>
 #include <iostream>
+#include <memory>
+#include <thread>
 
 
 namespace easy3d
@@ -36,6 +40,166 @@ namespace easy3d
 	namespace logging
 	{
 
+		// the directory and the file name prefix the synchronous log files were sent to (set by initialize()),
+		// needed to place the asynchronous log file next to them and to restore the destination on disable.
+		static std::string log_path_ = "";
+		static std::string log_dest_ = "";
+
+
+		namespace details {
+
+			// A bounded lock-free multi-producer queue of log messages (Dmitry Vyukov's array-based design:
+			// each cell carries a sequence number that tells whether it is ready to be written or read).
+			// Producers are the logging threads; the single consumer is the logger thread.
+			class MessageQueue
+			{
+			public:
+				explicit MessageQueue(std::size_t capacity) // capacity must be a power of two
+					: cells_(new Cell[capacity])
+					, mask_(capacity - 1)
+					, enqueue_pos_(0)
+					, dequeue_pos_(0)
+				{
+					for (std::size_t i = 0; i < capacity; ++i)
+						cells_[i].sequence.store(i, std::memory_order_relaxed);
+				}
+
+				// returns false if the queue is full (the message is not consumed then)
+				bool push(std::string& msg) {
+					std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+					Cell* cell = nullptr;
+					for (;;) {
+						cell = &cells_[pos & mask_];
+						const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+						const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+						if (diff == 0) {
+							if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+								break;
+						}
+						else if (diff < 0)  // the cell still holds a message the consumer has not read: full
+							return false;
+						else
+							pos = enqueue_pos_.load(std::memory_order_relaxed);
+					}
+					cell->data = std::move(msg);
+					cell->sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+
+				// returns false if the queue is empty. Single consumer only.
+				bool pop(std::string& msg) {
+					const std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+					Cell* cell = &cells_[pos & mask_];
+					const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+					if (static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1) < 0)
+						return false;
+					msg = std::move(cell->data);
+					cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+					dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+					return true;
+				}
+
+			private:
+				struct Cell {
+					std::atomic<std::size_t>	sequence;
+					std::string					data;
+				};
+				std::unique_ptr<Cell[]>		cells_;
+				const std::size_t			mask_;
+				std::atomic<std::size_t>	enqueue_pos_;
+				std::atomic<std::size_t>	dequeue_pos_;
+			};
+
+
+			// A glog sink that moves the file writes off the logging threads: send() (called on the thread
+			// that issued the LOG statement) only formats the message and enqueues it; a dedicated logger
+			// thread drains the queue and writes the messages to the log file in batches.
+			class AsyncSink : public google::LogSink
+			{
+			public:
+				explicit AsyncSink(const std::string& file_name)
+					: queue_(8192)
+					, stop_(false)
+					, dropped_(0)
+				{
+					file_ = std::fopen(file_name.c_str(), "a");
+					if (!file_)
+						std::cerr << "could not open log file: " << file_name << std::endl;
+					thread_ = std::thread(&AsyncSink::run, this);
+				}
+
+				~AsyncSink() override {
+					stop_.store(true, std::memory_order_release);
+					thread_.join();	// run() drains the queue before returning
+					if (file_)
+						std::fclose(file_);
+				}
+
+				void send(google::LogSeverity severity, const char* full_filename,
+						  const char* base_filename, int line, const struct ::tm* tm_time,
+						  const char* message, size_t message_len, google::int32 usecs) override
+				{
+					std::string msg = ToString(severity, base_filename, line, tm_time, message, message_len, usecs);
+					if (!queue_.push(msg)) {
+						if (severity <= google::GLOG_INFO)	// bounded-drop policy: low-severity spam is dropped
+							dropped_.fetch_add(1, std::memory_order_relaxed);
+						else {								// important messages wait for space instead
+							while (!queue_.push(msg))
+								std::this_thread::yield();
+						}
+					}
+				}
+
+				void send(google::LogSeverity severity, const char* full_filename,
+						  const char* base_filename, int line, const struct ::tm* tm_time,
+						  const char* message, size_t message_len) override
+				{
+					send(severity, full_filename, base_filename, line, tm_time, message, message_len, 0);
+				}
+
+			private:
+				void run() {
+					std::string msg;
+					std::string batch;
+					batch.reserve(64 * 1024);
+					for (;;) {
+						const bool stop = stop_.load(std::memory_order_acquire);
+						while (queue_.pop(msg)) {
+							batch += msg;
+							batch += '\n';
+							if (batch.size() >= 64 * 1024)
+								write(batch);
+						}
+						const unsigned long dropped = dropped_.exchange(0, std::memory_order_relaxed);
+						if (dropped > 0)
+							batch += "W [async logging] dropped " + std::to_string(dropped) + " INFO message(s) (queue was full)\n";
+						if (!batch.empty())
+							write(batch);
+						if (stop)	// stop was requested before the drain above: the queue is now empty
+							return;
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					}
+				}
+
+				void write(std::string& batch) {
+					if (file_) {
+						std::fwrite(batch.data(), 1, batch.size(), file_);
+						std::fflush(file_);
+					}
+					batch.clear();
+				}
+
+			private:
+				MessageQueue				queue_;
+				std::thread					thread_;
+				std::atomic<bool>			stop_;
+				std::atomic<unsigned long>	dropped_;
+				std::FILE*					file_;
+			};
+
+		}
+
+
 		void initialize(bool severity_dependent, const std::string& log_dir, int stderr_threshold)
 		{
 			// Ensures the library will not be initialized more than once.
@@ -64,11 +228,12 @@ namespace easy3d
 				file_system::create_directory(log_path);
 			LOG_IF(ERROR, !file_system::is_directory(log_path)) << "could not create log directory: " << log_path;
 
+			log_path_ = log_path;
 			if (severity_dependent) // create a log file for each severity level
 				FLAGS_log_dir = log_path;
 			else {
-			    const std::string& dest = log_path + "/" + file_system::base_name(app_path) + "-";
-                google::SetLogDestination(google::GLOG_INFO, dest.c_str());
+			    log_dest_ = log_path + "/" + file_system::base_name(app_path) + "-";
+                google::SetLogDestination(google::GLOG_INFO, log_dest_.c_str());
 			}
 
 			FLAGS_stderrthreshold = stderr_threshold;
@@ -86,6 +251,43 @@ namespace easy3d
 			DLOG(INFO) << "executable path: " << file_system::executable_directory();
 			DLOG(INFO) << "current working dir: " << file_system::current_working_directory();
 		}
+
+
+		void set_asynchronous(bool enabled)
+		{
+			static details::AsyncSink* sink = nullptr;
+			if (enabled) {
+				if (sink)
+					return;
+				std::string log_path = log_path_;
+				if (log_path.empty()) {	// initialize() was not called; fall back to its default location
+					log_path = file_system::parent_directory(file_system::executable()) + "/logs";
+					if (!file_system::is_directory(log_path))
+						file_system::create_directory(log_path);
+				}
+				const std::string file_name = log_path + "/" + file_system::base_name(file_system::executable()) + "-async.log";
+				sink = new details::AsyncSink(file_name);
+				google::AddLogSink(sink);
+				// stop glog's own synchronous log files; the messages now reach the disk through the sink
+				// (stderr output is not affected and still honors the threshold given to initialize()).
+				for (int severity = 0; severity < google::NUM_SEVERITIES; ++severity)
+					google::SetLogDestination(severity, "");
+				DLOG(INFO) << "asynchronous logging enabled: " << file_name;
+			}
+			else {
+				if (!sink)
+					return;
+				google::RemoveLogSink(sink);
+				delete sink;	// drains the queue and joins the logger thread
+				sink = nullptr;
+				// restore the synchronous log files set up by initialize()
+				if (!log_dest_.empty())
+					google::SetLogDestination(google::GLOG_INFO, log_dest_.c_str());
+				else if (!log_path_.empty())
+					FLAGS_log_dir = log_path_;
+				DLOG(INFO) << "asynchronous logging disabled";
+			}
+		}
 	}
 
 }
@@ -62,6 +62,21 @@ namespace easy3d
 		 */
 		void initialize(bool severity_dependent = false, const std::string& log_dir = "", int stderr_threshold = google::GLOG_WARNING);
 
+		/**
+		 * @brief Enable/Disable the asynchronous logging backend.
+		 * @details With the asynchronous backend enabled, a log call only formats its message and pushes it
+		 * 		onto a lock-free queue; a dedicated logger thread drains the queue and writes the messages to
+		 * 		"<app>-async.log" (next to the regular log files) in batches. This removes the file write
+		 * 		latency from the calling threads, which matters for pipelines logging per-item progress at a
+		 * 		high rate. When the queue is full, messages of INFO severity are dropped (a summary with the
+		 * 		dropped count is written instead of stalling the pipeline), while WARNING and above wait for
+		 * 		space. Messages are still sent to stderr according to the threshold given to initialize();
+		 * 		FATAL messages are additionally handled by glog itself before aborting.
+		 * 		Disabling drains the queue, joins the logger thread, and restores the synchronous log files.
+		 * @note Call this after initialize().
+		 */
+		void set_asynchronous(bool enabled);
+
 	}
 
 }
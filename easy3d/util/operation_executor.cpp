@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/util/operation_executor.h>
+#include <easy3d/util/thread_pool.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    OperationExecutor::OperationExecutor()
+        : num_pending_(0)
+    {
+    }
+
+
+    OperationExecutor::~OperationExecutor() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return num_pending_ == 0; });
+        LOG_IF(WARNING, !finished_.empty()) << finished_.size()
+            << " operation(s) finished but their results were never polled";
+    }
+
+
+    void OperationExecutor::submit(const void* model, const std::string& name, Task job, Task on_finished) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto& queue = queues_[model];
+        queue.push_back(Operation());
+        queue.back().name = name;
+        queue.back().job = job;
+        queue.back().on_finished = on_finished;
+        ++num_pending_;
+
+        LOG_IF(INFO, queue.size() > 1) << "operation '" << name << "' queued behind '"
+                                       << queue.front().name << "' (same model)";
+        if (queue.size() == 1)
+            dispatch_front(model);
+    }
+
+
+    void OperationExecutor::dispatch_front(const void* model) {
+        // the Operation stays at the front of its queue while running; only name/job/on_finished
+        // are needed here, and they are copied so the deque may grow meanwhile
+        const Operation op = queues_[model].front();
+        ThreadPool::global().run([this, model, op]() {
+            op.job();
+
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (op.on_finished)
+                finished_.push_back(op.on_finished);
+            --num_pending_;
+
+            auto& queue = queues_[model];
+            queue.pop_front();
+            if (queue.empty())
+                queues_.erase(model);
+            else
+                dispatch_front(model);  // the next operation on this model
+            condition_.notify_all();
+        });
+    }
+
+
+    std::size_t OperationExecutor::poll_finished() {
+        std::vector<Task> callbacks;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            callbacks.swap(finished_);
+        }
+        for (std::size_t i = 0; i < callbacks.size(); ++i)
+            callbacks[i]();
+        return callbacks.size();
+    }
+
+
+    bool OperationExecutor::is_busy(const void* model) const {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return queues_.find(model) != queues_.end();
+    }
+
+
+    std::size_t OperationExecutor::num_pending() const {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return num_pending_;
+    }
+
+
+    void OperationExecutor::wait_all() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return num_pending_ == 0; });
+        }
+        poll_finished();
+    }
+
+}   // namespace easy3d
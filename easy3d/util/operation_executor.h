@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_UTIL_OPERATION_EXECUTOR_H
+#define EASY3D_UTIL_OPERATION_EXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace easy3d {
+
+    /**
+     * \brief Runs long operations in the background, serialized per model.
+     * \class OperationExecutor easy3d/util/operation_executor.h
+     *
+     * \details An application (e.g., Mapple) submits each algorithm invocation together with a key
+     *      identifying the model it operates on. Operations bound to the same model run one after
+     *      another in submission order (two algorithms never mutate one model concurrently);
+     *      operations on different models run concurrently on the workers of ThreadPool::global().
+     *
+     *      The jobs run on worker threads, but their completion callbacks do not: they are queued
+     *      and executed by poll_finished(), which the owner of the results (typically the UI
+     *      thread, from a timer or idle hook) calls periodically. This is what makes the result
+     *      hand-over atomic from the UI's point of view - the viewer never observes an operation's
+     *      output until its callback installs it, on the UI thread, in one piece.
+     *
+     *      Usage example (from a GUI action):
+     *      \code
+     *      auto result = std::make_shared<SurfaceMesh*>(nullptr);
+     *      executor->submit(cloud, "Poisson reconstruction",
+     *          [=]() { *result = reconstruct(cloud); },          // on a worker
+     *          [=]() { if (*result) viewer->addModel(*result); } // on the polling thread
+     *      );
+     *      \endcode
+     *
+     * \note Cancellation goes through the existing progress::cancel() mechanism, which is
+     *      process-wide: it stops every running operation, not a single one.
+     */
+    class OperationExecutor {
+    public:
+        typedef std::function<void()> Task;
+
+    public:
+        OperationExecutor();
+        /// \brief Waits for all submitted operations (like wait_all(), but discards the
+        /// completion callbacks that have not been polled).
+        ~OperationExecutor();
+
+        /**
+         * \brief Submits an operation.
+         * \param model Identifies the data the operation mutates (any stable pointer works; it is
+         *      only compared, never dereferenced). Operations with the same \p model are
+         *      serialized; operations with different models run concurrently.
+         * \param name A short description (for logging and progress display).
+         * \param job The operation itself. Runs on a worker of ThreadPool::global().
+         * \param on_finished Runs after \p job, but on the thread calling poll_finished() - put
+         *      the result hand-over (adding models to the viewer, updating the UI) here. May be
+         *      empty.
+         */
+        void submit(const void* model, const std::string& name, Task job, Task on_finished = Task());
+
+        /**
+         * \brief Executes the completion callbacks of all operations that finished since the last
+         *      call, on the calling thread, in completion order.
+         * \return The number of callbacks executed.
+         */
+        std::size_t poll_finished();
+
+        /// \brief True if an operation bound to \p model is currently queued or running. GUIs use
+        /// this to grey out actions on a busy model instead of queueing surprises.
+        bool is_busy(const void* model) const;
+
+        /// \brief The number of operations submitted but not yet finished.
+        std::size_t num_pending() const;
+
+        /// \brief Blocks until all submitted operations have finished, then runs their completion
+        /// callbacks (so it may only be called from the thread that normally polls).
+        void wait_all();
+
+    private:
+        struct Operation {
+            std::string name;
+            Task        job;
+            Task        on_finished;
+        };
+
+        // dispatches the front operation of the queue of \p model to the thread pool.
+        // \attention mutex_ must be held by the caller.
+        void dispatch_front(const void* model);
+
+    private:
+        mutable std::mutex      mutex_;
+        std::condition_variable condition_;     // signaled when an operation finishes
+
+        // per-model FIFO; the front operation is the queued or running one
+        std::unordered_map<const void*, std::deque<Operation> > queues_;
+        std::vector<Task>       finished_;      // completion callbacks awaiting poll_finished()
+        std::size_t             num_pending_;
+
+        // copying the executor makes no sense (the workers hold pointers into it)
+        OperationExecutor(const OperationExecutor&);
+        OperationExecutor& operator=(const OperationExecutor&);
+    };
+
+}   // namespace easy3d
+
+
+#endif  // EASY3D_UTIL_OPERATION_EXECUTOR_H
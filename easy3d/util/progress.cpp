@@ -27,6 +27,8 @@
 
 #include <cassert>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 
 
 namespace easy3d {
@@ -47,16 +49,30 @@ namespace easy3d {
 
             void cancel() { canceled_ = true; }
             void clear_canceled() { canceled_ = false; }
-            bool is_canceled() const { return canceled_; }
+            bool is_canceled() const {
+                if (canceled_)
+                    return true;
+                // the time budget counts from the start of the top-level operation
+                if (budget_seconds_ > 0.0 && level_ > 0) {
+                    const auto elapsed = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start_time_).count();
+                    return elapsed > budget_seconds_;
+                }
+                return false;
+            }
+
+            void set_time_budget(double seconds) { budget_seconds_ = seconds; }
 
         protected:
-            Progress() : client_(nullptr), level_(0), canceled_(false) {}
+            Progress() : client_(nullptr), level_(0), canceled_(false), budget_seconds_(0.0) {}
 
             virtual ~Progress() {}
 
             ProgressClient *client_;
             int level_;
-            bool canceled_;
+            std::atomic<bool> canceled_;    // may be set from another thread (e.g., a GUI button)
+            double budget_seconds_;
+            std::chrono::steady_clock::time_point start_time_;
         };
 
         Progress* Progress::instance() {
@@ -68,6 +84,7 @@ namespace easy3d {
             level_++;
             if (level_ == 1) {
                 clear_canceled();
+                start_time_ = std::chrono::steady_clock::now();
             }
         }
 
@@ -86,6 +103,25 @@ namespace easy3d {
     //_________________________________________________________
 
 
+    namespace progress {
+
+        void cancel() {
+            details::Progress::instance()->cancel();
+        }
+
+        bool is_canceled() {
+            return details::Progress::instance()->is_canceled();
+        }
+
+        void set_time_budget(double seconds) {
+            details::Progress::instance()->set_time_budget(seconds);
+        }
+
+    }
+
+    //_________________________________________________________
+
+
     ProgressClient::ProgressClient() {
         details::Progress::instance()->set_client(this);
     }
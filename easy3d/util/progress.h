@@ -31,6 +31,36 @@
 
 namespace easy3d {
 
+    /**
+     * \brief Cooperative cancellation of long-running operations.
+     * \details Long-running loops in the library check ProgressLogger::is_canceled() at chunk
+     *      boundaries (per iteration, per round, ...) and, when it reports true, stop early and
+     *      return their current result (partial or unchanged, but always in a valid state). A
+     *      cancellation can be requested explicitly - from any thread, typically a GUI button
+     *      via ProgressClient::cancel() or directly via progress::cancel() - or implicitly by
+     *      giving the operation a time budget.
+     */
+    namespace progress {
+
+        /// \brief Requests cancellation of the running operation. Thread-safe.
+        void cancel();
+
+        /// \brief True if cancellation has been requested (or the time budget is exhausted).
+        bool is_canceled();
+
+        /**
+         * \brief Sets a time budget for the operations that follow ("give me the best result
+         *      within \p seconds seconds").
+         * \details Once an operation has run longer than the budget, is_canceled() reports true
+         *      and anytime-capable algorithms (e.g., simplification, smoothing, remeshing) stop
+         *      at the next chunk boundary, keeping the best result computed so far. The timing
+         *      of an operation starts when its first ProgressLogger is created.
+         * \param seconds The budget. 0 (the default) means no budget.
+         */
+        void set_time_budget(double seconds);
+
+    }
+
     /**
      * \brief The based class of GUI element reporting the progress.
      * \class ProgressClient easy3d/util/progress.h
@@ -0,0 +1,168 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/util/thread_pool.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    thread_local ThreadPool* ThreadPool::current_pool_ = nullptr;
+    thread_local int ThreadPool::worker_index_ = -1;
+
+    std::mutex  ThreadPool::global_mutex_;
+    ThreadPool* ThreadPool::global_pool_ = nullptr;
+    int         ThreadPool::global_num_workers_ = 0;
+
+
+    ThreadPool::ThreadPool(int num_workers)
+        : num_queued_(0)
+        , num_pending_(0)
+        , next_queue_(0)
+        , stop_(false)
+    {
+        if (num_workers <= 0)
+            num_workers = std::max(1u, std::thread::hardware_concurrency());
+
+        queues_.reserve(num_workers);
+        for (int i = 0; i < num_workers; ++i)
+            queues_.emplace_back(new WorkerQueue);
+
+        workers_.reserve(num_workers);
+        for (int i = 0; i < num_workers; ++i)
+            workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+
+
+    ThreadPool::~ThreadPool() {
+        wait();
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            stop_.store(true);
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+
+    void ThreadPool::run(std::function<void()> task) {
+        num_pending_.fetch_add(1);
+
+        // workers push to their own queue (popped back-first, i.e., cache-warm subtasks run first,
+        // while idle workers steal from the front); external submissions are spread round-robin.
+        std::size_t index;
+        if (current_pool_ == this)
+            index = static_cast<std::size_t>(worker_index_);
+        else
+            index = next_queue_.fetch_add(1) % queues_.size();
+
+        {
+            std::lock_guard<std::mutex> guard(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        num_queued_.fetch_add(1);
+        condition_.notify_one();
+    }
+
+
+    void ThreadPool::wait() {
+        if (current_pool_ == this) {
+            LOG_FIRST_N(ERROR, 1) << "ThreadPool::wait() called from a worker thread of the pool "
+                                     "(ignored to avoid a deadlock). (this is the first record)";
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_condition_.wait(lock, [this]() { return num_pending_.load() == 0; });
+    }
+
+
+    bool ThreadPool::try_execute_one() {
+        std::function<void()> task;
+        const std::size_t num_queues = queues_.size();
+        const std::size_t self = (current_pool_ == this) ? static_cast<std::size_t>(worker_index_) : 0;
+
+        // own queue first: pop from the back
+        {
+            WorkerQueue& queue = *queues_[self];
+            std::lock_guard<std::mutex> guard(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+        }
+        // then steal from the front of the other queues
+        for (std::size_t i = 1; !task && i < num_queues; ++i) {
+            WorkerQueue& queue = *queues_[(self + i) % num_queues];
+            std::lock_guard<std::mutex> guard(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+        if (!task)
+            return false;
+
+        num_queued_.fetch_sub(1);
+        task();
+        if (num_pending_.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            idle_condition_.notify_all();
+        }
+        return true;
+    }
+
+
+    void ThreadPool::worker_loop(int index) {
+        current_pool_ = this;
+        worker_index_ = index;
+        for (;;) {
+            if (try_execute_one())
+                continue;
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return stop_.load() || num_queued_.load() > 0; });
+            if (stop_.load() && num_queued_.load() == 0)
+                return;
+        }
+    }
+
+
+    ThreadPool& ThreadPool::global() {
+        std::lock_guard<std::mutex> guard(global_mutex_);
+        if (!global_pool_)
+            global_pool_ = new ThreadPool(global_num_workers_);
+        return *global_pool_;
+    }
+
+
+    void ThreadPool::set_global_num_workers(int num_workers) {
+        std::lock_guard<std::mutex> guard(global_mutex_);
+        global_num_workers_ = num_workers;
+        if (global_pool_) {     // finishes the pending tasks of the old pool
+            delete global_pool_;
+            global_pool_ = nullptr;
+        }
+    }
+
+}
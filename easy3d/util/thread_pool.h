@@ -0,0 +1,201 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_UTIL_THREAD_POOL_H
+#define EASY3D_UTIL_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace easy3d {
+
+    /**
+     * \brief A shared pool of worker threads with a work-stealing scheduler.
+     * \class ThreadPool easy3d/util/thread_pool.h
+     *
+     * \details Each worker owns a double-ended task queue: it pushes and pops its own tasks at the
+     *      back and steals from the front of the queues of other workers when its own runs dry, so
+     *      unbalanced workloads spread across the pool automatically.
+     *
+     *      Library code should use the process-wide pool returned by global() instead of spawning
+     *      its own threads, so that concurrently running operations share one set of workers and
+     *      the machine is not oversubscribed. The worker count of the global pool can be configured
+     *      with set_global_num_workers() (e.g., to leave cores free for the UI).
+     *
+     *      Usage example:
+     *      \code
+     *      // run a task in the background
+     *      ThreadPool::global().run([]() { ... });
+     *      // process a range in parallel, at least 64 elements per task
+     *      ThreadPool::global().parallel_for(0, data.size(), [&](std::size_t i) {
+     *          process(data[i]);
+     *      }, 64);
+     *      \endcode
+     */
+    class ThreadPool {
+    public:
+        /**
+         * \brief Creates a pool with \p num_workers worker threads.
+         * \param num_workers The number of workers. 0 (the default) uses the hardware concurrency.
+         */
+        explicit ThreadPool(int num_workers = 0);
+
+        /// \brief Waits for all submitted tasks to finish and joins the workers.
+        ~ThreadPool();
+
+        /**
+         * \brief Submits a task for asynchronous execution.
+         * \details When called from a worker of this pool, the task goes to the worker's own queue
+         *      (and may be stolen by idle workers), so tasks may safely submit subtasks.
+         */
+        void run(std::function<void()> task);
+
+        /**
+         * \brief Blocks until all tasks submitted so far have finished.
+         * \attention Must not be called from a worker thread of this pool (a task waiting for all
+         *      tasks would wait for itself). Worker threads can use parallel_for(), which helps
+         *      executing tasks instead of blocking.
+         */
+        void wait();
+
+        /**
+         * \brief Applies \p func to every index in [\p begin, \p end), distributing contiguous
+         *      chunks of the range over the workers.
+         * \param grain_size The minimum number of indices per task. Small grains balance better,
+         *      large grains have less scheduling overhead. The default (0) aims at four tasks per
+         *      worker. Ranges not larger than one grain run in the calling thread.
+         * \details The function returns only after the whole range has been processed. The calling
+         *      thread participates in the work, so parallel_for() may be nested inside tasks.
+         */
+        template <typename Func>
+        void parallel_for(std::size_t begin, std::size_t end, const Func& func, std::size_t grain_size = 0);
+
+        /// \brief The number of worker threads of this pool.
+        int num_workers() const { return static_cast<int>(workers_.size()); }
+
+        /// \brief The process-wide pool shared by the library (created on first use).
+        static ThreadPool& global();
+
+        /**
+         * \brief Sets the worker count of the global pool.
+         * \details If the global pool already exists, it finishes its pending tasks and is
+         *      recreated with the new worker count. 0 restores the hardware concurrency.
+         */
+        static void set_global_num_workers(int num_workers);
+
+    private:
+        // executes one queued task (own queue first, then stealing); false if all queues are empty
+        bool try_execute_one();
+
+        void worker_loop(int index);
+
+        // a latch shared by the tasks of one parallel_for() call
+        struct RangeLatch {
+            std::atomic<std::size_t>    count;
+            std::mutex                  mutex;
+            std::condition_variable     condition;
+        };
+
+    private:
+        struct WorkerQueue {
+            std::mutex                          mutex;
+            std::deque<std::function<void()> >  tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue> >  queues_;
+        std::vector<std::thread>                    workers_;
+
+        std::mutex                  mutex_;             // guards sleeping / waking
+        std::condition_variable     condition_;         // wakes workers when tasks arrive
+        std::condition_variable     idle_condition_;    // wakes wait() when the pool drains
+        std::atomic<std::size_t>    num_queued_;        // tasks sitting in the queues
+        std::atomic<std::size_t>    num_pending_;       // tasks queued or executing
+        std::atomic<std::size_t>    next_queue_;        // round-robin cursor for external submissions
+        std::atomic<bool>           stop_;
+
+        // identifies worker threads (for queue affinity and for helping in parallel_for)
+        static thread_local ThreadPool* current_pool_;
+        static thread_local int         worker_index_;
+
+        // the global pool
+        static std::mutex   global_mutex_;
+        static ThreadPool*  global_pool_;
+        static int          global_num_workers_;
+    };
+
+
+    template <typename Func>
+    void ThreadPool::parallel_for(std::size_t begin, std::size_t end, const Func& func, std::size_t grain_size) {
+        if (begin >= end)
+            return;
+
+        const std::size_t count = end - begin;
+        if (grain_size == 0)
+            grain_size = std::max<std::size_t>(std::size_t(1), count / (num_workers() * 4 + 1));
+        if (count <= grain_size || workers_.empty()) {
+            for (std::size_t i = begin; i < end; ++i)
+                func(i);
+            return;
+        }
+
+        const std::size_t num_tasks = (count + grain_size - 1) / grain_size;
+        auto latch = std::make_shared<RangeLatch>();
+        latch->count.store(num_tasks);
+
+        for (std::size_t t = 0; t < num_tasks; ++t) {
+            const std::size_t chunk_begin = begin + t * grain_size;
+            const std::size_t chunk_end = std::min(chunk_begin + grain_size, end);
+            run([&func, chunk_begin, chunk_end, latch]() {
+                for (std::size_t i = chunk_begin; i < chunk_end; ++i)
+                    func(i);
+                if (latch->count.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> guard(latch->mutex);
+                    latch->condition.notify_all();
+                }
+            });
+        }
+
+        // the calling thread helps executing tasks (not necessarily its own chunks) until the
+        // whole range is done. This also makes nested parallel_for() calls deadlock-free.
+        while (latch->count.load() > 0) {
+            if (!try_execute_one()) {
+                std::unique_lock<std::mutex> lock(latch->mutex);
+                latch->condition.wait_for(lock, std::chrono::milliseconds(1),
+                                          [&latch]() { return latch->count.load() == 0; });
+            }
+        }
+    }
+
+}
+
+#endif  // EASY3D_UTIL_THREAD_POOL_H
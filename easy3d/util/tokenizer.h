@@ -38,6 +38,8 @@
 #include <string>
 #include <cstdlib>
 
+#include <easy3d/util/fast_float.h>
+
 #define NV_MAX_TOKEN_LEN  1024
 #define NV_MAX_DELIM_COUNT  16
 
@@ -302,7 +304,7 @@ namespace easy3d {
 				out = 0;
 				return false;
 			}
-			out = (float)strtod(mTokBuf, nullptr);
+			io::fast_float::parse_float(mTokBuf, mTokBuf + mTokLen, out);
 			return true;
 		}
 
@@ -320,7 +322,7 @@ namespace easy3d {
 				}
 				if (!readToken())
 					break; // so we return what we've got.
-				out[i++] = (float)strtod(mTokBuf, nullptr);
+				io::fast_float::parse_float(mTokBuf, mTokBuf + mTokLen, out[i++]);
 
 				// OPTIONALLY consume a delimiter between each number.
 				delim = consumeOneDelim();
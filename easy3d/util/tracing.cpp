@@ -0,0 +1,154 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/util/tracing.h>
+
+#ifdef EASY3D_ENABLE_TRACING
+
+#include <easy3d/util/logging.h>
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+
+namespace easy3d {
+
+    namespace tracing {
+
+        namespace details {
+
+            // how many zones each thread keeps; older zones are overwritten when the buffer is full
+            static const std::size_t buffer_capacity = 65536;
+
+            struct ThreadBuffer {
+                struct Event {
+                    const char* name;
+                    uint64_t    start;
+                    uint64_t    end;
+                };
+
+                explicit ThreadBuffer(int id)
+                    : events(buffer_capacity), head(0), wrapped(false), thread_id(id) {
+                }
+
+                std::vector<Event>  events;
+                std::size_t         head;
+                bool                wrapped;
+                int                 thread_id;
+            };
+
+            // All per-thread buffers. They are created on a thread's first zone, registered here,
+            // and deliberately never freed: a thread may finish long before save() is called and
+            // its zones must still be exportable.
+            static std::mutex registry_mutex_;
+            static std::vector<ThreadBuffer*> registry_;
+
+            // a reference reading of both clocks, taken when the first buffer is created. save()
+            // takes a second reading to calibrate the tick duration of the time stamp counter.
+            static uint64_t reference_ticks_ = 0;
+            static std::chrono::steady_clock::time_point reference_time_;
+
+            static ThreadBuffer* thread_buffer() {
+                static thread_local ThreadBuffer* buffer = nullptr;
+                if (!buffer) {
+                    std::lock_guard<std::mutex> guard(registry_mutex_);
+                    if (registry_.empty()) {
+                        reference_ticks_ = timestamp();
+                        reference_time_ = std::chrono::steady_clock::now();
+                    }
+                    buffer = new ThreadBuffer(static_cast<int>(registry_.size()));
+                    registry_.push_back(buffer);
+                }
+                return buffer;
+            }
+
+            void record(const char* name, uint64_t start, uint64_t end) {
+                ThreadBuffer* buffer = thread_buffer();
+                buffer->events[buffer->head] = {name, start, end};
+                if (++buffer->head == buffer_capacity) {
+                    buffer->head = 0;
+                    buffer->wrapped = true;
+                }
+            }
+
+        }
+
+
+        bool save(const std::string& file_name) {
+            std::lock_guard<std::mutex> guard(details::registry_mutex_);
+            if (details::registry_.empty()) {
+                LOG(WARNING) << "no tracing zones have been recorded";
+                return false;
+            }
+
+            std::ofstream output(file_name.c_str());
+            if (output.fail()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+
+            // calibrate: ticks per microsecond since the reference reading
+            const uint64_t ticks = timestamp() - details::reference_ticks_;
+            const double elapsed_us = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - details::reference_time_).count();
+            const double ticks_per_us = static_cast<double>(ticks) / elapsed_us;
+
+            output << "{\"traceEvents\":[\n";
+            bool first = true;
+            for (const auto buffer : details::registry_) {
+                const std::size_t count = buffer->wrapped ? details::buffer_capacity : buffer->head;
+                for (std::size_t i = 0; i < count; ++i) {
+                    const auto& e = buffer->events[i];
+                    if (!first)
+                        output << ",\n";
+                    first = false;
+                    output << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1"
+                           << ",\"tid\":" << buffer->thread_id
+                           << ",\"ts\":" << static_cast<double>(e.start - details::reference_ticks_) / ticks_per_us
+                           << ",\"dur\":" << static_cast<double>(e.end - e.start) / ticks_per_us
+                           << "}";
+                }
+            }
+            output << "\n]}\n";
+
+            LOG(INFO) << "trace saved to '" << file_name << "' (open chrome://tracing to view it)";
+            return true;
+        }
+
+
+        void clear() {
+            std::lock_guard<std::mutex> guard(details::registry_mutex_);
+            for (auto buffer : details::registry_) {
+                buffer->head = 0;
+                buffer->wrapped = false;
+            }
+        }
+
+    }
+
+}
+
+#endif  // EASY3D_ENABLE_TRACING
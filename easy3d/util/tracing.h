@@ -0,0 +1,145 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_UTIL_TRACING_H
+#define EASY3D_UTIL_TRACING_H
+
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif !defined(__x86_64__) && !defined(__i386__)
+#include <chrono>
+#endif
+
+
+namespace easy3d {
+
+    /**
+     * \brief A lightweight tracing facility for instrumenting hot paths.
+     *
+     * \details Unlike StopWatch (which requires manual timing and printing), tracing zones are
+     *      dropped into the code once and record themselves into a per-thread ring buffer with
+     *      raw time stamp counter (rdtsc) readings, so a zone costs only two counter reads and
+     *      one buffer store. The recorded zones can be exported to a JSON file that loads into
+     *      the trace viewer of Chromium-based browsers (open "chrome://tracing" or
+     *      "about://tracing" and load the file) for a per-thread timeline view.
+     *
+     *      Tracing is a compile-time feature: all macros expand to nothing unless the library
+     *      is built with EASY3D_ENABLE_TRACING defined, so instrumented release builds carry
+     *      no overhead at all. Usage:
+     *      \code
+     *      void Foo::expensive() {
+     *          EASY3D_TRACE_FUNCTION;          // traces the whole function
+     *          ...
+     *          {
+     *              EASY3D_TRACE_SCOPE("inner loop");   // traces an inner block
+     *              ...
+     *          }
+     *      }
+     *      // somewhere at the end of the run:
+     *      tracing::save("trace.json");
+     *      \endcode
+     *
+     * \note The ring buffers are bounded (the oldest zones of a thread are overwritten when its
+     *      buffer is full) and per-thread, so zones may be recorded from any thread without
+     *      synchronization on the hot path.
+     */
+    namespace tracing {
+
+#ifdef EASY3D_ENABLE_TRACING
+
+        /// \brief Reads the time stamp counter (falls back to the steady clock on non-x86 targets).
+        inline uint64_t timestamp() {
+#if defined(_MSC_VER)
+            return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            unsigned int lo, hi;
+            __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+            return (static_cast<uint64_t>(hi) << 32) | lo;
+#else
+            return static_cast<uint64_t>(
+                    std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        namespace details {
+            /// Appends a finished zone to the calling thread's ring buffer.
+            void record(const char* name, uint64_t start, uint64_t end);
+        }
+
+        /**
+         * \brief A scoped tracing zone: records the time spent between its construction and its
+         *      destruction. Use the EASY3D_TRACE_SCOPE / EASY3D_TRACE_FUNCTION macros instead of
+         *      instantiating it directly, so the instrumentation compiles away when tracing is
+         *      disabled.
+         * \attention The zone keeps only the \b pointer to its name, so the name must outlive the
+         *      zone and the final save() call. String literals (the intended use) always do.
+         */
+        class Zone {
+        public:
+            explicit Zone(const char* name) : name_(name), start_(timestamp()) {}
+            ~Zone() { details::record(name_, start_, timestamp()); }
+        private:
+            const char* name_;
+            uint64_t    start_;
+        };
+
+        /**
+         * \brief Exports all zones recorded so far to a JSON file in the trace event format of
+         *      chrome://tracing.
+         * \return true on success.
+         */
+        bool save(const std::string& file_name);
+
+        /// \brief Discards all recorded zones (the ring buffers remain allocated).
+        void clear();
+
+#else   // tracing disabled at compile time: everything reduces to no-ops
+
+        inline bool save(const std::string&) { return false; }
+        inline void clear() {}
+
+#endif
+
+    }
+
+}
+
+
+#ifdef EASY3D_ENABLE_TRACING
+#define EASY3D_TRACE_CONCAT_IMPL(a, b)  a##b
+#define EASY3D_TRACE_CONCAT(a, b)       EASY3D_TRACE_CONCAT_IMPL(a, b)
+/// Traces the enclosing scope under the given name (a string literal).
+#define EASY3D_TRACE_SCOPE(name)        ::easy3d::tracing::Zone EASY3D_TRACE_CONCAT(easy3d_trace_zone_, __LINE__)(name)
+/// Traces the enclosing function under its own name.
+#define EASY3D_TRACE_FUNCTION           EASY3D_TRACE_SCOPE(__FUNCTION__)
+#else
+#define EASY3D_TRACE_SCOPE(name)
+#define EASY3D_TRACE_FUNCTION
+#endif
+
+
+#endif  // EASY3D_UTIL_TRACING_H
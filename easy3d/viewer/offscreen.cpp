@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <easy3d/viewer/offscreen.h>
+
+#include <easy3d/renderer/opengl.h>        // Initialize with glewInit()
+#include <3rd_party/glfw/include/GLFW/glfw3.h>    // Include glfw3.h after our OpenGL definitions
+
+#include <easy3d/util/file_system.h>
+#include <easy3d/util/logging.h>
+
+
+namespace easy3d {
+
+    OffScreen::OffScreen(int width, int height)
+            : Viewer("Easy3D OffScreen", 4, 3, 2, false, false)
+    {
+        resize(width, height);
+
+        // run() never executes for offscreen rendering, so the OpenGL state that init() would
+        // have set up is established here (the text renderer and the usage print of init() are
+        // for interactive use only). The context created by the Viewer constructor is current.
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+
+        glClearDepthf(1.0f);
+        glClearColor(background_color_[0], background_color_[1], background_color_[2], background_color_[3]);
+    }
+
+
+    bool OffScreen::render(const std::string &file_name, bool bk_white) const {
+        // render at the size of the framebuffer, i.e., a single tile
+        int w, h;
+        glfwGetFramebufferSize(window_, &w, &h);
+        return snapshot(file_name, w, h, bk_white);
+    }
+
+
+    bool OffScreen::render(const std::string &file_name, int width, int height, bool bk_white, bool expand) const {
+        return snapshot(file_name, width, height, bk_white, expand);
+    }
+
+
+    std::size_t OffScreen::render_batch(const std::vector<std::string> &input_files,
+                                        const std::string &output_directory,
+                                        const std::string &format,
+                                        bool bk_white)
+    {
+        if (format != "png" && format != "jpg" && format != "bmp" && format != "ppm" && format != "tga") {
+            LOG(ERROR) << "image format must be png, jpg, bmp, ppm, or tga";
+            return 0;
+        }
+        if (!file_system::is_directory(output_directory)) {
+            LOG(ERROR) << "no such directory: " << output_directory;
+            return 0;
+        }
+
+        std::size_t num_rendered = 0;
+        for (const auto &file_name : input_files) {
+            // release the previous asset; the shader programs and textures cached by the
+            // ShaderManager/TextureManager survive (only cleanup() terminates the caches),
+            // so every asset after the first skips the whole GL setup
+            clear_scene();
+
+            Model *model = add_model(file_name);
+            if (!model) {
+                LOG(WARNING) << "failed to load model from file: " << file_name;
+                continue;
+            }
+            fit_screen(model);
+
+            const std::string &output = output_directory + "/" +
+                    file_system::base_name(file_name) + "." + format;
+            if (render(output, bk_white))
+                ++num_rendered;
+            else
+                LOG(WARNING) << "failed to render model into file: " << output;
+        }
+        clear_scene();
+
+        LOG(INFO) << num_rendered << " of " << input_files.size() << " models rendered";
+        return num_rendered;
+    }
+
+}
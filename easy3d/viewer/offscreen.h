@@ -0,0 +1,121 @@
+/**
+ * Copyright (C) 2015 by Liangliang Nan (liangliang.nan@gmail.com)
+ * https://3d.bk.tudelft.nl/liangliang/
+ *
+ * This file is part of Easy3D. If it is useful in your research/work,
+ * I would be grateful if you show your appreciation by citing it:
+ * ------------------------------------------------------------------
+ *      Liangliang Nan.
+ *      Easy3D: a lightweight, easy-to-use, and efficient C++
+ *      library for processing and rendering 3D data. 2018.
+ * ------------------------------------------------------------------
+ * Easy3D is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3
+ * as published by the Free Software Foundation.
+ *
+ * Easy3D is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EASY3D_VIEWER_OFFSCREEN_H
+#define EASY3D_VIEWER_OFFSCREEN_H
+
+#include <easy3d/viewer/viewer.h>
+
+
+namespace easy3d {
+
+    /**
+     * @brief Offscreen rendering (without showing a window), e.g., for batch processing on
+     *        render farms and in CI pipelines.
+     * \class OffScreen easy3d/viewer/offscreen.h
+     * @details OffScreen renders into image files without ever showing a window (the underlying
+     *          window stays hidden; there is no event loop). The OpenGL context is created once,
+     *          in the constructor, and all renderings share it, so the context setup, the GLEW
+     *          initialization, and the shader programs and textures cached by the ShaderManager
+     *          and the TextureManager are paid for only once per process instead of once per
+     *          image. This matters for batch jobs: setting up a context from scratch easily costs
+     *          more than a second, which dominates the per-asset cost when thumbnails of
+     *          thousands of models are generated.
+     *
+     *          Rendering a single model to an image takes only a few lines:
+     *          \code
+     *          OffScreen os(800, 600);
+     *          os.add_model("bunny.ply");
+     *          os.fit_screen();
+     *          os.render("bunny.png");
+     *          \endcode
+     *          For a whole directory of assets, render_batch() loops over the files reusing the
+     *          context and the caches. Clients needing a non-default viewpoint or lighting can
+     *          manipulate camera() between add_model() and render(), exactly as with the Viewer.
+     * @attention A hidden window still requires a display connection (or a virtual one, e.g.,
+     *            Xvfb) on Linux; the context is hidden, not surfaceless.
+     */
+    class OffScreen : public Viewer {
+    public:
+        /**
+         * @brief Creating the offscreen renderer. The OpenGL context is created here and reused
+         *        by all subsequent renderings.
+         * @param width/height The default resolution (in pixels) of the output images, and the
+         *        size of the tiles when rendering at higher resolutions.
+         */
+        explicit OffScreen(int width = 800, int height = 600);
+
+        /**
+         * @brief Render the current scene into an image file at the default resolution (i.e.,
+         *        the width/height the offscreen renderer was created with).
+         * @param file_name The output image file: png, jpg, bmp, tga, or ppm.
+         * @param bk_white Use a white background instead of the background color.
+         * @return true on success and false otherwise.
+         */
+        bool render(const std::string& file_name, bool bk_white = true) const;
+
+        /**
+         * @brief Render the current scene into an image file of an arbitrary resolution.
+         * @details The image is rendered tile by tile (see the resolution-taking overload of
+         *          Viewer::snapshot() for the details and the memory behavior of the formats).
+         * @param file_name The output image file: png, jpg, bmp, tga, or ppm.
+         * @param width The width of the output image, in pixels.
+         * @param height The height of the output image, in pixels.
+         * @param bk_white Use a white background instead of the background color.
+         * @param expand When the aspect ratio of the output differs from the default one, expand
+         *        the view frustum to cover the extra extent (true) or crop it (false).
+         * @return true on success and false otherwise.
+         */
+        bool render(const std::string& file_name, int width, int height,
+                    bool bk_white = true, bool expand = true) const;
+
+        /**
+         * @brief Render a sequence of model files into image files, reusing the context.
+         * @details For each input file, the scene is cleared, the model is loaded, the camera is
+         *          adjusted to see the entire model, and the scene is rendered into
+         *          `output_directory/<model name>.<format>`. Exactly one context is used for the
+         *          whole batch, and the shader programs and textures cached during the first
+         *          asset are reused by all later ones, so the per-asset cost reduces to loading
+         *          and rasterization. Files that fail to load or to save are reported and
+         *          skipped; they don't stop the batch.
+         * @param input_files The model files to render.
+         * @param output_directory The directory receiving the images (it must exist).
+         * @param format The image format: png, jpg, bmp, tga, or ppm.
+         * @param bk_white Use a white background instead of the background color.
+         * @return The number of images successfully written.
+         */
+        std::size_t render_batch(const std::vector<std::string>& input_files,
+                                 const std::string& output_directory,
+                                 const std::string& format = "png",
+                                 bool bk_white = true);
+
+    private:
+        // the interactive event loop makes no sense without a visible window
+        using Viewer::run;
+    };
+
+}
+
+
+#endif  // EASY3D_VIEWER_OFFSCREEN_H
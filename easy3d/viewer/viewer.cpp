@@ -25,7 +25,11 @@
 #include <easy3d/viewer/viewer.h>
 
 #include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 
 
 #if !defined(_WIN32)
@@ -53,10 +57,14 @@
 #include <easy3d/renderer/manipulated_camera_frame.h>
 #include <easy3d/renderer/key_frame_interpolator.h>
 #include <easy3d/renderer/framebuffer_object.h>
+#include <easy3d/renderer/frame_profiler.h>
+#include <easy3d/renderer/frame_statistics.h>
 #include <easy3d/renderer/opengl_error.h>
 #include <easy3d/renderer/setting.h>
+#include <easy3d/renderer/clipping_plane.h>
 #include <easy3d/renderer/text_renderer.h>
 #include <easy3d/renderer/texture_manager.h>
+#include <easy3d/fileio/image_io.h>
 #include <easy3d/fileio/resources.h>
 #include <easy3d/fileio/point_cloud_io.h>
 #include <easy3d/fileio/graph_io.h>
@@ -67,6 +75,7 @@
 #include <easy3d/util/dialogs.h>
 #include <easy3d/util/file_system.h>
 #include <easy3d/util/logging.h>
+#include <easy3d/util/thread_pool.h>
 #include <easy3d/util/timer.h>
 
 
@@ -93,8 +102,11 @@ namespace easy3d {
     )
             : window_(nullptr), dpi_scaling_(1.0), title_(title), camera_(nullptr), samples_(0),
               full_screen_(full_screen), background_color_(0.9f, 0.9f, 1.0f, 1.0f),
-              process_events_(true), texter_(nullptr), pressed_button_(-1), modifiers_(-1), drag_active_(false),
+              process_events_(true), needs_update_(true), texter_(nullptr), pressed_button_(-1), modifiers_(-1),
+              drag_active_(false),
               mouse_current_x_(0), mouse_current_y_(0), mouse_pressed_x_(0), mouse_pressed_y_(0), pressed_key_(-1),
+              drag_pending_dx_(0), drag_pending_dy_(0), scroll_pending_dx_(0), scroll_pending_dy_(0),
+              next_animation_id_(0),
               show_pivot_point_(false), drawable_axes_(nullptr), show_camera_path_(false), model_idx_(-1) {
         // Avoid locale-related number parsing issues.
         setlocale(LC_NUMERIC, "C");
@@ -214,9 +226,8 @@ namespace easy3d {
             throw std::runtime_error("failed to load OpenGL and its extensions!");
         }
 
-#ifndef NDEBUG
-        opengl::setup_gl_debug_callback();
-#endif
+        if (setting::gl_debug_output)
+            opengl::setup_gl_debug_callback();
 
         LOG(INFO) << "OpenGL vendor:            " << glGetString(GL_VENDOR);
         LOG(INFO) << "OpenGL renderer:          " << glGetString(GL_RENDERER);
@@ -314,6 +325,13 @@ namespace easy3d {
             viewer->callback_event_resize(width, height);
         });
 
+        /* The window contents were damaged, e.g., previously obscured by another window
+         * or restored from an iconified state, and have to be repainted */
+        glfwSetWindowRefreshCallback(window, [](GLFWwindow *win) {
+            auto viewer = reinterpret_cast<Viewer *>(glfwGetWindowUserPointer(win));
+            viewer->update();
+        });
+
         // notify when the screen has lost focus (e.g. application switch)
         glfwSetWindowFocusCallback(window, [](GLFWwindow *win, int focused) {
             auto viewer = reinterpret_cast<Viewer *>(glfwGetWindowUserPointer(win));
@@ -334,9 +352,17 @@ namespace easy3d {
             int dy = py - mouse_current_y_;
             mouse_current_x_ = px;
             mouse_current_y_ = py;
-            if (drag_active_)
-                return mouse_drag_event(px, py, dx, dy, pressed_button_, modifiers_);
-            else
+            if (drag_active_) {
+                // dragging damages the content; cursor moves with no button pressed do not
+                // (handlers highlighting the hovered primitive are expected to call update())
+                needs_update_ = true;
+                // coalesced: the deltas are accumulated here and applied once per rendered
+                // frame (see flush_coalesced_events()), so a 1kHz mouse does not trigger the
+                // camera math for events whose effect is overwritten within the same frame.
+                drag_pending_dx_ += dx;
+                drag_pending_dy_ += dy;
+                return true;
+            } else
                 return mouse_free_move_event(px, py, dx, dy, modifiers_);
         }
         catch (const std::exception &e) {
@@ -348,6 +374,10 @@ namespace easy3d {
 
     bool Viewer::callback_event_mouse_button(int button, int action, int modifiers) {
         try {
+            needs_update_ = true;
+            // apply motion that arrived before this transition, while the button/modifier state
+            // that produced it is still in effect (otherwise the tail of a drag would be lost)
+            flush_coalesced_events();
             if (action == GLFW_PRESS) {
                 drag_active_ = true;
                 pressed_button_ = button;
@@ -373,6 +403,8 @@ namespace easy3d {
 
     bool Viewer::callback_event_keyboard(int key, int action, int modifiers) {
         try {
+            // the built-in shortcuts change the scene (visibility, point/line sizes, ...)
+            needs_update_ = true;
             if (action == GLFW_PRESS || action == GLFW_REPEAT) {
                 return key_press_event(key, modifiers);
             } else {
@@ -388,6 +420,7 @@ namespace easy3d {
 
     bool Viewer::callback_event_character(unsigned int codepoint) {
         try {
+            needs_update_ = true;
             return char_input_event(codepoint);
         }
         catch (const std::exception &e) {
@@ -399,6 +432,7 @@ namespace easy3d {
 
     bool Viewer::callback_event_drop(int count, const char **filenames) {
         try {
+            needs_update_ = true;
             std::vector<std::string> arg(count);
             for (int i = 0; i < count; ++i)
                 arg[i] = filenames[i];
@@ -413,7 +447,11 @@ namespace easy3d {
 
     bool Viewer::callback_event_scroll(double dx, double dy) {
         try {
-            return mouse_scroll_event(mouse_current_x_, mouse_current_y_, static_cast<int>(dx), static_cast<int>(dy));
+            needs_update_ = true;
+            // coalesced like mouse drags: only the accumulated scroll amount matters
+            scroll_pending_dx_ += static_cast<int>(dx);
+            scroll_pending_dy_ += static_cast<int>(dy);
+            return true;
         }
         catch (const std::exception &e) {
             LOG(ERROR) << "Caught exception in event handler: " << e.what();
@@ -422,6 +460,93 @@ namespace easy3d {
     }
 
 
+    void Viewer::flush_coalesced_events() {
+        try {
+            if (drag_pending_dx_ != 0 || drag_pending_dy_ != 0) {
+                const int dx = drag_pending_dx_;
+                const int dy = drag_pending_dy_;
+                drag_pending_dx_ = drag_pending_dy_ = 0;
+                mouse_drag_event(mouse_current_x_, mouse_current_y_, dx, dy, pressed_button_, modifiers_);
+            }
+            if (scroll_pending_dx_ != 0 || scroll_pending_dy_ != 0) {
+                const int dx = scroll_pending_dx_;
+                const int dy = scroll_pending_dy_;
+                scroll_pending_dx_ = scroll_pending_dy_ = 0;
+                mouse_scroll_event(mouse_current_x_, mouse_current_y_, dx, dy);
+            }
+        }
+        catch (const std::exception &e) {
+            LOG(ERROR) << "Caught exception in event handler: " << e.what();
+        }
+    }
+
+
+    unsigned int Viewer::add_animation(std::function<bool(Viewer*)> func, float rate_hz) {
+        if (!func) {
+            LOG(ERROR) << "null animation function";
+            return 0;
+        }
+        LOG_IF(WARNING, rate_hz <= 0.0f) << "animation rate must be positive (using 30 Hz)";
+        const double interval = 1.0 / (rate_hz > 0.0f ? double(rate_hz) : 30.0);
+
+        Animation anim;
+        anim.id = ++next_animation_id_;
+        anim.func = func;
+        anim.interval = interval;
+        anim.next_time = glfwGetTime();     // first tick on the next loop iteration
+        animations_.push_back(anim);
+        update();   // in case the loop is sleeping in an untimed event wait
+        return anim.id;
+    }
+
+
+    void Viewer::remove_animation(unsigned int id) {
+        for (std::size_t i = 0; i < animations_.size(); ++i) {
+            if (animations_[i].id == id) {
+                animations_.erase(animations_.begin() + i);
+                return;
+            }
+        }
+    }
+
+
+    double Viewer::tick_animations() {
+        if (animations_.empty())
+            return -1.0;
+
+        // animations due within this window of 'now' tick together, so a handful of equal-rate
+        // animations whose phases drifted apart by microseconds still share one frame
+        static const double batch_window = 0.001;
+
+        const double now = glfwGetTime();
+        double earliest = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < animations_.size(); /* nothing */) {
+            Animation& anim = animations_[i];
+            if (anim.next_time <= now + batch_window) {
+                bool keep = true;
+                try {
+                    keep = anim.func(this);
+                }
+                catch (const std::exception &e) {
+                    LOG(ERROR) << "Caught exception in animation: " << e.what();
+                    keep = false;
+                }
+                if (!keep) {
+                    animations_.erase(animations_.begin() + i);
+                    continue;
+                }
+                needs_update_ = true;
+                anim.next_time += anim.interval;
+                if (anim.next_time < now)   // behind (e.g., a long frame): don't try to catch up
+                    anim.next_time = now + anim.interval;
+            }
+            earliest = std::min(earliest, anim.next_time);
+            ++i;
+        }
+        return animations_.empty() ? -1.0 : earliest;
+    }
+
+
     void Viewer::callback_event_resize(int w, int h) {
         if (w == 0 && h == 0)
             return;
@@ -431,7 +556,13 @@ namespace easy3d {
             int win_w, win_h;
             glfwGetWindowSize(window_, &win_w, &win_h);
             camera_->setScreenWidthAndHeight(win_w, win_h);
+            for (auto &view : views_) {
+                if (view.camera)
+                    view.camera->setScreenWidthAndHeight(static_cast<int>(win_w * view.w),
+                                                         static_cast<int>(win_h * view.h));
+            }
             glViewport(0, 0, w, h);
+            needs_update_ = true;
             post_resize(w, h);
         }
         catch (const std::exception &e) {
@@ -466,10 +597,21 @@ namespace easy3d {
     }
 
     void Viewer::cleanup() {
+        // wait for the background loaders (if any) and release the models they delivered
+        for (auto &t : loader_threads_) {
+            if (t.joinable())
+                t.join();
+        }
+        loader_threads_.clear();
+        for (const auto &entry : pending_models_)
+            delete entry.first;
+        pending_models_.clear();
+
         // viewer may have already been destroyed by the user
         if (!window_)
             return;
 
+        clear_views();
         delete camera_;
         delete kfi_;
         delete drawable_axes_;
@@ -477,6 +619,7 @@ namespace easy3d {
 
         clear_scene();
 
+        FrameProfiler::terminate();
         ShaderManager::terminate();
         TextureManager::terminate();
 
@@ -518,6 +661,7 @@ namespace easy3d {
 
 
     void Viewer::update() const {
+        needs_update_ = true;
         glfwPostEmptyEvent();
     }
 
@@ -1002,22 +1146,63 @@ namespace easy3d {
                     continue;
 
                 glfwPollEvents();
+                flush_coalesced_events();
+
+                // add the models finished by the background loaders (if any)
+                process_pending_models();
+
+                // run the animations that are due; they mark the content dirty, so animations
+                // due together are batched into the single frame rendered below
+                const double next_tick = tick_animations();
+
+                // nothing has damaged the content (e.g., cursor moves with no button pressed):
+                // keep the presented frame instead of re-rendering a static scene.
+                if (needs_update_) {
+                    // Calculate ms/frame
+                    double current_time = glfwGetTime();
+                    ++frame_counter;
+                    if(current_time - last_time >= 2.0f) {
+                        sprintf(gpu_time_, "fps: %2.0f (%4.1f ms/frame)\n", double(frame_counter) / (current_time - last_time), 1000.0 / double(frame_counter));
+                        frame_counter = 0;
+                        // frames are no longer rendered continuously, so the next measuring
+                        // interval starts now (not 2s after the previous one)
+                        last_time = current_time;
+                    }
 
-                // Calculate ms/frame
-                double current_time = glfwGetTime();
-                ++frame_counter;
-                if(current_time - last_time >= 2.0f) {
-                    sprintf(gpu_time_, "fps: %2.0f (%4.1f ms/frame)\n", double(frame_counter) / (current_time - last_time), 1000.0 / double(frame_counter));
-                    frame_counter = 0;
-                    last_time += 2.0f;
-                }
+                    // cleared before drawing, so update() calls issued while this frame is
+                    // being rendered schedule the next one.
+                    needs_update_ = false;
 
-                pre_draw();
-                draw();
-                post_draw();
-                glfwSwapBuffers(window_);
+                    FrameStatistics::new_frame();
+                    FrameProfiler::begin_frame();
+                    {
+                        FrameProfiler::Section section("pre_draw");
+                        pre_draw();
+                    }
+                    {
+                        FrameProfiler::Section section("draw");
+                        draw();
+                    }
+                    {
+                        FrameProfiler::Section section("post_draw");
+                        post_draw();
+                    }
+                    {
+                        FrameProfiler::Section section("swap_buffers");
+                        glfwSwapBuffers(window_);
+                    }
+                    FrameProfiler::end_frame();
+                }
 
-                glfwWaitEvents();
+                // sleep until something happens: indefinitely when no animation is registered
+                // (input and update() wake the loop), otherwise until the next due tick
+                if (next_tick < 0.0)
+                    glfwWaitEvents();
+                else {
+                    const double timeout = next_tick - glfwGetTime();
+                    if (timeout > 0.0)
+                        glfwWaitEventsTimeout(timeout);
+                }
             }
 
             /* Process events once more */
@@ -1096,14 +1281,7 @@ namespace easy3d {
     }
 
 
-    Model *Viewer::add_model(const std::string &file_name, bool create_default_drawables) {
-        for (auto m : models_) {
-            if (m->name() == file_name) {
-                LOG(WARNING) << "model has already been added to the viewer: " << file_name;
-                return m;
-            }
-        }
-
+    Model *Viewer::read_model(const std::string &file_name) {
         const std::string &ext = file_system::extension(file_name, true);
         bool is_ply_mesh = false;
         if (ext == "ply")
@@ -1117,25 +1295,147 @@ namespace easy3d {
             model = GraphIO::load(file_name);
         } else if (ext == "plm" || ext == "pmesh") {
             model = PolyMeshIO::load(file_name);
+        } else // point cloud
+            model = PointCloudIO::load(file_name);
+
+        if (model)
+            model->set_name(file_name);
+        return model;
+    }
+
+
+    Model *Viewer::add_model(const std::string &file_name, bool create_default_drawables) {
+        for (auto m : models_) {
+            if (m->name() == file_name) {
+                LOG(WARNING) << "model has already been added to the viewer: " << file_name;
+                return m;
+            }
+        }
+
+        // a ptx file may contain multiple point clouds
+        if (file_system::extension(file_name, true) == "ptx") {
+            io::PointCloudIO_ptx serializer(file_name);
+            Model *model = nullptr;
+            PointCloud *cloud = nullptr;
+            while ((cloud = serializer.load_next())) {
+                model = add_model(cloud, create_default_drawables);
+                update();
+            }
+            return model;   // returns the last cloud in the file.
+        }
+
+        Model *model = read_model(file_name);
+        if (model)
+            add_model(model, create_default_drawables);
+        return model;
+    }
+
+
+    std::vector<Model*> Viewer::add_models(const std::vector<std::string> &file_names, bool create_default_drawables) {
+        // drop files whose models are already in the viewer (same behavior as add_model())
+        std::vector<std::string> names;
+        for (const auto &name : file_names) {
+            bool exists = false;
+            for (auto m : models_) {
+                if (m->name() == name) {
+                    LOG(WARNING) << "model has already been added to the viewer: " << name;
+                    exists = true;
+                    break;
+                }
+            }
+            if (!exists)
+                names.push_back(name);
         }
-        else { // point cloud
-            if (ext == "ptx") {
+
+        std::vector<Model *> models;
+        if (names.empty())
+            return models;
+
+        // parse all files concurrently. Parsing is pure CPU/disk work, so it can run on the
+        // workers; only the bookkeeping below must stay on the rendering thread.
+        std::vector< std::vector<Model *> > loaded(names.size());
+        ThreadPool::global().parallel_for(0, names.size(), [this, &names, &loaded](std::size_t i) {
+            const std::string &file_name = names[i];
+            // a ptx file may contain multiple point clouds
+            if (file_system::extension(file_name, true) == "ptx") {
                 io::PointCloudIO_ptx serializer(file_name);
                 PointCloud *cloud = nullptr;
                 while ((cloud = serializer.load_next())) {
-                    model = add_model(cloud, create_default_drawables);
-                    update();
+                    cloud->set_name(file_name);
+                    loaded[i].push_back(cloud);
                 }
-                return model;   // returns the last cloud in the file.
-            } else
-                model = PointCloudIO::load(file_name);
+            } else {
+                Model *model = read_model(file_name);
+                if (model)
+                    loaded[i].push_back(model);
+                else
+                    LOG(WARNING) << "failed to load model from file: " << file_name;
+            }
+        }, 1);
+
+        // one bookkeeping pass, with no rendering interleaved: the GL buffers of all the models
+        // are then created together in the next frame (see internal_update_buffers())
+        for (const auto &batch : loaded) {
+            for (auto model : batch) {
+                if (add_model(model, create_default_drawables))
+                    models.push_back(model);
+            }
         }
 
-        if (model) {
-            model->set_name(file_name);
-            add_model(model, create_default_drawables);
+        update();
+        return models;
+    }
+
+
+    void Viewer::add_model_async(const std::string &file_name, bool create_default_drawables) {
+        for (auto m : models_) {
+            if (m->name() == file_name) {
+                LOG(WARNING) << "model has already been added to the viewer: " << file_name;
+                return;
+            }
+        }
+
+        loader_threads_.emplace_back([this, file_name, create_default_drawables]() {
+            // a ptx file may contain multiple point clouds; add each one as it becomes available
+            if (file_system::extension(file_name, true) == "ptx") {
+                io::PointCloudIO_ptx serializer(file_name);
+                PointCloud *cloud = nullptr;
+                while ((cloud = serializer.load_next())) {
+                    cloud->set_name(file_name);
+                    enqueue_model(cloud, create_default_drawables);
+                }
+                return;
+            }
+
+            Model *model = read_model(file_name);
+            if (model)
+                enqueue_model(model, create_default_drawables);
+            else
+                LOG(WARNING) << "failed to load model from file: " << file_name;
+        });
+    }
+
+
+    void Viewer::enqueue_model(Model *model, bool create_default_drawables) {
+        {
+            std::lock_guard<std::mutex> guard(pending_models_mutex_);
+            pending_models_.emplace_back(model, create_default_drawables);
+        }
+        // wake up the event loop (glfwPostEmptyEvent() may be called from any thread)
+        glfwPostEmptyEvent();
+    }
+
+
+    void Viewer::process_pending_models() {
+        std::vector< std::pair<Model *, bool> > pending;
+        {
+            std::lock_guard<std::mutex> guard(pending_models_mutex_);
+            pending.swap(pending_models_);
+        }
+        for (const auto &entry : pending) {
+            add_model(entry.first, entry.second);
+            update();
         }
-        return model;
     }
 
 
@@ -1193,6 +1493,45 @@ namespace easy3d {
     }
 
 
+    std::size_t Viewer::memory_usage() const {
+        std::size_t bytes = 0;
+        for (auto m : models_)
+            bytes += m->memory_usage();
+        return bytes;
+    }
+
+
+    void Viewer::memory_report(std::ostream& output) const {
+        std::size_t total_used = 0, total_allocated = 0;
+        for (auto m : models_) {
+            std::vector<PropertyMemoryRecord> records;
+            m->memory_report(records);
+            output << "model '" << m->name() << "':\n";
+            for (const auto& r : records) {
+                output << "\t" << r.name << ": " << r.used << " bytes used, "
+                       << r.allocated << " bytes allocated";
+                if (r.allocated > r.used)
+                    output << " (" << (r.allocated - r.used) << " bytes slack)";
+                output << "\n";
+                total_used += r.used;
+                total_allocated += r.allocated;
+            }
+        }
+        output << "total: " << total_used << " bytes used, " << total_allocated
+               << " bytes allocated (" << (total_allocated - total_used) << " bytes slack)"
+               << std::endl;
+    }
+
+
+    std::size_t Viewer::shrink_all_to_fit() {
+        const std::size_t before = memory_usage();
+        for (auto m : models_)
+            m->shrink_to_fit();
+        const std::size_t after = memory_usage();
+        return before - after;
+    }
+
+
     bool Viewer::add_drawable(Drawable *drawable) {
         if (!drawable) {
             LOG(WARNING) << "drawable is NULL.";
@@ -1255,11 +1594,61 @@ namespace easy3d {
         if (box.is_valid()) {
             camera_->setSceneBoundingBox(box.min(), box.max());
             camera_->showEntireScene();
+            // frame the cameras of the views on the scene as well (their orientations are kept)
+            for (auto &view : views_) {
+                if (view.camera) {
+                    view.camera->setSceneBoundingBox(box.min(), box.max());
+                    view.camera->showEntireScene();
+                }
+            }
             update();
         }
     }
 
 
+    int Viewer::add_view(float x, float y, float w, float h, bool own_camera /* = false */) {
+        View view;
+        view.x = x;
+        view.y = y;
+        view.w = w;
+        view.h = h;
+        view.camera = nullptr;
+
+        if (own_camera) {
+            // the camera starts from the current viewpoint and can be oriented independently
+            Camera *cam = new Camera;
+            cam->setType(camera_->type());
+            cam->setScreenWidthAndHeight(static_cast<int>(camera_->screenWidth() * w),
+                                         static_cast<int>(camera_->screenHeight() * h));
+            cam->setSceneCenter(camera_->sceneCenter());
+            cam->setSceneRadius(camera_->sceneRadius());
+            cam->setPosition(camera_->position());
+            cam->setOrientation(camera_->orientation());
+            cam->connect(this, &Viewer::update);
+            view.camera = cam;
+        }
+
+        views_.push_back(view);
+        return static_cast<int>(views_.size()) - 1;
+    }
+
+
+    Camera *Viewer::view_camera(int idx) {
+        if (idx < 0 || idx >= num_views()) {
+            LOG(ERROR) << "view index is out of range: " << idx;
+            return camera_;
+        }
+        return views_[idx].camera ? views_[idx].camera : camera_;
+    }
+
+
+    void Viewer::clear_views() {
+        for (auto &view : views_)
+            delete view.camera;
+        views_.clear();
+    }
+
+
     bool Viewer::open() {
         const std::string title("Please choose a file");
         const std::string &default_path = resource::directory() + "/data/";
@@ -1366,6 +1755,15 @@ namespace easy3d {
         fbo.release();
 
 #if 1   // color render buffer
+        if (ext == "png" || ext == "jpg") {
+            // only the pixel readback has to happen on the render thread; the compression (the
+            // expensive part for these formats) is handed to a worker by save_async()
+            std::vector<unsigned char> bits;
+            if (!fbo.read_color(0, bits, GL_RGBA, true))
+                return false;
+            ImageIO::save_async(file_name, std::move(bits), w, h, 4);
+            return true;
+        }
         return fbo.snapshot_color(0, file_name);
 #else
         // depth buffer
@@ -1374,6 +1772,131 @@ namespace easy3d {
     }
 
 
+    bool Viewer::snapshot(const std::string &file_name, int width, int height, bool bk_white, bool expand) const {
+        const std::string &ext = file_system::extension(file_name, true);
+        if (ext != "png" && ext != "jpg" && ext != "bmp" && ext != "ppm" && ext != "tga") {
+            LOG(ERROR) << "snapshot format must be png, jpg, bmp, ppm, or tga";
+            return false;
+        }
+        if (width <= 0 || height <= 0) {
+            LOG(ERROR) << "invalid snapshot resolution: " << width << " x " << height;
+            return false;
+        }
+
+        // the tiles have the size of the framebuffer, which is known to be supported
+        int sub_w, sub_h;
+        glfwGetFramebufferSize(window_, &sub_w, &sub_h);
+
+        // derive the frustum of the output image from the camera's current one
+        const double aspect_ratio = sub_w / static_cast<double>(sub_h);
+        const double new_aspect_ratio = width / static_cast<double>(height);
+        const double znear = camera_->zNear();
+        const double zfar = camera_->zFar();
+
+        float xmin = 0.0f, ymin = 0.0f;
+        if (camera_->type() == Camera::PERSPECTIVE) {
+            if ((expand && (new_aspect_ratio > aspect_ratio)) || (!expand && (new_aspect_ratio < aspect_ratio))) {
+                ymin = znear * std::tan(camera_->fieldOfView() / 2.0);
+                xmin = new_aspect_ratio * ymin;
+            } else {
+                xmin = znear * std::tan(camera_->fieldOfView() / 2.0) * aspect_ratio;
+                ymin = xmin / new_aspect_ratio;
+            }
+        } else {
+            camera_->getOrthoWidthHeight(xmin, ymin);
+            if ((expand && (new_aspect_ratio > aspect_ratio)) || (!expand && (new_aspect_ratio < aspect_ratio)))
+                xmin = new_aspect_ratio * ymin;
+            else
+                ymin = xmin / new_aspect_ratio;
+        }
+
+        const double delta_x = 2.0 * xmin * sub_w / static_cast<double>(width);
+        const double delta_y = 2.0 * ymin * sub_h / static_cast<double>(height);
+        int nx = width / sub_w;
+        int ny = height / sub_h;
+        // an extra tile on the right/bottom border(s) if needed
+        if (nx * sub_w < width) ++nx;
+        if (ny * sub_h < height) ++ny;
+
+        // remember the projection matrix (a copy: the buffered matrix is overwritten per tile)
+        const mat4 proj_matrix = camera_->projectionMatrix();
+
+        FramebufferObject fbo(sub_w, sub_h, samples_);
+        fbo.add_color_buffer();
+        fbo.add_depth_buffer();
+
+        // "ppm" is streamed one tile row at a time with constant memory; the other formats
+        // have to be assembled completely before their encoder can run
+        const bool streaming = (ext == "ppm");
+        std::ofstream output;
+        std::vector<unsigned char> image;   // the whole image (non-streaming formats only)
+        std::vector<unsigned char> row;     // one row of tiles (streaming only)
+        if (streaming) {
+            output.open(file_name.c_str(), std::ios::binary);
+            if (!output.is_open()) {
+                LOG(ERROR) << "could not open file: " << file_name;
+                return false;
+            }
+            output << "P6\n" << width << " " << height << "\n255\n";
+            row.resize(static_cast<std::size_t>(width) * sub_h * 3);
+        } else
+            image.resize(static_cast<std::size_t>(width) * height * 3);
+
+        std::vector<unsigned char> tile;
+        for (int j = 0; j < ny; ++j) {      // top to bottom, so finished rows can be streamed out
+            for (int i = 0; i < nx; ++i) {
+                // the sub-frustum of this tile
+                const float left = -xmin + i * delta_x;
+                const float right = -xmin + (i + 1) * delta_x;
+                const float bottom = ymin - (j + 1) * delta_y;
+                const float top = ymin - j * delta_y;
+                if (camera_->type() == Camera::PERSPECTIVE)
+                    camera_->set_projection_matrix(transform::frustum(left, right, bottom, top, znear, zfar));
+                else
+                    camera_->set_projection_matrix(transform::ortho(left, right, bottom, top, znear, zfar));
+
+                fbo.bind();
+                if (bk_white)
+                    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+                else
+                    glClearColor(background_color_[0], background_color_[1], background_color_[2], background_color_[3]);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+                const_cast<Viewer *>(this)->draw();
+                fbo.release();
+
+                if (!fbo.read_color(0, tile, GL_RGB, true)) {   // flipped: top scanline first
+                    camera_->set_projection_matrix(proj_matrix);
+                    return false;
+                }
+
+                // copy the tile (clipped at the right/bottom borders) into the row/image
+                const int tw = std::min(sub_w, width - i * sub_w);
+                const int th = std::min(sub_h, height - j * sub_h);
+                for (int y = 0; y < th; ++y) {
+                    const unsigned char *src = tile.data() + static_cast<std::size_t>(y) * sub_w * 3;
+                    unsigned char *dst = streaming
+                            ? row.data() + (static_cast<std::size_t>(y) * width + i * sub_w) * 3
+                            : image.data() + ((static_cast<std::size_t>(j) * sub_h + y) * width + i * sub_w) * 3;
+                    std::memcpy(dst, src, static_cast<std::size_t>(tw) * 3);
+                }
+            }
+            if (streaming) {
+                const int th = std::min(sub_h, height - j * sub_h);
+                output.write(reinterpret_cast<const char *>(row.data()),
+                             static_cast<std::streamsize>(th) * width * 3);
+            }
+        }
+
+        // restore the projection matrix and the clear color
+        camera_->set_projection_matrix(proj_matrix);
+        glClearColor(background_color_[0], background_color_[1], background_color_[2], background_color_[3]);
+
+        if (streaming)
+            return output.good();
+        return ImageIO::save(file_name, image, width, height, 3);
+    }
+
+
     void Viewer::draw_corner_axes() {
         ShaderProgram *program = ShaderManager::get_program("surface/surface_color");
         if (!program) {
@@ -1424,22 +1947,23 @@ namespace easy3d {
 
         const mat4 &proj = transform::ortho(-1, 1, -1, 1, -1, 1);
         const mat4 &view = camera_->orientation().inverse().matrix();
-        const mat4 &MVP = proj * view;
 
+        // the axes use their own projection, so the shared per-frame block is overridden here;
+        // the next frame re-submits the scene values anyway
+        ShaderProgram::FrameBlock frame_block;
+        frame_block.MVP = proj * view;
         // camera position is defined in world coordinate system.
-        const vec3 &wCamPos = camera_->position();
+        frame_block.wCamPos = camera_->position();
         // it can also be computed as follows:
         //const vec3& wCamPos = invMV * vec4(0, 0, 0, 1);
         const mat4 &MV = camera_->modelViewMatrix();
-        const vec4 &wLightPos = inverse(MV) * setting::light_position;
+        frame_block.wLightPos = vec3(inverse(MV) * setting::light_position);
 
         program->bind();
-        program->set_uniform("MVP", MVP)
-                ->set_uniform("lighting", true)
+        ShaderProgram::upload_block("FrameBlock", &frame_block, sizeof(frame_block));
+        program->set_uniform("lighting", true)
                 ->set_uniform("two_sides_lighting", false)
                 ->set_uniform("smooth_shading", true)
-                ->set_uniform("wLightPos", wLightPos)
-                ->set_uniform("wCamPos", wCamPos)
                 ->set_uniform("ssaoEnabled", false)
                 ->set_uniform("per_vertex_color", true)
                 ->set_uniform("distinct_back_color", false)
@@ -1538,41 +2062,125 @@ namespace easy3d {
 
 
     void Viewer::draw() const {
+        if (views_.empty()) {
+            draw_scene(camera());
+            return;
+        }
+
+        // remember the viewport and the scissor status, later we will have to restore them
+        int viewport[4], scissor[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glGetIntegerv(GL_SCISSOR_BOX, scissor);
+        const int w = viewport[2];
+        const int h = viewport[3];
+
+        // All views share the vertex buffers and shader programs of the scene: the first view
+        // rendering a drawable updates its buffers (if needed); the other views only rasterize.
+        for (const auto &view : views_) {
+            glViewport(static_cast<int>(w * view.x), static_cast<int>(h * view.y),
+                       static_cast<int>(w * view.w), static_cast<int>(h * view.h));
+            glScissor(static_cast<int>(w * view.x), static_cast<int>(h * view.y),
+                      static_cast<int>(w * view.w), static_cast<int>(h * view.h));
+            draw_scene(view.camera ? view.camera : camera());
+        }
+
+        // restore the scissor and viewport states
+        glScissor(scissor[0], scissor[1], scissor[2], scissor[3]);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
+
+
+    void Viewer::draw_scene(const Camera *cam) const {
+        // The visible drawables of all models are gathered into per-category render queues and
+        // each queue is sorted by the GL state its draw() call binds (the key is computed once
+        // per drawable per frame), so consecutive items share shader programs and textures.
+        // This cuts the redundant program/texture binds of multi-material scenes; the effect is
+        // measurable with ShaderProgram::num_switches() and Texture::num_switches().
+        typedef std::pair<std::size_t, Drawable *> QueueItem;
+        static const auto by_key = [](const QueueItem &a, const QueueItem &b) -> bool {
+            return a.first < b.first;
+        };
+        std::vector<QueueItem> lines, points, triangles, offset_triangles;
+
         for (const auto m : models_) {
             if (!m->renderer()->is_visible())
                 continue;
 
+            // view-frustum culling: models completely outside the frustum are not submitted at all
+            if (!cam->isVisible(m->bounding_box()))
+                continue;
+
+            // keep the section cap drawable of the model in sync with the clipping plane
+            if (setting::clipping_plane)
+                setting::clipping_plane->update_section_cap(m);
+
             // Let's check if edges and surfaces are both shown. If true, we
             // make the depth coordinates of the surface smaller, so that displaying
             // the mesh and the surface together does not cause Z-fighting.
             std::size_t count = 0;
             for (auto d : m->renderer()->lines_drawables()) {
                 if (d->is_visible()) {
-                    d->draw(camera(), false); easy3d_debug_log_gl_error;
+                    lines.push_back(QueueItem(d->sort_key(), d));
                     ++count;
                 }
             }
 
             for (auto d : m->renderer()->points_drawables()) {
                 if (d->is_visible())
-                    d->draw(camera(), false); easy3d_debug_log_gl_error;
+                    points.push_back(QueueItem(d->sort_key(), d));
             }
 
-            if (count > 0) {
-                glEnable(GL_POLYGON_OFFSET_FILL);
-                glPolygonOffset(0.5f, -0.0001f);
-            }
             for (auto d : m->renderer()->triangles_drawables()) {
                 if (d->is_visible())
-                    d->draw(camera(), false); easy3d_debug_log_gl_error;
+                    (count > 0 ? offset_triangles : triangles).push_back(QueueItem(d->sort_key(), d));
+            }
+        }
+
+        // the stable sort keeps the model order for equal keys, so the draw order is deterministic
+        std::stable_sort(lines.begin(), lines.end(), by_key);
+        std::stable_sort(points.begin(), points.end(), by_key);
+        std::stable_sort(triangles.begin(), triangles.end(), by_key);
+        std::stable_sort(offset_triangles.begin(), offset_triangles.end(), by_key);
+
+        if (!lines.empty()) {
+            FrameProfiler::Section section("lines");
+            for (const auto &item : lines) {
+                item.second->draw(cam, false); easy3d_debug_log_gl_error;
+            }
+        }
+
+        if (!points.empty()) {
+            FrameProfiler::Section section("points");
+            for (const auto &item : points) {
+                item.second->draw(cam, false); easy3d_debug_log_gl_error;
+            }
+        }
+
+        if (!triangles.empty() || !offset_triangles.empty()) {
+            FrameProfiler::Section section("triangles");
+            for (const auto &item : triangles) {
+                item.second->draw(cam, false); easy3d_debug_log_gl_error;
             }
-            if (count > 0)
+            if (!offset_triangles.empty()) {
+                glEnable(GL_POLYGON_OFFSET_FILL);
+                glPolygonOffset(0.5f, -0.0001f);
+                for (const auto &item : offset_triangles) {
+                    item.second->draw(cam, false); easy3d_debug_log_gl_error;
+                }
                 glDisable(GL_POLYGON_OFFSET_FILL);
+            }
         }
 
-        for (auto d : drawables_) {
-            if (d->is_visible())
-                d->draw(camera(), false);
+        if (!drawables_.empty()) {
+            FrameProfiler::Section section("drawables");
+            std::vector<QueueItem> others;
+            for (auto d : drawables_) {
+                if (d->is_visible() && cam->isVisible(d->bounding_box()))
+                    others.push_back(QueueItem(d->sort_key(), d));
+            }
+            std::stable_sort(others.begin(), others.end(), by_key);
+            for (const auto &item : others)
+                item.second->draw(cam, false);
         }
     }
 
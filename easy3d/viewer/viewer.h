@@ -26,7 +26,11 @@
 #define EASY3D_VIEWER_VIEWER_H
 
 
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <easy3d/core/types.h>
@@ -194,6 +198,40 @@ namespace easy3d {
          */
         virtual Model* add_model(const std::string& file_name, bool create_default_drawables = true);
 
+        /**
+         * @brief Add a model to the viewer without blocking the rendering thread.
+         * @details The file is parsed on a background thread, so the viewer stays interactive
+         *          during long loads. Once the data is in memory, the finished model is handed
+         *          over to the rendering thread, which creates the drawables and uploads the
+         *          buffers (OpenGL resources must be created on the thread owning the context).
+         *          Loading progress is reported through the usual progress mechanism (see
+         *          ProgressClient in easy3d/util/progress.h). For ptx files, every point cloud
+         *          in the file is added as soon as it becomes available.
+         * @param file_name The string of the file name.
+         * @param create_default_drawables If ture, the default drawables will be created.
+         * @related add_model(const std::string&, bool).
+         */
+        void add_model_async(const std::string& file_name, bool create_default_drawables = true);
+
+        /**
+         * @brief Add a batch of models to the viewer, parsing the files in parallel.
+         * @details The files are parsed concurrently on the workers of the global thread pool,
+         *          and the loaded models are then added in one pass. Unlike calling add_model()
+         *          once per file, no frame is rendered between the additions, so the OpenGL
+         *          buffers of all the models are created in a single consolidated upload phase
+         *          at the next frame instead of interleaved with redraws — on large multi-tile
+         *          projects this makes the scene open time I/O bound. The call blocks until all
+         *          files are processed (use add_model_async() to keep the viewer interactive
+         *          during the load).
+         * @param file_names The files to load. Files that fail to parse are skipped (with a
+         *          warning); a ptx file contributes one model per contained point cloud.
+         * @param create_default_drawables If ture, the default drawables will be created.
+         * @return The models added to the viewer, in the order of \p file_names.
+         * @related add_model(const std::string&, bool).
+         */
+        std::vector<Model*> add_models(const std::vector<std::string>& file_names,
+                                       bool create_default_drawables = true);
+
         /**
          * @brief Add an existing model to the viewer to be visualized. After a model being added
          *        to the viewer, the viewer will be incharge of its memory menagement.
@@ -227,6 +265,27 @@ namespace easy3d {
          */
         const std::vector<Model*>& models() const { return models_; }
 
+        /**
+         * @brief The memory (in bytes) occupied by all models in the viewer.
+         * @details Aggregates Model::memory_usage() over the scene. Use memory_report() for a
+         *          per-model, per-property breakdown when hunting for what is eating the RAM.
+         */
+        std::size_t memory_usage() const;
+
+        /**
+         * @brief Prints a per-model, per-property memory breakdown to an output stream (e.g.,
+         *        std::cout), reporting for every property the bytes used and allocated. The
+         *        difference is the slack left by vector growth; Model::shrink_to_fit() (or
+         *        shrink_all_to_fit() for the whole scene) reclaims it.
+         */
+        void memory_report(std::ostream& output) const;
+
+        /**
+         * @brief Releases the unused capacity of the property arrays of all models in the
+         *        viewer. @return The number of bytes reclaimed.
+         */
+        std::size_t shrink_all_to_fit();
+
         /**
          * @brief Query the active model.
          * @details The viewer can manage/visiulize/process multiple models. The default behavior
@@ -269,6 +328,45 @@ namespace easy3d {
          */
         void clear_scene();
 
+        /** --------------------------- multi-view support ------------------------------- */
+
+        /**
+         * @brief Add a view, i.e., a sub-region of the content area in which the scene is rendered
+         *        (possibly from another viewpoint).
+         * @details Once views have been added, every frame renders the scene once per view instead of
+         *          once for the whole content area. All views share the OpenGL resources (the vertex
+         *          buffers and shader programs) of the scene, and the buffers of a drawable are updated
+         *          at most once per frame (by the first view rendering it), so each additional view only
+         *          pays the rasterization cost. Typical use is a 2 x 2 layout of synchronized
+         *          top/front/side/perspective views of the same scene.
+         * @param x/y/w/h The region of the view relative to the content area (values in [0, 1], with
+         *        the origin at the lower-left corner).
+         * @param own_camera If true, the view gets its own camera (initialized from the viewer's
+         *        camera), which can be retrieved by view_camera() and oriented independently, e.g., for
+         *        an orthographic top view. If false, the view shares the viewer's camera.
+         * @return The index of the view.
+         * @note User interaction (mouse/keyboard) manipulates the viewer's camera; the cameras of the
+         *       views are controlled programmatically. \see view_camera(int).
+         */
+        int add_view(float x, float y, float w, float h, bool own_camera = false);
+
+        /**
+         * @brief The number of views. The viewer behaves as a single view covering the whole content
+         *        area until a view has been added.
+         */
+        int num_views() const { return static_cast<int>(views_.size()); }
+
+        /**
+         * @brief The camera of the view \p idx (the viewer's camera for views sharing it).
+         */
+        Camera* view_camera(int idx);
+
+        /**
+         * @brief Remove all views (the cameras owned by the views are deleted). The viewer falls back
+         *        to the single-view behavior.
+         */
+        void clear_views();
+
         /** ----------------------------- UI ----------------------------------- */
 
         /**
@@ -287,6 +385,26 @@ namespace easy3d {
          */
 	    bool snapshot(bool bk_white = true) const;
 
+        /**
+         * @brief Render the scene into an image file of an arbitrary resolution, tile by tile.
+         * @details The scene is rendered into a sequence of framebuffer-sized tiles, each drawn
+         *          with the matching sub-frustum of the camera's projection, so the resolution is
+         *          not limited by the largest framebuffer the driver supports and the GPU memory
+         *          use stays constant. For "ppm" output the finished tile rows are streamed
+         *          directly into the file, which keeps the peak memory constant regardless of the
+         *          resolution; the other formats are assembled in memory before saving (e.g., a
+         *          16K x 16K image needs 768 MB), so prefer "ppm" for extreme resolutions.
+         * @param file_name The output image file: png, jpg, bmp, tga, or ppm.
+         * @param width The width of the output image, in pixels.
+         * @param height The height of the output image, in pixels.
+         * @param bk_white Use a white background instead of the viewer's background color.
+         * @param expand When the aspect ratio of the output differs from that of the viewer,
+         *        expand the view frustum to cover the extra extent (true) or crop it (false).
+         * @return true on success and false otherwise.
+         */
+        bool snapshot(const std::string& file_name, int width, int height,
+                      bool bk_white = true, bool expand = true) const;
+
         /**
          * @brief Query the XYZ coordinates of the surface point under the cursor.
          * @param x The cursor x-coordinate, relative to the left edge of the content area.
@@ -310,9 +428,34 @@ namespace easy3d {
          * @brief Update the display (i.e., repaint).
          * @details This method is used to update the display of the rendering. Client should call
          *          it when your data/view is changed.
+         * @note The viewer re-renders only when something has changed: update() marks the content
+         *       dirty, and the main loop skips the draw procedure entirely (keeping the presented
+         *       frame) for events that did not damage it, e.g., cursor moves with no button
+         *       pressed. Camera manipulations and the built-in shortcuts mark the content dirty
+         *       automatically; code changing the scene by other means must call update().
          */
         void update() const;
 
+        /**
+         * @brief Registers an animation that ticks at a fixed rate.
+         * @details The function is called from the rendering thread, at most \p rate_hz times per
+         *          second, right before the frame is rendered; a frame is rendered only when at
+         *          least one animation ticked (or something else damaged the content), so an idle
+         *          scene does not render at all. Animations due at (nearly) the same moment are
+         *          ticked together and share one frame - three 30 Hz animations still produce
+         *          30 frames per second, not 90. Between ticks the main loop sleeps in the event
+         *          wait, waking for input or for the earliest due animation.
+         * @param func The per-tick function. Return false to unregister the animation (e.g., when
+         *          a transition has reached its target).
+         * @param rate_hz The tick rate. Rates above the monitor refresh rate are pointless: with
+         *          vsync on, frames cannot be presented faster than the monitor refreshes.
+         * @return An id for remove_animation().
+         */
+        unsigned int add_animation(std::function<bool(Viewer*)> func, float rate_hz = 30.0f);
+
+        /** @brief Unregisters an animation. \sa add_animation(). */
+        void remove_animation(unsigned int id);
+
         /**
          * @brief The usage information of the viewer. For the time being, it is the manual of the
          *        viewer. User can override the usage.
@@ -324,6 +467,9 @@ namespace easy3d {
         // rendering. Users can put their additional rendering function here by reimplementing it.
         virtual void draw() const;
 
+        // render the scene (all models and the standalone drawables) as seen from cam.
+        void draw_scene(const Camera* cam) const;
+
 		// OpenGL resources (e.g., shaders, textures, VAOs) must be created when 
 		// there exists a valid rendering context. It is (usually) a bad idea to do 
 		// this in a constructor because the OpenGL context may not have been 
@@ -344,6 +490,20 @@ namespace easy3d {
 		//		 inherited function.
 		virtual void cleanup();
 
+        // Load a model from a file. This is the format dispatch of add_model(file_name)
+        // without any of the viewer bookkeeping, so it can run on a worker thread.
+        // NOTE: ptx files (which may contain multiple point clouds) are handled by the
+        //       callers, see add_model(const std::string&, bool) and add_model_async().
+        static Model* read_model(const std::string& file_name);
+
+        // Hand a model loaded on a worker thread over to the rendering thread and wake
+        // up the event loop. See add_model_async().
+        void enqueue_model(Model* model, bool create_default_drawables);
+
+        // Add the models finished by the worker threads to the viewer. Called by the
+        // rendering thread in the main loop. See add_model_async().
+        void process_pending_models();
+
 		// This function will be called before the main draw procedure.
         virtual void pre_draw();
 
@@ -399,6 +559,17 @@ namespace easy3d {
         virtual bool callback_event_scroll(double dx, double dy);
         virtual void callback_event_resize(int w, int h);
 
+        // applies the mouse motion and scroll deltas accumulated since the last call (see the
+        // coalescing members below). Called once per iteration of the main loop and on mouse
+        // button transitions (so deltas are attributed to the button that produced them).
+        void flush_coalesced_events();
+
+        // runs the animations that are due, removes the finished ones, and marks the content
+        // dirty if any ticked. Returns the time (glfwGetTime() clock) of the earliest upcoming
+        // tick, or a negative value if no animations are registered; the main loop uses it to
+        // sleep in the event wait exactly until the next tick or the next input event.
+        double tick_animations();
+
         void draw_corner_axes();
 
 	protected:
@@ -417,6 +588,11 @@ namespace easy3d {
 
 		// enable/disable event processing
 		bool	process_events_;
+
+		// does the content need to be re-rendered? (see update()). The main loop clears the
+		// flag before drawing, so update() calls issued while a frame is being rendered
+		// schedule the next one.
+		mutable bool needs_update_;
 		char   gpu_time_[48];       // show the frame rate
 
         TextRenderer* texter_;
@@ -431,6 +607,26 @@ namespace easy3d {
 		int     mouse_pressed_y_;
 		int     pressed_key_;
 
+		// input event coalescing. A high-rate mouse can deliver many motion/scroll events per
+		// rendered frame, each of which used to trigger camera math and a redraw request while
+		// only the accumulated delta matters. The event callbacks just sum the deltas here;
+		// they are applied once per rendered frame by flush_coalesced_events().
+		int     drag_pending_dx_;
+		int     drag_pending_dy_;
+		int     scroll_pending_dx_;
+		int     scroll_pending_dy_;
+
+		// rate-controlled animations (see add_animation()). Touched only by the rendering
+		// thread, so no locking is needed.
+		struct Animation {
+			unsigned int id;
+			std::function<bool(Viewer*)> func;
+			double interval;    // seconds between ticks
+			double next_time;   // glfwGetTime() of the next due tick
+		};
+		std::vector<Animation> animations_;
+		unsigned int next_animation_id_;
+
 		bool    show_pivot_point_;
 
 		//----------------- viewer data -------------------
@@ -444,8 +640,20 @@ namespace easy3d {
 		std::vector<Model*> models_;
 		int model_idx_;
 
+        // asynchronous model loading (see add_model_async())
+        std::vector<std::thread> loader_threads_;
+        std::vector< std::pair<Model*, bool> > pending_models_; // finished but not yet added
+        std::mutex pending_models_mutex_;
+
         // drawables independent of any model
         std::vector<Drawable*> drawables_;
+
+        // the views (see add_view()). Empty means the usual single full-window view.
+        struct View {
+            float x, y, w, h;   // the region, relative to the content area
+            Camera* camera;     // nullptr for views sharing the viewer's camera
+        };
+        std::vector<View> views_;
 	};
 
 }
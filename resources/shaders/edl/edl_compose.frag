@@ -54,13 +54,56 @@ out vec4	fragOutput;
 uniform sampler2D    s2_S1;  // fine scale
 uniform sampler2D    s2_S2;  // larger medium scale
 uniform sampler2D    s2_C;   // scene color image
+uniform sampler2D    s2_D;   // scene depth image, always full resolution
+uniform bool         scaled; // true if the shading images have a reduced resolution
+uniform float        Znear;
+uniform float        Zfar;
 							 /**************************************************/
 
+float linear_z(float d)
+{
+	d = d * 2.0 - 1.0;
+	return (2.0 * Znear * Zfar) / (Zfar + Znear - d * (Zfar - Znear));
+}
+
+// depth-aware upsampling of a reduced resolution shading image: taps whose depth
+// (stored in the alpha channel of the shading image) differs from the full
+// resolution depth are discounted, so shading does not bleed across silhouettes
+vec4 upsample(sampler2D s, float zc)
+{
+	vec2 texelSize = 1.0 / vec2(textureSize(s, 0));
+	vec4  sum = vec4(0.);
+	float weight_sum = 0.;
+	for (int x = -1; x <= 1; ++x)
+	{
+		for (int y = -1; y <= 1; ++y)
+		{
+			vec2 uv = tcoordVC.st + vec2(float(x), float(y)) * texelSize;
+			vec4 tap = texture(s, uv);
+			float w = 1.0 / (0.01 + abs(linear_z(tap.a) - zc) / zc);
+			sum += tap * w;
+			weight_sum += w;
+		}
+	}
+	return sum / weight_sum;
+}
+
 void main(void)
 {
-        vec4 shade1 = texture(s2_S1, tcoordVC.st);
-        vec4 shade2 = texture(s2_S2, tcoordVC.st);
-        vec4  color = texture(s2_C, tcoordVC.st);
+	vec4 shade1;
+	vec4 shade2;
+	if (scaled)
+	{
+		float zc = linear_z(texture(s2_D, tcoordVC.st).r);
+		shade1 = upsample(s2_S1, zc);
+		shade2 = upsample(s2_S2, zc);
+	}
+	else
+	{
+		shade1 = texture(s2_S1, tcoordVC.st);
+		shade2 = texture(s2_S2, tcoordVC.st);
+	}
+	vec4  color = texture(s2_C, tcoordVC.st);
 
 	// if it is the background(ala depth > 0.99) just copy it
 	//if (shade1.a > 0.99)
@@ -73,5 +116,6 @@ void main(void)
 		fragOutput = vec4(color.rgb*lum, color.a);
 	//}
 
-	gl_FragDepth = shade1.a; // write stored depth
+	// write stored depth (with reduced resolution shading, the full resolution depth is used)
+	gl_FragDepth = scaled ? texture(s2_D, tcoordVC.st).r : shade1.a;
 }
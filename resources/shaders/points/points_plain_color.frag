@@ -20,6 +20,11 @@ uniform bool highlight;
 uniform int  hightlight_id_min;
 uniform int  hightlight_id_max;
 
+// rebuild-free highlighting of arbitrary selections: one bit per primitive, indexed by
+// gl_PrimitiveID (see Drawable::update_highlight_mask())
+uniform bool           use_highlight_mask;
+uniform usamplerBuffer highlightMask;
+
 in Data{
     vec4 color;
     vec3 position;
@@ -42,6 +47,11 @@ void main(void) {
         if (gl_PrimitiveID >= hightlight_id_min && gl_PrimitiveID <= hightlight_id_max)
         color = mix(color, vec3(1.0, 0.0, 0.0), 0.8);
     }
+    if (use_highlight_mask) {
+        uint word = texelFetch(highlightMask, gl_PrimitiveID >> 5).r;
+        if ((word & (1u << (gl_PrimitiveID & 31))) != 0u)
+            color = mix(color, vec3(1.0, 0.0, 0.0), 0.8);
+    }
 
     vec3 view_dir = normalize(wCamPos - DataIn.position);// compute view direction and normalize it
     vec3 normal = DataIn.normal;
@@ -0,0 +1,68 @@
+#version 150
+
+uniform vec3    eLightPos;
+uniform bool    lighting = true;
+uniform bool    two_sides_lighting = true;
+
+layout(std140) uniform Material {
+        vec3	ambient;		// in [0, 1], r==g==b;
+        vec3	specular;		// in [0, 1], r==g==b;
+        float	shininess;
+};
+
+uniform bool highlight;
+uniform int  hightlight_id_min;
+uniform int  hightlight_id_max;
+
+in Data{
+    vec4 color;
+    vec3 position;	// in eye space
+    vec3 normal;	// in eye space
+} DataIn;
+
+out vec4 outputF;
+
+
+void main()
+{
+    // a round splat: discard the corners of the point sprite
+    vec2 tex = gl_PointCoord * 2.0 - vec2(1.0);
+    if (dot(tex, tex) > 1.0)
+        discard;
+
+    if (!lighting) {
+        outputF = DataIn.color;
+        return;
+    }
+
+    // camera pos is (0, 0, 0) in the camera coordinate system
+    vec3 normal = normalize(DataIn.normal);
+    vec3 light_dir = normalize(eLightPos);
+
+    float df = 0.0;	// diffuse factor
+    if (two_sides_lighting)
+        df = abs(dot(light_dir, normal));
+    else
+        df = max(dot(light_dir, normal), 0);
+
+    float sf = 0.0;	// specular factor
+    if (df > 0.0) {	// if the fragment is lit compute the specular color
+        vec3 view_dir = normalize(-DataIn.position);
+        vec3 half_vector = normalize(light_dir + view_dir);	// compute the half vector
+
+        if (two_sides_lighting)
+            sf = abs(dot(half_vector, normal));
+        else
+            sf = max(dot(half_vector, normal), 0.0);
+
+        sf = pow(sf, shininess);
+    }
+
+    vec3 color = DataIn.color.xyz;
+    if (highlight) {
+        if (gl_PrimitiveID >= hightlight_id_min && gl_PrimitiveID <= hightlight_id_max)
+            color = mix(color, vec3(1.0, 0.0, 0.0), 0.8);
+    }
+
+    outputF = vec4(color * df + specular * sf + ambient, DataIn.color.a);
+}
@@ -0,0 +1,63 @@
+#version 150		// for point sprite to work
+
+in vec3  vtx_position;
+in vec3  vtx_color;
+in vec3  vtx_normal;
+in float vtx_radius;	// the per-point splat radius, precomputed from the k-NN distances
+
+uniform mat4 MV;
+uniform mat4 PROJ;
+uniform mat4 MANIP = mat4(1.0);
+
+uniform int   screen_width;     // scale to calculate size in pixels
+uniform float radius_scale;     // a global scale on the per-point radii
+uniform float max_screen_size;  // the screen-space bound of a splat, in pixels
+
+uniform vec4 default_color;
+uniform bool per_vertex_color;
+
+uniform bool planeClippingDiscard = false;
+uniform bool clippingPlaneEnabled = false;
+uniform bool crossSectionEnabled = false;
+uniform vec4 clippingPlane0;
+uniform vec4 clippingPlane1;
+
+out Data {
+    vec4 color;
+    vec3 position;	// in eye space
+    vec3 normal;	// in eye space
+} DataOut;
+
+
+void main()
+{
+    if (per_vertex_color)
+        DataOut.color = vec4(vtx_color, 1.0);
+    else
+        DataOut.color = default_color;
+
+    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+
+    if (clippingPlaneEnabled) {
+        gl_ClipDistance[0] = dot(new_position, clippingPlane0);
+        if (planeClippingDiscard && gl_ClipDistance[0] < 0)
+            return;
+        if (crossSectionEnabled) {
+            gl_ClipDistance[1] = dot(new_position, clippingPlane1);
+            if (planeClippingDiscard && gl_ClipDistance[1] < 0)
+                return;
+        }
+    }
+
+    vec4 position = MV * new_position;	// eye space
+    DataOut.position = position.xyz;
+    DataOut.normal = mat3(MV) * mat3(MANIP) * vtx_normal;
+
+    // the splat diameter in pixels, bounded so that the densest regions do not overdraw
+    // http://stackoverflow.com/questions/8608844/resizing-point-sprites-based-on-distance-from-the-camera
+    float radius = vtx_radius * radius_scale;
+    vec4 projCorner = PROJ * vec4(radius, radius, position.z, position.w);
+    gl_PointSize = clamp(screen_width * projCorner.x / projCorner.w, 1.0, max_screen_size);
+
+    gl_Position = PROJ * position;
+}
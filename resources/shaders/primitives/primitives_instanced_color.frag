@@ -0,0 +1,34 @@
+#version 150
+
+uniform vec3	wLightPos;
+uniform vec3	wCamPos;
+
+uniform vec3	ambient = vec3(0.05, 0.05, 0.05);
+uniform vec3	specular = vec3(0.4, 0.4, 0.4);
+uniform float	shininess = 64.0;
+
+in Data{
+	vec3 color;
+	vec3 normal;
+	vec3 position;
+} DataIn;
+
+out vec4 outputF;
+
+void main(void)
+{
+	vec3 normal = normalize(DataIn.normal);
+
+	vec3 view_dir = normalize(wCamPos - DataIn.position);
+	vec3 light_dir = normalize(wLightPos);
+
+	// diffuse factor
+	float df = abs(dot(light_dir, normal));				// light up both sides
+
+	// specular factor
+	vec3 half_vector = normalize(light_dir + view_dir);	// compute the half vector
+	float sf = max(dot(half_vector, normal), 0.0);		// only the front side can have specular
+	sf = pow(sf, shininess);
+
+	outputF = vec4(DataIn.color * df + specular * sf + ambient, 1.0);
+}
@@ -0,0 +1,30 @@
+#version 150
+
+in vec3 vtx_position;	// vertex position of the unit primitive
+in vec3 vtx_normal;		// vertex normal of the unit primitive
+
+// per-instance attributes
+in mat4 instance_matrix;	// the transformation of the instance (occupies 4 attribute slots)
+in vec3 instance_color;		// the color of the instance
+
+uniform mat4 MVP;
+uniform mat4 MANIP = mat4(1.0);
+
+// the data to be sent to the fragment shader
+out Data{
+	vec3 color;
+	vec3 normal;
+	vec3 position;
+} DataOut;
+
+void main()
+{
+	vec4 pos = MANIP * instance_matrix * vec4(vtx_position, 1.0);
+
+	// valid for translations, rotations, and uniform scalings (the typical gizmo transforms)
+	DataOut.normal = normalize(mat3(instance_matrix) * vtx_normal);
+	DataOut.position = pos.xyz;
+	DataOut.color = instance_color;
+
+	gl_Position = MVP * pos;
+}
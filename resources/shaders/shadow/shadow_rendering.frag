@@ -16,6 +16,11 @@ uniform bool    is_background = false;
 uniform sampler2DShadow  shadowMap;
 uniform float darkness;
 
+uniform mat4 SHADOW[4];
+uniform int  num_cascades = 1;
+uniform vec4 cascade_splits;	// the far distance of each cascade along the view direction
+uniform vec3 wViewDir;
+
 in Data{
 	vec3 color;
 	vec3 normal;
@@ -60,7 +65,21 @@ vec3 shade(vec3 worldPos)
 void main(void) {
         vec3 color = shade(DataIn.position);
 
-        vec3 coords = DataIn.shadowCoord.xyz / DataIn.shadowCoord.w;
+        vec4 sc = DataIn.shadowCoord;
+        if (num_cascades > 1) {
+            // select the cascade from the distance along the view direction
+            float dist = dot(DataIn.position - wCamPos, wViewDir);
+            int cascade = num_cascades - 1;
+            for (int i = 0; i < num_cascades - 1; ++i) {
+                if (dist <= cascade_splits[i]) {
+                    cascade = i;
+                    break;
+                }
+            }
+            sc = SHADOW[cascade] * vec4(DataIn.position, 1.0);
+        }
+
+        vec3 coords = sc.xyz / sc.w;
         // to avoid shadow acne: See: http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-16-shadow-mapping/
         coords.z -= 0.005;
         float visibility = texture(shadowMap, coords);
@@ -4,7 +4,7 @@ in  vec3 vtx_position;	// vertex position
 in  vec3 vtx_normal;	// vertex normal
 in  vec3 vtx_color;		// vertex color
 
-uniform mat4 SHADOW;
+uniform mat4 SHADOW[4];
 uniform mat4 MVP;
 uniform mat4 MANIP = mat4(1.0);
 
@@ -47,7 +47,9 @@ void main() {
 
 	DataOut.normal = vtx_normal;
 	DataOut.position = new_position.xyz;
-	DataOut.shadowCoord = SHADOW * new_position;
+	// the coordinates of the first cascade; the other cascades (if any) are
+	// computed in the fragment shader, where the depth slice is known.
+	DataOut.shadowCoord = SHADOW[0] * new_position;
 
 	// the position of the vertex as seen from the current camera, in clip space
 	gl_Position = MVP * new_position;
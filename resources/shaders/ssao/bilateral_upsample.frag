@@ -0,0 +1,46 @@
+#version 150
+
+
+in vec2 TexCoords;
+
+uniform sampler2D ssaoInput;     // occlusion computed at reduced resolution
+uniform sampler2D gPosition;     // full resolution eye-space positions (geometry prepass)
+uniform sampler2D depthTexture;  // full resolution hardware depth (shared depth prepass)
+
+uniform bool  use_depth_texture;
+uniform float Znear;
+uniform float Zfar;
+
+out float FragColor;
+
+float eye_depth(vec2 uv)
+{
+    if (use_depth_texture) {
+        float d = texture(depthTexture, uv).r * 2.0 - 1.0;
+        return (2.0 * Znear * Zfar) / (Zfar + Znear - d * (Zfar - Znear));
+    }
+    return -texture(gPosition, uv).z;
+}
+
+void main()
+{
+    // joint bilateral upsampling: taps whose depth differs from the center pixel are
+    // discounted, so occlusion does not bleed across silhouettes
+    vec2 texelSize = 1.0 / vec2(textureSize(ssaoInput, 0));
+    float zc = eye_depth(TexCoords);
+
+    float result = 0.0;
+    float weight_sum = 0.0;
+    for (int x = -1; x <= 1; ++x)
+    {
+        for (int y = -1; y <= 1; ++y)
+        {
+            vec2 uv = TexCoords + vec2(float(x), float(y)) * texelSize;
+            float z = eye_depth(uv);
+            float w = 1.0 / (0.01 + abs(z - zc) / max(zc, 0.001));
+            result += texture(ssaoInput, uv).r * w;
+            weight_sum += w;
+        }
+    }
+    FragColor = result / weight_sum;
+}
\ No newline at end of file
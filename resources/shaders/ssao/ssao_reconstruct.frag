@@ -0,0 +1,73 @@
+#version 150
+
+in vec2 TexCoords;
+
+// the SSAO pass of a shared depth prepass: eye-space positions are reconstructed from the
+// depth values and normals are derived from the position derivatives, so the geometry does
+// not have to be rendered again into a dedicated geometry buffer.
+
+uniform sampler2D depthTexture;
+uniform sampler2D texNoise;
+
+uniform vec3 samples[64];
+
+uniform mat4 PROJ;
+uniform mat4 invPROJ;
+
+// parameters (you'd probably want to use them as uniforms to more easily tweak the effect)
+const int kernelSize = 64;
+uniform float radius;
+uniform float bias;
+
+out float FragColor;
+
+// reconstruct the eye-space position from the hardware depth buffer
+vec3 eye_position(vec2 uv)
+{
+    float depth = texture(depthTexture, uv).r;
+    vec4 ndc = vec4(uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 pos = invPROJ * ndc;
+    return pos.xyz / pos.w;
+}
+
+void main()
+{
+	// tile noise texture over screen based on screen dimensions divided by noise size
+	vec2 noiseScale = textureSize(depthTexture, 0) / 4.0;
+
+    // get input for SSAO algorithm
+    vec3 fragPos = eye_position(TexCoords);
+    // derive the eye-space normal from the position derivatives, flipped to face the viewer
+    vec3 normal = normalize(cross(dFdx(fragPos), dFdy(fragPos)));
+    if (normal.z < 0.0)
+        normal = -normal;
+    vec3 randomVec = normalize(texture(texNoise, TexCoords * noiseScale).xyz);
+    // create TBN change-of-basis matrix: from tangent-space to view-space
+    vec3 tangent = normalize(randomVec - normal * dot(randomVec, normal));
+    vec3 bitangent = cross(normal, tangent);
+    mat3 TBN = mat3(tangent, bitangent, normal);
+    // iterate over the sample kernel and calculate occlusion factor
+    float occlusion = 0.0;
+    for(int i = 0; i < kernelSize; ++i)
+    {
+        // get sample position
+        vec3 sample = TBN * samples[i]; // from tangent to view-space
+        sample = fragPos + sample * radius;
+
+        // project sample position (to sample texture) (to get position on screen/texture)
+        vec4 offset = vec4(sample, 1.0);
+        offset = PROJ * offset; // from view to clip-space
+        offset.xyz /= offset.w; // perspective divide
+        offset.xyz = offset.xyz * 0.5 + 0.5; // transform to range 0.0 - 1.0
+
+        // get sample depth
+        float sampleDepth = eye_position(offset.xy).z; // get depth value of kernel sample
+
+        // range check & accumulate
+        float rangeCheck = smoothstep(0.0, 1.0, radius / abs(fragPos.z - sampleDepth));
+        occlusion += (sampleDepth >= sample.z + bias ? 1.0 : 0.0) * rangeCheck;
+    }
+    occlusion = 1.0 - (occlusion / kernelSize);
+
+    FragColor = occlusion;
+}
\ No newline at end of file
@@ -7,7 +7,11 @@ in  vec3 vtx_color;
 uniform vec4	default_color = vec4(0.4f, 0.8f, 0.8f, 1.0f);
 uniform bool	per_vertex_color = false;
 
-uniform mat4	MVP;
+layout(std140) uniform FrameBlock {
+    mat4 MVP;
+    vec3 wLightPos;
+    vec3 wCamPos;
+};
 uniform mat4 MANIP = mat4(1.0);
 uniform bool planeClippingDiscard = false;
 uniform bool clippingPlaneEnabled = false;
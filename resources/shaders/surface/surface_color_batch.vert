@@ -0,0 +1,50 @@
+#version 150
+#extension GL_ARB_shader_draw_parameters : require
+
+in  vec3 vtx_position;
+in  vec3 vtx_normal;
+
+// the per-object colors of the batch, indexed by the draw command id (see MultiDrawBatch)
+layout(std140) uniform BatchColors {
+    vec4 batch_colors[1024];
+};
+
+layout(std140) uniform FrameBlock {
+    mat4 MVP;
+    vec3 wLightPos;
+    vec3 wCamPos;
+};
+uniform mat4 MANIP = mat4(1.0);
+uniform bool planeClippingDiscard = false;
+uniform bool clippingPlaneEnabled = false;
+uniform bool crossSectionEnabled = false;
+uniform vec4 clippingPlane0;
+uniform vec4 clippingPlane1;
+
+
+out Data{
+    vec4 color;
+    vec3 position;
+    vec3 normal;
+} DataOut;
+
+void main() {
+    vec4 new_position = MANIP * vec4(vtx_position, 1.0);
+
+    if (clippingPlaneEnabled) {
+        gl_ClipDistance[0] = dot(new_position, clippingPlane0);
+        if (planeClippingDiscard && gl_ClipDistance[0] < 0)
+            return;
+        if (crossSectionEnabled) {
+            gl_ClipDistance[1] = dot(new_position, clippingPlane1);
+            if (planeClippingDiscard && gl_ClipDistance[1] < 0)
+                return;
+        }
+    }
+
+    DataOut.color = batch_colors[gl_DrawIDARB];
+    DataOut.position = new_position.xyz;
+    DataOut.normal = vtx_normal;
+
+    gl_Position = MVP * new_position;
+}
@@ -0,0 +1,66 @@
+#version 150
+
+in  vec3 vtx_position;
+in  vec3 vtx_normal;
+in  vec3 vtx_color;
+// the per-instance transformation, occupying four consecutive attribute locations (one per column)
+in  mat4 vtx_instance_matrix;
+
+uniform vec4	default_color = vec4(0.4f, 0.8f, 0.8f, 1.0f);
+uniform bool	per_vertex_color = false;
+
+// picking: every instance is rendered with its encoded id instead of its color (see ModelPicker)
+uniform bool	picking = false;
+uniform int		picking_id = 0;
+
+layout(std140) uniform FrameBlock {
+    mat4 MVP;
+    vec3 wLightPos;
+    vec3 wCamPos;
+};
+uniform mat4 MANIP = mat4(1.0);
+uniform bool planeClippingDiscard = false;
+uniform bool clippingPlaneEnabled = false;
+uniform bool crossSectionEnabled = false;
+uniform vec4 clippingPlane0;
+uniform vec4 clippingPlane1;
+
+
+out Data{
+    vec4 color;
+    vec3 position;
+    vec3 normal;
+} DataOut;
+
+void main() {
+    vec4 new_position = MANIP * (vtx_instance_matrix * vec4(vtx_position, 1.0));
+
+    if (clippingPlaneEnabled) {
+        gl_ClipDistance[0] = dot(new_position, clippingPlane0);
+        if (planeClippingDiscard && gl_ClipDistance[0] < 0)
+            return;
+        if (crossSectionEnabled) {
+            gl_ClipDistance[1] = dot(new_position, clippingPlane1);
+            if (planeClippingDiscard && gl_ClipDistance[1] < 0)
+                return;
+        }
+    }
+
+    if (picking) {
+        int id = picking_id + gl_InstanceID;
+        DataOut.color.r = ((id >> 16) & 0xff) / 255.0;
+        DataOut.color.g = ((id >> 8) & 0xff) / 255.0;
+        DataOut.color.b = (id & 0xff) / 255.0;
+        DataOut.color.a = (id >> 24) / 255.0;
+    }
+    else if (per_vertex_color)
+        DataOut.color = vec4(vtx_color, 1.0);
+    else
+        DataOut.color = default_color;
+
+    DataOut.position = new_position.xyz;
+    // correct for rigid (and uniformly scaled) instance transformations
+    DataOut.normal = mat3(vtx_instance_matrix) * vtx_normal;
+
+    gl_Position = MVP * new_position;
+}
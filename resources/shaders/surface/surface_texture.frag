@@ -2,8 +2,11 @@
 // please send comments or report bug to: liangliang.nan@gmail.com
 
 
-uniform vec3    wLightPos;
-uniform vec3    wCamPos;
+layout(std140) uniform FrameBlock {
+    mat4 MVP;
+    vec3 wLightPos;
+    vec3 wCamPos;
+};
 
 layout(std140) uniform Material {
     vec3    ambient;// in [0, 1], r==g==b;
@@ -5,7 +5,11 @@ in vec3 vtx_position;
 in vec2 vtx_texcoord;
 in vec3 vtx_normal;
 
-uniform mat4	MVP;
+layout(std140) uniform FrameBlock {
+    mat4 MVP;
+    vec3 wLightPos;
+    vec3 wCamPos;
+};
 uniform mat4 MANIP = mat4(1.0);
 
 uniform bool planeClippingDiscard = false;
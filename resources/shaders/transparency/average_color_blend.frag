@@ -4,28 +4,25 @@ in vec2 texCoord;
 
 uniform sampler2D ColorTex0;
 uniform sampler2D ColorTex1;
-uniform vec3 BackgroundColor;
 
 out vec4 fragOutput;
 
 void main(void)
 {
-	vec4 SumColor = texture(ColorTex0, texCoord);
-	float n = texture(ColorTex1, texCoord).r;
+	vec2 Counts = texture(ColorTex1, texCoord).rg;
+	float SumAlpha = Counts.r;
+	float n = Counts.g;
 
-	if (n == 0.0) {
-		fragOutput.rgb = BackgroundColor;
-		// Liangliang: I don't want transparent images
-		fragOutput.a = 1.0f;
-		return;
-	}
+	// no transparent fragment covers this pixel: keep the opaque pass untouched
+	if (n == 0.0)
+		discard;
 
-	vec3 AvgColor = SumColor.rgb / SumColor.a;
-	float AvgAlpha = SumColor.a / n;
+	vec4 Accum = texture(ColorTex0, texCoord);
+	vec3 AvgColor = Accum.rgb / max(Accum.a, 1e-5);	// the accumulation weights cancel out
 
-	float T = pow(1.0-AvgAlpha, n);
-	fragOutput.rgb = AvgColor * (1 - T) + BackgroundColor * T;
+	float AvgAlpha = SumAlpha / n;
+	float T = pow(1.0 - AvgAlpha, n);	// the approximated transmittance
 
-	// Liangliang: I don't want transparent images
-	fragOutput.a = 1.0f;
+	// premultiplied alpha, composited over the opaque pass with (GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+	fragOutput = vec4(AvgColor * (1.0 - T), 1.0 - T);
 }
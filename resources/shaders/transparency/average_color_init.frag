@@ -55,6 +55,12 @@ vec4 ShadeFragment()
 void main(void)
 {
 	vec4 color = ShadeFragment();
-	fragOutput0 = vec4(color.rgb * color.a, color.a);
-	fragOutput1 = vec4(1.0);
+
+	// the depth-based weight of weighted-blended OIT (McGuire and Bavoil, 2013): near
+	// fragments dominate far ones, approximating the sorted composite. The weights
+	// cancel out in the resolve pass, so only their ratios matter.
+	float weight = color.a * clamp(3e3 * pow(1.0 - gl_FragCoord.z, 3.0), 1e-2, 3e3);
+
+	fragOutput0 = vec4(color.rgb * color.a, color.a) * weight;
+	fragOutput1 = vec4(color.a, 1.0, 0.0, 0.0);	// total opacity and fragment count
 }
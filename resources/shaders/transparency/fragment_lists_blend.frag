@@ -0,0 +1,65 @@
+#version 430
+
+// sort each pixel's fragment list by depth and blend the fragments back to front.
+
+layout(binding = 0, r32ui) uniform uimage2D HeadPointers;
+
+struct Node {
+	vec4  color;
+	float depth;
+	uint  next;
+	float _pad0;
+	float _pad1;
+};
+
+layout(std430, binding = 0) buffer NodeBuffer {
+	Node nodes[];
+};
+
+uniform vec3 BackgroundColor;
+
+in vec2 texCoord;
+
+out vec4 fragOutput;
+
+#define MAX_FRAGMENTS 64
+
+void main(void)
+{
+	// collect the fragments of this pixel
+	Node fragments[MAX_FRAGMENTS];
+	int count = 0;
+	uint index = imageLoad(HeadPointers, ivec2(gl_FragCoord.xy)).r;
+	while (index != 0xFFFFFFFFu && count < MAX_FRAGMENTS) {
+		fragments[count] = nodes[index];
+		index = fragments[count].next;
+		++count;
+	}
+
+	if (count == 0) {
+		fragOutput.rgb = BackgroundColor;
+		// Liangliang: I don't want transparent images
+		fragOutput.a = 1.0f;
+		return;
+	}
+
+	// insertion sort, far to near
+	for (int i = 1; i < count; ++i) {
+		Node value = fragments[i];
+		int j = i;
+		while (j > 0 && fragments[j - 1].depth < value.depth) {
+			fragments[j] = fragments[j - 1];
+			--j;
+		}
+		fragments[j] = value;
+	}
+
+	// blend the fragments over the background, far to near
+	vec3 color = BackgroundColor;
+	for (int i = 0; i < count; ++i)
+		color = mix(color, fragments[i].color.rgb, fragments[i].color.a);
+
+	fragOutput.rgb = color;
+	// Liangliang: I don't want transparent images
+	fragOutput.a = 1.0f;
+}
\ No newline at end of file
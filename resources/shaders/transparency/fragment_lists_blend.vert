@@ -0,0 +1,13 @@
+#version 430
+
+
+in vec4 vtx_position;
+in vec2 vtx_texcoord;
+
+out vec2 texCoord;
+
+void main()
+{
+	gl_Position = vtx_position;
+	texCoord = vtx_texcoord;
+}
\ No newline at end of file
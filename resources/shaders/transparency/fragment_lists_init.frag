@@ -0,0 +1,81 @@
+#version 430
+
+// every fragment is appended to the linked list of its pixel; there is no color output
+// in this pass (color writes are disabled by the caller).
+
+layout(binding = 0, r32ui) uniform uimage2D HeadPointers;
+layout(binding = 0, offset = 0) uniform atomic_uint NodeCounter;
+
+struct Node {
+	vec4  color;
+	float depth;
+	uint  next;
+	float _pad0;
+	float _pad1;
+};
+
+layout(std430, binding = 0) buffer NodeBuffer {
+	Node nodes[];
+};
+
+uniform uint MaxNodes;
+
+uniform float	Alpha;
+
+uniform vec3	wLightPos;
+uniform vec3	wCamPos;
+layout(std140) uniform Material {
+        vec3	ambient;
+        vec3	specular;
+        float	shininess;
+};
+
+// smooth shading
+uniform bool    smooth_shading = true;
+
+in Data{
+	vec3 color;
+	vec3 normal;
+	vec3 position;
+} DataIn;
+
+
+vec4 ShadeFragment()
+{
+    vec3 normal;
+    if (smooth_shading)
+        normal = normalize(DataIn.normal);
+    else {
+        normal = normalize(cross(dFdx(DataIn.position), dFdy(DataIn.position)));
+        if (dot(normal, DataIn.normal) < 0)
+            normal = -normal;
+    }
+
+    vec3 view_dir = normalize(wCamPos - DataIn.position);
+    vec3 light_dir = normalize(wLightPos);
+
+    // diffuse factor
+    float df = abs(dot(light_dir, normal));				// light up both sides
+
+    // specular factor
+    vec3 half_vector = normalize(light_dir + view_dir);	// compute the half vector
+    float sf = max(dot(half_vector, normal), 0.0);		// only the front side can have specular
+    sf = pow(sf, shininess);
+
+    return vec4(DataIn.color * df + specular * sf + ambient, Alpha);
+}
+
+void main(void)
+{
+	vec4 color = ShadeFragment();
+
+	uint index = atomicCounterIncrement(NodeCounter);
+	if (index < MaxNodes) {
+		// the fragment becomes the new head of its pixel's list
+		uint previous = imageAtomicExchange(HeadPointers, ivec2(gl_FragCoord.xy), index);
+		nodes[index].color = color;
+		nodes[index].depth = gl_FragCoord.z;
+		nodes[index].next = previous;
+	}
+	// fragments beyond the budget are dropped for this frame
+}
\ No newline at end of file
@@ -31,6 +31,8 @@
 #include <easy3d/core/surface_mesh.h>
 #include <easy3d/renderer/text_renderer.h>
 #include <easy3d/renderer/camera.h>
+#include <easy3d/renderer/frame_profiler.h>
+#include <easy3d/renderer/frame_statistics.h>
 
 #include <3rd_party/imgui/misc/fonts/imgui_fonts_droid_sans.h>
 #include <3rd_party/imgui/imgui.h>
@@ -56,6 +58,7 @@ namespace easy3d {
 		: Viewer(title, samples, gl_major, gl_minor, full_screen, resizable, depth_bits, stencil_bits)
         , alpha_(0.8f)
         , movable_(true)
+        , show_statistics_(false)
 	{
         camera()->setUpVector(vec3(0, 1, 0));
         camera()->setViewDirection(vec3(0, 0, -1));
@@ -248,6 +251,12 @@ namespace easy3d {
         if (show_overlay)
             draw_overlay(&show_overlay);
 
+        if (FrameProfiler::is_enabled())
+            draw_profiler();
+
+        if (show_statistics_)
+            draw_statistics();
+
         static bool show_about = false;
 		if (show_about) {
             ImGui::SetNextWindowPos(ImVec2(width() * 0.5f, height() * 0.5f), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
@@ -313,6 +322,69 @@ namespace easy3d {
 	}
 
 
+    void ViewerImGui::draw_profiler() {
+        bool visible = true;
+        ImGui::SetNextWindowSize(ImVec2(420, 360), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Frame Profiler", &visible);
+
+        ImGui::Text("frame: %6.2f ms (CPU)   %6.2f ms (GPU)",
+                    FrameProfiler::frame_cpu_time(), FrameProfiler::frame_gpu_time());
+
+        const auto& cpu = FrameProfiler::cpu_history();
+        const auto& gpu = FrameProfiler::gpu_history();
+        if (!cpu.empty()) {
+            ImGui::PlotLines("CPU (ms)", cpu.data(), static_cast<int>(cpu.size()),
+                             FrameProfiler::history_index(), nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+            ImGui::PlotLines("GPU (ms)", gpu.data(), static_cast<int>(gpu.size()),
+                             FrameProfiler::history_index(), nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+        }
+
+        ImGui::Separator();
+        ImGui::Columns(3, "profiler_sections");
+        ImGui::Text("section");  ImGui::NextColumn();
+        ImGui::Text("CPU (ms)"); ImGui::NextColumn();
+        ImGui::Text("GPU (ms)"); ImGui::NextColumn();
+        ImGui::Separator();
+        for (const auto& record : FrameProfiler::sections()) {
+            ImGui::Text("%*s%s", record.depth * 2, "", record.name.c_str()); ImGui::NextColumn();
+            ImGui::Text("%6.3f", record.cpu_time); ImGui::NextColumn();
+            ImGui::Text("%6.3f", record.gpu_time); ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+        ImGui::End();
+
+        if (!visible)
+            FrameProfiler::set_enabled(false);
+
+        // the timings change every frame, so keep redrawing while the profiler is shown
+        update();
+    }
+
+
+    void ViewerImGui::draw_statistics() {
+        ImGui::SetNextWindowSize(ImVec2(320, 220), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Render Statistics", &show_statistics_);
+
+        const auto& counters = FrameStatistics::last_frame();
+        ImGui::Columns(2, "statistics_counters");
+        ImGui::Text("draw calls");       ImGui::NextColumn();
+        ImGui::Text("%u", counters.draw_calls); ImGui::NextColumn();
+        ImGui::Text("triangles");        ImGui::NextColumn();
+        ImGui::Text("%lu", static_cast<unsigned long>(counters.triangles)); ImGui::NextColumn();
+        ImGui::Text("program binds");    ImGui::NextColumn();
+        ImGui::Text("%u (%u switches)", counters.program_binds, counters.program_switches); ImGui::NextColumn();
+        ImGui::Text("texture binds");    ImGui::NextColumn();
+        ImGui::Text("%u (%u switches)", counters.texture_binds, counters.texture_switches); ImGui::NextColumn();
+        ImGui::Text("buffer uploads");   ImGui::NextColumn();
+        ImGui::Text("%u (%.1f KB)", counters.buffer_uploads, counters.buffer_upload_bytes / 1024.0); ImGui::NextColumn();
+        ImGui::Columns(1);
+        ImGui::End();
+
+        // the counters change every frame, so keep redrawing while the HUD is shown
+        update();
+    }
+
+
     void ViewerImGui::draw_menu_file() {
         if (ImGui::BeginMenu("File"))
         {
@@ -350,6 +422,12 @@ namespace easy3d {
             if (ImGui::MenuItem("Snapshot", nullptr))
                 snapshot();
 
+            ImGui::Separator();
+            bool profiling = FrameProfiler::is_enabled();
+            if (ImGui::MenuItem("Frame Profiler", nullptr, &profiling))
+                FrameProfiler::set_enabled(profiling);
+            ImGui::MenuItem("Render Statistics", nullptr, &show_statistics_);
+
             ImGui::Separator();
             if (ImGui::BeginMenu("Options"))
             {
@@ -93,6 +93,15 @@ namespace easy3d {
         // with no decoration + a context-menu to choose its position.
         void  draw_overlay(bool* visible);
 
+        // The frame profiler HUD: per-section CPU/GPU timings of a frame and a
+        // plot of the recent frame times (see FrameProfiler). The profiling
+        // itself is toggled in the View menu.
+        void  draw_profiler();
+
+        // The render statistics HUD: the per-frame draw call, bind and upload
+        // counters (see FrameStatistics). Toggled in the View menu.
+        void  draw_statistics();
+
 	protected:
 		// Single global context by default, but can be overridden by the user
 		static ImGuiContext *	context_;
@@ -100,6 +109,7 @@ namespace easy3d {
         // Global variables for all the windows
         float	alpha_;
         bool	movable_;
+        bool	show_statistics_;
 		
 		float   menu_height_;
 	};
@@ -102,13 +102,14 @@ void TutorialAmbientOcclusion::draw() const {
 	if (ao_enabled_) {
 		ao_->generate(models_);
 
-		const mat4& MVP = camera_->modelViewProjectionMatrix();
+		ShaderProgram::FrameBlock frame_block;
+		frame_block.MVP = camera_->modelViewProjectionMatrix();
 		// camera position is defined in world coordinate system.
-		const vec3& wCamPos = camera_->position();
+		frame_block.wCamPos = camera_->position();
 		// it can also be computed as follows:
 		//const vec3& wCamPos = invMV * vec4(0, 0, 0, 1);
 		const mat4& MV = camera_->modelViewMatrix();
-		const vec4& wLightPos = inverse(MV) * setting::light_position;
+		frame_block.wLightPos = vec3(inverse(MV) * setting::light_position);
 
         ShaderProgram* program = ShaderManager::get_program("surface/surface_color");
 		if (!program) {
@@ -122,10 +123,8 @@ void TutorialAmbientOcclusion::draw() const {
 			return;
 
 		program->bind();
-		program->set_uniform("MVP", MVP)
-			->set_uniform("wLightPos", wLightPos)
-			->set_uniform("wCamPos", wCamPos)
-			->set_uniform("ssaoEnabled", true)
+		ShaderProgram::upload_block("FrameBlock", &frame_block, sizeof(frame_block));
+		program->set_uniform("ssaoEnabled", true)
 			->bind_texture("ssaoTexture", ao_->ssao_texture(), 0);
 
         program->set_uniform("smooth_shading", faces->smooth_shading())